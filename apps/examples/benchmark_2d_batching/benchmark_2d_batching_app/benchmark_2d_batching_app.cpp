@@ -0,0 +1,192 @@
+#include "benchmark_2d_batching_app.h"
+
+#include "le_renderer.hpp"
+#include "le_2d.h"
+#include "le_log.h"
+
+#include "glm/glm.hpp"
+
+#include <random>
+#include <vector>
+
+// Measures how well le_2d batches primitives: draws 1k, 10k, and 100k circles per frame,
+// first in submission order, then with primitive sorting enabled, and prints `get_draw_stats`
+// averaged over each run. Renders headless, into an image swapchain which discards frames,
+// so that this may run without a display.
+//
+// Circles come in a small number of distinct shapes, so that sorting may merge all circles
+// which share a shape into one instanced draw. Without sorting, consecutive circles have
+// different shapes, and each needs its own draw.
+
+static constexpr uint32_t FRAMES_PER_RUN = 60; // frames to render for each configuration before we print statistics
+
+static constexpr uint32_t PRIMITIVE_COUNTS[] = { 1000, 10000, 100000 };
+
+static constexpr float CIRCLE_RADII[] = { 2.f, 3.f, 5.f, 8.f }; // together with filled/outlined, this gives 8 distinct shapes
+
+// Consumes frames without writing them anywhere - the default pipe command would write a video.
+static constexpr auto IMG_SWAPCHAIN_PIPE_CMD = "ffmpeg -f rawvideo -pix_fmt %s -s %dx%d -i - -f null -";
+
+struct circle_t {
+	glm::vec2 position;
+	float     radius;
+	bool      filled;
+	uint32_t  color;
+};
+
+struct benchmark_2d_batching_app_o {
+	le::Renderer          renderer;
+	std::vector<circle_t> circles;               // enough for the largest primitive count
+	size_t                count_idx     = 0;     // index into PRIMITIVE_COUNTS
+	bool                  should_sort   = false; // whether le_2d may reorder primitives to merge draws
+	uint64_t              frame_counter = 0;     // frames rendered with the current configuration
+};
+
+typedef benchmark_2d_batching_app_o app_o;
+
+static auto logger = LeLog( "benchmark_2d_batching_app" );
+
+// ----------------------------------------------------------------------
+
+static void app_initialize(){};
+
+// ----------------------------------------------------------------------
+
+static void app_terminate(){};
+
+// ----------------------------------------------------------------------
+
+static app_o* app_create() {
+	auto app = new ( app_o );
+
+	app->renderer.setup(
+	    le::RendererInfoBuilder()
+	        .addSwapchain()
+	        .setWidthHint( 1024 )
+	        .setHeightHint( 768 )
+	        .asImgSwapchain()
+	        .setPipeCmd( IMG_SWAPCHAIN_PIPE_CMD )
+	        .end()
+	        .end()
+	        .build() );
+
+	std::mt19937                            rng( 1 ); // fixed seed, so that runs are repeatable
+	std::uniform_real_distribution<float>   coord_x( 0.f, 1024.f );
+	std::uniform_real_distribution<float>   coord_y( 0.f, 768.f );
+	std::uniform_int_distribution<uint32_t> color( 0, 0xffffff );
+
+	uint32_t const num_circles = PRIMITIVE_COUNTS[ sizeof( PRIMITIVE_COUNTS ) / sizeof( PRIMITIVE_COUNTS[ 0 ] ) - 1 ];
+	uint32_t const num_radii   = sizeof( CIRCLE_RADII ) / sizeof( CIRCLE_RADII[ 0 ] );
+
+	app->circles.reserve( num_circles );
+
+	for ( uint32_t i = 0; i != num_circles; i++ ) {
+		app->circles.push_back( {
+		    .position = { coord_x( rng ), coord_y( rng ) },
+		    .radius   = CIRCLE_RADII[ i % num_radii ],
+		    .filled   = ( i / num_radii ) % 2 == 0,
+		    .color    = color( rng ) << 8 | 0xff,
+		} );
+	}
+
+	le_2d::le_2d_i.reset_draw_stats();
+
+	return app;
+}
+
+// ----------------------------------------------------------------------
+
+static void pass_main_exec( le_command_buffer_encoder_o* encoder_, void* user_data ) {
+	auto app = static_cast<app_o*>( user_data );
+
+	Le2D le2d{ encoder_ };
+
+	le2d.setSortPrimitives( app->should_sort );
+
+	uint32_t const num_circles = PRIMITIVE_COUNTS[ app->count_idx ];
+
+	for ( uint32_t i = 0; i != num_circles; i++ ) {
+		auto const& c = app->circles[ i ];
+		le2d.circle()
+		    .set_node_position( c.position )
+		    .set_radius( c.radius )
+		    .set_filled( c.filled )
+		    .set_stroke_weight( 1.f )
+		    .set_color( c.color )
+		    .draw();
+	}
+
+	// le2d draws all its primitives when it goes out of scope.
+}
+
+// ----------------------------------------------------------------------
+
+static bool app_update( app_o* self ) {
+
+	static le_img_resource_handle LE_SWAPCHAIN_IMAGE_HANDLE = self->renderer.getSwapchainResource();
+
+	le::RenderGraph renderGraph{};
+	{
+		auto renderPassFinal =
+		    le::RenderPass( "root", le::QueueFlagBits::eGraphics )
+		        .addColorAttachment( LE_SWAPCHAIN_IMAGE_HANDLE )
+		        .setExecuteCallback( self, pass_main_exec ) //
+		    ;
+
+		renderGraph.addRenderPass( renderPassFinal );
+	}
+
+	self->renderer.update( renderGraph );
+
+	if ( ++self->frame_counter != FRAMES_PER_RUN ) {
+		return true; // keep app alive
+	}
+
+	// --------| invariant: we have rendered all frames for the current configuration
+
+	le_2d_api::draw_stats_t stats{};
+	le_2d::le_2d_i.get_draw_stats( &stats );
+
+	logger.info( "%6d primitives, sorting %-3s: per frame: %6.0f draw calls, %8.0f vertices uploaded, %7.3fms cpu time",
+	             PRIMITIVE_COUNTS[ self->count_idx ], self->should_sort ? "on" : "off",
+	             double( stats.num_draw_calls ) / FRAMES_PER_RUN,
+	             double( stats.num_vertices_uploaded ) / FRAMES_PER_RUN,
+	             double( stats.cpu_time_nanoseconds ) / ( 1e6 * FRAMES_PER_RUN ) );
+
+	le_2d::le_2d_i.reset_draw_stats();
+	self->frame_counter = 0;
+
+	if ( !self->should_sort ) {
+		self->should_sort = true;
+		return true;
+	}
+
+	self->should_sort = false;
+
+	if ( ++self->count_idx == sizeof( PRIMITIVE_COUNTS ) / sizeof( PRIMITIVE_COUNTS[ 0 ] ) ) {
+		return false; // we're done
+	}
+
+	return true; // keep app alive
+}
+
+// ----------------------------------------------------------------------
+
+static void app_destroy( app_o* self ) {
+	delete ( self );
+}
+
+// ----------------------------------------------------------------------
+
+LE_MODULE_REGISTER_IMPL( benchmark_2d_batching_app, api ) {
+
+	auto  benchmark_2d_batching_app_api_i = static_cast<benchmark_2d_batching_app_api*>( api );
+	auto& benchmark_2d_batching_app_i     = benchmark_2d_batching_app_api_i->benchmark_2d_batching_app_i;
+
+	benchmark_2d_batching_app_i.initialize = app_initialize;
+	benchmark_2d_batching_app_i.terminate  = app_terminate;
+
+	benchmark_2d_batching_app_i.create  = app_create;
+	benchmark_2d_batching_app_i.destroy = app_destroy;
+	benchmark_2d_batching_app_i.update  = app_update;
+}
@@ -0,0 +1,61 @@
+#ifndef GUARD_benchmark_2d_batching_app_H
+#define GUARD_benchmark_2d_batching_app_H
+
+#include "le_core.h"
+
+struct benchmark_2d_batching_app_o;
+
+// clang-format off
+struct benchmark_2d_batching_app_api {
+
+	struct benchmark_2d_batching_app_interface_t {
+		benchmark_2d_batching_app_o * ( *create     )();
+		void                          ( *destroy    )( benchmark_2d_batching_app_o *self );
+		bool                          ( *update     )( benchmark_2d_batching_app_o *self );
+		void                          ( *initialize )(); // static methods
+		void                          ( *terminate  )(); // static methods
+	};
+
+	benchmark_2d_batching_app_interface_t benchmark_2d_batching_app_i;
+};
+// clang-format on
+
+LE_MODULE( benchmark_2d_batching_app );
+LE_MODULE_LOAD_DEFAULT( benchmark_2d_batching_app );
+
+#ifdef __cplusplus
+
+namespace benchmark_2d_batching_app {
+static const auto& api                         = benchmark_2d_batching_app_api_i;
+static const auto& benchmark_2d_batching_app_i = api -> benchmark_2d_batching_app_i;
+} // namespace benchmark_2d_batching_app
+
+class Benchmark2dBatchingApp : NoCopy, NoMove {
+
+	benchmark_2d_batching_app_o* self;
+
+  public:
+	Benchmark2dBatchingApp()
+	    : self( benchmark_2d_batching_app::benchmark_2d_batching_app_i.create() ) {
+	}
+
+	bool update() {
+		return benchmark_2d_batching_app::benchmark_2d_batching_app_i.update( self );
+	}
+
+	~Benchmark2dBatchingApp() {
+		benchmark_2d_batching_app::benchmark_2d_batching_app_i.destroy( self );
+	}
+
+	static void initialize() {
+		benchmark_2d_batching_app::benchmark_2d_batching_app_i.initialize();
+	}
+
+	static void terminate() {
+		benchmark_2d_batching_app::benchmark_2d_batching_app_i.terminate();
+	}
+};
+
+#endif
+
+#endif // GUARD_benchmark_2d_batching_app_H
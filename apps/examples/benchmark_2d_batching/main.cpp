@@ -0,0 +1,33 @@
+#include "benchmark_2d_batching_app/benchmark_2d_batching_app.h"
+
+// ----------------------------------------------------------------------
+
+int main( int argc, char const* argv[] ) {
+
+	Benchmark2dBatchingApp::initialize();
+
+	{
+		// We instantiate Benchmark2dBatchingApp in its own scope - so that
+		// it will be destroyed before Benchmark2dBatchingApp::terminate
+		// is called.
+
+		Benchmark2dBatchingApp Benchmark2dBatchingApp{};
+
+		for ( ;; ) {
+
+#ifdef PLUGINS_DYNAMIC
+			le_core_poll_for_module_reloads();
+#endif
+			auto result = Benchmark2dBatchingApp.update();
+
+			if ( !result ) {
+				break;
+			}
+		}
+	}
+
+	// Must only be called once last Benchmark2dBatchingApp is destroyed
+	Benchmark2dBatchingApp::terminate();
+
+	return 0;
+}
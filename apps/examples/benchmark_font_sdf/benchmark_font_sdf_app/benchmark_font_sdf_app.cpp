@@ -0,0 +1,139 @@
+#include "benchmark_font_sdf_app.h"
+#include "le_log.h"
+#include "le_font.h"
+#include "le_jobs.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+// Measures how long `create_sdf_atlas` takes to build a signed distance field atlas,
+// depending on the number of le_jobs worker threads, and prints timings, and speedup
+// relative to building the atlas without the job system, on the calling thread.
+//
+// We re-initialise le_jobs for each thread count - this is safe, as le_font asks the
+// job system for its number of workers each time it builds an atlas.
+
+static constexpr auto     FONT_PATH      = "./resources/fonts/IBMPlexSans-Regular.otf";
+static constexpr float    SDF_FONT_SIZE  = 64.f; // font size at which distance fields are rendered
+static constexpr float    SDF_RANGE      = 8.f;  // distance from outline, in atlas pixels, at which distance fields saturate
+static constexpr uint32_t NUM_ITERATIONS = 5;    // atlas builds per thread count - we print the average
+
+static constexpr size_t MAX_WORKER_THREADS = 16; // le_jobs supports at most 16 worker threads
+
+struct benchmark_font_sdf_app_o {
+	std::vector<size_t> thread_counts; // 0 means: no job system
+};
+
+typedef benchmark_font_sdf_app_o app_o;
+
+static auto logger = LeLog( "benchmark_font_sdf_app" );
+
+// ----------------------------------------------------------------------
+
+static void app_initialize(){};
+
+// ----------------------------------------------------------------------
+
+static void app_terminate(){};
+
+// ----------------------------------------------------------------------
+
+static app_o* app_create() {
+	auto app = new ( app_o );
+
+	size_t const max_threads = std::clamp<size_t>( std::thread::hardware_concurrency(), 1, MAX_WORKER_THREADS );
+
+	app->thread_counts.push_back( 0 );
+
+	for ( size_t n = 1; n < max_threads; n *= 2 ) {
+		app->thread_counts.push_back( n );
+	}
+
+	app->thread_counts.push_back( max_threads );
+
+	return app;
+}
+
+// ----------------------------------------------------------------------
+// Returns average time in milliseconds to build an sdf atlas, or a negative number if
+// the atlas could not be built.
+static double measure_atlas_build_ms() {
+	double total_ms = 0;
+
+	for ( uint32_t i = 0; i != NUM_ITERATIONS; i++ ) {
+
+		// We create a new font for each iteration, as a font's atlas may only be created once.
+		le_font_o* font = le_font::le_font_i.create( FONT_PATH, SDF_FONT_SIZE );
+
+		auto t_start = std::chrono::high_resolution_clock::now();
+		bool success = le_font::le_font_i.create_sdf_atlas( font, SDF_FONT_SIZE, SDF_RANGE );
+		auto t_end   = std::chrono::high_resolution_clock::now();
+
+		le_font::le_font_i.destroy( font );
+
+		if ( !success ) {
+			return -1;
+		}
+
+		total_ms += std::chrono::duration<double, std::milli>( t_end - t_start ).count();
+	}
+
+	return total_ms / NUM_ITERATIONS;
+}
+
+// ----------------------------------------------------------------------
+
+static bool app_update( app_o* self ) {
+
+	double baseline_ms = 0;
+
+	for ( size_t num_threads : self->thread_counts ) {
+
+		if ( num_threads ) {
+			le_jobs::initialize( num_threads );
+		}
+
+		double ms = measure_atlas_build_ms();
+
+		if ( num_threads ) {
+			le_jobs::terminate();
+		}
+
+		if ( ms < 0 ) {
+			logger.error( "Could not build sdf atlas from font: '%s'", FONT_PATH );
+			return false;
+		}
+
+		if ( num_threads == 0 ) {
+			baseline_ms = ms;
+			logger.info( "no job system  : sdf atlas build: %8.3fms", ms );
+		} else {
+			logger.info( "%2zu worker(s)   : sdf atlas build: %8.3fms, speedup: %5.2fx", num_threads, ms, baseline_ms / ms );
+		}
+	}
+
+	return false; // we only run once
+}
+
+// ----------------------------------------------------------------------
+
+static void app_destroy( app_o* self ) {
+	delete ( self );
+}
+
+// ----------------------------------------------------------------------
+
+LE_MODULE_REGISTER_IMPL( benchmark_font_sdf_app, api ) {
+
+	auto  benchmark_font_sdf_app_api_i = static_cast<benchmark_font_sdf_app_api*>( api );
+	auto& benchmark_font_sdf_app_i     = benchmark_font_sdf_app_api_i->benchmark_font_sdf_app_i;
+
+	benchmark_font_sdf_app_i.initialize = app_initialize;
+	benchmark_font_sdf_app_i.terminate  = app_terminate;
+
+	benchmark_font_sdf_app_i.create  = app_create;
+	benchmark_font_sdf_app_i.destroy = app_destroy;
+	benchmark_font_sdf_app_i.update  = app_update;
+}
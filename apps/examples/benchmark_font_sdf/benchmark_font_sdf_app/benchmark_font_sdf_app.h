@@ -0,0 +1,61 @@
+#ifndef GUARD_benchmark_font_sdf_app_H
+#define GUARD_benchmark_font_sdf_app_H
+
+#include "le_core.h"
+
+struct benchmark_font_sdf_app_o;
+
+// clang-format off
+struct benchmark_font_sdf_app_api {
+
+	struct benchmark_font_sdf_app_interface_t {
+		benchmark_font_sdf_app_o * ( *create               )();
+		void         ( *destroy                  )( benchmark_font_sdf_app_o *self );
+		bool         ( *update                   )( benchmark_font_sdf_app_o *self );
+		void         ( *initialize               )(); // static methods
+		void         ( *terminate                )(); // static methods
+	};
+
+	benchmark_font_sdf_app_interface_t benchmark_font_sdf_app_i;
+};
+// clang-format on
+
+LE_MODULE( benchmark_font_sdf_app );
+LE_MODULE_LOAD_DEFAULT( benchmark_font_sdf_app );
+
+#ifdef __cplusplus
+
+namespace benchmark_font_sdf_app {
+static const auto& api            = benchmark_font_sdf_app_api_i;
+static const auto& benchmark_font_sdf_app_i = api -> benchmark_font_sdf_app_i;
+} // namespace benchmark_font_sdf_app
+
+class BenchmarkFontSdfApp : NoCopy, NoMove {
+
+	benchmark_font_sdf_app_o* self;
+
+  public:
+	BenchmarkFontSdfApp()
+	    : self( benchmark_font_sdf_app::benchmark_font_sdf_app_i.create() ) {
+	}
+
+	bool update() {
+		return benchmark_font_sdf_app::benchmark_font_sdf_app_i.update( self );
+	}
+
+	~BenchmarkFontSdfApp() {
+		benchmark_font_sdf_app::benchmark_font_sdf_app_i.destroy( self );
+	}
+
+	static void initialize() {
+		benchmark_font_sdf_app::benchmark_font_sdf_app_i.initialize();
+	}
+
+	static void terminate() {
+		benchmark_font_sdf_app::benchmark_font_sdf_app_i.terminate();
+	}
+};
+
+#endif
+
+#endif // GUARD_benchmark_font_sdf_app_H
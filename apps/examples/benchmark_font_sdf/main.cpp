@@ -0,0 +1,33 @@
+#include "benchmark_font_sdf_app/benchmark_font_sdf_app.h"
+
+// ----------------------------------------------------------------------
+
+int main( int argc, char const* argv[] ) {
+
+	BenchmarkFontSdfApp::initialize();
+
+	{
+		// We instantiate BenchmarkFontSdfApp in its own scope - so that
+		// it will be destroyed before BenchmarkFontSdfApp::terminate
+		// is called.
+
+		BenchmarkFontSdfApp BenchmarkFontSdfApp{};
+
+		for ( ;; ) {
+
+#ifdef PLUGINS_DYNAMIC
+			le_core_poll_for_module_reloads();
+#endif
+			auto result = BenchmarkFontSdfApp.update();
+
+			if ( !result ) {
+				break;
+			}
+		}
+	}
+
+	// Must only be called once last BenchmarkFontSdfApp is destroyed
+	BenchmarkFontSdfApp::terminate();
+
+	return 0;
+}
@@ -0,0 +1,190 @@
+#include "benchmark_path_svg_app.h"
+#include "le_log.h"
+#include "le_path.h"
+
+#include "glm/glm.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+// Measures how long it takes to parse simplified svg via `add_from_simplified_svg`, and to
+// flatten the resulting paths, using `flatten` (adaptive subdivision, scalar), and
+// `flatten_uniform` (uniform subdivision, SIMD for bezier curves, and arcs), and prints
+// timings, and vertex counts for a range of tolerances. Also times generating offset
+// outlines from flattened contours, which remains scalar.
+//
+// The svg document is generated upfront from a fixed seed, so that runs are repeatable. It
+// contains a mix of lines, quadratic, and cubic bezier curves, and elliptical arcs - which is
+// what Inkscape writes for typical artwork, once set up to write simplified svg.
+
+static constexpr uint32_t NUM_CONTOURS   = 2000; // contours in generated svg document
+static constexpr uint32_t NUM_ITERATIONS = 20;   // repetitions per measurement - we print the average
+
+static constexpr float TOLERANCES[] = { 1.f, 0.25f, 0.05f };
+
+struct benchmark_path_svg_app_o {
+	std::string svg; // generated svg path data
+};
+
+typedef benchmark_path_svg_app_o app_o;
+
+static auto logger = LeLog( "benchmark_path_svg_app" );
+
+// ----------------------------------------------------------------------
+
+static void app_initialize(){};
+
+// ----------------------------------------------------------------------
+
+static void app_terminate(){};
+
+// ----------------------------------------------------------------------
+// Generates simplified svg: absolute coordinates, every command repeated.
+static std::string generate_svg( uint32_t num_contours ) {
+
+	std::mt19937                          rng( 1 ); // fixed seed, so that runs are repeatable
+	std::uniform_real_distribution<float> coord( 0.f, 1000.f );
+	std::uniform_real_distribution<float> offset( -80.f, 80.f );
+	std::uniform_real_distribution<float> radius( 5.f, 120.f );
+	std::uniform_real_distribution<float> rotation( -3.f, 3.f );
+
+	std::string svg;
+	char        cmd[ 160 ];
+
+	for ( uint32_t i = 0; i != num_contours; i++ ) {
+
+		glm::vec2 p{ coord( rng ), coord( rng ) };
+
+		auto next_point = [ & ]() -> glm::vec2 {
+			p += glm::vec2{ offset( rng ), offset( rng ) };
+			return p;
+		};
+
+		snprintf( cmd, sizeof( cmd ), "M %.3f,%.3f ", p.x, p.y );
+		svg += cmd;
+
+		for ( int j = 0; j != 2; j++ ) {
+			glm::vec2 a = next_point();
+			snprintf( cmd, sizeof( cmd ), "L %.3f,%.3f ", a.x, a.y );
+			svg += cmd;
+
+			glm::vec2 c1 = next_point(), c2 = next_point(), b = next_point();
+			snprintf( cmd, sizeof( cmd ), "C %.3f,%.3f %.3f,%.3f %.3f,%.3f ", c1.x, c1.y, c2.x, c2.y, b.x, b.y );
+			svg += cmd;
+
+			glm::vec2 q1 = next_point(), c = next_point();
+			snprintf( cmd, sizeof( cmd ), "Q %.3f,%.3f %.3f,%.3f ", q1.x, q1.y, c.x, c.y );
+			svg += cmd;
+
+			glm::vec2 d = next_point();
+			snprintf( cmd, sizeof( cmd ), "A %.3f,%.3f %.3f %d %d %.3f,%.3f ",
+			          radius( rng ), radius( rng ), rotation( rng ), j, ( i + j ) % 2, d.x, d.y );
+			svg += cmd;
+		}
+
+		svg += "Z ";
+	}
+
+	return svg;
+}
+
+// ----------------------------------------------------------------------
+
+static app_o* app_create() {
+	auto app = new ( app_o );
+	app->svg = generate_svg( NUM_CONTOURS );
+	return app;
+}
+
+// ----------------------------------------------------------------------
+
+static size_t count_vertices( le::Path& path ) {
+	size_t total = 0;
+	for ( size_t i = 0; i != path.getNumPolylines(); i++ ) {
+		size_t num_vertices = 0;
+		path.getVerticesForPolyline( i, nullptr, &num_vertices );
+		total += num_vertices;
+	}
+	return total;
+}
+
+// ----------------------------------------------------------------------
+// Returns average time in milliseconds for calling `fn` NUM_ITERATIONS times.
+template <typename F>
+static double measure_ms( F&& fn ) {
+	auto t_start = std::chrono::high_resolution_clock::now();
+	for ( uint32_t i = 0; i != NUM_ITERATIONS; i++ ) {
+		fn();
+	}
+	auto t_end = std::chrono::high_resolution_clock::now();
+	return std::chrono::duration<double, std::milli>( t_end - t_start ).count() / NUM_ITERATIONS;
+}
+
+// ----------------------------------------------------------------------
+
+static bool app_update( app_o* self ) {
+
+	le::Path path;
+
+	double parse_ms = measure_ms( [ & ]() {
+		path.clear();
+		path.addFromSimplifiedSvg( self->svg.c_str() );
+	} );
+
+	logger.info( "svg: %zu bytes, %zu contours, parse: %8.3fms", self->svg.size(), path.getNumContours(), parse_ms );
+
+	std::vector<glm::vec2> outline_l;
+	std::vector<glm::vec2> outline_r;
+
+	for ( float tolerance : TOLERANCES ) {
+
+		double flatten_ms = measure_ms( [ & ]() { path.flatten( tolerance ); } );
+		size_t flatten_n  = count_vertices( path );
+
+		double uniform_ms = measure_ms( [ & ]() { path.flattenUniform( tolerance ); } );
+		size_t uniform_n  = count_vertices( path );
+
+		// Offset outlines are generated from contours directly - with their own flattening,
+		// which follows the offset curve, and is therefore adaptive, and scalar.
+		double outline_ms = measure_ms( [ & ]() {
+			for ( size_t i = 0; i != path.getNumContours(); i++ ) {
+				size_t count_l = outline_l.size();
+				size_t count_r = outline_r.size();
+				if ( !le_path::le_path_i.generate_offset_outline_for_contour( path, i, 2.f, tolerance, outline_l.data(), &count_l, outline_r.data(), &count_r ) ) {
+					outline_l.resize( count_l );
+					outline_r.resize( count_r );
+					le_path::le_path_i.generate_offset_outline_for_contour( path, i, 2.f, tolerance, outline_l.data(), &count_l, outline_r.data(), &count_r );
+				}
+			}
+		} );
+
+		logger.info( "tolerance %5.2f: flatten: %8.3fms (%8zu vertices), flatten_uniform: %8.3fms (%8zu vertices), offset outlines: %8.3fms",
+		             tolerance, flatten_ms, flatten_n, uniform_ms, uniform_n, outline_ms );
+	}
+
+	return false; // we only run once
+}
+
+// ----------------------------------------------------------------------
+
+static void app_destroy( app_o* self ) {
+	delete ( self );
+}
+
+// ----------------------------------------------------------------------
+
+LE_MODULE_REGISTER_IMPL( benchmark_path_svg_app, api ) {
+
+	auto  benchmark_path_svg_app_api_i = static_cast<benchmark_path_svg_app_api*>( api );
+	auto& benchmark_path_svg_app_i     = benchmark_path_svg_app_api_i->benchmark_path_svg_app_i;
+
+	benchmark_path_svg_app_i.initialize = app_initialize;
+	benchmark_path_svg_app_i.terminate  = app_terminate;
+
+	benchmark_path_svg_app_i.create  = app_create;
+	benchmark_path_svg_app_i.destroy = app_destroy;
+	benchmark_path_svg_app_i.update  = app_update;
+}
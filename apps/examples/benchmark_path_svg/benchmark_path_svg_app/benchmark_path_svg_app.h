@@ -0,0 +1,61 @@
+#ifndef GUARD_benchmark_path_svg_app_H
+#define GUARD_benchmark_path_svg_app_H
+
+#include "le_core.h"
+
+struct benchmark_path_svg_app_o;
+
+// clang-format off
+struct benchmark_path_svg_app_api {
+
+	struct benchmark_path_svg_app_interface_t {
+		benchmark_path_svg_app_o * ( *create               )();
+		void         ( *destroy                  )( benchmark_path_svg_app_o *self );
+		bool         ( *update                   )( benchmark_path_svg_app_o *self );
+		void         ( *initialize               )(); // static methods
+		void         ( *terminate                )(); // static methods
+	};
+
+	benchmark_path_svg_app_interface_t benchmark_path_svg_app_i;
+};
+// clang-format on
+
+LE_MODULE( benchmark_path_svg_app );
+LE_MODULE_LOAD_DEFAULT( benchmark_path_svg_app );
+
+#ifdef __cplusplus
+
+namespace benchmark_path_svg_app {
+static const auto& api            = benchmark_path_svg_app_api_i;
+static const auto& benchmark_path_svg_app_i = api -> benchmark_path_svg_app_i;
+} // namespace benchmark_path_svg_app
+
+class BenchmarkPathSvgApp : NoCopy, NoMove {
+
+	benchmark_path_svg_app_o* self;
+
+  public:
+	BenchmarkPathSvgApp()
+	    : self( benchmark_path_svg_app::benchmark_path_svg_app_i.create() ) {
+	}
+
+	bool update() {
+		return benchmark_path_svg_app::benchmark_path_svg_app_i.update( self );
+	}
+
+	~BenchmarkPathSvgApp() {
+		benchmark_path_svg_app::benchmark_path_svg_app_i.destroy( self );
+	}
+
+	static void initialize() {
+		benchmark_path_svg_app::benchmark_path_svg_app_i.initialize();
+	}
+
+	static void terminate() {
+		benchmark_path_svg_app::benchmark_path_svg_app_i.terminate();
+	}
+};
+
+#endif
+
+#endif // GUARD_benchmark_path_svg_app_H
@@ -0,0 +1,33 @@
+#include "benchmark_path_svg_app/benchmark_path_svg_app.h"
+
+// ----------------------------------------------------------------------
+
+int main( int argc, char const* argv[] ) {
+
+	BenchmarkPathSvgApp::initialize();
+
+	{
+		// We instantiate BenchmarkPathSvgApp in its own scope - so that
+		// it will be destroyed before BenchmarkPathSvgApp::terminate
+		// is called.
+
+		BenchmarkPathSvgApp BenchmarkPathSvgApp{};
+
+		for ( ;; ) {
+
+#ifdef PLUGINS_DYNAMIC
+			le_core_poll_for_module_reloads();
+#endif
+			auto result = BenchmarkPathSvgApp.update();
+
+			if ( !result ) {
+				break;
+			}
+		}
+	}
+
+	// Must only be called once last BenchmarkPathSvgApp is destroyed
+	BenchmarkPathSvgApp::terminate();
+
+	return 0;
+}
@@ -0,0 +1,168 @@
+#include "benchmark_pixels_decode_app.h"
+#include "le_log.h"
+#include "le_pixels.h"
+#include "le_jobs.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+// Measures how long it takes le_pixels to decode a batch of png, and jpg images: first
+// one after the other via `create`, then via `create_batch_from_files`, and finally via
+// `load_async_from_file` - and prints timings, and speedup relative to serial decoding.
+//
+// Batched, and async decoding spread work over le_jobs worker threads - we measure these
+// with the job system initialised with as many workers as there are hardware threads.
+
+static char const* IMAGE_PATHS[] = {
+    "./local_resources/images/hald_8_identity.png",
+    "./local_resources/images/night_from_day.png",
+    "./local_resources/images/revolt-97ZPiaJbDuA-unsplash.jpg",
+};
+
+static constexpr uint32_t BATCH_REPEAT   = 8; // how many times each image appears in a batch
+static constexpr uint32_t NUM_ITERATIONS = 5; // decodes per mode - we print the average
+
+static constexpr size_t MAX_WORKER_THREADS = 16; // le_jobs supports at most 16 worker threads
+
+struct benchmark_pixels_decode_app_o {
+	std::vector<char const*>  file_paths; // every image, BATCH_REPEAT times
+	std::vector<le_pixels_o*> results;    // one per file path
+};
+
+typedef benchmark_pixels_decode_app_o app_o;
+
+static auto logger = LeLog( "benchmark_pixels_decode_app" );
+
+// ----------------------------------------------------------------------
+
+static void app_initialize(){};
+
+// ----------------------------------------------------------------------
+
+static void app_terminate(){};
+
+// ----------------------------------------------------------------------
+
+static app_o* app_create() {
+	auto app = new ( app_o );
+
+	for ( uint32_t i = 0; i != BATCH_REPEAT; i++ ) {
+		for ( auto const& path : IMAGE_PATHS ) {
+			app->file_paths.push_back( path );
+		}
+	}
+
+	app->results.resize( app->file_paths.size(), nullptr );
+
+	return app;
+}
+
+// ----------------------------------------------------------------------
+// Frees all decoded images - returns false if any image could not be decoded.
+static bool release_results( app_o* self ) {
+	bool success = true;
+	for ( auto& p : self->results ) {
+		if ( p ) {
+			le_pixels::le_pixels_i.destroy( p );
+			p = nullptr;
+		} else {
+			success = false;
+		}
+	}
+	return success;
+}
+
+// ----------------------------------------------------------------------
+// Returns average time in milliseconds for decoding all files via `decode`, or a
+// negative number if any file could not be decoded.
+template <typename F>
+static double measure_decode_ms( app_o* self, F&& decode ) {
+	double total_ms = 0;
+
+	for ( uint32_t i = 0; i != NUM_ITERATIONS; i++ ) {
+
+		auto t_start = std::chrono::high_resolution_clock::now();
+		decode();
+		auto t_end = std::chrono::high_resolution_clock::now();
+
+		if ( !release_results( self ) ) {
+			return -1;
+		}
+
+		total_ms += std::chrono::duration<double, std::milli>( t_end - t_start ).count();
+	}
+
+	return total_ms / NUM_ITERATIONS;
+}
+
+// ----------------------------------------------------------------------
+
+static bool app_update( app_o* self ) {
+
+	using namespace le_pixels;
+
+	size_t const num_files = self->file_paths.size();
+
+	double serial_ms = measure_decode_ms( self, [ & ]() {
+		for ( size_t i = 0; i != num_files; i++ ) {
+			self->results[ i ] = le_pixels_i.create( self->file_paths[ i ], 4, le_pixels_info::eUInt8 );
+		}
+	} );
+
+	if ( serial_ms < 0 ) {
+		logger.error( "Could not decode images - are local resources linked?" );
+		return false;
+	}
+
+	size_t const num_threads = std::clamp<size_t>( std::thread::hardware_concurrency(), 1, MAX_WORKER_THREADS );
+
+	le_jobs::initialize( num_threads );
+
+	double batch_ms = measure_decode_ms( self, [ & ]() {
+		le_pixels_i.create_batch_from_files( self->file_paths.data(), num_files, 4, le_pixels_info::eUInt8, self->results.data() );
+	} );
+
+	std::vector<le_pixels_load_o*> loads( num_files );
+
+	double async_ms = measure_decode_ms( self, [ & ]() {
+		for ( size_t i = 0; i != num_files; i++ ) {
+			loads[ i ] = le_pixels_i.load_async_from_file( self->file_paths[ i ], 4, le_pixels_info::eUInt8, nullptr, 0 );
+		}
+		for ( size_t i = 0; i != num_files; i++ ) {
+			self->results[ i ] = le_pixels_i.load_wait( loads[ i ] );
+		}
+	} );
+
+	le_jobs::terminate();
+
+	logger.info( "%zu images, %zu worker(s)", num_files, num_threads );
+	logger.info( "serial : %8.3fms", serial_ms );
+	logger.info( "batched: %8.3fms, speedup: %5.2fx", batch_ms, serial_ms / batch_ms );
+	logger.info( "async  : %8.3fms, speedup: %5.2fx", async_ms, serial_ms / async_ms );
+
+	return false; // we only run once
+}
+
+// ----------------------------------------------------------------------
+
+static void app_destroy( app_o* self ) {
+	release_results( self );
+	delete ( self );
+}
+
+// ----------------------------------------------------------------------
+
+LE_MODULE_REGISTER_IMPL( benchmark_pixels_decode_app, api ) {
+
+	auto  benchmark_pixels_decode_app_api_i = static_cast<benchmark_pixels_decode_app_api*>( api );
+	auto& benchmark_pixels_decode_app_i     = benchmark_pixels_decode_app_api_i->benchmark_pixels_decode_app_i;
+
+	benchmark_pixels_decode_app_i.initialize = app_initialize;
+	benchmark_pixels_decode_app_i.terminate  = app_terminate;
+
+	benchmark_pixels_decode_app_i.create  = app_create;
+	benchmark_pixels_decode_app_i.destroy = app_destroy;
+	benchmark_pixels_decode_app_i.update  = app_update;
+}
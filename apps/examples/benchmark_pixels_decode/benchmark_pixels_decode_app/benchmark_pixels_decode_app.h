@@ -0,0 +1,61 @@
+#ifndef GUARD_benchmark_pixels_decode_app_H
+#define GUARD_benchmark_pixels_decode_app_H
+
+#include "le_core.h"
+
+struct benchmark_pixels_decode_app_o;
+
+// clang-format off
+struct benchmark_pixels_decode_app_api {
+
+	struct benchmark_pixels_decode_app_interface_t {
+		benchmark_pixels_decode_app_o * ( *create               )();
+		void         ( *destroy                  )( benchmark_pixels_decode_app_o *self );
+		bool         ( *update                   )( benchmark_pixels_decode_app_o *self );
+		void         ( *initialize               )(); // static methods
+		void         ( *terminate                )(); // static methods
+	};
+
+	benchmark_pixels_decode_app_interface_t benchmark_pixels_decode_app_i;
+};
+// clang-format on
+
+LE_MODULE( benchmark_pixels_decode_app );
+LE_MODULE_LOAD_DEFAULT( benchmark_pixels_decode_app );
+
+#ifdef __cplusplus
+
+namespace benchmark_pixels_decode_app {
+static const auto& api            = benchmark_pixels_decode_app_api_i;
+static const auto& benchmark_pixels_decode_app_i = api -> benchmark_pixels_decode_app_i;
+} // namespace benchmark_pixels_decode_app
+
+class BenchmarkPixelsDecodeApp : NoCopy, NoMove {
+
+	benchmark_pixels_decode_app_o* self;
+
+  public:
+	BenchmarkPixelsDecodeApp()
+	    : self( benchmark_pixels_decode_app::benchmark_pixels_decode_app_i.create() ) {
+	}
+
+	bool update() {
+		return benchmark_pixels_decode_app::benchmark_pixels_decode_app_i.update( self );
+	}
+
+	~BenchmarkPixelsDecodeApp() {
+		benchmark_pixels_decode_app::benchmark_pixels_decode_app_i.destroy( self );
+	}
+
+	static void initialize() {
+		benchmark_pixels_decode_app::benchmark_pixels_decode_app_i.initialize();
+	}
+
+	static void terminate() {
+		benchmark_pixels_decode_app::benchmark_pixels_decode_app_i.terminate();
+	}
+};
+
+#endif
+
+#endif // GUARD_benchmark_pixels_decode_app_H
@@ -0,0 +1,33 @@
+#include "benchmark_pixels_decode_app/benchmark_pixels_decode_app.h"
+
+// ----------------------------------------------------------------------
+
+int main( int argc, char const* argv[] ) {
+
+	BenchmarkPixelsDecodeApp::initialize();
+
+	{
+		// We instantiate BenchmarkPixelsDecodeApp in its own scope - so that
+		// it will be destroyed before BenchmarkPixelsDecodeApp::terminate
+		// is called.
+
+		BenchmarkPixelsDecodeApp BenchmarkPixelsDecodeApp{};
+
+		for ( ;; ) {
+
+#ifdef PLUGINS_DYNAMIC
+			le_core_poll_for_module_reloads();
+#endif
+			auto result = BenchmarkPixelsDecodeApp.update();
+
+			if ( !result ) {
+				break;
+			}
+		}
+	}
+
+	// Must only be called once last BenchmarkPixelsDecodeApp is destroyed
+	BenchmarkPixelsDecodeApp::terminate();
+
+	return 0;
+}
@@ -0,0 +1,261 @@
+#include "bindless_example_app.h"
+
+#include "le_renderer.hpp"
+#include "le_backend_vk.h"
+#include "le_pipeline_builder.h"
+#include "le_log.h"
+
+#include <cstdio>
+
+// Draws a grid of textured quads, first binding each quad's texture as a regular argument,
+// then indexing into the bindless texture array, and prints how many descriptors the backend
+// wrote for each mode. Renders headless, into an image swapchain which discards frames, so
+// that this may run without a display.
+//
+// Bindless mode is a backend setting, which becomes readonly once the first renderer is set
+// up - we therefore enable it once, and switch between draw paths instead: regular draws
+// update argument descriptor sets with every texture change, while bindless draws only pass
+// an index via push constants, and leave argument sets alone.
+
+static constexpr uint32_t NUM_TEXTURES    = 64; // one texture per quad, must match GRID_SIZE * GRID_SIZE in quad.vert
+static constexpr uint32_t FRAMES_PER_MODE = 60; // frames to render for each mode before we print descriptor write counts
+
+// Consumes frames without writing them anywhere - the default pipe command would write a video.
+static constexpr auto IMG_SWAPCHAIN_PIPE_CMD = "ffmpeg -f rawvideo -pix_fmt %s -s %dx%d -i - -f null -";
+
+enum class DrawMode : uint32_t {
+	eRegular = 0,
+	eBindless,
+};
+
+struct push_constants_t {
+	uint32_t quad_idx;
+	uint32_t texture_idx; // only used by the bindless fragment shader
+};
+
+struct bindless_example_app_o {
+	le::Renderer      renderer;
+	le_texture_handle textures[ NUM_TEXTURES ]; // all sample the same image, but each has its own descriptor
+	DrawMode          draw_mode            = DrawMode::eRegular;
+	uint64_t          frame_counter        = 0;     // frames rendered with the current draw mode
+	bool              bindless_unsupported = false; // set if the device does not support bindless mode
+};
+
+typedef bindless_example_app_o app_o;
+
+static auto logger = LeLog( "bindless_example_app" );
+
+// ----------------------------------------------------------------------
+
+static void app_initialize(){};
+
+// ----------------------------------------------------------------------
+
+static void app_terminate(){};
+
+// ----------------------------------------------------------------------
+
+static char const* draw_mode_name( DrawMode draw_mode ) {
+	switch ( draw_mode ) {
+	case DrawMode::eRegular:
+		return "regular";
+	case DrawMode::eBindless:
+		return "bindless";
+	}
+	return "unknown";
+}
+
+// ----------------------------------------------------------------------
+
+static app_o* app_create() {
+
+	// Must happen before the renderer is set up, so that the backend may request
+	// descriptor indexing features from the device.
+	le_backend_vk::settings_i.set_bindless_enabled( true );
+
+	auto app = new ( app_o );
+
+	app->renderer.setup(
+	    le::RendererInfoBuilder()
+	        .addSwapchain()
+	        .setWidthHint( 640 )
+	        .setHeightHint( 480 )
+	        .asImgSwapchain()
+	        .setPipeCmd( IMG_SWAPCHAIN_PIPE_CMD )
+	        .end()
+	        .end()
+	        .build() );
+
+	char texture_name[ 32 ];
+	for ( uint32_t i = 0; i != NUM_TEXTURES; i++ ) {
+		snprintf( texture_name, sizeof( texture_name ), "texQuad_%02d", i );
+		app->textures[ i ] = le::Renderer::produceTextureHandle( texture_name );
+	}
+
+	return app;
+}
+
+// ----------------------------------------------------------------------
+
+static void pass_source_exec( le_command_buffer_encoder_o* encoder_, void* user_data ) {
+	// Nothing to draw - the renderpass clears the source image.
+}
+
+// ----------------------------------------------------------------------
+
+static void pass_main_exec( le_command_buffer_encoder_o* encoder_, void* user_data ) {
+	auto                app = static_cast<app_o*>( user_data );
+	le::GraphicsEncoder encoder{ encoder_ };
+
+	static auto shader_vert =
+	    LeShaderModuleBuilder( encoder.getPipelineManager() )
+	        .setShaderStage( le::ShaderStage::eVertex )
+	        .setSourceFilePath( "./local_resources/shaders/quad.vert" )
+	        .build();
+
+	static auto pipeline_regular =
+	    LeGraphicsPipelineBuilder( encoder.getPipelineManager() )
+	        .addShaderStage( shader_vert )
+	        .addShaderStage(
+	            LeShaderModuleBuilder( encoder.getPipelineManager() )
+	                .setShaderStage( le::ShaderStage::eFragment )
+	                .setSourceFilePath( "./local_resources/shaders/quad_regular.frag" )
+	                .build() )
+	        .build();
+
+	static auto pipeline_bindless =
+	    LeGraphicsPipelineBuilder( encoder.getPipelineManager() )
+	        .addShaderStage( shader_vert )
+	        .addShaderStage(
+	            LeShaderModuleBuilder( encoder.getPipelineManager() )
+	                .setShaderStage( le::ShaderStage::eFragment )
+	                .setSourceFilePath( "./local_resources/shaders/quad_bindless.frag" )
+	                .build() )
+	        .build();
+
+	push_constants_t params{};
+
+	if ( app->draw_mode == DrawMode::eRegular ) {
+
+		// Every texture change means a new argument descriptor set.
+		encoder.bindGraphicsPipeline( pipeline_regular );
+
+		for ( uint32_t i = 0; i != NUM_TEXTURES; i++ ) {
+			params.quad_idx = i;
+			encoder
+			    .setArgumentTexture( LE_ARGUMENT_NAME( "src_tex" ), app->textures[ i ] )
+			    .setPushConstantData( &params, sizeof( params ) )
+			    .draw( 6 );
+		}
+
+	} else {
+
+		// Textures live in the bindless set - we only tell the shader where to look.
+		encoder.bindGraphicsPipeline( pipeline_bindless );
+
+		for ( uint32_t i = 0; i != NUM_TEXTURES; i++ ) {
+			params.quad_idx    = i;
+			params.texture_idx = encoder.getBindlessTextureIndex( app->textures[ i ] );
+
+			if ( params.texture_idx == LE_BINDLESS_INDEX_INVALID ) {
+				app->bindless_unsupported = true;
+				return;
+			}
+
+			encoder
+			    .setPushConstantData( &params, sizeof( params ) )
+			    .draw( 6 );
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+
+static bool app_update( app_o* self ) {
+
+	static le_img_resource_handle LE_SWAPCHAIN_IMAGE_HANDLE = self->renderer.getSwapchainResource();
+	static le_img_resource_handle LE_SOURCE_IMAGE_HANDLE    = LE_IMG_RESOURCE( "SOURCE_IMAGE" );
+
+	le::RenderGraph renderGraph{};
+	{
+		auto renderPassSource =
+		    le::RenderPass( "source", le::QueueFlagBits::eGraphics )
+		        .addColorAttachment(
+		            LE_SOURCE_IMAGE_HANDLE,
+		            le::ImageAttachmentInfoBuilder()
+		                .setColorClearValue( le::ClearValue( { 0.2f, 0.4f, 0.8f, 1.f } ) )
+		                .build() )
+		        .setWidth( 64 )
+		        .setHeight( 64 )
+		        .setExecuteCallback( self, pass_source_exec ) //
+		    ;
+
+		auto renderPassMain =
+		    le::RenderPass( "root", le::QueueFlagBits::eGraphics )
+		        .addColorAttachment( LE_SWAPCHAIN_IMAGE_HANDLE )
+		        .setExecuteCallback( self, pass_main_exec ) //
+		    ;
+
+		for ( auto const& texture : self->textures ) {
+			renderPassMain.sampleTexture( texture, LE_SOURCE_IMAGE_HANDLE );
+		}
+
+		renderGraph
+		    .addRenderPass( renderPassSource )
+		    .addRenderPass( renderPassMain )
+		    .declareResource(
+		        LE_SOURCE_IMAGE_HANDLE,
+		        le::ImageInfoBuilder()
+		            .setExtent( 64, 64 )
+		            .addUsageFlags( le::ImageUsageFlagBits::eColorAttachment | le::ImageUsageFlagBits::eSampled )
+		            .build() ) //
+		    ;
+	}
+
+	self->renderer.update( renderGraph );
+
+	if ( self->bindless_unsupported ) {
+		logger.warn( "Bindless mode is not supported on this device - skipping bindless draws." );
+		return false;
+	}
+
+	if ( ++self->frame_counter == FRAMES_PER_MODE ) {
+
+		uint32_t num_argument_writes = 0;
+		uint32_t num_bindless_writes = 0;
+		self->renderer.getDescriptorWriteCounts( &num_argument_writes, &num_bindless_writes );
+
+		logger.info( "%-8s: %3d draws per frame, descriptor writes per frame: argument sets: %4d, bindless set: %4d",
+		             draw_mode_name( self->draw_mode ), NUM_TEXTURES, num_argument_writes, num_bindless_writes );
+
+		if ( self->draw_mode == DrawMode::eBindless ) {
+			return false; // we're done
+		}
+
+		self->draw_mode     = DrawMode::eBindless;
+		self->frame_counter = 0;
+	}
+
+	return true; // keep app alive
+}
+
+// ----------------------------------------------------------------------
+
+static void app_destroy( app_o* self ) {
+	delete ( self );
+}
+
+// ----------------------------------------------------------------------
+
+LE_MODULE_REGISTER_IMPL( bindless_example_app, api ) {
+
+	auto  bindless_example_app_api_i = static_cast<bindless_example_app_api*>( api );
+	auto& bindless_example_app_i     = bindless_example_app_api_i->bindless_example_app_i;
+
+	bindless_example_app_i.initialize = app_initialize;
+	bindless_example_app_i.terminate  = app_terminate;
+
+	bindless_example_app_i.create  = app_create;
+	bindless_example_app_i.destroy = app_destroy;
+	bindless_example_app_i.update  = app_update;
+}
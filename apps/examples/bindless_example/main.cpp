@@ -0,0 +1,33 @@
+#include "bindless_example_app/bindless_example_app.h"
+
+// ----------------------------------------------------------------------
+
+int main( int argc, char const* argv[] ) {
+
+	BindlessExampleApp::initialize();
+
+	{
+		// We instantiate BindlessExampleApp in its own scope - so that
+		// it will be destroyed before BindlessExampleApp::terminate
+		// is called.
+
+		BindlessExampleApp BindlessExampleApp{};
+
+		for ( ;; ) {
+
+#ifdef PLUGINS_DYNAMIC
+			le_core_poll_for_module_reloads();
+#endif
+			auto result = BindlessExampleApp.update();
+
+			if ( !result ) {
+				break;
+			}
+		}
+	}
+
+	// Must only be called once last BindlessExampleApp is destroyed
+	BindlessExampleApp::terminate();
+
+	return 0;
+}
@@ -0,0 +1,42 @@
+#version 450 core
+
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+// Draws quad number `quad_idx` of a grid of quads which covers the screen.
+// Note: no vertex inputs - draw with 6 vertices, as a triangle list.
+
+#define GRID_SIZE 8
+
+// uniforms
+layout (push_constant) uniform Params
+{
+	uint quad_idx;
+	uint texture_idx; // only used by bindless fragment shader
+};
+
+// outputs
+layout (location = 0) out vec2 outTexCoord;
+layout (location = 1) flat out uint outTextureIdx;
+
+out gl_PerVertex
+{
+	vec4 gl_Position;
+};
+
+const vec2 corners[6] = vec2[](
+	vec2(0, 0), vec2(1, 0), vec2(0, 1),
+	vec2(0, 1), vec2(1, 0), vec2(1, 1)
+);
+
+void main()
+{
+	vec2 corner = corners[gl_VertexIndex];
+	vec2 cell   = vec2(quad_idx % GRID_SIZE, quad_idx / GRID_SIZE);
+
+	outTexCoord   = corner;
+	outTextureIdx = texture_idx;
+
+	// leave a small gap between quads
+	gl_Position = vec4(((cell + 0.05 + corner * 0.9) / GRID_SIZE) * 2.0 - 1.0, 0.0, 1.0);
+}
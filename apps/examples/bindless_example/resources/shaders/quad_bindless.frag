@@ -0,0 +1,19 @@
+#version 450 core
+
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+#extension GL_EXT_nonuniform_qualifier : require
+
+// inputs
+layout (location = 0) in vec2 inTexCoord;
+layout (location = 1) flat in uint inTextureIdx; // from encoder `getBindlessTextureIndex`
+
+// uniforms - set, and binding must match resources/shaders/le_bindless.glsl
+layout (set = 3, binding = 0) uniform sampler2D le_bindless_textures[];
+
+// outputs
+layout (location = 0) out vec4 outFragColor;
+
+void main(){
+	outFragColor = texture(le_bindless_textures[nonuniformEXT(inTextureIdx)], inTexCoord);
+}
@@ -0,0 +1,18 @@
+#version 450 core
+
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+// inputs
+layout (location = 0) in vec2 inTexCoord;
+layout (location = 1) flat in uint inTextureIdx;
+
+// uniforms - set via encoder `setArgumentTexture` for every draw
+layout (set = 0, binding = 0) uniform sampler2D src_tex;
+
+// outputs
+layout (location = 0) out vec4 outFragColor;
+
+void main(){
+	outFragColor = texture(src_tex, inTexCoord);
+}
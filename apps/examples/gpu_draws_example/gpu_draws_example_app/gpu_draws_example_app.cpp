@@ -0,0 +1,319 @@
+#include "gpu_draws_example_app.h"
+
+#include "le_renderer.hpp"
+#include "le_backend_vk.h"
+#include "le_camera.h"
+#include "le_stage.h"
+#include "le_stage_types.h"
+#include "le_log.h"
+
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE // vulkan clip space is from 0 to 1
+#define GLM_FORCE_RIGHT_HANDED      // glTF uses right handed coordinate system, and we're following its lead.
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+#include <cstddef> // for offsetof
+#include <vector>
+
+// Renders a grid of cubes with le_stage, first drawing on the CPU, then GPU-driven, where
+// a compute pass culls instances, and writes indirect draws. Renders headless, into an image
+// swapchain which pipes frames to ffmpeg, and prints draw statistics for both modes.
+//
+// Note that GPU-driven drawing must be enabled before the renderer is set up, so that the
+// backend may request indirect draw features from the device.
+
+// Wrappers so that we can pass data via opaque pointers across header boundaries
+struct glm_vec3_t {
+	glm::vec3 data;
+};
+struct glm_quat_t {
+	glm::quat data;
+};
+struct glm_mat4_t {
+	glm::mat4 data;
+};
+
+static constexpr uint32_t GRID_SIZE       = 32;  // cubes per side of the grid - some of these will be outside the camera frustum
+static constexpr float    GRID_SPACING    = 3.f; // distance between cube centres
+static constexpr uint32_t FRAMES_PER_MODE = 60;  // frames to render for each mode before we print draw statistics
+
+// Writes each frame as a png image - the default pipe command would write a video instead.
+static constexpr auto IMG_SWAPCHAIN_PIPE_CMD = "ffmpeg -r 60 -f rawvideo -pix_fmt %s -s %dx%d -i - -threads 0 -y isl%s_gpu_draws_%%03d.png";
+
+struct gpu_draws_example_app_o {
+	le::Renderer renderer;
+	LeStage*     stage         = nullptr;
+	uint64_t     frame_counter = 0;
+
+	LeCamera camera;
+
+	le_stage_api::draw_params_t draw_params{}; // must live as long as the rendergraph which uses it
+};
+
+typedef gpu_draws_example_app_o app_o;
+
+static auto logger = LeLog( "gpu_draws_example_app" );
+
+// ----------------------------------------------------------------------
+
+static void app_initialize(){};
+
+// ----------------------------------------------------------------------
+
+static void app_terminate(){};
+
+// ----------------------------------------------------------------------
+// Adds a unit cube mesh to the stage, and returns its mesh index.
+static uint32_t stage_create_cube_mesh( le_stage_o* stage ) {
+
+	using namespace le_stage;
+
+	struct vertex_data_t {
+		glm::vec3 positions[ 24 ];
+		glm::vec3 normals[ 24 ];
+		uint16_t  indices[ 36 ];
+	};
+
+	vertex_data_t data{};
+
+	// One quad per face, so that each face gets its own normal.
+	glm::vec3 const face_normals[ 6 ] = {
+	    { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 } };
+
+	for ( uint32_t f = 0; f != 6; f++ ) {
+		glm::vec3 const n = face_normals[ f ];
+		glm::vec3 const u = glm::vec3( n.y, n.z, n.x ); // two axes orthogonal to the normal
+		glm::vec3 const v = glm::cross( n, u );
+
+		glm::vec3 const corners[ 4 ] = { n - u - v, n + u - v, n + u + v, n - u + v };
+
+		for ( uint32_t c = 0; c != 4; c++ ) {
+			data.positions[ f * 4 + c ] = corners[ c ] * 0.5f;
+			data.normals[ f * 4 + c ]   = n;
+		}
+
+		uint16_t const quad[ 6 ] = { 0, 1, 2, 0, 2, 3 };
+		for ( uint32_t i = 0; i != 6; i++ ) {
+			data.indices[ f * 6 + i ] = uint16_t( f * 4 + quad[ i ] );
+		}
+	}
+
+	uint32_t buffer_idx = le_stage_i.create_buffer( stage, &data, sizeof( data ), "cube" );
+
+	le_buffer_view_info views[ 3 ]{};
+
+	views[ 0 ].buffer_idx  = buffer_idx;
+	views[ 0 ].byte_offset = offsetof( vertex_data_t, positions );
+	views[ 0 ].byte_length = sizeof( data.positions );
+	views[ 0 ].byte_stride = sizeof( glm::vec3 );
+	views[ 0 ].type        = le_buffer_view_type::eVertex;
+
+	views[ 1 ].buffer_idx  = buffer_idx;
+	views[ 1 ].byte_offset = offsetof( vertex_data_t, normals );
+	views[ 1 ].byte_length = sizeof( data.normals );
+	views[ 1 ].byte_stride = sizeof( glm::vec3 );
+	views[ 1 ].type        = le_buffer_view_type::eVertex;
+
+	views[ 2 ].buffer_idx  = buffer_idx;
+	views[ 2 ].byte_offset = offsetof( vertex_data_t, indices );
+	views[ 2 ].byte_length = sizeof( data.indices );
+	views[ 2 ].type        = le_buffer_view_type::eIndex;
+
+	le_accessor_info accessors[ 3 ]{};
+
+	accessors[ 0 ].component_type  = le_num_type::eF32;
+	accessors[ 0 ].type            = le_compound_num_type::eVec3;
+	accessors[ 0 ].count           = 24;
+	accessors[ 0 ].buffer_view_idx = le_stage_i.create_buffer_view( stage, &views[ 0 ] );
+	accessors[ 0 ].has_min         = true; // positions must have bounds, so that nodes may be culled
+	accessors[ 0 ].has_max         = true;
+
+	for ( int i = 0; i != 3; i++ ) {
+		accessors[ 0 ].min[ i ] = -0.5f;
+		accessors[ 0 ].max[ i ] = 0.5f;
+	}
+
+	accessors[ 1 ].component_type  = le_num_type::eF32;
+	accessors[ 1 ].type            = le_compound_num_type::eVec3;
+	accessors[ 1 ].count           = 24;
+	accessors[ 1 ].buffer_view_idx = le_stage_i.create_buffer_view( stage, &views[ 1 ] );
+
+	accessors[ 2 ].component_type  = le_num_type::eU16;
+	accessors[ 2 ].type            = le_compound_num_type::eScalar;
+	accessors[ 2 ].count           = 36;
+	accessors[ 2 ].buffer_view_idx = le_stage_i.create_buffer_view( stage, &views[ 2 ] );
+
+	le_primitive_attribute_info attributes[ 2 ]{};
+
+	attributes[ 0 ].accessor_idx = le_stage_i.create_accessor( stage, &accessors[ 0 ] );
+	attributes[ 0 ].type         = le_primitive_attribute_info::Type::ePosition;
+
+	attributes[ 1 ].accessor_idx = le_stage_i.create_accessor( stage, &accessors[ 1 ] );
+	attributes[ 1 ].type         = le_primitive_attribute_info::Type::eNormal;
+
+	le_primitive_info primitive{};
+	primitive.indices_accessor_idx = le_stage_i.create_accessor( stage, &accessors[ 2 ] );
+	primitive.has_indices          = true;
+	primitive.attributes           = attributes;
+	primitive.attributes_count     = 2;
+
+	le_mesh_info mesh{};
+	mesh.primitives      = &primitive;
+	mesh.primitive_count = 1;
+
+	return le_stage_i.create_mesh( stage, &mesh );
+}
+
+// ----------------------------------------------------------------------
+// Adds a scene with a grid of cubes to the stage - all cubes share the same mesh, so that
+// they may be drawn as instances of one draw.
+static void stage_create_cube_grid( le_stage_o* stage, uint32_t mesh_idx ) {
+
+	using namespace le_stage;
+
+	std::vector<glm_vec3_t>   translations( GRID_SIZE * GRID_SIZE );
+	std::vector<glm_quat_t>   rotations( GRID_SIZE * GRID_SIZE, { glm::quat( 1, 0, 0, 0 ) } );
+	std::vector<glm_vec3_t>   scales( GRID_SIZE * GRID_SIZE, { glm::vec3( 1 ) } );
+	std::vector<glm_mat4_t>   transforms( GRID_SIZE * GRID_SIZE );
+	std::vector<le_node_info> nodes( GRID_SIZE * GRID_SIZE );
+
+	float const offset = 0.5f * GRID_SPACING * float( GRID_SIZE - 1 );
+
+	for ( uint32_t i = 0; i != nodes.size(); i++ ) {
+		translations[ i ].data = glm::vec3( float( i % GRID_SIZE ) * GRID_SPACING - offset, 0, float( i / GRID_SIZE ) * GRID_SPACING - offset );
+		transforms[ i ].data   = glm::translate( glm::mat4( 1 ), translations[ i ].data );
+
+		nodes[ i ].mesh              = mesh_idx;
+		nodes[ i ].has_mesh          = true;
+		nodes[ i ].local_translation = &translations[ i ];
+		nodes[ i ].local_rotation    = &rotations[ i ];
+		nodes[ i ].local_scale       = &scales[ i ];
+		nodes[ i ].local_transform   = &transforms[ i ];
+	}
+
+	uint32_t const first_node_idx = le_stage_i.create_nodes( stage, nodes.data(), nodes.size() );
+
+	std::vector<uint32_t> node_indices( nodes.size() );
+	for ( uint32_t i = 0; i != node_indices.size(); i++ ) {
+		node_indices[ i ] = first_node_idx + i;
+	}
+
+	le_stage_i.create_scene( stage, node_indices.data(), uint32_t( node_indices.size() ) );
+}
+
+// ----------------------------------------------------------------------
+
+static app_o* app_create() {
+	auto app = new ( app_o );
+
+	using namespace le_stage;
+
+	app->stage = new LeStage( app->renderer );
+
+	// We must enable GPU-driven drawing before the renderer is set up: this is
+	// when the backend requests indirect draw features from the device.
+	le_stage_i.set_gpu_driven( *app->stage, true );
+
+	app->renderer.setup(
+	    le::RendererInfoBuilder()
+	        .addSwapchain()
+	        .setWidthHint( 640 )
+	        .setHeightHint( 480 )
+	        .asImgSwapchain()
+	        .setPipeCmd( IMG_SWAPCHAIN_PIPE_CMD )
+	        .end()
+	        .end()
+	        .build() );
+
+	if ( !le_backend_vk::settings_i.get_indirect_draws_enabled() ) {
+		logger.warn( "Device does not support indirect draws - both modes will draw on the CPU." );
+	}
+
+	// We first draw on the CPU - see app_update.
+	le_stage_i.set_gpu_driven( *app->stage, false );
+
+	stage_create_cube_grid( *app->stage, stage_create_cube_mesh( *app->stage ) );
+	le_stage_i.setup_pipelines( *app->stage );
+
+	// Set up the camera so that it looks at the grid from above, at an angle - this leaves
+	// cubes at the far edges of the grid outside the frustum.
+	le::Extent2D extents{};
+	app->renderer.getSwapchainExtent( &extents.width, &extents.height );
+	app->camera.setViewport( { 0, 0, float( extents.width ), float( extents.height ), 0.f, 1.f } );
+	app->camera.setFovRadians( glm::radians( 60.f ) );
+	app->camera.setClipDistances( 1.f, 1000.f );
+	glm::mat4 camMatrix = glm::lookAt( glm::vec3{ 0, 20, 40 }, glm::vec3{ 0 }, glm::vec3{ 0, 1, 0 } );
+	app->camera.setViewMatrix( ( float* )( &camMatrix ) );
+
+	app->draw_params = { *app->stage, app->camera };
+
+	return app;
+}
+
+// ----------------------------------------------------------------------
+
+static void app_print_draw_stats( app_o* self, char const* mode ) {
+	le_stage_draw_stats_t stats{};
+	le_stage::le_stage_i.get_draw_stats( *self->stage, &stats );
+
+	logger.info( "%-12s: nodes visible: %5d, nodes culled: %5d, primitives: %5d, draw calls: %5d, pipeline binds: %5d",
+	             mode, stats.num_nodes_visible, stats.num_nodes_culled, stats.num_primitives, stats.num_draw_calls, stats.num_pipeline_binds );
+}
+
+// ----------------------------------------------------------------------
+
+static bool app_update( app_o* self ) {
+
+	using namespace le_stage;
+
+	if ( self->frame_counter == FRAMES_PER_MODE ) {
+		app_print_draw_stats( self, "CPU" );
+		le_stage_i.set_gpu_driven( *self->stage, true );
+	} else if ( self->frame_counter == 2 * FRAMES_PER_MODE ) {
+		app_print_draw_stats( self, "GPU-driven" );
+		return false; // we're done
+	}
+
+	self->stage->update();
+
+	static le_img_resource_handle LE_SWAPCHAIN_IMAGE_HANDLE = self->renderer.getSwapchainResource();
+	static le_img_resource_handle LE_DEPTH_IMAGE_HANDLE     = LE_IMG_RESOURCE( "DEPTH_BUFFER" );
+
+	le::RenderGraph renderGraph{};
+
+	le_stage_i.update_rendermodule( *self->stage, renderGraph );
+	le_stage_i.draw_into_module( &self->draw_params, renderGraph, LE_SWAPCHAIN_IMAGE_HANDLE, LE_DEPTH_IMAGE_HANDLE );
+
+	renderGraph
+	    .declareResource( LE_DEPTH_IMAGE_HANDLE, le::ImageInfoBuilder().addUsageFlags( le::ImageUsageFlags( le::ImageUsageFlagBits::eDepthStencilAttachment ) ).build() ) //
+	    ;
+
+	self->renderer.update( renderGraph );
+
+	self->frame_counter++;
+
+	return true; // keep app alive
+}
+
+// ----------------------------------------------------------------------
+
+static void app_destroy( app_o* self ) {
+	delete self->stage; // stage must go before renderer
+	delete ( self );
+}
+
+// ----------------------------------------------------------------------
+
+LE_MODULE_REGISTER_IMPL( gpu_draws_example_app, api ) {
+
+	auto  gpu_draws_example_app_api_i = static_cast<gpu_draws_example_app_api*>( api );
+	auto& gpu_draws_example_app_i     = gpu_draws_example_app_api_i->gpu_draws_example_app_i;
+
+	gpu_draws_example_app_i.initialize = app_initialize;
+	gpu_draws_example_app_i.terminate  = app_terminate;
+
+	gpu_draws_example_app_i.create  = app_create;
+	gpu_draws_example_app_i.destroy = app_destroy;
+	gpu_draws_example_app_i.update  = app_update;
+}
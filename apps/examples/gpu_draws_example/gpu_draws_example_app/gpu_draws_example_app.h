@@ -0,0 +1,61 @@
+#ifndef GUARD_gpu_draws_example_app_H
+#define GUARD_gpu_draws_example_app_H
+
+#include "le_core.h"
+
+struct gpu_draws_example_app_o;
+
+// clang-format off
+struct gpu_draws_example_app_api {
+
+	struct gpu_draws_example_app_interface_t {
+		gpu_draws_example_app_o * ( *create     )();
+		void                      ( *destroy    )( gpu_draws_example_app_o *self );
+		bool                      ( *update     )( gpu_draws_example_app_o *self );
+		void                      ( *initialize )(); // static methods
+		void                      ( *terminate  )(); // static methods
+	};
+
+	gpu_draws_example_app_interface_t gpu_draws_example_app_i;
+};
+// clang-format on
+
+LE_MODULE( gpu_draws_example_app );
+LE_MODULE_LOAD_DEFAULT( gpu_draws_example_app );
+
+#ifdef __cplusplus
+
+namespace gpu_draws_example_app {
+static const auto& api                     = gpu_draws_example_app_api_i;
+static const auto& gpu_draws_example_app_i = api -> gpu_draws_example_app_i;
+} // namespace gpu_draws_example_app
+
+class GpuDrawsExampleApp : NoCopy, NoMove {
+
+	gpu_draws_example_app_o* self;
+
+  public:
+	GpuDrawsExampleApp()
+	    : self( gpu_draws_example_app::gpu_draws_example_app_i.create() ) {
+	}
+
+	bool update() {
+		return gpu_draws_example_app::gpu_draws_example_app_i.update( self );
+	}
+
+	~GpuDrawsExampleApp() {
+		gpu_draws_example_app::gpu_draws_example_app_i.destroy( self );
+	}
+
+	static void initialize() {
+		gpu_draws_example_app::gpu_draws_example_app_i.initialize();
+	}
+
+	static void terminate() {
+		gpu_draws_example_app::gpu_draws_example_app_i.terminate();
+	}
+};
+
+#endif
+
+#endif // GUARD_gpu_draws_example_app_H
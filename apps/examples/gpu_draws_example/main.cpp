@@ -0,0 +1,33 @@
+#include "gpu_draws_example_app/gpu_draws_example_app.h"
+
+// ----------------------------------------------------------------------
+
+int main( int argc, char const* argv[] ) {
+
+	GpuDrawsExampleApp::initialize();
+
+	{
+		// We instantiate GpuDrawsExampleApp in its own scope - so that
+		// it will be destroyed before GpuDrawsExampleApp::terminate
+		// is called.
+
+		GpuDrawsExampleApp GpuDrawsExampleApp{};
+
+		for ( ;; ) {
+
+#ifdef PLUGINS_DYNAMIC
+			le_core_poll_for_module_reloads();
+#endif
+			auto result = GpuDrawsExampleApp.update();
+
+			if ( !result ) {
+				break;
+			}
+		}
+	}
+
+	// Must only be called once last GpuDrawsExampleApp is destroyed
+	GpuDrawsExampleApp::terminate();
+
+	return 0;
+}
@@ -0,0 +1,165 @@
+#include "latency_example_app.h"
+
+#include "le_renderer.hpp"
+#include "le_log.h"
+
+// Measures input latency for both frame pacing modes: tags every frame with the time at
+// which the app would have polled input, and prints `get_latency_stats` once per second.
+// Renders headless, into an image swapchain which discards frames, so that this may run
+// without a display.
+//
+// Frame pacing is a renderer setting - we therefore create a new renderer for each mode.
+
+static constexpr uint32_t FRAMES_PER_REPORT  = 60; // frames between latency reports
+static constexpr uint32_t REPORTS_PER_PACING = 4;  // latency reports per frame pacing mode
+
+// Consumes frames without writing them anywhere - the default pipe command would write a video.
+static constexpr auto IMG_SWAPCHAIN_PIPE_CMD = "ffmpeg -f rawvideo -pix_fmt %s -s %dx%d -i - -f null -";
+
+static constexpr le::FramePacing FRAME_PACING_MODES[] = {
+    le::FramePacing::eThroughput,
+    le::FramePacing::eLowLatency,
+};
+
+struct latency_example_app_o {
+	le::Renderer* renderer      = nullptr;
+	size_t        pacing_idx    = 0; // index into FRAME_PACING_MODES
+	uint64_t      frame_counter = 0; // frames rendered with the current renderer
+};
+
+typedef latency_example_app_o app_o;
+
+static auto logger = LeLog( "latency_example_app" );
+
+// ----------------------------------------------------------------------
+
+static void app_initialize(){};
+
+// ----------------------------------------------------------------------
+
+static void app_terminate(){};
+
+// ----------------------------------------------------------------------
+
+static char const* frame_pacing_name( le::FramePacing frame_pacing ) {
+	switch ( frame_pacing ) {
+	case le::FramePacing::eThroughput:
+		return "throughput";
+	case le::FramePacing::eLowLatency:
+		return "low latency";
+	}
+	return "unknown";
+}
+
+// ----------------------------------------------------------------------
+// Creates a renderer which uses the frame pacing mode at `self->pacing_idx`.
+static void app_setup_renderer( app_o* self ) {
+
+	delete self->renderer; // waits for frames in flight, and releases all resources
+
+	self->renderer      = new le::Renderer();
+	self->frame_counter = 0;
+
+	self->renderer->setup(
+	    le::RendererInfoBuilder()
+	        .setFramePacing( FRAME_PACING_MODES[ self->pacing_idx ] )
+	        .addSwapchain()
+	        .setWidthHint( 640 )
+	        .setHeightHint( 480 )
+	        .asImgSwapchain()
+	        .setPipeCmd( IMG_SWAPCHAIN_PIPE_CMD )
+	        .end()
+	        .end()
+	        .build() );
+
+	logger.info( "Frame pacing: %s", frame_pacing_name( FRAME_PACING_MODES[ self->pacing_idx ] ) );
+}
+
+// ----------------------------------------------------------------------
+
+static app_o* app_create() {
+	auto app = new ( app_o );
+	app_setup_renderer( app );
+	return app;
+}
+
+// ----------------------------------------------------------------------
+
+static void pass_main_exec( le_command_buffer_encoder_o* encoder_, void* user_data ) {
+	// Nothing to draw - the renderpass clears the swapchain image.
+}
+
+// ----------------------------------------------------------------------
+
+static bool app_update( app_o* self ) {
+
+	using namespace le_renderer;
+
+	// Tag the frame which we're about to record with the current time - this is
+	// where an interactive app would poll for input events.
+	renderer_i.set_input_timestamp( *self->renderer, 0 );
+
+	le_img_resource_handle swapchain_image = self->renderer->getSwapchainResource();
+
+	float const t = float( self->frame_counter % FRAMES_PER_REPORT ) / float( FRAMES_PER_REPORT );
+
+	le::RenderGraph renderGraph{};
+	{
+		auto renderPassFinal =
+		    le::RenderPass( "root", le::QueueFlagBits::eGraphics )
+		        .addColorAttachment(
+		            swapchain_image,
+		            le::ImageAttachmentInfoBuilder()
+		                .setColorClearValue( le::ClearValue( { t, t, t, 1.f } ) )
+		                .build() )
+		        .setExecuteCallback( self, pass_main_exec ) //
+		    ;
+
+		renderGraph.addRenderPass( renderPassFinal );
+	}
+
+	self->renderer->update( renderGraph );
+
+	self->frame_counter++;
+
+	if ( self->frame_counter % FRAMES_PER_REPORT == 0 ) {
+		le_renderer_latency_stats_t stats{};
+		renderer_i.get_latency_stats( *self->renderer, &stats );
+
+		logger.info( "%-11s: frames: %3d, input to dispatch: avg %6.2fms, max %6.2fms, input to complete: avg %6.2fms, max %6.2fms",
+		             frame_pacing_name( FRAME_PACING_MODES[ self->pacing_idx ] ), stats.num_frames,
+		             stats.input_to_dispatch_ms_avg, stats.input_to_dispatch_ms_max,
+		             stats.input_to_complete_ms_avg, stats.input_to_complete_ms_max );
+	}
+
+	if ( self->frame_counter == FRAMES_PER_REPORT * REPORTS_PER_PACING ) {
+		if ( ++self->pacing_idx == sizeof( FRAME_PACING_MODES ) / sizeof( FRAME_PACING_MODES[ 0 ] ) ) {
+			return false; // we're done
+		}
+		app_setup_renderer( self );
+	}
+
+	return true; // keep app alive
+}
+
+// ----------------------------------------------------------------------
+
+static void app_destroy( app_o* self ) {
+	delete self->renderer;
+	delete ( self );
+}
+
+// ----------------------------------------------------------------------
+
+LE_MODULE_REGISTER_IMPL( latency_example_app, api ) {
+
+	auto  latency_example_app_api_i = static_cast<latency_example_app_api*>( api );
+	auto& latency_example_app_i     = latency_example_app_api_i->latency_example_app_i;
+
+	latency_example_app_i.initialize = app_initialize;
+	latency_example_app_i.terminate  = app_terminate;
+
+	latency_example_app_i.create  = app_create;
+	latency_example_app_i.destroy = app_destroy;
+	latency_example_app_i.update  = app_update;
+}
@@ -0,0 +1,61 @@
+#ifndef GUARD_latency_example_app_H
+#define GUARD_latency_example_app_H
+
+#include "le_core.h"
+
+struct latency_example_app_o;
+
+// clang-format off
+struct latency_example_app_api {
+
+	struct latency_example_app_interface_t {
+		latency_example_app_o * ( *create     )();
+		void                    ( *destroy    )( latency_example_app_o *self );
+		bool                    ( *update     )( latency_example_app_o *self );
+		void                    ( *initialize )(); // static methods
+		void                    ( *terminate  )(); // static methods
+	};
+
+	latency_example_app_interface_t latency_example_app_i;
+};
+// clang-format on
+
+LE_MODULE( latency_example_app );
+LE_MODULE_LOAD_DEFAULT( latency_example_app );
+
+#ifdef __cplusplus
+
+namespace latency_example_app {
+static const auto& api                   = latency_example_app_api_i;
+static const auto& latency_example_app_i = api -> latency_example_app_i;
+} // namespace latency_example_app
+
+class LatencyExampleApp : NoCopy, NoMove {
+
+	latency_example_app_o* self;
+
+  public:
+	LatencyExampleApp()
+	    : self( latency_example_app::latency_example_app_i.create() ) {
+	}
+
+	bool update() {
+		return latency_example_app::latency_example_app_i.update( self );
+	}
+
+	~LatencyExampleApp() {
+		latency_example_app::latency_example_app_i.destroy( self );
+	}
+
+	static void initialize() {
+		latency_example_app::latency_example_app_i.initialize();
+	}
+
+	static void terminate() {
+		latency_example_app::latency_example_app_i.terminate();
+	}
+};
+
+#endif
+
+#endif // GUARD_latency_example_app_H
@@ -0,0 +1,33 @@
+#include "latency_example_app/latency_example_app.h"
+
+// ----------------------------------------------------------------------
+
+int main( int argc, char const* argv[] ) {
+
+	LatencyExampleApp::initialize();
+
+	{
+		// We instantiate LatencyExampleApp in its own scope - so that
+		// it will be destroyed before LatencyExampleApp::terminate
+		// is called.
+
+		LatencyExampleApp LatencyExampleApp{};
+
+		for ( ;; ) {
+
+#ifdef PLUGINS_DYNAMIC
+			le_core_poll_for_module_reloads();
+#endif
+			auto result = LatencyExampleApp.update();
+
+			if ( !result ) {
+				break;
+			}
+		}
+	}
+
+	// Must only be called once last LatencyExampleApp is destroyed
+	LatencyExampleApp::terminate();
+
+	return 0;
+}
@@ -0,0 +1,33 @@
+#include "test_path_simd_app/test_path_simd_app.h"
+
+// ----------------------------------------------------------------------
+
+int main( int argc, char const* argv[] ) {
+
+	TestPathSimdApp::initialize();
+
+	{
+		// We instantiate TestPathSimdApp in its own scope - so that
+		// it will be destroyed before TestPathSimdApp::terminate
+		// is called.
+
+		TestPathSimdApp TestPathSimdApp{};
+
+		for ( ;; ) {
+
+#ifdef PLUGINS_DYNAMIC
+			le_core_poll_for_module_reloads();
+#endif
+			auto result = TestPathSimdApp.update();
+
+			if ( !result ) {
+				break;
+			}
+		}
+	}
+
+	// Must only be called once last TestPathSimdApp is destroyed
+	TestPathSimdApp::terminate();
+
+	return 0;
+}
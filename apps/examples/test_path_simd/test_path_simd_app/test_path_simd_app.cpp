@@ -0,0 +1,273 @@
+#include "test_path_simd_app.h"
+#include "le_log.h"
+#include "le_path.h"
+
+#include "glm/glm.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <random>
+
+// Tests `flatten_uniform`, which evaluates cubic bezier curves using SIMD (AVX2, or SSE),
+// against a scalar reference which evaluates the same curves in Bernstein form, in double
+// precision. We test curves with a range of tolerances, so that segment counts cover
+// full SIMD lanes as well as leftovers which go through the scalar loop.
+//
+// Arcs are flattened using SIMD, too - we test these by drawing arcs of ellipses with
+// known centre, radii, and rotation, and checking that all vertices lie on the ellipse,
+// that tangents are perpendicular to the ellipse's gradient, and that no segment deviates
+// from the ellipse by more than the tolerance.
+
+struct test_path_simd_app_o {
+	uint32_t num_curves_tested = 0;
+	uint32_t num_failures      = 0;
+};
+
+typedef test_path_simd_app_o app_o;
+
+static auto logger = LeLog( "test_path_simd_app" );
+
+// ----------------------------------------------------------------------
+
+static void app_initialize(){};
+
+// ----------------------------------------------------------------------
+
+static void app_terminate(){};
+
+// ----------------------------------------------------------------------
+
+static test_path_simd_app_o* test_path_simd_app_create() {
+	auto app = new ( test_path_simd_app_o );
+	return app;
+}
+
+// ----------------------------------------------------------------------
+// Scalar reference: point on cubic bezier, and its first derivative, at t.
+static void bezier_reference( glm::dvec2 const* b, double t, glm::dvec2* point, glm::dvec2* tangent ) {
+	double const s = 1.0 - t;
+
+	*point   = s * s * s * b[ 0 ] + 3.0 * s * s * t * b[ 1 ] + 3.0 * s * t * t * b[ 2 ] + t * t * t * b[ 3 ];
+	*tangent = 3.0 * ( s * s * ( b[ 1 ] - b[ 0 ] ) + 2.0 * s * t * ( b[ 2 ] - b[ 1 ] ) + t * t * ( b[ 3 ] - b[ 2 ] ) );
+}
+
+// ----------------------------------------------------------------------
+// Returns false if any vertex, or tangent deviates from the reference by more than
+// a small fraction of the curve's extent.
+static bool test_curve( glm::vec2 const ( &b )[ 4 ], float tolerance ) {
+
+	le::Path path;
+	path.moveTo( b[ 0 ] );
+	path.cubicBezierTo( b[ 3 ], b[ 1 ], b[ 2 ] );
+	path.flattenUniform( tolerance );
+
+	if ( path.getNumPolylines() != 1 ) {
+		logger.error( "Expected 1 polyline, got %zu", path.getNumPolylines() );
+		return false;
+	}
+
+	size_t num_vertices = 0;
+	path.getVerticesForPolyline( 0, nullptr, &num_vertices );
+	std::vector<glm::vec2> vertices( num_vertices );
+	path.getVerticesForPolyline( 0, vertices.data(), &num_vertices );
+
+	size_t num_tangents = 0;
+	path.getTangentsForPolyline( 0, nullptr, &num_tangents );
+	std::vector<glm::vec2> tangents( num_tangents );
+	path.getTangentsForPolyline( 0, tangents.data(), &num_tangents );
+
+	if ( num_vertices < 2 || num_tangents < num_vertices - 1 ) {
+		logger.error( "Unexpected number of vertices (%zu), or tangents (%zu)", num_vertices, num_tangents );
+		return false;
+	}
+
+	// First vertex is the start point - the curve contributes the remaining vertices,
+	// and the last tangents.
+	size_t const n               = num_vertices - 1;
+	size_t const first_tangent   = num_tangents - n;
+	glm::dvec2   bd[ 4 ]         = { glm::dvec2( b[ 0 ] ), glm::dvec2( b[ 1 ] ), glm::dvec2( b[ 2 ] ), glm::dvec2( b[ 3 ] ) };
+	double       extent          = 0;
+	double       max_point_err   = 0;
+	double       max_tangent_err = 0;
+
+	for ( auto const& p : bd ) {
+		extent = std::max( { extent, std::abs( p.x ), std::abs( p.y ) } );
+	}
+
+	for ( size_t i = 0; i != n; i++ ) {
+		glm::dvec2 point, tangent;
+		bezier_reference( bd, double( i + 1 ) / double( n ), &point, &tangent );
+
+		max_point_err   = std::max( max_point_err, glm::length( point - glm::dvec2( vertices[ i + 1 ] ) ) );
+		max_tangent_err = std::max( max_tangent_err, glm::length( tangent - glm::dvec2( tangents[ first_tangent + i ] ) ) );
+	}
+
+	// Tangents are scaled by the curve's size, and so must be their error bound.
+	double const max_err = 1e-5 * ( 1.0 + extent );
+
+	if ( max_point_err > max_err || max_tangent_err > 3 * max_err ) {
+		logger.error( "Curve with %zu segments deviates from reference: max point error: %f, max tangent error: %f",
+		              n, max_point_err, max_tangent_err );
+		return false;
+	}
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+// Returns false if any vertex of the flattened arc lies off the ellipse given by `centre`,
+// `radii`, and rotation `phi`, or if any segment's midpoint deviates by more than `tolerance`.
+static bool test_arc( glm::vec2 const& centre, glm::vec2 const& radii, float phi, float angle_start, float angle_delta, float tolerance ) {
+
+	// le_path builds its arc basis from rows ( cos phi, -sin phi ), and ( sin phi, cos phi ),
+	// which means that the ellipse's x-axis is rotated by -phi.
+	glm::dvec2 const x_axis{ cos( double( phi ) ), -sin( double( phi ) ) };
+	glm::dvec2 const y_axis{ -x_axis.y, x_axis.x };
+
+	auto point_on_ellipse = [ & ]( double angle ) -> glm::vec2 {
+		return glm::vec2( glm::dvec2( centre ) + x_axis * ( double( radii.x ) * cos( angle ) ) + y_axis * ( double( radii.y ) * sin( angle ) ) );
+	};
+
+	// Distance from ellipse, approximated by the ellipse's implicit function, scaled by
+	// the smaller radius so that it is roughly in the same units as our vertices.
+	auto distance_from_ellipse = [ & ]( glm::vec2 const& p ) -> double {
+		glm::dvec2 const d  = glm::dvec2( p ) - glm::dvec2( centre );
+		double const     u  = glm::dot( d, x_axis ) / double( radii.x );
+		double const     v  = glm::dot( d, y_axis ) / double( radii.y );
+		double const     r  = std::min( radii.x, radii.y );
+		return std::abs( sqrt( u * u + v * v ) - 1.0 ) * r;
+	};
+
+	glm::vec2 const p0 = point_on_ellipse( angle_start );
+	glm::vec2 const p1 = point_on_ellipse( double( angle_start ) + double( angle_delta ) );
+
+	le::Path path;
+	path.moveTo( p0 );
+	path.arcTo( p1, radii, phi, fabsf( angle_delta ) > glm::pi<float>(), angle_delta > 0 );
+	path.flattenUniform( tolerance );
+
+	size_t num_vertices = 0;
+	path.getVerticesForPolyline( 0, nullptr, &num_vertices );
+	std::vector<glm::vec2> vertices( num_vertices );
+	path.getVerticesForPolyline( 0, vertices.data(), &num_vertices );
+
+	size_t num_tangents = 0;
+	path.getTangentsForPolyline( 0, nullptr, &num_tangents );
+	std::vector<glm::vec2> tangents( num_tangents );
+	path.getTangentsForPolyline( 0, tangents.data(), &num_tangents );
+
+	if ( num_vertices < 2 || num_tangents < num_vertices - 1 ) {
+		logger.error( "Unexpected number of vertices (%zu), or tangents (%zu)", num_vertices, num_tangents );
+		return false;
+	}
+
+	size_t const n               = num_vertices - 1;
+	size_t const first_tangent   = num_tangents - n;
+	double       extent          = std::max( { std::abs( centre.x ), std::abs( centre.y ), radii.x, radii.y } );
+	double const max_err         = 1e-5 * ( 1.0 + extent );
+	double       max_point_err   = 0;
+	double       max_tangent_err = 0;
+	double       max_chord_err   = 0;
+
+	for ( size_t i = 0; i != n; i++ ) {
+		glm::vec2 const& v = vertices[ i + 1 ];
+
+		max_point_err = std::max( max_point_err, distance_from_ellipse( v ) );
+
+		// Tangent must be perpendicular to the gradient of the ellipse's implicit function.
+		glm::dvec2 const d        = glm::dvec2( v ) - glm::dvec2( centre );
+		glm::dvec2 const gradient = x_axis * ( glm::dot( d, x_axis ) / double( radii.x * radii.x ) ) +
+		                            y_axis * ( glm::dot( d, y_axis ) / double( radii.y * radii.y ) );
+		glm::dvec2 const tangent  = glm::dvec2( tangents[ first_tangent + i ] );
+
+		max_tangent_err = std::max( max_tangent_err, std::abs( glm::dot( glm::normalize( gradient ), glm::normalize( tangent ) ) ) );
+
+		// Segment midpoints lie inside the ellipse - they must not be further away than tolerance.
+		max_chord_err = std::max( max_chord_err, distance_from_ellipse( ( vertices[ i ] + v ) * 0.5f ) );
+	}
+
+	// Tangent error is measured against the gradient at float vertex positions, which for
+	// very eccentric ellipses is sensitive to rounding - we allow for this.
+	if ( max_point_err > max_err || max_tangent_err > 1e-2 || max_chord_err > tolerance * 1.01 + max_err ) {
+		logger.error( "Arc with %zu segments deviates from ellipse: max point error: %f, max tangent error: %f, max chord error: %f (tolerance: %f)",
+		              n, max_point_err, max_tangent_err, max_chord_err, tolerance );
+		return false;
+	}
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+
+static bool test_path_simd_app_update( test_path_simd_app_o* self ) {
+
+	std::mt19937                          rng( 1 ); // fixed seed, so that runs are repeatable
+	std::uniform_real_distribution<float> coord( -500.f, 500.f );
+
+	float const tolerances[] = { 10.f, 2.f, 0.5f, 0.25f, 0.1f, 0.01f };
+
+	for ( int i = 0; i != 200; i++ ) {
+		glm::vec2 const b[ 4 ] = {
+		    { coord( rng ), coord( rng ) },
+		    { coord( rng ), coord( rng ) },
+		    { coord( rng ), coord( rng ) },
+		    { coord( rng ), coord( rng ) },
+		};
+
+		for ( float tolerance : tolerances ) {
+			self->num_curves_tested++;
+			if ( !test_curve( b, tolerance ) ) {
+				self->num_failures++;
+			}
+		}
+	}
+
+	std::uniform_real_distribution<float> radius( 1.f, 400.f );
+	std::uniform_real_distribution<float> angle( -glm::pi<float>(), glm::pi<float>() );
+	std::uniform_real_distribution<float> sweep( 0.1f, 1.9f * glm::pi<float>() );
+
+	for ( int i = 0; i != 200; i++ ) {
+		glm::vec2 const centre{ coord( rng ), coord( rng ) };
+		glm::vec2 const radii{ radius( rng ), radius( rng ) };
+		float const     phi         = angle( rng );
+		float const     angle_start = angle( rng );
+		float const     angle_delta = ( i % 2 ? 1.f : -1.f ) * sweep( rng ); // alternate sweep direction
+
+		for ( float tolerance : tolerances ) {
+			self->num_curves_tested++;
+			if ( !test_arc( centre, radii, phi, angle_start, angle_delta, tolerance ) ) {
+				self->num_failures++;
+			}
+		}
+	}
+
+	if ( self->num_failures ) {
+		logger.error( "FAILED: %d of %d curves, and arcs deviate from reference", self->num_failures, self->num_curves_tested );
+	} else {
+		logger.info( "PASSED: %d curves, and arcs match reference", self->num_curves_tested );
+	}
+
+	return false; // we only run once
+}
+
+// ----------------------------------------------------------------------
+
+static void test_path_simd_app_destroy( test_path_simd_app_o* self ) {
+	delete ( self );
+}
+
+// ----------------------------------------------------------------------
+
+LE_MODULE_REGISTER_IMPL( test_path_simd_app, api ) {
+
+	auto  test_path_simd_app_api_i = static_cast<test_path_simd_app_api*>( api );
+	auto& test_path_simd_app_i     = test_path_simd_app_api_i->test_path_simd_app_i;
+
+	test_path_simd_app_i.initialize = app_initialize;
+	test_path_simd_app_i.terminate  = app_terminate;
+
+	test_path_simd_app_i.create  = test_path_simd_app_create;
+	test_path_simd_app_i.destroy = test_path_simd_app_destroy;
+	test_path_simd_app_i.update  = test_path_simd_app_update;
+}
@@ -0,0 +1,61 @@
+#ifndef GUARD_test_path_simd_app_H
+#define GUARD_test_path_simd_app_H
+
+#include "le_core.h"
+
+struct test_path_simd_app_o;
+
+// clang-format off
+struct test_path_simd_app_api {
+
+	struct test_path_simd_app_interface_t {
+		test_path_simd_app_o * ( *create               )();
+		void         ( *destroy                  )( test_path_simd_app_o *self );
+		bool         ( *update                   )( test_path_simd_app_o *self );
+		void         ( *initialize               )(); // static methods
+		void         ( *terminate                )(); // static methods
+	};
+
+	test_path_simd_app_interface_t test_path_simd_app_i;
+};
+// clang-format on
+
+LE_MODULE( test_path_simd_app );
+LE_MODULE_LOAD_DEFAULT( test_path_simd_app );
+
+#ifdef __cplusplus
+
+namespace test_path_simd_app {
+static const auto& api            = test_path_simd_app_api_i;
+static const auto& test_path_simd_app_i = api -> test_path_simd_app_i;
+} // namespace test_path_simd_app
+
+class TestPathSimdApp : NoCopy, NoMove {
+
+	test_path_simd_app_o* self;
+
+  public:
+	TestPathSimdApp()
+	    : self( test_path_simd_app::test_path_simd_app_i.create() ) {
+	}
+
+	bool update() {
+		return test_path_simd_app::test_path_simd_app_i.update( self );
+	}
+
+	~TestPathSimdApp() {
+		test_path_simd_app::test_path_simd_app_i.destroy( self );
+	}
+
+	static void initialize() {
+		test_path_simd_app::test_path_simd_app_i.initialize();
+	}
+
+	static void terminate() {
+		test_path_simd_app::test_path_simd_app_i.terminate();
+	}
+};
+
+#endif
+
+#endif // GUARD_test_path_simd_app_H
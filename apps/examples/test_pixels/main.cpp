@@ -0,0 +1,33 @@
+#include "test_pixels_app/test_pixels_app.h"
+
+// ----------------------------------------------------------------------
+
+int main( int argc, char const* argv[] ) {
+
+	TestPixelsApp::initialize();
+
+	{
+		// We instantiate TestPixelsApp in its own scope - so that
+		// it will be destroyed before TestPixelsApp::terminate
+		// is called.
+
+		TestPixelsApp TestPixelsApp{};
+
+		for ( ;; ) {
+
+#ifdef PLUGINS_DYNAMIC
+			le_core_poll_for_module_reloads();
+#endif
+			auto result = TestPixelsApp.update();
+
+			if ( !result ) {
+				break;
+			}
+		}
+	}
+
+	// Must only be called once last TestPixelsApp is destroyed
+	TestPixelsApp::terminate();
+
+	return 0;
+}
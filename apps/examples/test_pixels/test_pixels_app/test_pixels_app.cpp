@@ -0,0 +1,483 @@
+#include "test_pixels_app.h"
+#include "le_log.h"
+#include "le_pixels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+// Tests loading KTX2, and DDS container files via le_pixels: sample files from
+// ./local_resources/images must report the expected format, extents, mip levels, and
+// layers, and every subresource must point at the pixels for its own mip level, and
+// layer. Sample files are filled with blocks which start with a 16 bit marker,
+// `layer << 8 | mip_level`, so that we can tell subresources apart.
+//
+// We also patch sample file headers to claim impossible mip, or layer counts, or an image
+// too large for `le_pixels_info::byte_count` - le_pixels must reject these files. Rejected
+// files are logged as errors, which raise a breakpoint in Debug builds, which is why we
+// only run these tests in Release builds.
+//
+// Mip chains from `generate_mip_chain` are tested against a scalar reference, which
+// filters in double precision - this covers the SIMD filters, SSE by default, or AVX2
+// if le_pixels was compiled with LE_PIXELS_ENABLE_AVX2. Image sizes are chosen so that
+// rows cover full SIMD lanes as well as leftover, and clamped edge texels.
+
+struct container_sample_t {
+	char const* path;
+	uint32_t    format; // le::Format (== VkFormat)
+	uint32_t    width;
+	uint32_t    height;
+	uint32_t    num_mip_levels;
+	uint32_t    num_layers;
+};
+
+static constexpr uint32_t FORMAT_BC1_RGBA_UNORM_BLOCK = 133;
+static constexpr uint32_t FORMAT_BC3_UNORM_BLOCK      = 137;
+
+static container_sample_t const CONTAINER_SAMPLES[] = {
+    { "./local_resources/images/bc1_array_mips.ktx2", FORMAT_BC1_RGBA_UNORM_BLOCK, 16, 16, 5, 2 },
+    { "./local_resources/images/bc1_cube_mips_dx10.dds", FORMAT_BC1_RGBA_UNORM_BLOCK, 8, 8, 4, 6 },
+    { "./local_resources/images/bc3_legacy.dds", FORMAT_BC3_UNORM_BLOCK, 8, 4, 1, 1 },
+};
+
+struct mip_test_size_t {
+	uint32_t width;
+	uint32_t height;
+};
+
+static mip_test_size_t const MIP_TEST_SIZES[] = { { 64, 64 }, { 37, 23 }, { 130, 3 }, { 1, 17 }, { 256, 5 } };
+
+// Must match le_pixels' Kaiser filter.
+static constexpr int    KAISER_NUM_TAPS = 8;
+static constexpr int    KAISER_TAP_MIN  = -3;
+static constexpr double KAISER_ALPHA    = 4;
+
+// Byte offsets of header fields which we patch to create corrupt files.
+static constexpr size_t KTX2_OFFSET_PIXEL_WIDTH  = 20;
+static constexpr size_t KTX2_OFFSET_PIXEL_HEIGHT = 24;
+static constexpr size_t KTX2_OFFSET_LAYER_COUNT  = 32;
+static constexpr size_t KTX2_OFFSET_LEVEL_COUNT  = 40;
+static constexpr size_t DDS_OFFSET_ARRAY_SIZE    = 128 + 12; // in DX10 header, which follows the DDS header
+
+struct test_pixels_app_o {
+	uint32_t num_tests    = 0;
+	uint32_t num_failures = 0;
+};
+
+typedef test_pixels_app_o app_o;
+
+static auto logger = LeLog( "test_pixels_app" );
+
+// ----------------------------------------------------------------------
+
+static void app_initialize(){};
+
+// ----------------------------------------------------------------------
+
+static void app_terminate(){};
+
+// ----------------------------------------------------------------------
+
+static test_pixels_app_o* test_pixels_app_create() {
+	auto app = new ( test_pixels_app_o );
+	return app;
+}
+
+// ----------------------------------------------------------------------
+// Returns false if the container file at `sample.path` does not load as expected.
+static bool test_container_sample( container_sample_t const& sample ) {
+
+	using namespace le_pixels;
+
+	le_pixels_info info{};
+
+	if ( !le_pixels_i.get_info_from_file( sample.path, &info ) ) {
+		logger.error( "Could not read info for '%s' - are local resources linked?", sample.path );
+		return false;
+	}
+
+	if ( info.format != sample.format || info.width != sample.width || info.height != sample.height ||
+	     info.num_mip_levels != sample.num_mip_levels || info.num_layers != sample.num_layers ) {
+		logger.error( "'%s': unexpected info: format %u, %ux%u, %u mip levels, %u layers",
+		              sample.path, info.format, info.width, info.height, info.num_mip_levels, info.num_layers );
+		return false;
+	}
+
+	le_pixels_o* pixels = le_pixels_i.create( sample.path, 0, le_pixels_info::eUInt8 );
+
+	if ( pixels == nullptr ) {
+		logger.error( "'%s': could not load pixels", sample.path );
+		return false;
+	}
+
+	bool success = true;
+
+	le_pixels_subresource_t const* subresources     = nullptr;
+	size_t                         num_subresources = 0;
+
+	le_pixels_info const pixels_info = le_pixels_i.get_info( pixels );
+	auto const*          data        = static_cast<unsigned char const*>( le_pixels_i.get_data( pixels ) );
+
+	if ( pixels_info.byte_count != info.byte_count ) {
+		logger.error( "'%s': get_info_from_file reports %u bytes, but pixels hold %u bytes", sample.path, info.byte_count, pixels_info.byte_count );
+		success = false;
+	}
+
+	if ( !le_pixels_i.get_subresources( pixels, &subresources, &num_subresources ) ||
+	     num_subresources != size_t( sample.num_mip_levels ) * sample.num_layers ) {
+		logger.error( "'%s': expected %u subresources, got %zu", sample.path, sample.num_mip_levels * sample.num_layers, num_subresources );
+		success = false;
+		num_subresources = 0;
+	}
+
+	uint64_t byte_count = 0;
+
+	for ( auto s = subresources; s != subresources + num_subresources; s++ ) {
+
+		uint32_t const expected_width  = std::max<uint32_t>( 1, sample.width >> s->mip_level );
+		uint32_t const expected_height = std::max<uint32_t>( 1, sample.height >> s->mip_level );
+
+		if ( s->width != expected_width || s->height != expected_height ||
+		     s->byte_count < sizeof( uint16_t ) || s->offset + s->byte_count > pixels_info.byte_count ) {
+			logger.error( "'%s': mip level %u, layer %u: unexpected extents %ux%u, or range [%llu, +%llu)",
+			              sample.path, s->mip_level, s->layer, s->width, s->height,
+			              ( unsigned long long )s->offset, ( unsigned long long )s->byte_count );
+			success = false;
+			continue;
+		}
+
+		uint16_t marker;
+		memcpy( &marker, data + s->offset, sizeof( marker ) );
+
+		if ( marker != ( ( s->layer << 8 ) | s->mip_level ) ) {
+			logger.error( "'%s': mip level %u, layer %u: found pixels for mip level %u, layer %u",
+			              sample.path, s->mip_level, s->layer, marker & 0xff, marker >> 8 );
+			success = false;
+		}
+
+		byte_count += s->byte_count;
+	}
+
+	if ( success && byte_count != pixels_info.byte_count ) {
+		logger.error( "'%s': subresources hold %llu bytes, but pixels hold %u bytes", sample.path, ( unsigned long long )byte_count, pixels_info.byte_count );
+		success = false;
+	}
+
+	le_pixels_i.destroy( pixels );
+
+	return success;
+}
+
+// ----------------------------------------------------------------------
+// Returns binary (P6) ppm file contents, with random pixels.
+static std::vector<unsigned char> make_ppm( uint32_t width, uint32_t height, std::mt19937& rng ) {
+	std::string const          header = "P6\n" + std::to_string( width ) + " " + std::to_string( height ) + "\n255\n";
+	std::vector<unsigned char> contents( header.begin(), header.end() );
+	std::uniform_int_distribution<int> value( 0, 255 );
+	for ( size_t i = 0; i != size_t( width ) * height * 3; i++ ) {
+		contents.push_back( uint8_t( value( rng ) ) );
+	}
+	return contents;
+}
+
+// ----------------------------------------------------------------------
+
+static double bessel_i0( double x ) {
+	double sum  = 1;
+	double term = 1;
+	for ( int k = 1; k < 32; k++ ) {
+		term *= ( x / ( 2 * k ) ) * ( x / ( 2 * k ) );
+		sum += term;
+	}
+	return sum;
+}
+
+// ----------------------------------------------------------------------
+// Scalar reference: downsamples RGBA `src` by a factor of two, clamping to edge texels.
+static std::vector<double> downsample_reference( std::vector<double> const& src, uint32_t src_w, uint32_t src_h, le_pixels_api::MipFilter filter ) {
+
+	int const dst_w = int( std::max<uint32_t>( 1, src_w / 2 ) );
+	int const dst_h = int( std::max<uint32_t>( 1, src_h / 2 ) );
+
+	// Box filter: two taps, with weight 1/2 each, at 2*x, and 2*x+1.
+	std::vector<double> weights = { 0.5, 0.5 };
+	int                 tap_min = 0;
+
+	if ( filter == le_pixels_api::eMipFilterKaiser ) {
+		constexpr double PI = 3.14159265358979323846;
+		weights.assign( KAISER_NUM_TAPS, 0 );
+		tap_min    = KAISER_TAP_MIN;
+		double sum = 0;
+		for ( int i = 0; i != KAISER_NUM_TAPS; i++ ) {
+			double const d = ( KAISER_TAP_MIN + i ) - 0.5;
+			double const x = d / 2;
+			double const t = d / ( KAISER_NUM_TAPS / 2 );
+			weights[ i ]   = ( x == 0 ? 1 : sin( PI * x ) / ( PI * x ) ) * bessel_i0( KAISER_ALPHA * sqrt( std::max( 0., 1 - t * t ) ) ) / bessel_i0( KAISER_ALPHA );
+			sum += weights[ i ];
+		}
+		for ( auto& w : weights ) {
+			w /= sum;
+		}
+	}
+
+	std::vector<double> dst( size_t( dst_w ) * dst_h * 4, 0 );
+
+	for ( int y = 0; y != dst_h; y++ ) {
+		for ( int x = 0; x != dst_w; x++ ) {
+			for ( int ty = 0; ty != int( weights.size() ); ty++ ) {
+				int const sy = std::clamp( 2 * y + tap_min + ty, 0, int( src_h ) - 1 );
+				for ( int tx = 0; tx != int( weights.size() ); tx++ ) {
+					int const sx = std::clamp( 2 * x + tap_min + tx, 0, int( src_w ) - 1 );
+					for ( int c = 0; c != 4; c++ ) {
+						dst[ ( size_t( y ) * dst_w + x ) * 4 + c ] += weights[ ty ] * weights[ tx ] * src[ ( size_t( sy ) * src_w + sx ) * 4 + c ];
+					}
+				}
+			}
+		}
+	}
+
+	return dst;
+}
+
+// ----------------------------------------------------------------------
+// Returns false if any mip level deviates from the scalar reference.
+static bool test_mip_chain( uint32_t width, uint32_t height, le_pixels_api::MipFilter filter, std::mt19937& rng ) {
+
+	using namespace le_pixels;
+
+	char const* const filter_name = filter == le_pixels_api::eMipFilterKaiser ? "kaiser" : "box";
+
+	std::vector<unsigned char> const ppm    = make_ppm( width, height, rng );
+	le_pixels_o*                     pixels = le_pixels_i.create_from_memory( ppm.data(), ppm.size(), 4, le_pixels_info::eFloat32 );
+
+	if ( pixels == nullptr ) {
+		logger.error( "%ux%u: could not decode test image", width, height );
+		return false;
+	}
+
+	// We take the reference's first level from decoded pixels, so that it holds exactly the same values.
+	auto const*         base = static_cast<float const*>( le_pixels_i.get_data( pixels ) );
+	std::vector<double> reference( base, base + size_t( width ) * height * 4 );
+
+	le_pixels_subresource_t const* subresources     = nullptr;
+	size_t                         num_subresources = 0;
+
+	bool success = le_pixels_i.generate_mip_chain( pixels, filter, false ) &&
+	               le_pixels_i.get_subresources( pixels, &subresources, &num_subresources );
+
+	uint32_t const expected_num_levels = 1 + uint32_t( floor( log2( std::max( width, height ) ) ) );
+
+	if ( !success || num_subresources != expected_num_levels ) {
+		logger.error( "%ux%u, %s: expected %u mip levels, got %zu", width, height, filter_name, expected_num_levels, num_subresources );
+		le_pixels_i.destroy( pixels );
+		return false;
+	}
+
+	auto const* data = static_cast<unsigned char const*>( le_pixels_i.get_data( pixels ) );
+
+	uint32_t ref_w = width;
+	uint32_t ref_h = height;
+
+	for ( size_t level = 1; level != num_subresources && success; level++ ) {
+
+		reference = downsample_reference( reference, ref_w, ref_h, filter );
+		ref_w     = std::max<uint32_t>( 1, ref_w / 2 );
+		ref_h     = std::max<uint32_t>( 1, ref_h / 2 );
+
+		auto const* texels = reinterpret_cast<float const*>( data + subresources[ level ].offset );
+
+		for ( size_t i = 0; i != reference.size(); i++ ) {
+			if ( fabs( texels[ i ] - reference[ i ] ) > 1e-5 ) {
+				logger.error( "%ux%u, %s: mip level %zu, texel %zu, channel %zu: %f, expected %f",
+				              width, height, filter_name, level, i / 4, i % 4, texels[ i ], reference[ i ] );
+				success = false;
+				break;
+			}
+		}
+	}
+
+	le_pixels_i.destroy( pixels );
+
+	return success;
+}
+
+// ----------------------------------------------------------------------
+// Returns false if the alpha channel of a grey, and alpha sRGB image is filtered as if
+// it were non-linear. We average two transparent, and two opaque texels: linear
+// filtering gives alpha 128 - filtering alpha in sRGB space would give 188.
+static bool test_mip_chain_grey_alpha_srgb() {
+
+	using namespace le_pixels;
+
+	// Uncompressed, 2x2, 32 bit TGA: black texels, alternating alpha 0, and 255 - stb_image
+	// converts these into grey, and alpha when we ask for 2 channels.
+	unsigned char tga[ 18 + 2 * 2 * 4 ] = { 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0, 2, 0, 32, 8 };
+	tga[ 18 + 3 ]                       = 255;
+	tga[ 18 + 4 * 2 + 3 ]               = 255;
+
+	le_pixels_o* pixels = le_pixels_i.create_from_memory( tga, sizeof( tga ), 2, le_pixels_info::eUInt8 );
+
+	le_pixels_subresource_t const* subresources     = nullptr;
+	size_t                         num_subresources = 0;
+
+	bool success = pixels &&
+	               le_pixels_i.generate_mip_chain( pixels, le_pixels_api::eMipFilterBox, true ) &&
+	               le_pixels_i.get_subresources( pixels, &subresources, &num_subresources ) &&
+	               num_subresources == 2;
+
+	if ( success ) {
+		auto const* texel = static_cast<uint8_t const*>( le_pixels_i.get_data( pixels ) ) + subresources[ 1 ].offset;
+		if ( texel[ 0 ] != 0 || texel[ 1 ] != 128 ) {
+			logger.error( "grey, and alpha sRGB image: mip level 1 is (%u, %u), expected (0, 128)", texel[ 0 ], texel[ 1 ] );
+			success = false;
+		}
+	} else {
+		logger.error( "grey, and alpha sRGB image: could not generate mip chain" );
+	}
+
+	if ( pixels ) {
+		le_pixels_i.destroy( pixels );
+	}
+
+	return success;
+}
+
+#ifdef NDEBUG
+
+// ----------------------------------------------------------------------
+
+static bool read_file( char const* file_path, std::vector<unsigned char>& contents ) {
+	FILE* file = fopen( file_path, "rb" );
+	if ( file == nullptr ) {
+		return false;
+	}
+	fseek( file, 0, SEEK_END );
+	contents.resize( size_t( ftell( file ) ) );
+	fseek( file, 0, SEEK_SET );
+	size_t num_bytes_read = fread( contents.data(), 1, contents.size(), file );
+	fclose( file );
+	return num_bytes_read == contents.size();
+}
+
+// ----------------------------------------------------------------------
+// Returns false if le_pixels accepts the contents of file `file_path` after `patch` was applied.
+template <typename F>
+static bool test_corrupt_sample( char const* file_path, char const* description, F&& patch ) {
+
+	using namespace le_pixels;
+
+	std::vector<unsigned char> contents;
+
+	if ( !read_file( file_path, contents ) ) {
+		logger.error( "Could not read '%s' - are local resources linked?", file_path );
+		return false;
+	}
+
+	patch( contents );
+
+	le_pixels_info info{};
+
+	if ( le_pixels_i.get_info_from_memory( contents.data(), contents.size(), &info ) ) {
+		logger.error( "'%s' with %s: get_info_from_memory should fail", file_path, description );
+		return false;
+	}
+
+	if ( le_pixels_o* pixels = le_pixels_i.create_from_memory( contents.data(), contents.size(), 0, le_pixels_info::eUInt8 ) ) {
+		le_pixels_i.destroy( pixels );
+		logger.error( "'%s' with %s: create_from_memory should fail", file_path, description );
+		return false;
+	}
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+
+static void patch_u32( std::vector<unsigned char>& contents, size_t offset, uint32_t value ) {
+	memcpy( contents.data() + offset, &value, sizeof( value ) );
+}
+
+#endif
+
+// ----------------------------------------------------------------------
+
+static bool test_pixels_app_update( test_pixels_app_o* self ) {
+
+	for ( auto const& sample : CONTAINER_SAMPLES ) {
+		self->num_tests++;
+		if ( !test_container_sample( sample ) ) {
+			self->num_failures++;
+		}
+	}
+
+	std::mt19937 rng( 1 ); // fixed seed, so that runs are repeatable
+
+	for ( auto const& size : MIP_TEST_SIZES ) {
+		for ( auto filter : { le_pixels_api::eMipFilterBox, le_pixels_api::eMipFilterKaiser } ) {
+			self->num_tests++;
+			if ( !test_mip_chain( size.width, size.height, filter, rng ) ) {
+				self->num_failures++;
+			}
+		}
+	}
+
+	self->num_tests++;
+	if ( !test_mip_chain_grey_alpha_srgb() ) {
+		self->num_failures++;
+	}
+
+#ifdef NDEBUG
+	char const* ktx2_path = CONTAINER_SAMPLES[ 0 ].path;
+	char const* dds_path  = CONTAINER_SAMPLES[ 1 ].path;
+
+	bool const corrupt_results[] = {
+	    test_corrupt_sample( ktx2_path, "33 mip levels", []( auto& c ) { patch_u32( c, KTX2_OFFSET_LEVEL_COUNT, 33 ); } ),
+	    test_corrupt_sample( ktx2_path, "2^32-1 layers", []( auto& c ) { patch_u32( c, KTX2_OFFSET_LAYER_COUNT, UINT32_MAX ); } ),
+	    test_corrupt_sample( ktx2_path, "more than 4GiB of pixels", []( auto& c ) {
+		    patch_u32( c, KTX2_OFFSET_PIXEL_WIDTH, 65536 );
+		    patch_u32( c, KTX2_OFFSET_PIXEL_HEIGHT, 65536 );
+	    } ),
+	    test_corrupt_sample( dds_path, "2^32-1 cube maps", []( auto& c ) { patch_u32( c, DDS_OFFSET_ARRAY_SIZE, UINT32_MAX ); } ),
+	};
+
+	for ( bool result : corrupt_results ) {
+		self->num_tests++;
+		if ( !result ) {
+			self->num_failures++;
+		}
+	}
+#endif
+
+	if ( self->num_failures ) {
+		logger.error( "FAILED: %d of %d tests", self->num_failures, self->num_tests );
+	} else {
+		logger.info( "PASSED: %d tests", self->num_tests );
+	}
+
+	return false; // we only run once
+}
+
+// ----------------------------------------------------------------------
+
+static void test_pixels_app_destroy( test_pixels_app_o* self ) {
+	delete ( self );
+}
+
+// ----------------------------------------------------------------------
+
+LE_MODULE_REGISTER_IMPL( test_pixels_app, api ) {
+
+	auto  test_pixels_app_api_i = static_cast<test_pixels_app_api*>( api );
+	auto& test_pixels_app_i     = test_pixels_app_api_i->test_pixels_app_i;
+
+	test_pixels_app_i.initialize = app_initialize;
+	test_pixels_app_i.terminate  = app_terminate;
+
+	test_pixels_app_i.create  = test_pixels_app_create;
+	test_pixels_app_i.destroy = test_pixels_app_destroy;
+	test_pixels_app_i.update  = test_pixels_app_update;
+}
@@ -0,0 +1,61 @@
+#ifndef GUARD_test_pixels_app_H
+#define GUARD_test_pixels_app_H
+
+#include "le_core.h"
+
+struct test_pixels_app_o;
+
+// clang-format off
+struct test_pixels_app_api {
+
+	struct test_pixels_app_interface_t {
+		test_pixels_app_o * ( *create               )();
+		void         ( *destroy                  )( test_pixels_app_o *self );
+		bool         ( *update                   )( test_pixels_app_o *self );
+		void         ( *initialize               )(); // static methods
+		void         ( *terminate                )(); // static methods
+	};
+
+	test_pixels_app_interface_t test_pixels_app_i;
+};
+// clang-format on
+
+LE_MODULE( test_pixels_app );
+LE_MODULE_LOAD_DEFAULT( test_pixels_app );
+
+#ifdef __cplusplus
+
+namespace test_pixels_app {
+static const auto& api            = test_pixels_app_api_i;
+static const auto& test_pixels_app_i = api -> test_pixels_app_i;
+} // namespace test_pixels_app
+
+class TestPixelsApp : NoCopy, NoMove {
+
+	test_pixels_app_o* self;
+
+  public:
+	TestPixelsApp()
+	    : self( test_pixels_app::test_pixels_app_i.create() ) {
+	}
+
+	bool update() {
+		return test_pixels_app::test_pixels_app_i.update( self );
+	}
+
+	~TestPixelsApp() {
+		test_pixels_app::test_pixels_app_i.destroy( self );
+	}
+
+	static void initialize() {
+		test_pixels_app::test_pixels_app_i.initialize();
+	}
+
+	static void terminate() {
+		test_pixels_app::test_pixels_app_i.terminate();
+	}
+};
+
+#endif
+
+#endif // GUARD_test_pixels_app_H
@@ -0,0 +1,25 @@
+#include "texture_baker_app/texture_baker_app.h"
+
+// ----------------------------------------------------------------------
+
+int main( int argc, char const* argv[] ) {
+
+	TextureBakerApp::initialize();
+
+	int result = 0;
+
+	{
+		// We instantiate TextureBakerApp in its own scope - so that
+		// it will be destroyed before TextureBakerApp::terminate
+		// is called.
+
+		TextureBakerApp app{};
+
+		result = app.run( argc, argv );
+	}
+
+	// Must only be called once last TextureBakerApp is destroyed
+	TextureBakerApp::terminate();
+
+	return result;
+}
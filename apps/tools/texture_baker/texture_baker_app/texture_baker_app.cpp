@@ -0,0 +1,146 @@
+#include "texture_baker_app.h"
+#include "le_log.h"
+#include "le_jobs.h"
+#include "le_pixels.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct texture_baker_app_o {
+	le_log_channel_o* logger;
+};
+
+typedef texture_baker_app_o app_o;
+
+// ----------------------------------------------------------------------
+
+static void app_initialize() {
+	// Mip levels are downsampled, and images decoded, on all available worker threads.
+	le_jobs::initialize( std::max( 1u, std::thread::hardware_concurrency() ) );
+};
+
+// ----------------------------------------------------------------------
+
+static void app_terminate() {
+	le_jobs::terminate();
+};
+
+// ----------------------------------------------------------------------
+
+static texture_baker_app_o* texture_baker_app_create() {
+	auto app = new ( texture_baker_app_o );
+
+	app->logger = le_log_api_i->get_channel( "texture_baker" );
+
+	return app;
+}
+
+// ----------------------------------------------------------------------
+
+static void print_usage( LeLog& logger, char const* app_name ) {
+	logger.info( "Usage: %s [--kaiser] [--srgb] [-o output_directory] image_file...", app_name );
+	logger.info( "  --kaiser  downsample using a kaiser-windowed sinc filter, instead of a 2x2 box filter" );
+	logger.info( "  --srgb    images hold sRGB colours: filter in linear space, and store with an sRGB format" );
+	logger.info( "  -o        directory for baked .ktx2 files; by default, these are placed next to their source images" );
+}
+
+// ----------------------------------------------------------------------
+
+static int texture_baker_app_run( texture_baker_app_o* self, int argc, char const* argv[] ) {
+
+	auto logger = LeLog( self->logger );
+
+	le_pixels_api::MipFilter filter  = le_pixels_api::eMipFilterBox;
+	bool                     is_srgb = false;
+	std::filesystem::path    output_directory;
+	std::vector<char const*> input_paths;
+
+	for ( int i = 1; i < argc; i++ ) {
+		if ( 0 == strcmp( argv[ i ], "--kaiser" ) ) {
+			filter = le_pixels_api::eMipFilterKaiser;
+		} else if ( 0 == strcmp( argv[ i ], "--srgb" ) ) {
+			is_srgb = true;
+		} else if ( 0 == strcmp( argv[ i ], "-o" ) && i + 1 < argc ) {
+			output_directory = argv[ ++i ];
+		} else if ( argv[ i ][ 0 ] == '-' ) {
+			logger.error( "Unknown option: '%s'", argv[ i ] );
+			print_usage( logger, argv[ 0 ] );
+			return 1;
+		} else {
+			input_paths.push_back( argv[ i ] );
+		}
+	}
+
+	if ( input_paths.empty() ) {
+		print_usage( logger, argv[ 0 ] );
+		return 1;
+	}
+
+	if ( !output_directory.empty() ) {
+		std::error_code ec;
+		std::filesystem::create_directories( output_directory, ec );
+		if ( ec ) {
+			logger.error( "Could not create output directory '%s': %s", output_directory.string().c_str(), ec.message().c_str() );
+			return 1;
+		}
+	}
+
+	// Decode all images at once - we always bake to 4 channels, as
+	// 3-channel formats are poorly supported for sampled images.
+	std::vector<le_pixels_o*> images( input_paths.size(), nullptr );
+	le_pixels::le_pixels_i.create_batch_from_files( input_paths.data(), input_paths.size(), 4, le_pixels_info::eUInt8, images.data() );
+
+	int num_failed = 0;
+
+	for ( size_t i = 0; i != images.size(); i++ ) {
+
+		std::filesystem::path input_path = input_paths[ i ];
+		std::filesystem::path output_path =
+		    ( output_directory.empty() ? input_path.parent_path() : output_directory ) / input_path.filename().replace_extension( ".ktx2" );
+
+		if ( nullptr == images[ i ] ) {
+			logger.error( "Could not decode image '%s'", input_paths[ i ] );
+			num_failed++;
+			continue;
+		}
+
+		if ( !le_pixels::le_pixels_i.generate_mip_chain( images[ i ], filter, is_srgb ) ||
+		     !le_pixels::le_pixels_i.write_ktx2( images[ i ], output_path.string().c_str(), is_srgb ) ) {
+			logger.error( "Could not bake image '%s'", input_paths[ i ] );
+			num_failed++;
+		} else {
+			auto info = le_pixels::le_pixels_i.get_info( images[ i ] );
+			logger.info( "Baked '%s' -> '%s' (%ux%u, %u mip levels, %u bytes)",
+			             input_paths[ i ], output_path.string().c_str(), info.width, info.height, info.num_mip_levels, info.byte_count );
+		}
+
+		le_pixels::le_pixels_i.destroy( images[ i ] );
+	}
+
+	return num_failed ? 1 : 0;
+}
+
+// ----------------------------------------------------------------------
+
+static void texture_baker_app_destroy( texture_baker_app_o* self ) {
+	delete ( self );
+}
+
+// ----------------------------------------------------------------------
+
+LE_MODULE_REGISTER_IMPL( texture_baker_app, api ) {
+
+	auto  texture_baker_app_api_i = static_cast<texture_baker_app_api*>( api );
+	auto& texture_baker_app_i     = texture_baker_app_api_i->texture_baker_app_i;
+
+	texture_baker_app_i.initialize = app_initialize;
+	texture_baker_app_i.terminate  = app_terminate;
+
+	texture_baker_app_i.create  = texture_baker_app_create;
+	texture_baker_app_i.destroy = texture_baker_app_destroy;
+	texture_baker_app_i.run     = texture_baker_app_run;
+}
@@ -0,0 +1,66 @@
+#ifndef GUARD_texture_baker_app_H
+#define GUARD_texture_baker_app_H
+#endif
+
+#include "le_core.h"
+
+// Command-line tool: decodes images, generates their full mip chain on the CPU,
+// and writes each image, with all mip levels, into a KTX2 file, which
+// le_resource_manager can then load without decoding, or downsampling.
+//
+// Usage: texture_baker [--kaiser] [--srgb] [-o output_directory] image_file...
+
+struct texture_baker_app_o;
+
+// clang-format off
+struct texture_baker_app_api {
+
+	struct texture_baker_app_interface_t {
+		texture_baker_app_o * ( *create          )();
+		void         ( *destroy                  )( texture_baker_app_o *self );
+		int          ( *run                      )( texture_baker_app_o *self, int argc, char const * argv[] ); // returns process exit code
+		void         ( *initialize               )(); // static methods
+		void         ( *terminate                )(); // static methods
+	};
+
+	texture_baker_app_interface_t texture_baker_app_i;
+};
+// clang-format on
+
+LE_MODULE( texture_baker_app );
+LE_MODULE_LOAD_DEFAULT( texture_baker_app );
+
+#ifdef __cplusplus
+
+namespace texture_baker_app {
+static const auto& api                 = texture_baker_app_api_i;
+static const auto& texture_baker_app_i = api -> texture_baker_app_i;
+} // namespace texture_baker_app
+
+class TextureBakerApp : NoCopy, NoMove {
+
+	texture_baker_app_o* self;
+
+  public:
+	TextureBakerApp()
+	    : self( texture_baker_app::texture_baker_app_i.create() ) {
+	}
+
+	int run( int argc, char const* argv[] ) {
+		return texture_baker_app::texture_baker_app_i.run( self, argc, argv );
+	}
+
+	~TextureBakerApp() {
+		texture_baker_app::texture_baker_app_i.destroy( self );
+	}
+
+	static void initialize() {
+		texture_baker_app::texture_baker_app_i.initialize();
+	}
+
+	static void terminate() {
+		texture_baker_app::texture_baker_app_i.terminate();
+	}
+};
+
+#endif
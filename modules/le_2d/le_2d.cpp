@@ -14,6 +14,10 @@
 #include <vector>
 #include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <string.h> // for memset, memcpy
 
 #include "le_renderer.h"
@@ -30,8 +34,9 @@ using StrokeJoinType = le_2d_api::StrokeJoinType;
 // A drawing context, owner of all primitives.
 struct le_2d_o {
 	le_command_buffer_encoder_o*    encoder = nullptr;
-	std::vector<le_2d_primitive_o*> primitives;     // owning
-	le_gpso_handle                  maybe_pipeline; // non-owning, optional
+	std::vector<le_2d_primitive_o*> primitives;                     // owning
+	le_gpso_handle                  maybe_pipeline;                 // non-owning, optional
+	bool                            should_sort_primitives = false; // whether we may reorder primitives to reduce draw calls
 };
 
 struct node_data_t {
@@ -103,6 +108,7 @@ struct le_2d_primitive_o {
 	node_data_t node;
 
 	uint64_t hash;
+	uint32_t tessellator_shape_index; // only used for filled paths, index of shape in tessellator batch
 };
 
 void le_2d_primitive_update_hash( le_2d_primitive_o* obj ) {
@@ -112,7 +118,7 @@ void le_2d_primitive_update_hash( le_2d_primitive_o* obj ) {
 	// Every primive is zero-initialised, meaning unused bytes in
 	// `le_2d_primitive_o.data` are initialised to zero, and the hash is
 	// therefore predictable.
-	obj->hash = SpookyHash::Hash32( &obj->type, offsetof( le_2d_primitive_o, material.color ), 0 );
+	obj->hash = SpookyHash::Hash64( &obj->type, offsetof( le_2d_primitive_o, material.color ), 0 );
 }
 
 // ----------------------------------------------------------------------
@@ -497,24 +503,26 @@ static void generate_geometry_outline_path( std::vector<VertexData2D>& geometry,
 			}
 		} break;
 		case 3: {
-			std::vector<glm::vec2> vertices( 1024 );
+			std::vector<glm::vec2> vertices;
+
+			le_path_api::stroke_attribute_t stroke_attribs{};
+			stroke_attribs.width          = stroke_weight;
+			stroke_attribs.tolerance      = tolerance;
+			stroke_attribs.line_join_type = to_path_enum( material.stroke_join_type );
+			stroke_attribs.line_cap_type  = to_path_enum( material.stroke_cap_type );
+
+			// Re-tessellate any changed contours in parallel - contours which
+			// did not change since the last call are served from the path's cache.
+			le_path_i.update_thick_contours( path, &stroke_attribs );
 
 			for ( size_t i = 0; i != num_contours; ++i ) {
 
-				size_t num_vertices = vertices.size();
+				size_t num_vertices = le_path_i.get_thick_contour_vertex_count( path, i, &stroke_attribs );
+				vertices.resize( num_vertices );
 
 				glm::vec2* v_data = vertices.data();
 
-				le_path_api::stroke_attribute_t stroke_attribs{};
-				stroke_attribs.width          = stroke_weight;
-				stroke_attribs.tolerance      = tolerance;
-				stroke_attribs.line_join_type = to_path_enum( material.stroke_join_type );
-				stroke_attribs.line_cap_type  = to_path_enum( material.stroke_cap_type );
-
-				while ( false == le_path_i.tessellate_thick_contour( path, i, &stroke_attribs, v_data, &num_vertices ) ) {
-					vertices.resize( num_vertices );
-					v_data = vertices.data();
-				}
+				le_path_i.tessellate_thick_contour( path, i, &stroke_attribs, v_data, &num_vertices );
 
 				glm::vec2 const*       v     = v_data;
 				glm::vec2 const* const v_end = v_data + num_vertices;
@@ -532,8 +540,9 @@ static void generate_geometry_outline_path( std::vector<VertexData2D>& geometry,
 	}
 }
 
-// Generates triangles by tessellating what's contained within path
-static void generate_geometry_path( std::vector<VertexData2D>& geometry, le_path_o* path, float tolerance ) {
+// Adds flattened contours of path as a new shape to a tessellator batch.
+// Returns the shape index which identifies the shape within the batch.
+static uint32_t add_path_to_tessellator_batch( le_tessellator_batch_o* batch, le_path_o* path, float tolerance ) {
 
 	using namespace le_path;
 	using namespace le_tessellator;
@@ -542,10 +551,9 @@ static void generate_geometry_path( std::vector<VertexData2D>& geometry, le_path
 
 	size_t const num_polylines = le_path_i.get_num_polylines( path );
 
-	auto tess = le_tessellator_i.create();
-	le_tessellator_i.set_options( tess, le_tessellator::Options::eWindingOdd );
-	// le_tessellator_i.set_options( tess, le_tessellator::Options::bitConstrainedDelaunayTriangulation );
-	// le_tessellator_i.set_options( tess, le_tessellator::Options::bitUseEarcutTessellator );
+	uint32_t shape_index = batch_i.add_shape( batch, le_tessellator::Options::eWindingOdd );
+	// batch_i.add_shape( batch, le_tessellator::Options::bitConstrainedDelaunayTriangulation );
+	// batch_i.add_shape( batch, le_tessellator::Options::bitUseEarcutTessellator );
 
 	size_t                 num_used_vertices = 1024;
 	std::vector<glm::vec2> line_vertices( num_used_vertices );
@@ -558,33 +566,47 @@ static void generate_geometry_path( std::vector<VertexData2D>& geometry, le_path
 			line_vertices.resize( num_used_vertices );
 		}
 
-		le_tessellator_i.add_polyline( tess, line_vertices.data(), num_used_vertices );
+		batch_i.add_polyline( batch, line_vertices.data(), num_used_vertices );
 	}
 
-	le_tessellator_i.tessellate( tess );
+	return shape_index;
+}
+
+// Generates triangles for a path which has been tessellated as part of a tessellator batch
+static void generate_geometry_path( std::vector<VertexData2D>& geometry, le_tessellator_batch_o* batch, uint32_t shape_index ) {
+
+	using namespace le_tessellator;
+
+	le_tessellator_api::shape_range_t range{};
+
+	if ( false == batch_i.get_shape_range( batch, shape_index, &range ) ) {
+		return;
+	}
 
 	le_tessellator_api::IndexType const* indices;
 	size_t                               num_indices = 0;
 	glm::vec2 const*                     vertices;
 	size_t                               num_vertices = 0;
 
-	le_tessellator_i.get_indices( tess, &indices, &num_indices );
-	le_tessellator_i.get_vertices( tess, &vertices, &num_vertices );
+	batch_i.get_indices( batch, &indices, &num_indices );
+	batch_i.get_vertices( batch, &vertices, &num_vertices );
 
 	// TODO: what do we want to set for tex coordinate?
 
-	for ( size_t i = 0; i + 2 < num_indices; ) {
+	geometry.reserve( geometry.size() + range.index_count );
+
+	// Note that indices are absolute, they already include the shape's vertex offset.
+	for ( size_t i = range.index_offset; i + 2 < range.index_offset + range.index_count; ) {
 		geometry.push_back( { vertices[ indices[ i++ ] ], { 0, 0 } } );
 		geometry.push_back( { vertices[ indices[ i++ ] ], { 0, 0 } } );
 		geometry.push_back( { vertices[ indices[ i++ ] ], { 0, 0 } } );
 	}
-
-	le_tessellator_i.destroy( tess );
 }
 
 // ----------------------------------------------------------------------
 
-static void generate_geometry_for_primitive( le_2d_primitive_o* p, std::vector<VertexData2D>& geometry ) {
+// `tessellator_batch` must hold tessellations for any filled path primitives.
+static void generate_geometry_for_primitive( le_2d_primitive_o* p, std::vector<VertexData2D>& geometry, le_tessellator_batch_o* tessellator_batch ) {
 
 	switch ( p->type ) {
 	case le_2d_primitive_o::Type::eLine: {
@@ -624,7 +646,7 @@ static void generate_geometry_for_primitive( le_2d_primitive_o* p, std::vector<V
 	case le_2d_primitive_o::Type::ePath: {
 		auto const& path = p->data.as_path;
 		if ( p->material.filled ) {
-			generate_geometry_path( geometry, path.path, path.tolerance );
+			generate_geometry_path( geometry, tessellator_batch, p->tessellator_shape_index );
 		} else {
 			generate_geometry_outline_path( geometry, path.path, path.tolerance, p->material );
 		}
@@ -635,16 +657,188 @@ static void generate_geometry_for_primitive( le_2d_primitive_o* p, std::vector<V
 	}
 }
 
+// ----------------------------------------------------------------------
+// Geometry cache - shared by all 2d contexts, and persistent across frames.
+//
+// Cache entries are keyed by a hash over all parameters which affect a
+// primitive's geometry. Node transform and colour are not part of the key,
+// as they are applied per-instance, which means that a primitive which only
+// moved, or changed colour, will re-use its cached geometry.
+//
+// Entries which have not been used for `GEOMETRY_CACHE_MAX_AGE` frames get
+// evicted. The generation advances once per frame, no matter how many 2d
+// contexts draw within that frame.
+//
+struct le_2d_geometry_cache_t {
+	struct entry_t {
+		std::shared_ptr<std::vector<VertexData2D> const> geometry;
+		uint64_t                                         last_used_generation;
+	};
+
+	static constexpr uint64_t GEOMETRY_CACHE_MAX_AGE = 120;
+
+	std::mutex                            mtx;               // protects all fields; 2d contexts may draw from more than one thread
+	std::unordered_map<uint64_t, entry_t> entries;           //
+	uint64_t                              generation;        // incremented once per frame in which 2d contexts draw primitives
+	uint64_t                              last_frame_number; // renderer frame number for which generation was last incremented
+	le_2d_api::geometry_cache_stats_t     stats;             // cumulative
+};
+
+static le_2d_geometry_cache_t* get_geometry_cache() {
+	static le_2d_geometry_cache_t cache{};
+	return &cache;
+}
+
+// ----------------------------------------------------------------------
+// Calculate a key over everything that affects geometry of a primitive.
+static uint64_t le_2d_primitive_get_geometry_key( le_2d_primitive_o const* p ) {
+
+	if ( p->type != le_2d_primitive_o::Type::ePath ) {
+		return SpookyHash::Hash64( &p->type, offsetof( le_2d_primitive_o, material.color ), 0 );
+	}
+
+	// Paths are owned by their primitive, and their address is not meaningful across
+	// frames. We hash the contents of the path instead of the path pointer.
+
+	le_2d_primitive_o tmp = *p;
+	tmp.data.as_path.path = nullptr;
+
+	uint64_t path_hash = le_path::le_path_i.get_hash( p->data.as_path.path );
+
+	return SpookyHash::Hash64( &tmp.type, offsetof( le_2d_primitive_o, material.color ), path_hash );
+}
+
+// ----------------------------------------------------------------------
+
+static std::shared_ptr<std::vector<VertexData2D> const> le_2d_geometry_cache_find( uint64_t key ) {
+	auto             cache = get_geometry_cache();
+	std::scoped_lock lock( cache->mtx );
+
+	auto it = cache->entries.find( key );
+
+	if ( it == cache->entries.end() ) {
+		return nullptr;
+	}
+
+	it->second.last_used_generation = cache->generation;
+	return it->second.geometry;
+}
+
+// ----------------------------------------------------------------------
+
+static void le_2d_geometry_cache_insert( uint64_t key, std::shared_ptr<std::vector<VertexData2D> const> const& geometry ) {
+	auto             cache = get_geometry_cache();
+	std::scoped_lock lock( cache->mtx );
+
+	cache->entries[ key ] = { geometry, cache->generation };
+}
+
+// ----------------------------------------------------------------------
+// Advance the generation if this is the first draw for `frame_number`, and evict
+// any entries which have not been used recently. Must be called before looking
+// up geometry for a frame.
+static void le_2d_geometry_cache_begin_frame( uint64_t frame_number ) {
+	auto             cache = get_geometry_cache();
+	std::scoped_lock lock( cache->mtx );
+
+	if ( frame_number == cache->last_frame_number ) {
+		return; // another 2d context has already drawn in this frame
+	}
+
+	cache->last_frame_number = frame_number;
+	cache->generation++;
+
+	// We only sweep once in a while, so that we don't have to
+	// iterate over all entries each frame.
+	if ( cache->generation % le_2d_geometry_cache_t::GEOMETRY_CACHE_MAX_AGE == 0 ) {
+		for ( auto it = cache->entries.begin(); it != cache->entries.end(); ) {
+			if ( cache->generation - it->second.last_used_generation > le_2d_geometry_cache_t::GEOMETRY_CACHE_MAX_AGE ) {
+				it = cache->entries.erase( it );
+				cache->stats.num_evictions++;
+			} else {
+				it++;
+			}
+		}
+	}
+
+	cache->stats.num_entries = cache->entries.size();
+}
+
+// ----------------------------------------------------------------------
+// Update statistics.
+static void le_2d_geometry_cache_update( size_t num_hits, size_t num_misses ) {
+	auto             cache = get_geometry_cache();
+	std::scoped_lock lock( cache->mtx );
+
+	cache->stats.num_hits += num_hits;
+	cache->stats.num_misses += num_misses;
+
+	cache->stats.num_entries = cache->entries.size();
+}
+
+// ----------------------------------------------------------------------
+
+static void le_2d_get_geometry_cache_stats( le_2d_api::geometry_cache_stats_t* stats ) {
+	auto             cache = get_geometry_cache();
+	std::scoped_lock lock( cache->mtx );
+	*stats = cache->stats;
+}
+
+// ----------------------------------------------------------------------
+
+static void le_2d_reset_geometry_cache() {
+	auto             cache = get_geometry_cache();
+	std::scoped_lock lock( cache->mtx );
+	cache->entries.clear();
+	cache->stats = {};
+}
+
+// ----------------------------------------------------------------------
+
+static le_2d_api::draw_stats_t* get_draw_stats() {
+	static le_2d_api::draw_stats_t stats{};
+	return &stats;
+}
+
+static std::mutex& get_draw_stats_mtx() {
+	static std::mutex mtx;
+	return mtx;
+}
+
+static void le_2d_get_draw_stats( le_2d_api::draw_stats_t* stats ) {
+	std::scoped_lock lock( get_draw_stats_mtx() );
+	*stats = *get_draw_stats();
+}
+
+static void le_2d_reset_draw_stats() {
+	std::scoped_lock lock( get_draw_stats_mtx() );
+	*get_draw_stats() = {};
+}
+
+// ----------------------------------------------------------------------
+
+static void le_2d_set_sort_primitives( le_2d_o* self, bool should_sort ) {
+	self->should_sort_primitives = should_sort;
+}
+
 // ----------------------------------------------------------------------
 // internal method, only triggered if le_2d is destroyed.
 static void le_2d_draw_primitives( le_2d_o* self ) {
 
-	/* We might want to do some sorting, and optimising here
-	 * Sort by pipeline for example. Also, issue draw commands
-	 * as instanced draws if more than three of the same prims
-	 * are issued.
+	/* Primitives which share geometry are drawn as instanced draws. All geometry,
+	 * and all per-instance data are each uploaded in one go, so that draws only
+	 * need to offset into these two buffers.
+	 *
+	 * If sorting is enabled, primitives are sorted so that all primitives which
+	 * share geometry are drawn with a single instanced draw.
 	 */
 
+	if ( self->primitives.empty() ) {
+		return;
+	}
+
+	auto time_start = std::chrono::steady_clock::now();
+
 	le::GraphicsEncoder encoder{ self->encoder };
 
 	// Use custom pipeline, if a custom pipeline has been specified
@@ -726,10 +920,28 @@ static void le_2d_draw_primitives( le_2d_o* self ) {
 		le_2d_primitive_update_hash( p );
 	}
 
+	if ( self->should_sort_primitives ) {
+		// Stable sort, so that primitives with the same geometry keep their relative draw order.
+		std::stable_sort( self->primitives.begin(), self->primitives.end(),
+		                  []( le_2d_primitive_o const* lhs, le_2d_primitive_o const* rhs ) -> bool {
+			                  return lhs->hash < rhs->hash;
+		                  } );
+	}
+
+	LE_SETTING( bool, LE_SETTING_2D_USE_GEOMETRY_CACHE, true );
+
+	bool const use_geometry_cache = *LE_SETTING_2D_USE_GEOMETRY_CACHE;
+
+	if ( use_geometry_cache ) {
+		le_2d_geometry_cache_begin_frame( encoder.getFrameNumber() );
+	}
+
 	// Now, we do essentially run-length encoding.
 
-	std::vector<std::vector<VertexData2D>> geometry_data;
-	std::vector<PrimitiveInstanceData2D>   per_instance_data;
+	using geometry_ptr_t = std::shared_ptr<std::vector<VertexData2D> const>;
+
+	std::vector<geometry_ptr_t>          geometry_data;
+	std::vector<PrimitiveInstanceData2D> per_instance_data;
 	per_instance_data.reserve( self->primitives.size() );
 
 	struct InstancedDraw {
@@ -740,75 +952,174 @@ static void le_2d_draw_primitives( le_2d_o* self ) {
 
 	std::vector<InstancedDraw> instanced_draws;
 
+	struct GeometryRequest {
+		le_2d_primitive_o* primitive;           // primitive for which to generate geometry
+		uint64_t           geometry_key;        // key under which to store generated geometry in cache
+		uint32_t           geometry_data_index; // where to store generated geometry
+	};
+
+	std::vector<GeometryRequest> geometry_requests; // geometry which was not found in cache
+
+	struct GeometryAlias {
+		uint32_t geometry_data_index;        // where to store geometry
+		uint32_t source_geometry_data_index; // where to take geometry from, once it has been generated
+	};
+
+	std::vector<GeometryAlias>             geometry_aliases;        // geometry which is missing from cache, but already requested for this draw
+	std::unordered_map<uint64_t, uint32_t> requested_geometry_keys; // geometry key -> geometry_data_index of first request with this key
+
 	uint64_t previous_hash = 0;
 
 	for ( auto const& p : self->primitives ) {
 
-		if ( instanced_draws.empty() ) {
+		PrimitiveInstanceData2D instance_data{};
+		instance_data.color        = p->material.color;
+		instance_data.rotation_ccw = p->node.rotation_ccw;
+		instance_data.scale        = p->node.scale;
+		instance_data.translation  = p->node.translation;
+
+		if ( !instanced_draws.empty() && p->hash == previous_hash ) {
+			// geometry is the same as for the previous primitive: add an instance.
+			per_instance_data.emplace_back( instance_data );
+			instanced_draws.back().instance_count++;
+			continue;
+		}
 
-			std::vector<VertexData2D> geometry;
+		// geometry has changed.
 
-			generate_geometry_for_primitive( p, geometry );
-			geometry_data.emplace_back( geometry );
+		instanced_draws.push_back( { uint32_t( geometry_data.size() ),
+		                             uint32_t( per_instance_data.size() ),
+		                             1 } );
 
-			PrimitiveInstanceData2D instance_data{};
-			instance_data.color        = p->material.color;
-			instance_data.rotation_ccw = p->node.rotation_ccw;
-			instance_data.scale        = p->node.scale;
-			instance_data.translation  = p->node.translation;
+		per_instance_data.emplace_back( instance_data );
 
-			per_instance_data.emplace_back( instance_data );
+		uint64_t       geometry_key = 0;
+		geometry_ptr_t geometry;
 
-			instanced_draws.push_back( { 0, 0, 1 } );
-			previous_hash = p->hash;
-			continue;
+		if ( use_geometry_cache ) {
+			geometry_key = le_2d_primitive_get_geometry_key( p );
+			geometry     = le_2d_geometry_cache_find( geometry_key );
 		}
 
-		uint32_t hash = p->hash;
+		if ( nullptr == geometry ) {
+			uint32_t const geometry_data_index = uint32_t( geometry_data.size() );
+			bool           is_first_request    = true;
 
-		if ( hash != previous_hash ) {
+			if ( use_geometry_cache ) {
+				// Generate geometry only once, even if it is missing from cache for more than one primitive.
+				auto [ it, was_inserted ] = requested_geometry_keys.try_emplace( geometry_key, geometry_data_index );
+				if ( !was_inserted ) {
+					geometry_aliases.push_back( { geometry_data_index, it->second } );
+					is_first_request = false;
+				}
+			}
 
-			instanced_draws.push_back( { uint32_t( geometry_data.size() ),
-			                             uint32_t( per_instance_data.size() ),
-			                             1 } );
-			// geometry has changed.
+			if ( is_first_request ) {
+				geometry_requests.push_back( { p, geometry_key, geometry_data_index } );
+			}
+		}
 
-			std::vector<VertexData2D> geometry;
+		geometry_data.emplace_back( std::move( geometry ) );
 
-			generate_geometry_for_primitive( p, geometry );
-			geometry_data.emplace_back( geometry );
+		previous_hash = p->hash;
+	}
 
-			PrimitiveInstanceData2D instance_data{};
-			instance_data.color        = p->material.color;
-			instance_data.rotation_ccw = p->node.rotation_ccw;
-			instance_data.scale        = p->node.scale;
-			instance_data.translation  = p->node.translation;
+	// Tessellate all filled paths which we must generate geometry for up-front, in one
+	// batch - this allows the tessellator to triangulate independent paths in parallel.
 
-			per_instance_data.emplace_back( instance_data );
+	le_tessellator_batch_o* tessellator_batch = nullptr;
 
-			previous_hash = hash;
-		} else {
+	for ( auto& r : geometry_requests ) {
+		auto& p = r.primitive;
+		if ( p->type == le_2d_primitive_o::Type::ePath && p->material.filled ) {
+			if ( nullptr == tessellator_batch ) {
+				tessellator_batch = le_tessellator::batch_i.create();
+			}
+			p->tessellator_shape_index = add_path_to_tessellator_batch( tessellator_batch, p->data.as_path.path, p->data.as_path.tolerance );
+		}
+	}
 
-			PrimitiveInstanceData2D instance_data{};
-			instance_data.color        = p->material.color;
-			instance_data.rotation_ccw = p->node.rotation_ccw;
-			instance_data.scale        = p->node.scale;
-			instance_data.translation  = p->node.translation;
+	if ( tessellator_batch ) {
+		le_tessellator::batch_i.tessellate( tessellator_batch );
+	}
 
-			per_instance_data.emplace_back( instance_data );
+	for ( auto& r : geometry_requests ) {
 
-			instanced_draws.back().instance_count++;
+		auto geometry = std::make_shared<std::vector<VertexData2D>>();
+
+		generate_geometry_for_primitive( r.primitive, *geometry, tessellator_batch );
+
+		if ( use_geometry_cache ) {
+			le_2d_geometry_cache_insert( r.geometry_key, geometry );
+		}
+
+		geometry_data[ r.geometry_data_index ] = std::move( geometry );
+	}
+
+	if ( tessellator_batch ) {
+		le_tessellator::batch_i.destroy( tessellator_batch );
+	}
+
+	for ( auto const& a : geometry_aliases ) {
+		geometry_data[ a.geometry_data_index ] = geometry_data[ a.source_geometry_data_index ];
+	}
+
+	if ( use_geometry_cache ) {
+		le_2d_geometry_cache_update( geometry_data.size() - geometry_requests.size(), geometry_requests.size() );
+	}
+
+	// Merge all geometry into one vertex buffer - each draw then only needs to
+	// know its first vertex, and we upload vertex data exactly once.
+	//
+	// Runs which share cached geometry share the same vertices - this matters
+	// if primitives are not sorted, where each run may be a single primitive.
+
+	std::vector<uint32_t> geometry_first_vertex;
+	geometry_first_vertex.reserve( geometry_data.size() );
+
+	std::unordered_map<std::vector<VertexData2D> const*, uint32_t> first_vertex_for_geometry;
+
+	std::vector<VertexData2D> vertex_data;
+
+	for ( auto const& g : geometry_data ) {
+		auto [ it, was_inserted ] = first_vertex_for_geometry.try_emplace( g.get(), uint32_t( vertex_data.size() ) );
+		if ( was_inserted ) {
+			vertex_data.insert( vertex_data.end(), g->begin(), g->end() );
 		}
+		geometry_first_vertex.push_back( it->second );
 	}
 
-	for ( auto& d : instanced_draws ) {
+	uint32_t num_draw_calls = 0;
 
-		auto& geom = geometry_data[ d.geometry_data_index ];
+	if ( !vertex_data.empty() ) {
 
 		encoder
-		    .setVertexData( geom.data(), sizeof( VertexData2D ) * geom.size(), 0 )
-		    .setVertexData( per_instance_data.data() + d.instance_data_index, d.instance_count * sizeof( PrimitiveInstanceData2D ), 1 )
-		    .draw( uint32_t( geom.size() ), d.instance_count );
+		    .setVertexData( vertex_data.data(), sizeof( VertexData2D ) * vertex_data.size(), 0 )
+		    .setVertexData( per_instance_data.data(), sizeof( PrimitiveInstanceData2D ) * per_instance_data.size(), 1 );
+
+		for ( auto const& d : instanced_draws ) {
+
+			uint32_t vertex_count = uint32_t( geometry_data[ d.geometry_data_index ]->size() );
+
+			if ( vertex_count == 0 ) {
+				continue;
+			}
+
+			encoder.draw( vertex_count, d.instance_count, geometry_first_vertex[ d.geometry_data_index ], d.instance_data_index );
+			num_draw_calls++;
+		}
+	}
+
+	{
+		auto time_end = std::chrono::steady_clock::now();
+
+		std::scoped_lock lock( get_draw_stats_mtx() );
+		auto             stats = get_draw_stats();
+
+		stats->num_primitives += self->primitives.size();
+		stats->num_draw_calls += num_draw_calls;
+		stats->num_vertices_uploaded += vertex_data.size();
+		stats->cpu_time_nanoseconds += uint64_t( std::chrono::duration_cast<std::chrono::nanoseconds>( time_end - time_start ).count() );
 	}
 }
 
@@ -1084,6 +1395,12 @@ LE_MODULE_REGISTER_IMPL( le_2d, api ) {
 	le_2d_i.create  = le_2d_create;
 	le_2d_i.destroy = le_2d_destroy;
 
+	le_2d_i.set_sort_primitives      = le_2d_set_sort_primitives;
+	le_2d_i.get_geometry_cache_stats = le_2d_get_geometry_cache_stats;
+	le_2d_i.reset_geometry_cache     = le_2d_reset_geometry_cache;
+	le_2d_i.get_draw_stats           = le_2d_get_draw_stats;
+	le_2d_i.reset_draw_stats         = le_2d_reset_draw_stats;
+
 	auto& le_2d_primitive_i = static_cast<le_2d_api*>( api )->le_2d_primitive_i;
 
 #define SET_PRIMITIVE_FPTR( prim_type, field_name ) \
@@ -93,11 +93,39 @@ struct le_2d_api {
 		#undef SETTER_DECLARE
 	};
 
+	// Geometry for primitives is cached across frames, keyed by the primitive's shape parameters.
+	// Statistics are cumulative: hit rate is num_hits / ( num_hits + num_misses ).
+	struct geometry_cache_stats_t {
+		uint64_t num_hits;      // number of times geometry was re-used from cache
+		uint64_t num_misses;    // number of times geometry had to be generated
+		uint64_t num_evictions; // number of entries removed because they had not been used recently
+		uint64_t num_entries;   // number of entries currently held in cache
+	};
+
+	// Cumulative statistics over all 2d contexts, so that you can see how well primitives batch.
+	struct draw_stats_t {
+		uint64_t num_primitives;        // number of primitives drawn
+		uint64_t num_draw_calls;        // number of draw calls issued for these primitives
+		uint64_t num_vertices_uploaded; // number of vertices uploaded
+		uint64_t cpu_time_nanoseconds;  // time spent generating, batching, and encoding draws
+	};
+
 	struct le_2d_interface_t {
 
 		le_2d_o *    ( * create                   ) ( le_command_buffer_encoder_o* encoder, struct le_gpso_handle_t* optional_custom_pipeline );
 		void         ( * destroy                  ) ( le_2d_o* self );
 
+		// Allow le_2d to reorder primitives, so that all primitives which share geometry
+		// can be drawn using a single instanced draw. Off by default, as this changes the
+		// order in which primitives are drawn - only enable this if primitives don't overlap,
+		// or if their draw order does not matter.
+		void         ( * set_sort_primitives      ) ( le_2d_o* self, bool should_sort );
+
+		void         ( * get_geometry_cache_stats ) ( geometry_cache_stats_t* stats );
+		void         ( * reset_geometry_cache     ) ( ); // removes all cached geometry, and resets statistics
+
+		void         ( * get_draw_stats           ) ( draw_stats_t* stats );
+		void         ( * reset_draw_stats         ) ( );
 	};
 
 	le_2d_interface_t			le_2d_i;
@@ -144,6 +172,12 @@ class Le2D : NoCopy, NoMove {
 		le_2d::le_2d_i.destroy( self );
 	}
 
+	// See: le_2d_interface_t::set_sort_primitives
+	Le2D& setSortPrimitives( bool should_sort ) {
+		le_2d::le_2d_i.set_sort_primitives( self, should_sort );
+		return *this;
+	}
+
 	// ---
 
 	class CircleBuilder {
@@ -58,6 +58,7 @@ struct le_descriptor_set_layout_t {
 	std::vector<le_shader_binding_info> binding_info;                  // binding info for this set
 	VkDescriptorSetLayout               vk_descriptor_set_layout;      // vk object
 	VkDescriptorUpdateTemplate          vk_descriptor_update_template; // template used to update such a descriptorset based on descriptor data laid out in flat DescriptorData elements
+	bool                                is_borrowed = false;           // if true, vk objects are owned elsewhere - this is how we keep the backend's bindless set layout
 };
 // ----------------------------------------------------------------------
 // Everything a possible vulkan descriptor binding might contain.
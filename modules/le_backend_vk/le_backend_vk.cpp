@@ -78,6 +78,9 @@ constexpr size_t LE_FRAME_DATA_POOL_BLOCK_SIZE  = 1u << 24; // 16.77 MB
 constexpr size_t LE_FRAME_DATA_POOL_BLOCK_COUNT = 1;
 constexpr size_t LE_LINEAR_ALLOCATOR_SIZE       = 1u << 24;
 
+constexpr uint32_t LE_BINDLESS_MAX_TEXTURES = 16384; // upper bound for bindless textures - clamped to device limits
+constexpr uint32_t LE_BINDLESS_MAX_BUFFERS  = 4096;  // upper bound for bindless storage buffers - clamped to device limits
+
 static constexpr VkImageSubresourceRange LE_IMAGE_SUBRESOURCE_RANGE_ALL_MIPLEVELS{
     .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
     .baseMipLevel   = 0,
@@ -525,8 +528,8 @@ struct swapchain_state_t {
 // with other threads processing other frames concurrently.
 struct BackendFrameData {
 
-	VkFence  frameFence  = nullptr; // protects the frame - cpu waits on gpu to pass fence before deleting/recycling frame
-	uint64_t frameNumber = 0;       // current frame number
+	uint64_t frameTimelineValue = 0; // protects the frame - cpu waits for the default graphics queue's timeline semaphore to reach this value before deleting/recycling frame
+	uint64_t frameNumber        = 0; // current frame number
 
 	std::vector<le_on_frame_clear_callback_data_t> on_clear_callbacks; // callbacks to call on frame clear
 
@@ -550,8 +553,9 @@ struct BackendFrameData {
 	std::unordered_map<uint64_t, swapchain_state_t> frame_owned_swapchain_state; // per-swapchain state for this frame
 
 	struct Texture {
-		VkSampler   sampler;
-		VkImageView imageView;
+		VkSampler     sampler     = nullptr; // nullptr if texture uses an immutable sampler
+		VkImageView   imageView   = nullptr;
+		VkImageLayout imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL; // layout in which the image gets sampled - see get_sampled_image_layout
 	};
 
 	using texture_map_t = std::unordered_map<le_texture_handle, Texture>;
@@ -591,14 +595,19 @@ struct BackendFrameData {
 	std::vector<std::string> debug_root_passes_names;       // names for root passis in RootPassesField
 
 	std::vector<texture_map_t> textures_per_pass; // non-owning, references to frame-local textures, cleared on frame fence.
+	texture_map_t              bindless_textures; // non-owning, bindless textures which no pass samples, cleared on frame fence.
 
 	std::vector<VkDescriptorPool> descriptorPools; // one descriptor pool per pass
 
+	VkDescriptorSet bindlessDescriptorSet = nullptr; // non-owning, allocated from backend bindless pool - only used in bindless mode
+
 	typedef std::unordered_map<le_resource_handle, AllocatedResourceVk> ResourceMap_T;
 
 	ResourceMap_T availableResources; // resources this frame may use - each entry represents an association between a le_resource_handle and a vk resource
 	ResourceMap_T binnedResources;    // resources to delete when this frame comes round to clear()
 
+	std::vector<VmaAllocation> binnedAllocations; // memory shared by transient images, to free when this frame comes round to clear()
+
 	/*
 
 	  Each Frame has one allocation pool from which all allocations for scratch buffers are drawn.
@@ -619,6 +628,10 @@ struct BackendFrameData {
 
 	std::vector<le_command_stream_t*> command_streams; // owning; these must be destroyed when frame gets destroyed.
 
+	VkQueryPool                   timestamp_query_pool      = nullptr; // owning; two timestamp queries per pass - only used if gpu timestamps are enabled
+	uint32_t                      timestamp_query_pool_size = 0;       // number of queries in timestamp_query_pool
+	std::vector<le_pass_timing_t> pass_timings;                        // per pass: name, and queue - durations get filled in when the frame is cleared
+
 	bool must_create_queues_dot_graph = false;
 };
 
@@ -664,6 +677,73 @@ struct le_backend_o {
 
 	std::unordered_map<le_resource_handle, uint64_t> resource_queue_family_ownership[ 2 ]; // per-resource queue family ownership - we use this to detect queue family ownership change for resources
 
+	// Transient images share memory with other transient images if the passes which use them don't overlap,
+	// see `backend_alias_transient_images`. We keep the layout of the most recent frame, so that
+	// images, and their memory may be re-used for as long as the layout does not change.
+	struct transient_image_t {
+		le_resource_handle   handle;              //
+		ResourceCreateInfo   info;                // create info, with format, and usage patched
+		uint32_t             first_pass;          // index of first pass which uses this image
+		uint32_t             last_pass;           // index of last pass which uses this image
+		le::RootPassesField  tree;                // root passes for all passes which may be submitted together with passes using this image
+		VkMemoryRequirements memory_requirements; //
+		uint32_t             heap_idx;            // index into transient_heaps
+	};
+
+	std::vector<transient_image_t> transient_images; // layout of transient images for most recent frame
+	std::vector<VmaAllocation>     transient_heaps;  // owning: memory shared by transient images
+
+	// Per-pass gpu timings - passes write timestamps into their frame's query pool, which we read
+	// back once the frame has been cleared, so that reading back never stalls.
+	struct gpu_timestamps_t {
+		bool                  enabled          = false; // set on setup, from backend settings
+		bool                  host_query_reset = false; // whether we may reset queries from the cpu - otherwise, each pass resets its own queries
+		double                tick_period_ns   = 0;     // nanoseconds per timestamp tick
+		std::vector<uint64_t> valid_bits_mask;          // per queue: mask for valid timestamp bits - 0 if queue does not support timestamps
+
+		std::mutex                    mtx;                   // protects all following elements
+		std::vector<le_pass_timing_t> last_timings;          // timings for the most recent frame which was cleared
+		uint64_t                      last_frame_number = 0; // frame number for last_timings
+#if defined( TRACY_ENABLE )
+		std::vector<int16_t>                                           tracy_contexts;         // per queue: tracy gpu context id, -1 if not yet created
+		std::unordered_map<std::string, ___tracy_source_location_data> tracy_source_locations; // per pass name: source location - must have stable address
+		uint16_t                                                       tracy_next_query_id = 0;
+#endif
+	} gpu_timestamps;
+
+	// Bindless mode: textures, and storage buffers are given indices into arrays of descriptors
+	// in one descriptor set. Indices are shared by all frames, so that they remain stable from
+	// frame to frame - but each frame owns its own descriptor set, into which it writes the
+	// descriptors for resources that it uses when it gets processed.
+	struct bindless_t {
+		bool                  enabled      = false;   // set on setup, from backend settings
+		VkDescriptorSetLayout layout       = nullptr; // owning
+		VkDescriptorPool      pool         = nullptr; // owning; one descriptor set per frame gets allocated from this pool
+		uint32_t              max_textures = 0;       // number of elements in array of textures at binding 0
+		uint32_t              max_buffers  = 0;       // number of elements in array of storage buffers at binding 1
+
+		struct index_allocator_t {
+			struct pending_release_t {
+				uint32_t index;
+				uint64_t frame_number; // index may be recycled once the frame with this number has been cleared
+			};
+			uint32_t                       next_index = 0;   // next index which has never been handed out
+			std::vector<uint32_t>          free_indices;     // indices which may be handed out again
+			std::vector<pending_release_t> pending_releases; // released indices which may still be in use by frames in flight
+		};
+
+		std::mutex                                                     mtx; // protects all following elements
+		std::unordered_map<le_texture_handle, uint32_t>                textures;
+		std::unordered_map<le_buf_resource_handle, uint32_t>           buffers;
+		std::unordered_map<le_texture_handle, le_image_sampler_info_t> texture_infos; // most recently declared image, and sampler per bindless texture
+		index_allocator_t                                              texture_indices;
+		index_allocator_t                                              buffer_indices;
+		uint64_t                                                       last_cleared_frame_number = 0;
+	} bindless;
+
+	std::atomic<uint32_t> num_argument_descriptor_writes = 0; // for the most recently processed frame
+	std::atomic<uint32_t> num_bindless_descriptor_writes = 0; // for the most recently processed frame
+
   private:
 	// Vulkan resources which are available to all frames.
 	// Generally, a resource needs to stay alive until the last frame that uses it has crossed its fence.
@@ -693,10 +773,13 @@ struct ArgumentState {
 	std::array<VkDescriptorUpdateTemplate, 8> updateTemplates; // update templates for currently bound descriptor sets
 	std::array<VkDescriptorSetLayout, 8>      layouts;         // layouts for currently bound descriptor sets
 	std::vector<le_shader_binding_info>       binding_infos;
+
+	VkDescriptorSetLayout bindlessLayout = nullptr; // if a set uses this layout, we bind bindlessSet instead of allocating a set
+	VkDescriptorSet       bindlessSet    = nullptr; // current frame's bindless descriptor set
 };
 
 struct DescriptorSetState {
-	VkDescriptorSetLayout       setLayout;
+	VkDescriptorSetLayout       setLayout = nullptr;
 	std::vector<DescriptorData> setData;
 };
 
@@ -745,6 +828,28 @@ static inline void le_format_get_is_depth_stencil( le::Format const& format_, bo
 	return;
 }
 
+// ----------------------------------------------------------------------
+// Returns the layout in which an image is expected to be when it gets sampled - this depends
+// on how the image was declared: images which may be used for storage stay in general layout,
+// so that they need not be transitioned between storage, and sampled access; depth/stencil
+// images get sampled in read-only depth/stencil layout.
+static inline VkImageLayout get_sampled_image_layout( VkImageCreateInfo const& image_info ) {
+
+	if ( image_info.usage & VK_IMAGE_USAGE_STORAGE_BIT ) {
+		return VK_IMAGE_LAYOUT_GENERAL;
+	}
+
+	bool isDepth   = false;
+	bool isStencil = false;
+	le_format_get_is_depth_stencil( le::Format( image_info.format ), isDepth, isStencil );
+
+	if ( isDepth || isStencil ) {
+		return VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+	}
+
+	return VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+}
+
 // ----------------------------------------------------------------------
 static VkBufferUsageFlags defaults_get_buffer_usage_scratch() {
 
@@ -815,10 +920,13 @@ static void backend_destroy( le_backend_o* self ) {
 
 		// -- destroy per-frame data
 
-		vkDestroyFence( device, frameData.frameFence, nullptr );
-
 		frameData.frame_owned_swapchain_state.clear();
 
+		if ( frameData.timestamp_query_pool ) {
+			vkDestroyQueryPool( device, frameData.timestamp_query_pool, nullptr );
+			frameData.timestamp_query_pool = nullptr;
+		}
+
 		{
 			for ( auto& cp : frameData.available_command_pools ) {
 				vkDestroyCommandPool( device, cp->pool, nullptr );
@@ -876,6 +984,11 @@ static void backend_destroy( le_backend_o* self ) {
 				vmaFreeMemory( self->mAllocator, a.second.allocation );
 			}
 			frameData.binnedResources.clear();
+
+			for ( auto& a : frameData.binnedAllocations ) {
+				vmaFreeMemory( self->mAllocator, a );
+			}
+			frameData.binnedAllocations.clear();
 		}
 
 		{ // Clear command streams
@@ -888,6 +1001,17 @@ static void backend_destroy( le_backend_o* self ) {
 
 	self->mFrames.clear();
 
+	// Destroying the bindless pool frees the bindless descriptor sets of all frames.
+	if ( self->bindless.pool ) {
+		vkDestroyDescriptorPool( device, self->bindless.pool, nullptr );
+		self->bindless.pool = nullptr;
+	}
+
+	if ( self->bindless.layout ) {
+		vkDestroyDescriptorSetLayout( device, self->bindless.layout, nullptr );
+		self->bindless.layout = nullptr;
+	}
+
 	// Remove any resources still alive in the backend.
 	// At this point we're running single-threaded, so we can ignore the
 	// ownership claim on allocatedResources.
@@ -920,6 +1044,13 @@ static void backend_destroy( le_backend_o* self ) {
 		}
 
 		allocated_resources.clear();
+
+		// Transient images were destroyed with allocated resources, but the memory they shared was not.
+		for ( auto& a : self->transient_heaps ) {
+			vmaFreeMemory( self->mAllocator, a );
+		}
+		self->transient_heaps.clear();
+		self->transient_images.clear();
 	}
 	if ( self->mAllocator ) {
 		vmaDestroyAllocator( self->mAllocator );
@@ -1416,6 +1547,152 @@ static void backend_setup( le_backend_o* self ) {
 
 	backend_create_main_allocator( vkInstance, vkPhysicalDevice, vkDevice, &self->mAllocator );
 
+	// -- set up gpu timestamps, if requested - queues may only write timestamps
+	// if their queue family has valid timestamp bits.
+	//
+	// Settings have cleared hostQueryReset if the device does not support it. Passes must
+	// then reset their queries via vkCmdResetQueryPool, which queues that support neither
+	// graphics, nor compute may not record - we don't write timestamps on these queues.
+
+	if ( settings->gpu_timestamps_enabled ) {
+		uint32_t num_queue_families = 0;
+		vkGetPhysicalDeviceQueueFamilyProperties( vkPhysicalDevice, &num_queue_families, nullptr );
+		std::vector<VkQueueFamilyProperties> queue_family_properties( num_queue_families );
+		vkGetPhysicalDeviceQueueFamilyProperties( vkPhysicalDevice, &num_queue_families, queue_family_properties.data() );
+
+		self->gpu_timestamps.host_query_reset = settings->physical_device_features.vk_12.hostQueryReset;
+
+		for ( auto const& q : self->queues ) {
+			auto const& properties = queue_family_properties[ q->queue_family_index ];
+			uint32_t    valid_bits = properties.timestampValidBits;
+
+			if ( !self->gpu_timestamps.host_query_reset && !( properties.queueFlags & ( VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT ) ) ) {
+				valid_bits = 0;
+			}
+
+			self->gpu_timestamps.valid_bits_mask.push_back( valid_bits >= 64 ? ~uint64_t( 0 ) : ( uint64_t( 1 ) << valid_bits ) - 1 );
+		}
+
+		self->gpu_timestamps.tick_period_ns = vk_device_i.get_vk_physical_device_properties( *self->device )->limits.timestampPeriod;
+		self->gpu_timestamps.enabled        = true;
+	}
+
+	// -- set up bindless descriptor set layout, and a pool for per-frame bindless descriptor sets,
+	// if requested. We clamp the number of bindless textures, and buffers to device limits.
+
+	if ( settings->bindless_enabled ) {
+		auto& bindless = self->bindless;
+
+		VkPhysicalDeviceVulkan12Properties vk_12_properties{
+		    .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES,
+		    .pNext = nullptr,
+		};
+
+		VkPhysicalDeviceProperties2 properties{
+		    .sType      = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+		    .pNext      = &vk_12_properties,
+		    .properties = {},
+		};
+
+		vkGetPhysicalDeviceProperties2( vkPhysicalDevice, &properties );
+
+		bindless.max_textures = std::min( { LE_BINDLESS_MAX_TEXTURES,
+		                                    vk_12_properties.maxDescriptorSetUpdateAfterBindSampledImages,
+		                                    vk_12_properties.maxDescriptorSetUpdateAfterBindSamplers,
+		                                    vk_12_properties.maxPerStageDescriptorUpdateAfterBindSampledImages,
+		                                    vk_12_properties.maxPerStageDescriptorUpdateAfterBindSamplers } );
+
+		bindless.max_buffers = std::min( { LE_BINDLESS_MAX_BUFFERS,
+		                                   vk_12_properties.maxDescriptorSetUpdateAfterBindStorageBuffers,
+		                                   vk_12_properties.maxPerStageDescriptorUpdateAfterBindStorageBuffers } );
+
+		// Textures, and buffers together must not exceed the per-stage limit for update-after-bind
+		// resources - if they do, we share out this limit in proportion to what we asked for.
+		uint32_t const max_resources = vk_12_properties.maxPerStageUpdateAfterBindResources;
+
+		if ( uint64_t( bindless.max_textures ) + bindless.max_buffers > max_resources ) {
+			bindless.max_buffers  = uint32_t( uint64_t( max_resources ) * bindless.max_buffers / ( uint64_t( bindless.max_textures ) + bindless.max_buffers ) );
+			bindless.max_textures = max_resources - bindless.max_buffers;
+		}
+
+		VkDescriptorSetLayoutBinding bindings[ 2 ] = {
+		    {
+		        .binding            = 0,
+		        .descriptorType     = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+		        .descriptorCount    = bindless.max_textures,
+		        .stageFlags         = VK_SHADER_STAGE_ALL,
+		        .pImmutableSamplers = nullptr,
+		    },
+		    {
+		        .binding            = 1,
+		        .descriptorType     = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+		        .descriptorCount    = bindless.max_buffers,
+		        .stageFlags         = VK_SHADER_STAGE_ALL,
+		        .pImmutableSamplers = nullptr,
+		    },
+		};
+
+		// Only elements which a frame uses get written - all others may hold stale descriptors,
+		// which is fine as long as shaders don't access them.
+		VkDescriptorBindingFlags binding_flags[ 2 ] = {
+		    VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT,
+		    VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT,
+		};
+
+		VkDescriptorSetLayoutBindingFlagsCreateInfo binding_flags_info{
+		    .sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO,
+		    .pNext         = nullptr, // optional
+		    .bindingCount  = 2,
+		    .pBindingFlags = binding_flags,
+		};
+
+		VkDescriptorSetLayoutCreateInfo layout_info{
+		    .sType        = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+		    .pNext        = &binding_flags_info,
+		    .flags        = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT,
+		    .bindingCount = 2,
+		    .pBindings    = bindings,
+		};
+
+		VkResult result = vkCreateDescriptorSetLayout( vkDevice, &layout_info, nullptr, &bindless.layout );
+
+		if ( result != VK_SUCCESS ) {
+			logger.error( "Could not create bindless descriptor set layout." );
+			bindless.layout = nullptr;
+		}
+
+		VkDescriptorPoolSize pool_sizes[ 2 ] = {
+		    { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, bindless.max_textures * settings->data_frames_count },
+		    { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, bindless.max_buffers * settings->data_frames_count },
+		};
+
+		VkDescriptorPoolCreateInfo pool_info{
+		    .sType         = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+		    .pNext         = nullptr, // optional
+		    .flags         = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT,
+		    .maxSets       = settings->data_frames_count,
+		    .poolSizeCount = 2,
+		    .pPoolSizes    = pool_sizes,
+		};
+
+		if ( bindless.layout ) {
+			result = vkCreateDescriptorPool( vkDevice, &pool_info, nullptr, &bindless.pool );
+
+			if ( result != VK_SUCCESS ) {
+				logger.error( "Could not create bindless descriptor pool." );
+				bindless.pool = nullptr;
+			}
+		}
+
+		bindless.enabled = ( bindless.layout != nullptr && bindless.pool != nullptr );
+
+		if ( bindless.enabled ) {
+			logger.info( "Bindless mode: %d textures, %d storage buffers", bindless.max_textures, bindless.max_buffers );
+		} else {
+			logger.error( "Could not set up bindless mode - falling back to regular descriptor sets." );
+		}
+	}
+
 	// -- setup backend memory objects
 
 	self->mFrames.reserve( settings->data_frames_count );
@@ -1431,16 +1708,6 @@ static void backend_setup( le_backend_o* self ) {
 		BackendFrameData frameData{};
 		frameData.frameNumber = i;
 
-		{
-			VkFenceCreateInfo create_info = {
-			    .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
-			    .pNext = nullptr, // optional
-			    .flags = 0,       // optional
-			};
-
-			vkCreateFence( vkDevice, &create_info, nullptr, &frameData.frameFence ); // frence starts out as sigmalled
-		}
-
 		{
 			// -- set up an allocation pool for each frame
 			// so that each frame can create sub-allocators
@@ -1458,6 +1725,23 @@ static void backend_setup( le_backend_o* self ) {
 		using namespace le_backend_vk;
 		frameData.stagingAllocator = le_staging_allocator_i.create( self->mAllocator, vkDevice );
 
+		if ( self->bindless.enabled ) {
+			VkDescriptorSetAllocateInfo info{
+			    .sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+			    .pNext              = nullptr, // optional
+			    .descriptorPool     = self->bindless.pool,
+			    .descriptorSetCount = 1,
+			    .pSetLayouts        = &self->bindless.layout,
+			};
+			VkResult result = vkAllocateDescriptorSets( vkDevice, &info, &frameData.bindlessDescriptorSet );
+
+			if ( result != VK_SUCCESS ) {
+				// Sets which were already allocated get freed together with the pool.
+				logger.error( "Could not allocate bindless descriptor set - falling back to regular descriptor sets." );
+				self->bindless.enabled = false;
+			}
+		}
+
 		self->mFrames.emplace_back( std::move( frameData ) );
 	}
 
@@ -1783,7 +2067,9 @@ static std::string to_string_le_access_flags2( const le::AccessFlags2& tp ) {
 // each renderpass contains offsets into sync chain for given resource used by renderpass.
 // resource sync state for images used as renderpass attachments is chosen so that they
 // can be implicitly synced using subpass dependencies.
-static void le_renderpass_add_explicit_sync( le_renderpass_o const* pass, BackendRenderPass& currentPass, BackendFrameData::sync_chain_table_t& syncChainTable ) {
+// sampled images are requested in the layout which matches their declared usage, see
+// get_sampled_image_layout - descriptors for textures use the same layout.
+static void le_renderpass_add_explicit_sync( le_renderpass_o const* pass, BackendRenderPass& currentPass, BackendFrameData::sync_chain_table_t& syncChainTable, BackendFrameData::ResourceMap_T const& availableResources ) {
 	using namespace le_renderer;
 	le_resource_handle const* resources        = nullptr;
 	le::AccessFlags2 const*   resources_access = nullptr;
@@ -1833,7 +2119,7 @@ static void le_renderpass_add_explicit_sync( le_renderpass_o const* pass, Backen
 			if ( resources_access[ i ] & VK_ACCESS_2_SHADER_SAMPLED_READ_BIT ) {
 				requestedState.visible_access = resources_access[ i ];
 				requestedState.stage          = get_stage_flags_based_on_renderpass_type( currentPass.type );
-				requestedState.layout         = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+				requestedState.layout         = get_sampled_image_layout( availableResources.at( resource ).info.imageInfo );
 
 				// Test whether the previous state for this resource is already what we need it to be
 				//
@@ -1958,7 +2244,7 @@ static void frame_track_resource_state(
 
 		// Find explicit sync ops needed for resources which are not attachments
 		//
-		le_renderpass_add_explicit_sync( *pass, currentPass, syncChainTable );
+		le_renderpass_add_explicit_sync( *pass, currentPass, syncChainTable, frame.availableResources );
 
 		// Iterate over all image attachments
 		le_renderpass_add_attachments( *pass, currentPass, frame, currentPass.sampleCount );
@@ -2083,17 +2369,27 @@ static void backend_debug_print_framedata( BackendFrameData const& frame ) {
 // ----------------------------------------------------------------------
 
 /// \brief polls frame fence, returns true if fence has been crossed, false otherwise.
+/// \note the frame fence is a value on the timeline semaphore of the default graphics
+/// queue: the last submission of each frame signals this value once all queues have
+/// completed all work for this frame. A frame which was never submitted waits for 0,
+/// which is always reached.
 static bool backend_poll_frame_fence( le_backend_o* self, size_t frameIndex ) {
 	ZoneScoped;
 	static auto logger = LeLog( LOGGER_LABEL );
 	auto&       frame  = self->mFrames[ frameIndex ];
 	VkDevice    device = self->device->getVkDevice();
 
-	// Non-blocking, polling
-	// auto result = device.getFenceStatus( {frame.frameFence} );
+	VkSemaphoreWaitInfo wait_info = {
+	    .sType          = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+	    .pNext          = nullptr, // optional
+	    .flags          = 0,       // optional
+	    .semaphoreCount = 1,
+	    .pSemaphores    = &self->queues[ self->queue_default_graphics_idx ]->semaphore,
+	    .pValues        = &frame.frameTimelineValue,
+	};
 
 	// NOTE: this may block.
-	auto result = vkWaitForFences( device, 1, &frame.frameFence, true, 100'000'000 );
+	auto result = vkWaitSemaphores( device, &wait_info, 100'000'000 );
 	// le::Log( LOGGER_LABEL ).info( "=[%3d]== frame fence cleared", frameIndex );
 
 	if ( result == VK_ERROR_DEVICE_LOST ) {
@@ -2107,6 +2403,303 @@ static bool backend_poll_frame_fence( le_backend_o* self, size_t frameIndex ) {
 	}
 }
 
+// ----------------------------------------------------------------------
+#if defined( TRACY_ENABLE )
+// Forwards pass timings to Tracy as gpu zones - one tracy gpu context per queue.
+//
+// We don't calibrate gpu, and cpu clocks: each context starts at the first timestamp
+// that we forward, which means that gpu zones appear shifted by about a frame's latency
+// against cpu zones. Durations, and the order of gpu zones are exact.
+static void backend_tracy_emit_gpu_zones( le_backend_o* self, std::vector<le_pass_timing_t> const& timings, std::vector<uint64_t> const& begin_ticks, std::vector<uint64_t> const& end_ticks ) {
+	auto& ts = self->gpu_timestamps; // note: caller must hold ts.mtx
+
+	if ( !TracyIsConnected ) {
+		return;
+	}
+
+	if ( ts.tracy_contexts.empty() ) {
+		ts.tracy_contexts.resize( self->queues.size(), -1 );
+	}
+
+	for ( size_t i = 0; i != timings.size(); i++ ) {
+
+		auto const& timing  = timings[ i ];
+		int16_t&    context = ts.tracy_contexts[ timing.queue_idx ];
+
+		if ( context == -1 ) {
+			context = int16_t( tracy::GetGpuCtxCounter().fetch_add( 1, std::memory_order_relaxed ) );
+			___tracy_emit_gpu_new_context_serial( {
+			    .gpuTime = int64_t( begin_ticks[ i ] ),
+			    .period  = float( ts.tick_period_ns ),
+			    .context = uint8_t( context ),
+			    .flags   = 0,
+			    .type    = 2, // tracy::GpuContextType::Vulkan
+			} );
+			char name[ 32 ];
+			int  name_len = snprintf( name, sizeof( name ), "Queue %u", timing.queue_idx );
+			___tracy_emit_gpu_context_name_serial( { .context = uint8_t( context ), .name = name, .len = uint16_t( name_len ) } );
+		}
+
+		auto [ it, was_inserted ] = ts.tracy_source_locations.try_emplace( timing.pass_name );
+		if ( was_inserted ) {
+			it->second = { .name = it->first.c_str(), .function = "pass", .file = __FILE__, .line = uint32_t( __LINE__ ), .color = 0 };
+		}
+
+		uint16_t query_id = ts.tracy_next_query_id;
+		ts.tracy_next_query_id += 2;
+
+		___tracy_emit_gpu_zone_begin_serial( { .srcloc = uint64_t( &it->second ), .queryId = query_id, .context = uint8_t( context ) } );
+		___tracy_emit_gpu_time_serial( { .gpuTime = int64_t( begin_ticks[ i ] ), .queryId = query_id, .context = uint8_t( context ) } );
+		___tracy_emit_gpu_zone_end_serial( { .queryId = uint16_t( query_id + 1 ), .context = uint8_t( context ) } );
+		___tracy_emit_gpu_time_serial( { .gpuTime = int64_t( end_ticks[ i ] ), .queryId = uint16_t( query_id + 1 ), .context = uint8_t( context ) } );
+	}
+}
+#endif
+
+// ----------------------------------------------------------------------
+// Reads back timestamp queries for all passes of a frame, and makes these
+// available via `get_pass_timings`.
+//
+// Preliminary: frame fence must have been crossed - this means that all queries
+// which were written will be available, and that reading them back won't block.
+static void backend_frame_collect_pass_timings( le_backend_o* self, BackendFrameData& frame ) {
+	ZoneScoped;
+
+	auto& ts = self->gpu_timestamps;
+
+	struct query_result_t {
+		uint64_t timestamp;
+		uint64_t availability;
+	};
+
+	uint32_t const              num_queries = uint32_t( frame.pass_timings.size() * 2 );
+	std::vector<query_result_t> results( num_queries );
+
+	// Note that VK_NOT_READY is expected if not all passes wrote timestamps - for example
+	// if they were executed on a queue which does not support timestamps.
+	VkResult result = vkGetQueryPoolResults( self->device->getVkDevice(), frame.timestamp_query_pool, 0, num_queries,
+	                                         results.size() * sizeof( query_result_t ), results.data(), sizeof( query_result_t ),
+	                                         VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT );
+
+	if ( result != VK_SUCCESS && result != VK_NOT_READY ) {
+		frame.pass_timings.clear();
+		return;
+	}
+
+	std::vector<le_pass_timing_t> timings;
+	std::vector<uint64_t>         begin_ticks;
+	std::vector<uint64_t>         end_ticks;
+	std::vector<int64_t>          begin_offsets; // per timing: ticks since first pass which wrote timestamps - negative if earlier
+
+	timings.reserve( frame.pass_timings.size() );
+	begin_ticks.reserve( frame.pass_timings.size() );
+	end_ticks.reserve( frame.pass_timings.size() );
+	begin_offsets.reserve( frame.pass_timings.size() );
+
+	// Timestamps only have valid bits per queue, and may wrap around within a frame: we calculate
+	// differences modulo the number of valid bits, and assume that timestamps within a frame are
+	// less than half the range of valid bits apart.
+	auto ticks_diff = []( uint64_t a, uint64_t b, uint64_t mask ) -> int64_t {
+		uint64_t const d = ( a - b ) & mask;
+		return d > ( mask >> 1 ) ? -int64_t( ( b - a ) & mask ) : int64_t( d );
+	};
+
+	int64_t frame_begin_offset = 0;
+
+	for ( size_t i = 0; i != frame.pass_timings.size(); i++ ) {
+
+		auto const& timing = frame.pass_timings[ i ];
+		auto const& begin  = results[ i * 2 ];
+		auto const& end    = results[ i * 2 + 1 ];
+
+		if ( timing.queue_idx == uint32_t( ~0 ) || 0 == begin.availability || 0 == end.availability ) {
+			continue; // pass did not write timestamps
+		}
+
+		uint64_t const mask     = ts.valid_bits_mask[ timing.queue_idx ];
+		uint64_t const duration = ( end.timestamp - begin.timestamp ) & mask;
+
+		timings.push_back( timing );
+		begin_ticks.push_back( begin.timestamp & mask );
+		end_ticks.push_back( begin_ticks.back() + duration );
+		begin_offsets.push_back( begin_ticks.size() == 1 ? 0 : ticks_diff( begin.timestamp, begin_ticks.front(), mask ) );
+
+		frame_begin_offset = std::min( frame_begin_offset, begin_offsets.back() );
+	}
+
+	for ( size_t i = 0; i != timings.size(); i++ ) {
+		timings[ i ].begin_ms    = double( begin_offsets[ i ] - frame_begin_offset ) * ts.tick_period_ns * 1e-6;
+		timings[ i ].duration_ms = double( end_ticks[ i ] - begin_ticks[ i ] ) * ts.tick_period_ns * 1e-6;
+	}
+
+	{
+		std::scoped_lock lock( ts.mtx );
+
+		ts.last_timings.swap( timings );
+		ts.last_frame_number = frame.frameNumber;
+
+#if defined( TRACY_ENABLE )
+		backend_tracy_emit_gpu_zones( self, ts.last_timings, begin_ticks, end_ticks );
+#endif
+	}
+
+	frame.pass_timings.clear();
+}
+
+// ----------------------------------------------------------------------
+
+static bool backend_get_pass_timings( le_backend_o* self, le_pass_timing_t* p_timings, size_t* num_timings, uint64_t* p_frame_number ) {
+	auto&            ts = self->gpu_timestamps;
+	std::scoped_lock lock( ts.mtx );
+
+	if ( p_timings == nullptr || *num_timings < ts.last_timings.size() ) {
+		*num_timings = ts.last_timings.size();
+		return false;
+	}
+
+	// ---------| invariant: p_timings can hold all timings
+
+	std::copy( ts.last_timings.begin(), ts.last_timings.end(), p_timings );
+	*num_timings = ts.last_timings.size();
+
+	if ( p_frame_number ) {
+		*p_frame_number = ts.last_frame_number;
+	}
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+// Bindless mode: hands out an index - caller must hold bindless.mtx
+static uint32_t bindless_index_allocate( le_backend_o::bindless_t::index_allocator_t& a, uint32_t max_count ) {
+	if ( !a.free_indices.empty() ) {
+		uint32_t index = a.free_indices.back();
+		a.free_indices.pop_back();
+		return index;
+	}
+	if ( a.next_index < max_count ) {
+		return a.next_index++;
+	}
+	return LE_BINDLESS_INDEX_INVALID;
+}
+
+// ----------------------------------------------------------------------
+// Bindless mode: recycles released indices which no frame may still be using - caller must hold bindless.mtx
+static void bindless_index_recycle( le_backend_o::bindless_t::index_allocator_t& a, uint64_t cleared_frame_number ) {
+	auto it = a.pending_releases.begin();
+	while ( it != a.pending_releases.end() ) {
+		if ( it->frame_number <= cleared_frame_number ) {
+			a.free_indices.push_back( it->index );
+			it = a.pending_releases.erase( it );
+		} else {
+			it++;
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+
+template <typename Handle>
+static uint32_t backend_get_bindless_index( le_backend_o* self, std::unordered_map<Handle, uint32_t>& indices, le_backend_o::bindless_t::index_allocator_t& allocator, uint32_t max_count, Handle handle ) {
+
+	if ( !self->bindless.enabled || handle == nullptr ) {
+		return LE_BINDLESS_INDEX_INVALID;
+	}
+
+	std::scoped_lock lock( self->bindless.mtx );
+
+	auto it = indices.find( handle );
+
+	if ( it != indices.end() ) {
+		return it->second;
+	}
+
+	// ----------| invariant: handle has no index yet
+
+	uint32_t index = bindless_index_allocate( allocator, max_count );
+
+	if ( index == LE_BINDLESS_INDEX_INVALID ) {
+		static auto logger = LeLog( LOGGER_LABEL );
+		logger.error( "Out of bindless indices - could not hand out more than %d indices.", max_count );
+		return index;
+	}
+
+	indices.emplace( handle, index );
+
+	return index;
+}
+
+// ----------------------------------------------------------------------
+
+template <typename Handle>
+static void backend_release_bindless_index( le_backend_o* self, std::unordered_map<Handle, uint32_t>& indices, le_backend_o::bindless_t::index_allocator_t& allocator, Handle handle ) {
+
+	if ( !self->bindless.enabled ) {
+		return;
+	}
+
+	std::scoped_lock lock( self->bindless.mtx );
+
+	auto it = indices.find( handle );
+
+	if ( it == indices.end() ) {
+		return;
+	}
+
+	// Frames which are in flight, or which are being recorded right now may still use this index.
+	// Any of these frames will have been cleared once the frame which is currently the most
+	// recently cleared frame comes round to be cleared again.
+	allocator.pending_releases.push_back( { it->second, self->bindless.last_cleared_frame_number + self->mFrames.size() } );
+
+	indices.erase( it );
+}
+
+// ----------------------------------------------------------------------
+
+static uint32_t backend_get_bindless_texture_index( le_backend_o* self, le_texture_handle texture ) {
+	return backend_get_bindless_index( self, self->bindless.textures, self->bindless.texture_indices, self->bindless.max_textures, texture );
+}
+
+static uint32_t backend_get_bindless_buffer_index( le_backend_o* self, le_buf_resource_handle buffer ) {
+	if ( buffer &&
+	     ( buffer->data->flags == uint8_t( le_buf_resource_usage_flags_t::eIsVirtual ) ||
+	       buffer->data->flags == uint8_t( le_buf_resource_usage_flags_t::eIsStaging ) ) ) {
+		// Transient, and staging buffers are sub-allocations which change with every frame.
+		static auto logger = LeLog( LOGGER_LABEL );
+		logger.error( "Buffer '%s' is transient, or staging - only persistent buffers may be bindless.", buffer->data->debug_name );
+		return LE_BINDLESS_INDEX_INVALID;
+	}
+	return backend_get_bindless_index( self, self->bindless.buffers, self->bindless.buffer_indices, self->bindless.max_buffers, buffer );
+}
+
+static void backend_release_bindless_texture( le_backend_o* self, le_texture_handle texture ) {
+	backend_release_bindless_index( self, self->bindless.textures, self->bindless.texture_indices, texture );
+
+	if ( self->bindless.enabled ) {
+		std::scoped_lock lock( self->bindless.mtx );
+		self->bindless.texture_infos.erase( texture );
+	}
+}
+
+static void backend_release_bindless_buffer( le_backend_o* self, le_buf_resource_handle buffer ) {
+	backend_release_bindless_index( self, self->bindless.buffers, self->bindless.buffer_indices, buffer );
+}
+
+static VkDescriptorSetLayout backend_get_bindless_descriptor_set_layout( le_backend_o* self ) {
+	return self->bindless.enabled ? self->bindless.layout : nullptr;
+}
+
+// ----------------------------------------------------------------------
+
+static void backend_get_descriptor_write_counts( le_backend_o* self, uint32_t* num_argument_writes, uint32_t* num_bindless_writes ) {
+	if ( num_argument_writes ) {
+		*num_argument_writes = self->num_argument_descriptor_writes;
+	}
+	if ( num_bindless_writes ) {
+		*num_bindless_writes = self->num_bindless_descriptor_writes;
+	}
+}
+
 // ----------------------------------------------------------------------
 /// \brief: Frees all frame local resources
 /// \preliminary: frame fence must have been crossed.
@@ -2138,7 +2731,11 @@ static bool backend_clear_frame( le_backend_o* self, size_t frameIndex ) {
 	// -------- Invariant: fence has been crossed, all resources protected by fence
 	//          can now be claimed back.
 
-	vkResetFences( device, 1, &frame.frameFence );
+	frame.frameTimelineValue = 0;
+
+	if ( !frame.pass_timings.empty() ) {
+		backend_frame_collect_pass_timings( self, frame );
+	}
 
 	// -- reset all frame-local sub-allocators
 	for ( auto& alloc : frame.allocators ) {
@@ -2150,6 +2747,7 @@ static bool backend_clear_frame( le_backend_o* self, size_t frameIndex ) {
 
 	// -- remove any texture references
 	frame.textures_per_pass.clear();
+	frame.bindless_textures.clear();
 
 	// -- remove any image view references
 	frame.imageViews.clear();
@@ -2224,6 +2822,14 @@ static bool backend_clear_frame( le_backend_o* self, size_t frameIndex ) {
 		cs->reset();
 	}
 
+	if ( self->bindless.enabled ) {
+		// Released bindless indices may be recycled once no frame which might use them is in flight.
+		std::scoped_lock lock( self->bindless.mtx );
+		self->bindless.last_cleared_frame_number = std::max( self->bindless.last_cleared_frame_number, uint64_t( frame.frameNumber ) ); // must never go backwards
+		bindless_index_recycle( self->bindless.texture_indices, frame.frameNumber );
+		bindless_index_recycle( self->bindless.buffer_indices, frame.frameNumber );
+	}
+
 	frame.frameNumber = self->mFramesCount++; // note post-increment
 
 	return true;
@@ -2628,16 +3234,6 @@ static inline AllocatedResourceVk const& frame_data_get_allocated_resource_from_
 	return frame->availableResources.at( rsp );
 }
 
-// ----------------------------------------------------------------------
-// if specific format for texture was not specified, return format of referenced image
-static inline VkFormat frame_data_get_image_format_from_texture_info( BackendFrameData const* frame, le_image_sampler_info_t const* texInfo ) {
-	if ( texInfo->imageView.format == le::Format::eUndefined ) {
-		return ( frame_data_get_image_format_from_resource_id( frame, texInfo->imageView.imageId ) );
-	} else {
-		return static_cast<VkFormat>( texInfo->imageView.format );
-	}
-}
-
 // ----------------------------------------------------------------------
 
 VkImageAspectFlags get_aspect_flags_from_format( le::Format const& format ) {
@@ -3356,6 +3952,11 @@ inline void frame_release_binned_resources( BackendFrameData& frame, VmaAllocato
 		}
 	}
 	frame.binnedResources.clear();
+
+	for ( auto& a : frame.binnedAllocations ) {
+		vmaFreeMemory( allocator, a );
+	}
+	frame.binnedAllocations.clear();
 }
 
 // ----------------------------------------------------------------------
@@ -3397,6 +3998,9 @@ static inline void consolidate_resource_info_into( le_resource_info_t& lhs, le_r
 		lhs.image.flags |= rhs.image.flags;
 		lhs.image.usage |= rhs.image.usage;
 
+		// An image is transient if any of its declarations says so - uses inferred from passes never do.
+		lhs.image.is_transient = lhs.image.is_transient || rhs.image.is_transient;
+
 		// If an image format was explictly set, this takes precedence over eUndefined.
 		// Note that we skip this block if both infos have the same format, so if both
 		// infos are eUndefined, format stays undefined.
@@ -3784,6 +4388,341 @@ static void frame_resources_set_debug_names( le_backend_vk_instance_o* instance,
 	}
 }
 
+// ----------------------------------------------------------------------
+// Executes on the DISPATCH FRAME, from within backend_allocate_resources,
+// while backend resources are locked.
+//
+// Transient images (see ImageInfoBuilder::setIsTransient) don't keep their contents
+// beyond the frame - which means that two transient images may share memory, as long
+// as no pass which uses one of them lies between the first and last pass which use the
+// other. We find the first, and last pass for each transient image, then assign images
+// to shared allocations (heaps) via greedy interval colouring: we visit images in order
+// of first use, and place each image in the heap which needs to grow least, out of all
+// heaps whose images are no longer used by the time this image is first used.
+//
+// Images may only share memory with images used by passes from the same tree of passes,
+// as only passes from the same tree are submitted together, and execute in pass order.
+//
+// Vulkan images can't be bound to different memory once bound, which is why we re-create
+// images and heaps whenever this layout changes - otherwise we re-use images, and heaps
+// from the previous frame.
+//
+// Each transient image starts the frame in an undefined layout, with a dependency on all
+// earlier commands, and writes: this acts as the aliasing barrier against any earlier
+// image which used the same memory.
+//
+static void backend_alias_transient_images(
+    le_backend_o*                                                     self,
+    BackendFrameData&                                                 frame,
+    std::unordered_map<le_resource_handle, AllocatedResourceVk>&      backend_resources,
+    le_renderpass_o**                                                 passes,
+    size_t                                                            numRenderPasses,
+    std::unordered_map<le_resource_handle, le_resource_info_t> const& active_resources ) {
+	ZoneScoped;
+
+	using namespace le_renderer;
+	using transient_image_t = le_backend_o::transient_image_t;
+
+	static auto logger = LeLog( LOGGER_LABEL );
+
+	std::vector<transient_image_t>                     images;
+	std::unordered_map<le_resource_handle, size_t> image_index; // index into images, by handle
+
+	for ( auto const& [ resource, info ] : active_resources ) {
+		if ( info.type == LeResourceType::eImage &&
+		     info.image.is_transient &&
+		     frame.availableResources.find( resource ) == frame.availableResources.end() ) {
+			transient_image_t img{};
+			img.handle     = resource;
+			img.first_pass = ~0u;
+			img.last_pass  = 0;
+			image_index[ resource ] = images.size();
+			images.emplace_back( img );
+		}
+	}
+
+	if ( images.empty() && self->transient_images.empty() ) {
+		return;
+	}
+
+	// -- Find trees of passes: passes whose root pass affinities overlap end up in the same tree.
+
+	std::vector<le::RootPassesField> pass_affinities( numRenderPasses );
+	std::vector<le::RootPassesField> trees;
+
+	for ( size_t i = 0; i != numRenderPasses; i++ ) {
+
+		le::QueueFlagBits pass_type{};
+		renderpass_i.get_queue_sumbission_info( passes[ i ], &pass_type, &pass_affinities[ i ] );
+
+		le::RootPassesField tree = pass_affinities[ i ];
+
+		for ( auto it = trees.begin(); it != trees.end(); ) {
+			if ( *it & tree ) {
+				tree |= *it;
+				it = trees.erase( it );
+			} else {
+				it++;
+			}
+		}
+
+		trees.push_back( tree );
+	}
+
+	// -- Find first, and last pass for each transient image. Multisampled versions
+	// of an image are used by the same passes as the image itself.
+
+	uint32_t const last_pass_idx = uint32_t( numRenderPasses ? numRenderPasses - 1 : 0 );
+
+	for ( uint32_t i = 0; i != numRenderPasses; i++ ) {
+
+		le::RootPassesField pass_tree = 0;
+
+		for ( auto const& t : trees ) {
+			if ( t & pass_affinities[ i ] ) {
+				pass_tree = t;
+				break;
+			}
+		}
+
+		uint32_t                pass_width        = 0;
+		uint32_t                pass_height       = 0;
+		le::SampleCountFlagBits pass_sample_count = {};
+
+		renderpass_i.get_framebuffer_settings( passes[ i ], &pass_width, &pass_height, &pass_sample_count );
+
+		uint16_t const pass_num_samples_log2 = get_sample_count_log_2( uint32_t( pass_sample_count ) );
+
+		le_resource_handle const* p_resources              = nullptr;
+		le::AccessFlags2 const*   p_resources_access_flags = nullptr;
+		size_t                    resources_count          = 0;
+
+		renderpass_i.get_used_resources( passes[ i ], &p_resources, &p_resources_access_flags, &resources_count );
+
+		auto update_lifetime = [ & ]( le_resource_handle const& resource ) {
+			auto it = image_index.find( resource );
+
+			if ( it == image_index.end() ) {
+				return;
+			}
+
+			transient_image_t& img = images[ it->second ];
+
+			if ( img.first_pass == ~0u ) {
+				img.first_pass = i;
+				img.tree       = pass_tree;
+			} else if ( img.tree != pass_tree ) {
+				// Image is used from more than one tree - it must not share memory.
+				img.first_pass = 0;
+				img.tree       = 0;
+			}
+
+			img.last_pass = i;
+		};
+
+		for ( size_t j = 0; j != resources_count; j++ ) {
+
+			le_resource_handle const& resource = p_resources[ j ];
+
+			if ( resource->data->type != LeResourceType::eImage ) {
+				continue;
+			}
+
+			update_lifetime( resource );
+
+			if ( pass_num_samples_log2 != 0 ) {
+				update_lifetime( renderer_i.produce_img_resource_handle(
+				    resource->data->debug_name, uint8_t( pass_num_samples_log2 ), static_cast<le_img_resource_handle>( resource ), 0 ) );
+			}
+		}
+	}
+
+	for ( auto& img : images ) {
+
+		if ( img.first_pass == ~0u || img.tree == 0 ) {
+			// Image is used from more than one tree, or not used by any pass: it must not share
+			// memory - a lifetime which spans all passes makes sure that it gets its own heap.
+			img.first_pass = 0;
+			img.last_pass  = last_pass_idx;
+			img.tree       = 0;
+		}
+
+		img.info = ResourceCreateInfo::from_le_resource_info( active_resources.at( img.handle ) );
+
+		patchImageUsageForMipLevels( &img.info );
+
+		if ( img.info.imageInfo.format == VK_FORMAT_UNDEFINED ) {
+			inferImageFormat( self, static_cast<le_img_resource_handle>( img.handle ), active_resources.at( img.handle ).image.usage, &img.info );
+		}
+	}
+
+	std::sort( images.begin(), images.end(), []( transient_image_t const& lhs, transient_image_t const& rhs ) {
+		return lhs.first_pass != rhs.first_pass ? lhs.first_pass < rhs.first_pass
+		       : lhs.last_pass != rhs.last_pass ? lhs.last_pass < rhs.last_pass
+		                                        : lhs.handle < rhs.handle;
+	} );
+
+	// -- Re-use images from the previous frame if the layout did not change.
+
+	bool layout_changed = images.size() != self->transient_images.size();
+
+	for ( size_t i = 0; !layout_changed && i != images.size(); i++ ) {
+		transient_image_t const& lhs = images[ i ];
+		transient_image_t const& rhs = self->transient_images[ i ];
+
+		layout_changed = lhs.handle != rhs.handle ||
+		                 lhs.first_pass != rhs.first_pass ||
+		                 lhs.last_pass != rhs.last_pass ||
+		                 lhs.tree != rhs.tree ||
+		                 !( lhs.info == rhs.info ) ||
+		                 backend_resources.find( lhs.handle ) == backend_resources.end();
+	}
+
+	if ( layout_changed ) {
+
+		VkDevice device = self->device->getVkDevice();
+
+		// -- Bin images, and heaps from the previous layout - frames in flight may still use them.
+
+		for ( auto const& img : self->transient_images ) {
+			auto it = backend_resources.find( img.handle );
+			if ( it != backend_resources.end() ) {
+				frame.binnedResources.try_emplace( img.handle, it->second );
+				backend_resources.erase( it );
+			}
+		}
+
+		frame.binnedAllocations.insert( frame.binnedAllocations.end(), self->transient_heaps.begin(), self->transient_heaps.end() );
+		self->transient_heaps.clear();
+
+		// -- Create images, so that we can query their memory requirements.
+
+		std::vector<VkImage> vk_images( images.size() );
+
+		for ( size_t i = 0; i != images.size(); i++ ) {
+			VkResult result = vkCreateImage( device, &images[ i ].info.imageInfo, nullptr, &vk_images[ i ] );
+			assert( result == VK_SUCCESS );
+			vkGetImageMemoryRequirements( device, vk_images[ i ], &images[ i ].memory_requirements );
+		}
+
+		// -- Assign images to heaps.
+
+		struct heap_t {
+			VkMemoryRequirements requirements; // combined requirements for all images in this heap
+			le::RootPassesField  tree;         //
+			uint32_t             last_pass;    // last pass which uses any image in this heap
+		};
+
+		std::vector<heap_t> heaps;
+
+		for ( auto& img : images ) {
+
+			VkMemoryRequirements const& req = img.memory_requirements;
+
+			uint32_t     best_heap   = ~0u;
+			VkDeviceSize best_growth = ~VkDeviceSize( 0 );
+
+			for ( uint32_t h = 0; h != heaps.size(); h++ ) {
+
+				heap_t const& heap = heaps[ h ];
+
+				if ( img.tree == 0 || heap.tree != img.tree || heap.last_pass >= img.first_pass ||
+				     0 == ( heap.requirements.memoryTypeBits & req.memoryTypeBits ) ) {
+					continue;
+				}
+
+				VkDeviceSize growth = std::max( heap.requirements.size, req.size ) - heap.requirements.size;
+
+				if ( growth < best_growth ||
+				     ( growth == best_growth && heap.requirements.size < heaps[ best_heap ].requirements.size ) ) {
+					best_growth = growth;
+					best_heap   = h;
+				}
+			}
+
+			if ( best_heap == ~0u ) {
+				best_heap = uint32_t( heaps.size() );
+				heaps.push_back( { req, img.tree, img.last_pass } );
+			} else {
+				heap_t& heap                     = heaps[ best_heap ];
+				heap.requirements.size           = std::max( heap.requirements.size, req.size );
+				heap.requirements.alignment      = std::max( heap.requirements.alignment, req.alignment );
+				heap.requirements.memoryTypeBits = heap.requirements.memoryTypeBits & req.memoryTypeBits;
+				heap.last_pass                   = img.last_pass;
+			}
+
+			img.heap_idx = best_heap;
+		}
+
+		// -- Allocate heaps, and bind images to heaps.
+
+		VmaAllocationCreateInfo allocation_create_info{};
+		allocation_create_info.flags          = {}; // default flags
+		allocation_create_info.usage          = VMA_MEMORY_USAGE_GPU_ONLY;
+		allocation_create_info.preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+		std::vector<VmaAllocationInfo> heap_infos( heaps.size() );
+
+		uint64_t num_bytes_shared = 0;
+
+		for ( size_t h = 0; h != heaps.size(); h++ ) {
+			VmaAllocation allocation = nullptr;
+			int32_t       result     = backend_allocate_gpu_memory( self, &allocation_create_info, &heaps[ h ].requirements, &allocation, &heap_infos[ h ] );
+			assert( result == VK_SUCCESS );
+			self->transient_heaps.push_back( allocation );
+			num_bytes_shared += heaps[ h ].requirements.size;
+		}
+
+		uint64_t num_bytes_separate = 0;
+
+		for ( size_t i = 0; i != images.size(); i++ ) {
+
+			transient_image_t const& img = images[ i ];
+
+			VkResult result = vmaBindImageMemory( self->mAllocator, self->transient_heaps[ img.heap_idx ], vk_images[ i ] );
+			assert( result == VK_SUCCESS );
+
+			num_bytes_separate += img.memory_requirements.size;
+
+			AllocatedResourceVk res{};
+			res.as.image       = vk_images[ i ];
+			res.allocation     = nullptr; // memory is owned by transient_heaps
+			res.allocationInfo = heap_infos[ img.heap_idx ];
+			res.info           = img.info;
+
+			// If this image was previously allocated as a regular image, that version must be recycled.
+			auto it = backend_resources.find( img.handle );
+			if ( it != backend_resources.end() ) {
+				frame.binnedResources.try_emplace( img.handle, it->second );
+			}
+
+			backend_resources.insert_or_assign( img.handle, res );
+
+			printResourceInfo( img.handle, res.info, "ALLOC (ALIASED)" );
+		}
+
+		if ( !images.empty() ) {
+			logger.info( "Transient images: %zu images share %zu allocations, using %llu bytes instead of %llu, which saves %llu bytes (%.1f%%) per frame.",
+			             images.size(), heaps.size(),
+			             ( unsigned long long )num_bytes_shared, ( unsigned long long )num_bytes_separate, ( unsigned long long )( num_bytes_separate - num_bytes_shared ),
+			             100.0 * double( num_bytes_separate - num_bytes_shared ) / double( num_bytes_separate ) );
+		}
+
+		self->transient_images = std::move( images );
+	}
+
+	// -- Make transient images available to the frame: contents are undefined at the start
+	// of the frame, and first use must wait for all earlier uses of the same memory.
+
+	for ( auto const& img : self->transient_images ) {
+		AllocatedResourceVk res   = backend_resources.at( img.handle );
+		res.state.stage           = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+		res.state.visible_access  = VK_ACCESS_2_MEMORY_WRITE_BIT;
+		res.state.layout          = VK_IMAGE_LAYOUT_UNDEFINED;
+		frame.availableResources.insert_or_assign( img.handle, res );
+	}
+}
+
 // ----------------------------------------------------------------------
 // Executes on the DISPATCH FRAME
 // towards the start of backend_acquire_physical_resources
@@ -3862,6 +4801,10 @@ static void backend_allocate_resources( le_backend_o* self, BackendFrameData& fr
 
 		auto [ backendResources, backend_resources_lock ] = self->get_allocated_resources();
 
+		// Transient images go first: once they are available to the frame,
+		// the following loop skips them.
+		backend_alias_transient_images( self, frame, backendResources, passes, numRenderPasses, active_resources );
+
 		for ( auto const& ar : active_resources ) {
 
 			le_resource_handle const& resource     = ar.first;
@@ -4054,9 +4997,104 @@ static void backend_allocate_resources( le_backend_o* self, BackendFrameData& fr
 		}
 	}
 
-	if ( DEBUG_TAG_RESOURCES ) {
-		frame_resources_set_debug_names( self->instance, self->device->getVkDevice(), frame.availableResources );
+	if ( DEBUG_TAG_RESOURCES ) {
+		frame_resources_set_debug_names( self->instance, self->device->getVkDevice(), frame.availableResources );
+	}
+}
+
+// ----------------------------------------------------------------------
+// Creates image view, and sampler for a texture which samples `image` - both are owned by
+// the frame, and get destroyed once the frame is cleared.
+static BackendFrameData::Texture frame_create_texture( BackendFrameData& frame, VkDevice const& device, VkImage image, VkImageCreateInfo const& image_info, le_image_sampler_info_t const& texInfo, VkSamplerYcbcrConversionInfo* ycbcr_conversion_info ) {
+
+	BackendFrameData::Texture tex;
+
+	tex.imageLayout = get_sampled_image_layout( image_info );
+
+	// if specific format for texture was not specified, use format of referenced image
+	le::Format const imageFormat = texInfo.imageView.format == le::Format::eUndefined ? le::Format( image_info.format ) : texInfo.imageView.format;
+	{
+		// Set or create vkImageview
+
+		VkImageSubresourceRange subresourceRange{
+		    .aspectMask     = get_aspect_flags_from_format( imageFormat ),
+		    .baseMipLevel   = 0,
+		    .levelCount     = VK_REMAINING_MIP_LEVELS, // we set VK_REMAINING_MIP_LEVELS which activates all mip levels remaining.
+		    .baseArrayLayer = texInfo.imageView.base_array_layer,
+		    .layerCount     = VK_REMAINING_ARRAY_LAYERS, // Fixme: texInfo.imageView.layer_count must be 6 if imageView.type is cubemap
+		};
+
+		// TODO: fill in additional image view create info based on info from pass...
+		VkImageViewCreateInfo imageViewCreateInfo;
+
+		imageViewCreateInfo = {
+		    .sType            = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+		    .pNext            = nullptr, // optional
+		    .flags            = 0,       // optional
+		    .image            = image,
+		    .viewType         = VkImageViewType( texInfo.imageView.image_view_type ),
+		    .format           = VkFormat( imageFormat ),
+		    .components       = {}, // default component mapping
+		    .subresourceRange = subresourceRange,
+		};
+
+		if ( VkFormat( imageFormat ) == VK_FORMAT_G8_B8R8_2PLANE_420_UNORM ) {
+			// if image is a planar image - we must create an image view with a sampler that can
+			// convert such an image
+			imageViewCreateInfo.pNext = ycbcr_conversion_info;
+		}
+
+		vkCreateImageView( device, &imageViewCreateInfo, nullptr, &tex.imageView );
+
+		// Store vk object references with frame-owned resources, so that
+		// the vk objects can be destroyed when frame crosses the fence.
+
+		AbstractPhysicalResource res;
+		res.asImageView = tex.imageView;
+		res.type        = AbstractPhysicalResource::Type::eImageView;
+
+		frame.ownedResources.emplace_front( std::move( res ) );
+	}
+
+	{
+		// Create VkSampler object on device in case we don't use an
+		// immutable sampler
+
+		if ( VkFormat( imageFormat ) != VK_FORMAT_G8_B8R8_2PLANE_420_UNORM ) {
+
+			VkSamplerCreateInfo samplerCreateInfo{
+			    .sType                   = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
+			    .pNext                   = nullptr, // optional
+			    .flags                   = 0,       // optional
+			    .magFilter               = VkFilter( texInfo.sampler.magFilter ),
+			    .minFilter               = VkFilter( texInfo.sampler.minFilter ),
+			    .mipmapMode              = VkSamplerMipmapMode( texInfo.sampler.mipmapMode ),
+			    .addressModeU            = VkSamplerAddressMode( texInfo.sampler.addressModeU ),
+			    .addressModeV            = VkSamplerAddressMode( texInfo.sampler.addressModeV ),
+			    .addressModeW            = VkSamplerAddressMode( texInfo.sampler.addressModeW ),
+			    .mipLodBias              = texInfo.sampler.mipLodBias,
+			    .anisotropyEnable        = texInfo.sampler.anisotropyEnable,
+			    .maxAnisotropy           = texInfo.sampler.maxAnisotropy,
+			    .compareEnable           = texInfo.sampler.compareEnable,
+			    .compareOp               = VkCompareOp( texInfo.sampler.compareOp ),
+			    .minLod                  = texInfo.sampler.minLod,
+			    .maxLod                  = texInfo.sampler.maxLod,
+			    .borderColor             = VkBorderColor( texInfo.sampler.borderColor ),
+			    .unnormalizedCoordinates = texInfo.sampler.unnormalizedCoordinates,
+			};
+			vkCreateSampler( device, &samplerCreateInfo, nullptr, &tex.sampler );
+			// Now store vk object references with frame-owned resources, so that
+			// the vk objects can be destroyed when frame crosses the fence.
+
+			AbstractPhysicalResource res;
+
+			res.asSampler = tex.sampler;
+			res.type      = AbstractPhysicalResource::Type::eSampler;
+			frame.ownedResources.emplace_front( std::move( res ) );
+		}
 	}
+
+	return tex;
 }
 
 // ----------------------------------------------------------------------
@@ -4183,101 +5221,100 @@ static void frame_allocate_transient_resources( BackendFrameData& frame, VkDevic
 			if ( frame.textures_per_pass[ pass_idx ].find( textureId ) == frame.textures_per_pass[ pass_idx ].end() ) {
 				// -- we need to allocate a new texture
 
-				auto& texInfo = textureInfos[ i ];
+				auto const& texInfo = textureInfos[ i ];
 
 				// -- Store Texture with frame so that decoder can find references
-				BackendFrameData::Texture tex;
-
-				auto const& imageFormat = le::Format( frame_data_get_image_format_from_texture_info( &frame, &texInfo ) );
-				{
-					// Set or create vkImageview
-
-					VkImageSubresourceRange subresourceRange{
-					    .aspectMask     = get_aspect_flags_from_format( imageFormat ),
-					    .baseMipLevel   = 0,
-					    .levelCount     = VK_REMAINING_MIP_LEVELS, // we set VK_REMAINING_MIP_LEVELS which activates all mip levels remaining.
-					    .baseArrayLayer = texInfo.imageView.base_array_layer,
-					    .layerCount     = VK_REMAINING_ARRAY_LAYERS, // Fixme: texInfo.imageView.layer_count must be 6 if imageView.type is cubemap
-					};
-
-					// TODO: fill in additional image view create info based on info from pass...
-					VkImageViewCreateInfo imageViewCreateInfo;
-
-					imageViewCreateInfo = {
-					    .sType            = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
-					    .pNext            = nullptr, // optional
-					    .flags            = 0,       // optional
-					    .image            = frame_data_get_image_from_le_resource_id( &frame, texInfo.imageView.imageId ),
-					    .viewType         = VkImageViewType( texInfo.imageView.image_view_type ),
-					    .format           = VkFormat( imageFormat ),
-					    .components       = {}, // default component mapping
-					    .subresourceRange = subresourceRange,
-					};
+				frame.textures_per_pass[ pass_idx ][ textureId ] =
+				    frame_create_texture( frame, device,
+				                          frame_data_get_image_from_le_resource_id( &frame, texInfo.imageView.imageId ),
+				                          frame.availableResources.at( texInfo.imageView.imageId ).info.imageInfo,
+				                          texInfo, ycbcr_conversion_info );
+			} else {
+				// The frame already has an element with such a texture id.
+				logger.error( "texture '%s' must have been defined multiple times using identical id within the same renderpass.", textureId );
+				assert( false && "texture must have been defined multiple times using identical id within the same renderpass." );
+			}
+		} // end for all textureIds
+	}     // end for all passes
+}
 
-					if ( VkFormat( imageFormat ) == VK_FORMAT_G8_B8R8_2PLANE_420_UNORM ) {
-						// if image is a planar image - we must create an image view with a sampler that can
-						// convert such an image
-						imageViewCreateInfo.pNext = ycbcr_conversion_info;
-					}
+// ----------------------------------------------------------------------
+// Executes on the DISPATCH FRAME
+//
+// Bindless mode: shaders may reach any bindless texture via its index - not just textures
+// which a pass of this frame samples. This frame's bindless descriptor set may still hold
+// descriptors written when it was last processed, which refer to image views, and samplers
+// that have since been destroyed. We therefore create textures for bindless textures which
+// no pass samples, so that their descriptors get written along with all others.
+//
+// We only learn a texture's image, and sampler once a pass declares it - and we can only
+// sample images which persist across frames, and which are already in the layout in which
+// they get sampled, as no pass of this frame transitions them.
+static void backend_frame_allocate_bindless_textures( le_backend_o* self, BackendFrameData& frame, VkDevice const& device, le_renderpass_o** passes, size_t numRenderPasses ) {
+	ZoneScoped;
+	using namespace le_renderer;
 
-					vkCreateImageView( device, &imageViewCreateInfo, nullptr, &tex.imageView );
+	auto& bindless = self->bindless;
 
-					// Store vk object references with frame-owned resources, so that
-					// the vk objects can be destroyed when frame crosses the fence.
+	if ( !bindless.enabled ) {
+		return;
+	}
 
-					AbstractPhysicalResource res;
-					res.asImageView = tex.imageView;
-					res.type        = AbstractPhysicalResource::Type::eImageView;
+	std::scoped_lock lock( bindless.mtx );
 
-					frame.ownedResources.emplace_front( std::move( res ) );
-				}
+	// -- remember image, and sampler for each bindless texture which a pass declares
 
-				{
-					// Create VkSampler object on device in case we don't use an
-					// immutable sampler
-
-					if ( VkFormat( imageFormat ) != VK_FORMAT_G8_B8R8_2PLANE_420_UNORM ) {
-
-						VkSamplerCreateInfo samplerCreateInfo{
-						    .sType                   = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO,
-						    .pNext                   = nullptr, // optional
-						    .flags                   = 0,       // optional
-						    .magFilter               = VkFilter( texInfo.sampler.magFilter ),
-						    .minFilter               = VkFilter( texInfo.sampler.minFilter ),
-						    .mipmapMode              = VkSamplerMipmapMode( texInfo.sampler.mipmapMode ),
-						    .addressModeU            = VkSamplerAddressMode( texInfo.sampler.addressModeU ),
-						    .addressModeV            = VkSamplerAddressMode( texInfo.sampler.addressModeV ),
-						    .addressModeW            = VkSamplerAddressMode( texInfo.sampler.addressModeW ),
-						    .mipLodBias              = texInfo.sampler.mipLodBias,
-						    .anisotropyEnable        = texInfo.sampler.anisotropyEnable,
-						    .maxAnisotropy           = texInfo.sampler.maxAnisotropy,
-						    .compareEnable           = texInfo.sampler.compareEnable,
-						    .compareOp               = VkCompareOp( texInfo.sampler.compareOp ),
-						    .minLod                  = texInfo.sampler.minLod,
-						    .maxLod                  = texInfo.sampler.maxLod,
-						    .borderColor             = VkBorderColor( texInfo.sampler.borderColor ),
-						    .unnormalizedCoordinates = texInfo.sampler.unnormalizedCoordinates,
-						};
-						vkCreateSampler( device, &samplerCreateInfo, nullptr, &tex.sampler );
-						// Now store vk object references with frame-owned resources, so that
-						// the vk objects can be destroyed when frame crosses the fence.
+	for ( size_t pass_idx = 0; pass_idx != numRenderPasses; ++pass_idx ) {
 
-						AbstractPhysicalResource res;
+		const le_texture_handle* textureIds     = nullptr;
+		size_t                   textureIdCount = 0;
+		renderpass_i.get_texture_ids( passes[ pass_idx ], &textureIds, &textureIdCount );
 
-						res.asSampler = tex.sampler;
-						res.type      = AbstractPhysicalResource::Type::eSampler;
-						frame.ownedResources.emplace_front( std::move( res ) );
-					}
-				}
+		const le_image_sampler_info_t* textureInfos     = nullptr;
+		size_t                         textureInfoCount = 0;
+		renderpass_i.get_texture_infos( passes[ pass_idx ], &textureInfos, &textureInfoCount );
 
-				frame.textures_per_pass[ pass_idx ][ textureId ] = tex;
-			} else {
-				// The frame already has an element with such a texture id.
-				logger.error( "texture '%s' must have been defined multiple times using identical id within the same renderpass.", textureId );
-				assert( false && "texture must have been defined multiple times using identical id within the same renderpass." );
+		for ( size_t i = 0; i != textureIdCount; i++ ) {
+			if ( bindless.textures.find( textureIds[ i ] ) != bindless.textures.end() ) {
+				bindless.texture_infos.insert_or_assign( textureIds[ i ], textureInfos[ i ] );
 			}
-		} // end for all textureIds
-	}     // end for all passes
+		}
+	}
+
+	// ----------| invariant: texture_infos holds the most recent declaration for each bindless texture
+
+	auto [ backend_resources, backend_resources_lock ] = self->get_allocated_resources();
+
+	for ( auto const& [ texture_handle, texture_info ] : bindless.texture_infos ) {
+
+		bool is_sampled_by_pass =
+		    std::any_of( frame.textures_per_pass.begin(), frame.textures_per_pass.end(),
+		                 [ & ]( BackendFrameData::texture_map_t const& textures ) {
+			                 return textures.find( texture_handle ) != textures.end();
+		                 } );
+
+		if ( is_sampled_by_pass ) {
+			// Texture descriptor gets written from the texture which the pass declared.
+			continue;
+		}
+
+		auto found_image = backend_resources.find( texture_info.imageView.imageId );
+
+		if ( found_image == backend_resources.end() ) {
+			// Image is transient, or has not been allocated yet.
+			continue;
+		}
+
+		auto const& image = found_image->second;
+
+		if ( image.state.layout != get_sampled_image_layout( image.info.imageInfo ) ) {
+			// Image must first be transitioned by a pass which samples it.
+			continue;
+		}
+
+		frame.bindless_textures[ texture_handle ] =
+		    frame_create_texture( frame, device, image.as.image, image.info.imageInfo, texture_info, &self->vk_sampler_ycbcr_conversion_info );
+	}
 }
 
 // ----------------------------------------------------------------------
@@ -4423,6 +5460,9 @@ static bool backend_acquire_physical_resources( le_backend_o*             self,
 	// -- allocate any transient vk objects such as image samplers, and image views
 	frame_allocate_transient_resources( frame, device, passes, numRenderPasses, &self->vk_sampler_ycbcr_conversion_info );
 
+	// -- allocate textures which shaders may only reach via their bindless index
+	backend_frame_allocate_bindless_textures( self, frame, device, passes, numRenderPasses );
+
 	// create renderpasses - use sync chain to apply implicit syncing for image attachment resources
 	backend_create_renderpasses( frame, device );
 
@@ -4535,7 +5575,8 @@ static bool updateArguments( const VkDevice&                    device,
                              const VkDescriptorPool&            descriptorPool_,
                              const ArgumentState&               argumentState,
                              std::array<DescriptorSetState, 8>& previousSetData,
-                             VkDescriptorSet*                   descriptorSets ) {
+                             VkDescriptorSet*                   descriptorSets,
+                             uint32_t&                          numDescriptorWrites ) {
 
 	static auto logger = LeLog( LOGGER_LABEL );
 	// -- allocate descriptors from descriptorpool based on set layout info
@@ -4563,6 +5604,13 @@ static bool updateArguments( const VkDevice&                    device,
 	// -- write data from descriptorSetData into freshly allocated DescriptorSets
 	for ( size_t setId = 0; setId != argumentState.setCount; ++setId ) {
 
+		if ( argumentState.bindlessLayout && argumentState.layouts[ setId ] == argumentState.bindlessLayout ) {
+			// The bindless set is written once per frame - we don't allocate a set for it.
+			descriptorSets[ setId ]            = argumentState.bindlessSet;
+			previousSetData[ setId ].setLayout = argumentState.bindlessLayout; // so that a regular set at this index must be re-allocated
+			continue;
+		}
+
 		// If argumentState contains invalid information (for example if an uniform has not been set yet)
 		// this will lead to SEGFAULT. You must ensure that argumentState contains valid information.
 		//
@@ -4653,8 +5701,12 @@ static bool updateArguments( const VkDevice&                    device,
 			// -- in such a case the parameters are the same between two descriptorSets,
 			// but the descriptorSetLayouts will be different, and you must allcate the matching
 			// descriptorSet.
+			//
+			// Note that we test the layout, not the data, to find out whether a set was ever
+			// allocated - a set may legitimately have no data, and must not be re-allocated
+			// with every draw just because of that.
 
-			if ( previousSetData[ setId ].setData.empty() ||
+			if ( previousSetData[ setId ].setLayout == nullptr ||
 			     previousSetData[ setId ].setData != argumentState.setData[ setId ] ||
 			     previousSetData[ setId ].setLayout != argumentState.layouts[ setId ] ) {
 
@@ -4750,6 +5802,8 @@ static bool updateArguments( const VkDevice&                    device,
 					}
 					vkUpdateDescriptorSets( device, uint32_t( write_descriptor_sets.size() ), write_descriptor_sets.data(), 0, nullptr );
 
+					numDescriptorWrites += uint32_t( write_descriptor_sets.size() );
+
 					// We must manually delete any WriteDescriptorSetAccelerationStructureKHR objects
 					for ( auto& w : write_acceleration_structures ) {
 						delete ( w );
@@ -4799,6 +5853,10 @@ static void debug_print_command( void*& cmd ) {
                 case (le::CommandType::eBuildRtxBlas): os << "eBuildRtxBlas"; break;
                 case (le::CommandType::eWriteToImage): os << "eWriteToImage"; break;
                 case (le::CommandType::eDrawMeshTasks): os << "eDrawMeshTasks"; break;
+                case (le::CommandType::eDrawIndirect): os << "eDrawIndirect"; break;
+                case (le::CommandType::eDrawIndexedIndirect): os << "eDrawIndexedIndirect"; break;
+                case (le::CommandType::eDrawIndirectCount): os << "eDrawIndirectCount"; break;
+                case (le::CommandType::eDrawIndexedIndirectCount): os << "eDrawIndexedIndirectCount"; break;
                 case (le::CommandType::eTraceRays): os << "eTraceRays"; break;
                 case (le::CommandType::eSetArgumentTlas): os << "eSetArgumentTlas"; break;
                 case (le::CommandType::eVideoDecoderExecuteCallback): os << "eVideoDecoderExecuteCallback"; break;
@@ -5104,6 +6162,113 @@ inline DescriptorData* find_descriptor_with_binding_number_and_array_idx(
 	return nullptr;
 }
 
+// ----------------------------------------------------------------------
+// Bindless mode: writes descriptors for all resources which have a bindless index, and which
+// this frame uses, into the frame's bindless descriptor set. Returns number of descriptors written.
+//
+// Image views, and samplers are re-created with every frame, which is why we must re-write
+// the descriptors for all bindless textures which a frame uses - but we do this only once per
+// frame, and with a single call.
+static uint32_t backend_frame_update_bindless_descriptors( le_backend_o* self, BackendFrameData& frame, VkDevice device ) {
+	ZoneScoped;
+
+	auto& bindless = self->bindless;
+
+	std::vector<VkDescriptorImageInfo>  image_infos;
+	std::vector<VkDescriptorBufferInfo> buffer_infos;
+	std::vector<VkWriteDescriptorSet>   writes;
+	std::vector<uint32_t>               texture_indices;
+	std::vector<uint32_t>               buffer_indices;
+
+	{
+		std::scoped_lock lock( bindless.mtx );
+
+		// Passes may sample the same texture - we only write its descriptor once.
+		std::vector<bool> is_texture_written( bindless.texture_indices.next_index, false );
+
+		auto add_texture_descriptors = [ & ]( BackendFrameData::texture_map_t const& textures ) {
+			for ( auto const& [ texture_handle, texture ] : textures ) {
+
+				auto found_index = bindless.textures.find( texture_handle );
+
+				if ( found_index == bindless.textures.end() ||
+				     is_texture_written[ found_index->second ] ||
+				     texture.sampler == nullptr ) {
+					// Textures which need an immutable sampler cannot be bindless.
+					continue;
+				}
+
+				is_texture_written[ found_index->second ] = true;
+
+				image_infos.push_back( { texture.sampler, texture.imageView, texture.imageLayout } );
+				texture_indices.push_back( found_index->second );
+			}
+		};
+
+		for ( auto const& textures : frame.textures_per_pass ) {
+			add_texture_descriptors( textures );
+		}
+
+		// Textures which no pass samples, but which shaders may reach via their bindless index,
+		// see backend_frame_allocate_bindless_textures.
+		add_texture_descriptors( frame.bindless_textures );
+
+		for ( auto const& [ buffer_handle, index ] : bindless.buffers ) {
+
+			// Only persistent buffers are given bindless indices - see backend_get_bindless_buffer_index.
+			auto found_resource = frame.availableResources.find( buffer_handle );
+
+			if ( found_resource == frame.availableResources.end() ) {
+				// buffer is not used by this frame
+				continue;
+			}
+
+			buffer_infos.push_back( { found_resource->second.as.buffer, 0, VK_WHOLE_SIZE } );
+			buffer_indices.push_back( index );
+		}
+	}
+
+	// ----------| invariant: image_infos, and buffer_infos won't grow anymore - we may point into them.
+
+	writes.reserve( image_infos.size() + buffer_infos.size() );
+
+	for ( size_t i = 0; i != image_infos.size(); i++ ) {
+		writes.push_back( {
+		    .sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+		    .pNext            = nullptr, // optional
+		    .dstSet           = frame.bindlessDescriptorSet,
+		    .dstBinding       = 0,
+		    .dstArrayElement  = texture_indices[ i ],
+		    .descriptorCount  = 1,
+		    .descriptorType   = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+		    .pImageInfo       = &image_infos[ i ],
+		    .pBufferInfo      = nullptr,
+		    .pTexelBufferView = nullptr,
+		} );
+	}
+
+	for ( size_t i = 0; i != buffer_infos.size(); i++ ) {
+		writes.push_back( {
+		    .sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+		    .pNext            = nullptr, // optional
+		    .dstSet           = frame.bindlessDescriptorSet,
+		    .dstBinding       = 1,
+		    .dstArrayElement  = buffer_indices[ i ],
+		    .descriptorCount  = 1,
+		    .descriptorType   = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+		    .pImageInfo       = nullptr,
+		    .pBufferInfo      = &buffer_infos[ i ],
+		    .pTexelBufferView = nullptr,
+		} );
+	}
+
+	if ( !writes.empty() ) {
+		vkUpdateDescriptorSets( device, uint32_t( writes.size() ), writes.data(), 0, nullptr );
+	}
+
+	return uint32_t( writes.size() );
+}
+
 // ----------------------------------------------------------------------
 // Decode commandStream for each pass (may happen in parallel)
 // translate into vk specific commands.
@@ -5134,6 +6299,13 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 
 	bool needs_to_collect_root_pass_names = frame.must_create_queues_dot_graph; // only collect root pass names when these are needed, for example in order to create dot graphs or debug printouts
 
+	uint32_t num_argument_writes = 0; // number of descriptors written for argument descriptor sets
+	uint32_t num_bindless_writes = 0; // number of descriptors written for the bindless descriptor set
+
+	if ( self->bindless.enabled ) {
+		num_bindless_writes = backend_frame_update_bindless_descriptors( self, frame, device );
+	}
+
 	{
 
 		// -- Collect command buffers for each queue submission by testing against queue submission key.
@@ -5277,6 +6449,43 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 			}
 		}
 
+		// -- Prepare timestamp queries: two per pass. We may reset queries from the cpu,
+		// as this frame has been cleared, which means that the gpu is done with them.
+
+		frame.pass_timings.clear();
+
+		if ( self->gpu_timestamps.enabled && !frame.passes.empty() ) {
+
+			uint32_t const num_queries = uint32_t( frame.passes.size() * 2 );
+
+			if ( frame.timestamp_query_pool_size < num_queries ) {
+
+				if ( frame.timestamp_query_pool ) {
+					vkDestroyQueryPool( device, frame.timestamp_query_pool, nullptr );
+				}
+
+				frame.timestamp_query_pool_size = std::max<uint32_t>( { num_queries, frame.timestamp_query_pool_size * 2, 64 } );
+
+				VkQueryPoolCreateInfo info = {
+				    .sType              = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+				    .pNext              = nullptr, // optional
+				    .flags              = 0,       // optional
+				    .queryType          = VK_QUERY_TYPE_TIMESTAMP,
+				    .queryCount         = frame.timestamp_query_pool_size,
+				    .pipelineStatistics = 0, // optional
+				};
+
+				vkCreateQueryPool( device, &info, nullptr, &frame.timestamp_query_pool );
+			}
+
+			if ( self->gpu_timestamps.host_query_reset ) {
+				vkResetQueryPool( device, frame.timestamp_query_pool, 0, num_queries );
+			}
+
+			// Passes which don't write timestamps keep a queue_idx of ~0
+			frame.pass_timings.resize( frame.passes.size(), { .pass_name = {}, .queue_idx = uint32_t( ~0 ), .begin_ms = 0, .duration_ms = 0 } );
+		}
+
 		if ( LE_PRINT_DEBUG_MESSAGES ) {
 			logger.info( "Listing queue batches and their queue affinity:" );
 			int i = 0;
@@ -5320,6 +6529,20 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 				vkBeginCommandBuffer( cmd, &info );
 			}
 
+			bool const should_write_timestamps =
+			    !frame.pass_timings.empty() && self->gpu_timestamps.valid_bits_mask[ submission.queue_idx ] != 0;
+
+			if ( should_write_timestamps ) {
+				auto& timing = frame.pass_timings[ passIndex ];
+				strncpy( timing.pass_name, pass.debugName, sizeof( timing.pass_name ) - 1 );
+				timing.queue_idx = submission.queue_idx;
+				if ( !self->gpu_timestamps.host_query_reset ) {
+					// we could not reset queries from the cpu - reset this pass's queries before writing them.
+					vkCmdResetQueryPool( cmd, frame.timestamp_query_pool, passIndex * 2, 2 );
+				}
+				vkCmdWriteTimestamp2( cmd, VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT, frame.timestamp_query_pool, passIndex * 2 );
+			}
+
 			if ( SHOULD_INSERT_DEBUG_LABELS ) {
 				VkDebugUtilsLabelEXT labelInfo{
 				    .sType      = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT,
@@ -5399,6 +6622,10 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 
 						auto dstImage = frame_data_get_image_from_le_resource_id( &frame, static_cast<le_img_resource_handle>( op.resource ) );
 
+						// Depth/stencil images may be sampled, too - the barrier must name their aspects.
+						VkImageSubresourceRange subresourceRange = LE_IMAGE_SUBRESOURCE_RANGE_ALL_MIPLEVELS;
+						subresourceRange.aspectMask              = get_aspect_flags_from_format( le::Format( frame_data_get_image_format_from_resource_id( &frame, static_cast<le_img_resource_handle>( op.resource ) ) ) );
+
 						VkImageMemoryBarrier2 imageLayoutTransfer{
 						    .sType               = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
 						    .pNext               = nullptr,
@@ -5411,7 +6638,7 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 						    .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
 						    .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
 						    .image               = dstImage,
-						    .subresourceRange    = LE_IMAGE_SUBRESOURCE_RANGE_ALL_MIPLEVELS,
+						    .subresourceRange    = subresourceRange,
 						};
 
 						VkDependencyInfo dependencyInfo = {
@@ -5475,6 +6702,9 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 			ArgumentState                     argumentState{};  //
 			RtxState                          rtx_state{};      // used to keep track of shader binding tables bound with rtx pipelines.
 
+			argumentState.bindlessLayout = self->bindless.enabled ? self->bindless.layout : nullptr;
+			argumentState.bindlessSet    = frame.bindlessDescriptorSet;
+
 			static le_buf_resource_handle LE_RTX_SCRATCH_BUFFER_HANDLE = LE_BUF_RESOURCE( "le_rtx_scratch_buffer_handle" ); // opaque handle for rtx scratch buffer
 
 			if ( pass.encoder ) {
@@ -5825,7 +7055,7 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 						auto* le_cmd = static_cast<le::CommandTraceRays*>( dataIt );
 
 						// -- update descriptorsets via template if tainted
-						bool argumentsOk = updateArguments( device, descriptorPool, argumentState, previousSetState, descriptorSets );
+						bool argumentsOk = updateArguments( device, descriptorPool, argumentState, previousSetState, descriptorSets, num_argument_writes );
 
 						if ( false == argumentsOk ) {
 							break;
@@ -5877,7 +7107,7 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 						auto* le_cmd = static_cast<le::CommandDispatch*>( dataIt );
 
 						// -- update descriptorsets via template if tainted
-						bool argumentsOk = updateArguments( device, descriptorPool, argumentState, previousSetState, descriptorSets );
+						bool argumentsOk = updateArguments( device, descriptorPool, argumentState, previousSetState, descriptorSets, num_argument_writes );
 
 						if ( false == argumentsOk ) {
 							break;
@@ -5901,12 +7131,20 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 
 					} break;
 					case le::CommandType::eBufferMemoryBarrier: {
-						auto*                  le_cmd = static_cast<le::CommandBufferMemoryBarrier*>( dataIt );
+						auto* le_cmd = static_cast<le::CommandBufferMemoryBarrier*>( dataIt );
+
+						// Indirect commands, and counts are typically written by shaders: we must make
+						// these writes available before the GPU may read draw parameters from the buffer.
+						VkAccessFlags2 const srcAccessMask =
+						    ( static_cast<VkAccessFlags2>( le_cmd->info.dstAccessMask ) & VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT )
+						        ? VK_ACCESS_2_MEMORY_WRITE_BIT
+						        : 0;
+
 						VkBufferMemoryBarrier2 bufferMemoryBarrier{
 						    .sType               = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2,
 						    .pNext               = nullptr,
 						    .srcStageMask        = static_cast<VkPipelineStageFlags2>( le_cmd->info.srcStageMask ), // happens-before
-						    .srcAccessMask       = 0,                                                               // FIXME: no memory is made available from src stage ?!
+						    .srcAccessMask       = srcAccessMask,                                                   // FIXME: no memory is made available from src stage, unless dst reads indirect commands ?!
 						    .dstStageMask        = static_cast<VkPipelineStageFlags2>( le_cmd->info.dstStageMask ), // before continuing with dst stage
 						    .dstAccessMask       = static_cast<VkAccessFlagBits2>( le_cmd->info.dstAccessMask ),    // and making memory visible to dst stage
 						    .srcQueueFamilyIndex = 0,
@@ -5935,7 +7173,7 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 						auto* le_cmd = static_cast<le::CommandDraw*>( dataIt );
 
 						// -- update descriptorsets via template if tainted
-						bool argumentsOk = updateArguments( device, descriptorPool, argumentState, previousSetState, descriptorSets );
+						bool argumentsOk = updateArguments( device, descriptorPool, argumentState, previousSetState, descriptorSets, num_argument_writes );
 
 						if ( false == argumentsOk ) {
 							break;
@@ -5963,7 +7201,7 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 						auto* le_cmd = static_cast<le::CommandDrawIndexed*>( dataIt );
 
 						// -- update descriptorsets via template if tainted
-						bool argumentsOk = updateArguments( device, descriptorPool, argumentState, previousSetState, descriptorSets );
+						bool argumentsOk = updateArguments( device, descriptorPool, argumentState, previousSetState, descriptorSets, num_argument_writes );
 
 						if ( false == argumentsOk ) {
 							break;
@@ -5993,11 +7231,147 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 						    le_cmd->info.firstInstance );
 					} break;
 
+					case le::CommandType::eDrawIndirect: {
+						auto* le_cmd = static_cast<le::CommandDrawIndirect*>( dataIt );
+
+						// -- update descriptorsets via template if tainted
+						bool argumentsOk = updateArguments( device, descriptorPool, argumentState, previousSetState, descriptorSets, num_argument_writes );
+
+						if ( false == argumentsOk ) {
+							break;
+						}
+
+						// --------| invariant: arguments were updated successfully
+
+						if ( argumentState.setCount > 0 ) {
+
+							vkCmdBindDescriptorSets(
+							    cmd,
+							    VK_PIPELINE_BIND_POINT_GRAPHICS,
+							    currentPipelineLayout,
+							    0,
+							    argumentState.setCount,
+							    descriptorSets,
+							    argumentState.dynamicOffsetCount,
+							    argumentState.dynamicOffsets.data() );
+						}
+
+						vkCmdDrawIndirect(
+						    cmd,
+						    frame_data_get_buffer_from_le_resource_id( &frame, le_cmd->info.buffer ),
+						    le_cmd->info.offset,
+						    le_cmd->info.drawCount,
+						    le_cmd->info.stride );
+					} break;
+
+					case le::CommandType::eDrawIndexedIndirect: {
+						auto* le_cmd = static_cast<le::CommandDrawIndexedIndirect*>( dataIt );
+
+						// -- update descriptorsets via template if tainted
+						bool argumentsOk = updateArguments( device, descriptorPool, argumentState, previousSetState, descriptorSets, num_argument_writes );
+
+						if ( false == argumentsOk ) {
+							break;
+						}
+
+						// --------| invariant: arguments were updated successfully
+
+						if ( argumentState.setCount > 0 ) {
+
+							vkCmdBindDescriptorSets(
+							    cmd,
+							    VK_PIPELINE_BIND_POINT_GRAPHICS,
+							    currentPipelineLayout,
+							    0,
+							    argumentState.setCount,
+							    descriptorSets,
+							    argumentState.dynamicOffsetCount,
+							    argumentState.dynamicOffsets.data() );
+						}
+
+						vkCmdDrawIndexedIndirect(
+						    cmd,
+						    frame_data_get_buffer_from_le_resource_id( &frame, le_cmd->info.buffer ),
+						    le_cmd->info.offset,
+						    le_cmd->info.drawCount,
+						    le_cmd->info.stride );
+					} break;
+
+					case le::CommandType::eDrawIndirectCount: {
+						auto* le_cmd = static_cast<le::CommandDrawIndirectCount*>( dataIt );
+
+						// -- update descriptorsets via template if tainted
+						bool argumentsOk = updateArguments( device, descriptorPool, argumentState, previousSetState, descriptorSets, num_argument_writes );
+
+						if ( false == argumentsOk ) {
+							break;
+						}
+
+						// --------| invariant: arguments were updated successfully
+
+						if ( argumentState.setCount > 0 ) {
+
+							vkCmdBindDescriptorSets(
+							    cmd,
+							    VK_PIPELINE_BIND_POINT_GRAPHICS,
+							    currentPipelineLayout,
+							    0,
+							    argumentState.setCount,
+							    descriptorSets,
+							    argumentState.dynamicOffsetCount,
+							    argumentState.dynamicOffsets.data() );
+						}
+
+						vkCmdDrawIndirectCount(
+						    cmd,
+						    frame_data_get_buffer_from_le_resource_id( &frame, le_cmd->info.buffer ),
+						    le_cmd->info.offset,
+						    frame_data_get_buffer_from_le_resource_id( &frame, le_cmd->info.countBuffer ),
+						    le_cmd->info.countBufferOffset,
+						    le_cmd->info.maxDrawCount,
+						    le_cmd->info.stride );
+					} break;
+
+					case le::CommandType::eDrawIndexedIndirectCount: {
+						auto* le_cmd = static_cast<le::CommandDrawIndexedIndirectCount*>( dataIt );
+
+						// -- update descriptorsets via template if tainted
+						bool argumentsOk = updateArguments( device, descriptorPool, argumentState, previousSetState, descriptorSets, num_argument_writes );
+
+						if ( false == argumentsOk ) {
+							break;
+						}
+
+						// --------| invariant: arguments were updated successfully
+
+						if ( argumentState.setCount > 0 ) {
+
+							vkCmdBindDescriptorSets(
+							    cmd,
+							    VK_PIPELINE_BIND_POINT_GRAPHICS,
+							    currentPipelineLayout,
+							    0,
+							    argumentState.setCount,
+							    descriptorSets,
+							    argumentState.dynamicOffsetCount,
+							    argumentState.dynamicOffsets.data() );
+						}
+
+						vkCmdDrawIndexedIndirectCount(
+						    cmd,
+						    frame_data_get_buffer_from_le_resource_id( &frame, le_cmd->info.buffer ),
+						    le_cmd->info.offset,
+						    frame_data_get_buffer_from_le_resource_id( &frame, le_cmd->info.countBuffer ),
+						    le_cmd->info.countBufferOffset,
+						    le_cmd->info.maxDrawCount,
+						    le_cmd->info.stride );
+					} break;
+
 					case le::CommandType::eDrawMeshTasks: {
 						auto* le_cmd = static_cast<le::CommandDrawMeshTasks*>( dataIt );
 
 						// -- update descriptorsets via template if tainted
-						bool argumentsOk = updateArguments( device, descriptorPool, argumentState, previousSetState, descriptorSets );
+						bool argumentsOk = updateArguments( device, descriptorPool, argumentState, previousSetState, descriptorSets, num_argument_writes );
 
 						if ( false == argumentsOk ) {
 							break;
@@ -6180,7 +7554,7 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 
 							// ----------| invariant: texture has been found
 
-							bindingData->imageInfo.imageLayout = le::ImageLayout::eShaderReadOnlyOptimal;
+							bindingData->imageInfo.imageLayout = le::ImageLayout( foundTex->second.imageLayout );
 							bindingData->imageInfo.sampler     = foundTex->second.sampler;
 							bindingData->imageInfo.imageView   = foundTex->second.imageView;
 							bindingData->type                  = le::DescriptorType::eCombinedImageSampler;
@@ -6408,7 +7782,7 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 
 							VkImageSubresourceLayers imageSubresourceLayers{
 							    .aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT,
-							    .mipLevel       = 0,
+							    .mipLevel       = le_cmd->info.dst_miplevel,
 							    .baseArrayLayer = le_cmd->info.dst_array_layer,
 							    .layerCount     = 1,
 							};
@@ -6948,9 +8322,16 @@ static void backend_process_frame( le_backend_o* self, size_t frameIndex ) {
 				vkCmdEndDebugUtilsLabelEXT( cmd );
 			}
 
+			if ( should_write_timestamps ) {
+				vkCmdWriteTimestamp2( cmd, VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT, frame.timestamp_query_pool, passIndex * 2 + 1 );
+			}
+
 			vkEndCommandBuffer( cmd );
 		}
 	}
+
+	self->num_argument_descriptor_writes = num_argument_writes;
+	self->num_bindless_descriptor_writes = num_bindless_writes;
 }
 
 // ----------------------------------------------------------------------
@@ -7886,7 +9267,10 @@ static bool backend_dispatch_frame( le_backend_o* self, size_t frameIndex ) {
 
 		};
 
-		backend_queue_submit( self->queues[ self->queue_default_graphics_idx ], 1, &submitInfo, nullptr, frame.must_create_queues_dot_graph, "wait_present_complete" );
+		if ( !wait_present_complete_semaphore_submit_infos.empty() ) {
+			// Only submit if there is anything to wait for - this submission does not contain any commands.
+			backend_queue_submit( self->queues[ self->queue_default_graphics_idx ], 1, &submitInfo, nullptr, frame.must_create_queues_dot_graph, "wait_present_complete" );
+		}
 	}
 
 	for ( auto const& current_submission : frame.queue_submission_data ) {
@@ -7950,10 +9334,21 @@ static bool backend_dispatch_frame( le_backend_o* self, size_t frameIndex ) {
 		///
 		/// If submitted on the same queue, Queue submission order means that batch 1 needs to complete before batch 2
 		/// -- see VkSpec 7.2 (Implicit Synchronization Guarantees)
+		///
+		/// This is also why we don't wait for the timeline semaphore of the default graphics queue itself:
+		/// the signal operation for this batch already includes all earlier submissions to this queue.
+		///
+		/// Once this batch completes, it signals the default graphics queue's timeline semaphore with
+		/// the frame's timeline value: that's what the frame fence waits for before the frame is recycled.
+
+		BackendQueueInfo* graphics_queue_info = self->queues[ self->queue_default_graphics_idx ];
 
 		std::vector<VkSemaphoreSubmitInfo> timeline_wait_semaphores;
 
 		for ( uint32_t i = 0; i != self->queues.size(); i++ ) {
+			if ( i == self->queue_default_graphics_idx ) {
+				continue;
+			}
 			timeline_wait_semaphores.push_back( {
 			    .sType       = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
 			    .pNext       = nullptr,
@@ -7964,6 +9359,18 @@ static bool backend_dispatch_frame( le_backend_o* self, size_t frameIndex ) {
 			} );
 		}
 
+		frame.frameTimelineValue = graphics_queue_info->semaphore_get_next_signal_value();
+
+		render_complete_semaphore_submit_infos.push_back(
+		    {
+		        .sType       = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO,
+		        .pNext       = nullptr,
+		        .semaphore   = graphics_queue_info->semaphore,
+		        .value       = frame.frameTimelineValue,
+		        .stageMask   = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, // signal semaphore once all commands have been processed
+		        .deviceIndex = 0,
+		    } );
+
 		// On default draw queue, wait for all timeline semaphores before signalling render complete.
 
 		VkSubmitInfo2 submitInfo{
@@ -7975,11 +9382,11 @@ static bool backend_dispatch_frame( le_backend_o* self, size_t frameIndex ) {
 		    .commandBufferInfoCount   = 0,                                           // No commands submitted, this submission is purely for synchronisation
 		    .pCommandBufferInfos      = nullptr,
 		    .signalSemaphoreInfoCount = uint32_t( render_complete_semaphore_submit_infos.size() ),
-		    .pSignalSemaphoreInfos    = render_complete_semaphore_submit_infos.data(), // signal render complete once this batch has finished processing
+		    .pSignalSemaphoreInfos    = render_complete_semaphore_submit_infos.data(), // signal render complete, and frame timeline value once this batch has finished processing
 
 		};
 
-		backend_queue_submit( self->queues[ self->queue_default_graphics_idx ], 1, &submitInfo, frame.frameFence, frame.must_create_queues_dot_graph, "graphics_queue_finalize" );
+		backend_queue_submit( graphics_queue_info, 1, &submitInfo, nullptr, frame.must_create_queues_dot_graph, "graphics_queue_finalize" );
 	}
 
 	bool overall_result = true;
@@ -8126,6 +9533,12 @@ LE_MODULE_REGISTER_IMPL( le_backend_vk, api_ ) {
 	vk_backend_i.get_swapchain_resource_default = backend_get_swapchain_resource_default;
 	vk_backend_i.get_swapchains_infos           = backend_get_swapchains_infos;
 	vk_backend_i.get_swapchains                 = backend_get_swapchains;
+	vk_backend_i.get_pass_timings               = backend_get_pass_timings;
+	vk_backend_i.get_bindless_texture_index     = backend_get_bindless_texture_index;
+	vk_backend_i.get_bindless_buffer_index      = backend_get_bindless_buffer_index;
+	vk_backend_i.release_bindless_texture       = backend_release_bindless_texture;
+	vk_backend_i.release_bindless_buffer        = backend_release_bindless_buffer;
+	vk_backend_i.get_descriptor_write_counts    = backend_get_descriptor_write_counts;
 	vk_backend_i.acquire_swapchain_resources    = backend_acquire_swapchain_resources;
 
 	vk_backend_i.create_rtx_blas_info = backend_create_rtx_blas_info;
@@ -8149,6 +9562,7 @@ LE_MODULE_REGISTER_IMPL( le_backend_vk, api_ ) {
 	private_backend_i.frame_add_on_clear_callbacks              = backend_frame_add_on_clear_callbacks;
 	private_backend_i.frame_data_get_image_from_le_resource_id  = frame_data_get_image_from_le_resource_id;
 	private_backend_i.get_sampler_ycbcr_conversion_info         = backend_get_sampler_ycbcr_conversion_info;
+	private_backend_i.get_bindless_descriptor_set_layout        = backend_get_bindless_descriptor_set_layout;
 
 	auto& staging_allocator_i   = api_i->le_staging_allocator_i;
 	staging_allocator_i.create  = staging_allocator_create;
@@ -8181,6 +9595,11 @@ LE_MODULE_REGISTER_IMPL( le_backend_vk, api_ ) {
 	backend_settings_i.add_requested_queue_capabilities   = le_backend_vk_settings_add_requested_queue_capabilities;
 	backend_settings_i.set_requested_queue_capabilities   = le_backend_vk_settings_set_requested_queue_capabilities;
 	backend_settings_i.set_data_frames_count              = le_backend_vk_settings_set_data_frames_count;
+	backend_settings_i.set_gpu_timestamps_enabled         = le_backend_vk_settings_set_gpu_timestamps_enabled;
+	backend_settings_i.set_bindless_enabled               = le_backend_vk_settings_set_bindless_enabled;
+	backend_settings_i.set_indirect_draws_enabled         = le_backend_vk_settings_set_indirect_draws_enabled;
+	backend_settings_i.get_indirect_draws_enabled         = le_backend_vk_settings_get_indirect_draws_enabled;
+	backend_settings_i.disable_unsupported_features       = le_backend_vk_settings_disable_unsupported_features;
 
 	void** p_settings_singleton_addr = le_core_produce_dictionary_entry( hash_64_fnv1a_const( "backend_api_settings_singleton" ) );
 
@@ -25,6 +25,9 @@ struct le_pipeline_manager_o;
 constexpr uint8_t LE_MAX_BOUND_DESCRIPTOR_SETS = 8;
 constexpr uint8_t LE_MAX_COLOR_ATTACHMENTS     = 16; // maximum number of color attachments to a renderpass
 
+constexpr uint32_t LE_BINDLESS_DESCRIPTOR_SET = 3;              // descriptor set at which shaders find bindless resources, see `settings_i.set_bindless_enabled`
+constexpr uint32_t LE_BINDLESS_INDEX_INVALID  = uint32_t( ~0 ); // bindless index for resources which could not be given a bindless index
+
 struct graphics_pipeline_state_o; // for le_pipeline_builder
 struct compute_pipeline_state_o;  // for le_pipeline_builder
 struct rtx_pipeline_state_o;      // for le_pipeline_builder
@@ -39,6 +42,7 @@ LE_OPAQUE_HANDLE( le_img_resource_handle );
 LE_OPAQUE_HANDLE( le_buf_resource_handle );
 LE_OPAQUE_HANDLE( le_tlas_resource_handle );
 LE_OPAQUE_HANDLE( le_blas_resource_handle );
+LE_OPAQUE_HANDLE( le_texture_handle );
 
 LE_OPAQUE_HANDLE( le_cpso_handle );
 LE_OPAQUE_HANDLE( le_cpso_handle );
@@ -100,6 +104,14 @@ struct le_pipeline_layout_info {
 	uint32_t push_constants_enabled  = 0;  // whether push constant buffers are enabled or not: They might be disabled unintentionally if not used in shader and optimised away
 };
 
+// GPU time taken by a rendergraph pass, see `get_pass_timings`
+struct le_pass_timing_t {
+	char     pass_name[ 64 ]; // debug name of pass, truncated if necessary
+	uint32_t queue_idx;       // index of backend queue which executed this pass
+	double   begin_ms;        // start of pass, relative to start of the earliest pass in the same frame
+	double   duration_ms;     // time between start, and end of pass on the gpu
+};
+
 struct le_pipeline_and_layout_info_t {
 	struct VkPipeline_T*    pipeline;
 	le_pipeline_layout_info layout_info;
@@ -120,6 +132,26 @@ struct le_backend_vk_api {
 		/// prefer add over set - as set will erase any previously added queues
 		bool ( *set_requested_queue_capabilities )( VkQueueFlags* queues, uint32_t num_queues );
 		bool ( *add_requested_queue_capabilities )( VkQueueFlags* queues, uint32_t num_queues );
+
+		/// measure gpu time per pass via timestamp queries - see backend `get_pass_timings`.
+		/// must be set before the backend is initialised.
+		bool ( *set_gpu_timestamps_enabled )( bool enabled );
+
+		/// keep all textures, and storage buffers which were given a bindless index in one descriptor
+		/// set, which shaders can index into - see backend `get_bindless_texture_index`.
+		/// must be set before the backend is initialised. if the device does not support descriptor
+		/// indexing, bindless mode stays disabled, and bindless indices are LE_BINDLESS_INDEX_INVALID.
+		bool ( *set_bindless_enabled )( bool enabled );
+
+		/// enable draw commands which read draw parameters, and draw counts from buffers - see encoder
+		/// `draw_indirect_count`. must be set before the backend is initialised. if the device does not
+		/// support indirect draws, these stay disabled - query `get_indirect_draws_enabled` after setup.
+		bool ( *set_indirect_draws_enabled )( bool enabled );
+		bool ( *get_indirect_draws_enabled )();
+
+		/// called by the device, once it has picked a physical device, but before it creates a logical
+		/// device: disables any optional features requested via settings which the device does not support.
+		void ( *disable_unsupported_features )( VkPhysicalDevice_T* physical_device );
 	};
 
 	// clang-format off
@@ -166,6 +198,30 @@ struct le_backend_vk_api {
 		bool                   ( *get_swapchains_infos        ) ( le_backend_o* self, uint32_t frame_index, uint32_t *count, uint32_t* p_width, uint32_t * p_height, le_img_resource_handle * p_handlle );
 
 
+		// Copies gpu timings for all passes of the most recent frame which the gpu has completed into p_timings,
+		// and sets p_frame_number to the number of this frame. If *num_timings is less than the number of
+		// timings, sets *num_timings to the number of timings, and returns false. Timings are only collected
+		// if gpu timestamps were enabled via `settings_i.set_gpu_timestamps_enabled`.
+		bool                   ( *get_pass_timings           ) ( le_backend_o* self, le_pass_timing_t* p_timings, size_t* num_timings, uint64_t* p_frame_number );
+
+		// Bindless mode: returns a stable index into the array of bindless textures (or buffers) at set
+		// LE_BINDLESS_DESCRIPTOR_SET, binding 0 (or 1). Indices stay valid until released; once released,
+		// an index is recycled after all frames which might have used it have been cleared.
+		// Returns LE_BINDLESS_INDEX_INVALID if bindless mode is not enabled, or if all indices are taken.
+		// Only persistent buffers may be bindless - transient, and staging buffers are sub-allocated
+		// anew with every frame, and return LE_BINDLESS_INDEX_INVALID.
+		//
+		// Note that a frame only writes descriptors for textures which one of its passes samples, and
+		// for buffers which one of its passes uses - passes must still declare these resources.
+		uint32_t               ( *get_bindless_texture_index ) ( le_backend_o* self, le_texture_handle texture );
+		uint32_t               ( *get_bindless_buffer_index  ) ( le_backend_o* self, le_buf_resource_handle buffer );
+		void                   ( *release_bindless_texture   ) ( le_backend_o* self, le_texture_handle texture );
+		void                   ( *release_bindless_buffer    ) ( le_backend_o* self, le_buf_resource_handle buffer );
+
+		// Number of descriptors written for the most recently processed frame - for argument
+		// descriptor sets, and for the bindless descriptor set.
+		void                   ( *get_descriptor_write_counts ) ( le_backend_o* self, uint32_t* num_argument_writes, uint32_t* num_bindless_writes );
+
 		le_rtx_blas_info_handle( *create_rtx_blas_info )(le_backend_o* self, le_rtx_geometry_t const * geometries, uint32_t geometries_count,le::BuildAccelerationStructureFlagsKHR const * flags);
 		le_rtx_tlas_info_handle( *create_rtx_tlas_info )(le_backend_o* self,  uint32_t instances_count, le::BuildAccelerationStructureFlagsKHR const * flags);
 	};
@@ -216,6 +272,7 @@ struct le_backend_vk_api {
 		VkImage_T* (*frame_data_get_image_from_le_resource_id)( const BackendFrameData* frame, le_img_resource_handle_t* img );
 
 		VkSamplerYcbcrConversionInfo* (*get_sampler_ycbcr_conversion_info)(le_backend_o* self);
+		struct VkDescriptorSetLayout_T* (*get_bindless_descriptor_set_layout)(le_backend_o* self); // nullptr if bindless mode is not enabled
 	};
 
 	struct instance_interface_t {
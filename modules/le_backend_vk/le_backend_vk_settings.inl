@@ -33,9 +33,12 @@ struct le_backend_vk_settings_o {
 	    //	    VK_QUEUE_COMPUTE_BIT,
 	}; // each entry stands for one queue and its capabilities
 
-	uint32_t         data_frames_count = 2; // mumber of backend data frames - must be at minimum 2
-	uint32_t         concurrency_count = 1; // number of potential worker threads
-	std::atomic_bool readonly          = false;
+	uint32_t         data_frames_count      = 2;     // mumber of backend data frames - must be at minimum 2
+	uint32_t         concurrency_count      = 1;     // number of potential worker threads
+	bool             gpu_timestamps_enabled = false; // whether to write timestamp queries at start and end of each pass
+	bool             bindless_enabled       = false; // whether to keep a descriptor set of bindless textures, and buffers
+	bool             indirect_draws_enabled = false; // whether draw parameters, and draw counts may be read from buffers
+	std::atomic_bool readonly               = false;
 };
 
 static bool le_backend_vk_settings_set_requested_queue_capabilities( VkQueueFlags* queues, uint32_t num_queues ) {
@@ -225,6 +228,7 @@ static le_backend_vk_settings_o* le_backend_vk_settings_create() {
 	// Apply some customisations
 
 	self->physical_device_features.vk_13.synchronization2 = VK_TRUE; // use synchronisation2 by default
+	self->physical_device_features.vk_12.timelineSemaphore = VK_TRUE; // queues, and frames are synchronised via timeline semaphores
 
 #ifdef LE_FEATURE_RTX
 	self->physical_device_features.vk_12.bufferDeviceAddress                    = true; // needed for rtx
@@ -291,6 +295,130 @@ static bool le_backend_vk_settings_set_data_frames_count( uint32_t data_frames_c
 	return true;
 }
 
+// ----------------------------------------------------------------------
+static bool le_backend_vk_settings_set_gpu_timestamps_enabled( bool enabled ) {
+	le_backend_vk_settings_o* self = le_backend_vk::api->backend_settings_singleton;
+	if ( self->readonly ) {
+		return false;
+	}
+	// ----------| invariant: settings is not readonly
+	self->gpu_timestamps_enabled = enabled;
+
+	if ( enabled ) {
+		// we reset timestamp queries from the cpu, once a frame has been cleared
+		self->physical_device_features.vk_12.hostQueryReset = VK_TRUE;
+	}
+	return true;
+}
+
+// ----------------------------------------------------------------------
+static void le_backend_vk_settings_request_bindless_features( le_backend_vk_settings_o* self, VkBool32 enabled ) {
+	// shaders index into large arrays of textures, and buffers, of which only some elements
+	// are written. update-after-bind sets may hold many more descriptors than regular sets.
+	auto& vk_12 = self->physical_device_features.vk_12;
+
+	vk_12.descriptorIndexing                            = enabled;
+	vk_12.runtimeDescriptorArray                        = enabled;
+	vk_12.descriptorBindingPartiallyBound               = enabled;
+	vk_12.descriptorBindingSampledImageUpdateAfterBind  = enabled;
+	vk_12.descriptorBindingStorageBufferUpdateAfterBind = enabled;
+	vk_12.shaderSampledImageArrayNonUniformIndexing     = enabled;
+	vk_12.shaderStorageBufferArrayNonUniformIndexing    = enabled;
+}
+
+// ----------------------------------------------------------------------
+static bool le_backend_vk_settings_set_bindless_enabled( bool enabled ) {
+	le_backend_vk_settings_o* self = le_backend_vk::api->backend_settings_singleton;
+	if ( self->readonly ) {
+		return false;
+	}
+	// ----------| invariant: settings is not readonly
+	self->bindless_enabled = enabled;
+
+	if ( enabled ) {
+		le_backend_vk_settings_request_bindless_features( self, VK_TRUE );
+	}
+	return true;
+}
+
+// ----------------------------------------------------------------------
+static void le_backend_vk_settings_request_indirect_draw_features( le_backend_vk_settings_o* self, VkBool32 enabled ) {
+	// draw parameters, and draw counts may be written on the GPU.
+	self->physical_device_features.features.features.multiDrawIndirect         = enabled;
+	self->physical_device_features.features.features.drawIndirectFirstInstance = enabled;
+	self->physical_device_features.vk_12.drawIndirectCount                     = enabled;
+}
+
+// ----------------------------------------------------------------------
+static bool le_backend_vk_settings_set_indirect_draws_enabled( bool enabled ) {
+	le_backend_vk_settings_o* self = le_backend_vk::api->backend_settings_singleton;
+	if ( self->readonly ) {
+		return false;
+	}
+	// ----------| invariant: settings is not readonly
+	self->indirect_draws_enabled = enabled;
+
+	if ( enabled ) {
+		le_backend_vk_settings_request_indirect_draw_features( self, VK_TRUE );
+	}
+	return true;
+}
+
+// ----------------------------------------------------------------------
+static bool le_backend_vk_settings_get_indirect_draws_enabled() {
+	le_backend_vk_settings_o const* self = le_backend_vk::api->backend_settings_singleton;
+	return self->indirect_draws_enabled;
+}
+
+// ----------------------------------------------------------------------
+// Optional features which the physical device does not support must not be requested,
+// or else device creation fails - we disable these, and fall back to regular code paths.
+static void le_backend_vk_settings_disable_unsupported_features( VkPhysicalDevice physical_device ) {
+	le_backend_vk_settings_o* self = le_backend_vk::api->backend_settings_singleton;
+
+	static auto logger = LeLog( "le_backend_vk_settings" );
+
+	VkPhysicalDeviceVulkan12Features supported_vk_12 = {
+	    .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
+	    .pNext = nullptr, // optional
+	};
+	VkPhysicalDeviceFeatures2 supported = {
+	    .sType    = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+	    .pNext    = &supported_vk_12, // optional
+	    .features = {},
+	};
+
+	vkGetPhysicalDeviceFeatures2( physical_device, &supported );
+
+	if ( self->indirect_draws_enabled &&
+	     !( supported.features.multiDrawIndirect &&
+	        supported.features.drawIndirectFirstInstance &&
+	        supported_vk_12.drawIndirectCount ) ) {
+		logger.warn( "Indirect draws were requested, but are not supported by the physical device - disabling indirect draws." );
+		self->indirect_draws_enabled = false;
+		le_backend_vk_settings_request_indirect_draw_features( self, VK_FALSE );
+	}
+
+	if ( self->gpu_timestamps_enabled && !supported_vk_12.hostQueryReset ) {
+		// Not fatal: the backend then resets timestamp queries via command buffers instead.
+		logger.warn( "Host query reset is not supported by the physical device - resetting timestamp queries on the GPU instead." );
+		self->physical_device_features.vk_12.hostQueryReset = VK_FALSE;
+	}
+
+	if ( self->bindless_enabled &&
+	     !( supported_vk_12.descriptorIndexing &&
+	        supported_vk_12.runtimeDescriptorArray &&
+	        supported_vk_12.descriptorBindingPartiallyBound &&
+	        supported_vk_12.descriptorBindingSampledImageUpdateAfterBind &&
+	        supported_vk_12.descriptorBindingStorageBufferUpdateAfterBind &&
+	        supported_vk_12.shaderSampledImageArrayNonUniformIndexing &&
+	        supported_vk_12.shaderStorageBufferArrayNonUniformIndexing ) ) {
+		logger.warn( "Bindless mode was requested, but descriptor indexing is not supported by the physical device - disabling bindless mode." );
+		self->bindless_enabled = false;
+		le_backend_vk_settings_request_bindless_features( self, VK_FALSE );
+	}
+}
+
 // ----------------------------------------------------------------------
 
 static VkPhysicalDeviceFeatures2* le_backend_vk_get_physical_device_features_chain() {
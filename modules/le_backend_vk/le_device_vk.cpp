@@ -356,6 +356,9 @@ static le_device_o* device_create( le_backend_vk_instance_o* backend_instance, c
 		}
 	}
 
+	// Make sure that we don't request optional features which the physical device doesn't support.
+	le_backend_vk::settings_i.disable_unsupported_features( self->vkPhysicalDevice );
+
 	auto features = le_backend_vk::settings_i.get_physical_device_features_chain();
 
 	VkDeviceCreateInfo deviceCreateInfo = {
@@ -2006,6 +2006,27 @@ static uint64_t le_pipeline_cache_produce_descriptor_set_layout( le_pipeline_man
 	return set_layout_hash;
 }
 
+// ----------------------------------------------------------------------
+// In bindless mode, the descriptor set at LE_BINDLESS_DESCRIPTOR_SET is owned by the backend:
+// we don't derive its layout from shader bindings, but borrow the backend's bindless set layout.
+// The bindless set layout has no bindings for which the encoder may set arguments.
+static uint64_t le_pipeline_cache_produce_bindless_descriptor_set_layout( le_pipeline_manager_o* self, VkDescriptorSetLayout bindless_layout ) {
+
+	static constexpr uint64_t BINDLESS_SET_LAYOUT_HASH = hash_64_fnv1a_const( "le_bindless_descriptor_set_layout" );
+
+	if ( nullptr == self->descriptorSetLayouts.try_find( BINDLESS_SET_LAYOUT_HASH ) ) {
+
+		le_descriptor_set_layout_t le_layout_info{};
+		le_layout_info.vk_descriptor_set_layout      = bindless_layout;
+		le_layout_info.vk_descriptor_update_template = nullptr;
+		le_layout_info.is_borrowed                   = true;
+
+		self->descriptorSetLayouts.try_insert( BINDLESS_SET_LAYOUT_HASH, &le_layout_info );
+	}
+
+	return BINDLESS_SET_LAYOUT_HASH;
+}
+
 // ----------------------------------------------------------------------
 // Calculates pipeline layout info by first consolidating all bindings
 // over all referenced shader modules, and then ordering these by descriptor sets.
@@ -2080,7 +2101,14 @@ static le_pipeline_layout_info le_pipeline_manager_produce_pipeline_layout_info(
 			}
 		}
 
+		VkDescriptorSetLayout bindless_layout = le_backend_vk::private_backend_vk_i.get_bindless_descriptor_set_layout( self->backend );
+
 		for ( size_t i = 0; i != sets.size(); ++i ) {
+			if ( i == LE_BINDLESS_DESCRIPTOR_SET && bindless_layout ) {
+				vkLayouts[ i ]            = bindless_layout;
+				info.set_layout_keys[ i ] = le_pipeline_cache_produce_bindless_descriptor_set_layout( self, bindless_layout );
+				continue;
+			}
 			info.set_layout_keys[ i ] = le_pipeline_cache_produce_descriptor_set_layout( self, sets[ i ], vkLayouts + i );
 		}
 	}
@@ -2618,6 +2646,9 @@ static void le_pipeline_manager_destroy( le_pipeline_manager_o* self ) {
 	self->descriptorSetLayouts.iterator(
 	    []( le_descriptor_set_layout_t* e, void* user_data ) {
 		    VkDevice device = *static_cast<VkDevice*>( user_data );
+		    if ( e->is_borrowed ) {
+			    return;
+		    }
 		    for ( auto& s : e->immutable_samplers ) {
 			    vkDestroySampler( device, *s, nullptr );
 			    delete s;
@@ -1,2 +1,9 @@
+// stb_truetype must see the same stbrp_rect as le_font.cpp, which passes rects into
+// stbtt_PackFontRangesGatherRects, and friends - we therefore include stb_rect_pack
+// here, too. Its functions are only used by stb_truetype, and therefore static.
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "stb_rect_pack.h"
+
 #define STB_TRUETYPE_IMPLEMENTATION
 #include "stb_truetype.h"
@@ -4,16 +4,23 @@
 #include "3rdparty/stb_rect_pack.h"
 
 #include <vector>
-#include <array>
+#include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+#include <limits>
 #include <fstream>
 #include <filesystem> // for parsing source filepaths
 #include <iostream>
+#include <mutex>
 #include <assert.h>
 
 #include <glm/vec2.hpp>
 #include <glm/vec4.hpp>
 
 #include "le_path.h" // for get_path_for_glyph
+#include "le_jobs.h"
 
 struct UnicodeRange {
 	uint32_t                      start_range;
@@ -21,17 +28,69 @@ struct UnicodeRange {
 	std::vector<stbtt_packedchar> data;
 };
 
+using atlas_region_t = le_font_api::atlas_region_t;
+
+// A horizontal strip of the dynamic atlas, holding glyphs of similar height.
+// Glyphs are evicted per-shelf, so that we never need to fill holes.
+struct AtlasShelf {
+	uint32_t              y;               // top edge of shelf in atlas pixels
+	uint32_t              height;          // height of shelf in atlas pixels
+	uint32_t              x_cursor;        // left edge of next glyph to be placed into this shelf
+	uint64_t              last_used_frame; // frame in which any glyph from this shelf was last drawn
+	std::vector<uint32_t> codepoints;      // codepoints for glyphs placed into this shelf
+	bool                  is_pinned;       // pinned shelves are never evicted
+};
+
+struct DynamicGlyph {
+	stbtt_packedchar data;
+	uint32_t         shelf_index;
+	uint64_t         added_frame; // glyph may only be drawn once its pixels were uploaded, i.e. from the next frame on
+};
+
+struct DynamicAtlas {
+	uint32_t                                   shelves_y_end = 0; // bottom edge of lowest shelf
+	uint64_t                                   current_frame = 1;
+	std::vector<AtlasShelf>                    shelves;
+	std::unordered_map<uint32_t, DynamicGlyph> glyphs;                   // codepoint -> glyph
+	std::unordered_set<uint32_t>               failed_codepoints;        // glyphs which can never fit into the atlas
+	DynamicGlyph const*                        fallback_glyph = nullptr; // drawn in place of glyphs which were not uploaded yet
+};
+
+// Drawn in place of glyphs which were added to a dynamic atlas, but not uploaded yet. If the
+// font has no glyph for the replacement character, stb_truetype renders the font's missing glyph.
+static constexpr uint32_t DYNAMIC_ATLAS_FALLBACK_CODEPOINT = 0xFFFD;
+
+// Anything which uploads atlas pixels - such as a font renderer - is a consumer of the atlas.
+// Consumers upload on their own schedule, which is why each consumer tracks its own changes.
+struct AtlasConsumer {
+	struct span_t {
+		uint32_t x0 = 0; // span of pixels which changed since last upload;
+		uint32_t x1 = 0; // shelf is not dirty if x0 == x1
+	};
+
+	bool                        in_use      = false;
+	bool                        fully_dirty = true; // whether the full atlas needs to be uploaded
+	uint64_t                    last_frame  = 0;    // dynamic atlas frame in which this consumer last began a frame
+	std::vector<span_t>         dirty_spans;        // one span per dynamic atlas shelf
+	std::vector<atlas_region_t> regions;            // scratch storage for take_atlas_dirty_regions
+};
+
 struct le_font_o {
 	// members
-	static constexpr uint16_t                                      PIXELS_WIDTH  = 512 * 2;
-	static constexpr uint16_t                                      PIXELS_HEIGHT = 256 * 2;
-	static constexpr uint16_t                                      PIXELS_BPP    = 1; // bytes per pixels
-	stbtt_fontinfo                                                 info;
-	std::vector<uint8_t>                                           data;                     // ttf file data
-	std::array<uint8_t, PIXELS_WIDTH * PIXELS_HEIGHT * PIXELS_BPP> pixels;                   // pixels for texture_atlas
-	float                                                          font_size         = 24.f; // font size in pixels. TODO: check units for font size.
-	bool                                                           has_texture_atlas = false;
-	std::vector<UnicodeRange>                                      unicode_ranges; // available unicode ranges, assumed to be sorted.
+	static constexpr uint16_t   PIXELS_WIDTH  = 512 * 2; // atlas width, and also width of a dynamic atlas page
+	static constexpr uint16_t   PIXELS_HEIGHT = 256 * 2; // atlas height, and also height of a dynamic atlas page
+	static constexpr uint16_t   PIXELS_BPP    = 1;       // bytes per pixels
+	stbtt_fontinfo              info;
+	std::vector<uint8_t>        data;                      // ttf file data
+	std::vector<uint8_t>        pixels;                    // pixels for texture_atlas
+	uint32_t                    pixels_height     = 0;     // height of texture atlas in pixels
+	float                       font_size         = 24.f;  // font size in pixels. TODO: check units for font size.
+	bool                        has_texture_atlas = false; //
+	std::vector<UnicodeRange>   unicode_ranges;            // available unicode ranges, assumed to be sorted.
+	bool                        is_sdf_atlas      = false; // whether atlas holds signed distance fields instead of coverage
+	DynamicAtlas*               dynamic_atlas = nullptr;   // only set if atlas is dynamic, owning
+	std::vector<AtlasConsumer>  atlas_consumers;           // indexed by consumer id
+	std::mutex                  atlas_mtx;                 // protects dynamic atlas, and atlas consumers
 };
 
 // ----------------------------------------------------------------------
@@ -130,6 +189,9 @@ static void le_font_add_paths_for_glyph( le_font_o const* self, le_path_o* path,
 			break;
 		}
 	}
+
+	stbtt_FreeShape( &self->info, pp_arr );
+
 	int advanceWidth, leftSideBearing;
 	stbtt_GetCodepointHMetrics( &self->info, codepoint, &advanceWidth, &leftSideBearing );
 
@@ -165,10 +227,43 @@ static le_font_o* le_font_create( char const* font_filename, float font_size ) {
 
 // ----------------------------------------------------------------------
 
+// Marks the full atlas as changed for all consumers - caller must hold atlas_mtx.
+static void atlas_mark_fully_dirty( le_font_o* self ) {
+	for ( auto& c : self->atlas_consumers ) {
+		c.fully_dirty = true;
+	}
+}
+
+// ----------------------------------------------------------------------
+
+// Marks a span of pixels of a dynamic atlas shelf as changed for all consumers - caller must hold atlas_mtx.
+static void atlas_mark_shelf_dirty( le_font_o* self, uint32_t shelf_index, uint32_t x0, uint32_t x1 ) {
+	for ( auto& c : self->atlas_consumers ) {
+		if ( !c.in_use || c.fully_dirty ) {
+			continue;
+		}
+		if ( c.dirty_spans.size() <= shelf_index ) {
+			c.dirty_spans.resize( shelf_index + 1 );
+		}
+		auto& span = c.dirty_spans[ shelf_index ];
+		if ( span.x0 == span.x1 ) {
+			span = { x0, x1 };
+		} else {
+			span.x0 = std::min( span.x0, x0 );
+			span.x1 = std::max( span.x1, x1 );
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+
 // Creates - (or re-creates) texture atlas for a given font
 static bool le_font_create_atlas( le_font_o* self ) {
 	if ( false == self->has_texture_atlas ) {
 
+		self->pixels_height = self->PIXELS_HEIGHT;
+		self->pixels.resize( size_t( self->PIXELS_WIDTH ) * self->pixels_height * self->PIXELS_BPP );
+
 		stbtt_pack_context pack_context{};
 		stbtt_PackBegin( &pack_context, self->pixels.data(), self->PIXELS_WIDTH, self->PIXELS_HEIGHT, 0, 1, nullptr ); // stride 0 means tightly packed, leave 1 pixel padding around pixels
 
@@ -195,8 +290,492 @@ static bool le_font_create_atlas( le_font_o* self ) {
 
 		stbtt_PackEnd( &pack_context );
 
+		std::scoped_lock lock( self->atlas_mtx );
 		self->has_texture_atlas = true;
+		atlas_mark_fully_dirty( self );
+	}
+	return true;
+}
+
+// ----------------------------------------------------------------------
+
+// Removes all glyphs from the shelf, so that it may be re-filled - caller must hold atlas_mtx.
+static void dynamic_atlas_evict_shelf( le_font_o* self, uint32_t shelf_index ) {
+	auto& atlas = *self->dynamic_atlas;
+	auto& shelf = atlas.shelves[ shelf_index ];
+
+	for ( auto const& cp : shelf.codepoints ) {
+		atlas.glyphs.erase( cp );
+	}
+	shelf.codepoints.clear();
+
+	// Clear pixels, as glyphs are rendered into rects which don't cover the full shelf height.
+	memset( self->pixels.data() + size_t( shelf.y ) * self->PIXELS_WIDTH, 0, size_t( shelf.height ) * self->PIXELS_WIDTH );
+
+	shelf.x_cursor = 0;
+
+	atlas_mark_shelf_dirty( self, shelf_index, 0, self->PIXELS_WIDTH );
+}
+
+// ----------------------------------------------------------------------
+
+// Finds a shelf with space for a rectangle of given size - opens a new shelf, or evicts least
+// recently used shelves as needed. Returns false if no space could be found. Caller must hold atlas_mtx.
+static bool dynamic_atlas_allocate( le_font_o* self, uint32_t w, uint32_t h, uint32_t* shelf_index ) {
+	auto& atlas = *self->dynamic_atlas;
+
+	if ( w > self->PIXELS_WIDTH || h > self->PIXELS_HEIGHT ) {
+		return false;
+	}
+
+	// Round up shelf height, so that glyphs of similar height share shelves.
+	uint32_t const shelf_h = std::min<uint32_t>( ( h + 7 ) & ~7u, self->PIXELS_HEIGHT );
+
+	// First, try to find the best-fitting shelf which has space left.
+
+	uint32_t best_index = uint32_t( ~0u );
+	uint32_t best_waste = uint32_t( ~0u );
+
+	for ( uint32_t i = 0; i != atlas.shelves.size(); i++ ) {
+		auto const& shelf = atlas.shelves[ i ];
+		if ( shelf.height >= h && shelf.height <= shelf_h * 2 && shelf.x_cursor + w <= self->PIXELS_WIDTH ) {
+			uint32_t waste = shelf.height - h;
+			if ( waste < best_waste ) {
+				best_waste = waste;
+				best_index = i;
+			}
+		}
+	}
+
+	if ( best_index != ~0u ) {
+		*shelf_index = best_index;
+		return true;
+	}
+
+	// Open a new shelf, if there is space left below the lowest shelf.
+
+	uint32_t const y = atlas.shelves_y_end;
+
+	if ( y + shelf_h <= self->pixels_height ) {
+		AtlasShelf shelf{};
+		shelf.y      = y;
+		shelf.height = shelf_h;
+		atlas.shelves.emplace_back( std::move( shelf ) );
+		atlas.shelves_y_end = y + shelf_h;
+		*shelf_index        = uint32_t( atlas.shelves.size() - 1 );
+		return true;
+	}
+
+	// Atlas is full: evict the least recently used shelf which is tall enough. We never
+	// evict shelves which were used in the current frame, as glyphs from these shelves
+	// may already have been placed into vertex buffers for the current frame.
+
+	uint64_t lru_frame = atlas.current_frame;
+	uint32_t lru_index = uint32_t( ~0u );
+
+	for ( uint32_t i = 0; i != atlas.shelves.size(); i++ ) {
+		auto const& shelf = atlas.shelves[ i ];
+		if ( shelf.height >= h && shelf.last_used_frame < lru_frame && !shelf.is_pinned ) {
+			lru_frame = shelf.last_used_frame;
+			lru_index = i;
+		}
+	}
+
+	if ( lru_index == ~0u ) {
+		return false;
+	}
+
+	dynamic_atlas_evict_shelf( self, lru_index );
+
+	*shelf_index = lru_index;
+	return true;
+}
+
+// ----------------------------------------------------------------------
+
+// Rasterizes glyph for codepoint into dynamic atlas. Returns nullptr if there was no space for glyph.
+// Caller must hold atlas_mtx.
+static DynamicGlyph const* dynamic_atlas_add_glyph( le_font_o* self, uint32_t codepoint ) {
+	auto& atlas = *self->dynamic_atlas;
+
+	// We use a pack context only to tell stb_truetype how to render into our pixels -
+	// we do our own packing, which is why we don't need stbtt_PackBegin.
+
+	stbtt_pack_context spc{};
+	spc.width           = self->PIXELS_WIDTH;
+	spc.height          = int( self->pixels_height );
+	spc.stride_in_bytes = self->PIXELS_WIDTH * self->PIXELS_BPP;
+	spc.padding         = 1;
+	spc.h_oversample    = 2; // same oversampling as static atlas
+	spc.v_oversample    = 1;
+
+	DynamicGlyph glyph{};
+
+	stbtt_pack_range range{};
+	range.font_size                        = self->font_size;
+	range.first_unicode_codepoint_in_range = int( codepoint );
+	range.num_chars                        = 1;
+	range.chardata_for_range               = &glyph.data;
+
+	stbrp_rect rect{};
+	stbtt_PackFontRangesGatherRects( &spc, &self->info, &range, 1, &rect );
+
+	if ( uint32_t( rect.w ) > self->PIXELS_WIDTH || uint32_t( rect.h ) > self->PIXELS_HEIGHT ) {
+		// Glyph is larger than an atlas page: it will never fit, no matter how many glyphs we evict.
+		std::cerr << "Glyph for codepoint U+" << std::hex << codepoint << std::dec
+		          << " is too large for font atlas, and will not be drawn." << std::endl
+		          << std::flush;
+		atlas.failed_codepoints.insert( codepoint );
+		return nullptr;
+	}
+
+	uint32_t shelf_index = 0;
+
+	if ( false == dynamic_atlas_allocate( self, rect.w, rect.h, &shelf_index ) ) {
+		return nullptr;
+	}
+
+	auto& shelf = atlas.shelves[ shelf_index ];
+
+	spc.pixels = self->pixels.data();
+
+	uint32_t const glyph_x0 = shelf.x_cursor;
+	uint32_t const glyph_x1 = shelf.x_cursor + rect.w; // rect includes padding
+
+	rect.x          = stbrp_coord( glyph_x0 );
+	rect.y          = stbrp_coord( shelf.y );
+	rect.was_packed = 1;
+
+	stbtt_PackFontRangesRenderIntoRects( &spc, &self->info, &range, 1, &rect );
+
+	atlas_mark_shelf_dirty( self, shelf_index, glyph_x0, glyph_x1 );
+
+	shelf.x_cursor = glyph_x1;
+	shelf.codepoints.push_back( codepoint );
+
+	glyph.shelf_index = shelf_index;
+	glyph.added_frame = atlas.current_frame;
+
+	return &( atlas.glyphs[ codepoint ] = glyph );
+}
+
+// ----------------------------------------------------------------------
+
+// Creates a texture atlas which starts out empty - glyphs are rasterized into the
+// atlas the first time they are drawn. Once the atlas is full, least recently used
+// glyphs are evicted to make space.
+//
+// The atlas is `max_pages` pages tall from the start, so that its extent never changes,
+// and texture coordinates may be normalised, as for any other atlas.
+static bool le_font_create_dynamic_atlas( le_font_o* self, uint32_t max_pages ) {
+	if ( self->has_texture_atlas ) {
+		return false;
 	}
+
+	std::scoped_lock lock( self->atlas_mtx );
+
+	self->dynamic_atlas = new DynamicAtlas();
+
+	// Atlas coordinates must fit into 16 bits, as they are stored in stbtt_packedchar.
+	self->pixels_height = std::clamp( max_pages, 1u, 16u ) * self->PIXELS_HEIGHT;
+	self->pixels.resize( size_t( self->PIXELS_WIDTH ) * self->pixels_height * self->PIXELS_BPP );
+
+	self->has_texture_atlas = true;
+	atlas_mark_fully_dirty( self );
+
+	// The fallback glyph is rasterized before any frame is drawn, so that it is part of every
+	// consumer's first upload - it therefore doesn't count as added in the current frame. Its
+	// shelf is pinned, so that the fallback glyph is never evicted.
+	auto& atlas = *self->dynamic_atlas;
+
+	if ( dynamic_atlas_add_glyph( self, DYNAMIC_ATLAS_FALLBACK_CODEPOINT ) ) {
+		auto& fallback       = atlas.glyphs[ DYNAMIC_ATLAS_FALLBACK_CODEPOINT ];
+		fallback.added_frame = 0;
+		atlas.shelves[ fallback.shelf_index ].is_pinned = true;
+		atlas.fallback_glyph                            = &fallback;
+	}
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+
+struct sdf_glyph_task_t {
+	uint32_t  codepoint;
+	uint32_t  x; // top-left corner of glyph rect in atlas, in pixels
+	uint32_t  y; //
+	uint32_t  w; // extent of glyph rect in pixels - includes padding for distance field
+	uint32_t  h; //
+	glm::vec2 origin; // glyph origin relative to top-left corner of glyph rect
+};
+
+struct sdf_glyph_job_params_t {
+	le_font_o const*        font;
+	uint8_t*                pixels; // font atlas pixels
+	sdf_glyph_task_t const* tasks_begin;
+	sdf_glyph_task_t const* tasks_end;
+	float                   scale;       // scale from font units to sdf pixels
+	float                   pixel_range; // distance in pixels which maps to the full range of sdf values
+};
+
+// ----------------------------------------------------------------------
+
+// Renders signed distance fields for a range of glyphs into the font atlas. Glyph
+// outlines are taken from `le_path`, which means they are flattened into polylines,
+// against which we measure distances. Since every glyph writes only into its own
+// rect, jobs may run in parallel.
+static void render_sdf_glyphs( void* p_params ) {
+	auto params = static_cast<sdf_glyph_job_params_t const*>( p_params );
+	auto font   = params->font;
+
+	using namespace le_path;
+
+	le_path_o* path = le_path_i.create();
+
+	std::vector<glm::vec2> vertices;        // flattened outline vertices for all contours of the glyph
+	std::vector<size_t>    contour_offsets; // offset into vertices for the first vertex of each contour, plus end
+
+	for ( auto task = params->tasks_begin; task != params->tasks_end; task++ ) {
+
+		le_path_i.clear( path );
+
+		glm::vec2 origin = task->origin;
+		le_font_add_paths_for_glyph( font, path, int32_t( task->codepoint ), params->scale, &origin, 0 );
+		le_path_i.flatten( path, 0.1f );
+
+		vertices.clear();
+		contour_offsets.clear();
+
+		size_t const num_polylines = le_path_i.get_num_polylines( path );
+
+		for ( size_t i = 0; i != num_polylines; i++ ) {
+			size_t num_vertices = 0;
+			le_path_i.get_vertices_for_polyline( path, i, nullptr, &num_vertices );
+			contour_offsets.push_back( vertices.size() );
+			vertices.resize( vertices.size() + num_vertices );
+			le_path_i.get_vertices_for_polyline( path, i, vertices.data() + contour_offsets.back(), &num_vertices );
+		}
+		contour_offsets.push_back( vertices.size() );
+
+		uint8_t* pixels = params->pixels + size_t( task->y ) * font->PIXELS_WIDTH + task->x;
+
+		for ( uint32_t y = 0; y != task->h; y++ ) {
+			for ( uint32_t x = 0; x != task->w; x++ ) {
+
+				glm::vec2 const p{ float( x ) + 0.5f, float( y ) + 0.5f }; // sample at pixel centre
+
+				float min_dist_2 = std::numeric_limits<float>::max();
+				int   winding    = 0;
+
+				for ( size_t c = 0; c + 1 < contour_offsets.size(); c++ ) {
+					glm::vec2 const* c_begin = vertices.data() + contour_offsets[ c ];
+					glm::vec2 const* c_end   = vertices.data() + contour_offsets[ c + 1 ];
+
+					if ( c_begin == c_end ) {
+						continue;
+					}
+
+					// Glyph contours are always closed - we start with the closing segment.
+					glm::vec2 a = *( c_end - 1 );
+
+					for ( auto v = c_begin; v != c_end; v++ ) {
+						glm::vec2 const b  = *v;
+						glm::vec2 const ab = b - a;
+						glm::vec2 const ap = p - a;
+
+						// Distance to line segment
+
+						float const len_2 = ab.x * ab.x + ab.y * ab.y;
+						float const t     = len_2 > 0.f ? std::clamp( ( ap.x * ab.x + ap.y * ab.y ) / len_2, 0.f, 1.f ) : 0.f;
+						glm::vec2   d     = ap - t * ab;
+						min_dist_2        = std::min( min_dist_2, d.x * d.x + d.y * d.y );
+
+						// Non-zero winding rule, which is what TrueType uses.
+
+						float const cross = ab.x * ap.y - ab.y * ap.x;
+						if ( a.y <= p.y && b.y > p.y && cross > 0.f ) {
+							winding++;
+						} else if ( b.y <= p.y && a.y > p.y && cross < 0.f ) {
+							winding--;
+						}
+
+						a = b;
+					}
+				}
+
+				float dist = sqrtf( min_dist_2 ) * ( winding != 0 ? 1.f : -1.f );
+				float val  = std::clamp( 0.5f + dist / ( 2.f * params->pixel_range ), 0.f, 1.f );
+
+				pixels[ size_t( y ) * font->PIXELS_WIDTH + x ] = uint8_t( val * 255.f + 0.5f );
+			}
+		}
+	}
+
+	le_path_i.destroy( path );
+}
+
+// ----------------------------------------------------------------------
+
+// Creates an atlas of signed distance fields for the same unicode ranges as `create_atlas`.
+//
+// Distance fields are rendered at `sdf_font_size`, so that a single atlas may be used to
+// draw text at any size (see `draw_utf8_string_scaled`). Glyph metrics are stored so that
+// drawing at scale 1 gives text at the font size given when creating the font.
+//
+// `pixel_range` is the distance (in atlas pixels) from the outline at which the distance
+// field saturates. Rendering glyphs is spread across le_jobs worker threads, if available.
+static bool le_font_create_sdf_atlas( le_font_o* self, float sdf_font_size, float pixel_range ) {
+	if ( self->has_texture_atlas ) {
+		return false;
+	}
+
+	float const scale     = stbtt_ScaleForPixelHeight( &self->info, sdf_font_size );
+	float const rescale   = self->font_size / sdf_font_size; // from sdf pixels to font pixels
+	int const   padding   = int( ceilf( pixel_range ) ) + 1;
+	uint32_t    num_tasks = 0;
+
+	self->unicode_ranges.clear();
+
+	for ( auto const& [ start_range, end_range ] : { std::pair<uint32_t, uint32_t>{ 0x00, 0x7F },  // ascii
+	                                                 { 0x80, 0xff },                               // latin-extended
+	                                                 { 0x20A0, 0x20CF },                           // currency symbols
+	                                                 { 0x2190, 0x21FF } } ) {                      // arrows
+		UnicodeRange r;
+		r.start_range = start_range;
+		r.end_range   = end_range;
+		r.data.resize( r.end_range - r.start_range );
+		self->unicode_ranges.emplace_back( std::move( r ) );
+		num_tasks += end_range - start_range;
+	}
+
+	// Calculate glyph rects, and glyph metrics - everything apart from atlas coordinates.
+
+	std::vector<sdf_glyph_task_t> tasks;
+	std::vector<stbrp_rect>       rects;
+	tasks.reserve( num_tasks );
+	rects.reserve( num_tasks );
+
+	for ( auto& r : self->unicode_ranges ) {
+		for ( uint32_t cp = r.start_range; cp != r.end_range; cp++ ) {
+			int x0 = 0, y0 = 0, x1 = 0, y1 = 0;
+			int advance_width, left_side_bearing;
+
+			stbtt_GetCodepointHMetrics( &self->info, int( cp ), &advance_width, &left_side_bearing );
+
+			if ( 0 == stbtt_GetCodepointBox( &self->info, int( cp ), &x0, &y0, &x1, &y1 ) ) {
+				x0 = y0 = x1 = y1 = 0; // glyph has no outline (e.g. space)
+			}
+
+			// Glyph boxes are in font units, with positive y pointing upwards.
+			float const left = floorf( x0 * scale );
+			float const top  = floorf( -y1 * scale );
+
+			sdf_glyph_task_t task{};
+			task.codepoint = cp;
+			task.w         = uint32_t( ceilf( x1 * scale ) - left ) + 2 * padding;
+			task.h         = uint32_t( ceilf( -y0 * scale ) - top ) + 2 * padding;
+			task.origin    = { float( padding ) - left, float( padding ) - top };
+
+			auto& packed    = r.data[ cp - r.start_range ];
+			packed.xoff     = ( left - padding ) * rescale;
+			packed.yoff     = ( top - padding ) * rescale;
+			packed.xoff2    = packed.xoff + task.w * rescale;
+			packed.yoff2    = packed.yoff + task.h * rescale;
+			packed.xadvance = advance_width * scale * rescale;
+
+			stbrp_rect rect{};
+			rect.id = int( tasks.size() );
+			rect.w  = stbrp_coord( task.w + 1 ); // leave one pixel of space between glyphs
+			rect.h  = stbrp_coord( task.h + 1 );
+
+			tasks.push_back( task );
+			rects.push_back( rect );
+		}
+	}
+
+	// Pack glyph rects into atlas - if they don't fit, we double the height of the atlas.
+
+	for ( self->pixels_height = self->PIXELS_HEIGHT;; self->pixels_height *= 2 ) {
+
+		if ( self->pixels_height > 16 * self->PIXELS_HEIGHT ) {
+			std::cerr << "Could not fit sdf glyphs into font atlas, try a smaller sdf font size." << std::endl
+			          << std::flush;
+			self->unicode_ranges.clear();
+			return false;
+		}
+
+		self->pixels.resize( size_t( self->PIXELS_WIDTH ) * self->pixels_height * self->PIXELS_BPP );
+
+		stbtt_pack_context pack_context{};
+		stbtt_PackBegin( &pack_context, self->pixels.data(), self->PIXELS_WIDTH, int( self->pixels_height ), 0, 0, nullptr );
+		stbtt_PackFontRangesPackRects( &pack_context, rects.data(), int( rects.size() ) );
+		stbtt_PackEnd( &pack_context );
+
+		if ( std::all_of( rects.begin(), rects.end(), []( stbrp_rect const& r ) { return r.was_packed != 0; } ) ) {
+			break;
+		}
+	}
+
+	// Store atlas coordinates with glyph metrics.
+
+	for ( auto const& rect : rects ) {
+		auto& task = tasks[ rect.id ];
+		task.x     = rect.x;
+		task.y     = rect.y;
+	}
+
+	{
+		size_t i = 0;
+		for ( auto& r : self->unicode_ranges ) {
+			for ( auto& packed : r.data ) {
+				auto const& task = tasks[ i++ ];
+				packed.x0        = uint16_t( task.x );
+				packed.y0        = uint16_t( task.y );
+				packed.x1        = uint16_t( task.x + task.w );
+				packed.y1        = uint16_t( task.y + task.h );
+			}
+		}
+	}
+
+	// Render distance fields - this is where most of the time is spent.
+
+	uint32_t const num_workers = le_jobs::get_worker_thread_count();
+
+	if ( num_workers == 0 ) {
+		// Job system not available: render on the calling thread.
+		sdf_glyph_job_params_t params{ self, self->pixels.data(), tasks.data(), tasks.data() + tasks.size(), scale, pixel_range };
+		render_sdf_glyphs( &params );
+	} else {
+		// We split glyphs into more chunks than we have workers, so that a few
+		// complex glyphs don't keep all other workers waiting.
+		uint32_t const num_jobs       = std::min( uint32_t( tasks.size() ), num_workers * 4 );
+		uint32_t const tasks_per_job  = uint32_t( tasks.size() + num_jobs - 1 ) / num_jobs;
+		auto* const    tasks_data_end = tasks.data() + tasks.size();
+
+		std::vector<sdf_glyph_job_params_t> params;
+		std::vector<le_jobs::job_t>         jobs;
+		params.reserve( num_jobs );
+		jobs.reserve( num_jobs );
+
+		for ( size_t i = 0; i < tasks.size(); i += tasks_per_job ) {
+			auto* begin = tasks.data() + i;
+			params.push_back( { self, self->pixels.data(), begin, std::min( begin + tasks_per_job, tasks_data_end ), scale, pixel_range } );
+		}
+
+		for ( auto& p : params ) {
+			jobs.push_back( { render_sdf_glyphs, &p } );
+		}
+
+		le_jobs::counter_t* counter;
+		le_jobs::run_jobs( jobs.data(), uint32_t( jobs.size() ), &counter );
+		le_jobs::wait_for_counter_and_free( counter, 0 );
+	}
+
+	std::scoped_lock lock( self->atlas_mtx );
+	self->has_texture_atlas = true;
+	self->is_sdf_atlas      = true;
+	atlas_mark_fully_dirty( self );
+
 	return true;
 }
 
@@ -285,11 +864,92 @@ static bool le_utf8_iterator( char const* str, void* user_data, le_font_api::le_
 	return ( count_remaining_bytes == 0 );
 }
 
+// Calculates quad for glyph, and advances x_pos - returns false if glyph is not available.
+// Texture coordinates for the quad are normalised.
+//
+// For a dynamic atlas, caller must hold atlas_mtx. Glyphs which were added to a dynamic atlas
+// in the current frame have not been uploaded yet - for these, we return a quad for the
+// fallback glyph, but advance x_pos as if we had drawn the glyph itself.
+static bool get_packed_quad_for_codepoint( le_font_o* self, uint32_t cp, float* x_pos, float* y_pos, stbtt_aligned_quad* quad ) {
+
+	if ( self->dynamic_atlas ) {
+		auto& atlas = *self->dynamic_atlas;
+
+		DynamicGlyph const* glyph = nullptr;
+
+		if ( auto it = atlas.glyphs.find( cp ); it != atlas.glyphs.end() ) {
+			glyph = &it->second;
+		} else if ( atlas.failed_codepoints.count( cp ) ) {
+			// We already know that this glyph will never fit into the atlas.
+			return false;
+		} else {
+			glyph = dynamic_atlas_add_glyph( self, cp );
+		}
+
+		if ( nullptr == glyph ) {
+			// Atlas is full, and all glyphs are in use for the current frame.
+			return false;
+		}
+
+		atlas.shelves[ glyph->shelf_index ].last_used_frame = atlas.current_frame;
+
+		if ( glyph->added_frame != atlas.current_frame ) {
+			stbtt_GetPackedQuad( &glyph->data, self->PIXELS_WIDTH, int( self->pixels_height ), 0, x_pos, y_pos, quad, 0 );
+			return true;
+		}
+
+		// --------| invariant: glyph pixels have not been uploaded yet
+
+		float fallback_x = *x_pos;
+		float fallback_y = *y_pos;
+
+		stbtt_aligned_quad glyph_quad{};
+		stbtt_GetPackedQuad( &glyph->data, self->PIXELS_WIDTH, int( self->pixels_height ), 0, x_pos, y_pos, &glyph_quad, 0 );
+
+		if ( nullptr == atlas.fallback_glyph ) {
+			return false; // fallback glyph did not fit into atlas - we leave a gap instead.
+		}
+
+		stbtt_GetPackedQuad( &atlas.fallback_glyph->data, self->PIXELS_WIDTH, int( self->pixels_height ), 0, &fallback_x, &fallback_y, quad, 0 );
+
+		return true;
+	}
+
+	// we must check that our codepoint is contained within a range of
+	// available codepoints from the current font.
+
+	UnicodeRange const*       range      = self->unicode_ranges.data();
+	UnicodeRange const* const end_ranges = range + self->unicode_ranges.size();
+
+	while ( range != end_ranges && cp > range->end_range ) {
+		range++;
+	}
+
+	if ( range == end_ranges || cp < range->start_range ) {
+		// could not find codepoint in known ranges.
+		assert( false && "could not find codepoint" );
+		return false;
+	}
+
+	// -------| invariant: cp is < range->end_range
+
+	stbtt_GetPackedQuad( range->data.data(), self->PIXELS_WIDTH, int( self->pixels_height ), int( cp - range->start_range ), x_pos, y_pos, quad, 0 );
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
 // Places geometry into vertices to draw an utf-8 string using given font.
 //
 // Returns count of used vertices - calculated as 6 * codepoint count.
 // Note that we count utf-8 code points, not ascii characters.
 //
+// Vertices are x/y position, and s/t (normalised) texture coordinates.
+//
+// If the font uses a dynamic atlas, any glyphs which are not yet in the
+// atlas get rasterized into the atlas. Until their pixels were uploaded,
+// which happens in the next frame, we draw a fallback glyph in their place.
+//
 // Place nullptr in `vertices` to calculate vertex count and return early.
 //
 // `max_vertices` marks the maximum number of vertices we may write into.
@@ -298,7 +958,11 @@ static bool le_utf8_iterator( char const* str, void* user_data, le_font_api::le_
 //
 // If vertex data was written, x_pos and y_pos will be updated to the current
 // advance of the virtual text cursor.
-static size_t le_font_draw_utf8_string( le_font_o* self, const char* str, float* x_pos, float* y_pos, glm::vec4* vertices, size_t max_vertices, size_t vertex_offset ) {
+//
+// `scale` scales glyph geometry relative to the font size for which the atlas was
+// created - this is most useful with an sdf atlas, which may be scaled without
+// becoming blurry.
+static size_t le_font_draw_utf8_string_scaled( le_font_o* self, const char* str, float scale, float* x_pos, float* y_pos, glm::vec4* vertices, size_t max_vertices, size_t vertex_offset ) {
 
 	size_t glyph_count = 0;
 
@@ -323,45 +987,54 @@ static size_t le_font_draw_utf8_string( le_font_o* self, const char* str, float*
 	const float y_anchor     = y_pos ? *y_pos : 0; // In case nullptr, set to zero.
 	size_t      num_newlines = 0;
 
+	// We track the pen position relative to the anchor, in unscaled atlas font pixels,
+	// so that glyph quads may be scaled around the anchor.
+	float pen_x = 0;
+	float pen_y = 0;
+
+	auto update_pos = [ & ]() {
+		if ( x_pos ) {
+			*x_pos = x_anchor + pen_x * scale;
+		}
+		if ( y_pos ) {
+			*y_pos = y_anchor + pen_y * scale;
+		}
+	};
+
 	size_t num_vertices = 0;
 
+	// A dynamic atlas may be changed by other threads which draw strings with the same font.
+	std::unique_lock<std::mutex> atlas_lock;
+	if ( self->dynamic_atlas ) {
+		atlas_lock = std::unique_lock( self->atlas_mtx );
+	}
+
 	{
 		stbtt_aligned_quad quad{};
 
 		for ( auto const& cp : codepoints ) {
 
 			if ( cp == '\n' ) {
-				*y_pos = y_anchor + int( ( ++num_newlines ) * self->font_size * 1.2f ); // We increase y position - assumed line height 1.2, aligned to pixels,
-				*x_pos = x_anchor;                                                      // and reset x position
+				pen_y = int( ( ++num_newlines ) * self->font_size * 1.2f ); // We increase y position - assumed line height 1.2, aligned to pixels,
+				pen_x = 0;                                                  // and reset x position
 				continue;
 			}
 
-			// we must check that our codepoint is contained within a range of
-			// available codepoints from the current font.
-
-			UnicodeRange*             range      = self->unicode_ranges.data();
-			UnicodeRange const* const end_ranges = range + self->unicode_ranges.size();
-
-			while ( range != end_ranges && cp > range->end_range ) {
-				range++;
-			}
-
-			if ( range == end_ranges || cp < range->start_range ) {
-				// could not find codepoint in known ranges.
-				assert( false && "could not find codepoint" );
-
+			if ( false == get_packed_quad_for_codepoint( self, cp, &pen_x, &pen_y, &quad ) ) {
 				continue;
 			}
 
-			// -------| invariant: cp is < range->end_range
-
-			stbtt_GetPackedQuad( range->data.data(), self->PIXELS_WIDTH, self->PIXELS_HEIGHT, int( cp - range->start_range ), x_pos, y_pos, &quad, 0 );
-
 			if ( num_vertices + 6 > max_vertices ) {
 				// we don't have enough vertex memory left, we must return early.
+				update_pos();
 				return num_vertices / 6;
 			}
 
+			quad.x0 = x_anchor + quad.x0 * scale;
+			quad.y0 = y_anchor + quad.y0 * scale;
+			quad.x1 = x_anchor + quad.x1 * scale;
+			quad.y1 = y_anchor + quad.y1 * scale;
+
 			// Update vertices - stb_tt_packed_quad returns top-left,
 			// and bottom-right vertex, and we must expand this to two
 			// triangles.
@@ -383,11 +1056,37 @@ static size_t le_font_draw_utf8_string( le_font_o* self, const char* str, float*
 		}
 	}
 
+	update_pos();
+
 	return num_vertices;
 }
 
 // ----------------------------------------------------------------------
 
+static size_t le_font_draw_utf8_string( le_font_o* self, const char* str, float* x_pos, float* y_pos, glm::vec4* vertices, size_t max_vertices, size_t vertex_offset ) {
+	return le_font_draw_utf8_string_scaled( self, str, 1.f, x_pos, y_pos, vertices, max_vertices, vertex_offset );
+}
+
+// ----------------------------------------------------------------------
+
+static float le_font_get_font_size( le_font_o const* self ) {
+	return self->font_size;
+}
+
+// ----------------------------------------------------------------------
+
+static bool le_font_is_sdf_atlas( le_font_o const* self ) {
+	return self->is_sdf_atlas;
+}
+
+// ----------------------------------------------------------------------
+
+static bool le_font_is_dynamic_atlas( le_font_o const* self ) {
+	return self->dynamic_atlas != nullptr;
+}
+
+// ----------------------------------------------------------------------
+
 static float le_font_get_scale_for_pixels_height( le_font_o const* self, float height_in_pixels ) {
 	return stbtt_ScaleForPixelHeight( &self->info, height_in_pixels );
 }
@@ -403,13 +1102,115 @@ static bool le_font_get_atlas( le_font_o* self, uint8_t const** pixels, uint32_t
 	*pixels              = self->pixels.data();
 	*pix_stride_in_bytes = self->PIXELS_BPP;
 	*width               = self->PIXELS_WIDTH;
-	*height              = self->PIXELS_HEIGHT;
+	*height              = self->pixels_height;
 
 	return true;
 }
 
 // ----------------------------------------------------------------------
 
+// Adds a consumer of the atlas, and returns its id. A new consumer must upload the full atlas.
+static uint32_t le_font_add_atlas_consumer( le_font_o* self ) {
+	std::scoped_lock lock( self->atlas_mtx );
+
+	uint32_t id = 0;
+
+	while ( id != self->atlas_consumers.size() && self->atlas_consumers[ id ].in_use ) {
+		id++;
+	}
+
+	if ( id == self->atlas_consumers.size() ) {
+		self->atlas_consumers.emplace_back();
+	}
+
+	self->atlas_consumers[ id ]        = {};
+	self->atlas_consumers[ id ].in_use = true;
+
+	return id;
+}
+
+// ----------------------------------------------------------------------
+
+static void le_font_remove_atlas_consumer( le_font_o* self, uint32_t consumer ) {
+	std::scoped_lock lock( self->atlas_mtx );
+	assert( consumer < self->atlas_consumers.size() );
+	self->atlas_consumers[ consumer ] = {};
+}
+
+// ----------------------------------------------------------------------
+
+// Marks the beginning of a new frame for a dynamic atlas. The atlas frame advances once the first
+// consumer begins a frame which it has not begun before - which means that with many consumers,
+// the atlas still advances by one frame per frame. Shelves used in an earlier frame may be evicted.
+static void le_font_begin_atlas_frame( le_font_o* self, uint32_t consumer ) {
+	std::scoped_lock lock( self->atlas_mtx );
+
+	if ( nullptr == self->dynamic_atlas ) {
+		return;
+	}
+
+	auto& atlas = *self->dynamic_atlas;
+	auto& c     = self->atlas_consumers[ consumer ];
+
+	if ( c.last_frame == atlas.current_frame ) {
+		atlas.current_frame++;
+	}
+
+	c.last_frame = atlas.current_frame;
+}
+
+// ----------------------------------------------------------------------
+
+// Returns regions of the atlas which changed for this consumer since its previous call, and
+// resets them, so that any later changes will be returned by the next call.
+static bool le_font_take_atlas_dirty_regions( le_font_o* self, uint32_t consumer, atlas_region_t const** regions, size_t* num_regions ) {
+	std::scoped_lock lock( self->atlas_mtx );
+
+	auto& c = self->atlas_consumers[ consumer ];
+
+	c.regions.clear();
+
+	if ( self->has_texture_atlas ) {
+		if ( c.fully_dirty ) {
+			c.regions.push_back( { 0, 0, self->PIXELS_WIDTH, self->pixels_height } );
+		} else if ( self->dynamic_atlas ) {
+			auto const& shelves = self->dynamic_atlas->shelves;
+			for ( size_t i = 0; i != c.dirty_spans.size(); i++ ) {
+				auto const& span = c.dirty_spans[ i ];
+				if ( span.x0 != span.x1 ) {
+					c.regions.push_back( { span.x0, shelves[ i ].y, span.x1 - span.x0, shelves[ i ].height } );
+				}
+			}
+		}
+
+		c.fully_dirty = false;
+		c.dirty_spans.clear();
+	}
+
+	*regions     = c.regions.data();
+	*num_regions = c.regions.size();
+
+	return !c.regions.empty();
+}
+
+// ----------------------------------------------------------------------
+
+// Copies pixels for the given region of the atlas into `dst`, tightly packed.
+static void le_font_copy_atlas_region( le_font_o* self, atlas_region_t const* region, uint8_t* dst ) {
+	std::scoped_lock lock( self->atlas_mtx );
+
+	assert( region->x + region->width <= self->PIXELS_WIDTH && region->y + region->height <= self->pixels_height );
+
+	size_t const   row_bytes = size_t( region->width ) * self->PIXELS_BPP;
+	uint8_t const* src       = self->pixels.data() + ( size_t( region->y ) * self->PIXELS_WIDTH + region->x ) * self->PIXELS_BPP;
+
+	for ( uint32_t y = 0; y != region->height; y++ ) {
+		memcpy( dst + y * row_bytes, src + size_t( y ) * self->PIXELS_WIDTH * self->PIXELS_BPP, row_bytes );
+	}
+}
+
+// ----------------------------------------------------------------------
+
 static uint8_t* le_font_create_codepoint_sdf_bitmap( le_font_o* self, float scale, int codepoint, int padding, unsigned char onedge_value, float pixel_dist_scale, int* width, int* height, int* xoff, int* yoff ) {
 	return stbtt_GetCodepointSDF( &self->info, scale, codepoint, padding, onedge_value, pixel_dist_scale, width, height, xoff, yoff );
 }
@@ -423,6 +1224,7 @@ static void le_font_destroy_codepoint_sdf_bitmap( le_font_o* self, uint8_t* bitm
 // ----------------------------------------------------------------------
 
 static void le_font_destroy( le_font_o* self ) {
+	delete self->dynamic_atlas;
 	delete self;
 }
 
@@ -434,13 +1236,25 @@ LE_MODULE_REGISTER_IMPL( le_font, api ) {
 	le_font_i.create                       = le_font_create;
 	le_font_i.destroy                      = le_font_destroy;
 	le_font_i.create_atlas                 = le_font_create_atlas;
+	le_font_i.create_dynamic_atlas         = le_font_create_dynamic_atlas;
 	le_font_i.get_atlas                    = le_font_get_atlas;
+	le_font_i.add_atlas_consumer           = le_font_add_atlas_consumer;
+	le_font_i.remove_atlas_consumer        = le_font_remove_atlas_consumer;
+	le_font_i.begin_atlas_frame            = le_font_begin_atlas_frame;
+	le_font_i.take_atlas_dirty_regions     = le_font_take_atlas_dirty_regions;
+	le_font_i.copy_atlas_region            = le_font_copy_atlas_region;
 	le_font_i.add_paths_for_glyph          = le_font_add_paths_for_glyph;
 	le_font_i.get_scale_for_pixel_height   = le_font_get_scale_for_pixels_height;
 	le_font_i.create_codepoint_sdf_bitmap  = le_font_create_codepoint_sdf_bitmap;
 	le_font_i.destroy_codepoint_sdf_bitmap = le_font_destroy_codepoint_sdf_bitmap;
 
-	le_font_i.draw_utf8_string = le_font_draw_utf8_string;
+	le_font_i.create_sdf_atlas = le_font_create_sdf_atlas;
+	le_font_i.is_sdf_atlas     = le_font_is_sdf_atlas;
+	le_font_i.is_dynamic_atlas = le_font_is_dynamic_atlas;
+	le_font_i.get_font_size    = le_font_get_font_size;
+
+	le_font_i.draw_utf8_string        = le_font_draw_utf8_string;
+	le_font_i.draw_utf8_string_scaled = le_font_draw_utf8_string_scaled;
 
 	auto& utf8_iterator = static_cast<le_font_api*>( api )->le_utf8_iterator;
 	utf8_iterator       = le_utf8_iterator;
@@ -28,6 +28,13 @@ struct le_font_api {
 	};
 #endif
 
+	struct atlas_region_t {
+		uint32_t x;
+		uint32_t y;
+		uint32_t width;
+		uint32_t height;
+	};
+
 	typedef void le_uft8_iterator_cb_t( uint32_t codepoint, void *user_data );
 
 	// Parses str, calls `cb` for each glyph.
@@ -39,7 +46,44 @@ struct le_font_api {
 		void                 ( * destroy                    ) ( le_font_o* self );
 		bool                 ( * create_atlas               ) ( le_font_o* self );
 		bool                 ( * get_atlas                  ) ( le_font_o* self, uint8_t const ** pixels, uint32_t * width, uint32_t * height, uint32_t *pix_stride_in_bytes );
+
+		// Creates an atlas into which glyphs get rasterized on-demand, when first drawn via `draw_utf8_string`.
+		// The atlas holds `max_pages` pages of the same size as a static atlas - once it is full, least recently
+		// used glyphs get evicted. Use this instead of `create_atlas` for large scripts (CJK).
+		bool                 ( * create_dynamic_atlas       ) ( le_font_o* self, uint32_t max_pages );
+		bool                 ( * is_dynamic_atlas           ) ( le_font_o const* self );
+
+		// Creates an atlas of signed distance fields, rendered at `sdf_font_size`, from glyph outlines. A single sdf atlas may
+		// be used to draw text at any size - see `draw_utf8_string_scaled`. `pixel_range` is the distance from the outline, in
+		// atlas pixels, at which the distance field saturates. Glyphs are rendered in parallel if le_jobs is available.
+		bool                 ( * create_sdf_atlas           ) ( le_font_o* self, float sdf_font_size, float pixel_range );
+		bool                 ( * is_sdf_atlas               ) ( le_font_o const* self );
+
+		// Anything which uploads the atlas to the GPU (a font renderer, for example) must register as a consumer of
+		// the atlas - each consumer tracks which regions of the atlas changed since its own last upload.
+		uint32_t             ( * add_atlas_consumer         ) ( le_font_o* self );
+		void                 ( * remove_atlas_consumer      ) ( le_font_o* self, uint32_t consumer );
+
+		// Each consumer must call this once per frame, before it uploads changed regions. Marks the beginning of a
+		// new frame for a dynamic atlas: glyphs which were drawn in earlier frames may now be evicted.
+		void                 ( * begin_atlas_frame          ) ( le_font_o* self, uint32_t consumer );
+
+		// Returns regions of the atlas which changed since the consumer's last call, and resets these regions.
+		// Returns false if there are no changed regions.
+		bool                 ( * take_atlas_dirty_regions   ) ( le_font_o* self, uint32_t consumer, atlas_region_t const ** regions, size_t* num_regions );
+
+		// Copies atlas pixels for `region` into `dst`, tightly packed. Use this instead of reading pixels returned
+		// by `get_atlas` if the atlas is dynamic, as other threads may add glyphs while you read.
+		void                 ( * copy_atlas_region          ) ( le_font_o* self, atlas_region_t const * region, uint8_t* dst );
+
+		// NOTE: With a dynamic atlas, glyphs which are new to the atlas are drawn as a fallback glyph (U+FFFD, or the
+		// font's missing glyph) until the next frame, once their pixels were uploaded.
 		size_t				 ( * draw_utf8_string           ) ( le_font_o *self, const char *str, float* x_pos, float* y_pos, glm::vec4 *vertices, size_t max_vertices, size_t vertex_offset );
+
+		// Same as draw_utf8_string, but scales glyphs (and advances) by `scale` relative to the font size of the font.
+		size_t				 ( * draw_utf8_string_scaled    ) ( le_font_o *self, const char *str, float scale, float* x_pos, float* y_pos, glm::vec4 *vertices, size_t max_vertices, size_t vertex_offset );
+
+		float                ( * get_font_size              ) ( le_font_o const * self );
 		float                ( * get_scale_for_pixel_height ) ( le_font_o const * self, float height_in_pixels);
 
 		uint8_t*             ( * create_codepoint_sdf_bitmap  ) ( le_font_o* self, float scale, int codepoint, int padding, unsigned char onedge_value, float pixel_dist_scale, int *width, int *height, int *xoff, int *yoff);
@@ -82,6 +126,14 @@ class Font : NoCopy, NoMove {
 		return le_font::le_font_i.create_atlas( self );
 	}
 
+	bool createDynamicAtlas( uint32_t max_pages = 4 ) {
+		return le_font::le_font_i.create_dynamic_atlas( self, max_pages );
+	}
+
+	bool createSdfAtlas( float sdf_font_size = 32.f, float pixel_range = 4.f ) {
+		return le_font::le_font_i.create_sdf_atlas( self, sdf_font_size, pixel_range );
+	}
+
 	bool getAtlas( uint8_t const** pixels, uint32_t& width, uint32_t& height, uint32_t& pix_stride_in_bytes ) {
 		return le_font::le_font_i.get_atlas( self, pixels, &width, &height, &pix_stride_in_bytes );
 	}
@@ -4,30 +4,73 @@
 #include "le_renderer.h"
 #include "le_font.h"
 #include "le_pipeline_builder.h"
+#include "le_hash_util.h"
 
 #include <forward_list>
+#include <vector>
 #include <cstdio>
+#include <cstring>
 #include <atomic>
 #include <algorithm>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <unordered_map>
 
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE // vulkan clip space is from 0 to 1
 #define GLM_FORCE_RIGHT_HANDED      // glTF uses right handed coordinate system, and we're following its lead.
 #include "glm/vec4.hpp"
 
 struct font_info_t {
-	le_font_o*             font; // non-owning
-	le_img_resource_handle font_image;
-	le_resource_info_t     font_atlas_info;
-	le_texture_handle      font_image_sampler;
-	bool                   atlas_uploaded;
-	bool                   sampler_created;
+	le_font_o*                               font;            // non-owning
+	le_img_resource_handle                   font_image;
+	le_resource_info_t                       font_atlas_info;
+	le_texture_handle                        font_image_sampler;
+	bool                                     sampler_created;
+	uint32_t                                 atlas_consumer;  // our id as a consumer of the font's atlas
+	std::vector<le_font_api::atlas_region_t> pending_regions; // changed atlas regions which we have yet to upload
+};
+
+// Glyph quads for a string, laid out with the pen starting at the origin.
+struct string_layout_t {
+	std::vector<glm::vec4> vertices;  // x/y position, s/t texture coordinates per vertex
+	float                  advance_x; // pen position after laying out string
+	float                  advance_y; //
+};
+
+// Cache for string layouts, so that strings which don't change from frame to frame don't need to be
+// decoded and laid out again. Layouts are position-independent, which means that a string which only
+// moves, or changes colour, will re-use its cached layout.
+//
+// Entries which have not been used for `LAYOUT_CACHE_MAX_AGE` frames get evicted.
+//
+struct layout_cache_t {
+	struct entry_t {
+		std::shared_ptr<string_layout_t const> layout;
+		std::string                            str; // we keep a copy of the string so that we can detect hash collisions
+		le_font_o*                             font;
+		float                                  scale;
+		uint64_t                               last_used_frame;
+	};
+
+	static constexpr uint64_t LAYOUT_CACHE_MAX_AGE = 120;
+
+	std::mutex                            mtx; // protects all fields; strings may be drawn from more than one thread
+	std::unordered_map<uint64_t, entry_t> entries;
+	uint64_t                              current_frame = 0;
 };
 
 struct le_font_renderer_o {
 	std::forward_list<font_info_t> fonts_info;
-	std::atomic<size_t>            counter          = {};
-	le_shader_module_handle        shader_font_vert = nullptr;
-	le_shader_module_handle        shader_font_frag = nullptr;
+	std::vector<uint8_t>           upload_scratch; // used to gather pixels for atlas regions
+	std::atomic<size_t>            counter                    = {};
+	le_shader_module_handle        shader_font_vert           = nullptr;
+	le_shader_module_handle        shader_font_frag           = nullptr;
+	le_shader_module_handle        shader_font_frag_sdf       = nullptr; // used for fonts with signed distance field atlas
+	le_shader_module_handle        shader_font_vert_batch     = nullptr; // shaders for batched strings take colour per-vertex
+	le_shader_module_handle        shader_font_frag_batch     = nullptr; //
+	le_shader_module_handle        shader_font_frag_sdf_batch = nullptr; //
+	layout_cache_t                 layout_cache;
 };
 
 using draw_string_info_t = le_font_renderer_api::draw_string_info_t;
@@ -43,12 +86,22 @@ le_font_renderer_o* le_font_renderer_create( le_renderer_o* renderer ) {
 	self->shader_font_vert = LeShaderModuleBuilder( pm ).setSourceFilePath( "./resources/shaders/le_font.vert" ).setShaderStage( le::ShaderStage::eVertex ).setSourceDefinesString( "NO_MVP" ).setHandle( LE_SHADER_MODULE_HANDLE( "le_font_default_shader_vert" ) ).build();
 	self->shader_font_frag = LeShaderModuleBuilder( pm ).setSourceFilePath( "./resources/shaders/le_font.frag" ).setShaderStage( le::ShaderStage::eFragment ).setHandle( LE_SHADER_MODULE_HANDLE( "le_font_default_shader_frag" ) ).build();
 
+	self->shader_font_frag_sdf = LeShaderModuleBuilder( pm ).setSourceFilePath( "./resources/shaders/le_font_sdf.frag" ).setShaderStage( le::ShaderStage::eFragment ).setHandle( LE_SHADER_MODULE_HANDLE( "le_font_sdf_shader_frag" ) ).build();
+
+	self->shader_font_vert_batch     = LeShaderModuleBuilder( pm ).setSourceFilePath( "./resources/shaders/le_font.vert" ).setShaderStage( le::ShaderStage::eVertex ).setSourceDefinesString( "NO_MVP,PER_VERTEX_COLOR" ).setHandle( LE_SHADER_MODULE_HANDLE( "le_font_batch_shader_vert" ) ).build();
+	self->shader_font_frag_batch     = LeShaderModuleBuilder( pm ).setSourceFilePath( "./resources/shaders/le_font.frag" ).setShaderStage( le::ShaderStage::eFragment ).setSourceDefinesString( "PER_VERTEX_COLOR" ).setHandle( LE_SHADER_MODULE_HANDLE( "le_font_batch_shader_frag" ) ).build();
+	self->shader_font_frag_sdf_batch = LeShaderModuleBuilder( pm ).setSourceFilePath( "./resources/shaders/le_font_sdf.frag" ).setShaderStage( le::ShaderStage::eFragment ).setSourceDefinesString( "PER_VERTEX_COLOR" ).setHandle( LE_SHADER_MODULE_HANDLE( "le_font_sdf_batch_shader_frag" ) ).build();
+
 	return self;
 }
 
 // ----------------------------------------------------------------------
 
+// Note: fonts must outlive the font renderer to which they were added.
 void le_font_renderer_destroy( le_font_renderer_o* self ) {
+	for ( auto& fnt : self->fonts_info ) {
+		le_font::le_font_i.remove_atlas_consumer( fnt.font, fnt.atlas_consumer );
+	}
 	delete self;
 }
 
@@ -84,7 +137,8 @@ void le_font_renderer_add_font( le_font_renderer_o* self, le_font_o* font ) {
 	          font_atlas_info,
 	          le::Renderer::produceTextureHandle( img_sampler_name ),
 	          false,
-	          false } );
+	          le_font_i.add_atlas_consumer( font ),
+	          {} } );
 
 	self->fonts_info.push_front( info );
 }
@@ -119,8 +173,96 @@ le_img_resource_handle le_font_renderer_get_font_image( le_font_renderer_o* self
 
 // ----------------------------------------------------------------------
 
+// Marks the beginning of a new frame for the layout cache, and evicts stale layouts.
+static void layout_cache_next_frame( layout_cache_t* cache ) {
+	std::scoped_lock lock( cache->mtx );
+
+	cache->current_frame++;
+
+	// We only sweep once in a while, so that we don't have to
+	// iterate over all entries every frame.
+	if ( cache->current_frame % layout_cache_t::LAYOUT_CACHE_MAX_AGE == 0 ) {
+		for ( auto it = cache->entries.begin(); it != cache->entries.end(); ) {
+			if ( cache->current_frame - it->second.last_used_frame > layout_cache_t::LAYOUT_CACHE_MAX_AGE ) {
+				it = cache->entries.erase( it );
+			} else {
+				it++;
+			}
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+
+// Returns layout for string - from cache if possible. Layouts for fonts with dynamic atlases
+// are never cached, as glyphs may move within the atlas, and as laying out a string is what
+// keeps its glyphs from being evicted.
+static std::shared_ptr<string_layout_t const> le_font_renderer_get_string_layout( le_font_renderer_o* self, le_font_o* font, char const* str, float scale ) {
+
+	using namespace le_font;
+
+	bool const use_cache = !le_font_i.is_dynamic_atlas( font );
+
+	uint64_t key = 0;
+
+	if ( use_cache ) {
+		key = hash_64_fnv1a( str );
+
+		auto add_bytes_to_hash = [ & ]( void const* data, size_t num_bytes ) {
+			for ( auto c = static_cast<uint8_t const*>( data ); num_bytes--; c++ ) {
+				key = ( key ^ *c ) * FNV1A_PRIME_64_CONST;
+			}
+		};
+
+		add_bytes_to_hash( &font, sizeof( font ) );
+		add_bytes_to_hash( &scale, sizeof( scale ) );
+
+		auto&            cache = self->layout_cache;
+		std::scoped_lock lock( cache.mtx );
+
+		if ( auto it = cache.entries.find( key ); it != cache.entries.end() &&
+		                                          it->second.font == font &&
+		                                          it->second.scale == scale &&
+		                                          it->second.str == str ) {
+			it->second.last_used_frame = cache.current_frame;
+			return it->second.layout;
+		}
+	}
+
+	// ----------| invariant: layout was not found in cache
+
+	auto layout = std::make_shared<string_layout_t>();
+
+	float x = 0;
+	float y = 0;
+
+	size_t num_vertices = le_font_i.draw_utf8_string_scaled( font, str, scale, nullptr, nullptr, nullptr, 0, 0 );
+	layout->vertices.resize( num_vertices );
+	num_vertices = le_font_i.draw_utf8_string_scaled( font, str, scale, &x, &y, layout->vertices.data(), num_vertices, 0 );
+	layout->vertices.resize( num_vertices ); // glyphs which are not available don't produce vertices
+
+	layout->advance_x = x;
+	layout->advance_y = y;
+
+	if ( use_cache ) {
+		auto&            cache = self->layout_cache;
+		std::scoped_lock lock( cache.mtx );
+		cache.entries[ key ] = { layout, str, font, scale, cache.current_frame };
+	}
+
+	return layout;
+}
+
+// ----------------------------------------------------------------------
+
 bool le_font_renderer_setup_resources( le_font_renderer_o* self, le_rendergraph_o* module ) {
 
+	layout_cache_next_frame( &self->layout_cache );
+
+	for ( auto& fnt : self->fonts_info ) {
+		le_font::le_font_i.begin_atlas_frame( fnt.font, fnt.atlas_consumer );
+	}
+
 	auto resource_upload_pass =
 	    le::RenderPass( "uploadImage", le::QueueFlagBits::eTransfer )
 	        .setSetupCallback( self, []( le_renderpass_o* rp_, void* user_data ) -> bool {
@@ -129,9 +271,20 @@ bool le_font_renderer_setup_resources( le_font_renderer_o* self, le_rendergraph_
 		        auto self         = static_cast<le_font_renderer_o*>( user_data );
 		        bool needs_upload = false; // If any atlasses need upload this must flip to true.
 
+		        using namespace le_font;
+
 		        for ( auto& fnt : self->fonts_info ) {
 			        rp.useImageResource( fnt.font_image, le::ImageUsageFlags( le::ImageUsageFlagBits::eTransferDst ) );
-			        needs_upload |= !fnt.atlas_uploaded;
+
+			        // We keep changed regions until they have been uploaded - this pass may not
+			        // get executed if no other pass uses any font image in this frame.
+			        le_font_api::atlas_region_t const* regions;
+			        size_t                              num_regions;
+			        if ( le_font_i.take_atlas_dirty_regions( fnt.font, fnt.atlas_consumer, &regions, &num_regions ) ) {
+				        fnt.pending_regions.insert( fnt.pending_regions.end(), regions, regions + num_regions );
+			        }
+
+			        needs_upload |= !fnt.pending_regions.empty();
 		        }
 
 		        return needs_upload;
@@ -141,23 +294,27 @@ bool le_font_renderer_setup_resources( le_font_renderer_o* self, le_rendergraph_
 
 		        le::Encoder encoder{ encoder_ };
 
+		        using namespace le_font;
+
 		        for ( auto& fnt : self->fonts_info ) {
 
-			        if ( fnt.atlas_uploaded ) {
-				        continue;
-			        }
+			        // Upload only regions of the atlas which have changed.
 
-			        auto write_settings = le::WriteToImageSettingsBuilder().build();
+			        for ( auto const& r : fnt.pending_regions ) {
 
-			        using namespace le_font;
+				        auto write_settings     = le::WriteToImageSettingsBuilder().build();
+				        write_settings.image_w  = r.width;
+				        write_settings.image_h  = r.height;
+				        write_settings.offset_x = int32_t( r.x );
+				        write_settings.offset_y = int32_t( r.y );
 
-			        uint8_t const* pixels_data;
-			        uint32_t       pix_stride;
-			        le_font_i.get_atlas( fnt.font, &pixels_data, &write_settings.image_w, &write_settings.image_h, &pix_stride );
+				        self->upload_scratch.resize( size_t( r.width ) * r.height );
+				        le_font_i.copy_atlas_region( fnt.font, &r, self->upload_scratch.data() );
 
-			        encoder.writeToImage( fnt.font_image, write_settings, pixels_data, pix_stride * write_settings.image_w * write_settings.image_h );
+				        encoder.writeToImage( fnt.font_image, write_settings, self->upload_scratch.data(), self->upload_scratch.size() );
+			        }
 
-			        fnt.atlas_uploaded = true;
+			        fnt.pending_regions.clear();
 		        }
 	        } );
 
@@ -227,27 +384,40 @@ bool le_font_renderer_draw_string( le_font_renderer_o* self, le_font_o* font, le
 	        .addShaderStage( self->shader_font_frag )
 	        .build();
 
+	static auto pipeline_sdf =
+	    LeGraphicsPipelineBuilder( encoder.getPipelineManager() )
+	        .addShaderStage( self->shader_font_vert )
+	        .addShaderStage( self->shader_font_frag_sdf )
+	        .build();
+
 	using namespace le_font;
 
-	size_t                 num_vertices = le_font_i.draw_utf8_string( font, info.str, nullptr, nullptr, nullptr, 0, 0 );
-	std::vector<glm::vec4> vertices;
+	// Only fonts with an sdf atlas will look crisp when drawn at a size other than their own font size.
+	float const scale = info.font_size > 0.f ? info.font_size / le_font_i.get_font_size( font ) : 1.f;
 
-	vertices.resize( num_vertices );
-	le_font_i.draw_utf8_string( font, info.str, &info.x, &info.y, vertices.data(), num_vertices, 0 );
+	auto layout = le_font_renderer_get_string_layout( self, font, info.str, scale );
+
+	if ( layout->vertices.empty() ) {
+		return true;
+	}
 
 	struct NoMvpUbo {
 		glm::vec4 screen_extents;
 	} no_mvp_ubo;
 
-	no_mvp_ubo.screen_extents = { 0, 0, float( extents.width ), float( extents.height ) };
+	// Layouts are relative to the origin - we use the offset in screen extents to place the string.
+	no_mvp_ubo.screen_extents = { info.x, info.y, float( extents.width ), float( extents.height ) };
+
+	info.x += layout->advance_x;
+	info.y += layout->advance_y;
 
 	encoder
-	    .bindGraphicsPipeline( pipeline )
+	    .bindGraphicsPipeline( le_font_i.is_sdf_atlas( font ) ? pipeline_sdf : pipeline )
 	    .setArgumentData( LE_ARGUMENT_NAME( "Extents" ), &no_mvp_ubo, sizeof( NoMvpUbo ) ) //
-	    .setVertexData( vertices.data(), sizeof( glm::vec4 ) * vertices.size(), 0 )
+	    .setVertexData( layout->vertices.data(), sizeof( glm::vec4 ) * layout->vertices.size(), 0 )
 	    .setArgumentTexture( LE_ARGUMENT_NAME( "tex_unit_0" ), le_font_renderer_get_font_image_sampler( self, font ) )
 	    .setArgumentData( LE_ARGUMENT_NAME( "VertexColor" ), &info.color, sizeof( info.color ) )
-	    .draw( uint32_t( vertices.size() ) ) //
+	    .draw( uint32_t( layout->vertices.size() ) ) //
 	    ;
 
 	return true;
@@ -255,6 +425,125 @@ bool le_font_renderer_draw_string( le_font_renderer_o* self, le_font_o* font, le
 
 // ----------------------------------------------------------------------
 
+// Draws many strings at once: vertices for all strings are written into a single vertex buffer,
+// and we issue one draw call per font. Strings are grouped by font, which means that strings
+// drawn with different fonts may not overlap in the order in which they were given.
+//
+// We can't merge draws across fonts: each font has its own atlas image, which we bind as an
+// argument for each draw, and sdf fonts need a different pipeline than coverage fonts. Merging
+// would need all fonts to share one atlas, or a texture array - callers who want one draw call
+// should use a single font, and vary `font_size` instead (best with an sdf atlas).
+//
+// Updates `.x` and `.y` for each element of `infos` to the pen position after drawing the string.
+bool le_font_renderer_draw_strings( le_font_renderer_o* self, le_command_buffer_encoder_o* encoder_, le_font_o** fonts, draw_string_info_t* infos, size_t num_strings ) {
+
+	if ( num_strings == 0 ) {
+		return true;
+	}
+
+	le::Encoder encoder{ encoder_ };
+
+	auto extents = encoder.getRenderpassExtent();
+
+	struct BatchVertex {
+		glm::vec4 pos_tex; // x/y position, s/t texture coordinates
+		glm::vec4 color;
+	};
+
+	auto build_pipeline = []( le_pipeline_manager_o* pm, le_shader_module_handle vert, le_shader_module_handle frag ) {
+		// clang-format off
+		return LeGraphicsPipelineBuilder( pm )
+		    .addShaderStage( vert )
+		    .addShaderStage( frag )
+		    .withAttributeBindingState()
+		        .addBinding( sizeof( BatchVertex ) )
+		            .setInputRate( le_vertex_input_rate::ePerVertex )
+		            .addAttribute( offsetof( BatchVertex, pos_tex ), le_num_type::eF32, 4 )
+		            .addAttribute( offsetof( BatchVertex, color ), le_num_type::eF32, 4 )
+		        .end()
+		    .end()
+		    .build();
+		// clang-format on
+	};
+
+	static auto pipeline     = build_pipeline( encoder.getPipelineManager(), self->shader_font_vert_batch, self->shader_font_frag_batch );
+	static auto pipeline_sdf = build_pipeline( encoder.getPipelineManager(), self->shader_font_vert_batch, self->shader_font_frag_sdf_batch );
+
+	using namespace le_font;
+
+	// Sort string indices by font, keeping the original order for strings which share a font.
+
+	std::vector<uint32_t> order( num_strings );
+	for ( uint32_t i = 0; i != num_strings; i++ ) {
+		order[ i ] = i;
+	}
+	std::stable_sort( order.begin(), order.end(), [ & ]( uint32_t lhs, uint32_t rhs ) { return fonts[ lhs ] < fonts[ rhs ]; } );
+
+	// Gather vertices for all strings into one buffer, and note where each font's range begins.
+
+	struct font_range_t {
+		le_font_o* font;
+		uint32_t   first_vertex;
+		uint32_t   num_vertices;
+	};
+
+	std::vector<BatchVertex>  vertices;
+	std::vector<font_range_t> font_ranges;
+
+	for ( auto const& i : order ) {
+		auto&       info  = infos[ i ];
+		float const scale = info.font_size > 0.f ? info.font_size / le_font_i.get_font_size( fonts[ i ] ) : 1.f;
+
+		auto layout = le_font_renderer_get_string_layout( self, fonts[ i ], info.str, scale );
+
+		if ( font_ranges.empty() || font_ranges.back().font != fonts[ i ] ) {
+			font_ranges.push_back( { fonts[ i ], uint32_t( vertices.size() ), 0 } );
+		}
+
+		glm::vec4 const offset{ info.x, info.y, 0, 0 };
+		glm::vec4 const color{ info.color.r, info.color.g, info.color.b, info.color.a };
+
+		for ( auto const& v : layout->vertices ) {
+			vertices.push_back( { v + offset, color } );
+		}
+
+		font_ranges.back().num_vertices += uint32_t( layout->vertices.size() );
+
+		info.x += layout->advance_x;
+		info.y += layout->advance_y;
+	}
+
+	if ( vertices.empty() ) {
+		return true;
+	}
+
+	struct NoMvpUbo {
+		glm::vec4 screen_extents;
+	} no_mvp_ubo;
+
+	no_mvp_ubo.screen_extents = { 0, 0, float( extents.width ), float( extents.height ) };
+
+	// Vertex data for all strings is uploaded once - draws pick their range via first vertex.
+
+	encoder.setVertexData( vertices.data(), sizeof( BatchVertex ) * vertices.size(), 0 );
+
+	for ( auto const& r : font_ranges ) {
+		if ( r.num_vertices == 0 ) {
+			continue;
+		}
+		encoder
+		    .bindGraphicsPipeline( le_font_i.is_sdf_atlas( r.font ) ? pipeline_sdf : pipeline )
+		    .setArgumentData( LE_ARGUMENT_NAME( "Extents" ), &no_mvp_ubo, sizeof( NoMvpUbo ) ) //
+		    .setArgumentTexture( LE_ARGUMENT_NAME( "tex_unit_0" ), le_font_renderer_get_font_image_sampler( self, r.font ) )
+		    .draw( r.num_vertices, 1, r.first_vertex, 0 ) //
+		    ;
+	}
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+
 LE_MODULE_REGISTER_IMPL( le_font_renderer, api ) {
 	auto& i = static_cast<le_font_renderer_api*>( api )->le_font_renderer_i;
 
@@ -267,4 +556,5 @@ LE_MODULE_REGISTER_IMPL( le_font_renderer, api ) {
 	i.get_font_image         = le_font_renderer_get_font_image;
 	i.get_font_image_sampler = le_font_renderer_get_font_image_sampler;
 	i.draw_string            = le_font_renderer_draw_string;
+	i.draw_strings           = le_font_renderer_draw_strings;
 }
@@ -26,6 +26,7 @@ struct le_font_renderer_api {
 			float b;
 			float a;
 		} color;
+		float font_size = 0; // optional: size in pixels - if 0, text is drawn at the font's own size
 	};
 
 	struct le_font_renderer_interface_t {
@@ -40,6 +41,11 @@ struct le_font_renderer_api {
 
 		bool (*draw_string)( le_font_renderer_o* self, le_font_o* font, le_command_buffer_encoder_o* encoder, draw_string_info_t  & info );
 
+		// Draws `num_strings` strings, where string at index i uses font `fonts[i]`, using one vertex buffer, and one draw call
+		// per font - each font samples its own atlas, so draws can't be merged across fonts. Layouts for strings which did not
+		// change since the last frame are taken from cache.
+		bool (*draw_strings)( le_font_renderer_o* self, le_command_buffer_encoder_o* encoder, le_font_o** fonts, draw_string_info_t* infos, size_t num_strings );
+
 		le_texture_handle      (* get_font_image_sampler )( le_font_renderer_o* self, le_font_o* font );
 		le_img_resource_handle (* get_font_image         )( le_font_renderer_o* self, le_font_o* font );
 
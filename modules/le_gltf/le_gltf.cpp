@@ -4,15 +4,33 @@
 #include "3rdparty/cgltf/cgltf.h"
 #include "le_stage.h"
 #include "le_stage_types.h"
+#include "le_jobs.h"
+#include "le_log.h"
 
 #include <vector>
 #include <string>
 #include <unordered_map>
 #include "string.h" // for memcpy
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <filesystem>
 #include <iostream>
 #include <iomanip>
 
+#ifdef _WIN32
+#	define WIN32_LEAN_AND_MEAN
+#	define NOMINMAX // we do this so that Windows.h does not define min and max macros
+#	include <windows.h> // for memory-mapped files
+#else
+#	include <fcntl.h>    // for memory-mapped files
+#	include <sys/mman.h> //
+#	include <sys/stat.h> //
+#	include <unistd.h>   //
+#endif
+
+static constexpr auto LOGGER_LABEL = "le_gltf";
+
 #define GLM_FORCE_RIGHT_HANDED // glTF uses right handed coordinate system, and we're following its lead.
 #define GLM_ENABLE_EXPERIMENTAL
 #include "glm/glm.hpp"
@@ -46,11 +64,127 @@ How to use this library:
 // when you create a mesh, you do it through the stage - which manages/stores the data for that mesh
 // the stage may also optimise data
 
+// ----------------------------------------------------------------------
+/// \brief   read-only, memory-mapped view of a file, shared by reference count
+/// \details A mapping is referenced by the le_gltf object which mapped it, and by
+///          any stage buffers which point into it - so that stage may upload from
+///          the mapping even if the le_gltf object gets destroyed right after import.
+struct le_gltf_mapping_o {
+	char*                 data = nullptr;
+	size_t                size = 0;
+	std::atomic<uint32_t> ref_count{ 1 };
+#ifdef _WIN32
+	HANDLE file    = INVALID_HANDLE_VALUE;
+	HANDLE mapping = nullptr;
+#endif
+};
+
+// ----------------------------------------------------------------------
+
+static void mapping_destroy( le_gltf_mapping_o* self ) {
+#ifdef _WIN32
+	if ( self->data ) {
+		UnmapViewOfFile( self->data );
+	}
+	if ( self->mapping ) {
+		CloseHandle( self->mapping );
+	}
+	if ( self->file != INVALID_HANDLE_VALUE ) {
+		CloseHandle( self->file );
+	}
+#else
+	if ( self->data ) {
+		munmap( self->data, self->size );
+	}
+#endif
+	delete self;
+}
+
+// ----------------------------------------------------------------------
+/// \return nullptr if file could not be mapped, otherwise a mapping with a reference count of 1
+static le_gltf_mapping_o* mapping_create( char const* file_path ) {
+
+	auto self = new le_gltf_mapping_o{};
+
+#ifdef _WIN32
+	self->file = CreateFileA( file_path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+
+	LARGE_INTEGER file_size{};
+
+	if ( self->file == INVALID_HANDLE_VALUE ||
+	     !GetFileSizeEx( self->file, &file_size ) ||
+	     file_size.QuadPart == 0 ) {
+		mapping_destroy( self );
+		return nullptr;
+	}
+
+	self->mapping = CreateFileMappingA( self->file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+	self->data    = self->mapping ? static_cast<char*>( MapViewOfFile( self->mapping, FILE_MAP_READ, 0, 0, 0 ) ) : nullptr;
+
+	if ( self->data == nullptr ) {
+		mapping_destroy( self );
+		return nullptr;
+	}
+
+	self->size = size_t( file_size.QuadPart );
+#else
+	int fd = open( file_path, O_RDONLY );
+
+	if ( fd == -1 ) {
+		mapping_destroy( self );
+		return nullptr;
+	}
+
+	struct stat file_stat {};
+
+	if ( fstat( fd, &file_stat ) == -1 || file_stat.st_size == 0 ) {
+		close( fd );
+		mapping_destroy( self );
+		return nullptr;
+	}
+
+	void* data = mmap( nullptr, size_t( file_stat.st_size ), PROT_READ, MAP_PRIVATE, fd, 0 );
+	close( fd ); // mapping keeps the file open for as long as it is needed
+
+	if ( data == MAP_FAILED ) {
+		mapping_destroy( self );
+		return nullptr;
+	}
+
+	// Buffers are read front-to-back when they are uploaded - ask the OS to start reading now.
+	madvise( data, size_t( file_stat.st_size ), MADV_WILLNEED );
+
+	self->data = static_cast<char*>( data );
+	self->size = size_t( file_stat.st_size );
+#endif
+
+	return self;
+}
+
+// ----------------------------------------------------------------------
+
+static void mapping_retain( le_gltf_mapping_o* self ) {
+	self->ref_count.fetch_add( 1, std::memory_order_relaxed );
+}
+
+// ----------------------------------------------------------------------
+/// \note Signature matches stage buffer `release_fn`, may be called from any thread.
+static void mapping_release( void* user_data ) {
+	auto self = static_cast<le_gltf_mapping_o*>( user_data );
+	if ( 1 == self->ref_count.fetch_sub( 1, std::memory_order_acq_rel ) ) {
+		mapping_destroy( self );
+	}
+}
+
+// ----------------------------------------------------------------------
+
 struct le_gltf_o {
-	cgltf_options         options = {};
-	cgltf_data*           data    = nullptr;
-	cgltf_result          result  = {};
-	std::filesystem::path gltf_file_path; // owning
+	cgltf_options                   options = {};
+	cgltf_data*                     data    = nullptr;
+	cgltf_result                    result  = {};
+	std::filesystem::path           gltf_file_path; // owning
+	std::vector<le_gltf_mapping_o*> mappings;       // gltf/glb file, and any external buffer files; we hold one reference to each
+	double                          parse_ms = 0;   // time spent mapping, and parsing files in create, for instrumentation
 };
 
 // ----------------------------------------------------------------------
@@ -58,8 +192,13 @@ struct le_gltf_o {
 static void le_gltf_destroy( le_gltf_o* self ) {
 	if ( self ) {
 		if ( self->data ) {
+			// Note that buffers which point into our mappings were marked as
+			// not-to-be-freed by cgltf, so this only frees cgltf's own allocations.
 			cgltf_free( self->data );
 		}
+		for ( auto& m : self->mappings ) {
+			mapping_release( m );
+		}
 		delete self;
 	}
 }
@@ -70,33 +209,145 @@ static le_gltf_o* le_gltf_create( char const* path ) {
 
 	assert( path && "valid path must be set" );
 
-	auto self    = new le_gltf_o{};
-	self->result = cgltf_parse_file( &self->options, path, &self->data );
+	static auto logger = LeLog( LOGGER_LABEL );
+
+	auto self       = new le_gltf_o{};
+	auto time_start = std::chrono::steady_clock::now();
+
+	self->gltf_file_path = std::filesystem::path{ path };
+
+	// We memory-map the gltf (or glb) file instead of reading it into memory:
+	// for .glb files, cgltf will point buffer 0 directly into the mapping.
+
+	le_gltf_mapping_o* file_mapping = mapping_create( path );
+
+	if ( file_mapping ) {
+		self->mappings.push_back( file_mapping );
+		self->result = cgltf_parse( &self->options, file_mapping->data, file_mapping->size, &self->data );
+	} else {
+		self->result = cgltf_result_file_not_found;
+	}
 
 	if ( self->result == cgltf_result_success ) {
 
-		// This will load buffers from file, or data URIs,
+		// Memory-map external buffer files - cgltf will not load any buffers which
+		// already have their data set, and won't free data which it does not own.
+
+		cgltf_buffer* buffers_begin = self->data->buffers;
+		auto          buffers_end   = buffers_begin + self->data->buffers_count;
+
+		for ( auto b = buffers_begin; b != buffers_end; b++ ) {
+
+			if ( b->data || nullptr == b->uri || 0 == strncmp( b->uri, "data:", 5 ) ) {
+				continue;
+			}
+
+			std::filesystem::path buffer_path{ b->uri };
+
+			if ( buffer_path.is_relative() ) {
+				buffer_path = self->gltf_file_path.parent_path() / buffer_path;
+			}
+
+			le_gltf_mapping_o* buffer_mapping = mapping_create( buffer_path.string().c_str() );
+
+			if ( nullptr == buffer_mapping ) {
+				// Leave it to cgltf to load this buffer - it knows how to decode escaped uris.
+				continue;
+			}
+
+			if ( buffer_mapping->size < b->size ) {
+				logger.error( "Buffer file '%s' is smaller than the %zu bytes declared in '%s'", buffer_path.string().c_str(), size_t( b->size ), path );
+				mapping_release( buffer_mapping );
+				continue;
+			}
+
+			self->mappings.push_back( buffer_mapping );
+			b->data             = buffer_mapping->data;
+			b->data_free_method = cgltf_data_free_method_none;
+		}
+
+		// This will load any remaining buffers from data URIs, or from files we could not map,
 		// and will allocate memory inside the cgltf module.
 		//
 		// Memory will be freed when calling `cgltf_free(self->data)`
 		cgltf_result buffer_load_result = cgltf_load_buffers( &self->options, self->data, path );
 
 		if ( buffer_load_result != cgltf_result_success ) {
+			logger.error( "Could not load buffers for file at path: '%s'", path );
 			le_gltf_destroy( self );
 			return nullptr;
 		}
 
 	} else {
-		std::cerr << "ERROR: could not load or parse file at path :'" << path << "'" << std::flush;
+		logger.error( "Could not load or parse file at path: '%s'", path );
 		le_gltf_destroy( self );
 		return nullptr;
 	}
 
-	self->gltf_file_path = std::filesystem::path{ path };
+	self->parse_ms = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - time_start ).count();
 
 	return self;
 }
 
+// ----------------------------------------------------------------------
+/// \return mapping which holds all `size` bytes at `data`, or nullptr if data is not memory-mapped
+static le_gltf_mapping_o* le_gltf_find_mapping( le_gltf_o const* self, void const* data, size_t size ) {
+	auto ptr = static_cast<char const*>( data );
+	for ( auto& m : self->mappings ) {
+		if ( ptr >= m->data && ptr + size <= m->data + m->size ) {
+			return m;
+		}
+	}
+	return nullptr;
+}
+
+// ----------------------------------------------------------------------
+// Image files are read on le_jobs worker threads, while buffers and accessors
+// get imported on the calling thread. Decoding happens later, asynchronously,
+// inside stage.
+
+struct image_file_read_t {
+	std::string path;
+	void*       data = nullptr; // allocated via malloc, nullptr if file could not be read
+	size_t      size = 0;
+};
+
+struct image_file_read_job_t {
+	image_file_read_t* reads_begin;
+	image_file_read_t* reads_end;
+};
+
+static void image_file_read( image_file_read_t* self ) {
+
+	FILE* file = fopen( self->path.c_str(), "rb" );
+
+	if ( nullptr == file ) {
+		return;
+	}
+
+	fseek( file, 0, SEEK_END );
+	long tell_sz = ftell( file );
+	rewind( file );
+
+	if ( tell_sz > 0 ) {
+		self->size = size_t( tell_sz );
+		self->data = malloc( self->size );
+		if ( self->data && fread( self->data, 1, self->size, file ) != self->size ) {
+			free( self->data );
+			self->data = nullptr;
+		}
+	}
+
+	fclose( file );
+}
+
+static void image_file_read_job_run( void* param ) {
+	auto job = static_cast<image_file_read_job_t const*>( param );
+	for ( auto r = job->reads_begin; r != job->reads_end; r++ ) {
+		image_file_read( r );
+	}
+}
+
 static le_buffer_view_type get_le_buffer_view_type_from_cgltf( cgltf_buffer_view_type const& tp ) {
 
 	// clang-format off
@@ -265,112 +516,81 @@ static bool le_gltf_import( le_gltf_o* self, le_stage_o* stage ) {
 
 	using namespace le_stage;
 
-	{
-		// Upload image data.
+	static auto logger = LeLog( LOGGER_LABEL );
 
-		// Note that we don't decode image data - we read in the image data but don't decode it yet - this is for the
-		// stage to do. We don't do this here because we don't want to allocate memory to store the decoded image twice.
+	// Instrumentation: we measure the time spent in each phase of the import.
 
-		// If we decoded the image inside this module, we would have to copy the decoded memory across the api boundary.
-		// We must copy because we cannot otherwise guarantee that the image data will still be available when stage
-		// uploads it to the gpu, as the upload step happens in another method than the import step.
+	auto time_import_start = std::chrono::steady_clock::now();
+	auto time_phase_start  = time_import_start;
 
-		cgltf_image const* images_begin = self->data->images;
-		auto               images_end   = images_begin + self->data->images_count;
+	auto phase_ms = [ &time_phase_start ]() -> double {
+		auto   now    = std::chrono::steady_clock::now();
+		double result = std::chrono::duration<double, std::milli>( now - time_phase_start ).count();
+		time_phase_start = now;
+		return result;
+	};
 
-		for ( auto img = images_begin; img != images_end; img++ ) {
+	cgltf_image const* images_begin = self->data->images;
+	auto               images_end   = images_begin + self->data->images_count;
 
-			uint32_t stage_idx = 0;
-
-			// TODO: must check if uri is not a data uri!
-
-			if ( img->uri ) {
+	// -- Start reading image files on worker threads.
+	//
+	// We don't decode image data here - that's for the stage to do, as otherwise
+	// we would have to copy decoded images across the api boundary. Stage decodes
+	// images asynchronously, too.
 
-				// We need to know the file basename, because the file path is most likely relative.
+	std::vector<image_file_read_t>     image_file_reads;
+	std::vector<image_file_read_job_t> image_file_read_jobs;
+	std::vector<le_jobs::job_t>        jobs;
+	le_jobs::counter_t*                image_file_reads_counter = nullptr;
 
-				std::filesystem::path img_path{ img->uri };
+	for ( auto img = images_begin; img != images_end; img++ ) {
+		if ( img->uri ) {
+			// We need to know the file basename, because the file path is most likely relative.
+			std::filesystem::path img_path{ img->uri };
 
-				if ( img_path.is_relative() ) {
-					img_path = self->gltf_file_path.parent_path() / img_path;
-				}
-
-				stage_idx = le_stage_i.create_image_from_file_path( stage, img_path.c_str(), img->name ? img->name : img->uri, 0 );
-
-			} else if ( img->buffer_view && img->buffer_view->buffer && img->buffer_view->buffer->data ) {
-
-				unsigned char const* data = static_cast<unsigned char const*>( img->buffer_view->buffer->data );
-				data += img->buffer_view->offset;
-				size_t data_sz = img->buffer_view->size;
-				stage_idx      = le_stage_i.create_image_from_memory( stage, data, uint32_t( data_sz ), img->name ? img->name : img->uri, 0 );
-
-			} else {
-				assert( false && "image must either have inline data or provide an uri" );
+			if ( img_path.is_relative() ) {
+				img_path = self->gltf_file_path.parent_path() / img_path;
 			}
 
-			images_map.insert( { img, stage_idx } );
+			image_file_reads.push_back( { img_path.string() } );
 		}
 	}
 
 	{
+		uint32_t const num_reads   = uint32_t( image_file_reads.size() );
+		uint32_t const num_workers = le_jobs::get_worker_thread_count();
 
-		{
-			// Sampler used for textures which don't define a sampler.
-			// Spec says: "When undefined, a sampler with repeat wrapping and auto filtering should be used."
-			le_sampler_info_t default_sampler_info{};
-			default_sampler_info.addressModeU = le::SamplerAddressMode::eRepeat;
-			default_sampler_info.addressModeV = le::SamplerAddressMode::eRepeat;
+		// More than one file per job if there are many image files, as
+		// the job system can only hold a limited number of jobs at once.
+		uint32_t const num_jobs = num_workers ? std::min( num_reads, num_workers * 4 ) : 0;
 
-			default_sampler_idx = le_stage_i.create_sampler( stage, &default_sampler_info );
-		}
-
-		// Upload sampler information
-
-		cgltf_sampler* samplers_begin = self->data->samplers;
-		auto           samplers_end   = samplers_begin + self->data->samplers_count;
-
-		for ( auto s = samplers_begin; s != samplers_end; s++ ) {
-			le_sampler_info_t info{};
+		if ( num_jobs ) {
+			image_file_read_jobs.resize( num_jobs );
+			jobs.resize( num_jobs );
 
-			info.addressModeU = cgltf_to_le_sampler_address_mode( s->wrap_s );
-			info.addressModeV = cgltf_to_le_sampler_address_mode( s->wrap_t );
-
-			// We assume that min and mag filter have the same values set for
-			// the Mipmap mode of their respective enums.
-			info.mipmapMode = cgltf_to_le_sampler_mipmap_mode( s->min_filter );
-
-			info.magFilter = cgltf_to_le_filter( s->mag_filter );
-			info.minFilter = cgltf_to_le_filter( s->min_filter );
-
-			// add sampler to stage
-			uint32_t stage_idx = le_stage_i.create_sampler( stage, &info );
-			samplers_map.insert( { s, stage_idx } );
-		}
-	}
-
-	{
-		// Upload texture information
-
-		cgltf_texture* textures_begin = self->data->textures;
-		auto           textures_end   = textures_begin + self->data->textures_count;
+			for ( uint32_t i = 0; i != num_jobs; i++ ) {
+				image_file_read_jobs[ i ] = { image_file_reads.data() + uint64_t( num_reads ) * i / num_jobs,
+				                              image_file_reads.data() + uint64_t( num_reads ) * ( i + 1 ) / num_jobs };
+				jobs[ i ]                 = { image_file_read_job_run, &image_file_read_jobs[ i ] };
+			}
 
-		for ( auto t = textures_begin; t != textures_end; t++ ) {
-			le_texture_info info;
-			if ( t->sampler ) {
-				info.sampler_idx = samplers_map.at( t->sampler );
-			} else {
-				// Note: Sampler is optional, GLTF spec says:
-				// "When undefined, a sampler with repeat wrapping and auto filtering should be used."
-				info.sampler_idx = default_sampler_idx;
+			le_jobs::run_jobs( jobs.data(), num_jobs, &image_file_reads_counter );
+		} else {
+			// No worker threads - we must read files right here.
+			for ( auto& r : image_file_reads ) {
+				image_file_read( &r );
 			}
-			info.image_idx     = images_map.at( t->image );
-			info.name          = t->image->name;
-			uint32_t stage_idx = le_stage_i.create_texture( stage, &info );
-			textures_map.insert( { t, stage_idx } );
 		}
 	}
 
+	double const ms_image_reads_start = phase_ms();
+
 	{
 		// Upload buffers
+		//
+		// Buffers which live in memory-mapped files are not copied - stage refers directly to
+		// the mapping, and keeps it alive until it has uploaded the buffer.
 
 		cgltf_buffer const* buffers_begin = self->data->buffers;
 		auto                buffers_end   = self->data->buffers + self->data->buffers_count;
@@ -380,7 +600,17 @@ static bool le_gltf_import( le_gltf_o* self, le_stage_o* stage ) {
 		int i = 0;
 		for ( auto b = buffers_begin; b != buffers_end; b++, ++i ) {
 			snprintf( debug_name, 32, "glTF_buffer_%d", i );
-			uint32_t stage_idx = le_stage_i.create_buffer( stage, b->data, uint32_t( b->size ), debug_name );
+
+			uint32_t           stage_idx = 0;
+			le_gltf_mapping_o* mapping   = le_gltf_find_mapping( self, b->data, b->size );
+
+			if ( mapping ) {
+				mapping_retain( mapping );
+				stage_idx = le_stage_i.create_buffer_non_owning( stage, b->data, uint32_t( b->size ), debug_name, mapping_release, mapping );
+			} else {
+				stage_idx = le_stage_i.create_buffer( stage, b->data, uint32_t( b->size ), debug_name );
+			}
+
 			buffer_map.insert( { b, stage_idx } );
 		}
 	}
@@ -442,6 +672,112 @@ static bool le_gltf_import( le_gltf_o* self, le_stage_o* stage ) {
 		}
 	}
 
+	double const ms_buffers = phase_ms();
+
+	if ( image_file_reads_counter ) {
+		le_jobs::wait_for_counter_and_free( image_file_reads_counter, 0 );
+	}
+
+	double const ms_image_reads_wait = phase_ms();
+
+	{
+		// Upload image data - stage starts decoding images as soon as they are handed over.
+
+		auto file_read = image_file_reads.begin();
+
+		for ( auto img = images_begin; img != images_end; img++ ) {
+
+			uint32_t stage_idx = 0;
+
+			// TODO: must check if uri is not a data uri!
+
+			if ( img->uri ) {
+
+				if ( file_read->data ) {
+					stage_idx = le_stage_i.create_image_from_memory( stage, static_cast<unsigned char const*>( file_read->data ), uint32_t( file_read->size ), img->name ? img->name : img->uri, 0 );
+					free( file_read->data );
+				} else {
+					logger.warn( "Could not read image file '%s'", file_read->path.c_str() );
+					stage_idx = le_stage_i.create_image_from_file_path( stage, file_read->path.c_str(), img->name ? img->name : img->uri, 0 );
+				}
+
+				file_read++;
+
+			} else if ( img->buffer_view && img->buffer_view->buffer && img->buffer_view->buffer->data ) {
+
+				unsigned char const* data = static_cast<unsigned char const*>( img->buffer_view->buffer->data );
+				data += img->buffer_view->offset;
+				size_t data_sz = img->buffer_view->size;
+				stage_idx      = le_stage_i.create_image_from_memory( stage, data, uint32_t( data_sz ), img->name ? img->name : img->uri, 0 );
+
+			} else {
+				assert( false && "image must either have inline data or provide an uri" );
+			}
+
+			images_map.insert( { img, stage_idx } );
+		}
+	}
+
+	{
+
+		{
+			// Sampler used for textures which don't define a sampler.
+			// Spec says: "When undefined, a sampler with repeat wrapping and auto filtering should be used."
+			le_sampler_info_t default_sampler_info{};
+			default_sampler_info.addressModeU = le::SamplerAddressMode::eRepeat;
+			default_sampler_info.addressModeV = le::SamplerAddressMode::eRepeat;
+
+			default_sampler_idx = le_stage_i.create_sampler( stage, &default_sampler_info );
+		}
+
+		// Upload sampler information
+
+		cgltf_sampler* samplers_begin = self->data->samplers;
+		auto           samplers_end   = samplers_begin + self->data->samplers_count;
+
+		for ( auto s = samplers_begin; s != samplers_end; s++ ) {
+			le_sampler_info_t info{};
+
+			info.addressModeU = cgltf_to_le_sampler_address_mode( s->wrap_s );
+			info.addressModeV = cgltf_to_le_sampler_address_mode( s->wrap_t );
+
+			// We assume that min and mag filter have the same values set for
+			// the Mipmap mode of their respective enums.
+			info.mipmapMode = cgltf_to_le_sampler_mipmap_mode( s->min_filter );
+
+			info.magFilter = cgltf_to_le_filter( s->mag_filter );
+			info.minFilter = cgltf_to_le_filter( s->min_filter );
+
+			// add sampler to stage
+			uint32_t stage_idx = le_stage_i.create_sampler( stage, &info );
+			samplers_map.insert( { s, stage_idx } );
+		}
+	}
+
+	{
+		// Upload texture information
+
+		cgltf_texture* textures_begin = self->data->textures;
+		auto           textures_end   = textures_begin + self->data->textures_count;
+
+		for ( auto t = textures_begin; t != textures_end; t++ ) {
+			le_texture_info info;
+			if ( t->sampler ) {
+				info.sampler_idx = samplers_map.at( t->sampler );
+			} else {
+				// Note: Sampler is optional, GLTF spec says:
+				// "When undefined, a sampler with repeat wrapping and auto filtering should be used."
+				info.sampler_idx = default_sampler_idx;
+			}
+			info.image_idx     = images_map.at( t->image );
+			info.name          = t->image->name;
+			uint32_t stage_idx = le_stage_i.create_texture( stage, &info );
+			textures_map.insert( { t, stage_idx } );
+		}
+	}
+
+	double const ms_images = phase_ms();
+
 	{
 		// Upload material info
 
@@ -546,6 +882,8 @@ static bool le_gltf_import( le_gltf_o* self, le_stage_o* stage ) {
 		}
 	}
 
+	double const ms_materials = phase_ms();
+
 	{
 		// Upload meshes
 
@@ -666,6 +1004,8 @@ static bool le_gltf_import( le_gltf_o* self, le_stage_o* stage ) {
 		}
 	}
 
+	double const ms_meshes = phase_ms();
+
 	{
 		// -- Upload cameras
 
@@ -944,6 +1284,8 @@ static bool le_gltf_import( le_gltf_o* self, le_stage_o* stage ) {
 		}
 	}
 
+	double const ms_nodes = phase_ms();
+
 	if ( self->data->animations_count ) {
 		// upload animations
 		// for each animation:
@@ -1050,6 +1392,18 @@ static bool le_gltf_import( le_gltf_o* self, le_stage_o* stage ) {
 		}
 	}
 
+	double const ms_animations_and_scenes = phase_ms();
+
+	logger.info( "Imported '%s' in %.2f ms (+ %.2f ms to parse)", self->gltf_file_path.string().c_str(),
+	             std::chrono::duration<double, std::milli>( time_phase_start - time_import_start ).count(), self->parse_ms );
+	logger.info( "\t%8.2f ms : images (%zu files read on worker threads, %.2f ms waiting for reads)",
+	             ms_image_reads_start + ms_image_reads_wait + ms_images, image_file_reads.size(), ms_image_reads_wait );
+	logger.info( "\t%8.2f ms : buffers, buffer views, accessors", ms_buffers );
+	logger.info( "\t%8.2f ms : materials", ms_materials );
+	logger.info( "\t%8.2f ms : meshes", ms_meshes );
+	logger.info( "\t%8.2f ms : cameras, lights, nodes, skins", ms_nodes );
+	logger.info( "\t%8.2f ms : animations, scenes", ms_animations_and_scenes );
+
 	return true;
 }
 
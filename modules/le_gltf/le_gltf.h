@@ -12,8 +12,13 @@ struct le_gltf_api {
 	
 	struct le_gltf_interface_t {
 
+		// Memory-maps the gltf/glb file, and any external buffer files.
 		le_gltf_o *     ( *create  ) ( char const * file_path );
 		void            ( *destroy ) ( le_gltf_o *self );
+
+		// Buffers are handed to stage as views into memory-mapped files: stage keeps mappings
+		// alive until it has uploaded them, so `self` may be destroyed right after import.
+		// Image files are read on le_jobs worker threads, if available. Logs time spent per phase.
 		bool            ( *import  ) ( le_gltf_o* self, le_stage_o* stage);
 
 	};
@@ -578,10 +578,20 @@ static void le_job_manager_run_jobs( le_job_o* jobs, uint32_t num_jobs, counter_
 
 // ----------------------------------------------------------------------
 
+static uint32_t le_job_manager_get_worker_thread_count() {
+	if ( nullptr == job_manager ) {
+		return 0;
+	}
+	return uint32_t( job_manager->worker_thread_count );
+}
+
+// ----------------------------------------------------------------------
+
 LE_MODULE_REGISTER_IMPL( le_jobs, api ) {
 
 	static_cast<le_jobs_api*>( api )->yield                     = le_fiber_yield;
 	static_cast<le_jobs_api*>( api )->get_current_worker_id     = get_current_worker_thread_id;
+	static_cast<le_jobs_api*>( api )->get_worker_thread_count   = le_job_manager_get_worker_thread_count;
 	static_cast<le_jobs_api*>( api )->run_jobs                  = le_job_manager_run_jobs;
 	static_cast<le_jobs_api*>( api )->initialize                = le_job_manager_initialize;
 	static_cast<le_jobs_api*>( api )->terminate                 = le_job_manager_terminate;
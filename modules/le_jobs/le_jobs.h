@@ -53,6 +53,10 @@ struct le_jobs_api {
 	// return id of current worker thread (0..MAX_THREADS), or -1 if called from outside job system.
 	int32_t (* get_current_worker_id)(void); 
 
+	// return number of worker threads, or 0 if the job system has not been initialised.
+	// modules which optionally parallelise work may use this to fall back to running serially.
+	uint32_t (* get_worker_thread_count)(void);
+
 };
 // clang-format on
 LE_MODULE( le_jobs );
@@ -74,6 +78,8 @@ static const auto& wait_for_counter_and_free = api -> wait_for_counter_and_free;
 static const auto& yield                 = api -> yield;
 static const auto& get_current_worker_id = api -> get_current_worker_id;
 
+static const auto& get_worker_thread_count = api -> get_worker_thread_count;
+
 } // namespace le_jobs
 
 #endif // __cplusplus
@@ -1,15 +1,31 @@
 #include "le_mesh.h"
 #include "le_core.h"
+#include "le_jobs.h"
 
 #include <math.h>
 #include <vector>
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <charconv>   // for parsing ascii numbers
 #include <filesystem> // for file loading
 #include <iostream>   // for file loading
-#include <fstream>    // for file loading
-#include <iomanip>    // for file loading
+#include <string_view>
 
 #include <cstring>
 
+#ifdef _WIN32
+#	define WIN32_LEAN_AND_MEAN
+#	define NOMINMAX // we do this so that Windows.h does not define min and max macros
+#	include <windows.h> // for memory-mapped files
+#else
+#	include <fcntl.h>    // for memory-mapped files
+#	include <sys/mman.h> //
+#	include <sys/stat.h> //
+#	include <unistd.h>   //
+#endif
+
 #include "le_mesh_types.h" //
 
 #ifdef _WIN32
@@ -39,6 +55,10 @@ static void le_mesh_clear( le_mesh_o* self ) {
 	self->tangents.clear();
 	self->colours.clear();
 	self->indices.clear();
+	self->indices_32.clear();
+	self->meshlets.clear();
+	self->meshlet_vertices.clear();
+	self->meshlet_triangles.clear();
 }
 
 // ----------------------------------------------------------------------
@@ -65,12 +85,16 @@ static void le_mesh_get_tangents( le_mesh_o* self, size_t* count, float const**
 
 // ----------------------------------------------------------------------
 
-static void le_mesh_get_indices( le_mesh_o* self, size_t* count, uint16_t const** indices ) {
+static void le_mesh_get_indices( le_mesh_o* self, size_t* count, void const** indices, le_mesh_api::IndexType* index_type ) {
+	bool const uses_32_bit_indices = !self->indices_32.empty();
 	if ( count ) {
-		*count = self->indices.size();
+		*count = uses_32_bit_indices ? self->indices_32.size() : self->indices.size();
 	}
 	if ( indices ) {
-		*indices = self->indices.data();
+		*indices = uses_32_bit_indices ? static_cast<void const*>( self->indices_32.data() ) : self->indices.data();
+	}
+	if ( index_type ) {
+		*index_type = uses_32_bit_indices ? le_mesh_api::eIndexTypeUint32 : le_mesh_api::eIndexTypeUint16;
 	}
 }
 
@@ -109,13 +133,12 @@ static void le_mesh_get_uvs( le_mesh_o* self, size_t* count, float const** uvs )
 
 // ----------------------------------------------------------------------
 
-static void le_mesh_get_data( le_mesh_o* self, size_t* numVertices, size_t* numIndices, float const** vertices, float const** normals, float const** uvs, float const** colours, uint16_t const** indices ) {
+static void le_mesh_get_data( le_mesh_o* self, size_t* numVertices, size_t* numIndices, float const** vertices, float const** normals, float const** uvs, float const** colours, void const** indices, le_mesh_api::IndexType* index_type ) {
 	if ( numVertices ) {
 		*numVertices = self->vertices.size();
 	}
-	if ( numIndices ) {
-		*numIndices = self->indices.size();
-	}
+
+	le_mesh_get_indices( self, numIndices, indices, index_type );
 
 	if ( vertices ) {
 		*vertices = self->vertices.empty() ? nullptr : static_cast<float const*>( &self->vertices[ 0 ].x );
@@ -132,53 +155,98 @@ static void le_mesh_get_data( le_mesh_o* self, size_t* numVertices, size_t* numI
 	if ( uvs ) {
 		*uvs = self->uvs.empty() ? nullptr : static_cast<float const*>( &self->uvs[ 0 ].x );
 	}
+}
 
-	if ( indices ) {
-		*indices = self->indices.data();
+// ----------------------------------------------------------------------
+/// \brief   read-only, memory-mapped view of a file
+/// \details pages are only read from disk once they are touched, and
+///          are shared with the OS file cache - there is no copy.
+struct MappedFile {
+	char const* data = nullptr;
+	size_t      size = 0;
+#ifdef _WIN32
+	HANDLE file    = INVALID_HANDLE_VALUE;
+	HANDLE mapping = nullptr;
+#endif
+};
+
+// ----------------------------------------------------------------------
+
+static void mapped_file_close( MappedFile* self ) {
+#ifdef _WIN32
+	if ( self->data ) {
+		UnmapViewOfFile( self->data );
+	}
+	if ( self->mapping ) {
+		CloseHandle( self->mapping );
+	}
+	if ( self->file != INVALID_HANDLE_VALUE ) {
+		CloseHandle( self->file );
 	}
+	self->mapping = nullptr;
+	self->file    = INVALID_HANDLE_VALUE;
+#else
+	if ( self->data ) {
+		munmap( const_cast<char*>( self->data ), self->size );
+	}
+#endif
+	self->data = nullptr;
+	self->size = 0;
 }
 
 // ----------------------------------------------------------------------
-/// \brief   file loader utility method
-/// \details loads file given by filepath and returns a vector of chars if successful
-/// \note    returns an empty vector if not successful
-static std::vector<char> load_file( const std::filesystem::path& file_path, bool* success ) {
+/// \return true upon success - in which case file must be closed via mapped_file_close
+static bool mapped_file_open( MappedFile* self, char const* file_path ) {
+#ifdef _WIN32
+	self->file = CreateFileA( file_path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
 
-	std::vector<char> contents;
+	LARGE_INTEGER file_size{};
+
+	if ( self->file == INVALID_HANDLE_VALUE ||
+	     !GetFileSizeEx( self->file, &file_size ) ||
+	     file_size.QuadPart == 0 ) {
+		mapped_file_close( self );
+		return false;
+	}
 
-	size_t        fileSize = 0;
-	std::ifstream file( file_path, std::ios::in | std::ios::binary | std::ios::ate );
+	self->mapping = CreateFileMappingA( self->file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+	self->data    = self->mapping ? static_cast<char const*>( MapViewOfFile( self->mapping, FILE_MAP_READ, 0, 0, 0 ) ) : nullptr;
 
-	if ( !file.is_open() ) {
-		std::cerr << "Unable to open file: " << std::filesystem::canonical( file_path ) << std::endl
-		          << std::flush;
-		*success = false;
-		return contents;
+	if ( self->data == nullptr ) {
+		mapped_file_close( self );
+		return false;
 	}
 
-	//	std::cout << "OK Opened file:" << std::filesystem::canonical( file_path ) << std::endl
-	//	          << std::flush;
+	self->size = size_t( file_size.QuadPart );
+	return true;
+#else
+	int fd = open( file_path, O_RDONLY );
 
-	// ----------| invariant: file is open
+	if ( fd == -1 ) {
+		return false;
+	}
 
-	auto endOfFilePos = file.tellg();
+	struct stat file_stat {};
 
-	if ( endOfFilePos > 0 ) {
-		fileSize = size_t( endOfFilePos );
-	} else {
-		*success = false;
-		return contents;
+	if ( fstat( fd, &file_stat ) == -1 || file_stat.st_size == 0 ) {
+		close( fd );
+		return false;
 	}
 
-	// ----------| invariant: file has some bytes to read
-	contents.resize( fileSize );
+	void* data = mmap( nullptr, size_t( file_stat.st_size ), PROT_READ, MAP_PRIVATE, fd, 0 );
+	close( fd ); // mapping stays valid once the file descriptor has been closed
 
-	file.seekg( 0, std::ios::beg );
-	file.read( contents.data(), endOfFilePos );
-	file.close();
+	if ( data == MAP_FAILED ) {
+		return false;
+	}
 
-	*success = true;
-	return contents;
+	// We are going to read all of the file - tell the OS to start reading ahead.
+	madvise( data, size_t( file_stat.st_size ), MADV_WILLNEED );
+
+	self->data = static_cast<char const*>( data );
+	self->size = size_t( file_stat.st_size );
+	return true;
+#endif
 }
 
 // ----------------------------------------------------------------------
@@ -189,444 +257,1662 @@ inline int does_start_with( char const* haystack, char const* needle, size_t& ne
 };
 
 // ----------------------------------------------------------------------
-/// \brief loads mesh from ply file
-/// \note any contents of mesh will be cleared before loading
-/// \return true upon success, false otherwise.
-static bool le_mesh_load_from_ply_file( le_mesh_o* self, char const* file_path_ ) {
 
-	// - Make sure file exists
-
-	std::filesystem::path file_path{ file_path_ };
+struct Property {
+
+	// data type for the property
+	enum class Type : uint8_t {
+		eUnknown,
+		eList,
+		eChar,   // int8
+		eUchar,  // uint8
+		eShort,  // int16
+		eUshort, // uint16
+		eInt,    // int32
+		eUint,   // uint32
+		eFloat,  // float32
+		eDouble, // float64
+	};
 
-	if ( !std::filesystem::exists( file_path ) ) {
-		std::cerr << "File not found: '" << file_path << "'";
-		return false;
-	}
+	// name for attribute in context of a mesh
+	enum class AttributeType : uint8_t {
+		eUnknown,
+		eVX,
+		eVY,
+		eVZ,
+		eNX,
+		eNY,
+		eNZ,
+		eTexU,
+		eTexV,
+		eColR,
+		eColG,
+		eColB,
+		eColA,
+	};
 
-	// --------| invariant: File path exists
+	Type          type              = Type::eUnknown;
+	AttributeType attribute_type    = AttributeType::eUnknown; // only used for attributes - not lists.
+	Type          list_size_type    = Type::eUnknown;          // only used for lists
+	Type          list_content_type = Type::eUnknown;          // only used for lists
+	char const*   name              = nullptr;
+	uint8_t       name_len          = 0; ///< number of chars for name (does not include \0)
+};
 
-	// - Build mesh attributes structure based on header.
+struct Element {
 
-	/*
-	 * element vertex structure: attribute index tells us where to store data which we parse
-	 */
-
-	struct Property {
-
-		// data type for the property
-		enum class Type : uint8_t {
-			eUnknown,
-			eList,
-			eFloat,
-			eUchar,
-			eUint,
-		};
-
-		// name for attribute in context of a mesh
-		enum class AttributeType : uint8_t {
-			eUnknown,
-			eVX,
-			eVY,
-			eVZ,
-			eNX,
-			eNY,
-			eNZ,
-			eTexU,
-			eTexV,
-			eColR,
-			eColG,
-			eColB,
-			eColA,
-		};
-
-		Type          type              = Type::eUnknown;
-		AttributeType attribute_type    = AttributeType::eUnknown; // only used for attributes - not lists.
-		Type          list_size_type    = Type::eUnknown;          // only used for lists
-		Type          list_content_type = Type::eUnknown;          // only used for lists
-		char const*   name              = nullptr;
-		uint8_t       name_len          = 0; ///< number of chars for name (does not include \0)
+	enum class Type : uint8_t {
+		eUnknown,
+		eVertex,
+		eFace,
 	};
+	char const*           name         = nullptr;
+	Type                  type         = Type::eUnknown;
+	uint8_t               name_len     = 0; ///< number of chars for name (does not include \0)
+	uint32_t              num_elements = 0;
+	std::vector<Property> properties;
+};
 
-	struct Element {
-
-		enum class Type : uint8_t {
-			eUnknown,
-			eVertex,
-			eFace,
-		};
-		char const*           name;
-		Type                  type;
-		uint8_t               name_len; ///< number of chars for name (does not include \0)
-		uint32_t              num_elements;
-		std::vector<Property> properties;
+// ----------------------------------------------------------------------
+/// \brief parses a property type name - a type name ends at the next space, or at the end of the string
+/// \return Type::eUnknown if type name was not recognised
+static Property::Type property_type_from_name( char const* c, size_t& name_len ) {
+
+	static constexpr struct {
+		char const*    name;
+		Property::Type type;
+	} TYPE_NAMES[] = {
+	    { "char", Property::Type::eChar },
+	    { "int8", Property::Type::eChar },
+	    { "uchar", Property::Type::eUchar },
+	    { "uint8", Property::Type::eUchar },
+	    { "short", Property::Type::eShort },
+	    { "int16", Property::Type::eShort },
+	    { "ushort", Property::Type::eUshort },
+	    { "uint16", Property::Type::eUshort },
+	    { "int", Property::Type::eInt },
+	    { "int32", Property::Type::eInt },
+	    { "uint", Property::Type::eUint },
+	    { "uint32", Property::Type::eUint },
+	    { "float", Property::Type::eFloat },
+	    { "float32", Property::Type::eFloat },
+	    { "double", Property::Type::eDouble },
+	    { "float64", Property::Type::eDouble },
 	};
 
-	// - Check that the header is correct (consistent, has minimum necessary attributes)
+	name_len = strcspn( c, " " );
 
-	// - Read file into memory
-	bool              file_load_success = true;
-	std::vector<char> file_data         = load_file( file_path, &file_load_success );
-
-	if ( !file_load_success ) {
-		std::cerr << "File could not be loaded: '" << file_path << "'";
-		return false;
+	for ( auto const& t : TYPE_NAMES ) {
+		if ( strlen( t.name ) == name_len && 0 == strncmp( c, t.name, name_len ) ) {
+			return t.type;
+		}
 	}
 
-	static auto DELIMS{ "\r\n\0" };
-	char*       c_save_ptr; //< we use the re-entrant version of strtok, for which state is stored in here
-
-	// --------| invariant: file was loaded.
+	return Property::Type::eUnknown;
+}
 
-	char* c = strtok_r( file_data.data(), DELIMS, &c_save_ptr );
+// ----------------------------------------------------------------------
+/// \return number of bytes used to store a value of the given type in a binary file, 0 for lists
+static uint32_t property_type_get_byte_count( Property::Type type ) {
+	switch ( type ) {
+	case Property::Type::eChar:   // intentional fall-through
+	case Property::Type::eUchar:  // intentional fall-through
+		return 1;
+	case Property::Type::eShort:  // intentional fall-through
+	case Property::Type::eUshort: // intentional fall-through
+		return 2;
+	case Property::Type::eInt:    // intentional fall-through
+	case Property::Type::eUint:   // intentional fall-through
+	case Property::Type::eFloat:  // intentional fall-through
+		return 4;
+	case Property::Type::eDouble:
+		return 8;
+	default:
+		return 0;
+	}
+}
 
-	if ( 0 != strcmp( c, "ply" ) ) {
-		std::cerr << "Invalid file header: '" << file_path << "'";
-		return false;
+// ----------------------------------------------------------------------
+/// \return smallest number of bytes a binary record for this element may take - lists count
+/// with their size field only, as they may be empty.
+static uint64_t element_get_min_binary_record_size( Element const& element ) {
+	uint64_t num_bytes = 0;
+	for ( auto const& p : element.properties ) {
+		num_bytes += property_type_get_byte_count( p.type == Property::Type::eList ? p.list_size_type : p.type );
 	}
+	return num_bytes;
+}
 
-	c = strtok_r( nullptr, DELIMS, &c_save_ptr );
+// ----------------------------------------------------------------------
+/// \return false if `num_bytes` can't possibly hold all records for element - we check
+/// this before we allocate anything based on element counts, which come from the file.
+static bool element_fits_into_bytes( Element const& element, size_t num_bytes, bool is_ascii ) {
+	// Ascii records take at least one byte each - their line break.
+	uint64_t const min_record_size = is_ascii ? 1 : element_get_min_binary_record_size( element );
+	return min_record_size * element.num_elements <= num_bytes;
+}
 
-	if ( 0 != strcmp( c, "format ascii 1.0" ) ) {
-		std::cerr << "Invalid file header: '" << file_path << "'";
-		return false;
+// ----------------------------------------------------------------------
+
+template <typename T>
+static inline T read_binary( char const* c, bool swap_bytes ) {
+	T value;
+	if ( swap_bytes ) {
+		char swapped[ sizeof( T ) ];
+		for ( size_t i = 0; i != sizeof( T ); i++ ) {
+			swapped[ i ] = c[ sizeof( T ) - 1 - i ];
+		}
+		memcpy( &value, swapped, sizeof( T ) );
+	} else {
+		memcpy( &value, c, sizeof( T ) );
 	}
+	return value;
+}
 
-	c = strtok_r( nullptr, DELIMS, &c_save_ptr );
+// ----------------------------------------------------------------------
 
-	// Parse header data into a vector of Element
-	std::vector<Element> elements;
+static double read_binary_as_double( char const* c, Property::Type type, bool swap_bytes ) {
+	// clang-format off
+	switch ( type ) {
+	case Property::Type::eChar   : return read_binary<int8_t>  ( c, swap_bytes );
+	case Property::Type::eUchar  : return read_binary<uint8_t> ( c, swap_bytes );
+	case Property::Type::eShort  : return read_binary<int16_t> ( c, swap_bytes );
+	case Property::Type::eUshort : return read_binary<uint16_t>( c, swap_bytes );
+	case Property::Type::eInt    : return read_binary<int32_t> ( c, swap_bytes );
+	case Property::Type::eUint   : return read_binary<uint32_t>( c, swap_bytes );
+	case Property::Type::eFloat  : return read_binary<float>   ( c, swap_bytes );
+	case Property::Type::eDouble : return read_binary<double>  ( c, swap_bytes );
+	default                      : return 0;
+	}
+	// clang-format on
+}
 
-	for ( ; c != nullptr; c = strtok_r( nullptr, DELIMS, &c_save_ptr ) ) {
+// ----------------------------------------------------------------------
 
-		size_t last_search_string_len = 0;
+static int64_t read_binary_as_int( char const* c, Property::Type type, bool swap_bytes ) {
+	// clang-format off
+	switch ( type ) {
+	case Property::Type::eChar   : return read_binary<int8_t>  ( c, swap_bytes );
+	case Property::Type::eUchar  : return read_binary<uint8_t> ( c, swap_bytes );
+	case Property::Type::eShort  : return read_binary<int16_t> ( c, swap_bytes );
+	case Property::Type::eUshort : return read_binary<uint16_t>( c, swap_bytes );
+	case Property::Type::eInt    : return read_binary<int32_t> ( c, swap_bytes );
+	case Property::Type::eUint   : return read_binary<uint32_t>( c, swap_bytes );
+	case Property::Type::eFloat  : return int64_t( read_binary<float>   ( c, swap_bytes ) );
+	case Property::Type::eDouble : return int64_t( read_binary<double>  ( c, swap_bytes ) );
+	default                      : return 0;
+	}
+	// clang-format on
+}
 
-		if ( does_start_with( c, "comment", last_search_string_len ) ) {
-			// Anything after a comment will be ignored
-			continue;
-		}
+// ----------------------------------------------------------------------
+/// \brief skips whitespace (but not past `end`) and parses a number
+/// \return pointer past the number, or nullptr if no number could be parsed
+template <typename T>
+static inline char const* read_ascii( char const* c, char const* end, T& value ) {
+	while ( c != end && ( *c == ' ' || *c == '\t' || *c == '\r' || *c == '\n' ) ) {
+		c++;
+	}
+	if ( c != end && *c == '+' ) {
+		c++; // from_chars does not accept a leading plus sign
+	}
+	auto [ ptr, ec ] = std::from_chars( c, end, value );
+	return ec == std::errc() ? ptr : nullptr;
+}
 
-		else if ( does_start_with( c, "element", last_search_string_len ) ) {
-			Element element;
+// ----------------------------------------------------------------------
 
-			// Note: This method replaces spaces between in-element tokens with \0 characters.
-			auto parse_element_line = []( char* c, Element& element ) -> bool {
-				element.name = c;
-				char* c_next = strchr( c, ' ' );
-				if ( c_next == nullptr ) {
-					// There must be a space character
-					assert( false );
-					return false;
-				}
-				*c_next          = 0; // insert an end-of-string token
-				element.name_len = uint8_t( c_next - c );
+static inline char const* read_ascii_as_double( char const* c, char const* end, Property::Type type, double& value ) {
+	if ( type == Property::Type::eFloat || type == Property::Type::eDouble ) {
+		return read_ascii( c, end, value );
+	}
+	int64_t int_value = 0;
+	c                 = read_ascii( c, end, int_value );
+	value             = double( int_value );
+	return c;
+}
 
-				if ( 0 == strncmp( element.name, "vertex", element.name_len ) ) {
-					element.type = Element::Type::eVertex;
-				} else if ( 0 == strncmp( element.name, "face", element.name_len ) ) {
-					element.type = Element::Type::eFace;
-				}
+// ----------------------------------------------------------------------
+/// \brief finds the start of each of the next `num_lines` lines of ascii element data
+/// \return pointer past the last line, or nullptr if there are not enough lines
+static char const* find_ascii_lines( char const* c, char const* end, uint32_t num_lines, std::vector<char const*>& line_starts ) {
 
-				c = c_next + 1; // adding one because we don't want the zero terminator.
+	if ( uint64_t( end - c ) < num_lines ) {
+		return nullptr; // each line takes at least one byte
+	}
 
-				element.num_elements = uint32_t( strtoul( c, nullptr, 0 ) );
-				return true;
-			};
+	line_starts.resize( size_t( num_lines ) + 1 );
 
-			c += last_search_string_len + 1;
+	for ( uint32_t i = 0; i != num_lines; i++ ) {
+		if ( c >= end ) {
+			return nullptr;
+		}
+		line_starts[ i ] = c;
+		auto line_end    = static_cast<char const*>( memchr( c, '\n', size_t( end - c ) ) );
+		c                = line_end ? line_end + 1 : end;
+	}
 
-			// fetch name of element, and count of elements
-			parse_element_line( c, element );
+	line_starts[ num_lines ] = c;
+	return c;
+}
 
-			elements.emplace_back( std::move( element ) );
+// ----------------------------------------------------------------------
+// Parsing large elements is split into chunks, which run on le_jobs worker
+// threads if the job system has been initialised.
 
-			continue;
-		}
+static constexpr uint32_t MIN_ELEMENTS_PER_CHUNK = 8192;
 
-		else if ( does_start_with( c, "property", last_search_string_len ) ) {
-			Property property;
+struct ChunkJob {
+	void ( *fun )( void* user_data, uint32_t chunk, uint32_t begin, uint32_t end );
+	void*    user_data;
+	uint32_t chunk;
+	uint32_t begin;
+	uint32_t end;
+};
 
-			// Note: this replaces spaces between in-element tokens with \0 characters.
-			auto parse_property_line = []( char* c, Property& property ) -> bool {
-				size_t last_search_string_len = 0;
+static uint32_t get_num_chunks( uint32_t num_elements ) {
+	uint32_t const num_workers = le_jobs::get_worker_thread_count();
+	if ( num_workers == 0 || num_elements < 2 * MIN_ELEMENTS_PER_CHUNK ) {
+		return 1;
+	}
+	return std::min( num_workers * 4, num_elements / MIN_ELEMENTS_PER_CHUNK );
+}
 
-				// now, we expect either list or [float|uchar] as property type
-				if ( does_start_with( c, "list", last_search_string_len ) ) {
-					c += last_search_string_len + 1;
-					property.type = Property::Type::eList;
+static void chunk_job_run( void* param ) {
+	auto job = static_cast<ChunkJob const*>( param );
+	job->fun( job->user_data, job->chunk, job->begin, job->end );
+}
 
-					// next item will be list size type
+static void run_chunks( uint32_t num_elements, uint32_t num_chunks, void* user_data,
+                        void ( *fun )( void* user_data, uint32_t chunk, uint32_t begin, uint32_t end ) ) {
 
-					if ( does_start_with( c, "uchar", last_search_string_len ) ) {
-						property.list_size_type = Property::Type::eUchar;
-						c += last_search_string_len + 1;
-					} else if ( does_start_with( c, "uint", last_search_string_len ) ) {
-						property.list_size_type = Property::Type::eUint;
-						c += last_search_string_len + 1;
-					} else {
-						std::cerr << "Unknown list size type: '" << c << "'" << std::endl
-						          << std::flush;
-						assert( false );
-					}
+	if ( num_chunks <= 1 ) {
+		fun( user_data, 0, 0, num_elements );
+		return;
+	}
 
-					// next item will be list content type
+	std::vector<ChunkJob>       chunk_jobs( num_chunks );
+	std::vector<le_jobs::job_t> jobs( num_chunks );
 
-					if ( does_start_with( c, "uchar", last_search_string_len ) ) {
-						property.list_content_type = Property::Type::eUchar;
-						c += last_search_string_len + 1;
-					} else if ( does_start_with( c, "uint", last_search_string_len ) ) {
-						property.list_content_type = Property::Type::eUint;
-						c += last_search_string_len + 1;
-					} else {
-						std::cerr << "Unknown list content type: '" << c << "'" << std::endl
-						          << std::flush;
-						assert( false );
-					}
+	for ( uint32_t i = 0; i != num_chunks; i++ ) {
+		chunk_jobs[ i ] = { fun, user_data, i,
+		                    uint32_t( uint64_t( num_elements ) * i / num_chunks ),
+		                    uint32_t( uint64_t( num_elements ) * ( i + 1 ) / num_chunks ) };
+		jobs[ i ]       = { chunk_job_run, &chunk_jobs[ i ] };
+	}
 
-					// last item will be list name
+	le_jobs::counter_t* counter;
+	le_jobs::run_jobs( jobs.data(), num_chunks, &counter );
+	le_jobs::wait_for_counter_and_free( counter, 0 );
+}
 
-					property.name     = c;
-					property.name_len = uint8_t( strlen( c ) );
-					return true;
-				} else {
+// ----------------------------------------------------------------------
+// Vertex elements
+
+// Where to store the value for a vertex property: values for consecutive
+// vertices are `dst_stride` floats apart.
+struct VertexPropertyTarget {
+	float*   dst        = nullptr; // nullptr if property is not stored
+	uint32_t dst_stride = 0;       // in floats
+	float    scale      = 1.f;     // integer colour values get normalised
+};
 
-					// Non-list type
+// ----------------------------------------------------------------------
+/// \brief makes space for all attributes used by vertex element, and returns one target per property
+static std::vector<VertexPropertyTarget> vertex_element_allocate( le_mesh_o* self, Element const& element ) {
 
-					if ( does_start_with( c, "float", last_search_string_len ) ) {
-						property.type = Property::Type::eFloat;
-					} else if ( does_start_with( c, "uint", last_search_string_len ) ) {
-						property.type = Property::Type::eUint;
-					} else if ( does_start_with( c, "uchar", last_search_string_len ) ) {
-						property.type = Property::Type::eUchar;
-					} else {
-						// Unknown property type.
-						std::cerr << __PRETTY_FUNCTION__ << ": Unknown property type: " << c << std::endl
-						          << std::flush;
-						assert( false );
-						return false;
-					}
+	std::vector<VertexPropertyTarget> targets;
 
-					c += last_search_string_len + 1;
-					property.name     = c;
-					property.name_len = uint8_t( strlen( c ) );
+	if ( element.num_elements == 0 ) {
+		return targets; // nothing to point at - attributes stay empty
+	}
 
-					if ( 0 == strncmp( c, "x", property.name_len ) ) {
-						property.attribute_type = Property::AttributeType::eVX;
-					} else if ( 0 == strncmp( c, "y", property.name_len ) ) {
-						property.attribute_type = Property::AttributeType::eVY;
-					} else if ( 0 == strncmp( c, "z", property.name_len ) ) {
-						property.attribute_type = Property::AttributeType::eVZ;
-					} else if ( 0 == strncmp( c, "nx", property.name_len ) ) {
-						property.attribute_type = Property::AttributeType::eNX;
-					} else if ( 0 == strncmp( c, "ny", property.name_len ) ) {
-						property.attribute_type = Property::AttributeType::eNY;
-					} else if ( 0 == strncmp( c, "nz", property.name_len ) ) {
-						property.attribute_type = Property::AttributeType::eNZ;
-					} else if ( 0 == strncmp( c, "s", property.name_len ) ||
-					            0 == strncmp( c, "u", property.name_len ) ) {
-						property.attribute_type = Property::AttributeType::eTexU;
-					} else if ( 0 == strncmp( c, "t", property.name_len ) ||
-					            0 == strncmp( c, "v", property.name_len ) ) {
-						property.attribute_type = Property::AttributeType::eTexV;
-					} else if ( 0 == strncmp( c, "red", property.name_len ) ||
-					            0 == strncmp( c, "r", property.name_len ) ) {
-						property.attribute_type = Property::AttributeType::eColR;
-					} else if ( 0 == strncmp( c, "green", property.name_len ) ||
-					            0 == strncmp( c, "g", property.name_len ) ) {
-						property.attribute_type = Property::AttributeType::eColG;
-					} else if ( 0 == strncmp( c, "blue", property.name_len ) ||
-					            0 == strncmp( c, "b", property.name_len ) ) {
-						property.attribute_type = Property::AttributeType::eColB;
-					} else if ( 0 == strncmp( c, "alpha", property.name_len ) ||
-					            0 == strncmp( c, "a", property.name_len ) ) {
-						property.attribute_type = Property::AttributeType::eColA;
-					} else {
-						std::cerr << "WARNING: Attribute name not recognised: '" << c << "'" << std::endl
-						          << std::flush;
-					}
+	targets.reserve( element.properties.size() );
 
-					return true;
-				}
-				std::cerr << "Expected property type must be either 'list', or one of non-list type: uchar, float, uint, but given: " << c << std::endl
-				          << std::flush;
-				assert( false );
-				return false;
-			};
+	// - Make space over all attributes for number of elements.
 
-			c += last_search_string_len + 1;
+	for ( auto const& p : element.properties ) {
+		switch ( p.attribute_type ) {
+		case ( Property::AttributeType::eVX ): // intentional fall-through
+		case ( Property::AttributeType::eVY ): // intentional fall-through
+		case ( Property::AttributeType::eVZ ): // intentional fall-through
+			self->vertices.resize( element.num_elements, {} );
+			break;
+		case ( Property::AttributeType::eNX ): // intentional fall-through
+		case ( Property::AttributeType::eNY ): // intentional fall-through
+		case ( Property::AttributeType::eNZ ): // intentional fall-through
+			self->normals.resize( element.num_elements, {} );
+			break;
+		case ( Property::AttributeType::eColR ): // intentional fall-through
+		case ( Property::AttributeType::eColG ): // intentional fall-through
+		case ( Property::AttributeType::eColB ): // intentional fall-through
+		case ( Property::AttributeType::eColA ): // intentional fall-through
+			self->colours.resize( element.num_elements, {} );
+			break;
+		case ( Property::AttributeType::eTexU ): // intentional fall-through
+		case ( Property::AttributeType::eTexV ): // intentional fall-through
+			self->uvs.resize( element.num_elements, {} );
+			break;
+		case ( Property::AttributeType::eUnknown ):
+			break;
+		}
+		// TODO: check for tangents.
+	}
 
-			if ( !elements.empty() && parse_property_line( c, property ) ) {
-				elements.back().properties.emplace_back( std::move( property ) );
+	// - Now that all attributes have their final size, we can point at their components.
+
+	for ( auto const& p : element.properties ) {
+
+		VertexPropertyTarget t{};
+
+		if ( p.type != Property::Type::eList ) {
+			// clang-format off
+			switch ( p.attribute_type ) {
+			case ( Property::AttributeType::eVX )   : t = { &self->vertices[ 0 ].x, 3 }; break;
+			case ( Property::AttributeType::eVY )   : t = { &self->vertices[ 0 ].y, 3 }; break;
+			case ( Property::AttributeType::eVZ )   : t = { &self->vertices[ 0 ].z, 3 }; break;
+			case ( Property::AttributeType::eNX )   : t = { &self->normals[ 0 ].x, 3 }; break;
+			case ( Property::AttributeType::eNY )   : t = { &self->normals[ 0 ].y, 3 }; break;
+			case ( Property::AttributeType::eNZ )   : t = { &self->normals[ 0 ].z, 3 }; break;
+			case ( Property::AttributeType::eTexU ) : t = { &self->uvs[ 0 ].x, 2 }; break;
+			case ( Property::AttributeType::eTexV ) : t = { &self->uvs[ 0 ].y, 2 }; break;
+			case ( Property::AttributeType::eColR ) : t = { &self->colours[ 0 ].x, 4 }; break;
+			case ( Property::AttributeType::eColG ) : t = { &self->colours[ 0 ].y, 4 }; break;
+			case ( Property::AttributeType::eColB ) : t = { &self->colours[ 0 ].z, 4 }; break;
+			case ( Property::AttributeType::eColA ) : t = { &self->colours[ 0 ].w, 4 }; break;
+			case ( Property::AttributeType::eUnknown ): break;
 			}
+			// clang-format on
 
-			continue;
+			if ( t.dst_stride == 4 && p.type != Property::Type::eFloat && p.type != Property::Type::eDouble ) {
+				t.scale = ( p.type == Property::Type::eUshort ) ? 1.f / 65535.f : 1.f / 255.f;
+			}
 		}
 
-		else if ( does_start_with( c, "end_header", last_search_string_len ) ) {
-			// we have reached the marker which signals the end of the header.
-			// - Move file data pointer past "end_header" line
-			c = strtok_r( nullptr, DELIMS, &c_save_ptr );
-			break;
-		}
+		targets.emplace_back( t );
+	}
 
-		// The following code only gets executed if none of the above if clauses has
-		// been triggered - this means that there is something wrong with
-		// the file. we must exit.
+	return targets;
+}
 
-		std::cerr << "ERROR: " << __PRETTY_FUNCTION__ << "Invalid file header data: '" << c << "'" << std::endl
-		          << std::flush;
+// ----------------------------------------------------------------------
 
-		assert( false );
+struct AsciiVertexParams {
+	Element const*              element;
+	VertexPropertyTarget const* targets;
+	char const* const*          line_starts;
+	std::atomic<bool>           success;
+};
 
-		return false;
-	}
+static void ascii_vertices_parse( void* user_data, uint32_t, uint32_t begin, uint32_t end ) {
+	auto params = static_cast<AsciiVertexParams*>( user_data );
 
-	// - Clear mesh
+	auto const& properties = params->element->properties;
 
-	le_mesh_clear( self );
+	for ( uint32_t i = begin; i != end; i++ ) {
 
-	// - Load file data
+		char const* c        = params->line_starts[ i ];
+		char const* line_end = params->line_starts[ i + 1 ];
 
-	Element const* element_archetype     = elements.data();
-	auto const     element_archetype_end = elements.data() + elements.size();
-
-	// What follows now is a list of elements, one element per line.
-	// elements have properties, which are separated by commas.
-
-	for ( ; element_archetype != element_archetype_end; element_archetype++ ) {
-
-		// Check whether the current property is still part of the current element
-		// Otherwise move to the next element
-
-		// Element archetype can be either face vertex or face
-
-		if ( element_archetype->type == Element::Type::eVertex ) {
-
-			// - Make space over all attributes for number of elements.
-
-			for ( auto const& p : element_archetype->properties ) {
-				switch ( p.attribute_type ) {
-				case ( Property::AttributeType::eVX ): // intentional fall-through
-				case ( Property::AttributeType::eVY ): // intentional fall-through
-				case ( Property::AttributeType::eVZ ): // intentional fall-through
-					self->vertices.resize( element_archetype->num_elements, {} );
-					break;
-				case ( Property::AttributeType::eNX ): // intentional fall-through
-				case ( Property::AttributeType::eNY ): // intentional fall-through
-				case ( Property::AttributeType::eNZ ): // intentional fall-through
-					self->normals.resize( element_archetype->num_elements, {} );
-					break;
-				case ( Property::AttributeType::eColR ): // intentional fall-through
-				case ( Property::AttributeType::eColG ): // intentional fall-through
-				case ( Property::AttributeType::eColB ): // intentional fall-through
-				case ( Property::AttributeType::eColA ): // intentional fall-through
-					self->colours.resize( element_archetype->num_elements, {} );
-					break;
-				case ( Property::AttributeType::eTexU ): // intentional fall-through
-				case ( Property::AttributeType::eTexV ): // intentional fall-through
-					self->uvs.resize( element_archetype->num_elements, {} );
-					break;
-				case ( Property::AttributeType::eUnknown ):
-					break;
-				}
-				// TODO: check for tangents.
-			}
+		for ( size_t j = 0; j != properties.size() && c; j++ ) {
+			auto const& p = properties[ j ];
+			auto const& t = params->targets[ j ];
 
-			for ( uint32_t i = 0; i != element_archetype->num_elements && c != nullptr; ++i, c = strtok_r( nullptr, DELIMS, &c_save_ptr ) ) {
-				char* s = c;
-
-				auto* v_data  = self->vertices.empty() ? nullptr : &self->vertices[ i ];
-				auto* n_data  = self->normals.empty() ? nullptr : &self->normals[ i ];
-				auto* uv_data = self->uvs.empty() ? nullptr : &self->uvs[ i ];
-				auto* c_data  = self->colours.empty() ? nullptr : &self->colours[ i ];
-
-				for ( auto const& p : element_archetype->properties ) {
-
-					// clang-format off
-					switch ( p.attribute_type ) {
-					case ( Property::AttributeType::eVX )   : v_data->x  = strtof( s, &s ); break;
-					case ( Property::AttributeType::eVY )   : v_data->y  = strtof( s, &s ); break;
-					case ( Property::AttributeType::eVZ )   : v_data->z  = strtof( s, &s ); break;
-					case ( Property::AttributeType::eNX )   : n_data->x  = strtof( s, &s ); break;
-					case ( Property::AttributeType::eNY )   : n_data->y  = strtof( s, &s ); break;
-					case ( Property::AttributeType::eNZ )   : n_data->z  = strtof( s, &s ); break;
-					case ( Property::AttributeType::eTexU ) : uv_data->x = strtof( s, &s ); break;
-					case ( Property::AttributeType::eTexV ) : uv_data->y = strtof( s, &s ); break;
-					case ( Property::AttributeType::eColR ):
-						c_data->x = p.type == Property::Type::eFloat ? strtof( s, &s ) : strtoul( s, &s, 0 )/255.f; break;
-					case ( Property::AttributeType::eColG ):
-						c_data->y = p.type == Property::Type::eFloat ? strtof( s, &s ) : strtoul( s, &s, 0 )/255.f; break;
-					case ( Property::AttributeType::eColB ):
-						c_data->z = p.type == Property::Type::eFloat ? strtof( s, &s ) : strtoul( s, &s, 0 )/255.f; break;
-					case ( Property::AttributeType::eColA ):
-						c_data->w = p.type == Property::Type::eFloat ? strtof( s, &s ) : strtoul( s, &s, 0 )/255.f; break;
-					case ( Property::AttributeType::eUnknown ):
-						// TODO: what do we do if there is an unknown attribute?
-						assert( false );
-						break;
-					}
-					// clang-format on
+			if ( p.type == Property::Type::eList ) {
+				// lists in vertex elements are not used - skip their values.
+				int64_t count = 0;
+				c             = read_ascii( c, line_end, count );
+				for ( int64_t k = 0; k < count && c; k++ ) {
+					double ignored;
+					c = read_ascii_as_double( c, line_end, p.list_content_type, ignored );
 				}
+				continue;
 			}
 
-		} else if ( element_archetype->type == Element::Type::eFace ) {
+			double value = 0;
+			c            = read_ascii_as_double( c, line_end, p.type, value );
 
-			// must be 3 indices per face - because our meshes can only be built from triangles, not quads or anything else.
-			self->indices.resize( element_archetype->num_elements * 3, {} );
+			if ( t.dst ) {
+				t.dst[ size_t( i ) * t.dst_stride ] = float( value ) * t.scale;
+			}
+		}
 
-			auto*       current_index = self->indices.data();
-			auto* const indices_end   = self->indices.data() + self->indices.size();
+		if ( c == nullptr ) {
+			params->success = false;
+			return;
+		}
+	}
+}
 
-			// this goes through line-by line.
-			for ( size_t line_num = 0;
-			      ( line_num != element_archetype->num_elements ) && ( current_index < indices_end ) && ( c != nullptr );
-			      ++line_num ) {
+// ----------------------------------------------------------------------
 
-				char* s = c;
+struct BinaryVertexParams {
 
-				auto three = strtoul( s, &s, 0 );
-				assert( three == 3 ); // first element must be three
+	// Consecutive float properties which are stored in consecutive floats - such as x, y, z -
+	// get copied (or byte-swapped) as one block.
+	struct Run {
+		uint32_t src_offset; // in bytes, relative to start of vertex record
+		uint32_t num_floats; //
+		float*   dst;        //
+		uint32_t dst_stride; // in floats
+	};
 
-				*current_index++ = strtoul( s, &s, 0 ); // first index
-				*current_index++ = strtoul( s, &s, 0 ); // second index
-				*current_index++ = strtoul( s, &s, 0 ); // third index
+	// Any other properties get converted one-by-one.
+	struct Scalar {
+		uint32_t             src_offset; // in bytes, relative to start of vertex record
+		Property::Type       type;       //
+		VertexPropertyTarget target;     //
+	};
 
-				c = strtok_r( nullptr, DELIMS, &c_save_ptr );
-			}
+	char const*         data;        // first vertex record
+	uint32_t            record_size; // in bytes
+	bool                swap_bytes;
+	std::vector<Run>    runs;
+	std::vector<Scalar> scalars;
+};
 
-			// parse face properties
+static void binary_vertices_parse( void* user_data, uint32_t, uint32_t begin, uint32_t end ) {
+	auto params = static_cast<BinaryVertexParams const*>( user_data );
+
+	// If vertex records contain nothing but a single run of floats - a common case - we
+	// can copy all records in one go.
+	if ( !params->swap_bytes && params->scalars.empty() && params->runs.size() == 1 ) {
+		auto const& run = params->runs[ 0 ];
+		if ( run.src_offset == 0 &&
+		     run.num_floats * sizeof( float ) == params->record_size &&
+		     run.dst_stride == run.num_floats ) {
+			memcpy( run.dst + size_t( begin ) * run.dst_stride,
+			        params->data + size_t( begin ) * params->record_size,
+			        size_t( end - begin ) * params->record_size );
+			return;
 		}
-		if ( element_archetype->type == Element::Type::eUnknown ) {
-			// Not implemented yet.
+	}
 
-			auto skip_lines = [ & ]( char const* c, Element const* archetype ) {
-				for ( uint32_t i = 0; i != archetype->num_elements && c != nullptr; ++i ) {
-					c = strtok_r( nullptr, DELIMS, &c_save_ptr );
-				}
-			};
+	for ( uint32_t i = begin; i != end; i++ ) {
 
-			skip_lines( c, element_archetype );
+		char const* record = params->data + size_t( i ) * params->record_size;
 
-			break;
+		for ( auto const& run : params->runs ) {
+			float* dst = run.dst + size_t( i ) * run.dst_stride;
+			if ( params->swap_bytes ) {
+				for ( uint32_t k = 0; k != run.num_floats; k++ ) {
+					dst[ k ] = read_binary<float>( record + run.src_offset + k * sizeof( float ), true );
+				}
+			} else {
+				memcpy( dst, record + run.src_offset, run.num_floats * sizeof( float ) );
+			}
 		}
-	}
 
-	return true;
+		for ( auto const& s : params->scalars ) {
+			s.target.dst[ size_t( i ) * s.target.dst_stride ] =
+			    float( read_binary_as_double( record + s.src_offset, s.type, params->swap_bytes ) ) * s.target.scale;
+		}
+	}
 }
 
 // ----------------------------------------------------------------------
+/// \return pointer past vertex element data, or nullptr upon failure.
+static char const* vertex_element_load( le_mesh_o* self, Element const& element, char const* c, char const* end, bool is_ascii, bool swap_bytes ) {
 
-LE_MODULE_REGISTER_IMPL( le_mesh, api ) {
-	auto& le_mesh_i = static_cast<le_mesh_api*>( api )->le_mesh_i;
+	if ( element.num_elements == 0 ) {
+		return c; // empty element: there is no data to load
+	}
 
-	le_mesh_i.get_vertices = le_mesh_get_vertices;
-	le_mesh_i.get_indices  = le_mesh_get_indices;
-	le_mesh_i.get_uvs      = le_mesh_get_uvs;
-	le_mesh_i.get_tangents = le_mesh_get_tangents;
-	le_mesh_i.get_normals  = le_mesh_get_normals;
-	le_mesh_i.get_colours  = le_mesh_get_colours;
-	le_mesh_i.get_data     = le_mesh_get_data;
+	if ( !element_fits_into_bytes( element, size_t( end - c ), is_ascii ) ) {
+		std::cerr << "ERROR: " << __PRETTY_FUNCTION__ << ": file is too short for " << element.num_elements << " vertices." << std::endl
+		          << std::flush;
+		return nullptr;
+	}
 
-	le_mesh_i.load_from_ply_file = le_mesh_load_from_ply_file;
+	auto const targets = vertex_element_allocate( self, element );
+
+	uint32_t const num_chunks = get_num_chunks( element.num_elements );
+
+	if ( is_ascii ) {
+
+		std::vector<char const*> line_starts;
+		c = find_ascii_lines( c, end, element.num_elements, line_starts );
+
+		if ( c == nullptr ) {
+			return nullptr;
+		}
+
+		AsciiVertexParams params{ &element, targets.data(), line_starts.data(), true };
+		run_chunks( element.num_elements, num_chunks, &params, ascii_vertices_parse );
+
+		return params.success ? c : nullptr;
+	}
+
+	// ----------| invariant: file is binary
+
+	BinaryVertexParams params{ c, 0, swap_bytes };
+
+	for ( size_t j = 0; j != element.properties.size(); j++ ) {
+		auto const& p = element.properties[ j ];
+		auto const& t = targets[ j ];
+
+		if ( p.type == Property::Type::eList ) {
+			std::cerr << "ERROR: " << __PRETTY_FUNCTION__ << ": list properties are not supported for binary vertex elements." << std::endl
+			          << std::flush;
+			return nullptr;
+		}
+
+		if ( t.dst ) {
+			if ( p.type == Property::Type::eFloat && t.scale == 1.f ) {
+				if ( !params.runs.empty() ) {
+					auto& run = params.runs.back();
+					if ( run.src_offset + run.num_floats * sizeof( float ) == params.record_size &&
+					     run.dst + run.num_floats == t.dst &&
+					     run.dst_stride == t.dst_stride ) {
+						// This property directly continues the previous run: extend it.
+						run.num_floats++;
+						params.record_size += sizeof( float );
+						continue;
+					}
+				}
+				params.runs.push_back( { params.record_size, 1, t.dst, t.dst_stride } );
+			} else {
+				params.scalars.push_back( { params.record_size, p.type, t } );
+			}
+		}
+
+		params.record_size += property_type_get_byte_count( p.type );
+	}
+
+	if ( uint64_t( end - c ) < uint64_t( params.record_size ) * element.num_elements ) {
+		return nullptr;
+	}
+
+	run_chunks( element.num_elements, num_chunks, &params, binary_vertices_parse );
+
+	return c + size_t( params.record_size ) * element.num_elements;
+}
+
+// ----------------------------------------------------------------------
+// Face elements
+
+// Triangles for a range of faces - faces with more than three vertices are triangulated as fans.
+struct FaceChunk {
+	std::vector<uint32_t> indices;
+	bool                  success = true;
+};
+
+// ----------------------------------------------------------------------
+/// \return false if any of the indices is out of bounds
+static inline bool face_chunk_add_polygon( FaceChunk& chunk, int64_t const* polygon, int64_t num_polygon_vertices, uint32_t num_vertices ) {
+	for ( int64_t k = 0; k < num_polygon_vertices; k++ ) {
+		if ( polygon[ k ] < 0 || polygon[ k ] >= num_vertices ) {
+			return false;
+		}
+	}
+	for ( int64_t k = 2; k < num_polygon_vertices; k++ ) {
+		chunk.indices.push_back( uint32_t( polygon[ 0 ] ) );
+		chunk.indices.push_back( uint32_t( polygon[ k - 1 ] ) );
+		chunk.indices.push_back( uint32_t( polygon[ k ] ) );
+	}
+	return true;
+}
+
+// ----------------------------------------------------------------------
+
+struct AsciiFaceParams {
+	Element const*     element;
+	size_t             index_property; // index of property which holds the list of vertex indices
+	uint32_t           num_vertices;
+	char const* const* line_starts;
+	FaceChunk*         chunks;
+};
+
+static void ascii_faces_parse( void* user_data, uint32_t chunk_index, uint32_t begin, uint32_t end ) {
+	auto  params = static_cast<AsciiFaceParams const*>( user_data );
+	auto& chunk  = params->chunks[ chunk_index ];
+
+	auto const& properties = params->element->properties;
+
+	std::vector<int64_t> polygon;
+	chunk.indices.reserve( size_t( end - begin ) * 3 );
+
+	for ( uint32_t i = begin; i != end; i++ ) {
+
+		char const* c        = params->line_starts[ i ];
+		char const* line_end = params->line_starts[ i + 1 ];
+
+		for ( size_t j = 0; j != properties.size() && c; j++ ) {
+			auto const& p = properties[ j ];
+
+			if ( p.type != Property::Type::eList ) {
+				double ignored;
+				c = read_ascii_as_double( c, line_end, p.type, ignored );
+				continue;
+			}
+
+			int64_t count = 0;
+			c             = read_ascii( c, line_end, count );
+
+			if ( j != params->index_property ) {
+				for ( int64_t k = 0; k < count && c; k++ ) {
+					double ignored;
+					c = read_ascii_as_double( c, line_end, p.list_content_type, ignored );
+				}
+				continue;
+			}
+
+			polygon.resize( size_t( std::max<int64_t>( count, 0 ) ) );
+
+			for ( int64_t k = 0; k < count && c; k++ ) {
+				c = read_ascii( c, line_end, polygon[ k ] );
+			}
+
+			if ( c && !face_chunk_add_polygon( chunk, polygon.data(), count, params->num_vertices ) ) {
+				c = nullptr;
+			}
+		}
+
+		if ( c == nullptr ) {
+			chunk.success = false;
+			return;
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+/// \brief binary face records have variable length, which is why we parse them in one go.
+static char const* binary_faces_parse( FaceChunk& chunk, Element const& element, size_t index_property, uint32_t num_vertices, char const* c, char const* end, bool swap_bytes ) {
+
+	std::vector<int64_t> polygon;
+
+	// Face count comes from the file - we don't reserve more faces than there are bytes left.
+	chunk.indices.reserve( size_t( std::min<uint64_t>( element.num_elements, uint64_t( end - c ) ) ) * 3 );
+
+	for ( uint32_t i = 0; i != element.num_elements; i++ ) {
+		for ( size_t j = 0; j != element.properties.size(); j++ ) {
+			auto const& p = element.properties[ j ];
+
+			if ( p.type != Property::Type::eList ) {
+				c += property_type_get_byte_count( p.type );
+				if ( c > end ) {
+					return nullptr;
+				}
+				continue;
+			}
+
+			uint32_t const size_bytes    = property_type_get_byte_count( p.list_size_type );
+			uint32_t const content_bytes = property_type_get_byte_count( p.list_content_type );
+
+			if ( size_t( end - c ) < size_bytes ) {
+				return nullptr;
+			}
+
+			int64_t const count = read_binary_as_int( c, p.list_size_type, swap_bytes );
+			c += size_bytes;
+
+			if ( count < 0 || uint64_t( end - c ) < uint64_t( count ) * content_bytes ) {
+				return nullptr;
+			}
+
+			if ( j == index_property ) {
+				polygon.resize( size_t( count ) );
+				for ( int64_t k = 0; k != count; k++ ) {
+					polygon[ k ] = read_binary_as_int( c + k * content_bytes, p.list_content_type, swap_bytes );
+				}
+				if ( !face_chunk_add_polygon( chunk, polygon.data(), count, num_vertices ) ) {
+					return nullptr;
+				}
+			}
+
+			c += size_t( count ) * content_bytes;
+		}
+	}
+
+	return c;
+}
+
+// ----------------------------------------------------------------------
+/// \return pointer past face element data, or nullptr upon failure.
+static char const* face_element_load( le_mesh_o* self, Element const& element, uint32_t num_vertices, char const* c, char const* end, bool is_ascii, bool swap_bytes ) {
+
+	// Vertex indices are held in the first list property - usually called `vertex_indices`.
+	size_t index_property = 0;
+	while ( index_property != element.properties.size() && element.properties[ index_property ].type != Property::Type::eList ) {
+		index_property++;
+	}
+
+	if ( !element_fits_into_bytes( element, size_t( end - c ), is_ascii ) ) {
+		std::cerr << "ERROR: " << __PRETTY_FUNCTION__ << ": file is too short for " << element.num_elements << " faces." << std::endl
+		          << std::flush;
+		return nullptr;
+	}
+
+	std::vector<FaceChunk> chunks;
+
+	if ( is_ascii ) {
+
+		std::vector<char const*> line_starts;
+		c = find_ascii_lines( c, end, element.num_elements, line_starts );
+
+		if ( c == nullptr ) {
+			return nullptr;
+		}
+
+		chunks.resize( get_num_chunks( element.num_elements ) );
+
+		AsciiFaceParams params{ &element, index_property, num_vertices, line_starts.data(), chunks.data() };
+		run_chunks( element.num_elements, uint32_t( chunks.size() ), &params, ascii_faces_parse );
+
+		for ( auto const& chunk : chunks ) {
+			if ( !chunk.success ) {
+				return nullptr;
+			}
+		}
+
+	} else {
+
+		chunks.resize( 1 );
+		c = binary_faces_parse( chunks[ 0 ], element, index_property, num_vertices, c, end, swap_bytes );
+
+		if ( c == nullptr ) {
+			return nullptr;
+		}
+	}
+
+	// - Gather indices from all chunks - we only use 32 bit indices if we must.
+
+	size_t num_indices = 0;
+	for ( auto const& chunk : chunks ) {
+		num_indices += chunk.indices.size();
+	}
+
+	if ( num_vertices > 0x10000 ) {
+		self->indices_32.reserve( self->indices_32.size() + num_indices );
+		for ( auto const& chunk : chunks ) {
+			self->indices_32.insert( self->indices_32.end(), chunk.indices.begin(), chunk.indices.end() );
+		}
+	} else {
+		self->indices.reserve( self->indices.size() + num_indices );
+		for ( auto const& chunk : chunks ) {
+			self->indices.insert( self->indices.end(), chunk.indices.begin(), chunk.indices.end() );
+		}
+	}
+
+	return c;
+}
+
+// ----------------------------------------------------------------------
+/// \return pointer past element data, or nullptr upon failure.
+static char const* element_skip( Element const& element, char const* c, char const* end, bool is_ascii, bool swap_bytes ) {
+
+	if ( is_ascii ) {
+		std::vector<char const*> line_starts;
+		return find_ascii_lines( c, end, element.num_elements, line_starts );
+	}
+
+	for ( uint32_t i = 0; i != element.num_elements; i++ ) {
+		for ( auto const& p : element.properties ) {
+			if ( p.type != Property::Type::eList ) {
+				c += property_type_get_byte_count( p.type );
+			} else {
+				if ( size_t( end - c ) < property_type_get_byte_count( p.list_size_type ) ) {
+					return nullptr;
+				}
+				int64_t const count = read_binary_as_int( c, p.list_size_type, swap_bytes );
+				if ( count < 0 ) {
+					return nullptr;
+				}
+				c += property_type_get_byte_count( p.list_size_type ) + size_t( count ) * property_type_get_byte_count( p.list_content_type );
+			}
+			if ( c > end ) {
+				return nullptr;
+			}
+		}
+	}
+
+	return c;
+}
+
+// ----------------------------------------------------------------------
+/// \brief loads mesh from ply file
+/// \note any contents of mesh will be cleared before loading
+/// \return true upon success, false otherwise.
+static bool le_mesh_load_from_ply_file( le_mesh_o* self, char const* file_path_ ) {
+
+	// - Make sure file exists
+
+	std::filesystem::path file_path{ file_path_ };
+
+	if ( !std::filesystem::exists( file_path ) ) {
+		std::cerr << "File not found: '" << file_path << "'";
+		return false;
+	}
+
+	// --------| invariant: File path exists
+
+	// - Map file into memory
+
+	MappedFile file{};
+
+	if ( !mapped_file_open( &file, file_path_ ) ) {
+		std::cerr << "File could not be loaded: '" << file_path << "'";
+		return false;
+	}
+
+	char const* const file_end = file.data + file.size;
+
+	// - Find end of header: element data starts on the line which follows `end_header`.
+
+	char const* data_start = nullptr;
+
+	if ( file.size > 3 && 0 == strncmp( file.data, "ply", 3 ) ) {
+		std::string_view file_view( file.data, file.size );
+		size_t           header_end = file_view.find( "\nend_header" );
+		if ( header_end != std::string_view::npos ) {
+			header_end = file_view.find( '\n', header_end + 1 );
+		}
+		if ( header_end != std::string_view::npos ) {
+			data_start = file.data + header_end + 1;
+		}
+	}
+
+	if ( data_start == nullptr ) {
+		std::cerr << "Invalid file header: '" << file_path << "'";
+		mapped_file_close( &file );
+		return false;
+	}
+
+	// - Build mesh attributes structure based on header.
+	//
+	// We parse a copy of the header, as mapped file memory is read-only. Element, and
+	// property names point into this copy.
+
+	std::vector<char> header( file.data, data_start );
+	header.push_back( '\0' );
+
+	static auto DELIMS{ "\r\n\0" };
+	char*       c_save_ptr; //< we use the re-entrant version of strtok, for which state is stored in here
+
+	char* c = strtok_r( header.data(), DELIMS, &c_save_ptr );
+
+	if ( 0 != strcmp( c, "ply" ) ) {
+		std::cerr << "Invalid file header: '" << file_path << "'";
+		mapped_file_close( &file );
+		return false;
+	}
+
+	c = strtok_r( nullptr, DELIMS, &c_save_ptr );
+
+	bool is_ascii   = false;
+	bool swap_bytes = false; // whether binary data must be byte-swapped, because its byte order differs from ours.
+
+	if ( c && 0 == strcmp( c, "format ascii 1.0" ) ) {
+		is_ascii = true;
+	} else if ( c && 0 == strcmp( c, "format binary_little_endian 1.0" ) ) {
+		swap_bytes = ( std::endian::native != std::endian::little );
+	} else if ( c && 0 == strcmp( c, "format binary_big_endian 1.0" ) ) {
+		swap_bytes = ( std::endian::native != std::endian::big );
+	} else {
+		std::cerr << "Invalid file header: '" << file_path << "'";
+		mapped_file_close( &file );
+		return false;
+	}
+
+	c = strtok_r( nullptr, DELIMS, &c_save_ptr );
+
+	// Parse header data into a vector of Element
+	std::vector<Element> elements;
+
+	for ( ; c != nullptr; c = strtok_r( nullptr, DELIMS, &c_save_ptr ) ) {
+
+		size_t last_search_string_len = 0;
+
+		if ( does_start_with( c, "comment", last_search_string_len ) ||
+		     does_start_with( c, "obj_info", last_search_string_len ) ) {
+			// Anything after a comment will be ignored
+			continue;
+		}
+
+		else if ( does_start_with( c, "element", last_search_string_len ) ) {
+			Element element;
+
+			// Note: This method replaces spaces between in-element tokens with \0 characters.
+			auto parse_element_line = []( char* c, Element& element ) -> bool {
+				element.name = c;
+				char* c_next = strchr( c, ' ' );
+				if ( c_next == nullptr ) {
+					// There must be a space character
+					assert( false );
+					return false;
+				}
+				*c_next          = 0; // insert an end-of-string token
+				element.name_len = uint8_t( c_next - c );
+
+				if ( 0 == strcmp( element.name, "vertex" ) ) {
+					element.type = Element::Type::eVertex;
+				} else if ( 0 == strcmp( element.name, "face" ) ) {
+					element.type = Element::Type::eFace;
+				}
+
+				c = c_next + 1; // adding one because we don't want the zero terminator.
+
+				element.num_elements = uint32_t( strtoul( c, nullptr, 0 ) );
+				return true;
+			};
+
+			c += last_search_string_len + 1;
+
+			// fetch name of element, and count of elements
+			parse_element_line( c, element );
+
+			elements.emplace_back( std::move( element ) );
+
+			continue;
+		}
+
+		else if ( does_start_with( c, "property", last_search_string_len ) ) {
+			Property property;
+
+			auto parse_property_line = []( char* c, Property& property ) -> bool {
+				size_t last_search_string_len = 0;
+
+				// now, we expect either list or a non-list type as property type
+				if ( does_start_with( c, "list ", last_search_string_len ) ) {
+					c += last_search_string_len;
+					property.type = Property::Type::eList;
+
+					// next item will be list size type, followed by list content type
+
+					property.list_size_type = property_type_from_name( c, last_search_string_len );
+					c += last_search_string_len + ( c[ last_search_string_len ] ? 1 : 0 );
+
+					property.list_content_type = property_type_from_name( c, last_search_string_len );
+					c += last_search_string_len + ( c[ last_search_string_len ] ? 1 : 0 );
+
+					if ( property.list_size_type == Property::Type::eUnknown ||
+					     property.list_content_type == Property::Type::eUnknown ) {
+						std::cerr << "Unknown list size or content type: '" << c << "'" << std::endl
+						          << std::flush;
+						assert( false );
+						return false;
+					}
+
+					// last item will be list name
+
+					property.name     = c;
+					property.name_len = uint8_t( strlen( c ) );
+					return true;
+				} else {
+
+					// Non-list type
+
+					property.type = property_type_from_name( c, last_search_string_len );
+
+					if ( property.type == Property::Type::eUnknown ) {
+						// Unknown property type.
+						std::cerr << __PRETTY_FUNCTION__ << ": Unknown property type: " << c << std::endl
+						          << std::flush;
+						assert( false );
+						return false;
+					}
+
+					c += last_search_string_len + ( c[ last_search_string_len ] ? 1 : 0 );
+					property.name     = c;
+					property.name_len = uint8_t( strlen( c ) );
+
+					if ( 0 == strcmp( c, "x" ) ) {
+						property.attribute_type = Property::AttributeType::eVX;
+					} else if ( 0 == strcmp( c, "y" ) ) {
+						property.attribute_type = Property::AttributeType::eVY;
+					} else if ( 0 == strcmp( c, "z" ) ) {
+						property.attribute_type = Property::AttributeType::eVZ;
+					} else if ( 0 == strcmp( c, "nx" ) ) {
+						property.attribute_type = Property::AttributeType::eNX;
+					} else if ( 0 == strcmp( c, "ny" ) ) {
+						property.attribute_type = Property::AttributeType::eNY;
+					} else if ( 0 == strcmp( c, "nz" ) ) {
+						property.attribute_type = Property::AttributeType::eNZ;
+					} else if ( 0 == strcmp( c, "s" ) ||
+					            0 == strcmp( c, "u" ) ||
+					            0 == strcmp( c, "texture_u" ) ) {
+						property.attribute_type = Property::AttributeType::eTexU;
+					} else if ( 0 == strcmp( c, "t" ) ||
+					            0 == strcmp( c, "v" ) ||
+					            0 == strcmp( c, "texture_v" ) ) {
+						property.attribute_type = Property::AttributeType::eTexV;
+					} else if ( 0 == strcmp( c, "red" ) ||
+					            0 == strcmp( c, "r" ) ) {
+						property.attribute_type = Property::AttributeType::eColR;
+					} else if ( 0 == strcmp( c, "green" ) ||
+					            0 == strcmp( c, "g" ) ) {
+						property.attribute_type = Property::AttributeType::eColG;
+					} else if ( 0 == strcmp( c, "blue" ) ||
+					            0 == strcmp( c, "b" ) ) {
+						property.attribute_type = Property::AttributeType::eColB;
+					} else if ( 0 == strcmp( c, "alpha" ) ||
+					            0 == strcmp( c, "a" ) ) {
+						property.attribute_type = Property::AttributeType::eColA;
+					} else {
+						std::cerr << "WARNING: Attribute name not recognised: '" << c << "'" << std::endl
+						          << std::flush;
+					}
+
+					return true;
+				}
+			};
+
+			c += last_search_string_len + 1;
+
+			if ( elements.empty() || !parse_property_line( c, property ) ) {
+				std::cerr << "ERROR: " << __PRETTY_FUNCTION__ << ": Invalid property: '" << c << "'" << std::endl
+				          << std::flush;
+				mapped_file_close( &file );
+				return false;
+			}
+
+			elements.back().properties.emplace_back( std::move( property ) );
+
+			continue;
+		}
+
+		else if ( does_start_with( c, "end_header", last_search_string_len ) ) {
+			// we have reached the marker which signals the end of the header.
+			break;
+		}
+
+		// The following code only gets executed if none of the above if clauses has
+		// been triggered - this means that there is something wrong with
+		// the file. we must exit.
+
+		std::cerr << "ERROR: " << __PRETTY_FUNCTION__ << "Invalid file header data: '" << c << "'" << std::endl
+		          << std::flush;
+
+		assert( false );
+
+		mapped_file_close( &file );
+		return false;
+	}
+
+	// - Clear mesh
+
+	le_mesh_clear( self );
+
+	// - Load file data
+	//
+	// Faces refer to vertices, and vertex count decides whether we need 32 bit indices.
+
+	uint32_t num_vertices = 0;
+
+	for ( auto const& element : elements ) {
+		if ( element.type == Element::Type::eVertex ) {
+			num_vertices = element.num_elements;
+			break;
+		}
+	}
+
+	char const* data = data_start;
+
+	for ( auto const& element : elements ) {
+
+		switch ( element.type ) {
+		case ( Element::Type::eVertex ):
+			data = vertex_element_load( self, element, data, file_end, is_ascii, swap_bytes );
+			break;
+		case ( Element::Type::eFace ):
+			data = face_element_load( self, element, num_vertices, data, file_end, is_ascii, swap_bytes );
+			break;
+		case ( Element::Type::eUnknown ):
+			data = element_skip( element, data, file_end, is_ascii, swap_bytes );
+			break;
+		}
+
+		if ( data == nullptr ) {
+			std::cerr << "ERROR: " << __PRETTY_FUNCTION__ << ": Invalid data for element '" << element.name << "' in file: '" << file_path << "'" << std::endl
+			          << std::flush;
+			le_mesh_clear( self );
+			mapped_file_close( &file );
+			return false;
+		}
+	}
+
+	mapped_file_close( &file );
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+// Mesh optimisation
+// ----------------------------------------------------------------------
+
+// Size of the post-transform vertex cache which we optimise for. Real hardware does not
+// use a simple FIFO cache, but ordering triangles for a small FIFO cache gives close to
+// optimal results for a wide range of GPUs.
+static constexpr uint32_t VERTEX_CACHE_SIZE = 16;
+
+// ----------------------------------------------------------------------
+/// \brief returns a copy of mesh indices, widened to 32 bit
+static std::vector<uint32_t> mesh_get_indices_32( le_mesh_o const* self ) {
+	if ( !self->indices_32.empty() ) {
+		return self->indices_32;
+	}
+	return std::vector<uint32_t>( self->indices.begin(), self->indices.end() );
+}
+
+// ----------------------------------------------------------------------
+/// \brief stores indices, using the same index type as the mesh did before
+static void mesh_set_indices_32( le_mesh_o* self, std::vector<uint32_t>&& indices ) {
+	if ( !self->indices_32.empty() ) {
+		self->indices_32 = std::move( indices );
+	} else {
+		self->indices.assign( indices.begin(), indices.end() );
+	}
+}
+
+// ----------------------------------------------------------------------
+/// \brief average cache miss ratio: number of vertices which a FIFO cache of `cache_size` entries
+///        must transform per triangle
+static float acmr_calculate( uint32_t const* indices, size_t num_indices, size_t num_vertices, uint32_t cache_size ) {
+
+	if ( num_indices < 3 || cache_size == 0 ) {
+		return 0.f;
+	}
+
+	// A vertex is in the cache if it was added no more than `cache_size` misses ago.
+	std::vector<uint32_t> cache_timestamps( num_vertices, 0 );
+	uint32_t              timestamp  = cache_size + 1;
+	size_t                num_misses = 0;
+
+	for ( size_t i = 0; i != num_indices; i++ ) {
+		uint32_t const v = indices[ i ];
+		if ( timestamp - cache_timestamps[ v ] > cache_size ) {
+			cache_timestamps[ v ] = timestamp++;
+			num_misses++;
+		}
+	}
+
+	return float( num_misses ) / float( num_indices / 3 );
+}
+
+// ----------------------------------------------------------------------
+
+static float le_mesh_get_acmr( le_mesh_o* self, uint32_t cache_size ) {
+	auto const indices = mesh_get_indices_32( self );
+	return acmr_calculate( indices.data(), indices.size(), self->vertices.size(), cache_size );
+}
+
+// ----------------------------------------------------------------------
+/// \brief  reorders triangles for vertex cache locality
+/// \details implements "Tipsify" from Sander, Nehab, Barczak: "Fast Triangle Reordering
+///          for Vertex Locality and Reduced Overdraw", SIGGRAPH 2007. Runs in linear time.
+/// \param  cluster_starts (optional) receives the first triangle of each cluster - a new
+///         cluster starts whenever the cache had to be flushed.
+static std::vector<uint32_t> tipsify( std::vector<uint32_t> const& indices, size_t num_vertices, uint32_t cache_size, std::vector<uint32_t>* cluster_starts ) {
+
+	size_t const num_triangles = indices.size() / 3;
+
+	// - Build vertex-triangle adjacency
+
+	std::vector<uint32_t> live_triangles( num_vertices, 0 ); // number of triangles using vertex which have not been emitted yet
+	for ( auto const& v : indices ) {
+		live_triangles[ v ]++;
+	}
+
+	std::vector<uint32_t> adjacency_offsets( num_vertices + 1, 0 );
+	for ( size_t v = 0; v != num_vertices; v++ ) {
+		adjacency_offsets[ v + 1 ] = adjacency_offsets[ v ] + live_triangles[ v ];
+	}
+
+	std::vector<uint32_t> adjacency( indices.size() );
+	{
+		std::vector<uint32_t> fill( adjacency_offsets.begin(), adjacency_offsets.end() - 1 );
+		for ( size_t i = 0; i != indices.size(); i++ ) {
+			adjacency[ fill[ indices[ i ] ]++ ] = uint32_t( i / 3 );
+		}
+	}
+
+	// - Emit triangles fanning around vertices, choosing the next vertex so that it
+	//   is likely to still be in the cache once its triangles are emitted.
+
+	std::vector<uint32_t> result;
+	result.reserve( indices.size() );
+
+	std::vector<uint32_t> cache_timestamps( num_vertices, 0 );
+	std::vector<bool>     is_emitted( num_triangles, false );
+	std::vector<uint32_t> dead_end_stack;
+	std::vector<uint32_t> candidates;
+
+	uint32_t timestamp = cache_size + 1;
+	uint32_t cursor    = 0; // next vertex to look at once we run out of candidates
+	int64_t  fan       = num_vertices ? 0 : -1;
+
+	while ( fan >= 0 ) {
+
+		if ( cluster_starts && timestamp - cache_timestamps[ fan ] > cache_size &&
+		     ( cluster_starts->empty() || cluster_starts->back() != result.size() / 3 ) ) {
+			cluster_starts->push_back( uint32_t( result.size() / 3 ) );
+		}
+
+		candidates.clear();
+
+		for ( uint32_t a = adjacency_offsets[ fan ]; a != adjacency_offsets[ fan + 1 ]; a++ ) {
+			uint32_t const t = adjacency[ a ];
+
+			if ( is_emitted[ t ] ) {
+				continue;
+			}
+
+			for ( uint32_t k = 0; k != 3; k++ ) {
+				uint32_t const v = indices[ t * 3 + k ];
+				result.push_back( v );
+				dead_end_stack.push_back( v );
+				candidates.push_back( v );
+				live_triangles[ v ]--;
+				if ( timestamp - cache_timestamps[ v ] > cache_size ) {
+					cache_timestamps[ v ] = timestamp++;
+				}
+			}
+
+			is_emitted[ t ] = true;
+		}
+
+		// - Pick the candidate which will be in the cache the longest once its
+		//   remaining triangles have been emitted.
+
+		int64_t next          = -1;
+		int64_t best_priority = -1;
+
+		for ( auto const& v : candidates ) {
+			if ( live_triangles[ v ] == 0 ) {
+				continue;
+			}
+			int64_t priority = 0;
+			if ( timestamp - cache_timestamps[ v ] + 2 * live_triangles[ v ] <= cache_size ) {
+				priority = timestamp - cache_timestamps[ v ];
+			}
+			if ( priority > best_priority ) {
+				best_priority = priority;
+				next          = v;
+			}
+		}
+
+		// - Dead end: go back to a recently used vertex, or failing that, to any vertex with triangles left.
+
+		while ( next == -1 && !dead_end_stack.empty() ) {
+			uint32_t const v = dead_end_stack.back();
+			dead_end_stack.pop_back();
+			if ( live_triangles[ v ] > 0 ) {
+				next = v;
+			}
+		}
+
+		while ( next == -1 && cursor < num_vertices ) {
+			if ( live_triangles[ cursor ] > 0 ) {
+				next = cursor;
+			}
+			cursor++;
+		}
+
+		fan = next;
+	}
+
+	return result;
+}
+
+// ----------------------------------------------------------------------
+/// \brief reorders clusters of triangles so that triangles which are likely to occlude
+///        others get drawn first - clusters facing away from the mesh centre go first.
+static std::vector<uint32_t> clusters_sort_for_overdraw( le_mesh_o const* self, std::vector<uint32_t> const& indices, std::vector<uint32_t> const& cluster_starts ) {
+
+	size_t const num_triangles = indices.size() / 3;
+	size_t const num_clusters  = cluster_starts.size();
+
+	auto const& vertices = self->vertices;
+
+	// - Find area-weighted centroid of the mesh, and area-weighted centroid, and normal of each cluster.
+
+	struct Cluster {
+		uint32_t  first_triangle;
+		uint32_t  num_triangles;
+		glm::vec3 centroid;
+		glm::vec3 normal;
+		float     sort_key;
+	};
+
+	std::vector<Cluster> clusters( num_clusters );
+
+	glm::vec3 mesh_centroid( 0 );
+	float     mesh_area = 0;
+
+	for ( size_t i = 0; i != num_clusters; i++ ) {
+		auto& cluster          = clusters[ i ];
+		cluster.first_triangle = cluster_starts[ i ];
+		cluster.num_triangles  = uint32_t( ( i + 1 < num_clusters ? cluster_starts[ i + 1 ] : num_triangles ) - cluster_starts[ i ] );
+		cluster.centroid       = glm::vec3( 0 );
+		cluster.normal         = glm::vec3( 0 );
+
+		float cluster_area = 0;
+
+		for ( uint32_t t = cluster.first_triangle; t != cluster.first_triangle + cluster.num_triangles; t++ ) {
+			glm::vec3 const& p0 = vertices[ indices[ t * 3 + 0 ] ];
+			glm::vec3 const& p1 = vertices[ indices[ t * 3 + 1 ] ];
+			glm::vec3 const& p2 = vertices[ indices[ t * 3 + 2 ] ];
+
+			glm::vec3 const normal = glm::cross( p1 - p0, p2 - p0 ); // length is twice the area of the triangle
+			float const     area   = glm::length( normal );
+
+			cluster.centroid += ( p0 + p1 + p2 ) * ( area / 3.f );
+			cluster.normal += normal;
+			cluster_area += area;
+		}
+
+		mesh_centroid += cluster.centroid;
+		mesh_area += cluster_area;
+
+		if ( cluster_area > 0 ) {
+			cluster.centroid /= cluster_area;
+		}
+	}
+
+	if ( mesh_area > 0 ) {
+		mesh_centroid /= mesh_area;
+	}
+
+	for ( auto& cluster : clusters ) {
+		float const normal_length = glm::length( cluster.normal );
+		cluster.sort_key          = normal_length > 0 ? glm::dot( cluster.centroid - mesh_centroid, cluster.normal / normal_length ) : 0.f;
+	}
+
+	std::stable_sort( clusters.begin(), clusters.end(), []( Cluster const& lhs, Cluster const& rhs ) -> bool {
+		return lhs.sort_key > rhs.sort_key;
+	} );
+
+	std::vector<uint32_t> result;
+	result.reserve( indices.size() );
+
+	for ( auto const& cluster : clusters ) {
+		result.insert( result.end(),
+		               indices.begin() + size_t( cluster.first_triangle ) * 3,
+		               indices.begin() + size_t( cluster.first_triangle + cluster.num_triangles ) * 3 );
+	}
+
+	return result;
+}
+
+// ----------------------------------------------------------------------
+
+template <typename T>
+static void attribute_remap( std::vector<T>& attribute, std::vector<uint32_t> const& new_index_for_vertex ) {
+	if ( attribute.empty() ) {
+		return;
+	}
+	std::vector<T> remapped( attribute.size() );
+	for ( size_t v = 0; v != attribute.size(); v++ ) {
+		remapped[ new_index_for_vertex[ v ] ] = attribute[ v ];
+	}
+	attribute = std::move( remapped );
+}
+
+// ----------------------------------------------------------------------
+/// \brief reorders vertices in the order in which they are first used by indices, so that
+///        vertex fetch reads memory mostly sequentially. Unused vertices are moved to the end.
+static void vertices_reorder_for_fetch( le_mesh_o* self, std::vector<uint32_t>& indices ) {
+
+	size_t const num_vertices = self->vertices.size();
+
+	constexpr uint32_t    UNASSIGNED = ~uint32_t( 0 );
+	std::vector<uint32_t> new_index_for_vertex( num_vertices, UNASSIGNED );
+	uint32_t              next_index = 0;
+
+	for ( auto& v : indices ) {
+		if ( new_index_for_vertex[ v ] == UNASSIGNED ) {
+			new_index_for_vertex[ v ] = next_index++;
+		}
+		v = new_index_for_vertex[ v ];
+	}
+
+	for ( auto& v : new_index_for_vertex ) {
+		if ( v == UNASSIGNED ) {
+			v = next_index++;
+		}
+	}
+
+	attribute_remap( self->vertices, new_index_for_vertex );
+	attribute_remap( self->normals, new_index_for_vertex );
+	attribute_remap( self->colours, new_index_for_vertex );
+	attribute_remap( self->uvs, new_index_for_vertex );
+	attribute_remap( self->tangents, new_index_for_vertex );
+}
+
+// ----------------------------------------------------------------------
+
+static void le_mesh_optimize( le_mesh_o* self, bool optimize_overdraw ) {
+
+	size_t const num_vertices = self->vertices.size();
+	auto         indices      = mesh_get_indices_32( self );
+
+	if ( indices.size() < 3 || num_vertices == 0 ) {
+		return;
+	}
+
+	indices.resize( indices.size() - indices.size() % 3 );
+
+	for ( auto const& v : indices ) {
+		if ( v >= num_vertices ) {
+			std::cerr << "ERROR: " << __PRETTY_FUNCTION__ << ": Mesh index out of bounds, not optimising mesh." << std::endl
+			          << std::flush;
+			return;
+		}
+	}
+
+	std::vector<uint32_t> cluster_starts;
+
+	indices = tipsify( indices, num_vertices, VERTEX_CACHE_SIZE, optimize_overdraw ? &cluster_starts : nullptr );
+
+	if ( optimize_overdraw && cluster_starts.size() > 1 ) {
+		indices = clusters_sort_for_overdraw( self, indices, cluster_starts );
+	}
+
+	vertices_reorder_for_fetch( self, indices );
+
+	mesh_set_indices_32( self, std::move( indices ) );
+
+	// Meshlets refer to vertices, and triangles by index - they are not valid anymore.
+	self->meshlets.clear();
+	self->meshlet_vertices.clear();
+	self->meshlet_triangles.clear();
+}
+
+// ----------------------------------------------------------------------
+// Meshlets
+// ----------------------------------------------------------------------
+
+/// \brief calculates bounding sphere, and normal cone for a meshlet
+static void meshlet_calculate_bounds( le_mesh_meshlet_t& meshlet, le_mesh_o const* self ) {
+
+	uint32_t const* meshlet_vertices  = self->meshlet_vertices.data() + meshlet.vertex_offset;
+	uint8_t const*  meshlet_triangles = self->meshlet_triangles.data() + meshlet.triangle_offset;
+
+	// - Bounding sphere: centred on the bounding box
+
+	glm::vec3 bb_min = self->vertices[ meshlet_vertices[ 0 ] ];
+	glm::vec3 bb_max = bb_min;
+
+	for ( uint32_t i = 1; i != meshlet.vertex_count; i++ ) {
+		bb_min = glm::min( bb_min, self->vertices[ meshlet_vertices[ i ] ] );
+		bb_max = glm::max( bb_max, self->vertices[ meshlet_vertices[ i ] ] );
+	}
+
+	glm::vec3 const center = ( bb_min + bb_max ) * 0.5f;
+	float           radius = 0;
+
+	for ( uint32_t i = 0; i != meshlet.vertex_count; i++ ) {
+		radius = std::max( radius, glm::distance( center, self->vertices[ meshlet_vertices[ i ] ] ) );
+	}
+
+	// - Normal cone: axis is the average triangle normal; the cone must contain all triangle normals.
+
+	std::vector<glm::vec3> normals;
+	normals.reserve( meshlet.triangle_count );
+
+	glm::vec3 axis( 0 );
+
+	for ( uint32_t t = 0; t != meshlet.triangle_count; t++ ) {
+		glm::vec3 const& p0 = self->vertices[ meshlet_vertices[ meshlet_triangles[ t * 3 + 0 ] ] ];
+		glm::vec3 const& p1 = self->vertices[ meshlet_vertices[ meshlet_triangles[ t * 3 + 1 ] ] ];
+		glm::vec3 const& p2 = self->vertices[ meshlet_vertices[ meshlet_triangles[ t * 3 + 2 ] ] ];
+
+		glm::vec3 const normal = glm::cross( p1 - p0, p2 - p0 );
+		float const     length = glm::length( normal );
+
+		if ( length > 0 ) {
+			// degenerate triangles are never visible, and don't count.
+			normals.push_back( normal / length );
+			axis += normals.back();
+		}
+	}
+
+	float const axis_length = glm::length( axis );
+	float       min_dot     = -1;
+
+	if ( axis_length > 0 ) {
+		axis /= axis_length;
+		min_dot = 1;
+		for ( auto const& n : normals ) {
+			min_dot = std::min( min_dot, glm::dot( n, axis ) );
+		}
+	}
+
+	meshlet.center[ 0 ] = center.x;
+	meshlet.center[ 1 ] = center.y;
+	meshlet.center[ 2 ] = center.z;
+	meshlet.radius      = radius;
+
+	if ( min_dot <= 0 ) {
+		// Normals spread over more than a hemisphere: meshlet can't be cone-culled.
+		meshlet.cone_axis[ 0 ] = 0;
+		meshlet.cone_axis[ 1 ] = 0;
+		meshlet.cone_axis[ 2 ] = 0;
+		meshlet.cone_cutoff    = 1;
+	} else {
+		meshlet.cone_axis[ 0 ] = axis.x;
+		meshlet.cone_axis[ 1 ] = axis.y;
+		meshlet.cone_axis[ 2 ] = axis.z;
+		meshlet.cone_cutoff    = sqrtf( 1.f - min_dot * min_dot ); // sine of cone half-angle
+	}
+}
+
+// ----------------------------------------------------------------------
+/// \brief splits mesh into meshlets, with triangles in mesh index order - call `optimize` first, so that
+///        neighbouring triangles are close together in index order, which gives tight meshlets.
+static bool le_mesh_build_meshlets( le_mesh_o* self, uint32_t max_vertices, uint32_t max_triangles ) {
+
+	self->meshlets.clear();
+	self->meshlet_vertices.clear();
+	self->meshlet_triangles.clear();
+
+	if ( max_vertices < 3 || max_vertices > 256 || max_triangles == 0 ) {
+		std::cerr << "ERROR: " << __PRETTY_FUNCTION__ << ": Meshlets must hold between 3 and 256 vertices, and at least one triangle." << std::endl
+		          << std::flush;
+		return false;
+	}
+
+	size_t const num_vertices = self->vertices.size();
+	auto const   indices      = mesh_get_indices_32( self );
+
+	constexpr uint16_t    NOT_IN_MESHLET = 0xffff;
+	std::vector<uint16_t> local_index( num_vertices, NOT_IN_MESHLET ); // index of vertex within current meshlet
+
+	le_mesh_meshlet_t meshlet{};
+
+	auto meshlet_finish = [ & ]() {
+		for ( uint32_t i = 0; i != meshlet.vertex_count; i++ ) {
+			local_index[ self->meshlet_vertices[ meshlet.vertex_offset + i ] ] = NOT_IN_MESHLET;
+		}
+		meshlet_calculate_bounds( meshlet, self );
+		self->meshlets.push_back( meshlet );
+
+		// Pad triangle data to a multiple of 4 bytes, so that each meshlet's triangles may be read as uint32 words.
+		self->meshlet_triangles.resize( ( self->meshlet_triangles.size() + 3 ) & ~size_t( 3 ), 0 );
+
+		meshlet                 = {};
+		meshlet.vertex_offset   = uint32_t( self->meshlet_vertices.size() );
+		meshlet.triangle_offset = uint32_t( self->meshlet_triangles.size() );
+	};
+
+	for ( size_t t = 0; t + 2 < indices.size(); t += 3 ) {
+
+		uint32_t const a = indices[ t + 0 ];
+		uint32_t const b = indices[ t + 1 ];
+		uint32_t const c = indices[ t + 2 ];
+
+		if ( a >= num_vertices || b >= num_vertices || c >= num_vertices ) {
+			std::cerr << "ERROR: " << __PRETTY_FUNCTION__ << ": Mesh index out of bounds." << std::endl
+			          << std::flush;
+			self->meshlets.clear();
+			self->meshlet_vertices.clear();
+			self->meshlet_triangles.clear();
+			return false;
+		}
+
+		uint32_t const num_new_vertices = ( local_index[ a ] == NOT_IN_MESHLET ) +
+		                                  ( local_index[ b ] == NOT_IN_MESHLET && b != a ) +
+		                                  ( local_index[ c ] == NOT_IN_MESHLET && c != a && c != b );
+
+		if ( meshlet.vertex_count + num_new_vertices > max_vertices ||
+		     meshlet.triangle_count + 1 > max_triangles ) {
+			meshlet_finish();
+		}
+
+		for ( uint32_t const v : { a, b, c } ) {
+			if ( local_index[ v ] == NOT_IN_MESHLET ) {
+				local_index[ v ] = uint16_t( meshlet.vertex_count++ );
+				self->meshlet_vertices.push_back( v );
+			}
+			self->meshlet_triangles.push_back( uint8_t( local_index[ v ] ) );
+		}
+
+		meshlet.triangle_count++;
+	}
+
+	if ( meshlet.triangle_count ) {
+		meshlet_finish();
+	}
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+
+static void le_mesh_get_meshlets( le_mesh_o* self, size_t* count, le_mesh_meshlet_t const** meshlets, uint32_t const** meshlet_vertices, uint8_t const** meshlet_triangles ) {
+	if ( count ) {
+		*count = self->meshlets.size();
+	}
+	if ( meshlets ) {
+		*meshlets = self->meshlets.data();
+	}
+	if ( meshlet_vertices ) {
+		*meshlet_vertices = self->meshlet_vertices.data();
+	}
+	if ( meshlet_triangles ) {
+		*meshlet_triangles = self->meshlet_triangles.data();
+	}
+}
+
+// ----------------------------------------------------------------------
+
+LE_MODULE_REGISTER_IMPL( le_mesh, api ) {
+	auto& le_mesh_i = static_cast<le_mesh_api*>( api )->le_mesh_i;
+
+	le_mesh_i.get_vertices = le_mesh_get_vertices;
+	le_mesh_i.get_indices  = le_mesh_get_indices;
+	le_mesh_i.get_uvs      = le_mesh_get_uvs;
+	le_mesh_i.get_tangents = le_mesh_get_tangents;
+	le_mesh_i.get_normals  = le_mesh_get_normals;
+	le_mesh_i.get_colours  = le_mesh_get_colours;
+	le_mesh_i.get_data     = le_mesh_get_data;
+
+	le_mesh_i.load_from_ply_file = le_mesh_load_from_ply_file;
+
+	le_mesh_i.optimize       = le_mesh_optimize;
+	le_mesh_i.get_acmr       = le_mesh_get_acmr;
+	le_mesh_i.build_meshlets = le_mesh_build_meshlets;
+	le_mesh_i.get_meshlets   = le_mesh_get_meshlets;
 
 	le_mesh_i.clear   = le_mesh_clear;
 	le_mesh_i.create  = le_mesh_create;
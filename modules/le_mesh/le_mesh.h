@@ -5,9 +5,28 @@
 
 struct le_mesh_o;
 
+// A meshlet is a small cluster of triangles which may be processed by a single mesh shader
+// workgroup. Its layout matches std430, so that meshlets may be uploaded into a storage buffer as-is.
+struct le_mesh_meshlet_t {
+	float    center[ 3 ];     // bounding sphere, in model space
+	float    radius;          //
+	float    cone_axis[ 3 ];  // normal cone: all triangles of the meshlet are back-facing if:
+	float    cone_cutoff;     // dot( center - eye, cone_axis ) >= cone_cutoff * ( length( center - eye ) + radius ) + radius
+	uint32_t vertex_offset;   // first element in meshlet vertices - which are indices into mesh vertices
+	uint32_t triangle_offset; // first byte in meshlet triangles - which hold 3 uint8_t meshlet vertex indices per triangle
+	uint32_t vertex_count;    //
+	uint32_t triangle_count;  //
+};
+
 // clang-format off
 struct le_mesh_api {
 
+	// Meshes with more than 65536 vertices use 32 bit indices.
+	enum IndexType : uint32_t {
+		eIndexTypeUint16 = 0, // same value as le::IndexType::eUint16
+		eIndexTypeUint32 = 1, // same value as le::IndexType::eUint32
+	};
+
 	struct le_mesh_interface_t {
 
 		le_mesh_o *    ( * create                   ) ( );
@@ -20,12 +39,30 @@ struct le_mesh_api {
 		void (*get_colours  )( le_mesh_o *self, size_t* count, float const **   colours ); 	// 4 floats per vertex
 		void (*get_uvs      )( le_mesh_o *self, size_t* count, float const **   uvs     ); 	// 3 floats per vertex
 		void (*get_tangents )( le_mesh_o *self, size_t* count, float const **   tangents); 	// 3 floats per vertex
-		void (*get_indices  )( le_mesh_o *self, size_t* count, uint16_t const ** indices ); // 1 uint16_t per index
+		void (*get_indices  )( le_mesh_o *self, size_t* count, void const **     indices, IndexType* index_type ); // 1 uint16_t or uint32_t per index, depending on index_type
 
-		void (*get_data     )( le_mesh_o *self, size_t* numVertices, size_t* numIndices, float const** vertices, float const **normals, float const **uvs, float const  ** colours, uint16_t const **indices);
+		void (*get_data     )( le_mesh_o *self, size_t* numVertices, size_t* numIndices, float const** vertices, float const **normals, float const **uvs, float const  ** colours, void const **indices, IndexType* index_type);
 
+		// Loads ascii, and binary (little- or big-endian) PLY files. The file is memory-mapped; ascii
+		// files with many elements are parsed on all available le_jobs worker threads.
+		// Faces with more than three vertices are triangulated as fans.
 		bool (*load_from_ply_file)( le_mesh_o *self, char const *file_path );
 
+		// Reorders triangles for post-transform vertex cache locality, and vertices in order of first use,
+		// for vertex fetch locality. With `optimize_overdraw`, clusters of triangles which face away from
+		// the mesh centre get drawn first, which reduces overdraw at the cost of slightly worse cache use.
+		void  (*optimize      )( le_mesh_o* self, bool optimize_overdraw );
+
+		// Average cache miss ratio: vertices transformed per triangle, given a FIFO vertex cache
+		// of `cache_size` entries. 0.5 is ideal for large meshes, 3 is worst.
+		float (*get_acmr      )( le_mesh_o* self, uint32_t cache_size );
+
+		// Splits mesh into meshlets, for use with mesh shaders. Call `optimize` first: meshlets are filled
+		// with triangles in index order. `max_vertices` must not be larger than 256. Typical limits are
+		// 64 vertices, and 124 triangles.
+		bool  (*build_meshlets)( le_mesh_o* self, uint32_t max_vertices, uint32_t max_triangles );
+		void  (*get_meshlets  )( le_mesh_o* self, size_t* count, le_mesh_meshlet_t const ** meshlets, uint32_t const ** meshlet_vertices, uint8_t const ** meshlet_triangles );
+
 	};
 
 	le_mesh_interface_t       le_mesh_i;
@@ -80,18 +117,52 @@ class LeMesh : NoCopy, NoMove {
 		this_i.get_uvs( self, count, pUvs );
 	}
 
+	// Sets `*pIndices` to nullptr if the mesh uses 32 bit indices - use the overload with index type for such meshes.
 	void getIndices( size_t* count, uint16_t const** pIndices = nullptr ) {
-		this_i.get_indices( self, count, pIndices );
+		le_mesh_api::IndexType index_type;
+		this_i.get_indices( self, count, reinterpret_cast<void const**>( pIndices ), &index_type );
+		if ( pIndices && index_type != le_mesh_api::eIndexTypeUint16 ) {
+			*pIndices = nullptr;
+		}
 	}
 
+	void getIndices( size_t* count, void const** pIndices, le_mesh_api::IndexType* pIndexType ) {
+		this_i.get_indices( self, count, pIndices, pIndexType );
+	}
+
+	// Sets `*pIndices` to nullptr if the mesh uses 32 bit indices - use the overload with index type for such meshes.
 	void getData( size_t* numVertices, size_t* numIndices, float const** pVertices = nullptr, float const** pNormals = nullptr, float const** pUvs = nullptr, float const** pColours = nullptr, uint16_t const** pIndices = nullptr ) {
-		this_i.get_data( self, numVertices, numIndices, pVertices, pNormals, pUvs, pColours, pIndices );
+		le_mesh_api::IndexType index_type;
+		this_i.get_data( self, numVertices, numIndices, pVertices, pNormals, pUvs, pColours, reinterpret_cast<void const**>( pIndices ), &index_type );
+		if ( pIndices && index_type != le_mesh_api::eIndexTypeUint16 ) {
+			*pIndices = nullptr;
+		}
+	}
+
+	void getData( size_t* numVertices, size_t* numIndices, float const** pVertices, float const** pNormals, float const** pUvs, float const** pColours, void const** pIndices, le_mesh_api::IndexType* pIndexType ) {
+		this_i.get_data( self, numVertices, numIndices, pVertices, pNormals, pUvs, pColours, pIndices, pIndexType );
 	}
 
 	bool loadFromPlyFile( char const* file_path ) {
 		return this_i.load_from_ply_file( self, file_path );
 	}
 
+	void optimize( bool optimizeOverdraw = false ) {
+		this_i.optimize( self, optimizeOverdraw );
+	}
+
+	float getAcmr( uint32_t cacheSize = 16 ) {
+		return this_i.get_acmr( self, cacheSize );
+	}
+
+	bool buildMeshlets( uint32_t maxVertices = 64, uint32_t maxTriangles = 124 ) {
+		return this_i.build_meshlets( self, maxVertices, maxTriangles );
+	}
+
+	void getMeshlets( size_t* count, le_mesh_meshlet_t const** pMeshlets = nullptr, uint32_t const** pMeshletVertices = nullptr, uint8_t const** pMeshletTriangles = nullptr ) {
+		this_i.get_meshlets( self, count, pMeshlets, pMeshletVertices, pMeshletTriangles );
+	}
+
 	operator auto() {
 		return self;
 	}
@@ -4,14 +4,20 @@
 #include <stdint.h>
 #include <vector>
 #include "glm/glm.hpp"
+#include "le_mesh.h" // for le_mesh_meshlet_t
 
 struct le_mesh_o {
-	std::vector<uint16_t>  indices;  // list of indices
-	std::vector<glm::vec3> vertices; // 3d position in model space
-	std::vector<glm::vec3> normals;  // normalised normal, per-vertex
-	std::vector<glm::vec4> colours;  // rgba colour, per-vertex
-	std::vector<glm::vec2> uvs;      // uv coordintates    , per-vertex
-	std::vector<glm::vec3> tangents; // normalised tangents, per-vertex
+	std::vector<uint16_t>  indices;    // list of indices
+	std::vector<uint32_t>  indices_32; // list of indices, used instead of `indices` for meshes with more than 65536 vertices
+	std::vector<glm::vec3> vertices;   // 3d position in model space
+	std::vector<glm::vec3> normals;    // normalised normal, per-vertex
+	std::vector<glm::vec4> colours;    // rgba colour, per-vertex
+	std::vector<glm::vec2> uvs;        // uv coordintates    , per-vertex
+	std::vector<glm::vec3> tangents;   // normalised tangents, per-vertex
+
+	std::vector<le_mesh_meshlet_t> meshlets;          // built on demand, see `build_meshlets`
+	std::vector<uint32_t>          meshlet_vertices;  // indices into vertices, referenced by meshlets
+	std::vector<uint8_t>           meshlet_triangles; // 3 indices into meshlet vertices per triangle
 };
 
 #endif
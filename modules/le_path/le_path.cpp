@@ -1,4 +1,6 @@
 #include "le_path.h"
+#include "le_hash_util.h"
+#include "le_jobs.h"
 #include <vector>
 #include <algorithm>
 
@@ -6,6 +8,10 @@
 #include <cstdio>
 #include <cstdlib>
 
+#if defined( __AVX2__ ) || defined( __SSE2__ ) || defined( _M_X64 )
+#	include <immintrin.h>
+#endif
+
 #include "glm/glm.hpp"
 #include "glm/gtx/vector_query.hpp"
 #include "glm/gtx/vector_angle.hpp"
@@ -69,7 +75,9 @@ struct PathCommand {
 };
 
 struct Contour {
-	std::vector<PathCommand> commands; // svg-style commands+parameters creating the path
+	std::vector<PathCommand> commands;        // svg-style commands+parameters creating the path
+	uint64_t                 hash     = 0;    // cached hash over commands - only valid if not is_dirty
+	bool                     is_dirty = true; // must be set whenever commands change
 };
 
 struct Polyline {
@@ -79,9 +87,15 @@ struct Polyline {
 	float                  total_distance = 0;
 };
 
+struct StrokeCacheEntry {
+	uint64_t               key = 0;   // hash over contour commands and stroke attributes; 0 means empty
+	std::vector<glm::vec2> triangles; // tessellated stroke, three vertices per triangle
+};
+
 struct le_path_o {
-	std::vector<Contour>  contours;  // an array of sub-paths, a contour must start with a moveto instruction
-	std::vector<Polyline> polylines; // an array of polylines, each corresponding to a sub-path.
+	std::vector<Contour>          contours;     // an array of sub-paths, a contour must start with a moveto instruction
+	std::vector<Polyline>         polylines;    // an array of polylines, each corresponding to a sub-path.
+	std::vector<StrokeCacheEntry> stroke_cache; // tessellated strokes, one entry per contour index - survives `clear`
 };
 
 struct CubicBezier {
@@ -236,6 +250,66 @@ inline static bool is_contained_0_1( float f ) {
 	return ( f >= 0.f && f <= 1.f );
 }
 
+// ----------------------------------------------------------------------
+// Returns the number of segments into which a cubic bezier curve must be
+// subdivided uniformly (in parameter space), so that no point of the
+// resulting polyline is further than `tolerance` away from the curve.
+//
+// This is Wang's formula for cubics: n = sqrt( 3*2/8 * M / tolerance ),
+// where M is the largest magnitude of the curve's second differences.
+static inline uint32_t cubic_bezier_wang_segment_count( CubicBezier const& b, float tolerance ) {
+	glm::vec2 d0 = b.p0 - 2.f * b.c1 + b.c2;
+	glm::vec2 d1 = b.c1 - 2.f * b.c2 + b.p1;
+	float     m  = sqrtf( std::max( glm::dot( d0, d0 ), glm::dot( d1, d1 ) ) );
+	float     n  = ceilf( sqrtf( 0.75f * m / std::max( tolerance, std::numeric_limits<float>::epsilon() ) ) );
+	return uint32_t( clamp( n, 1.f, 1000.f ) );
+}
+
+// ----------------------------------------------------------------------
+// Returns an estimate for the number of vertices which flattening a contour
+// will produce - so that we may reserve memory for vertices once, upfront.
+// The estimate is an upper bound for curves, and for full ellipse arcs.
+static size_t contour_estimate_flattened_vertex_count( Contour const& contour, float tolerance ) {
+
+	size_t    count      = 0;
+	glm::vec2 prev_point = {};
+
+	tolerance = std::max( tolerance, std::numeric_limits<float>::epsilon() );
+
+	for ( auto const& command : contour.commands ) {
+		switch ( command.type ) {
+		case PathCommand::eQuadBezierTo: {
+			auto const& bez = command.data.as_quad_bezier;
+			CubicBezier b{
+			    prev_point,
+			    prev_point + 2 / 3.f * ( bez.c1 - prev_point ),
+			    command.p + 2 / 3.f * ( bez.c1 - command.p ),
+			    command.p,
+			};
+			count += cubic_bezier_wang_segment_count( b, tolerance );
+		} break;
+		case PathCommand::eCubicBezierTo: {
+			auto const& bez = command.data.as_cubic_bezier;
+			count += cubic_bezier_wang_segment_count( { prev_point, bez.c1, bez.c2, command.p }, tolerance );
+		} break;
+		case PathCommand::eArcTo: {
+			float r_max = std::max( fabsf( command.data.as_arc.radii.x ), fabsf( command.data.as_arc.radii.y ) );
+			if ( r_max > tolerance ) {
+				count += size_t( ceilf( glm::two_pi<float>() / acosf( 1.f - ( tolerance / r_max ) ) ) ) + 1;
+			} else {
+				count += 1;
+			}
+		} break;
+		default:
+			count += 1;
+			break;
+		}
+		prev_point = command.p;
+	}
+
+	return count;
+}
+
 // ----------------------------------------------------------------------
 
 static le_path_o* le_path_create() {
@@ -251,6 +325,8 @@ static void le_path_destroy( le_path_o* self ) {
 
 // ----------------------------------------------------------------------
 
+// Note that we keep the stroke cache, so that a path which gets cleared
+// and re-built with the same contours every frame may re-use strokes.
 static void le_path_clear( le_path_o* self ) {
 	self->contours.clear();
 	self->polylines.clear();
@@ -947,6 +1023,165 @@ static void flatten_cubic_bezier_segment_to( Polyline&          polyline,
 	}
 }
 
+// ----------------------------------------------------------------------
+// Evaluates a cubic bezier curve, and its first derivative, at `n` uniformly
+// spaced parameter values t = 1/n, 2/n, ..., n/n, and writes results into
+// `vertices`, and `tangents`, which must each have space for `n` elements.
+//
+// We evaluate the curve in polynomial form, B(t) = ((a*t + b)*t + c)*t + d,
+// so that all parameter values are independent of each other, and can be
+// evaluated side-by-side in SIMD lanes: 8 at a time with AVX2 (which we only
+// use if FMA is available, too - see LE_PATH_ENABLE_AVX2 in CMakeLists.txt),
+// 4 at a time with SSE, with a scalar loop for any leftovers.
+static void cubic_bezier_evaluate_uniform( CubicBezier const& bez, uint32_t n, glm::vec2* vertices, glm::vec2* tangents ) {
+
+	glm::vec2 const a = -bez.p0 + 3.f * bez.c1 - 3.f * bez.c2 + bez.p1;
+	glm::vec2 const b = 3.f * bez.p0 - 6.f * bez.c1 + 3.f * bez.c2;
+	glm::vec2 const c = -3.f * bez.p0 + 3.f * bez.c1;
+	glm::vec2 const d = bez.p0;
+
+	float const inv_n = 1.f / float( n );
+
+	uint32_t i = 0;
+
+	static_assert( sizeof( glm::vec2 ) == 2 * sizeof( float ), "vec2 must be tightly packed for SIMD stores" );
+
+#if defined( __AVX2__ ) && defined( __FMA__ )
+	{
+		__m256 const ax = _mm256_set1_ps( a.x ), ay = _mm256_set1_ps( a.y );
+		__m256 const bx = _mm256_set1_ps( b.x ), by = _mm256_set1_ps( b.y );
+		__m256 const cx = _mm256_set1_ps( c.x ), cy = _mm256_set1_ps( c.y );
+		__m256 const dx = _mm256_set1_ps( d.x ), dy = _mm256_set1_ps( d.y );
+
+		__m256 const a3x = _mm256_set1_ps( 3.f * a.x ), a3y = _mm256_set1_ps( 3.f * a.y );
+		__m256 const b2x = _mm256_set1_ps( 2.f * b.x ), b2y = _mm256_set1_ps( 2.f * b.y );
+
+		__m256 const lane_offsets = _mm256_setr_ps( 1, 2, 3, 4, 5, 6, 7, 8 );
+		__m256 const v_inv_n      = _mm256_set1_ps( inv_n );
+
+		for ( ; i + 8 <= n; i += 8 ) {
+			__m256 t = _mm256_mul_ps( _mm256_add_ps( _mm256_set1_ps( float( i ) ), lane_offsets ), v_inv_n );
+
+			__m256 px = _mm256_fmadd_ps( _mm256_fmadd_ps( _mm256_fmadd_ps( ax, t, bx ), t, cx ), t, dx );
+			__m256 py = _mm256_fmadd_ps( _mm256_fmadd_ps( _mm256_fmadd_ps( ay, t, by ), t, cy ), t, dy );
+			__m256 tx = _mm256_fmadd_ps( _mm256_fmadd_ps( a3x, t, b2x ), t, cx );
+			__m256 ty = _mm256_fmadd_ps( _mm256_fmadd_ps( a3y, t, b2y ), t, cy );
+
+			// Interleave x, and y - unpack works per 128 bit lane, which is why we must permute afterwards.
+			__m256 p_lo = _mm256_unpacklo_ps( px, py ); // x0 y0 x1 y1 | x4 y4 x5 y5
+			__m256 p_hi = _mm256_unpackhi_ps( px, py ); // x2 y2 x3 y3 | x6 y6 x7 y7
+			__m256 t_lo = _mm256_unpacklo_ps( tx, ty );
+			__m256 t_hi = _mm256_unpackhi_ps( tx, ty );
+
+			float* pv = reinterpret_cast<float*>( vertices + i );
+			float* pt = reinterpret_cast<float*>( tangents + i );
+
+			_mm256_storeu_ps( pv, _mm256_permute2f128_ps( p_lo, p_hi, 0x20 ) );
+			_mm256_storeu_ps( pv + 8, _mm256_permute2f128_ps( p_lo, p_hi, 0x31 ) );
+			_mm256_storeu_ps( pt, _mm256_permute2f128_ps( t_lo, t_hi, 0x20 ) );
+			_mm256_storeu_ps( pt + 8, _mm256_permute2f128_ps( t_lo, t_hi, 0x31 ) );
+		}
+	}
+#endif
+
+#if defined( __SSE2__ ) || defined( _M_X64 )
+	{
+		__m128 const ax = _mm_set1_ps( a.x ), ay = _mm_set1_ps( a.y );
+		__m128 const bx = _mm_set1_ps( b.x ), by = _mm_set1_ps( b.y );
+		__m128 const cx = _mm_set1_ps( c.x ), cy = _mm_set1_ps( c.y );
+		__m128 const dx = _mm_set1_ps( d.x ), dy = _mm_set1_ps( d.y );
+
+		__m128 const a3x = _mm_set1_ps( 3.f * a.x ), a3y = _mm_set1_ps( 3.f * a.y );
+		__m128 const b2x = _mm_set1_ps( 2.f * b.x ), b2y = _mm_set1_ps( 2.f * b.y );
+
+		__m128 const lane_offsets = _mm_setr_ps( 1, 2, 3, 4 );
+		__m128 const v_inv_n      = _mm_set1_ps( inv_n );
+
+		for ( ; i + 4 <= n; i += 4 ) {
+			__m128 t = _mm_mul_ps( _mm_add_ps( _mm_set1_ps( float( i ) ), lane_offsets ), v_inv_n );
+
+			__m128 px = _mm_add_ps( _mm_mul_ps( _mm_add_ps( _mm_mul_ps( _mm_add_ps( _mm_mul_ps( ax, t ), bx ), t ), cx ), t ), dx );
+			__m128 py = _mm_add_ps( _mm_mul_ps( _mm_add_ps( _mm_mul_ps( _mm_add_ps( _mm_mul_ps( ay, t ), by ), t ), cy ), t ), dy );
+			__m128 tx = _mm_add_ps( _mm_mul_ps( _mm_add_ps( _mm_mul_ps( a3x, t ), b2x ), t ), cx );
+			__m128 ty = _mm_add_ps( _mm_mul_ps( _mm_add_ps( _mm_mul_ps( a3y, t ), b2y ), t ), cy );
+
+			float* pv = reinterpret_cast<float*>( vertices + i );
+			float* pt = reinterpret_cast<float*>( tangents + i );
+
+			_mm_storeu_ps( pv, _mm_unpacklo_ps( px, py ) );     // x0 y0 x1 y1
+			_mm_storeu_ps( pv + 4, _mm_unpackhi_ps( px, py ) ); // x2 y2 x3 y3
+			_mm_storeu_ps( pt, _mm_unpacklo_ps( tx, ty ) );
+			_mm_storeu_ps( pt + 4, _mm_unpackhi_ps( tx, ty ) );
+		}
+	}
+#endif
+
+	// Scalar fallback, and leftovers
+
+	for ( ; i < n; i++ ) {
+		float t       = float( i + 1 ) * inv_n;
+		vertices[ i ] = ( ( a * t + b ) * t + c ) * t + d;
+		tangents[ i ] = ( 3.f * a * t + 2.f * b ) * t + c;
+	}
+
+	// Make sure that the last vertex sits exactly on the end point, independent of rounding.
+	vertices[ n - 1 ] = bez.p1;
+}
+
+// ----------------------------------------------------------------------
+// Flatten a cubic bezier curve by subdividing it into a number of uniform
+// segments, which we calculate upfront using Wang's formula. This means we
+// know the exact number of vertices before we generate them, and that we
+// can evaluate all vertices in parallel.
+//
+// Compared with `flatten_cubic_bezier_to`, this generally creates more
+// vertices for the same tolerance, but it does so with much less work.
+static void flatten_cubic_bezier_uniform_to( Polyline&        polyline,
+                                             glm::vec2 const& p1,       // end point
+                                             glm::vec2 const& c1,       // control point 1
+                                             glm::vec2 const& c2,       // control point 2
+                                             float            tolerance // max distance for arc segment
+) {
+
+	assert( !polyline.vertices.empty() ); // Contour vertices must not be empty.
+
+	CubicBezier const b{
+	    polyline.vertices.back(),
+	    c1,
+	    c2,
+	    p1,
+	};
+
+	uint32_t const n = cubic_bezier_wang_segment_count( b, tolerance );
+
+	if ( n == 1 ) {
+		// Curve is flat enough to be a straight line.
+		trace_line_to( polyline, p1 );
+		return;
+	}
+
+	size_t const first = polyline.vertices.size();
+
+	polyline.vertices.resize( first + n );
+	polyline.tangents.resize( polyline.tangents.size() + n );
+
+	cubic_bezier_evaluate_uniform( b, n, polyline.vertices.data() + first, polyline.tangents.data() + polyline.tangents.size() - n );
+
+	// Distances are a running sum, which means we must calculate them in sequence.
+
+	polyline.distances.reserve( polyline.distances.size() + n );
+
+	glm::vec2 const* v      = polyline.vertices.data() + first;
+	glm::vec2 const* v_end  = v + n;
+	glm::vec2        p_prev = b.p0;
+
+	for ( ; v != v_end; v++ ) {
+		polyline.total_distance += glm::distance( *v, p_prev );
+		polyline.distances.emplace_back( polyline.total_distance );
+		p_prev = *v;
+	}
+}
+
 // ----------------------------------------------------------------------
 // Flatten a cubic bezier curve from previous point p0 to target point p3
 // controlled by control points p1, and p2.
@@ -1084,34 +1319,26 @@ static glm::vec2 get_arc_tangent_at_normalised_t( glm::vec2 const& p0, // end po
 }
 
 // ----------------------------------------------------------------------
-// translates arc into straight polylines - while respecting tolerance.
-static void flatten_arc_to( Polyline&        polyline,
-                            glm::vec2 const& p1, // end point
-                            glm::vec2 const& radii,
-                            float            phi,
-                            bool             large_arc,
-                            bool             sweep,
-                            float            tolerance ) {
-
-	assert( !polyline.vertices.empty() ); // Contour vertices must not be empty.
-
-	// If any or both of radii.x or radii.y is 0, then we must treat the
-	// arc as a straight line:
-	//
-	if ( fabsf( radii.x * radii.y ) <= std::numeric_limits<float>::epsilon() ) {
-		trace_line_to( polyline, p1 );
-		return;
-	}
-
-	// ---------| Invariant: radii.x and radii.y are not 0.
-
-	glm::vec2 const p0 = polyline.vertices.back(); // copy start point
+// Converts an svg-style arc from endpoint form into centre form, following the
+// implementation notes of the w3/svg standards group.
+//
+// See: <https://www.w3.org/TR/SVG/implnote.html#ArcConversionEndpointToCenter>
+//
+// Points on the arc are `inv_basis * ( r * {cos(theta), sin(theta)} ) + c`, with
+// theta going from `theta_1` to `theta_1 + theta_delta`. Returns false if the arc
+// has no extent, in which case nothing needs to be drawn.
+static bool arc_endpoint_to_centre( glm::vec2 const& p0,
+                                    glm::vec2 const& p1,
+                                    glm::vec2 const& radii,
+                                    float            phi,
+                                    bool             large_arc,
+                                    bool             sweep,
+                                    glm::vec2*       centre,
+                                    glm::vec2*       radii_corrected,
+                                    glm::mat2*       inv_basis_,
+                                    float*           theta_1_,
+                                    float*           theta_delta_ ) {
 
-	// First, we perform an endpoint to centre form conversion, following the
-	// implementation notes of the w3/svg standards group.
-	//
-	// See: <https://www.w3.org/TR/SVG/implnote.html#ArcConversionEndpointToCenter>
-	//
 	glm::vec2 x_axis{ cosf( phi ), sinf( phi ) };
 	glm::vec2 y_axis{ -x_axis.y, x_axis.x };
 	glm::mat2 basis{ x_axis, y_axis };
@@ -1176,6 +1403,49 @@ static void flatten_arc_to( Polyline&        polyline,
 	}
 
 	if ( fabsf( theta_delta ) <= std::numeric_limits<float>::epsilon() ) {
+		return false;
+	}
+
+	*centre          = c;
+	*radii_corrected = r;
+	*inv_basis_      = inv_basis;
+	*theta_1_        = theta_1;
+	*theta_delta_    = theta_delta;
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+// translates arc into straight polylines - while respecting tolerance.
+static void flatten_arc_to( Polyline&        polyline,
+                            glm::vec2 const& p1, // end point
+                            glm::vec2 const& radii,
+                            float            phi,
+                            bool             large_arc,
+                            bool             sweep,
+                            float            tolerance ) {
+
+	assert( !polyline.vertices.empty() ); // Contour vertices must not be empty.
+
+	// If any or both of radii.x or radii.y is 0, then we must treat the
+	// arc as a straight line:
+	//
+	if ( fabsf( radii.x * radii.y ) <= std::numeric_limits<float>::epsilon() ) {
+		trace_line_to( polyline, p1 );
+		return;
+	}
+
+	// ---------| Invariant: radii.x and radii.y are not 0.
+
+	glm::vec2 const p0 = polyline.vertices.back(); // copy start point
+
+	glm::vec2 c;
+	glm::vec2 r;
+	glm::mat2 inv_basis;
+	float     theta_1;
+	float     theta_delta;
+
+	if ( !arc_endpoint_to_centre( p0, p1, radii, phi, large_arc, sweep, &c, &r, &inv_basis, &theta_1, &theta_delta ) ) {
 		return;
 	}
 
@@ -1224,8 +1494,196 @@ static void flatten_arc_to( Polyline&        polyline,
 }
 
 // ----------------------------------------------------------------------
+// Evaluates an arc in centre form, and its first derivative, at `n` uniformly
+// spaced angles theta_1 + theta_delta * ( 1/n, 2/n, ..., n/n ), and writes results
+// into `vertices`, and `tangents`, which must each have space for `n` elements.
+//
+// With e_x = inv_basis[0] * r.x, and e_y = inv_basis[1] * r.y, a point on the arc
+// is e_x * cos(theta) + e_y * sin(theta) + c. Rather than calling cos, and sin for
+// each lane, we calculate cos, and sin only once for the first angle of each batch
+// of lanes, and rotate this by precalculated per-lane angle offsets. Like
+// `cubic_bezier_evaluate_uniform`, this uses 8 lanes with AVX2 (and FMA), 4 lanes
+// with SSE, and a scalar loop for any leftovers.
+static void arc_evaluate_uniform( glm::vec2 const& c, glm::vec2 const& r, glm::mat2 const& inv_basis, float theta_1, float theta_delta, uint32_t n, glm::vec2* vertices, glm::vec2* tangents ) {
 
-static void le_path_flatten_path( le_path_o* self, float tolerance ) {
+	glm::vec2 const e_x = inv_basis[ 0 ] * r.x;
+	glm::vec2 const e_y = inv_basis[ 1 ] * r.y;
+
+	float const d_theta = theta_delta / float( n );
+
+	uint32_t i = 0;
+
+	static_assert( sizeof( glm::vec2 ) == 2 * sizeof( float ), "vec2 must be tightly packed for SIMD stores" );
+
+#if defined( __AVX2__ ) && defined( __FMA__ )
+	if ( i + 8 <= n ) {
+		alignas( 32 ) float lane_cos[ 8 ];
+		alignas( 32 ) float lane_sin[ 8 ];
+
+		for ( int l = 0; l != 8; l++ ) {
+			lane_cos[ l ] = cosf( d_theta * float( l + 1 ) );
+			lane_sin[ l ] = sinf( d_theta * float( l + 1 ) );
+		}
+
+		__m256 const oc = _mm256_load_ps( lane_cos ), os = _mm256_load_ps( lane_sin );
+
+		__m256 const exx = _mm256_set1_ps( e_x.x ), exy = _mm256_set1_ps( e_x.y );
+		__m256 const eyx = _mm256_set1_ps( e_y.x ), eyy = _mm256_set1_ps( e_y.y );
+		__m256 const cx = _mm256_set1_ps( c.x ), cy = _mm256_set1_ps( c.y );
+
+		for ( ; i + 8 <= n; i += 8 ) {
+			float const  base = theta_1 + d_theta * float( i );
+			__m256 const bc   = _mm256_set1_ps( cosf( base ) );
+			__m256 const bs   = _mm256_set1_ps( sinf( base ) );
+
+			// cos( base + offset ), sin( base + offset )
+			__m256 cos_t = _mm256_fmsub_ps( bc, oc, _mm256_mul_ps( bs, os ) );
+			__m256 sin_t = _mm256_fmadd_ps( bs, oc, _mm256_mul_ps( bc, os ) );
+
+			__m256 px = _mm256_fmadd_ps( exx, cos_t, _mm256_fmadd_ps( eyx, sin_t, cx ) );
+			__m256 py = _mm256_fmadd_ps( exy, cos_t, _mm256_fmadd_ps( eyy, sin_t, cy ) );
+			__m256 tx = _mm256_fmsub_ps( eyx, cos_t, _mm256_mul_ps( exx, sin_t ) );
+			__m256 ty = _mm256_fmsub_ps( eyy, cos_t, _mm256_mul_ps( exy, sin_t ) );
+
+			// Interleave x, and y - unpack works per 128 bit lane, which is why we must permute afterwards.
+			__m256 p_lo = _mm256_unpacklo_ps( px, py );
+			__m256 p_hi = _mm256_unpackhi_ps( px, py );
+			__m256 t_lo = _mm256_unpacklo_ps( tx, ty );
+			__m256 t_hi = _mm256_unpackhi_ps( tx, ty );
+
+			float* pv = reinterpret_cast<float*>( vertices + i );
+			float* pt = reinterpret_cast<float*>( tangents + i );
+
+			_mm256_storeu_ps( pv, _mm256_permute2f128_ps( p_lo, p_hi, 0x20 ) );
+			_mm256_storeu_ps( pv + 8, _mm256_permute2f128_ps( p_lo, p_hi, 0x31 ) );
+			_mm256_storeu_ps( pt, _mm256_permute2f128_ps( t_lo, t_hi, 0x20 ) );
+			_mm256_storeu_ps( pt + 8, _mm256_permute2f128_ps( t_lo, t_hi, 0x31 ) );
+		}
+	}
+#endif
+
+#if defined( __SSE2__ ) || defined( _M_X64 )
+	if ( i + 4 <= n ) {
+		__m128 const oc = _mm_setr_ps( cosf( d_theta ), cosf( 2 * d_theta ), cosf( 3 * d_theta ), cosf( 4 * d_theta ) );
+		__m128 const os = _mm_setr_ps( sinf( d_theta ), sinf( 2 * d_theta ), sinf( 3 * d_theta ), sinf( 4 * d_theta ) );
+
+		__m128 const exx = _mm_set1_ps( e_x.x ), exy = _mm_set1_ps( e_x.y );
+		__m128 const eyx = _mm_set1_ps( e_y.x ), eyy = _mm_set1_ps( e_y.y );
+		__m128 const cx = _mm_set1_ps( c.x ), cy = _mm_set1_ps( c.y );
+
+		for ( ; i + 4 <= n; i += 4 ) {
+			float const  base = theta_1 + d_theta * float( i );
+			__m128 const bc   = _mm_set1_ps( cosf( base ) );
+			__m128 const bs   = _mm_set1_ps( sinf( base ) );
+
+			// cos( base + offset ), sin( base + offset )
+			__m128 cos_t = _mm_sub_ps( _mm_mul_ps( bc, oc ), _mm_mul_ps( bs, os ) );
+			__m128 sin_t = _mm_add_ps( _mm_mul_ps( bs, oc ), _mm_mul_ps( bc, os ) );
+
+			__m128 px = _mm_add_ps( _mm_add_ps( _mm_mul_ps( exx, cos_t ), _mm_mul_ps( eyx, sin_t ) ), cx );
+			__m128 py = _mm_add_ps( _mm_add_ps( _mm_mul_ps( exy, cos_t ), _mm_mul_ps( eyy, sin_t ) ), cy );
+			__m128 tx = _mm_sub_ps( _mm_mul_ps( eyx, cos_t ), _mm_mul_ps( exx, sin_t ) );
+			__m128 ty = _mm_sub_ps( _mm_mul_ps( eyy, cos_t ), _mm_mul_ps( exy, sin_t ) );
+
+			float* pv = reinterpret_cast<float*>( vertices + i );
+			float* pt = reinterpret_cast<float*>( tangents + i );
+
+			_mm_storeu_ps( pv, _mm_unpacklo_ps( px, py ) );     // x0 y0 x1 y1
+			_mm_storeu_ps( pv + 4, _mm_unpackhi_ps( px, py ) ); // x2 y2 x3 y3
+			_mm_storeu_ps( pt, _mm_unpacklo_ps( tx, ty ) );
+			_mm_storeu_ps( pt + 4, _mm_unpackhi_ps( tx, ty ) );
+		}
+	}
+#endif
+
+	// Scalar fallback, and leftovers
+
+	for ( ; i < n; i++ ) {
+		float const theta = theta_1 + d_theta * float( i + 1 );
+		float const cos_t = cosf( theta );
+		float const sin_t = sinf( theta );
+		vertices[ i ]     = e_x * cos_t + e_y * sin_t + c;
+		tangents[ i ]     = e_y * cos_t - e_x * sin_t;
+	}
+}
+
+// ----------------------------------------------------------------------
+// Flatten an arc by subdividing it into a number of segments of equal angle,
+// which we calculate upfront from the largest radius - uniform counterpart
+// to `flatten_arc_to`, and used by `flatten_uniform`.
+static void flatten_arc_uniform_to( Polyline&        polyline,
+                                    glm::vec2 const& p1, // end point
+                                    glm::vec2 const& radii,
+                                    float            phi,
+                                    bool             large_arc,
+                                    bool             sweep,
+                                    float            tolerance ) {
+
+	assert( !polyline.vertices.empty() ); // Contour vertices must not be empty.
+
+	// If any or both of radii.x or radii.y is 0, then we must treat the
+	// arc as a straight line:
+	//
+	if ( fabsf( radii.x * radii.y ) <= std::numeric_limits<float>::epsilon() ) {
+		trace_line_to( polyline, p1 );
+		return;
+	}
+
+	// ---------| Invariant: radii.x and radii.y are not 0.
+
+	glm::vec2 const p0 = polyline.vertices.back(); // copy start point
+
+	glm::vec2 c;
+	glm::vec2 r;
+	glm::mat2 inv_basis;
+	float     theta_1;
+	float     theta_delta;
+
+	if ( !arc_endpoint_to_centre( p0, p1, radii, phi, large_arc, sweep, &c, &r, &inv_basis, &theta_1, &theta_delta ) ) {
+		return;
+	}
+
+	// --------- | Invariant: delta_theta is not zero.
+
+	// The largest step which keeps the chord within tolerance of the arc is where
+	// the arc is least curved, which is where the radius is largest. We use the same
+	// upper bound for the number of segments as `flatten_arc_to`.
+	float const r_max = std::max( r.x, r.y );
+	float const step  = tolerance < r_max ? acosf( 1 - ( tolerance / r_max ) ) : glm::pi<float>();
+
+	uint32_t const n = uint32_t( std::clamp( ceilf( fabsf( theta_delta ) / step ), 1.f, 1000.f ) );
+
+	size_t const first = polyline.vertices.size();
+
+	polyline.vertices.resize( first + n );
+	polyline.tangents.resize( polyline.tangents.size() + n );
+
+	arc_evaluate_uniform( c, r, inv_basis, theta_1, theta_delta, n, polyline.vertices.data() + first, polyline.tangents.data() + polyline.tangents.size() - n );
+
+	// Make sure that the last vertex sits exactly on the end point, independent of rounding.
+	polyline.vertices.back() = p1;
+
+	// Distances are a running sum, which means we must calculate them in sequence.
+
+	polyline.distances.reserve( polyline.distances.size() + n );
+
+	glm::vec2 const* v      = polyline.vertices.data() + first;
+	glm::vec2 const* v_end  = v + n;
+	glm::vec2        p_prev = p0;
+
+	for ( ; v != v_end; v++ ) {
+		polyline.total_distance += glm::distance( *v, p_prev );
+		polyline.distances.emplace_back( polyline.total_distance );
+		p_prev = *v;
+	}
+}
+
+// ----------------------------------------------------------------------
+
+// If `uniform` is set, bezier curves, and arcs are flattened by uniform subdivision,
+// otherwise by adaptive subdivision - see `flatten_cubic_bezier_uniform_to`, and
+// `flatten_arc_uniform_to`.
+static void flatten_path( le_path_o* self, float tolerance, bool uniform ) {
 
 	self->polylines.clear();
 	self->polylines.reserve( self->contours.size() );
@@ -1234,8 +1692,17 @@ static void le_path_flatten_path( le_path_o* self, float tolerance ) {
 
 		Polyline polyline;
 
+		// Reserve memory upfront, so that polyline vectors don't need to grow one element at a time.
+		size_t const num_vertices_estimate = contour_estimate_flattened_vertex_count( s, tolerance );
+		polyline.vertices.reserve( num_vertices_estimate );
+		polyline.tangents.reserve( num_vertices_estimate );
+		polyline.distances.reserve( num_vertices_estimate );
+
 		glm::vec2 prev_point = {};
 
+		auto flatten_cubic_bezier = uniform ? flatten_cubic_bezier_uniform_to : flatten_cubic_bezier_to;
+		auto flatten_arc          = uniform ? flatten_arc_uniform_to : flatten_arc_to;
+
 		for ( auto const& command : s.commands ) {
 
 			switch ( command.type ) {
@@ -1249,25 +1716,25 @@ static void le_path_flatten_path( le_path_o* self, float tolerance ) {
 				break;
 			case PathCommand::eQuadBezierTo: {
 				auto& bez = command.data.as_quad_bezier;
-				flatten_cubic_bezier_to( polyline,
-				                         command.p,
-				                         prev_point + 2 / 3.f * ( bez.c1 - prev_point ),
-				                         command.p + 2 / 3.f * ( bez.c1 - command.p ),
-				                         tolerance );
+				flatten_cubic_bezier( polyline,
+				                      command.p,
+				                      prev_point + 2 / 3.f * ( bez.c1 - prev_point ),
+				                      command.p + 2 / 3.f * ( bez.c1 - command.p ),
+				                      tolerance );
 				prev_point = command.p;
 			} break;
 			case PathCommand::eCubicBezierTo: {
 				auto& bez = command.data.as_cubic_bezier;
-				flatten_cubic_bezier_to( polyline,
-				                         command.p,
-				                         bez.c1,
-				                         bez.c2,
-				                         tolerance );
+				flatten_cubic_bezier( polyline,
+				                      command.p,
+				                      bez.c1,
+				                      bez.c2,
+				                      tolerance );
 				prev_point = command.p;
 			} break;
 			case PathCommand::eArcTo: {
 				auto& arc = command.data.as_arc;
-				flatten_arc_to( polyline, command.p, arc.radii, arc.phi, arc.large_arc, arc.sweep, tolerance );
+				flatten_arc( polyline, command.p, arc.radii, arc.phi, arc.large_arc, arc.sweep, tolerance );
 				prev_point = command.p;
 			} break;
 			case PathCommand::eClosePath:
@@ -1281,12 +1748,24 @@ static void le_path_flatten_path( le_path_o* self, float tolerance ) {
 
 		assert( polyline.vertices.size() == polyline.distances.size() );
 
-		self->polylines.emplace_back( polyline );
+		self->polylines.emplace_back( std::move( polyline ) );
 	}
 }
 
 // ----------------------------------------------------------------------
 
+static void le_path_flatten_path( le_path_o* self, float tolerance ) {
+	flatten_path( self, tolerance, false );
+}
+
+// ----------------------------------------------------------------------
+
+static void le_path_flatten_path_uniform( le_path_o* self, float tolerance ) {
+	flatten_path( self, tolerance, true );
+}
+
+// ----------------------------------------------------------------------
+
 static void generate_offset_outline_line_to( std::vector<glm::vec2>& outline, glm::vec2 const& p0, glm::vec2 const& p1, float offset ) {
 
 	if ( p1 == p0 ) {
@@ -1659,15 +2138,19 @@ static bool le_path_generate_offset_outline_for_contour(
 	std::vector<glm::vec2> outline_l;
 	std::vector<glm::vec2> outline_r;
 
-	outline_l.reserve( *max_count_outline_l );
-	outline_r.reserve( *max_count_outline_r );
+	auto& s = self->contours[ contour_index ];
+
+	// Each flattened line segment results in up to two outline vertices per side.
+	size_t const num_vertices_estimate = 2 * contour_estimate_flattened_vertex_count( s, tolerance );
+
+	outline_l.reserve( std::max( *max_count_outline_l, num_vertices_estimate ) );
+	outline_r.reserve( std::max( *max_count_outline_r, num_vertices_estimate ) );
 
 	// Now process the commands for this contour
 
 	glm::vec2 prev_point  = {};
 	float     line_offset = line_weight * 0.5f;
 
-	auto& s = self->contours[ contour_index ];
 	for ( auto const& command : s.commands ) {
 
 		switch ( command.type ) {
@@ -2095,16 +2578,11 @@ void tessellate_outline_l_r( std::vector<glm::vec2>& triangles, std::vector<glm:
 
 // ----------------------------------------------------------------------
 
-bool le_path_tessellate_thick_contour( le_path_o* self, size_t contour_index, le_path_api::stroke_attribute_t const* stroke_attributes, glm::vec2* vertices, size_t* num_vertices ) {
-	std::vector<glm::vec2> triangles;
-
-	triangles.reserve( *num_vertices );
-
-	auto& contour = self->contours[ contour_index ];
+// Tessellates stroke for contour into triangles, which are appended to `triangles`.
+static void tessellate_thick_contour( Contour const& contour, stroke_attribute_t const* stroke_attributes, std::vector<glm::vec2>& triangles ) {
 
 	if ( contour.commands.empty() ) {
-		*num_vertices = 0;
-		return true;
+		return;
 	}
 
 	// ---------| Invariant: There are commands to render
@@ -2234,8 +2712,8 @@ bool le_path_tessellate_thick_contour( le_path_o* self, size_t contour_index, le
 
 			// we must find out tangent into the path
 
-			PathCommand* tail = &contour.commands.front();
-			PathCommand* head = &contour.commands.back();
+			PathCommand const* tail = &contour.commands.front();
+			PathCommand const* head = &contour.commands.back();
 
 			glm::vec2 tangent_head{};
 			glm::vec2 tangent_tail{};
@@ -2252,20 +2730,6 @@ bool le_path_tessellate_thick_contour( le_path_o* self, size_t contour_index, le
 		}
 	}
 
-	//
-
-	bool success = true;
-
-	if ( vertices && triangles.size() <= *num_vertices ) {
-		memcpy( vertices, triangles.data(), sizeof( glm::vec2 ) * triangles.size() );
-	} else {
-		success = false;
-	}
-
-	// update outline counts with actual number of generated vertices.
-	*num_vertices = triangles.size();
-
-	return success;
 }
 
 // ----------------------------------------------------------------------
@@ -2459,6 +2923,7 @@ static void le_path_line_to( le_path_o* self, glm::vec2 const* p ) {
 	}
 	assert( !self->contours.empty() ); // subpath must exist
 	self->contours.back().commands.emplace_back( PathCommand::eLineTo, *p );
+	self->contours.back().is_dirty = true;
 }
 
 // ----------------------------------------------------------------------
@@ -2525,6 +2990,7 @@ static void le_path_line_vert_to( le_path_o* self, float py ) {
 static void le_path_quad_bezier_to( le_path_o* self, glm::vec2 const* p, glm::vec2 const* c1 ) {
 	assert( !self->contours.empty() ); // contour must exist
 	self->contours.back().commands.emplace_back( *p, PathCommand::Data::AsQuadBezier{ *c1 } );
+	self->contours.back().is_dirty = true;
 }
 
 // ----------------------------------------------------------------------
@@ -2532,6 +2998,7 @@ static void le_path_quad_bezier_to( le_path_o* self, glm::vec2 const* p, glm::ve
 static void le_path_cubic_bezier_to( le_path_o* self, glm::vec2 const* p, glm::vec2 const* c1, glm::vec2 const* c2 ) {
 	assert( !self->contours.empty() ); // subpath must exist
 	self->contours.back().commands.emplace_back( *p, PathCommand::Data::AsCubicBezier{ *c1, *c2 } );
+	self->contours.back().is_dirty = true;
 }
 
 // ----------------------------------------------------------------------
@@ -2539,12 +3006,14 @@ static void le_path_cubic_bezier_to( le_path_o* self, glm::vec2 const* p, glm::v
 static void le_path_arc_to( le_path_o* self, glm::vec2 const* p, glm::vec2 const* radii, float phi, bool large_arc, bool sweep ) {
 	assert( !self->contours.empty() ); // subpath must exist
 	self->contours.back().commands.emplace_back( *p, PathCommand::Data::AsArc{ *radii, phi, large_arc, sweep } );
+	self->contours.back().is_dirty = true;
 }
 
 // ----------------------------------------------------------------------
 
 static void le_path_close_path( le_path_o* self ) {
 	self->contours.back().commands.emplace_back( PathCommand::eClosePath, glm::vec2{} );
+	self->contours.back().is_dirty = true;
 }
 
 // ----------------------------------------------------------------------
@@ -2760,6 +3229,8 @@ static void le_path_apply_hobby_on_last_contour( le_path_o* self ) {
 	} else {
 		path_commands_apply_hobby_open( commands );
 	}
+
+	self->contours.back().is_dirty = true;
 }
 
 // ----------------------------------------------------------------------
@@ -2796,6 +3267,206 @@ static size_t le_path_get_num_contours( le_path_o* self ) {
 
 // ----------------------------------------------------------------------
 
+static inline uint64_t fnv1a_64_bytes( void const* data, size_t num_bytes, uint64_t hash = FNV1A_VAL_64_CONST ) {
+	auto const* c     = static_cast<uint8_t const*>( data );
+	auto const* c_end = c + num_bytes;
+	for ( ; c != c_end; c++ ) {
+		hash = ( hash ^ *c ) * FNV1A_PRIME_64_CONST;
+	}
+	return hash;
+}
+
+// Hashes command parameters field-by-field, as PathCommand may contain padding
+// and unused union bytes which are not initialised.
+static uint64_t contour_calculate_hash( Contour const& contour, uint64_t hash = FNV1A_VAL_64_CONST ) {
+
+	for ( auto const& c : contour.commands ) {
+		hash = fnv1a_64_bytes( &c.type, sizeof( c.type ), hash );
+		hash = fnv1a_64_bytes( &c.p, sizeof( c.p ), hash );
+
+		switch ( c.type ) {
+		case PathCommand::eQuadBezierTo:
+			hash = fnv1a_64_bytes( &c.data.as_quad_bezier.c1, sizeof( glm::vec2 ), hash );
+			break;
+		case PathCommand::eCubicBezierTo:
+			hash = fnv1a_64_bytes( &c.data.as_cubic_bezier.c1, sizeof( glm::vec2 ), hash );
+			hash = fnv1a_64_bytes( &c.data.as_cubic_bezier.c2, sizeof( glm::vec2 ), hash );
+			break;
+		case PathCommand::eArcTo: {
+			uint32_t flags = ( c.data.as_arc.large_arc ? 1 : 0 ) | ( c.data.as_arc.sweep ? 2 : 0 );
+			hash           = fnv1a_64_bytes( &c.data.as_arc.radii, sizeof( glm::vec2 ), hash );
+			hash           = fnv1a_64_bytes( &c.data.as_arc.phi, sizeof( float ), hash );
+			hash           = fnv1a_64_bytes( &flags, sizeof( flags ), hash );
+		} break;
+		default:
+			break;
+		}
+	}
+
+	return hash;
+}
+
+// ----------------------------------------------------------------------
+
+// Returns hash over contour commands - only recalculates hash if contour has changed.
+static uint64_t contour_get_hash( Contour& contour ) {
+	if ( contour.is_dirty ) {
+		contour.hash     = contour_calculate_hash( contour );
+		contour.is_dirty = false;
+	}
+	return contour.hash;
+}
+
+// ----------------------------------------------------------------------
+
+static uint64_t le_path_get_hash( le_path_o* self ) {
+	uint64_t hash = FNV1A_VAL_64_CONST;
+	for ( auto& contour : self->contours ) {
+		// Combining per-contour hashes also marks contour boundaries, so that
+		// moving a command from one contour to the next results in a different hash.
+		uint64_t contour_hash = contour_get_hash( contour );
+		hash                  = fnv1a_64_bytes( &contour_hash, sizeof( contour_hash ), hash );
+	}
+	return hash;
+}
+
+// ----------------------------------------------------------------------
+
+// Returns key for stroke cache - combines contour hash with stroke attributes.
+static uint64_t stroke_cache_calculate_key( Contour& contour, stroke_attribute_t const* sa ) {
+	uint64_t hash = contour_get_hash( contour );
+	hash          = fnv1a_64_bytes( &sa->tolerance, sizeof( sa->tolerance ), hash );
+	hash          = fnv1a_64_bytes( &sa->width, sizeof( sa->width ), hash );
+	hash          = fnv1a_64_bytes( &sa->line_join_type, sizeof( sa->line_join_type ), hash );
+	hash          = fnv1a_64_bytes( &sa->line_cap_type, sizeof( sa->line_cap_type ), hash );
+	return hash ? hash : 1; // key 0 is reserved to mark empty entries
+}
+
+// ----------------------------------------------------------------------
+
+// Returns cache entry holding the stroke for contour at contour_index - re-tessellates
+// the stroke only if the contour, or the stroke attributes, have changed.
+static StrokeCacheEntry const& le_path_get_stroke( le_path_o* self, size_t contour_index, stroke_attribute_t const* stroke_attributes ) {
+
+	assert( contour_index < self->contours.size() );
+
+	if ( self->stroke_cache.size() < self->contours.size() ) {
+		self->stroke_cache.resize( self->contours.size() );
+	}
+
+	auto&    entry = self->stroke_cache[ contour_index ];
+	uint64_t key   = stroke_cache_calculate_key( self->contours[ contour_index ], stroke_attributes );
+
+	if ( entry.key != key ) {
+		entry.triangles.clear(); // keeps capacity, so that we may reuse memory
+		tessellate_thick_contour( self->contours[ contour_index ], stroke_attributes, entry.triangles );
+		entry.key = key;
+	}
+
+	return entry;
+}
+
+// ----------------------------------------------------------------------
+
+bool le_path_tessellate_thick_contour( le_path_o* self, size_t contour_index, le_path_api::stroke_attribute_t const* stroke_attributes, glm::vec2* vertices, size_t* num_vertices ) {
+
+	auto const& triangles = le_path_get_stroke( self, contour_index, stroke_attributes ).triangles;
+
+	bool success = true;
+
+	if ( vertices && triangles.size() <= *num_vertices ) {
+		memcpy( vertices, triangles.data(), sizeof( glm::vec2 ) * triangles.size() );
+	} else {
+		success = false;
+	}
+
+	// update outline counts with actual number of generated vertices.
+	*num_vertices = triangles.size();
+
+	return success;
+}
+
+// ----------------------------------------------------------------------
+
+static size_t le_path_get_thick_contour_vertex_count( le_path_o* self, size_t contour_index, le_path_api::stroke_attribute_t const* stroke_attributes ) {
+	return le_path_get_stroke( self, contour_index, stroke_attributes ).triangles.size();
+}
+
+// ----------------------------------------------------------------------
+
+struct tessellate_strokes_job_params_t {
+	Contour const*            contour;
+	stroke_attribute_t const* stroke_attributes;
+	StrokeCacheEntry*         entry;
+};
+
+static void tessellate_stroke_job( void* p_params ) {
+	auto params = static_cast<tessellate_strokes_job_params_t*>( p_params );
+	params->entry->triangles.clear();
+	tessellate_thick_contour( *params->contour, params->stroke_attributes, params->entry->triangles );
+}
+
+// ----------------------------------------------------------------------
+
+// Re-tessellates strokes for all contours which have changed since they were last
+// tessellated - using worker threads if the job system is available.
+static void le_path_update_thick_contours( le_path_o* self, le_path_api::stroke_attribute_t const* stroke_attributes ) {
+
+	size_t const num_contours = self->contours.size();
+
+	if ( self->stroke_cache.size() < num_contours ) {
+		self->stroke_cache.resize( num_contours );
+	}
+
+	// Find contours which need re-tessellating. We calculate keys up-front, on
+	// this thread, as calculating a key may update the hash cached with a contour.
+
+	std::vector<tessellate_strokes_job_params_t> params;
+	std::vector<uint64_t>                        keys;
+
+	for ( size_t i = 0; i != num_contours; i++ ) {
+		uint64_t key = stroke_cache_calculate_key( self->contours[ i ], stroke_attributes );
+		if ( self->stroke_cache[ i ].key != key ) {
+			params.push_back( { &self->contours[ i ], stroke_attributes, &self->stroke_cache[ i ] } );
+			keys.push_back( key );
+		}
+	}
+
+	if ( params.empty() ) {
+		return;
+	}
+
+	// ---------| invariant: at least one contour needs re-tessellating
+
+	uint32_t const num_workers = le_jobs::get_worker_thread_count();
+
+	if ( num_workers == 0 || params.size() == 1 ) {
+		// Job system not available: tessellate on the calling thread.
+		for ( auto& p : params ) {
+			tessellate_stroke_job( &p );
+		}
+	} else {
+		std::vector<le_jobs::job_t> jobs;
+		jobs.reserve( params.size() );
+
+		for ( auto& p : params ) {
+			jobs.push_back( { tessellate_stroke_job, &p } );
+		}
+
+		// We may submit all jobs at once: should the job queue fill up, run_jobs
+		// blocks until workers have made room.
+		le_jobs::counter_t* counter;
+		le_jobs::run_jobs( jobs.data(), uint32_t( jobs.size() ), &counter );
+		le_jobs::wait_for_counter_and_free( counter, 0 );
+	}
+
+	for ( size_t i = 0; i != params.size(); i++ ) {
+		params[ i ].entry->key = keys[ i ];
+	}
+}
+
+// ----------------------------------------------------------------------
+
 static bool le_path_get_vertices_for_polyline( le_path_o* self, size_t const& polyline_index, glm::vec2* vertices, size_t* numVertices ) {
 	bool success = false;
 	assert( polyline_index < self->polylines.size() );
@@ -3200,18 +3871,23 @@ LE_MODULE_REGISTER_IMPL( le_path, api ) {
 
 	le_path_i.get_num_contours                 = le_path_get_num_contours;
 	le_path_i.get_num_polylines                = le_path_get_num_polylines;
+	le_path_i.get_hash                         = le_path_get_hash;
 	le_path_i.get_vertices_for_polyline        = le_path_get_vertices_for_polyline;
 	le_path_i.get_tangents_for_polyline        = le_path_get_tangents_for_polyline;
 	le_path_i.get_polyline_at_pos_interpolated = le_path_get_polyline_at_pos_interpolated;
 
 	le_path_i.generate_offset_outline_for_contour = le_path_generate_offset_outline_for_contour;
 	le_path_i.tessellate_thick_contour            = le_path_tessellate_thick_contour;
+	le_path_i.get_thick_contour_vertex_count      = le_path_get_thick_contour_vertex_count;
+	le_path_i.update_thick_contours               = le_path_update_thick_contours;
 
 	le_path_i.iterate_vertices_for_contour     = le_path_iterate_vertices_for_contour;
 	le_path_i.iterate_quad_beziers_for_contour = le_path_iterate_quad_beziers_for_contour;
 
 	le_path_i.trace    = le_path_trace_path;
 	le_path_i.flatten  = le_path_flatten_path;
+
+	le_path_i.flatten_uniform = le_path_flatten_path_uniform;
 	le_path_i.resample = le_path_resample;
 	le_path_i.clear    = le_path_clear;
 }
@@ -63,6 +63,11 @@ struct le_path_api {
         // Generate and cache polylines for each contour per path
 		void        (* trace                     ) ( le_path_o* self, size_t resolution );
 		void        (* flatten                   ) ( le_path_o* self, float tolerance);
+
+		// Same as flatten, but subdivides bezier curves, and arcs uniformly, into a number of segments calculated
+		// upfront. Produces more vertices than `flatten` for the same tolerance, but is considerably
+		// cheaper for dense paths (font outlines, svg artwork), as curve points are evaluated using SIMD.
+		void        (* flatten_uniform           ) ( le_path_o* self, float tolerance);
 		void        (* resample                  ) ( le_path_o* self, float interval);
 
         // Always updates `max_count_outline_[l|r] with the number of used vertices for l and r outline.
@@ -73,11 +78,24 @@ struct le_path_api {
 
 		/// Returns `false` if num_vertices was smaller than needed number of vertices.
 		/// Note: Upon return, `*num_vertices` will contain number of vertices needed to describe tessellated contour triangles.
+		/// Note: Tessellated strokes are cached per contour, and only re-tessellated if the contour, or stroke attributes change.
 		bool        (* tessellate_thick_contour)(le_path_o* self, size_t contour_index, struct stroke_attribute_t const * stroke_attributes, glm::vec2* vertices, size_t* num_vertices);
 
+		/// Returns exact number of vertices needed to hold the tessellated stroke for contour at `contour_index`.
+		/// Tessellates (and caches) stroke if needed, so that a following `tessellate_thick_contour` only copies.
+		size_t      (* get_thick_contour_vertex_count)(le_path_o* self, size_t contour_index, struct stroke_attribute_t const * stroke_attributes);
+
+		/// Re-tessellates strokes for all contours which have changed since their last tessellation, in parallel
+		/// if le_jobs is available. Call this before querying individual contours to make use of worker threads.
+		void        (* update_thick_contours)(le_path_o* self, struct stroke_attribute_t const * stroke_attributes);
+
         size_t      (* get_num_contours          ) ( le_path_o* self );
 		size_t      (* get_num_polylines         ) ( le_path_o* self );
 
+		// Returns a hash calculated over all path commands and their parameters - paths with
+		// identical commands have identical hashes, which means this may be used as a cache key.
+		uint64_t    (* get_hash                  ) ( le_path_o* self );
+
         // Always updates `numVertices` with number of vertices in polyline at `polyline_index`
         // If `numVertices` < number of vertices in polyline at `polyline_index`:
         //      + Returns true
@@ -179,6 +197,10 @@ class Path : NoCopy, NoMove {
 		le_path::le_path_i.flatten( self, tolerance );
 	}
 
+	void flattenUniform( float tolerance = 0.25f ) {
+		le_path::le_path_i.flatten_uniform( self, tolerance );
+	}
+
 	void resample( float interval ) {
 		le_path::le_path_i.resample( self, interval );
 	}
@@ -1,8 +1,21 @@
 #include "le_pixels.h"
 #include "le_log.h"
 #include "le_core.h"
+#include "le_jobs.h"
 #include "3rdparty/stb_image.h"
 #include "assert.h"
+
+#if defined( __AVX2__ ) || defined( __SSE2__ ) || defined( _M_X64 )
+#	include <immintrin.h>
+#endif
+#include <atomic>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <string>
+#include <vector>
 #include <iostream>
 #include <iomanip>
 
@@ -10,6 +23,9 @@ struct le_pixels_o {
 	// members
 	void*          image_data = nullptr;
 	le_pixels_info info{};
+	bool           owns_image_data = true; // false if image was decoded into memory provided by the caller
+
+	std::vector<le_pixels_subresource_t> subresources; // only used for images loaded from container files; image_data was allocated via malloc if not empty
 };
 
 // ----------------------------------------------------------------------
@@ -35,14 +51,32 @@ struct image_source_info_t {
 	Type                 type;
 	int                  requested_num_channels; // number of channels requested, 0 meaning don't change number of channels on load
 	le_pixels_info::Type requested_pixel_type;   // requested pixel component type.
+	void*                target_memory;          // optional: memory owned by caller into which to place decoded pixels
+	size_t               target_memory_capacity; // number of bytes available at target_memory
+};
+
+// ----------------------------------------------------------------------
+
+// A pending decode - decoding happens on a le_jobs worker thread,
+// or immediately, if the job system has not been initialised.
+struct le_pixels_load_o {
+	image_source_info_t  source;
+	std::string          file_path;          // owned copy of the file path, if source is a file - source points into this
+	le_pixels_o*         result   = nullptr; // set once decoding has completed, nullptr if decoding failed
+	std::atomic<bool>    is_ready = false;   // set once decoding has completed
+	le_jobs::counter_t*  counter  = nullptr; // nullptr if decoding happened synchronously
 };
 
 // ----------------------------------------------------------------------
 
 static void le_pixels_destroy( le_pixels_o* self ) {
 
-	if ( self && self->image_data ) {
-		stbi_image_free( self->image_data );
+	if ( self && self->image_data && self->owns_image_data ) {
+		if ( self->subresources.empty() ) {
+			stbi_image_free( self->image_data );
+		} else {
+			free( self->image_data );
+		}
 		self->image_data = nullptr;
 	}
 
@@ -55,9 +89,652 @@ static inline uint32_t get_num_bytes_for_type( le_pixels_info::Type const& type
 	return ( 1 << ( type & 0b11 ) );
 }
 
+// ----------------------------------------------------------------------
+// Container files (KTX2, DDS) hold block-compressed pixels, which we
+// pass on to the GPU as they are, together with all mip levels and layers
+// stored in the file. KTX2 files may also hold uncompressed pixels - this
+// is what we write when baking mip chains, see `le_pixels_write_ktx2`.
+// ----------------------------------------------------------------------
+
+enum class ContainerType : uint32_t {
+	eNone = 0, // not a container which we know how to read - use stb_image
+	eKtx2,
+	eDds,
+};
+
+// Subset of le::Format (== VkFormat) which we accept from container files
+enum BlockCompressedFormat : uint32_t {
+	eBc1RgbaUnormBlock = 133,
+	eBc1RgbaSrgbBlock  = 134,
+	eBc2UnormBlock     = 135,
+	eBc2SrgbBlock      = 136,
+	eBc3UnormBlock     = 137,
+	eBc3SrgbBlock      = 138,
+	eBc4UnormBlock     = 139,
+	eBc4SnormBlock     = 140,
+	eBc5UnormBlock     = 141,
+	eBc5SnormBlock     = 142,
+	eBc6HUfloatBlock   = 143,
+	eBc6HSfloatBlock   = 144,
+	eBc7UnormBlock     = 145,
+	eBc7SrgbBlock      = 146,
+	// BC1 formats without alpha (131, 132) are accepted as well.
+};
+
+// Subset of le::Format (== VkFormat) for uncompressed pixels which we accept from KTX2 files
+struct uncompressed_format_t {
+	uint32_t             format;
+	uint32_t             num_channels;
+	le_pixels_info::Type type;
+	bool                 is_srgb;
+};
+
+static constexpr uncompressed_format_t UNCOMPRESSED_FORMATS[] = {
+    // clang-format off
+    {   9, 1, le_pixels_info::eUInt8,   false }, // R8_UNORM
+    {  16, 2, le_pixels_info::eUInt8,   false }, // R8G8_UNORM
+    {  23, 3, le_pixels_info::eUInt8,   false }, // R8G8B8_UNORM
+    {  37, 4, le_pixels_info::eUInt8,   false }, // R8G8B8A8_UNORM
+    {  15, 1, le_pixels_info::eUInt8,   true  }, // R8_SRGB
+    {  22, 2, le_pixels_info::eUInt8,   true  }, // R8G8_SRGB
+    {  29, 3, le_pixels_info::eUInt8,   true  }, // R8G8B8_SRGB
+    {  43, 4, le_pixels_info::eUInt8,   true  }, // R8G8B8A8_SRGB
+    {  70, 1, le_pixels_info::eUInt16,  false }, // R16_UNORM
+    {  77, 2, le_pixels_info::eUInt16,  false }, // R16G16_UNORM
+    {  84, 3, le_pixels_info::eUInt16,  false }, // R16G16B16_UNORM
+    {  91, 4, le_pixels_info::eUInt16,  false }, // R16G16B16A16_UNORM
+    { 100, 1, le_pixels_info::eFloat32, false }, // R32_SFLOAT
+    { 103, 2, le_pixels_info::eFloat32, false }, // R32G32_SFLOAT
+    { 106, 3, le_pixels_info::eFloat32, false }, // R32G32B32_SFLOAT
+    { 109, 4, le_pixels_info::eFloat32, false }, // R32G32B32A32_SFLOAT
+    // clang-format on
+};
+
+static uncompressed_format_t const* uncompressed_format_find( uint32_t format ) {
+	for ( auto const& f : UNCOMPRESSED_FORMATS ) {
+		if ( f.format == format ) {
+			return &f;
+		}
+	}
+	return nullptr;
+}
+
+static uncompressed_format_t const* uncompressed_format_find( uint32_t num_channels, le_pixels_info::Type type, bool is_srgb ) {
+	for ( auto const& f : UNCOMPRESSED_FORMATS ) {
+		if ( f.num_channels == num_channels && f.type == type && f.is_srgb == is_srgb ) {
+			return &f;
+		}
+	}
+	return nullptr;
+}
+
+// Images may have at most 32 mip levels, as their width and height are 32 bit: anything
+// more in a container header means that the file is corrupt.
+static constexpr uint32_t MAX_MIP_LEVELS = 32;
+
+static constexpr unsigned char KTX2_IDENTIFIER[ 12 ] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };
+static constexpr unsigned char DDS_MAGIC[ 4 ]        = { 'D', 'D', 'S', ' ' };
+
+struct ktx2_header_t {
+	unsigned char identifier[ 12 ];
+	uint32_t      vk_format;
+	uint32_t      type_size;
+	uint32_t      pixel_width;
+	uint32_t      pixel_height;
+	uint32_t      pixel_depth;
+	uint32_t      layer_count;
+	uint32_t      face_count;
+	uint32_t      level_count;
+	uint32_t      supercompression_scheme;
+	uint32_t      dfd_byte_offset;
+	uint32_t      dfd_byte_length;
+	uint32_t      kvd_byte_offset;
+	uint32_t      kvd_byte_length;
+	uint64_t      sgd_byte_offset;
+	uint64_t      sgd_byte_length;
+};
+
+struct ktx2_level_index_t {
+	uint64_t byte_offset;
+	uint64_t byte_length;
+	uint64_t uncompressed_byte_length;
+};
+
+struct dds_header_t {
+	uint32_t magic;
+	uint32_t size; // must be 124
+	uint32_t flags;
+	uint32_t height;
+	uint32_t width;
+	uint32_t pitch_or_linear_size;
+	uint32_t depth;
+	uint32_t mip_map_count;
+	uint32_t reserved_1[ 11 ];
+	struct {
+		uint32_t size;
+		uint32_t flags;
+		uint32_t four_cc;
+		uint32_t rgb_bit_count;
+		uint32_t bit_mask[ 4 ];
+	} pixel_format;
+	uint32_t caps;
+	uint32_t caps_2;
+	uint32_t caps_3;
+	uint32_t caps_4;
+	uint32_t reserved_2;
+};
+
+struct dds_header_dxt10_t {
+	uint32_t dxgi_format;
+	uint32_t resource_dimension;
+	uint32_t misc_flag;
+	uint32_t array_size;
+	uint32_t misc_flags_2;
+};
+
+static_assert( sizeof( ktx2_header_t ) == 80, "ktx2 header must be tightly packed" );
+static_assert( sizeof( dds_header_t ) == 128, "dds header must be tightly packed" );
+
+static constexpr uint32_t DDS_FLAG_DEPTH          = 0x800000;
+static constexpr uint32_t DDS_PIXEL_FORMAT_FOURCC = 0x4;
+static constexpr uint32_t DDS_CAPS_2_CUBEMAP      = 0x200;
+static constexpr uint32_t DDS_CAPS_2_VOLUME       = 0x200000;
+static constexpr uint32_t DDS_DXT10_MISC_CUBEMAP  = 0x4;
+
+static constexpr uint32_t make_four_cc( char a, char b, char c, char d ) {
+	return uint32_t( uint8_t( a ) ) | ( uint32_t( uint8_t( b ) ) << 8 ) | ( uint32_t( uint8_t( c ) ) << 16 ) | ( uint32_t( uint8_t( d ) ) << 24 );
+}
+
+// ----------------------------------------------------------------------
+
+static ContainerType container_get_type( unsigned char const* data, size_t num_bytes ) {
+	if ( num_bytes >= sizeof( ktx2_header_t ) && 0 == memcmp( data, KTX2_IDENTIFIER, sizeof( KTX2_IDENTIFIER ) ) ) {
+		return ContainerType::eKtx2;
+	}
+	if ( num_bytes >= sizeof( dds_header_t ) && 0 == memcmp( data, DDS_MAGIC, sizeof( DDS_MAGIC ) ) ) {
+		return ContainerType::eDds;
+	}
+	return ContainerType::eNone;
+}
+
+// ----------------------------------------------------------------------
+// Returns number of bytes per 4x4 block, or 0 if format is not one of the BCn formats.
+static uint32_t block_compressed_format_get_block_size( uint32_t format ) {
+	if ( format == 131 || format == 132 || format == eBc1RgbaUnormBlock || format == eBc1RgbaSrgbBlock ||
+	     format == eBc4UnormBlock || format == eBc4SnormBlock ) {
+		return 8;
+	}
+	if ( format >= eBc2UnormBlock && format <= eBc7SrgbBlock ) {
+		return 16;
+	}
+	return 0;
+}
+
+// ----------------------------------------------------------------------
+// Returns false if format is neither one of the BCn formats, nor one of the uncompressed formats which we accept.
+static bool format_get_texel_block( uint32_t format, uint32_t* block_dimension, uint32_t* block_num_bytes ) {
+	if ( uint32_t block_size = block_compressed_format_get_block_size( format ) ) {
+		*block_dimension = 4;
+		*block_num_bytes = block_size;
+		return true;
+	}
+	if ( auto f = uncompressed_format_find( format ) ) {
+		*block_dimension = 1;
+		*block_num_bytes = f->num_channels * ( 1 << ( f->type & 0b11 ) );
+		return true;
+	}
+	return false;
+}
+
+// ----------------------------------------------------------------------
+
+static uint32_t block_compressed_format_get_num_channels( uint32_t format ) {
+	switch ( format ) {
+	case eBc4UnormBlock: // fall-through
+	case eBc4SnormBlock:
+		return 1;
+	case eBc5UnormBlock: // fall-through
+	case eBc5SnormBlock:
+		return 2;
+	case 131: // BC1 rgb without alpha
+	case 132:
+	case eBc6HUfloatBlock:
+	case eBc6HSfloatBlock:
+		return 3;
+	default:
+		return 4;
+	}
+}
+
+// ----------------------------------------------------------------------
+
+static uint64_t format_get_byte_count( uint32_t format, uint32_t width, uint32_t height ) {
+	uint32_t block_dimension = 1;
+	uint32_t block_num_bytes = 0;
+	format_get_texel_block( format, &block_dimension, &block_num_bytes );
+	uint64_t const blocks_x = std::max<uint32_t>( 1, ( width + block_dimension - 1 ) / block_dimension );
+	uint64_t const blocks_y = std::max<uint32_t>( 1, ( height + block_dimension - 1 ) / block_dimension );
+	return blocks_x * blocks_y * block_num_bytes;
+}
+
+// ----------------------------------------------------------------------
+
+static uint32_t dds_get_format( dds_header_t const& header, dds_header_dxt10_t const* header_dxt10 ) {
+
+	if ( header_dxt10 ) {
+		switch ( header_dxt10->dxgi_format ) {
+			// clang-format off
+		case 71: return eBc1RgbaUnormBlock; // DXGI_FORMAT_BC1_UNORM
+		case 72: return eBc1RgbaSrgbBlock;  // DXGI_FORMAT_BC1_UNORM_SRGB
+		case 74: return eBc2UnormBlock;     // DXGI_FORMAT_BC2_UNORM
+		case 75: return eBc2SrgbBlock;      // DXGI_FORMAT_BC2_UNORM_SRGB
+		case 77: return eBc3UnormBlock;     // DXGI_FORMAT_BC3_UNORM
+		case 78: return eBc3SrgbBlock;      // DXGI_FORMAT_BC3_UNORM_SRGB
+		case 80: return eBc4UnormBlock;     // DXGI_FORMAT_BC4_UNORM
+		case 81: return eBc4SnormBlock;     // DXGI_FORMAT_BC4_SNORM
+		case 83: return eBc5UnormBlock;     // DXGI_FORMAT_BC5_UNORM
+		case 84: return eBc5SnormBlock;     // DXGI_FORMAT_BC5_SNORM
+		case 95: return eBc6HUfloatBlock;   // DXGI_FORMAT_BC6H_UF16
+		case 96: return eBc6HSfloatBlock;   // DXGI_FORMAT_BC6H_SF16
+		case 98: return eBc7UnormBlock;     // DXGI_FORMAT_BC7_UNORM
+		case 99: return eBc7SrgbBlock;      // DXGI_FORMAT_BC7_UNORM_SRGB
+		default: return 0;
+			// clang-format on
+		}
+	}
+
+	if ( 0 == ( header.pixel_format.flags & DDS_PIXEL_FORMAT_FOURCC ) ) {
+		return 0; // uncompressed dds files are not supported
+	}
+
+	switch ( header.pixel_format.four_cc ) {
+		// clang-format off
+	case make_four_cc( 'D', 'X', 'T', '1' ): return eBc1RgbaUnormBlock;
+	case make_four_cc( 'D', 'X', 'T', '2' ): // fall-through
+	case make_four_cc( 'D', 'X', 'T', '3' ): return eBc2UnormBlock;
+	case make_four_cc( 'D', 'X', 'T', '4' ): // fall-through
+	case make_four_cc( 'D', 'X', 'T', '5' ): return eBc3UnormBlock;
+	case make_four_cc( 'A', 'T', 'I', '1' ): // fall-through
+	case make_four_cc( 'B', 'C', '4', 'U' ): return eBc4UnormBlock;
+	case make_four_cc( 'B', 'C', '4', 'S' ): return eBc4SnormBlock;
+	case make_four_cc( 'A', 'T', 'I', '2' ): // fall-through
+	case make_four_cc( 'B', 'C', '5', 'U' ): return eBc5UnormBlock;
+	case make_four_cc( 'B', 'C', '5', 'S' ): return eBc5SnormBlock;
+	default: return 0;
+		// clang-format on
+	}
+}
+
+// ----------------------------------------------------------------------
+// Reads container header, and fills in `info`. If `subresources` is given,
+// also builds a list of subresources - with offsets relative to `data`.
+static bool container_read_header( ContainerType type, unsigned char const* data, size_t num_bytes, le_pixels_info* info, std::vector<le_pixels_subresource_t>* subresources ) {
+
+	static auto logger = LeLog( "le_pixels" );
+
+	uint32_t format         = 0;
+	uint32_t width          = 0;
+	uint32_t height         = 0;
+	uint32_t num_mip_levels = 1;
+	uint32_t num_layers     = 1;
+
+	if ( type == ContainerType::eKtx2 ) {
+
+		ktx2_header_t header;
+		memcpy( &header, data, sizeof( header ) );
+
+		if ( header.supercompression_scheme != 0 ) {
+			logger.error( "ERROR: Supercompressed KTX2 files are not supported (scheme: %u).", header.supercompression_scheme );
+			return false;
+		}
+
+		if ( header.pixel_depth > 1 ) {
+			logger.error( "ERROR: KTX2 volume images are not supported." );
+			return false;
+		}
+
+		format         = header.vk_format;
+		width          = header.pixel_width;
+		height         = std::max<uint32_t>( 1, header.pixel_height );
+		num_mip_levels = std::max<uint32_t>( 1, header.level_count ); // level count 0 means that mip levels must be generated - we only upload the base level
+
+		uint64_t const num_layers_total = uint64_t( std::max<uint32_t>( 1, header.layer_count ) ) * std::max<uint32_t>( 1, header.face_count );
+
+		// Every layer takes at least one byte - a file which claims more layers than it has
+		// bytes is corrupt. This also bounds the number of subresources which we build below.
+
+		if ( num_mip_levels > MAX_MIP_LEVELS || num_layers_total > num_bytes ) {
+			logger.error( "ERROR: KTX2 file has invalid level count (%u), or layer count (%llu).", num_mip_levels, ( unsigned long long )num_layers_total );
+			return false;
+		}
+
+		num_layers = uint32_t( num_layers_total );
+
+		uint32_t block_dimension, block_num_bytes;
+
+		if ( !format_get_texel_block( format, &block_dimension, &block_num_bytes ) ) {
+			logger.error( "ERROR: KTX2 file uses unsupported format: %u, only BC1-BC7, and 8/16 bit unorm, or 32 bit float formats are supported.", format );
+			return false;
+		}
+
+		if ( sizeof( ktx2_header_t ) + num_mip_levels * sizeof( ktx2_level_index_t ) > num_bytes ) {
+			logger.error( "ERROR: KTX2 file is truncated." );
+			return false;
+		}
+
+		if ( subresources ) {
+
+			// KTX2 stores levels in arbitrary order, as given by the level index; within each
+			// level, images for all layers (and faces) are stored one after another.
+
+			for ( uint32_t level = 0; level != num_mip_levels; level++ ) {
+
+				ktx2_level_index_t level_index;
+				memcpy( &level_index, data + sizeof( ktx2_header_t ) + level * sizeof( ktx2_level_index_t ), sizeof( level_index ) );
+
+				uint32_t const level_width  = std::max<uint32_t>( 1, width >> level );
+				uint32_t const level_height = std::max<uint32_t>( 1, height >> level );
+				uint64_t const image_bytes  = format_get_byte_count( format, level_width, level_height );
+
+				// Compare against remaining bytes, so that large offsets, or lengths can't overflow.
+				if ( level_index.byte_offset > num_bytes ||
+				     level_index.byte_length > num_bytes - level_index.byte_offset ||
+				     image_bytes > level_index.byte_length / num_layers ) {
+					logger.error( "ERROR: KTX2 file is truncated, or level %u has unexpected size.", level );
+					return false;
+				}
+
+				for ( uint32_t layer = 0; layer != num_layers; layer++ ) {
+					subresources->push_back( { level, layer, level_width, level_height, level_index.byte_offset + layer * image_bytes, image_bytes } );
+				}
+			}
+		}
+
+	} else if ( type == ContainerType::eDds ) {
+
+		dds_header_t header;
+		memcpy( &header, data, sizeof( header ) );
+
+		if ( header.size != 124 ) {
+			logger.error( "ERROR: DDS file has invalid header size." );
+			return false;
+		}
+
+		dds_header_dxt10_t header_dxt10{};
+		bool const         has_header_dxt10 = ( header.pixel_format.flags & DDS_PIXEL_FORMAT_FOURCC ) &&
+		                              header.pixel_format.four_cc == make_four_cc( 'D', 'X', '1', '0' );
+		size_t             data_offset      = sizeof( dds_header_t );
+
+		if ( has_header_dxt10 ) {
+			if ( num_bytes < sizeof( dds_header_t ) + sizeof( dds_header_dxt10_t ) ) {
+				logger.error( "ERROR: DDS file is truncated." );
+				return false;
+			}
+			memcpy( &header_dxt10, data + data_offset, sizeof( header_dxt10 ) );
+			data_offset += sizeof( dds_header_dxt10_t );
+		}
+
+		if ( ( header.caps_2 & DDS_CAPS_2_VOLUME ) || ( ( header.flags & DDS_FLAG_DEPTH ) && header.depth > 1 ) ) {
+			logger.error( "ERROR: DDS volume images are not supported." );
+			return false;
+		}
+
+		format         = dds_get_format( header, has_header_dxt10 ? &header_dxt10 : nullptr );
+		width          = header.width;
+		height         = std::max<uint32_t>( 1, header.height );
+		num_mip_levels = std::max<uint32_t>( 1, header.mip_map_count );
+
+		uint64_t num_layers_total = 1;
+
+		if ( has_header_dxt10 ) {
+			num_layers_total = uint64_t( std::max<uint32_t>( 1, header_dxt10.array_size ) ) * ( ( header_dxt10.misc_flag & DDS_DXT10_MISC_CUBEMAP ) ? 6 : 1 );
+		} else {
+			num_layers_total = ( header.caps_2 & DDS_CAPS_2_CUBEMAP ) ? 6 : 1; // we assume that cube maps define all six faces
+		}
+
+		if ( num_mip_levels > MAX_MIP_LEVELS || num_layers_total > num_bytes ) {
+			logger.error( "ERROR: DDS file has invalid mip count (%u), or layer count (%llu).", num_mip_levels, ( unsigned long long )num_layers_total );
+			return false;
+		}
+
+		num_layers = uint32_t( num_layers_total );
+
+		if ( format == 0 ) {
+			logger.error( "ERROR: DDS file uses unsupported format, only BC1-BC7 are supported." );
+			return false;
+		}
+
+		if ( subresources ) {
+
+			// DDS stores the full mip chain for each layer (or face), one layer after another.
+
+			uint64_t offset = data_offset;
+
+			for ( uint32_t layer = 0; layer != num_layers; layer++ ) {
+				for ( uint32_t level = 0; level != num_mip_levels; level++ ) {
+
+					uint32_t const level_width  = std::max<uint32_t>( 1, width >> level );
+					uint32_t const level_height = std::max<uint32_t>( 1, height >> level );
+					uint64_t const image_bytes  = format_get_byte_count( format, level_width, level_height );
+
+					if ( image_bytes > num_bytes - offset ) {
+						logger.error( "ERROR: DDS file is truncated." );
+						return false;
+					}
+
+					subresources->push_back( { level, layer, level_width, level_height, offset, image_bytes } );
+					offset += image_bytes;
+				}
+			}
+		}
+
+	} else {
+		assert( false ); // unreachable
+		return false;
+	}
+
+	if ( width == 0 ) {
+		logger.error( "ERROR: Container file has invalid image width." );
+		return false;
+	}
+
+	info->width          = width;
+	info->height         = height;
+	info->depth          = 1;
+	info->num_mip_levels = num_mip_levels;
+	info->num_layers     = num_layers;
+	info->format         = format;
+
+	if ( auto f = uncompressed_format_find( format ) ) {
+		info->num_channels = f->num_channels;
+		info->type         = f->type;
+		info->bpp          = 8 * get_num_bytes_for_type( f->type ) * f->num_channels;
+	} else {
+		info->num_channels = block_compressed_format_get_num_channels( format );
+		info->type         = le_pixels_info::Type::eUInt8;
+		info->bpp          = block_compressed_format_get_block_size( format ) / 2; // 16 texels per block, 8 bits per byte
+	}
+
+	// We sum in 64 bit, as `byte_count` is only 32 bit wide: should the sum not fit, we must
+	// reject the file - otherwise we would allocate less memory than we then copy into.
+
+	uint64_t byte_count = 0;
+
+	if ( subresources ) {
+		for ( auto const& s : *subresources ) {
+			byte_count += s.byte_count;
+		}
+	} else {
+		for ( uint32_t level = 0; level != num_mip_levels; level++ ) {
+			byte_count += num_layers * format_get_byte_count( format, std::max<uint32_t>( 1, width >> level ), std::max<uint32_t>( 1, height >> level ) );
+		}
+	}
+
+	if ( byte_count > UINT32_MAX ) {
+		logger.error( "ERROR: Container file is too large: %llu Bytes of image data.", ( unsigned long long )byte_count );
+		return false;
+	}
+
+	info->byte_count = uint32_t( byte_count );
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+// Loads container into `self`: we copy all subresources into one tightly packed
+// allocation, and update subresource offsets so that they refer to this allocation.
+static bool container_load( le_pixels_o* self, ContainerType type, unsigned char const* data, size_t num_bytes ) {
+
+	if ( !container_read_header( type, data, num_bytes, &self->info, &self->subresources ) ) {
+		return false;
+	}
+
+	auto image_data = static_cast<unsigned char*>( malloc( self->info.byte_count ) );
+
+	if ( image_data == nullptr ) {
+		return false;
+	}
+
+	uint64_t offset = 0;
+
+	for ( auto& s : self->subresources ) {
+		memcpy( image_data + offset, data + s.offset, s.byte_count );
+		s.offset = offset;
+		offset += s.byte_count;
+	}
+
+	self->image_data = image_data;
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+// Returns container type of file at `file_path` - only reads the first few bytes of the file.
+static ContainerType container_get_type_from_file( char const* file_path ) {
+
+	unsigned char header[ sizeof( dds_header_t ) ];
+	size_t        num_bytes_read = 0;
+
+	if ( FILE* file = fopen( file_path, "rb" ) ) {
+		num_bytes_read = fread( header, 1, sizeof( header ), file );
+		fclose( file );
+	}
+
+	return container_get_type( header, num_bytes_read );
+}
+
+// ----------------------------------------------------------------------
+
+static bool read_file( char const* file_path, std::vector<unsigned char>& contents ) {
+
+	FILE* file = fopen( file_path, "rb" );
+
+	if ( file == nullptr ) {
+		return false;
+	}
+
+	fseek( file, 0, SEEK_END );
+	long file_size = ftell( file );
+	rewind( file );
+
+	if ( file_size > 0 ) {
+		contents.resize( size_t( file_size ) );
+		contents.resize( fread( contents.data(), 1, contents.size(), file ) );
+	}
+
+	fclose( file );
+
+	return file_size > 0 && contents.size() == size_t( file_size );
+}
+
+// ----------------------------------------------------------------------
+// Moves pixels into target memory given by caller, if any.
+static le_pixels_o* pixels_move_to_target_memory( le_pixels_o* self, image_source_info_t const& info ) {
+
+	if ( nullptr == info.target_memory ) {
+		return self;
+	}
+
+	// Caller wants pixels to end up in memory which it owns (a mapped staging buffer, for example),
+	// we move pixels over while we are still on the decoding thread, and free the decoder's memory
+	// right away, so that decoded images don't pile up in memory.
+
+	if ( info.target_memory_capacity < self->info.byte_count ) {
+		static auto logger = LeLog( "le_pixels" );
+		logger.error( "ERROR: Target memory too small for decoded image: %zu Bytes available, %u Bytes needed.", info.target_memory_capacity, self->info.byte_count );
+		le_pixels_destroy( self );
+		return nullptr;
+	}
+
+	memcpy( info.target_memory, self->image_data, self->info.byte_count );
+
+	if ( self->subresources.empty() ) {
+		stbi_image_free( self->image_data );
+	} else {
+		free( self->image_data );
+	}
+
+	self->image_data      = info.target_memory;
+	self->owns_image_data = false;
+
+	return self;
+}
+
+// ----------------------------------------------------------------------
+// Loads image from container, if source is a container file. Returns false if source is not a
+// container; `result` is nullptr if source is a container, but could not be loaded.
+static bool le_pixels_create_from_container( image_source_info_t const& info, le_pixels_o** result ) {
+
+	std::vector<unsigned char> file_contents;
+	unsigned char const*       data      = nullptr;
+	size_t                     num_bytes = 0;
+	ContainerType              type      = ContainerType::eNone;
+
+	if ( info.type == image_source_info_t::Type::eBuffer ) {
+		data      = info.data.as_buffer.buffer;
+		num_bytes = info.data.as_buffer.buffer_num_bytes;
+		type      = container_get_type( data, num_bytes );
+	} else if ( info.type == image_source_info_t::Type::eFile ) {
+		type = container_get_type_from_file( info.data.as_file.file_path );
+		if ( type != ContainerType::eNone && read_file( info.data.as_file.file_path, file_contents ) ) {
+			data      = file_contents.data();
+			num_bytes = file_contents.size();
+		}
+	}
+
+	if ( type == ContainerType::eNone ) {
+		return false;
+	}
+
+	// ----------| invariant: source is a container - requested channels and pixel type don't apply.
+
+	auto self = new le_pixels_o{};
+
+	if ( data == nullptr || !container_load( self, type, data, num_bytes ) ) {
+		static auto logger = LeLog( "le_pixels" );
+		if ( info.type == image_source_info_t::Type::eFile ) {
+			logger.error( "ERROR: Could not load image container from file: '%s'", info.data.as_file.file_path );
+		} else {
+			logger.error( "ERROR: Could not load image container from buffer at address: %p", info.data.as_buffer.buffer );
+		}
+		le_pixels_destroy( self );
+		*result = nullptr;
+		return true;
+	}
+
+	*result = pixels_move_to_target_memory( self, info );
+
+	return true;
+}
+
 // ----------------------------------------------------------------------
 
 static le_pixels_o* le_pixels_create( image_source_info_t const& info ) {
+
+	if ( le_pixels_o * container_pixels; le_pixels_create_from_container( info, &container_pixels ) ) {
+		return container_pixels;
+	}
+
 	auto self = new le_pixels_o{};
 
 	int width;
@@ -124,14 +801,17 @@ static le_pixels_o* le_pixels_create( image_source_info_t const& info ) {
 
 	// ----------| invariant: load was successful
 
-	self->info.bpp          = 8 * get_num_bytes_for_type( info.requested_pixel_type ) * uint32_t( num_channels ); // note * 8, since we're returning *bits* per pixel!
-	self->info.width        = uint32_t( width );
-	self->info.height       = uint32_t( height );
-	self->info.depth        = 1;
-	self->info.num_channels = uint32_t( num_channels );
-	self->info.byte_count   = ( self->info.bpp / 8 ) * ( self->info.width * self->info.height * self->info.depth );
-
-	return self;
+	self->info.bpp            = 8 * get_num_bytes_for_type( info.requested_pixel_type ) * uint32_t( num_channels ); // note * 8, since we're returning *bits* per pixel!
+	self->info.width          = uint32_t( width );
+	self->info.height         = uint32_t( height );
+	self->info.depth          = 1;
+	self->info.num_channels   = uint32_t( num_channels );
+	self->info.type           = info.requested_pixel_type;
+	self->info.byte_count     = ( self->info.bpp / 8 ) * ( self->info.width * self->info.height * self->info.depth );
+	self->info.num_mip_levels = 1;
+	self->info.num_layers     = 1;
+
+	return pixels_move_to_target_memory( self, info );
 }
 
 // ----------------------------------------------------------------------
@@ -165,6 +845,680 @@ static le_pixels_o* le_pixels_create_from_memory( unsigned char const* buffer, s
 
 // ----------------------------------------------------------------------
 
+static void pixels_load_job( void* param ) {
+	auto load    = static_cast<le_pixels_load_o*>( param );
+	load->result = le_pixels_create( load->source );
+	load->is_ready.store( true, std::memory_order_release );
+}
+
+// ----------------------------------------------------------------------
+
+static le_pixels_load_o* le_pixels_load_start( le_pixels_load_o* load ) {
+
+	if ( le_jobs::get_worker_thread_count() == 0 ) {
+		// No job system - we must decode right away, on the calling thread.
+		pixels_load_job( load );
+		return load;
+	}
+
+	le_jobs::job_t job{ pixels_load_job, load };
+	le_jobs::run_jobs( &job, 1, &load->counter );
+
+	return load;
+}
+
+// ----------------------------------------------------------------------
+
+static le_pixels_load_o* le_pixels_load_async_from_file( char const* file_path, int num_channels_requested, le_pixels_info::Type type, void* target_memory, size_t target_memory_capacity ) {
+
+	auto load = new le_pixels_load_o{};
+
+	load->file_path = file_path; // we keep a copy, since caller's string may not outlive decoding
+
+	load->source.type                   = image_source_info_t::Type::eFile;
+	load->source.data.as_file.file_path = load->file_path.c_str();
+	load->source.requested_pixel_type   = type;
+	load->source.requested_num_channels = num_channels_requested;
+	load->source.target_memory          = target_memory;
+	load->source.target_memory_capacity = target_memory_capacity;
+
+	return le_pixels_load_start( load );
+}
+
+// ----------------------------------------------------------------------
+
+static le_pixels_load_o* le_pixels_load_async_from_memory( unsigned char const* buffer, size_t buffer_byte_count, int num_channels_requested, le_pixels_info::Type type, void* target_memory, size_t target_memory_capacity ) {
+
+	auto load = new le_pixels_load_o{};
+
+	load->source.type                            = image_source_info_t::Type::eBuffer;
+	load->source.data.as_buffer.buffer           = buffer;
+	load->source.data.as_buffer.buffer_num_bytes = buffer_byte_count;
+	load->source.requested_pixel_type            = type;
+	load->source.requested_num_channels          = num_channels_requested;
+	load->source.target_memory                   = target_memory;
+	load->source.target_memory_capacity          = target_memory_capacity;
+
+	return le_pixels_load_start( load );
+}
+
+// ----------------------------------------------------------------------
+
+static bool le_pixels_load_is_ready( le_pixels_load_o const* self ) {
+	return self->is_ready.load( std::memory_order_acquire );
+}
+
+// ----------------------------------------------------------------------
+
+// Blocks until decoding has completed, then frees the load handle.
+// Returns decoded pixels - caller takes ownership - or nullptr if decoding failed.
+static le_pixels_o* le_pixels_load_wait( le_pixels_load_o* self ) {
+
+	if ( self->counter ) {
+		le_jobs::wait_for_counter_and_free( self->counter, 0 );
+	}
+
+	assert( self->is_ready );
+
+	le_pixels_o* result = self->result;
+	delete self;
+
+	return result;
+}
+
+// ----------------------------------------------------------------------
+
+// Decodes all given files, spreading work over all worker threads.
+// Each job keeps pulling the next file to decode, so that workers stay
+// busy even if some images take much longer to decode than others.
+//
+// Writes one pixels object per file into `results` - nullptr for files which
+// could not be decoded. Returns true if all files were decoded successfully.
+static bool le_pixels_create_batch_from_files( char const* const* file_paths, size_t num_files, int num_channels_requested, le_pixels_info::Type type, le_pixels_o** results ) {
+
+	struct batch_t {
+		char const* const*   file_paths;
+		size_t               num_files;
+		int                  num_channels_requested;
+		le_pixels_info::Type type;
+		le_pixels_o**        results;
+		std::atomic<size_t>  next_file;
+	};
+
+	batch_t batch{ file_paths, num_files, num_channels_requested, type, results, { 0 } };
+
+	auto decode_files = []( void* param ) {
+		auto b = static_cast<batch_t*>( param );
+		for ( size_t i = b->next_file++; i < b->num_files; i = b->next_file++ ) {
+			image_source_info_t info{};
+			info.type                   = image_source_info_t::Type::eFile;
+			info.data.as_file.file_path = b->file_paths[ i ];
+			info.requested_pixel_type   = b->type;
+			info.requested_num_channels = b->num_channels_requested;
+			b->results[ i ]             = le_pixels_create( info );
+		}
+	};
+
+	uint32_t const num_workers = le_jobs::get_worker_thread_count();
+
+	if ( num_workers == 0 || num_files < 2 ) {
+		decode_files( &batch );
+	} else {
+		std::vector<le_jobs::job_t> jobs( std::min<size_t>( num_files, num_workers ), le_jobs::job_t{ decode_files, &batch } );
+		le_jobs::counter_t*         counter;
+		le_jobs::run_jobs( jobs.data(), uint32_t( jobs.size() ), &counter );
+		le_jobs::wait_for_counter_and_free( counter, 0 );
+	}
+
+	return std::all_of( results, results + num_files, []( le_pixels_o const* p ) { return p != nullptr; } );
+}
+
+// ----------------------------------------------------------------------
+// Mip chain generation
+//
+// We convert each level into linear floating point RGBA, so that every
+// texel fits into one SIMD register, filter, and then convert back into
+// the image's pixel type. Each level is split into bands of rows, which
+// are filtered in parallel on le_jobs worker threads.
+//
+// Filters process two texels at a time if le_pixels is compiled with AVX2
+// (see LE_PIXELS_ENABLE_AVX2), otherwise one texel at a time, using SSE.
+// ----------------------------------------------------------------------
+
+struct mip_level_t {
+	uint32_t           width;
+	uint32_t           height;
+	std::vector<float> texels; // linear RGBA, 4 floats per texel
+};
+
+struct mip_filter_job_t {
+	mip_level_t const*       src;
+	mip_level_t*             dst;
+	le_pixels_api::MipFilter filter;
+	uint32_t                 row_begin; // rows of dst to compute
+	uint32_t                 row_end;   //
+};
+
+// Kaiser-windowed sinc, for downsampling by a factor of two. Taps sample the source
+// at offsets -3..+4 around 2*x; the filter is centered between the two source texels
+// which a box filter would average.
+static constexpr int   KAISER_NUM_TAPS = 8;
+static constexpr int   KAISER_TAP_MIN  = -3;
+static constexpr float KAISER_ALPHA    = 4.f;
+
+// ----------------------------------------------------------------------
+// Modified Bessel function of the first kind, order zero.
+static double bessel_i0( double x ) {
+	double sum  = 1;
+	double term = 1;
+	for ( int k = 1; k < 32; k++ ) {
+		term *= ( x / ( 2 * k ) ) * ( x / ( 2 * k ) );
+		sum += term;
+	}
+	return sum;
+}
+
+// ----------------------------------------------------------------------
+
+static float const* get_kaiser_weights() {
+	static auto const weights = []() {
+		constexpr double                   PI         = 3.14159265358979323846;
+		std::array<float, KAISER_NUM_TAPS> w{};
+		double const                       half_width = KAISER_NUM_TAPS / 2;
+		double                             sum        = 0;
+		for ( int i = 0; i != KAISER_NUM_TAPS; i++ ) {
+			double const d      = ( KAISER_TAP_MIN + i ) - 0.5; // distance from filter center, in source texels
+			double const x      = d / 2;                        // sinc cutoff at half the source sampling rate
+			double const sinc   = x == 0 ? 1 : sin( PI * x ) / ( PI * x );
+			double const t      = d / half_width;
+			double const window = bessel_i0( KAISER_ALPHA * sqrt( std::max( 0., 1 - t * t ) ) ) / bessel_i0( KAISER_ALPHA );
+			w[ i ]              = float( sinc * window );
+			sum += w[ i ];
+		}
+		for ( auto& v : w ) {
+			v = float( v / sum );
+		}
+		return w;
+	}();
+	return weights.data();
+}
+
+// ----------------------------------------------------------------------
+// Averages 2x2 source texels for each texel in dst rows.
+static void mip_filter_box( mip_filter_job_t const& job ) {
+
+	uint32_t const src_w = job.src->width;
+	uint32_t const src_h = job.src->height;
+	uint32_t const dst_w = job.dst->width;
+
+	for ( uint32_t y = job.row_begin; y != job.row_end; y++ ) {
+
+		float const* r0  = job.src->texels.data() + size_t( std::min( 2 * y, src_h - 1 ) ) * src_w * 4;
+		float const* r1  = job.src->texels.data() + size_t( std::min( 2 * y + 1, src_h - 1 ) ) * src_w * 4;
+		float*       out = job.dst->texels.data() + size_t( y ) * dst_w * 4;
+
+		// Texels for which both source columns lie within the source image
+		uint32_t const num_full = std::min( dst_w, src_w / 2 );
+		uint32_t       x        = 0;
+
+#if defined( __AVX2__ )
+		__m256 const quarter_8 = _mm256_set1_ps( 0.25f );
+		for ( ; x + 2 <= num_full; x += 2 ) {
+			__m256 const a   = _mm256_add_ps( _mm256_loadu_ps( r0 + 8 * x ), _mm256_loadu_ps( r1 + 8 * x ) );         // texels 0, 1
+			__m256 const b   = _mm256_add_ps( _mm256_loadu_ps( r0 + 8 * x + 8 ), _mm256_loadu_ps( r1 + 8 * x + 8 ) ); // texels 2, 3
+			__m256 const sum = _mm256_add_ps( _mm256_permute2f128_ps( a, b, 0x20 ), _mm256_permute2f128_ps( a, b, 0x31 ) );
+			_mm256_storeu_ps( out + 4 * x, _mm256_mul_ps( sum, quarter_8 ) );
+		}
+#endif
+#if defined( __SSE2__ ) || defined( _M_X64 )
+		__m128 const quarter_4 = _mm_set1_ps( 0.25f );
+		for ( ; x < num_full; x++ ) {
+			__m128 const a = _mm_add_ps( _mm_loadu_ps( r0 + 8 * x ), _mm_loadu_ps( r0 + 8 * x + 4 ) );
+			__m128 const b = _mm_add_ps( _mm_loadu_ps( r1 + 8 * x ), _mm_loadu_ps( r1 + 8 * x + 4 ) );
+			_mm_storeu_ps( out + 4 * x, _mm_mul_ps( _mm_add_ps( a, b ), quarter_4 ) );
+		}
+#endif
+		// Remaining texels - and right edge for images with odd width, where we clamp to the last source column
+		for ( ; x < dst_w; x++ ) {
+			uint32_t const x0 = std::min( 2 * x, src_w - 1 ) * 4;
+			uint32_t const x1 = std::min( 2 * x + 1, src_w - 1 ) * 4;
+			for ( uint32_t c = 0; c != 4; c++ ) {
+				out[ 4 * x + c ] = 0.25f * ( r0[ x0 + c ] + r0[ x1 + c ] + r1[ x0 + c ] + r1[ x1 + c ] );
+			}
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+// Accumulates `weight * src` into `dst` for `num_texels` RGBA texels.
+static inline void texels_accumulate( float* dst, float const* src, float weight, uint32_t num_texels ) {
+
+	uint32_t i = 0;
+
+#if defined( __AVX2__ )
+	__m256 const w8 = _mm256_set1_ps( weight );
+	for ( ; i + 2 <= num_texels; i += 2 ) {
+		_mm256_storeu_ps( dst + 4 * i, _mm256_add_ps( _mm256_loadu_ps( dst + 4 * i ), _mm256_mul_ps( _mm256_loadu_ps( src + 4 * i ), w8 ) ) );
+	}
+#endif
+#if defined( __SSE2__ ) || defined( _M_X64 )
+	__m128 const w4 = _mm_set1_ps( weight );
+	for ( ; i < num_texels; i++ ) {
+		_mm_storeu_ps( dst + 4 * i, _mm_add_ps( _mm_loadu_ps( dst + 4 * i ), _mm_mul_ps( _mm_loadu_ps( src + 4 * i ), w4 ) ) );
+	}
+#endif
+	for ( ; i < num_texels; i++ ) {
+		for ( uint32_t c = 0; c != 4; c++ ) {
+			dst[ 4 * i + c ] += src[ 4 * i + c ] * weight;
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+// Separable Kaiser filter: we first filter source rows horizontally into a scratch
+// buffer - only the rows which this band of dst rows needs - and then filter
+// vertically from scratch into dst.
+static void mip_filter_kaiser( mip_filter_job_t const& job ) {
+
+	int const src_w = int( job.src->width );
+	int const src_h = int( job.src->height );
+	int const dst_w = int( job.dst->width );
+
+	float const* weights = get_kaiser_weights();
+
+	int const scratch_row_begin = 2 * int( job.row_begin ) + KAISER_TAP_MIN;
+	int const scratch_row_end   = 2 * int( job.row_end - 1 ) + KAISER_TAP_MIN + KAISER_NUM_TAPS;
+
+	std::vector<float> scratch( size_t( scratch_row_end - scratch_row_begin ) * dst_w * 4, 0.f );
+
+	for ( int sy = scratch_row_begin; sy != scratch_row_end; sy++ ) {
+
+		float const* src_row = job.src->texels.data() + size_t( std::clamp( sy, 0, src_h - 1 ) ) * src_w * 4;
+		float*       out     = scratch.data() + size_t( sy - scratch_row_begin ) * dst_w * 4;
+
+		for ( int x = 0; x != dst_w; x++ ) {
+#if defined( __SSE2__ ) || defined( _M_X64 )
+			__m128 acc = _mm_setzero_ps();
+			for ( int t = 0; t != KAISER_NUM_TAPS; t++ ) {
+				int const sx = std::clamp( 2 * x + KAISER_TAP_MIN + t, 0, src_w - 1 );
+				acc          = _mm_add_ps( acc, _mm_mul_ps( _mm_loadu_ps( src_row + 4 * sx ), _mm_set1_ps( weights[ t ] ) ) );
+			}
+			_mm_storeu_ps( out + 4 * x, acc );
+#else
+			for ( int t = 0; t != KAISER_NUM_TAPS; t++ ) {
+				int const sx = std::clamp( 2 * x + KAISER_TAP_MIN + t, 0, src_w - 1 );
+				for ( int c = 0; c != 4; c++ ) {
+					out[ 4 * x + c ] += src_row[ 4 * sx + c ] * weights[ t ];
+				}
+			}
+#endif
+		}
+	}
+
+	// Vertical pass - whole rows at a time, which is where SIMD pays off most.
+
+	for ( uint32_t y = job.row_begin; y != job.row_end; y++ ) {
+		float* out = job.dst->texels.data() + size_t( y ) * dst_w * 4;
+		std::fill( out, out + size_t( dst_w ) * 4, 0.f );
+		for ( int t = 0; t != KAISER_NUM_TAPS; t++ ) {
+			int const sy = 2 * int( y ) + KAISER_TAP_MIN + t - scratch_row_begin;
+			texels_accumulate( out, scratch.data() + size_t( sy ) * dst_w * 4, weights[ t ], uint32_t( dst_w ) );
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+
+static void mip_filter_run_job( void* param ) {
+	auto job = static_cast<mip_filter_job_t const*>( param );
+	if ( job->filter == le_pixels_api::eMipFilterKaiser ) {
+		mip_filter_kaiser( *job );
+	} else {
+		mip_filter_box( *job );
+	}
+}
+
+// ----------------------------------------------------------------------
+// Filters `src` into `dst`, using all available worker threads.
+static void mip_level_downsample( mip_level_t const& src, mip_level_t& dst, le_pixels_api::MipFilter filter ) {
+
+	dst.width  = std::max<uint32_t>( 1, src.width / 2 );
+	dst.height = std::max<uint32_t>( 1, src.height / 2 );
+	dst.texels.resize( size_t( dst.width ) * dst.height * 4 );
+
+	uint32_t const num_workers = le_jobs::get_worker_thread_count();
+
+	// Small levels aren't worth distributing over workers.
+	uint32_t const num_bands = ( num_workers == 0 || size_t( dst.width ) * dst.height < 64 * 64 )
+	                               ? 1
+	                               : std::min( dst.height, num_workers * 4 );
+
+	std::vector<mip_filter_job_t> bands( num_bands );
+
+	for ( uint32_t i = 0; i != num_bands; i++ ) {
+		bands[ i ] = { &src, &dst, filter, uint32_t( uint64_t( dst.height ) * i / num_bands ), uint32_t( uint64_t( dst.height ) * ( i + 1 ) / num_bands ) };
+	}
+
+	if ( num_bands == 1 ) {
+		mip_filter_run_job( &bands[ 0 ] );
+		return;
+	}
+
+	std::vector<le_jobs::job_t> jobs( num_bands );
+	for ( uint32_t i = 0; i != num_bands; i++ ) {
+		jobs[ i ] = { mip_filter_run_job, &bands[ i ] };
+	}
+
+	le_jobs::counter_t* counter;
+	le_jobs::run_jobs( jobs.data(), num_bands, &counter );
+	le_jobs::wait_for_counter_and_free( counter, 0 );
+}
+
+// ----------------------------------------------------------------------
+// sRGB formats store R, G, and B non-linearly - alpha is always linear. Images with
+// two channels hold grey, and alpha: only their first channel is non-linear.
+static inline bool channel_is_srgb( uint32_t channel, uint32_t num_channels ) {
+	return num_channels == 2 ? channel == 0 : channel < 3;
+}
+
+static float const* get_srgb_to_linear_table() {
+	static auto const table = []() {
+		std::array<float, 256> t{};
+		for ( int i = 0; i != 256; i++ ) {
+			float const c = i / 255.f;
+			t[ i ]        = c <= 0.04045f ? c / 12.92f : powf( ( c + 0.055f ) / 1.055f, 2.4f );
+		}
+		return t;
+	}();
+	return table.data();
+}
+
+static inline float linear_to_srgb( float c ) {
+	return c <= 0.0031308f ? c * 12.92f : 1.055f * powf( c, 1 / 2.4f ) - 0.055f;
+}
+
+// ----------------------------------------------------------------------
+
+static void mip_level_from_pixels( mip_level_t& level, void const* pixels, le_pixels_info const& info, bool is_srgb ) {
+
+	level.width  = info.width;
+	level.height = info.height;
+	level.texels.assign( size_t( info.width ) * info.height * 4, 1.f ); // missing channels (alpha) default to 1
+
+	size_t const   num_texels   = size_t( info.width ) * info.height;
+	uint32_t const num_channels = info.num_channels;
+	float const*   srgb_table   = get_srgb_to_linear_table();
+
+	for ( size_t i = 0; i != num_texels; i++ ) {
+		for ( uint32_t c = 0; c != num_channels; c++ ) {
+			size_t const src_idx = i * num_channels + c;
+			float&       dst     = level.texels[ i * 4 + c ];
+			switch ( info.type ) {
+			case le_pixels_info::eUInt8: {
+				uint8_t const v = static_cast<uint8_t const*>( pixels )[ src_idx ];
+				dst             = ( is_srgb && channel_is_srgb( c, num_channels ) ) ? srgb_table[ v ] : v / 255.f;
+				break;
+			}
+			case le_pixels_info::eUInt16:
+				dst = static_cast<uint16_t const*>( pixels )[ src_idx ] / 65535.f;
+				break;
+			case le_pixels_info::eFloat32:
+				dst = static_cast<float const*>( pixels )[ src_idx ];
+				break;
+			}
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+
+static void mip_level_to_pixels( mip_level_t const& level, void* pixels, le_pixels_info const& info, bool is_srgb ) {
+
+	size_t const   num_texels   = size_t( level.width ) * level.height;
+	uint32_t const num_channels = info.num_channels;
+
+	for ( size_t i = 0; i != num_texels; i++ ) {
+		for ( uint32_t c = 0; c != num_channels; c++ ) {
+			size_t const dst_idx = i * num_channels + c;
+			float        v       = level.texels[ i * 4 + c ];
+			switch ( info.type ) {
+			case le_pixels_info::eUInt8:
+				if ( is_srgb && channel_is_srgb( c, num_channels ) ) {
+					v = linear_to_srgb( std::clamp( v, 0.f, 1.f ) );
+				}
+				static_cast<uint8_t*>( pixels )[ dst_idx ] = uint8_t( std::clamp( v, 0.f, 1.f ) * 255.f + 0.5f );
+				break;
+			case le_pixels_info::eUInt16:
+				static_cast<uint16_t*>( pixels )[ dst_idx ] = uint16_t( std::clamp( v, 0.f, 1.f ) * 65535.f + 0.5f );
+				break;
+			case le_pixels_info::eFloat32:
+				static_cast<float*>( pixels )[ dst_idx ] = v;
+				break;
+			}
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+// Replaces pixels with a full mip chain, generated from the first mip level.
+// Only works for images which were decoded via stb_image, as we don't decode block-compressed pixels.
+static bool le_pixels_generate_mip_chain( le_pixels_o* self, le_pixels_api::MipFilter filter, bool is_srgb ) {
+
+	static auto logger = LeLog( "le_pixels" );
+
+	if ( self->info.format != 0 || self->info.depth != 1 ) {
+		logger.error( "ERROR: Can only generate mip chain for 2D images which were decoded from image files." );
+		return false;
+	}
+
+	if ( self->info.num_mip_levels > 1 ) {
+		return true; // already has a mip chain
+	}
+
+	uint32_t const num_mip_levels  = 1 + uint32_t( floor( log2( std::max( self->info.width, self->info.height ) ) ) );
+	uint32_t const bytes_per_texel = self->info.bpp / 8;
+
+	// Calculate subresources, and total size for all levels
+
+	std::vector<le_pixels_subresource_t> subresources;
+	subresources.reserve( num_mip_levels );
+
+	uint64_t byte_count = 0;
+
+	for ( uint32_t level = 0; level != num_mip_levels; level++ ) {
+		uint32_t const w = std::max<uint32_t>( 1, self->info.width >> level );
+		uint32_t const h = std::max<uint32_t>( 1, self->info.height >> level );
+		subresources.push_back( { level, 0, w, h, byte_count, uint64_t( w ) * h * bytes_per_texel } );
+		byte_count += subresources.back().byte_count;
+	}
+
+	if ( byte_count > UINT32_MAX ) {
+		logger.error( "ERROR: Mip chain is too large: %llu Bytes.", ( unsigned long long )byte_count );
+		return false;
+	}
+
+	auto image_data = static_cast<unsigned char*>( malloc( byte_count ) );
+
+	if ( image_data == nullptr ) {
+		return false;
+	}
+
+	// First level is a copy of the original pixels - we don't want to lose precision to a round-trip.
+	memcpy( image_data, self->image_data, subresources[ 0 ].byte_count );
+
+	mip_level_t src;
+	mip_level_t dst;
+
+	mip_level_from_pixels( src, self->image_data, self->info, is_srgb );
+
+	for ( uint32_t level = 1; level != num_mip_levels; level++ ) {
+		mip_level_downsample( src, dst, filter );
+		mip_level_to_pixels( dst, image_data + subresources[ level ].offset, self->info, is_srgb );
+		std::swap( src, dst );
+	}
+
+	// Replace original pixels
+
+	if ( self->owns_image_data ) {
+		if ( self->subresources.empty() ) {
+			stbi_image_free( self->image_data );
+		} else {
+			free( self->image_data );
+		}
+	}
+
+	self->image_data          = image_data;
+	self->owns_image_data     = true;
+	self->subresources        = std::move( subresources );
+	self->info.num_mip_levels = num_mip_levels;
+	self->info.byte_count     = uint32_t( byte_count );
+
+	return true;
+}
+
+// ----------------------------------------------------------------------
+// Writes pixels - with all mip levels - into a KTX2 file, which can be loaded without
+// needing to be decoded, or having its mip chain generated again.
+static bool le_pixels_write_ktx2( le_pixels_o* self, char const* file_path, bool is_srgb ) {
+
+	static auto logger = LeLog( "le_pixels" );
+
+	uncompressed_format_t const* format =
+	    self->info.format ? uncompressed_format_find( self->info.format )
+	                      : uncompressed_format_find( self->info.num_channels, self->info.type, is_srgb && self->info.type == le_pixels_info::eUInt8 );
+
+	if ( format == nullptr ) {
+		logger.error( "ERROR: Cannot write KTX2 file '%s': unsupported pixel format.", file_path );
+		return false;
+	}
+
+	// Subresources, if pixels have only a single level and layer
+
+	le_pixels_subresource_t const  single_subresource = { 0, 0, self->info.width, self->info.height, 0, self->info.byte_count };
+	le_pixels_subresource_t const* subresources       = self->subresources.empty() ? &single_subresource : self->subresources.data();
+	size_t const                   num_subresources   = self->subresources.empty() ? 1 : self->subresources.size();
+
+	uint32_t const num_levels      = std::max<uint32_t>( 1, self->info.num_mip_levels );
+	uint32_t const num_layers      = std::max<uint32_t>( 1, self->info.num_layers );
+	uint32_t const bytes_per_value = get_num_bytes_for_type( format->type );
+	uint32_t const bytes_per_texel = bytes_per_value * format->num_channels;
+	uint32_t const level_alignment = std::lcm( bytes_per_texel, 4u ); // KTX2 requires levels to be aligned to lcm(texel block size, 4)
+
+	// Data format descriptor: a basic descriptor block, with one sample per channel.
+
+	std::vector<uint32_t> dfd;
+	{
+		uint32_t const num_samples = format->num_channels;
+		uint32_t const block_size  = 24 + 16 * num_samples;
+
+		dfd.push_back( 4 + block_size );                                          // total dfd size
+		dfd.push_back( 0 );                                                       // vendor id: khronos, descriptor type: basic
+		dfd.push_back( 2 | ( block_size << 16 ) );                                // version 1.3, block size
+		dfd.push_back( 1 | ( 1 << 8 ) | ( ( format->is_srgb ? 2 : 1 ) << 16 ) ); // model: rgbsda, primaries: bt709, transfer: srgb or linear, flags: straight alpha
+		dfd.push_back( 0 );                                                       // texel block dimensions: 1x1x1x1
+		dfd.push_back( bytes_per_texel );                                         // bytes in plane 0
+		dfd.push_back( 0 );                                                       // bytes in planes 4..7
+
+		for ( uint32_t c = 0; c != num_samples; c++ ) {
+			bool const     is_alpha     = ( num_samples == 4 && c == 3 );
+			uint32_t       channel_type = is_alpha ? 15 : c; // rgbsda channel ids: r, g, b, ... a == 15
+			uint32_t const bit_length   = bytes_per_value * 8;
+
+			if ( format->type == le_pixels_info::eFloat32 ) {
+				channel_type |= 0x80 | 0x40; // float, signed
+			} else if ( format->is_srgb && is_alpha ) {
+				channel_type |= 0x10; // alpha is linear for srgb formats
+			}
+
+			dfd.push_back( ( c * bit_length ) | ( ( bit_length - 1 ) << 16 ) | ( channel_type << 24 ) );
+			dfd.push_back( 0 ); // sample position
+
+			if ( format->type == le_pixels_info::eFloat32 ) {
+				dfd.push_back( 0xBF800000 ); // -1.f
+				dfd.push_back( 0x3F800000 ); // +1.f
+			} else {
+				dfd.push_back( 0 );
+				dfd.push_back( uint32_t( ( uint64_t( 1 ) << bit_length ) - 1 ) );
+			}
+		}
+	}
+
+	// Levels are stored smallest first; images for all layers of a level follow one another.
+
+	uint64_t const dfd_offset  = sizeof( ktx2_header_t ) + num_levels * sizeof( ktx2_level_index_t );
+	uint64_t       data_offset = dfd_offset + dfd.size() * sizeof( uint32_t );
+
+	std::vector<ktx2_level_index_t> level_index( num_levels );
+
+	for ( uint32_t level = num_levels; level-- > 0; ) {
+		data_offset = ( data_offset + level_alignment - 1 ) / level_alignment * level_alignment;
+
+		uint64_t level_bytes = 0;
+		for ( size_t i = 0; i != num_subresources; i++ ) {
+			if ( subresources[ i ].mip_level == level ) {
+				level_bytes += subresources[ i ].byte_count;
+			}
+		}
+
+		level_index[ level ] = { data_offset, level_bytes, level_bytes };
+		data_offset += level_bytes;
+	}
+
+	ktx2_header_t header{};
+	memcpy( header.identifier, KTX2_IDENTIFIER, sizeof( KTX2_IDENTIFIER ) );
+	header.vk_format               = format->format;
+	header.type_size               = bytes_per_value;
+	header.pixel_width             = self->info.width;
+	header.pixel_height            = self->info.height;
+	header.pixel_depth             = 0;
+	header.layer_count             = num_layers > 1 ? num_layers : 0;
+	header.face_count              = 1;
+	header.level_count             = num_levels;
+	header.supercompression_scheme = 0;
+	header.dfd_byte_offset         = uint32_t( dfd_offset );
+	header.dfd_byte_length         = uint32_t( dfd.size() * sizeof( uint32_t ) );
+
+	FILE* file = fopen( file_path, "wb" );
+
+	if ( file == nullptr ) {
+		logger.error( "ERROR: Could not open file for writing: '%s'", file_path );
+		return false;
+	}
+
+	bool success = true;
+
+	success &= 1 == fwrite( &header, sizeof( header ), 1, file );
+	success &= num_levels == fwrite( level_index.data(), sizeof( ktx2_level_index_t ), num_levels, file );
+	success &= dfd.size() == fwrite( dfd.data(), sizeof( uint32_t ), dfd.size(), file );
+
+	for ( uint32_t level = num_levels; success && level-- > 0; ) {
+
+		// Pad up to level offset
+		static constexpr char zeroes[ 16 ] = {};
+		long const            padding      = long( level_index[ level ].byte_offset ) - ftell( file );
+		success &= padding >= 0 && size_t( padding ) == fwrite( zeroes, 1, size_t( padding ), file );
+
+		for ( uint32_t layer = 0; layer != num_layers; layer++ ) {
+			for ( size_t i = 0; i != num_subresources; i++ ) {
+				auto const& s = subresources[ i ];
+				if ( s.mip_level == level && s.layer == layer ) {
+					success &= s.byte_count == fwrite( static_cast<char const*>( self->image_data ) + s.offset, 1, s.byte_count, file );
+				}
+			}
+		}
+	}
+
+	fclose( file );
+
+	if ( !success ) {
+		logger.error( "ERROR: Could not write KTX2 file: '%s'", file_path );
+	}
+
+	return success;
+}
+
+// ----------------------------------------------------------------------
+
 static le_pixels_info le_pixels_get_info( le_pixels_o* self ) {
 	return self->info;
 }
@@ -177,6 +1531,17 @@ static void* le_pixels_get_data( le_pixels_o* self ) {
 
 // ----------------------------------------------------------------------
 
+static bool le_pixels_get_subresources( le_pixels_o* self, le_pixels_subresource_t const** subresources, size_t* num_subresources ) {
+	if ( self->subresources.empty() ) {
+		return false;
+	}
+	*subresources     = self->subresources.data();
+	*num_subresources = self->subresources.size();
+	return true;
+}
+
+// ----------------------------------------------------------------------
+
 static bool le_pixels_get_info_from_source( image_source_info_t const& source, le_pixels_info* info ) {
 
 	if ( info == nullptr ) {
@@ -196,6 +1561,20 @@ static bool le_pixels_get_info_from_source( image_source_info_t const& source, l
 		assert( false );
 	}
 
+	// Container files hold information which stb_image does not know about.
+
+	if ( source.type == image_source_info_t::Type::eBuffer ) {
+		if ( auto type = container_get_type( source.data.as_buffer.buffer, source.data.as_buffer.buffer_num_bytes ); type != ContainerType::eNone ) {
+			return container_read_header( type, source.data.as_buffer.buffer, source.data.as_buffer.buffer_num_bytes, info, nullptr );
+		}
+	} else {
+		if ( auto type = container_get_type_from_file( source.data.as_file.file_path ); type != ContainerType::eNone ) {
+			std::vector<unsigned char> file_contents;
+			return read_file( source.data.as_file.file_path, file_contents ) &&
+			       container_read_header( type, file_contents.data(), file_contents.size(), info, nullptr );
+		}
+	}
+
 	int width;
 	int height;
 	int components;
@@ -242,8 +1621,11 @@ static bool le_pixels_get_info_from_source( image_source_info_t const& source, l
 		info->type = le_pixels_info::Type::eUInt8;
 	}
 
-	info->bpp        = 8 * get_num_bytes_for_type( info->type ) * uint32_t( info->num_channels ); // note * 8, since we're returning bits per pixels!
-	info->byte_count = ( info->bpp / 8 ) * ( info->width * info->height * info->depth );
+	info->bpp            = 8 * get_num_bytes_for_type( info->type ) * uint32_t( info->num_channels ); // note * 8, since we're returning bits per pixels!
+	info->byte_count     = ( info->bpp / 8 ) * ( info->width * info->height * info->depth );
+	info->num_mip_levels = 1;
+	info->num_layers     = 1;
+	info->format         = 0;
 
 	return true;
 }
@@ -275,10 +1657,22 @@ LE_MODULE_REGISTER_IMPL( le_pixels, api ) {
 	le_pixels_i.create             = le_pixels_create_from_file;
 	le_pixels_i.create_from_memory = le_pixels_create_from_memory;
 
+	le_pixels_i.load_async_from_file   = le_pixels_load_async_from_file;
+	le_pixels_i.load_async_from_memory = le_pixels_load_async_from_memory;
+	le_pixels_i.load_is_ready          = le_pixels_load_is_ready;
+	le_pixels_i.load_wait              = le_pixels_load_wait;
+
+	le_pixels_i.create_batch_from_files = le_pixels_create_batch_from_files;
+
 	le_pixels_i.get_info_from_memory = le_pixels_get_info_from_memory;
 	le_pixels_i.get_info_from_file   = le_pixels_get_info_from_file;
 
 	le_pixels_i.destroy  = le_pixels_destroy;
 	le_pixels_i.get_data = le_pixels_get_data;
 	le_pixels_i.get_info = le_pixels_get_info;
+
+	le_pixels_i.get_subresources = le_pixels_get_subresources;
+
+	le_pixels_i.generate_mip_chain = le_pixels_generate_mip_chain;
+	le_pixels_i.write_ktx2         = le_pixels_write_ktx2;
 }
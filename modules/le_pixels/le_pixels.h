@@ -4,6 +4,7 @@
 #include "le_core.h"
 
 struct le_pixels_o;
+struct le_pixels_load_o; // handle for a pending decode, see `load_async_from_file`
 
 struct le_pixels_info {
 	// Note that we store the log2 of the number of Bytes needed to store values of a type
@@ -13,18 +14,37 @@ struct le_pixels_info {
 		eUInt16  = ( 1 << 2 ) | 1,
 		eFloat32 = ( 2 << 2 ) | 2, // 32 bit float type
 	};
-	uint32_t width;        //
-	uint32_t height;       //
-	uint32_t depth;        // 1 by default
-	uint32_t bpp;          // bits per pixel
-	uint32_t num_channels; // number of channels
-	uint32_t byte_count;   // total number of bytes
-	Type     type;
+	uint32_t width;          //
+	uint32_t height;         //
+	uint32_t depth;          // 1 by default
+	uint32_t bpp;            // bits per pixel
+	uint32_t num_channels;   // number of channels
+	uint32_t byte_count;     // total number of bytes
+	Type     type;           //
+	uint32_t num_mip_levels; // number of mip levels stored with the image, 1 unless image was loaded from a container (KTX2, DDS), or has had its mip chain generated
+	uint32_t num_layers;     // number of array layers (cube faces count as layers) stored with the image
+	uint32_t format;         // le::Format (== VkFormat) of pixels loaded from a container file, 0 if pixels were decoded via stb_image
+};
+
+// Describes where to find pixels for a single mip level of a single layer, for images
+// which were loaded from a container file with pre-built mip levels, and/or layers.
+struct le_pixels_subresource_t {
+	uint32_t mip_level;
+	uint32_t layer;
+	uint32_t width;      // in texels
+	uint32_t height;     // in texels
+	uint64_t offset;     // in bytes, relative to get_data()
+	uint64_t byte_count; //
 };
 
 // clang-format off
 struct le_pixels_api {
 
+	enum MipFilter : uint32_t {
+		eMipFilterBox = 0, // average of 2x2 texels - fastest
+		eMipFilterKaiser,  // kaiser-windowed sinc - sharper, with less aliasing
+	};
+
 	struct le_pixels_interface_t {
 
 		bool (* get_info_from_memory ) ( unsigned char const * buffer, size_t buffer_byte_count, le_pixels_info * info);
@@ -36,6 +56,44 @@ struct le_pixels_api {
 
 		le_pixels_info   ( * get_info ) ( le_pixels_o* self );
 		void *           ( * get_data ) ( le_pixels_o* self );
+
+		// Images loaded from KTX2 or DDS containers keep their block-compressed (BC1-BC7) pixels, with all
+		// mip levels and layers stored in the container. Returns false if pixels were decoded via stb_image,
+		// in which case there is just one subresource, and all of get_data() belongs to it.
+		bool             ( * get_subresources ) ( le_pixels_o* self, le_pixels_subresource_t const ** subresources, size_t* num_subresources );
+
+		// Replace pixels with a full mip chain, downsampled from the first level on all available worker threads.
+		// Filtering happens in linear space: set `is_srgb` for 8 bit images which hold sRGB colours. Mip levels are
+		// accessible via get_subresources. Alpha - and the second channel of two-channel (grey, alpha) images -
+		// is always filtered linearly. Fails for images loaded from container files.
+		bool             ( * generate_mip_chain ) ( le_pixels_o* self, MipFilter filter, bool is_srgb );
+
+		// Write pixels, with all mip levels and layers, into a KTX2 file - which can then be loaded without
+		// decoding, or downsampling. `is_srgb` selects an sRGB format for 8 bit images. Fails for block-compressed images.
+		bool             ( * write_ktx2         ) ( le_pixels_o* self, char const * file_path, bool is_srgb );
+
+		// Start decoding an image on a le_jobs worker thread - or right away, if the job system
+		// has not been initialised. Returns a handle which must be passed to `load_wait`.
+		//
+		// If `target_memory` is given, decoded pixels are placed there (this may be mapped memory),
+		// and the resulting pixels object does not own its data. Decoding fails if
+		// `target_memory_capacity` is smaller than the decoded image.
+		//
+		// Memory given via `buffer` must stay valid until decoding has completed.
+		le_pixels_load_o * ( * load_async_from_file   ) ( char const * file_path, int num_channels_requested, le_pixels_info::Type type, void* target_memory, size_t target_memory_capacity );
+		le_pixels_load_o * ( * load_async_from_memory ) ( unsigned char const * buffer, size_t buffer_byte_count, int num_channels_requested, le_pixels_info::Type type, void* target_memory, size_t target_memory_capacity );
+
+		// Returns true once decoding has completed; never blocks.
+		bool               ( * load_is_ready          ) ( le_pixels_load_o const * self );
+
+		// Blocks until decoding has completed, and frees the load handle. Caller takes
+		// ownership of returned pixels, which are nullptr if the image could not be decoded.
+		le_pixels_o *      ( * load_wait              ) ( le_pixels_load_o * self );
+
+		// Decode many files at once, using all available worker threads. Blocks until all files are decoded.
+		// Writes `num_files` pixels objects into `results`: nullptr for any file which could not be decoded.
+		// Returns true if all files were decoded successfully.
+		bool ( * create_batch_from_files )( char const * const * file_paths, size_t num_files, int num_channels_requested, le_pixels_info::Type type, le_pixels_o** results );
 	};
 
 	le_pixels_interface_t       le_pixels_i;
@@ -75,6 +133,18 @@ class Pixels : NoCopy, NoMove {
 		return le_pixels::le_pixels_i.get_info( self );
 	}
 
+	bool getSubresources( le_pixels_subresource_t const** subresources, size_t* num_subresources ) noexcept {
+		return le_pixels::le_pixels_i.get_subresources( self, subresources, num_subresources );
+	}
+
+	bool generateMipChain( le_pixels_api::MipFilter const& filter = le_pixels_api::eMipFilterBox, bool isSrgb = false ) noexcept {
+		return le_pixels::le_pixels_i.generate_mip_chain( self, filter, isSrgb );
+	}
+
+	bool writeKtx2( char const* filePath, bool isSrgb = false ) noexcept {
+		return le_pixels::le_pixels_i.write_ktx2( self, filePath, isSrgb );
+	}
+
 	bool isValid() noexcept {
 		return ( self );
 	}
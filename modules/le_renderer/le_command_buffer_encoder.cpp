@@ -88,18 +88,22 @@ struct le_command_buffer_encoder_o {
 	le_allocator_o**                        ppAllocator        = nullptr; // allocator list is owned by backend, externally
 	le_pipeline_manager_o*                  pipelineManager    = nullptr; // non-owning: owned by backend.
 	le_staging_allocator_o*                 stagingAllocator   = nullptr; // Borrowed from backend - used for larger, permanent resources, shared amongst encoders
+	le_backend_o*                           backend            = nullptr; // non-owning - used to look up bindless indices
 	le::Extent2D                            extent             = {};      // Renderpass extent, otherwise swapchain extent inferred via renderer, this may be queried by users of encoder.
+	uint64_t                                frame_number       = 0;       // Number of the frame which this encoder records, may be queried by users of encoder.
 	std::vector<le_shader_binding_table_o*> shader_binding_tables;        // owning
 };
 
 // ----------------------------------------------------------------------
 
-static le_command_buffer_encoder_o* cbe_create( le_allocator_o** allocator, le_command_stream_t* command_stream, le_pipeline_manager_o* pipelineManager, le_staging_allocator_o* stagingAllocator, le::Extent2D const* extent ) {
+static le_command_buffer_encoder_o* cbe_create( le_allocator_o** allocator, le_command_stream_t* command_stream, le_pipeline_manager_o* pipelineManager, le_staging_allocator_o* stagingAllocator, le_backend_o* backend, le::Extent2D const* extent, uint64_t frame_number ) {
 	auto self              = new le_command_buffer_encoder_o;
 	self->ppAllocator      = allocator;
 	self->mCommandStream   = command_stream;
 	self->pipelineManager  = pipelineManager;
 	self->stagingAllocator = stagingAllocator;
+	self->backend          = backend;
+	self->frame_number     = frame_number;
 	if ( extent ) {
 		self->extent = *extent;
 	}
@@ -126,6 +130,12 @@ static void cbe_get_extent( le_command_buffer_encoder_o* self, le::Extent2D* ext
 
 // ----------------------------------------------------------------------
 
+static uint64_t cbe_get_frame_number( le_command_buffer_encoder_o* self ) {
+	return self->frame_number;
+}
+
+// ----------------------------------------------------------------------
+
 static void cbe_set_line_width( le_command_buffer_encoder_o* self, float lineWidth ) {
 
 	auto cmd        = self->mCommandStream->emplace_cmd<le::CommandSetLineWidth>(); // placement new into data array
@@ -209,6 +219,58 @@ static void cbe_draw_mesh_tasks( le_command_buffer_encoder_o* self,
 }
 // ----------------------------------------------------------------------
 
+static void cbe_draw_indirect( le_command_buffer_encoder_o* self,
+                               le_buf_resource_handle const buffer,
+                               uint64_t                     offset,
+                               uint32_t                     drawCount,
+                               uint32_t                     stride ) {
+
+	auto cmd  = self->mCommandStream->emplace_cmd<le::CommandDrawIndirect>(); // placement new!
+	cmd->info = { buffer, offset, drawCount, stride };
+}
+
+// ----------------------------------------------------------------------
+
+static void cbe_draw_indexed_indirect( le_command_buffer_encoder_o* self,
+                                       le_buf_resource_handle const buffer,
+                                       uint64_t                     offset,
+                                       uint32_t                     drawCount,
+                                       uint32_t                     stride ) {
+
+	auto cmd  = self->mCommandStream->emplace_cmd<le::CommandDrawIndexedIndirect>(); // placement new!
+	cmd->info = { buffer, offset, drawCount, stride };
+}
+
+// ----------------------------------------------------------------------
+
+static void cbe_draw_indirect_count( le_command_buffer_encoder_o* self,
+                                     le_buf_resource_handle const buffer,
+                                     uint64_t                     offset,
+                                     le_buf_resource_handle const countBuffer,
+                                     uint64_t                     countBufferOffset,
+                                     uint32_t                     maxDrawCount,
+                                     uint32_t                     stride ) {
+
+	auto cmd  = self->mCommandStream->emplace_cmd<le::CommandDrawIndirectCount>(); // placement new!
+	cmd->info = { buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride };
+}
+
+// ----------------------------------------------------------------------
+
+static void cbe_draw_indexed_indirect_count( le_command_buffer_encoder_o* self,
+                                             le_buf_resource_handle const buffer,
+                                             uint64_t                     offset,
+                                             le_buf_resource_handle const countBuffer,
+                                             uint64_t                     countBufferOffset,
+                                             uint32_t                     maxDrawCount,
+                                             uint32_t                     stride ) {
+
+	auto cmd  = self->mCommandStream->emplace_cmd<le::CommandDrawIndexedIndirectCount>(); // placement new!
+	cmd->info = { buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride };
+}
+
+// ----------------------------------------------------------------------
+
 static void cbe_set_viewport( le_command_buffer_encoder_o* self,
                               uint32_t                     firstViewport,
                               const uint32_t               viewportCount,
@@ -896,6 +958,26 @@ static le_pipeline_manager_o* cbe_get_pipeline_manager( le_command_buffer_encode
 	return self->pipelineManager;
 }
 
+// ----------------------------------------------------------------------
+// Bindless mode: returns index of texture in the bindless texture array.
+// Note that the texture must still be used by the pass which draws with it,
+// so that the backend can write its descriptor for this frame.
+static uint32_t cbe_get_bindless_texture_index( le_command_buffer_encoder_o* self, le_texture_handle const texture ) {
+	if ( self->backend == nullptr ) {
+		return LE_BINDLESS_INDEX_INVALID;
+	}
+	return le_backend_vk::vk_backend_i.get_bindless_texture_index( self->backend, texture );
+}
+
+// ----------------------------------------------------------------------
+// Bindless mode: returns index of buffer in the bindless storage buffer array.
+static uint32_t cbe_get_bindless_buffer_index( le_command_buffer_encoder_o* self, le_buf_resource_handle const buffer ) {
+	if ( self->backend == nullptr ) {
+		return LE_BINDLESS_INDEX_INVALID;
+	}
+	return le_backend_vk::vk_backend_i.get_bindless_buffer_index( self->backend, buffer );
+}
+
 // ----------------------------------------------------------------------
 
 le_shader_binding_table_o* cbe_build_shader_binding_table( le_command_buffer_encoder_o* self, le_rtxpso_handle pipeline ) {
@@ -960,37 +1042,46 @@ void register_le_command_buffer_encoder_api( void* api_ ) {
 	};
 
 	cbe_graphics_i = {
-	    .get_pipeline_manager   = cbe_get_pipeline_manager,
-	    .set_push_constant_data = cbe_set_push_constant_data,
-	    .bind_argument_buffer   = cbe_bind_argument_buffer,
-	    .buffer_memory_barrier  = cbe_buffer_memory_barrier,
-	    .set_argument_data      = cbe_set_argument_data,
-	    .set_argument_texture   = cbe_set_argument_texture,
-	    .set_argument_image     = cbe_set_argument_image,
-	    .draw                   = cbe_draw,
-	    .draw_indexed           = cbe_draw_indexed,
-	    .draw_mesh_tasks        = cbe_draw_mesh_tasks,
-	    .bind_graphics_pipeline = cbe_bind_graphics_pipeline,
-	    .set_line_width         = cbe_set_line_width,
-	    .set_viewport           = cbe_set_viewport,
-	    .set_scissor            = cbe_set_scissor,
-	    .bind_index_buffer      = cbe_bind_index_buffer,
-	    .bind_vertex_buffers    = cbe_bind_vertex_buffers,
-	    .set_index_data         = cbe_set_index_data,
-	    .set_vertex_data        = cbe_set_vertex_data,
-	    .get_extent             = cbe_get_extent,
+	    .get_pipeline_manager        = cbe_get_pipeline_manager,
+	    .set_push_constant_data      = cbe_set_push_constant_data,
+	    .bind_argument_buffer        = cbe_bind_argument_buffer,
+	    .buffer_memory_barrier       = cbe_buffer_memory_barrier,
+	    .set_argument_data           = cbe_set_argument_data,
+	    .set_argument_texture        = cbe_set_argument_texture,
+	    .set_argument_image          = cbe_set_argument_image,
+	    .draw                        = cbe_draw,
+	    .draw_indexed                = cbe_draw_indexed,
+	    .draw_mesh_tasks             = cbe_draw_mesh_tasks,
+	    .draw_indirect               = cbe_draw_indirect,
+	    .draw_indexed_indirect       = cbe_draw_indexed_indirect,
+	    .draw_indirect_count         = cbe_draw_indirect_count,
+	    .draw_indexed_indirect_count = cbe_draw_indexed_indirect_count,
+	    .bind_graphics_pipeline      = cbe_bind_graphics_pipeline,
+	    .set_line_width              = cbe_set_line_width,
+	    .set_viewport                = cbe_set_viewport,
+	    .set_scissor                 = cbe_set_scissor,
+	    .bind_index_buffer           = cbe_bind_index_buffer,
+	    .bind_vertex_buffers         = cbe_bind_vertex_buffers,
+	    .set_index_data              = cbe_set_index_data,
+	    .set_vertex_data             = cbe_set_vertex_data,
+	    .get_extent                  = cbe_get_extent,
+	    .get_frame_number            = cbe_get_frame_number,
+	    .get_bindless_texture_index  = cbe_get_bindless_texture_index,
+	    .get_bindless_buffer_index   = cbe_get_bindless_buffer_index,
 	};
 
 	cbe_compute_i = {
-	    .get_pipeline_manager   = cbe_get_pipeline_manager,
-	    .bind_compute_pipeline  = cbe_bind_compute_pipeline,
-	    .set_push_constant_data = cbe_set_push_constant_data,
-	    .bind_argument_buffer   = cbe_bind_argument_buffer,
-	    .set_argument_data      = cbe_set_argument_data,
-	    .set_argument_texture   = cbe_set_argument_texture,
-	    .set_argument_image     = cbe_set_argument_image,
-	    .dispatch               = cbe_dispatch,
-	    .buffer_memory_barrier  = cbe_buffer_memory_barrier,
+	    .get_pipeline_manager       = cbe_get_pipeline_manager,
+	    .bind_compute_pipeline      = cbe_bind_compute_pipeline,
+	    .set_push_constant_data     = cbe_set_push_constant_data,
+	    .bind_argument_buffer       = cbe_bind_argument_buffer,
+	    .set_argument_data          = cbe_set_argument_data,
+	    .set_argument_texture       = cbe_set_argument_texture,
+	    .set_argument_image         = cbe_set_argument_image,
+	    .dispatch                   = cbe_dispatch,
+	    .buffer_memory_barrier      = cbe_buffer_memory_barrier,
+	    .get_bindless_texture_index = cbe_get_bindless_texture_index,
+	    .get_bindless_buffer_index  = cbe_get_bindless_buffer_index,
 	};
 
 	cbe_transfer_i = {
@@ -17,6 +17,8 @@
 #include <string>
 #include <cstring> // for memcpy
 #include <bitset>
+#include <chrono>
+#include <thread>
 
 #include "private/le_renderer/le_resource_handle_t.inl"
 #include "private/le_renderer/le_rendergraph.h"
@@ -57,6 +59,9 @@ struct FrameData {
 	le_rendergraph_o* rendergraph = nullptr;
 
 	size_t frameNumber = size_t( ~0 );
+
+	uint64_t input_time_ns    = 0; // time of input event which this frame reflects, if tagged via set_input_timestamp, 0 otherwise
+	uint64_t dispatch_time_ns = 0; // time at which this frame was dispatched
 };
 
 struct le_texture_handle_t {
@@ -144,8 +149,27 @@ struct le_renderer_o {
 	size_t                 backendDataFramesCount = 0;
 	size_t                 currentFrameNumber = size_t( ~0 ); // ever increasing number of current frame
 	le_renderer_settings_t settings;
+
+	struct FramePacing {
+		double fence_wait_ms = 0; // how long the most recent clear had to wait for its frame fence
+		double delay_ms      = 0; // low latency: how long to delay the next frame, adapted with every frame
+	} pacing;
+
+	struct LatencyStats {
+		uint32_t num_frames               = 0; // tagged frames which completed since the previous call to get_latency_stats
+		double   input_to_dispatch_ms_sum = 0; // get_latency_stats divides sums by num_frames
+		double   input_to_dispatch_ms_max = 0; //
+		double   input_to_complete_ms_sum = 0; //
+		double   input_to_complete_ms_max = 0; //
+	} latency_stats;
+
+	uint64_t next_input_time_ns = 0; // input time for the next frame to be recorded
 };
 
+static uint64_t renderer_now_ns() {
+	return uint64_t( std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count() );
+}
+
 static void renderer_clear_frame( le_renderer_o* self, size_t frameIndex ); // ffdecl
 
 // ----------------------------------------------------------------------
@@ -396,6 +420,13 @@ static void renderer_setup( le_renderer_o* self, le_renderer_settings_t const* s
 		le_backend_vk::settings_i.set_concurrency_count( LE_MT );
 #endif
 
+		if ( self->settings.frames_in_flight != 0 ) {
+			if ( self->settings.frames_in_flight < 2 ||
+			     false == le_backend_vk::settings_i.set_data_frames_count( self->settings.frames_in_flight ) ) {
+				LeLog( "le_renderer" ).warn( "Could not set number of frames in flight to %d.", self->settings.frames_in_flight );
+			}
+		}
+
 		// We can now initialize the backend so that it hopefully conforms to
 		// any requirements and capabilities that have been requested so far...
 		//
@@ -465,6 +496,8 @@ static void renderer_clear_frame( le_renderer_o* self, size_t frameIndex ) {
 	     frame.state == FrameData::State::eFailedDispatch ||
 	     frame.state == FrameData::State::eFailedClear ) {
 
+		uint64_t const wait_begin_ns = renderer_now_ns();
+
 		while ( false == vk_backend_i.poll_frame_fence( self->backend, frameIndex ) ) {
 			// Note: this call may block until the fence has been reached.
 #if ( LE_MT > 0 )
@@ -472,6 +505,26 @@ static void renderer_clear_frame( le_renderer_o* self, size_t frameIndex ) {
 #endif
 		}
 
+		uint64_t const wait_end_ns = renderer_now_ns();
+
+		self->pacing.fence_wait_ms = double( wait_end_ns - wait_begin_ns ) * 1e-6;
+
+		if ( frame.input_time_ns && frame.state == FrameData::State::eDispatched ) {
+			// We can only tell when we saw that the frame had completed - which is why
+			// input to complete is an upper bound.
+			auto&  stats                = self->latency_stats;
+			double input_to_dispatch_ms = double( frame.dispatch_time_ns - frame.input_time_ns ) * 1e-6;
+			double input_to_complete_ms = double( wait_end_ns - frame.input_time_ns ) * 1e-6;
+
+			stats.input_to_dispatch_ms_sum += input_to_dispatch_ms;
+			stats.input_to_complete_ms_sum += input_to_complete_ms;
+			stats.input_to_dispatch_ms_max = std::max( stats.input_to_dispatch_ms_max, input_to_dispatch_ms );
+			stats.input_to_complete_ms_max = std::max( stats.input_to_complete_ms_max, input_to_complete_ms );
+			stats.num_frames++;
+		}
+
+		frame.input_time_ns = 0;
+
 		bool result = vk_backend_i.clear_frame( self->backend, frameIndex );
 
 		if ( result != true ) {
@@ -506,6 +559,9 @@ static void renderer_record_frame( le_renderer_o* self, size_t frameIndex, le_re
 		return;
 	}
 
+	frame.input_time_ns      = self->next_input_time_ns;
+	self->next_input_time_ns = 0;
+
 	// ---------| invariant: Frame was previously acquired successfully.
 
 	// - build up dependencies for graph, create table of unique resources for graph
@@ -630,7 +686,8 @@ static void renderer_dispatch_frame( le_renderer_o* self, size_t frameIndex ) {
 
 	vk_backend_i.dispatch_frame( self->backend, frameIndex );
 
-	frame.state = FrameData::State::eDispatched;
+	frame.dispatch_time_ns = renderer_now_ns();
+	frame.state            = FrameData::State::eDispatched;
 }
 
 // ----------------------------------------------------------------------
@@ -680,6 +737,90 @@ static bool renderer_get_swapchains( le_renderer_o* self, size_t* num_swapchains
 	assert( self->backend && "Backend must exist" );
 	return vk_backend_i.get_swapchains( self->backend, num_swapchains, p_swapchain_handles );
 }
+
+// ----------------------------------------------------------------------
+
+static bool renderer_get_pass_timings( le_renderer_o* self, le_pass_timing_t* p_timings, size_t* num_timings, uint64_t* p_frame_number ) {
+	using namespace le_backend_vk;
+	assert( self->backend && "Backend must exist" );
+	return vk_backend_i.get_pass_timings( self->backend, p_timings, num_timings, p_frame_number );
+}
+
+// ----------------------------------------------------------------------
+
+static void renderer_set_input_timestamp( le_renderer_o* self, uint64_t input_time_ns ) {
+	self->next_input_time_ns = input_time_ns ? input_time_ns : renderer_now_ns();
+}
+
+// ----------------------------------------------------------------------
+
+static void renderer_get_latency_stats( le_renderer_o* self, le_renderer_latency_stats_t* stats ) {
+	auto const& latency = self->latency_stats;
+
+	*stats = {};
+
+	stats->num_frames               = latency.num_frames;
+	stats->input_to_dispatch_ms_max = latency.input_to_dispatch_ms_max;
+	stats->input_to_complete_ms_max = latency.input_to_complete_ms_max;
+
+	if ( latency.num_frames ) {
+		stats->input_to_dispatch_ms_avg = latency.input_to_dispatch_ms_sum / latency.num_frames;
+		stats->input_to_complete_ms_avg = latency.input_to_complete_ms_sum / latency.num_frames;
+	}
+
+	self->latency_stats = {};
+}
+
+// ----------------------------------------------------------------------
+
+static void renderer_release_bindless_texture( le_renderer_o* self, le_texture_handle texture ) {
+	using namespace le_backend_vk;
+	assert( self->backend && "Backend must exist" );
+	vk_backend_i.release_bindless_texture( self->backend, texture );
+}
+
+static void renderer_release_bindless_buffer( le_renderer_o* self, le_buf_resource_handle buffer ) {
+	using namespace le_backend_vk;
+	assert( self->backend && "Backend must exist" );
+	vk_backend_i.release_bindless_buffer( self->backend, buffer );
+}
+
+static void renderer_get_descriptor_write_counts( le_renderer_o* self, uint32_t* num_argument_writes, uint32_t* num_bindless_writes ) {
+	using namespace le_backend_vk;
+	assert( self->backend && "Backend must exist" );
+	vk_backend_i.get_descriptor_write_counts( self->backend, num_argument_writes, num_bindless_writes );
+}
+
+// ----------------------------------------------------------------------
+// Low latency frame pacing: delay the next frame just long enough so that it gets
+// dispatched just before the gpu has completed the current frame.
+//
+// We just waited for the previous frame: if that wait blocked, the gpu was still busy
+// with the previous frame when we dispatched the current frame, which means that the
+// current frame had to queue up, and that its input could have been sampled later by
+// about as long as we blocked. If the wait did not block, the gpu may have been idle,
+// waiting for us, and we back off.
+static void renderer_delay_for_frame_pacing( le_renderer_o* self ) {
+	ZoneScoped;
+
+	static constexpr double MARGIN_MS    = 0.5;  // how much we still want to block when waiting for the previous frame
+	static constexpr double MAX_DELAY_MS = 50.0; // upper bound, so that we recover quickly if frame times change
+
+	auto& pacing = self->pacing;
+
+	if ( pacing.fence_wait_ms > MARGIN_MS ) {
+		pacing.delay_ms += 0.5 * ( pacing.fence_wait_ms - MARGIN_MS );
+	} else {
+		pacing.delay_ms *= 0.5;
+	}
+
+	pacing.delay_ms = std::min( pacing.delay_ms, MAX_DELAY_MS );
+
+	if ( pacing.delay_ms > 0.1 ) {
+		std::this_thread::sleep_for( std::chrono::duration<double, std::milli>( pacing.delay_ms ) );
+	}
+}
+
 // ----------------------------------------------------------------------
 
 static void renderer_update( le_renderer_o* self, le_rendergraph_o* graph_ ) {
@@ -691,6 +832,23 @@ static void renderer_update( le_renderer_o* self, le_rendergraph_o* graph_ ) {
 	const auto& index     = self->currentFrameNumber;
 	const auto& numFrames = self->frames.size();
 
+	bool const is_low_latency = self->settings.frame_pacing == le_renderer_settings_t::FramePacing::eLowLatency;
+
+	// Pick which frames to record, dispatch, and clear with this update:
+	//
+	// Throughput: we record frame N, dispatch frame N-1, which was recorded with the previous
+	// update, and clear the oldest frame, which leaves all other frames in flight. With only two
+	// frames there is no frame to spare between record and dispatch: we dispatch frame N right
+	// after we recorded it.
+	//
+	// Low latency: we record, and dispatch frame N, then clear frame N-1, so that at most one
+	// frame is in flight. We then delay returning until just before the gpu is expected to
+	// become available, so that the next frame samples its input as late as possible.
+	//
+	size_t const record_index   = ( index + 0 ) % numFrames;
+	size_t const dispatch_index = ( is_low_latency || numFrames < 3 ) ? record_index : ( index + numFrames - 1 ) % numFrames;
+	size_t const clear_index    = is_low_latency ? ( index + numFrames - 1 ) % numFrames : ( index + 1 ) % numFrames;
+
 	// If necessary, recompile and reload shader modules
 	// - this must be complete before the record_frame step
 
@@ -739,42 +897,65 @@ static void renderer_update( le_renderer_o* self, le_rendergraph_o* graph_ ) {
 			renderer_dispatch_frame( p->renderer, p->frame_index );
 		};
 
+		auto record_and_process_frame_fun = []( void* param_ ) {
+			// if we record, and dispatch the same frame, these steps must happen in sequence.
+			auto p = static_cast<record_params_t*>( param_ );
+			le_jobs::wait_for_counter_and_free( p->shader_counter, 0 );
+			renderer_record_frame( p->renderer, p->frame_index, p->rendergraph, p->current_frame_number );
+			renderer_acquire_backend_resources( p->renderer, p->frame_index );
+			renderer_process_frame( p->renderer, p->frame_index );
+			renderer_dispatch_frame( p->renderer, p->frame_index );
+		};
+
 		auto clear_frame_fun = []( void* param_ ) {
 			auto p = static_cast<frame_params_t*>( param_ );
 			renderer_clear_frame( p->renderer, p->frame_index );
 		};
 
 		le_jobs::job_t jobs[ 3 ];
+		uint32_t       num_jobs = 0;
 
 		record_params_t record_frame_params;
 		record_frame_params.renderer             = self;
-		record_frame_params.frame_index          = ( index + 0 ) % numFrames;
+		record_frame_params.frame_index          = record_index;
 		record_frame_params.rendergraph          = graph_;
 		record_frame_params.current_frame_number = self->currentFrameNumber;
 		record_frame_params.shader_counter       = shader_counter;
 
 		frame_params_t process_frame_params;
 		process_frame_params.renderer    = self;
-		process_frame_params.frame_index = ( index + 2 ) % numFrames;
+		process_frame_params.frame_index = dispatch_index;
 
 		frame_params_t clear_frame_params;
 		clear_frame_params.renderer    = self;
-		clear_frame_params.frame_index = ( index + 1 ) % numFrames;
+		clear_frame_params.frame_index = clear_index;
+
+		if ( dispatch_index == record_index ) {
+			jobs[ num_jobs++ ] = { record_and_process_frame_fun, &record_frame_params };
+		} else {
+			jobs[ num_jobs++ ] = { process_frame_fun, &process_frame_params };
+			jobs[ num_jobs++ ] = { record_frame_fun, &record_frame_params };
+		}
 
-		jobs[ 0 ] = { process_frame_fun, &process_frame_params };
-		jobs[ 1 ] = { clear_frame_fun, &clear_frame_params };
-		jobs[ 2 ] = { record_frame_fun, &record_frame_params };
+		if ( !is_low_latency ) {
+			// In low latency mode we clear after the current frame was dispatched - see below.
+			jobs[ num_jobs++ ] = { clear_frame_fun, &clear_frame_params };
+		}
 
 		le_jobs::counter_t* counter;
 
 		assert( self->backend );
 
-		le_jobs::run_jobs( jobs, 3, &counter );
+		le_jobs::run_jobs( jobs, num_jobs, &counter );
 
 		// we could theoretically do some more work on the main thread here...
 
 		le_jobs::wait_for_counter_and_free( counter, 0 );
 
+		if ( is_low_latency ) {
+			renderer_clear_frame( self, clear_index );
+		}
+
 	} else {
 
 		// render on the main thread
@@ -782,31 +963,32 @@ static void renderer_update( le_renderer_o* self, le_rendergraph_o* graph_ ) {
 
 		{
 			// RECORD FRAME
-			auto frameIndex = ( index + 0 ) % numFrames;
-			// logger.info( "+++ [%5d] RECO", frameIndex );
-			renderer_record_frame( self, frameIndex, graph_, self->currentFrameNumber ); // generate an intermediary, api-agnostic, representation of the frame
+			// logger.info( "+++ [%5d] RECO", record_index );
+			renderer_record_frame( self, record_index, graph_, self->currentFrameNumber ); // generate an intermediary, api-agnostic, representation of the frame
 		}
 
 		{
 			// DISPATCH FRAME
 			// acquire external backend resources such as swapchain
 			// and create any temporary resources
-			auto frameIndex = ( index + 2 ) % numFrames;
-			// logger.info( "+++ [%5d] DISP", frameIndex );
-			renderer_acquire_backend_resources( self, frameIndex ); //
-			renderer_process_frame( self, frameIndex );             // generate api commands for the frame
-			renderer_dispatch_frame( self, frameIndex );            //
+			// logger.info( "+++ [%5d] DISP", dispatch_index );
+			renderer_acquire_backend_resources( self, dispatch_index ); //
+			renderer_process_frame( self, dispatch_index );             // generate api commands for the frame
+			renderer_dispatch_frame( self, dispatch_index );            //
 		}
 
 		{
 			// CLEAR FRAME
 			// wait for frame to come back (important to do this last, as it may block...)
-			auto frameIndex = ( index + 1 ) % numFrames;
-			// logger.info( "+++ [%5d] CLEA", frameIndex );
-			renderer_clear_frame( self, frameIndex );
+			// logger.info( "+++ [%5d] CLEA", clear_index );
+			renderer_clear_frame( self, clear_index );
 		}
 	}
 
+	if ( is_low_latency ) {
+		renderer_delay_for_frame_pacing( self );
+	}
+
 	// logger.info( "+++ NEXT FRAME\n" );
 	++self->currentFrameNumber;
 	FrameMark; // We have completed the current frame - this signals it to tracy
@@ -836,6 +1018,7 @@ static le_resource_info_t get_default_resource_info_for_image() {
 		img.imageType               = le::ImageType::e2D;
 		img.tiling                  = le::ImageTiling::eOptimal;
 		img.samplesFlags            = 0;
+		img.is_transient            = false;
 	}
 
 	return res;
@@ -873,6 +1056,12 @@ LE_MODULE_REGISTER_IMPL( le_renderer, api ) {
 	le_renderer_i.add_swapchain                  = renderer_add_swapchain;
 	le_renderer_i.remove_swapchain               = renderer_remove_swapchain;
 	le_renderer_i.get_swapchains                 = renderer_get_swapchains;
+	le_renderer_i.get_pass_timings               = renderer_get_pass_timings;
+	le_renderer_i.set_input_timestamp            = renderer_set_input_timestamp;
+	le_renderer_i.get_latency_stats              = renderer_get_latency_stats;
+	le_renderer_i.release_bindless_texture       = renderer_release_bindless_texture;
+	le_renderer_i.release_bindless_buffer        = renderer_release_bindless_buffer;
+	le_renderer_i.get_descriptor_write_counts    = renderer_get_descriptor_write_counts;
 	le_renderer_i.produce_texture_handle         = renderer_produce_texture_handle;
 	le_renderer_i.texture_handle_get_name        = texture_handle_get_name;
 	le_renderer_i.create_rtx_blas_info           = renderer_create_rtx_blas_info_handle;
@@ -17,6 +17,7 @@ struct le_command_stream_t; // ffdecl
 
 struct le_allocator_o;         // from backend
 struct le_staging_allocator_o; // from backend
+struct le_pass_timing_t;       // from backend
 
 LE_OPAQUE_HANDLE( le_shader_module_handle );
 LE_OPAQUE_HANDLE( le_swapchain_handle );
@@ -50,6 +51,21 @@ struct le_renderer_api {
 		le_img_resource_handle         ( * get_swapchain_resource_default)( le_renderer_o* self);
 		bool                           ( * get_swapchain_extent  )( le_renderer_o* self, le_swapchain_handle swapchain, uint32_t* p_width, uint32_t* p_height );
 		bool                           ( * get_swapchains        )(le_renderer_o* self, size_t *num_swapchains , le_swapchain_handle* p_swapchain_handles);
+
+		// gpu time per pass for the most recent completed frame - see backend `get_pass_timings`
+		bool                           ( * get_pass_timings      )(le_renderer_o* self, le_pass_timing_t* p_timings, size_t* num_timings, uint64_t* p_frame_number);
+
+		// tags the frame recorded by the next call to update() with the time of the input event that it reflects, in
+		// nanoseconds since the epoch of std::chrono::steady_clock - 0 means now. See `get_latency_stats`.
+		void                           ( * set_input_timestamp   )(le_renderer_o* self, uint64_t input_time_ns);
+		// returns latency stats for tagged frames which completed since the previous call, and resets these stats.
+		void                           ( * get_latency_stats     )(le_renderer_o* self, le_renderer_latency_stats_t* stats);
+
+		// bindless mode: releases the bindless index of a texture (or buffer) - see backend `release_bindless_texture`
+		void                           ( * release_bindless_texture )(le_renderer_o* self, le_texture_handle texture);
+		void                           ( * release_bindless_buffer  )(le_renderer_o* self, le_buf_resource_handle buffer);
+		// number of descriptors written for argument sets, and for the bindless set, for the most recently processed frame
+		void                           ( * get_descriptor_write_counts )(le_renderer_o* self, uint32_t* num_argument_writes, uint32_t* num_bindless_writes);
 		le_swapchain_handle 		   ( * add_swapchain 		 )(le_renderer_o* self, le_swapchain_settings_t const * settings);
 		bool 						   ( * remove_swapchain 	 )(le_renderer_o* self, le_swapchain_handle swapchain);
 
@@ -137,7 +153,7 @@ struct le_renderer_api {
    	         uint64_t             offset;
         };
 
-		le_command_buffer_encoder_o *( *create                 )( le_allocator_o **allocator, le_command_stream_t* command_stream, le_pipeline_manager_o* pipeline_cache, le_staging_allocator_o* stagingAllocator, le::Extent2D const* extent );
+		le_command_buffer_encoder_o *( *create                 )( le_allocator_o **allocator, le_command_stream_t* command_stream, le_pipeline_manager_o* pipeline_cache, le_staging_allocator_o* stagingAllocator, le_backend_o* backend, le::Extent2D const* extent, uint64_t frame_number );
 		void                         ( *destroy                )( le_command_buffer_encoder_o *obj );
 
 		le_pipeline_manager_o*		 ( *get_pipeline_manager   )( le_command_buffer_encoder_o *self);
@@ -157,6 +173,10 @@ struct le_renderer_api {
 		void                         ( *draw                   )( le_command_buffer_encoder_o *self, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance );
 		void                         ( *draw_indexed           )( le_command_buffer_encoder_o *self, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance);
 		void                         ( *draw_mesh_tasks        )( le_command_buffer_encoder_o *self, uint32_t taskCount, uint32_t fistTask);
+		void                         ( *draw_indirect          )( le_command_buffer_encoder_o *self, le_buf_resource_handle const buffer, uint64_t offset, uint32_t drawCount, uint32_t stride );
+		void                         ( *draw_indexed_indirect  )( le_command_buffer_encoder_o *self, le_buf_resource_handle const buffer, uint64_t offset, uint32_t drawCount, uint32_t stride );
+		void                         ( *draw_indirect_count    )( le_command_buffer_encoder_o *self, le_buf_resource_handle const buffer, uint64_t offset, le_buf_resource_handle const countBuffer, uint64_t countBufferOffset, uint32_t maxDrawCount, uint32_t stride );
+		void                         ( *draw_indexed_indirect_count )( le_command_buffer_encoder_o *self, le_buf_resource_handle const buffer, uint64_t offset, le_buf_resource_handle const countBuffer, uint64_t countBufferOffset, uint32_t maxDrawCount, uint32_t stride );
 		void                         ( *bind_graphics_pipeline )( le_command_buffer_encoder_o *self, le_gpso_handle pipelineHandle);
 		void                         ( *set_line_width         )( le_command_buffer_encoder_o *self, float line_width_ );
 		void                         ( *set_viewport           )( le_command_buffer_encoder_o *self, uint32_t firstViewport, const uint32_t viewportCount, const le::Viewport *pViewports );
@@ -168,6 +188,11 @@ struct le_renderer_api {
 		void                         ( *set_index_data         )( le_command_buffer_encoder_o *self, void const *data, uint64_t numBytes, le::IndexType const & indexType, command_buffer_encoder_interface_t::buffer_binding_info_o* optional_binding_info_readback );
 		void                         ( *set_vertex_data        )( le_command_buffer_encoder_o *self, void const *data, uint64_t numBytes, uint32_t bindingIndex, command_buffer_encoder_interface_t::buffer_binding_info_o* optional_transient_binding_info_readback );
 		void         				 ( *get_extent             )( le_command_buffer_encoder_o *self, le::Extent2D* extent);
+		uint64_t                     ( *get_frame_number       )( le_command_buffer_encoder_o *self); // number of the frame which this encoder records
+
+		// Bindless mode: index of texture (or buffer) in the bindless descriptor set - see backend `get_bindless_texture_index`
+		uint32_t                     ( *get_bindless_texture_index )( le_command_buffer_encoder_o *self, le_texture_handle const texture );
+		uint32_t                     ( *get_bindless_buffer_index  )( le_command_buffer_encoder_o *self, le_buf_resource_handle const buffer );
 	};
 
 	struct command_buffer_compute_encoder_interface_t{
@@ -180,6 +205,8 @@ struct le_renderer_api {
 		void                         ( *set_argument_image     )( le_command_buffer_encoder_o *self, le_img_resource_handle const imageId, uint64_t argumentName, uint64_t arrayIndex);
 		void                         ( *dispatch               )( le_command_buffer_encoder_o *self, uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ );
 		void                         ( *buffer_memory_barrier  )( le_command_buffer_encoder_o *self, le::PipelineStageFlags2 const srcStageMask, le::PipelineStageFlags2 const dstStageMask, le::AccessFlags2 const  dstAccessMask, le_buf_resource_handle const buffer, uint64_t const  offset, uint64_t const  range );
+		uint32_t                     ( *get_bindless_texture_index )( le_command_buffer_encoder_o *self, le_texture_handle const texture );
+		uint32_t                     ( *get_bindless_buffer_index  )( le_command_buffer_encoder_o *self, le_buf_resource_handle const buffer );
 	 };
 
 	struct command_buffer_transfer_encoder_interface_t{
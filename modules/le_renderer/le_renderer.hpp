@@ -6,6 +6,7 @@
 
 namespace le {
 using Presentmode = le_swapchain_settings_t::khr_settings_t::Presentmode;
+using FramePacing = le_renderer_settings_t::FramePacing;
 
 #	define BUILDER_IMPLEMENT( builder, method_name, param_type, param, default_value ) \
 		constexpr builder& method_name( param_type param default_value ) {              \
@@ -222,6 +223,19 @@ class RendererInfoBuilder {
 		}
 	}
 
+	/// Low latency pacing keeps at most one frame in flight, and delays the next
+	/// frame so that it reaches the gpu just in time - at the cost of throughput.
+	RendererInfoBuilder& setFramePacing( le::FramePacing frame_pacing = le::FramePacing::eThroughput ) {
+		self.frame_pacing = frame_pacing;
+		return *this;
+	}
+
+	/// Number of backend data frames - with throughput pacing, all but one of these may be in flight.
+	RendererInfoBuilder& setFramesInFlight( uint32_t frames_in_flight = 3 ) {
+		self.frames_in_flight = frames_in_flight;
+		return *this;
+	}
+
 	operator le_renderer_settings_t const&() {
 		return self;
 	}
@@ -427,6 +441,21 @@ class Renderer {
 		return le_renderer::renderer_i.get_pipeline_manager( self );
 	}
 
+	/// Bindless mode: releases the bindless index of a texture once no in-flight frame may still use it.
+	void releaseBindlessTexture( le_texture_handle texture ) {
+		le_renderer::renderer_i.release_bindless_texture( self, texture );
+	}
+
+	/// Bindless mode: releases the bindless index of a buffer once no in-flight frame may still use it.
+	void releaseBindlessBuffer( le_buf_resource_handle buffer ) {
+		le_renderer::renderer_i.release_bindless_buffer( self, buffer );
+	}
+
+	/// Number of descriptors written for argument sets, and for the bindless set, for the most recently processed frame.
+	void getDescriptorWriteCounts( uint32_t* numArgumentWrites, uint32_t* numBindlessWrites ) const {
+		le_renderer::renderer_i.get_descriptor_write_counts( self, numArgumentWrites, numBindlessWrites );
+	}
+
 	static le_texture_handle produceTextureHandle( char const* maybe_name ) {
 		return le_renderer::renderer_i.produce_texture_handle( maybe_name );
 	}
@@ -684,6 +713,14 @@ class ImageInfoBuilder : NoCopy, NoMove {
 		return *this;
 	}
 
+	// Transient images must be written before they are read in each frame, as their contents
+	// are undefined at the start of each frame: the backend may alias their memory with other
+	// transient images which are used by passes earlier, or later in the frame.
+	ImageInfoBuilder& setIsTransient( bool isTransient = true ) {
+		img.is_transient = isTransient;
+		return *this;
+	}
+
 	const le_resource_info_t& build() {
 		return res;
 	}
@@ -744,6 +781,18 @@ class GraphicsEncoder {
 		return le_renderer::encoder_graphics_i.get_pipeline_manager( self );
 	}
 
+	/// Bindless mode: returns index of texture in the bindless texture array, LE_BINDLESS_INDEX_INVALID on failure.
+	/// Note: the texture must still be used by this encoder's pass.
+	uint32_t getBindlessTextureIndex( le_texture_handle const& texture ) {
+		return le_renderer::encoder_graphics_i.get_bindless_texture_index( self, texture );
+	}
+
+	/// Bindless mode: returns index of buffer in the bindless storage buffer array, LE_BINDLESS_INDEX_INVALID on failure.
+	/// Note: the buffer must still be used by this encoder's pass.
+	uint32_t getBindlessBufferIndex( le_buf_resource_handle const& buffer ) {
+		return le_renderer::encoder_graphics_i.get_bindless_buffer_index( self, buffer );
+	}
+
 	GraphicsEncoder& setPushConstantData( void const* data, uint64_t const& numBytes ) {
 		le_renderer::encoder_graphics_i.set_push_constant_data( self, data, numBytes );
 		return *this;
@@ -795,6 +844,32 @@ class GraphicsEncoder {
 		return *this;
 	}
 
+	/// \brief Draw using parameters read from `buffer`, which holds VkDrawIndirectCommand structs (16 bytes each, if tightly packed).
+	GraphicsEncoder& drawIndirect( le_buf_resource_handle const& buffer, uint64_t const& offset = 0, uint32_t const& drawCount = 1, uint32_t const& stride = 16 ) {
+		le_renderer::encoder_graphics_i.draw_indirect( self, buffer, offset, drawCount, stride );
+		return *this;
+	}
+
+	/// \brief Draw using parameters read from `buffer`, which holds VkDrawIndexedIndirectCommand structs (20 bytes each, if tightly packed).
+	GraphicsEncoder& drawIndexedIndirect( le_buf_resource_handle const& buffer, uint64_t const& offset = 0, uint32_t const& drawCount = 1, uint32_t const& stride = 20 ) {
+		le_renderer::encoder_graphics_i.draw_indexed_indirect( self, buffer, offset, drawCount, stride );
+		return *this;
+	}
+
+	/// \brief Like drawIndirect, but the number of draws is read at draw time from `countBuffer`, as a uint32_t.
+	/// \note  requires Vulkan 1.2 feature `drawIndirectCount`.
+	GraphicsEncoder& drawIndirectCount( le_buf_resource_handle const& buffer, uint64_t const& offset, le_buf_resource_handle const& countBuffer, uint64_t const& countBufferOffset, uint32_t const& maxDrawCount, uint32_t const& stride = 16 ) {
+		le_renderer::encoder_graphics_i.draw_indirect_count( self, buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride );
+		return *this;
+	}
+
+	/// \brief Like drawIndexedIndirect, but the number of draws is read at draw time from `countBuffer`, as a uint32_t.
+	/// \note  requires Vulkan 1.2 feature `drawIndirectCount`.
+	GraphicsEncoder& drawIndexedIndirectCount( le_buf_resource_handle const& buffer, uint64_t const& offset, le_buf_resource_handle const& countBuffer, uint64_t const& countBufferOffset, uint32_t const& maxDrawCount, uint32_t const& stride = 20 ) {
+		le_renderer::encoder_graphics_i.draw_indexed_indirect_count( self, buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride );
+		return *this;
+	}
+
 	GraphicsEncoder& bindGraphicsPipeline( le_gpso_handle pipelineHandle ) {
 		le_renderer::encoder_graphics_i.bind_graphics_pipeline( self, pipelineHandle );
 		return *this;
@@ -852,6 +927,11 @@ class GraphicsEncoder {
 		return result;
 	}
 
+	/// Number of the frame which this encoder records - increases by one with every renderer update.
+	uint64_t getFrameNumber() {
+		return le_renderer::encoder_graphics_i.get_frame_number( self );
+	}
+
 	operator auto() {
 		return self;
 	}
@@ -876,6 +956,18 @@ class ComputeEncoder {
 		return le_renderer::encoder_compute_i.get_pipeline_manager( self );
 	}
 
+	/// Bindless mode: returns index of texture in the bindless texture array, LE_BINDLESS_INDEX_INVALID on failure.
+	/// Note: the texture must still be used by this encoder's pass.
+	uint32_t getBindlessTextureIndex( le_texture_handle const& texture ) {
+		return le_renderer::encoder_compute_i.get_bindless_texture_index( self, texture );
+	}
+
+	/// Bindless mode: returns index of buffer in the bindless storage buffer array, LE_BINDLESS_INDEX_INVALID on failure.
+	/// Note: the buffer must still be used by this encoder's pass.
+	uint32_t getBindlessBufferIndex( le_buf_resource_handle const& buffer ) {
+		return le_renderer::encoder_compute_i.get_bindless_buffer_index( self, buffer );
+	}
+
 	ComputeEncoder& bindComputePipeline( le_cpso_handle pipelineHandle ) {
 		le_renderer::encoder_compute_i.bind_compute_pipeline( self, pipelineHandle );
 		return *this;
@@ -677,6 +677,8 @@ static void node_tag_contributing( Node* const nodes, const size_t num_nodes, ui
 static void rendergraph_build( le_rendergraph_o* self, size_t frame_number ) {
 	ZoneScoped;
 
+	self->frame_number = frame_number;
+
 	static auto logger = LeLog( LOGGER_LABEL );
 
 	LE_SETTING( bool, LE_SETTING_RENDERGRAPH_PRINT_EXTENDED_DEBUG_MESSAGES, false );
@@ -1073,7 +1075,7 @@ static void rendergraph_execute( le_rendergraph_o* self, size_t frameIndex, le_b
 			}
 
 			// NOTE: we must manually track the lifetime of encoder!
-			pass->encoder = encoder_i.create( ppAllocators, ppCommandStreams[ i ], pipelineCache, stagingAllocator, &pass_extents );
+			pass->encoder = encoder_i.create( ppAllocators, ppCommandStreams[ i ], pipelineCache, stagingAllocator, backend, &pass_extents, self->frame_number );
 
 			if ( pass->type == le::QueueFlagBits::eGraphics ) {
 
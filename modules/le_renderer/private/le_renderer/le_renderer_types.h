@@ -286,11 +286,28 @@ struct le_swapchain_settings_t {
 };
 
 struct le_renderer_settings_t {
+	enum class FramePacing : uint32_t {
+		eThroughput = 0, // record, dispatch, and clear frames in a pipeline, keeping as many frames in flight as there are data frames (default)
+		eLowLatency,     // dispatch each frame right after recording it, keep at most one frame in flight, and start the next frame just in time for the gpu
+	};
+
 	le_swapchain_settings_t swapchain_settings[ 16 ] = {}; // todo: rename this to initial_swapchain_settings; make sure that this is only accessed during renderer::setup, and not any later. convert this into a linked list!
 	size_t                  num_swapchain_settings   = 0;
+	FramePacing             frame_pacing             = FramePacing::eThroughput;
+	uint32_t                frames_in_flight         = 0; // number of backend data frames (at least 2) - 0 means to use the backend default
 	// TODO: add a hint for number of swapchain frames
 };
 
+// Latency for frames which were tagged with the time of an input event via `renderer_i.set_input_timestamp`,
+// accumulated since the previous call to `renderer_i.get_latency_stats`.
+struct le_renderer_latency_stats_t {
+	uint32_t num_frames;               // number of tagged frames which completed
+	double   input_to_dispatch_ms_avg; // from input event until frame was submitted, and queued for present
+	double   input_to_dispatch_ms_max; //
+	double   input_to_complete_ms_avg; // from input event until renderer saw that the gpu had completed the frame - an upper bound
+	double   input_to_complete_ms_max; //
+};
+
 // specifies parameters for an image write operation.
 struct le_write_to_image_settings_t {
 	uint32_t image_w         = 0; // image (slice) width in texels
@@ -389,6 +406,7 @@ struct le_resource_info_t {
 		le::ImageTiling      tiling;            // enum VkImageTiling
 		le::ImageUsageFlags  usage;             // usage flags (LeImageUsageFlags : uint32_t)
 		uint32_t             samplesFlags;      // bitfield over all variants of this image resource- we use this to tell how many multisampling instances this image requires
+		bool                 is_transient;      // contents need not survive the frame: image may share memory with other transient images whose uses don't overlap
 
 		//		bool operator==( ImageInfo const& ) const = default;
 	};
@@ -568,6 +586,10 @@ enum class CommandType : uint32_t {
 	eDrawIndexed,
 	eDraw,
 	eDrawMeshTasks,
+	eDrawIndirect,
+	eDrawIndexedIndirect,
+	eDrawIndirectCount,
+	eDrawIndexedIndirectCount,
 	eDispatch,
 	eBufferMemoryBarrier,
 	eTraceRays,
@@ -631,6 +653,54 @@ struct CommandDrawMeshTasks {
 	} info;
 };
 
+// Draw parameters are read from `buffer`, which must hold `drawCount` tightly packed
+// (or `stride` bytes apart) VkDrawIndirectCommand structs.
+struct CommandDrawIndirect {
+	CommandHeader header = { { { CommandType::eDrawIndirect, sizeof( CommandDrawIndirect ) } } };
+	struct {
+		le_buf_resource_handle buffer; // buffer holding draw commands
+		uint64_t               offset; // byte offset into buffer for first draw command
+		uint32_t               drawCount;
+		uint32_t               stride; // byte stride between draw commands
+	} info;
+};
+
+// Same as CommandDrawIndirect, but `buffer` holds VkDrawIndexedIndirectCommand structs.
+struct CommandDrawIndexedIndirect {
+	CommandHeader header = { { { CommandType::eDrawIndexedIndirect, sizeof( CommandDrawIndexedIndirect ) } } };
+	struct {
+		le_buf_resource_handle buffer; // buffer holding draw commands
+		uint64_t               offset; // byte offset into buffer for first draw command
+		uint32_t               drawCount;
+		uint32_t               stride; // byte stride between draw commands
+	} info;
+};
+
+// Number of draws is read from `countBuffer` at draw time, and clamped to `maxDrawCount`.
+struct CommandDrawIndirectCount {
+	CommandHeader header = { { { CommandType::eDrawIndirectCount, sizeof( CommandDrawIndirectCount ) } } };
+	struct {
+		le_buf_resource_handle buffer;            // buffer holding draw commands
+		uint64_t               offset;            // byte offset into buffer for first draw command
+		le_buf_resource_handle countBuffer;       // buffer holding draw count as uint32_t
+		uint64_t               countBufferOffset; // byte offset into countBuffer, must be a multiple of 4
+		uint32_t               maxDrawCount;
+		uint32_t               stride; // byte stride between draw commands
+	} info;
+};
+
+struct CommandDrawIndexedIndirectCount {
+	CommandHeader header = { { { CommandType::eDrawIndexedIndirectCount, sizeof( CommandDrawIndexedIndirectCount ) } } };
+	struct {
+		le_buf_resource_handle buffer;            // buffer holding draw commands
+		uint64_t               offset;            // byte offset into buffer for first draw command
+		le_buf_resource_handle countBuffer;       // buffer holding draw count as uint32_t
+		uint64_t               countBufferOffset; // byte offset into countBuffer, must be a multiple of 4
+		uint32_t               maxDrawCount;
+		uint32_t               stride; // byte stride between draw commands
+	} info;
+};
+
 struct CommandDispatch {
 	CommandHeader header = { { { CommandType::eDispatch, sizeof( CommandDispatch ) } } };
 	struct {
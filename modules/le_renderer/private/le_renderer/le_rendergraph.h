@@ -147,5 +147,6 @@ struct le_rendergraph_o : NoCopy, NoMove {
 	                                                                         //
 	std::vector<char const*>                       root_debug_names;         // not owning: pointers to debug_names for root passes held within passes, in same order as RootPassesField indices
 	std::vector<le_on_frame_clear_callback_data_t> on_frame_clear_callbacks; // passed on to the backend: callbacks which get called once the backend frame into which this renderpass was placed gets cleared
+	uint64_t                                       frame_number = 0;         // frame number given to most recent build, passed on to encoders
 };
 #endif
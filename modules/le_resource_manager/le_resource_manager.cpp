@@ -2,7 +2,9 @@
 #include "le_core.h"
 #include "le_renderer.hpp"
 #include "le_pixels.h"
+#include "le_log.h"
 
+#include <stdio.h>
 #include <string>
 #include <vector>
 #include <assert.h>
@@ -16,13 +18,14 @@ struct le_resource_manager_o {
 	struct image_data_layer_t {
 		le_pixels_o* pixels;
 		std::string  path;
+		uint32_t     base_array_layer; // first array layer of image covered by this file - container files may hold more than one layer
 		bool         was_uploaded = false;
 	};
 
 	struct resource_item_t {
 		le_img_resource_handle          image_handle;
 		le_resource_info_t              image_info;
-		std::vector<image_data_layer_t> image_layers; // must have at least one element
+		std::vector<image_data_layer_t> image_layers; // must have at least one element, one element per file
 	};
 
 	std::vector<resource_item_t> resources;
@@ -78,47 +81,80 @@ static void execTransferPass( le_command_buffer_encoder_o* pEncoder, void* user_
 
 	for ( auto& r : manager->resources ) {
 
-		uint32_t const num_layers     = uint32_t( r.image_layers.size() );
-		uint32_t const image_width    = r.image_info.image.extent.width;
-		uint32_t const image_height   = r.image_info.image.extent.height;
-		uint32_t const image_depth    = r.image_info.image.extent.depth;
-		uint32_t const num_mip_levels = r.image_info.image.mipLevels;
+		uint32_t const num_layers       = uint32_t( r.image_layers.size() );
+		uint32_t const image_width      = r.image_info.image.extent.width;
+		uint32_t const image_height     = r.image_info.image.extent.height;
+		uint32_t const image_depth      = r.image_info.image.extent.depth;
+		uint32_t const num_mip_levels   = r.image_info.image.mipLevels;
+		uint32_t const num_array_layers = r.image_info.image.arrayLayers;
 
 		for ( uint32_t layer = 0; layer != num_layers; layer++ ) {
 
-			// we can fill in the correct handling for mutiple mip levels later.
-			// for now, assert that there is exatcly one mip level.
 			if ( r.image_layers[ layer ].was_uploaded ) {
 				continue;
 			}
 
 			// --------| invariant: layer was not yet uploaded.
 
-			for ( uint32_t mip_level = 0; mip_level != 1; mip_level++ ) {
+			if ( r.image_layers[ layer ].pixels == nullptr ) {
+				r.image_layers[ layer ].was_uploaded = true; // file could not be loaded - nothing to upload
+				continue;
+			}
+
+			auto  pixels = r.image_layers[ layer ].pixels;
+			auto  info   = le_pixels_i.get_info( pixels );
+			auto* bytes  = static_cast<char const*>( le_pixels_i.get_data( pixels ) );
+
+			le_pixels_subresource_t const* subresources     = nullptr;
+			size_t                         num_subresources = 0;
+
+			if ( le_pixels_i.get_subresources( pixels, &subresources, &num_subresources ) ) {
+
+				// Pixels come from a container file, which holds pre-built mip levels, and possibly more
+				// than one layer. We upload every subresource as it is - block-compressed images cannot
+				// be blitted, which is why we never ask for mip levels to be generated.
+
+				for ( auto s = subresources; s != subresources + num_subresources; s++ ) {
 
-				assert( mip_level == 0 && "mip level greater than 0 not implemented" );
-				uint32_t width  = image_width >> mip_level;
-				uint32_t height = image_height >> mip_level;
-				uint32_t depth  = image_depth;
+					if ( s->mip_level >= num_mip_levels ) {
+						continue; // image has fewer mip levels than container file
+					}
+
+					if ( s->layer >= num_array_layers - r.image_layers[ layer ].base_array_layer ) {
+						continue; // image has fewer array layers than container file
+					}
+
+					le_write_to_image_settings_t write_info =
+					    le::WriteToImageSettingsBuilder()
+					        .setDstMiplevel( s->mip_level )
+					        .setNumMiplevels( 1 )
+					        .setArrayLayer( r.image_layers[ layer ].base_array_layer + s->layer )
+					        .setImageH( s->height )
+					        .setImageW( s->width )
+					        .setImageD( 1 )
+					        .build();
+
+					encoder.writeToImage( r.image_handle, write_info, bytes + s->offset, s->byte_count );
+				}
+
+			} else {
+
+				// Pixels were decoded from a single image: we upload the first mip level, and
+				// any further mip levels get generated from it.
 
 				le_write_to_image_settings_t write_info =
 				    le::WriteToImageSettingsBuilder()
-				        .setDstMiplevel( mip_level )
+				        .setDstMiplevel( 0 )
 				        .setNumMiplevels( num_mip_levels )
-				        .setArrayLayer( layer ) // faces are indexed: +x, -x, +y, -y, +z, -z
-				        .setImageH( height )
-				        .setImageW( width )
-				        .setImageD( depth )
-
+				        .setArrayLayer( r.image_layers[ layer ].base_array_layer ) // faces are indexed: +x, -x, +y, -y, +z, -z
+				        .setImageH( image_height )
+				        .setImageW( image_width )
+				        .setImageD( image_depth )
 				        .build();
 
-				auto     pixels    = r.image_layers[ layer ].pixels;
-				auto     info      = le_pixels_i.get_info( pixels );
-				uint32_t num_bytes = info.byte_count; // TODO: make sure to get correct byte count for mip level, or compressed image.
-				void*    bytes     = le_pixels_i.get_data( pixels );
-
-				encoder.writeToImage( r.image_handle, write_info, bytes, num_bytes );
+				encoder.writeToImage( r.image_handle, write_info, bytes, info.byte_count );
 			}
+
 			r.image_layers[ layer ].was_uploaded = true;
 		}
 	}
@@ -166,10 +202,37 @@ static void infer_from_le_format( le::Format const& format, uint32_t* num_channe
 	}
 }
 
+// ----------------------------------------------------------------------
+// Reads the full contents of the file at `file_path` into `contents`.
+static bool read_file( char const* file_path, std::vector<unsigned char>& contents ) {
+
+	FILE* file = fopen( file_path, "rb" );
+
+	if ( file == nullptr ) {
+		return false;
+	}
+
+	fseek( file, 0, SEEK_END );
+	long file_size = ftell( file );
+	rewind( file );
+
+	if ( file_size > 0 ) {
+		contents.resize( size_t( file_size ) );
+		contents.resize( fread( contents.data(), 1, contents.size(), file ) );
+	}
+
+	fclose( file );
+
+	return file_size > 0 && contents.size() == size_t( file_size );
+}
+
 // ----------------------------------------------------------------------
 // NOTE: You must provide an array of paths in image_paths, and the
-// array's size must match `image_info.image.arrayLayers`
-// Most meta-data about the image file is loaded via image_info
+// array's size must match `image_info.image.arrayLayers` - unless images
+// are loaded from container files (KTX2, DDS), which may each provide more
+// than one layer.
+// Most meta-data about the image file is loaded via image_info; images
+// loaded from container files may fill in format, and mip levels.
 static void le_resource_manager_add_item( le_resource_manager_o*        self,
                                           le_img_resource_handle const* image_handle,
                                           le_resource_info_t const*     image_info,
@@ -188,20 +251,85 @@ static void le_resource_manager_add_item( le_resource_manager_o*        self,
 		extents_inferred = true;
 	}
 
-	for ( size_t i = 0; i != item.image_info.image.arrayLayers; ++i ) {
+	bool is_storage_capable = true;
+
+	static auto logger = LeLog( "le_resource_manager" );
+
+	// We read each file just once, and then inspect, and decode it from memory.
+	std::vector<unsigned char> file_contents;
+
+	for ( uint32_t i = 0, num_layers_covered = 0; num_layers_covered < item.image_info.image.arrayLayers; ++i ) {
 		le_resource_manager_o::image_data_layer_t layer_data{};
-		layer_data.path         = std::string{ image_paths[ i ] };
-		layer_data.was_uploaded = false;
+		layer_data.path             = std::string{ image_paths[ i ] };
+		layer_data.base_array_layer = num_layers_covered;
+		layer_data.was_uploaded     = false;
+
+		le_pixels_info file_info{};
+
+		if ( !read_file( layer_data.path.c_str(), file_contents ) ) {
+
+			logger.error( "ERROR: Could not read image file: '%s'", layer_data.path.c_str() );
+			layer_data.pixels = nullptr;
+			num_layers_covered += 1;
+
+		} else if ( le_pixels::le_pixels_i.get_info_from_memory( file_contents.data(), file_contents.size(), &file_info ) &&
+		            file_info.format != 0 ) {
+
+			// Container file - the container decides the image format, and provides all mip levels;
+			// pixels are not decoded.
+
+			le::Format const file_format = le::Format( file_info.format );
+
+			if ( item.image_info.image.format == le::Format::eUndefined ) {
+				item.image_info.image.format = file_format;
+			}
+
+			// Container formats are block-compressed, or - for baked images - often sRGB;
+			// neither can usually be used for storage images.
+			is_storage_capable = false;
 
-		// we must find out the pixels type from image info format
-		uint32_t             num_channels = 0;
-		le_pixels_info::Type pixels_type{};
+			if ( item.image_info.image.format != file_format ) {
 
-		infer_from_le_format( item.image_info.image.format, &num_channels, &pixels_type );
+				// We can't convert pixels from a container file - uploading them anyway would
+				// mean writing more, or fewer bytes than the image has room for.
 
-		layer_data.pixels = le_pixels::le_pixels_i.create( layer_data.path.c_str(), num_channels, pixels_type );
+				logger.error( "ERROR: Image container file '%s' has format %u, which does not match image format %u - skipping file.",
+				              layer_data.path.c_str(), file_info.format, uint32_t( item.image_info.image.format ) );
+				layer_data.pixels = nullptr;
 
-		if ( extents_inferred ) {
+			} else {
+
+				if ( i == 0 && item.image_info.image.mipLevels <= 1 ) {
+					item.image_info.image.mipLevels = file_info.num_mip_levels;
+				}
+
+				// We never generate mip levels for images from container files - the file must
+				// provide every mip level of the image, otherwise these would remain undefined.
+
+				if ( item.image_info.image.mipLevels > file_info.num_mip_levels ) {
+					logger.warn( "Image container file '%s' provides %u mip levels, but image asks for %u - using %u mip levels.",
+					             layer_data.path.c_str(), file_info.num_mip_levels, item.image_info.image.mipLevels, file_info.num_mip_levels );
+					item.image_info.image.mipLevels = file_info.num_mip_levels;
+				}
+
+				layer_data.pixels = le_pixels::le_pixels_i.create_from_memory( file_contents.data(), file_contents.size(), 0, le_pixels_info::Type::eUInt8 );
+			}
+
+			num_layers_covered += file_info.num_layers;
+
+		} else {
+
+			// we must find out the pixels type from image info format
+			uint32_t             num_channels = 0;
+			le_pixels_info::Type pixels_type{};
+
+			infer_from_le_format( item.image_info.image.format, &num_channels, &pixels_type );
+
+			layer_data.pixels = le_pixels::le_pixels_i.create_from_memory( file_contents.data(), file_contents.size(), num_channels, pixels_type );
+			num_layers_covered += 1;
+		}
+
+		if ( extents_inferred && layer_data.pixels ) {
 			auto info                           = le_pixels::le_pixels_i.get_info( layer_data.pixels );
 			item.image_info.image.extent.depth  = std::max( item.image_info.image.extent.depth, info.depth );
 			item.image_info.image.extent.width  = std::max( item.image_info.image.extent.width, info.width );
@@ -211,7 +339,11 @@ static void le_resource_manager_add_item( le_resource_manager_o*        self,
 		item.image_layers.emplace_back( layer_data );
 	}
 
-	item.image_info.image.usage = le::ImageUsageFlagBits::eTransferDst | le::ImageUsageFlagBits::eSampled | le::ImageUsageFlagBits::eStorage;
+	if ( is_storage_capable ) {
+		item.image_info.image.usage = le::ImageUsageFlagBits::eTransferDst | le::ImageUsageFlagBits::eSampled | le::ImageUsageFlagBits::eStorage;
+	} else {
+		item.image_info.image.usage = le::ImageUsageFlagBits::eTransferDst | le::ImageUsageFlagBits::eSampled;
+	}
 
 	assert( item.image_info.image.extent.width != 0 &&
 	        item.image_info.image.extent.height != 0 &&
@@ -69,6 +69,30 @@ when you specify the image info for the resource
 
         app->resource_manager.add_item( cube_image, image_info, paths );
 
+* * *
+
+Images may also be loaded from KTX2 or DDS container files which hold block-
+compressed (BC1-BC7) pixels. These are uploaded without being decoded, together
+with all mip levels stored in the file. If you leave the image format undefined,
+it is taken from the file. A single container file may hold all layers of an
+image - a cube map, for example - in which case one path is enough:
+
+        auto image_info =
+            le::ImageInfoBuilder()
+                .setImageType( le::ImageType::e2D )
+                .setCreateFlags( le::ImageCreateFlagBits::eCubeCompatible )
+                .setArrayLayers( 6 )
+                .build();
+
+        char const* path = "./local_resources/cubemap.ktx2";
+
+        app->resource_manager.add_item( cube_image, image_info, &path );
+
+KTX2 files may also hold uncompressed pixels. The `texture_baker` tool (see
+`apps/tools/texture_baker`) decodes images ahead of time, generates their full
+mip chain, and writes the result into KTX2 files, which then load without any
+decoding or mip generation at runtime.
+
 */
 
 #include "le_core.h"
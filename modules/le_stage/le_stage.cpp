@@ -10,6 +10,7 @@
 #include <vulkan/vulkan.h>
 
 #include "le_camera.h"
+#include "le_jobs.h"
 #include "le_pixels.h"
 #include "le_timebase.h"
 
@@ -17,12 +18,18 @@
 
 #include "string.h" // for memcpy
 
+#if defined( __SSE2__ ) || defined( _M_X64 )
+#	include <immintrin.h>
+#endif
+
 #include <iostream>
 #include <iomanip>
 #include <vector>
 #include <string>
 #include <unordered_map>
 #include <algorithm>
+#include <limits>
+#include <tuple>
 
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE // vulkan clip space is from 0 to 1
 #define GLM_FORCE_RIGHT_HANDED      // glTF uses right handed coordinate system, and we're following its lead.
@@ -68,8 +75,10 @@ struct glm_mat4_t {
 };
 
 struct stage_image_o {
-	le_pixels_o*   pixels;
-	le_pixels_info info;
+	le_pixels_o*      pixels;
+	le_pixels_load_o* pixels_load;  // pending decode, resolved into `pixels` before upload
+	void*             encoded_data; // owned copy of encoded image, must stay alive until decoding completes
+	le_pixels_info    info;
 
 	le_img_resource_handle handle;
 	le_resource_info_t     resource_info;
@@ -91,6 +100,8 @@ struct le_buffer_o {
 	uint32_t               size;            // number of bytes
 	bool                   was_transferred; // whether this buffer was transferred to gpu already
 	bool                   owns_mem;        // true if sole owner of memory pointed to in mem
+	void ( *release_fn )( void* user_data ); // optional: called once non-owned mem is no longer needed
+	void* release_user_data;                 // passed to release_fn
 };
 
 struct le_buffer_view_o {
@@ -184,6 +195,7 @@ struct le_material_o {
 struct le_primitive_o {
 	std::vector<uint64_t>               bindings_buffer_offsets; // cached: offset into each buffer_handle when binding
 	std::vector<le_buf_resource_handle> bindings_buffer_handles; // cached: bufferviews sorted and grouped based on accessors
+	std::vector<uint32_t>               bindings_buffer_strides; // cached: stride for each binding
 	                                                             //
 	uint32_t vertex_count;                                       // cached: number of POSITION vertices, used to figure out draw call param
 	uint32_t index_count;                                        // cached: number of INDICES, if any.
@@ -212,24 +224,19 @@ struct le_primitive_o {
 // has many primitives
 struct le_mesh_o {
 	std::vector<le_primitive_o> primitives;
+	glm::vec3                   bounds_min; // object-space bounds over all primitives, including morph targets
+	glm::vec3                   bounds_max; //
+	bool                        has_bounds; // false if any primitive's positions came without min/max
 };
 
+// Note that a node's transforms live in stage->transforms, see `le_transform_hierarchy_o`.
 struct le_node_o {
-	glm::mat4 global_transform;
-	glm::mat4 inverse_global_transform;
-	glm::mat4 local_transform;
-
-	glm::vec3 local_translation;
-	glm::quat local_rotation;
-	glm::vec3 local_scale;
+	uint32_t idx; // index of this node in stage->nodes
 
 	float morph_target_weights[ 12 ]; // Morph target weights; These apply to all primitives in meshes associated with this node...
 
 	char name[ 32 ];
 
-	bool local_transform_cached;   // whether local transform is accurate wrt local[translation|rotation|scale]
-	bool global_transform_chached; // whether global transform is current
-
 	bool     has_mesh;
 	uint32_t mesh_idx;
 
@@ -239,7 +246,8 @@ struct le_node_o {
 	bool     has_light;
 	uint32_t light_idx;
 
-	struct le_skin_o* skin; // Optional, non-owning
+	struct le_skin_o* skin;              // Optional, non-owning
+	uint32_t          joint_palette_idx; // entry in stage joint palette for this node's skin - only valid if skin is set
 
 	// TODO: we could use the scene_bit_flags to express affinity,
 	// or whether a node should be used for raytracing for example.
@@ -254,36 +262,27 @@ struct le_skin_o {
 	std::vector<glm::mat4>  inverse_bind_matrices; // one per joint
 };
 
-struct le_keyframe_o {
-	enum class Type : uint32_t {
-		eLinear,
-		eStep,
-		eCubicSpline,
-	};
-	uint64_t             delta_ticks;       // given in units of 1/12000 seconds.
-	Type                 type;              //
-	le_num_type          num_type;          // numeric type
-	le_compound_num_type compound_num_type; // scalar, vec2, vec3, etc.
-	uint16_t             array_size;        // number of elements used, default must be 1
-	union {                                 //
-		glm::quat as_quat[ 3 ];             // used for spline       : xyzw quaternion
-		glm::vec4 as_vec4[ 3 ];             // used for spline
-		glm::vec3 as_vec3[ 3 ];             // used for spline
-		glm::vec2 as_vec2[ 3 ];             // used for spline
-		float     as_scalar[ 12 ];          // used for weights
-	} data;
-};
-
-/// A channel is a mapping from a sequence of keyframes to a node property
+/// A channel is a mapping from a sequence of keyframes to a node property.
+/// Keyframe times and values live in separate, tightly packed arrays, so that
+/// looking up the current keyframe only touches keyframe times.
 struct le_animation_channel_o {
+	using Interpolation = le_animation_sampler_info::InterpolationType;
+
 	uint64_t ticks_offset;   // Offset (in ticks) of first keyframe
 	uint64_t ticks_duration; // Offset (in ticks) of last keyframe, designating total duration in ticks for this channel, since keyframes are defined as: [0..n[
 	//
-	std::vector<le_keyframe_o> sampler;        // (non-owning) keyframes for this channel, their time is relative to this channel.
-	                                           //
-	le_compound_num_type target_compound_type; // numeric type for target - we keep this mostly because quaternion requires slerp rather than lerp.
-	le_node_o*           target_node;          // (non-owning) pointer to targeted node						 : how do we deal with deleted nodes?
-	void*                target_node_element;  // (non-owning) pointer to targeted node element (t, r, or s) : how do we deal with deleted nodes?
+	std::vector<uint64_t> key_ticks;      // time for each keyframe, in ticks, ascending
+	std::vector<float>    key_values;     // per keyframe: values_per_key values of num_components floats each
+	uint32_t              num_components; // floats per value: 3 for translation, and scale, 4 for rotation (xyzw quaternion), number of morph targets for weights
+	uint32_t              values_per_key; // 3 for cubic spline keyframes (in-tangent, value, out-tangent), 1 otherwise
+	Interpolation         interpolation;  //
+	                                      //
+	uint32_t cursor;                      // keyframe found by the most recent lookup - where the next lookup starts
+	float    value[ 12 ];                 // most recently evaluated value
+	                                      //
+	le_compound_num_type  target_compound_type; // numeric type for target - we keep this mostly because quaternion requires slerp rather than lerp.
+	le_node_o*            target_node;          // (non-owning) pointer to targeted node						 : how do we deal with deleted nodes?
+	LeAnimationTargetType target_type;          // targeted node element (t, r, s, or weights)
 };
 
 /// An animation is a collection of channels
@@ -354,9 +353,36 @@ struct le_light_o {
 	glm::vec2 padding;
 };
 
+// Bounding volume hierarchy over a scene's mesh nodes, with bounds given in world space.
+// Hierarchy is built once, and from then on refit whenever transforms change - so that
+// culling cost depends on what is visible, rather than on how many nodes there are.
+struct le_scene_bvh_o {
+	static constexpr uint32_t MAX_ITEMS_PER_LEAF = 4;
+
+	struct item_t {
+		glm::vec3 min;      // world-space bounds
+		uint32_t  node_idx; // index of node in stage->nodes
+		glm::vec3 max;      //
+		uint32_t  slot;     // transform slot for node
+	};
+
+	struct bvh_node_t {
+		glm::vec3 min;   // world-space bounds over all items in this subtree
+		uint32_t  first; // leaf: index of first item; internal node: index of left child - right child follows
+		glm::vec3 max;   //
+		uint32_t  count; // leaf: number of items; internal node: 0
+	};
+
+	std::vector<bvh_node_t> nodes;     // root comes first, children always come after their parent
+	std::vector<item_t>     items;     // grouped by leaf
+	std::vector<uint32_t>   unbounded; // mesh nodes which can't be culled, because they are skinned, or have no bounds
+	bool                    needs_build{ true };
+};
+
 struct le_scene_o {
 	uint8_t                 scene_id;   // matches scene bit flag in node.
 	std::vector<le_node_o*> root_nodes; // non-owning
+	le_scene_bvh_o          bvh;        // mesh nodes in this scene, for culling
 
 	le_tlas_resource_handle rtx_tlas_handle; // only used for rtx
 	le_resource_info_t      rtx_tlas_info;   // only used for rtx
@@ -366,6 +392,157 @@ struct le_scene_o {
 	std::vector<le_light_o> lights;
 };
 
+// Transforms for all nodes, kept apart from nodes in a flattened hierarchy, so that
+// updating transforms only touches the data it needs, in the order in which it is laid
+// out in memory. Slots are sorted by depth: parents always come before their children,
+// and slots at the same depth don't depend on each other, so they may be updated in parallel.
+struct le_transform_hierarchy_o {
+	static constexpr uint32_t NO_PARENT = ~uint32_t( 0 );
+
+	std::vector<uint32_t>  parent;         // per slot: slot of parent, or NO_PARENT for root nodes
+	std::vector<glm::vec3> translation;    // per slot: local translation
+	std::vector<glm::quat> rotation;       // per slot: local rotation
+	std::vector<glm::vec3> scale;          // per slot: local scale
+	std::vector<glm::mat4> local;          // per slot: local transform, calculated from local translation, rotation, and scale
+	std::vector<glm::mat4> global;         // per slot: global transform
+	std::vector<glm::mat4> inverse_global; // per slot: inverse of global transform
+	std::vector<uint8_t>   local_dirty;    // per slot: local transform must be re-calculated, set this when changing translation, rotation, or scale
+	std::vector<uint8_t>   global_dirty;   // per slot: whether global transform changed during the most recent update
+	std::vector<uint32_t>  node_of_slot;   // per slot: index of node in stage->nodes
+	std::vector<uint32_t>  slot_of_node;   // per node: slot for node with given index in stage->nodes
+	std::vector<uint32_t>  level_offsets;  // first slot for each level of depth, followed by total number of slots
+
+	bool has_local_changes;  // whether any slot has local_dirty set
+	bool has_global_changes; // whether any slot has global_dirty set
+};
+
+// Joint matrices for all skins, calculated once per frame, and stored in a single
+// storage buffer, from which primitives pick the range for their skin.
+//
+// Nodes which share a skin share a palette entry, unless their skin has no skeleton:
+// then, joint matrices are relative to each node, and each node needs its own entry.
+struct le_joint_palette_o {
+	// For each entry, joint matrices are followed by joint normal matrices. Both ranges
+	// start at multiples of `ALIGNMENT` matrices, so that they may be bound as storage
+	// buffers: 4 mat4s == 256 bytes, which satisfies any minStorageBufferOffsetAlignment.
+	static constexpr uint32_t ALIGNMENT = 4;
+
+	struct entry_t {
+		le_skin_o const* skin;           // non-owning
+		le_node_o const* root;           // non-owning: skeleton, if skin has one, otherwise skinned node
+		uint32_t         offset;         // index of first joint matrix in `matrices`
+		uint32_t         normals_offset; // index of first joint normal matrix in `matrices`
+	};
+
+	std::vector<entry_t>   entries;       //
+	std::vector<glm::mat4> matrices;      // joint matrices, and joint normal matrices for all entries
+	le_buf_resource_handle handle;        // renderer resource handle for storage buffer holding `matrices`
+	le_resource_info_t     resource_info; //
+
+	bool needs_layout; // entries must be re-built - set this when a skin gets assigned to a node
+	bool needs_upload; // matrices changed since they were last uploaded
+};
+
+// Model, and normal matrix for one instance, as laid out in the shader's InstanceTransforms buffer.
+struct le_instance_transform_t {
+	glm::mat4 modelMatrix;
+	glm::mat4 normalMatrix; // given in world-space, which means normalmatrix does not depend on camera, but is transpose(inverse(globalMatrix))
+};
+
+// One primitive of one visible mesh node.
+struct stage_draw_item_t {
+	le_gpso_handle pipeline;        // non-owning
+	uint32_t       material_idx;    // ~0u if primitive has no material
+	uint32_t       mesh_idx;        //
+	uint32_t       primitive_idx;   //
+	uint32_t       node_idx;        //
+	bool           is_instanceable; // false if primitive needs per-node data other than its transform: joints, or morph target weights
+};
+
+// Draw lists for primitives which we draw from the CPU, built each frame when the stage is drawn into a
+// render module: visible primitives per scene, sorted by state, and instance transforms in draw list
+// order, for all scenes. Transforms go into a storage buffer which grows as needed - encoder scratch
+// memory is too small to hold transforms for large scenes.
+struct le_cpu_draws_o {
+	struct scene_draws_t {
+		std::vector<stage_draw_item_t> items;           // sorted by pipeline, material, mesh, primitive
+		uint32_t                       first_transform; // index of transform for first item in `transforms`
+	};
+
+	std::vector<scene_draws_t>           scene_draws;   // one per scene
+	std::vector<le_instance_transform_t> transforms;    //
+	std::vector<uint32_t>                visible_nodes; // scratch space for culling
+	le_buf_resource_handle               handle;        // renderer resource handle for storage buffer holding `transforms`
+	le_resource_info_t                   resource_info; //
+	uint32_t                             capacity;      // number of transforms which fit into storage buffer
+};
+
+// Draw data for GPU-driven drawing: instanceable primitives are grouped by scene, pipeline,
+// material, and primitive - each group becomes one indirect draw command. Consecutive groups
+// which may be drawn with the same bindings form a batch, which we draw via one draw-indirect-count.
+// A compute pass culls all instances against the camera frustum, copies transforms for visible
+// instances into each group's range of visible transforms, and writes instance counts, and one
+// draw count per batch, which the draw pass then reads.
+struct le_gpu_draws_o {
+	// Number of uint32_t per draw command - large enough for VkDrawIndexedIndirectCommand,
+	// non-indexed draws use the first four elements as VkDrawIndirectCommand.
+	static constexpr uint32_t COMMAND_STRIDE = 5;
+
+	struct group_t {
+		le_gpso_handle pipeline;       // non-owning
+		uint32_t       scene_idx;      //
+		uint32_t       material_idx;   // ~0u if primitive has no material
+		uint32_t       mesh_idx;       //
+		uint32_t       primitive_idx;  //
+		uint32_t       first_instance; // first slot for this group in visible transforms
+		uint32_t       instance_count; // number of instances in this group before culling
+		uint32_t       batch_idx;      //
+		uint32_t       batch_slot;     // index of this group within its batch
+		uint32_t       first_index;    // relative to first group in batch, whose buffers we bind for the batch
+		int32_t        vertex_offset;  // relative to first group in batch - first vertex for draws without indices
+	};
+
+	// Groups in a batch share scene, pipeline, material, and buffers - only their offsets into
+	// these buffers differ, which their draw commands express via first index, and vertex offset.
+	struct batch_t {
+		uint32_t first_group;
+		uint32_t group_count;
+	};
+
+	// Layout must match `Instance` in cull_instances.comp
+	struct instance_t {
+		glm::vec3 bounds_min;     // object-space bounds; bounds_min.x > bounds_max.x means: never cull
+		uint32_t  group_idx;      //
+		glm::vec3 bounds_max;     //
+		uint32_t  first_instance; // first slot for this instance's group in visible transforms
+		uint32_t  batch_idx;      // index of draw count for this instance's batch
+		uint32_t  batch_slot;     // index of this instance's group within its batch
+		uint32_t  padding[ 2 ];   // std430 rounds up struct size to a multiple of 16, the alignment of vec3
+	};
+
+	std::vector<group_t>                 groups;         // sorted by scene, pipeline, material, mesh, primitive
+	std::vector<batch_t>                 batches;        // in group order
+	std::vector<instance_t>              instances;      // in group order
+	std::vector<uint32_t>                instance_nodes; // node index for each instance
+	std::vector<le_instance_transform_t> transforms;     // transforms for each instance, updated whenever their nodes move
+	std::vector<uint32_t>                commands;       // draw commands with zero instances, one per group, followed by one (zero) draw count per batch
+
+	le_buf_resource_handle instances_handle;
+	le_buf_resource_handle transforms_handle;
+	le_buf_resource_handle visible_transforms_handle; // written by cull pass, read by draw pass as InstanceTransforms
+	le_buf_resource_handle commands_handle;           // written by cull pass, read by draw pass as indirect draw commands, and counts
+	le_resource_info_t     instances_info;
+	le_resource_info_t     transforms_info;
+	le_resource_info_t     commands_info;
+
+	le_cpso_handle cull_pipeline; // non-owning
+
+	bool enabled;
+	bool needs_build{ true };    // groups must be re-built - set this when nodes, scenes, or pipelines change
+	bool needs_upload;           // instances changed since they were last uploaded
+	bool transforms_need_upload; // transforms for some instances changed since they were last uploaded
+};
+
 // Owns all the data
 struct le_stage_o {
 	le_renderer_o*                      renderer;        // non-owning
@@ -373,6 +550,7 @@ struct le_stage_o {
 	std::vector<le_scene_o>             scenes;          //
 	std::vector<le_animation_o>         animations;      //
 	std::vector<le_node_o*>             nodes;           // owning
+	le_transform_hierarchy_o            transforms;      // transforms for nodes
 	std::vector<le_camera_settings_o>   camera_settings; //
 	std::vector<le_mesh_o>              meshes;          //
 	std::vector<le_light_info>          lights;          //
@@ -386,6 +564,11 @@ struct le_stage_o {
 	std::vector<stage_image_o*>         images;          // owning
 	std::vector<le_img_resource_handle> image_handles;   //
 	std::vector<le_skin_o*>             skins;           // owning
+	le_joint_palette_o                  joint_palette;   // joint matrices for all skinned nodes
+	le_cpu_draws_o                      cpu_draws;       // draw lists for most recent draw
+	le_gpu_draws_o                      gpu_draws;       // only used if drawing gpu-driven
+	le_stage_draw_stats_t               draw_stats;      // statistics for most recent draw
+	le::Extent2D                        draw_extent;     // extent of most recent draw pass - we need this to calculate the frustum for culling
 };
 
 // clang-format off
@@ -401,18 +584,17 @@ struct le_stage_o {
 		        };
 // clang-format on
 
-/// \brief Create image by interpreting given memory as an image.
-/// \note  Image memory is decoded via stb_image.
-/// \param debug_name : (optional) name to remember the image by.
-/// \param mip_levels_: (optional) number of mip-levels to auto-generate:
-///        0 means generate the full mip chain, any other number limits
-///        the number of mip levels.
-static uint32_t le_stage_create_image_from_memory(
-    le_stage_o*          stage,
-    unsigned char const* image_file_memory,
-    uint32_t             image_file_sz,
-    char const*          debug_name,
-    uint32_t             mip_levels_ ) {
+/// \brief Create image by interpreting given memory as an image - takes ownership of `image_file_memory`,
+/// which must have been allocated via malloc.
+/// \note  Decoding happens asynchronously on le_jobs worker threads, if the job system is available:
+///        loading scenes with many textures keeps all cores busy, instead of decoding images one
+///        after another. We only wait for decoding to complete once an image needs to be uploaded.
+static uint32_t le_stage_create_image_from_owned_memory(
+    le_stage_o* stage,
+    void*       image_file_memory,
+    uint32_t    image_file_sz,
+    char const* debug_name,
+    uint32_t    mip_levels_ ) {
 
 	assert( image_file_memory && "must point to memory" );
 	assert( image_file_sz && "must have size > 0" );
@@ -442,9 +624,11 @@ static uint32_t le_stage_create_image_from_memory(
 
 		stage_image_o* img = new stage_image_o{};
 
+		auto encoded_data = static_cast<unsigned char const*>( image_file_memory );
+
 		// We want to find out whether this image uses a 16 bit type.
 		// further, if this image uses a single channel, we are fine with it,
-		le_pixels_i.get_info_from_memory( image_file_memory, image_file_sz, &img->info );
+		le_pixels_i.get_info_from_memory( encoded_data, image_file_sz, &img->info );
 
 		// If image more than 1 channel, we will request 4 channels, as
 		// we cannot sample from RGB images (must be RGBA).
@@ -452,11 +636,14 @@ static uint32_t le_stage_create_image_from_memory(
 			img->info.num_channels = 4;
 		}
 
-		// update pixel information after load, since load hints/requests may have changed
-		// how image was decoded in the end.
+		// Update pixel information to reflect what we requested, since we will not know
+		// what decoding produced until decoding completes; the image header is enough
+		// for us to tell the image's extents.
+		img->info.bpp        = 8 * ( 1 << ( img->info.type & 0b11 ) ) * img->info.num_channels;
+		img->info.byte_count = ( img->info.bpp / 8 ) * ( img->info.width * img->info.height * img->info.depth );
 
-		img->pixels          = le_pixels_i.create_from_memory( image_file_memory, image_file_sz, img->info.num_channels, img->info.type );
-		img->info            = le_pixels_i.get_info( img->pixels );
+		img->pixels_load     = le_pixels_i.load_async_from_memory( encoded_data, image_file_sz, int( img->info.num_channels ), img->info.type, nullptr, 0 );
+		img->encoded_data    = image_file_memory;
 		img->handle          = res;
 		img->was_transferred = false;
 
@@ -486,11 +673,49 @@ static uint32_t le_stage_create_image_from_memory(
 
 		stage->images.emplace_back( img );
 		stage->image_handles.emplace_back( res );
+	} else {
+		free( image_file_memory );
 	}
 
 	return image_handle_idx;
 }
 
+/// \brief Create image by interpreting given memory as an image.
+/// \note  Image memory is decoded via stb_image.
+/// \param debug_name : (optional) name to remember the image by.
+/// \param mip_levels_: (optional) number of mip-levels to auto-generate:
+///        0 means generate the full mip chain, any other number limits
+///        the number of mip levels.
+static uint32_t le_stage_create_image_from_memory(
+    le_stage_o*          stage,
+    unsigned char const* image_file_memory,
+    uint32_t             image_file_sz,
+    char const*          debug_name,
+    uint32_t             mip_levels_ ) {
+
+	assert( image_file_memory && "must point to memory" );
+	assert( image_file_sz && "must have size > 0" );
+
+	// We must keep a copy of the encoded image, as decoding may still be
+	// in progress once this method returns.
+	void* encoded_data = malloc( image_file_sz );
+	memcpy( encoded_data, image_file_memory, image_file_sz );
+
+	return le_stage_create_image_from_owned_memory( stage, encoded_data, image_file_sz, debug_name, mip_levels_ );
+}
+
+/// \brief Block until image has been decoded, and free encoded image data.
+static void stage_image_resolve_pixels( stage_image_o* img ) {
+	if ( img->pixels_load ) {
+		img->pixels      = le_pixels::le_pixels_i.load_wait( img->pixels_load );
+		img->pixels_load = nullptr;
+	}
+	if ( img->encoded_data ) {
+		free( img->encoded_data );
+		img->encoded_data = nullptr;
+	}
+}
+
 /// \brief create image by loading file at given filepath into memory,
 /// then handing over to `create_image_from_memory`
 static uint32_t le_stage_create_image_from_file_path( le_stage_o* stage, char const* image_file_path, char const* debug_name, uint32_t mip_levels ) {
@@ -515,18 +740,16 @@ static uint32_t le_stage_create_image_from_file_path( le_stage_o* stage, char co
 
 	assert( num_bytes_read == image_file_sz );
 
-	// load into memory, call create_image_from_memory
+	fclose( file );
+
+	// load into memory, hand over to create_image_from_owned_memory,
+	// which takes ownership of, and eventually frees file memory
 	uint32_t result =
-	    le_stage_create_image_from_memory(
+	    le_stage_create_image_from_owned_memory(
 	        stage,
-	        static_cast<unsigned char const*>( image_file_memory ),
+	        image_file_memory,
 	        uint32_t( image_file_sz ), debug_name, mip_levels );
 
-	free( image_file_memory );
-
-	fclose( file );
-	// free file memory
-
 	return result;
 }
 
@@ -596,15 +819,27 @@ static le::BufferUsageFlags get_defaults_buffer_usage_flags() {
 	return flags;
 }
 
-/// \brief Add a buffer to stage, return index to buffer within this stage.
-///
-static uint32_t le_stage_create_buffer( le_stage_o* stage, void* mem, uint32_t sz, char const* debug_name ) {
+/// \brief Let go of memory held by buffer: free it if buffer owns it, otherwise
+/// tell whoever lent us the memory that we don't need it anymore.
+static void stage_buffer_release_mem( le_buffer_o* buffer ) {
+	if ( buffer->owns_mem ) {
+		free( buffer->mem );
+	} else if ( buffer->release_fn ) {
+		buffer->release_fn( buffer->release_user_data );
+	}
+	buffer->mem               = nullptr;
+	buffer->owns_mem          = false;
+	buffer->release_fn        = nullptr;
+	buffer->release_user_data = nullptr;
+}
 
-	assert( mem && "must point to memory" );
-	assert( sz && "must have size > 0" );
+/// \brief Add a buffer which uses `mem` as its backing memory, return index to buffer within this stage.
+static uint32_t stage_add_buffer( le_stage_o* stage, void* mem, uint32_t sz, bool owns_mem, void ( *release_fn )( void* user_data ), void* release_user_data, char const* debug_name ) {
 
 	assert( stage->buffers.size() == stage->buffer_handles.size() );
 
+	le_buf_resource_handle res = LE_BUF_RESOURCE( "" ); // force unique handle
+
 #if LE_RESOURCE_LABEL_LENGTH > 0
 	if ( debug_name ) {
 		// Copy debug name if such was given, and handle has debug name field.
@@ -612,8 +847,6 @@ static uint32_t le_stage_create_buffer( le_stage_o* stage, void* mem, uint32_t s
 	}
 #endif
 
-	le_buf_resource_handle res = LE_BUF_RESOURCE( "" ); // force unique handle
-
 	uint32_t buffer_handle_idx = 0;
 	for ( auto& h : stage->buffer_handles ) {
 		if ( h == res ) {
@@ -627,22 +860,16 @@ static uint32_t le_stage_create_buffer( le_stage_o* stage, void* mem, uint32_t s
 	if ( buffer_handle_idx == stage->buffer_handles.size() ) {
 
 		// Buffer with this hash was not yet seen before
-		// - we must allocate a new buffer.
+		// - we must add a new buffer.
 
 		le_buffer_o* buffer = new le_buffer_o{};
 
-		buffer->handle = res;
-		buffer->mem    = malloc( sz );
-
-		if ( buffer->mem ) {
-			memcpy( buffer->mem, mem, sz );
-			buffer->owns_mem = true;
-			buffer->size     = sz;
-		} else {
-			// TODO: handle out-of-memory error.
-			delete buffer;
-			assert( false );
-		}
+		buffer->handle            = res;
+		buffer->mem               = mem;
+		buffer->size              = sz;
+		buffer->owns_mem          = owns_mem;
+		buffer->release_fn        = release_fn;
+		buffer->release_user_data = release_user_data;
 
 		static const auto BUFFER_USAGE_FLAGS = get_defaults_buffer_usage_flags();
 
@@ -653,11 +880,50 @@ static uint32_t le_stage_create_buffer( le_stage_o* stage, void* mem, uint32_t s
 
 		stage->buffer_handles.push_back( res );
 		stage->buffers.push_back( buffer );
+	} else {
+		// We won't use the memory that was handed to us.
+		if ( owns_mem ) {
+			free( mem );
+		} else if ( release_fn ) {
+			release_fn( release_user_data );
+		}
 	}
 
 	return buffer_handle_idx;
 }
 
+/// \brief Add a buffer to stage, return index to buffer within this stage.
+/// \note  Copies `sz` bytes from `mem` - the caller keeps ownership of `mem`.
+static uint32_t le_stage_create_buffer( le_stage_o* stage, void* mem, uint32_t sz, char const* debug_name ) {
+
+	assert( mem && "must point to memory" );
+	assert( sz && "must have size > 0" );
+
+	void* buffer_mem = malloc( sz );
+
+	if ( nullptr == buffer_mem ) {
+		// TODO: handle out-of-memory error.
+		assert( false );
+		return uint32_t( stage->buffers.size() );
+	}
+
+	memcpy( buffer_mem, mem, sz );
+
+	return stage_add_buffer( stage, buffer_mem, sz, true, nullptr, nullptr, debug_name );
+}
+
+/// \brief Add a buffer to stage which refers to `mem` without copying it, return index to buffer within this stage.
+/// \note  `mem` must stay valid, and unchanged, until stage calls `release_fn( release_user_data )` - which
+///        happens once the buffer has been uploaded, or when the stage gets destroyed, whichever comes first.
+///        `release_fn` may be called from a render worker thread.
+static uint32_t le_stage_create_buffer_non_owning( le_stage_o* stage, void* mem, uint32_t sz, char const* debug_name, void ( *release_fn )( void* user_data ), void* release_user_data ) {
+
+	assert( mem && "must point to memory" );
+	assert( sz && "must have size > 0" );
+
+	return stage_add_buffer( stage, mem, sz, false, release_fn, release_user_data, debug_name );
+}
+
 /// \brief add buffer view to stage, return index of added buffer view inside of stage
 static uint32_t le_stage_create_buffer_view( le_stage_o* self, le_buffer_view_info const* info ) {
 	le_buffer_view_o view{};
@@ -1019,11 +1285,192 @@ static uint32_t le_stage_create_mesh( le_stage_o* self, le_mesh_info const* info
 		}
 	}
 
+	// -- Calculate mesh bounds from min/max of position accessors, which glTF requires to be given.
+	//
+	// Morph targets hold displacements - weights are usually within [0..1], so we extend
+	// bounds by any negative minimum, and any positive maximum displacement.
+
+	mesh.has_bounds = !mesh.primitives.empty();
+	mesh.bounds_min = glm::vec3( std::numeric_limits<float>::max() );
+	mesh.bounds_max = glm::vec3( -std::numeric_limits<float>::max() );
+
+	for ( auto const& primitive : mesh.primitives ) {
+
+		bool      has_positions = false;
+		glm::vec3 p_min{};
+		glm::vec3 p_max{};
+		glm::vec3 displacement_min{};
+		glm::vec3 displacement_max{};
+
+		for ( auto const& attr : primitive.attributes ) {
+
+			if ( attr.type != le_primitive_attribute_info::Type::ePosition ) {
+				continue;
+			}
+
+			auto const& acc = self->accessors[ attr.accessor_idx ];
+
+			if ( !acc.has_min || !acc.has_max || get_num_components( acc.type ) < 3 ) {
+				has_positions = false;
+				break;
+			}
+
+			glm::vec3 const acc_min{ acc.min[ 0 ], acc.min[ 1 ], acc.min[ 2 ] };
+			glm::vec3 const acc_max{ acc.max[ 0 ], acc.max[ 1 ], acc.max[ 2 ] };
+
+			if ( attr.morph.target.is_target ) {
+				displacement_min += glm::min( acc_min, glm::vec3( 0 ) );
+				displacement_max += glm::max( acc_max, glm::vec3( 0 ) );
+			} else if ( attr.index == 0 ) {
+				p_min         = acc_min;
+				p_max         = acc_max;
+				has_positions = true;
+			}
+		}
+
+		if ( !has_positions ) {
+			mesh.has_bounds = false;
+			break;
+		}
+
+		mesh.bounds_min = glm::min( mesh.bounds_min, p_min + displacement_min );
+		mesh.bounds_max = glm::max( mesh.bounds_max, p_max + displacement_max );
+	}
+
 	uint32_t idx = uint32_t( self->meshes.size() );
 	self->meshes.emplace_back( mesh );
 	return idx;
 }
 
+// ----------------------------------------------------------------------
+
+static inline glm::mat4 const& node_get_global_transform( le_stage_o const* stage, le_node_o const* node ) {
+	return stage->transforms.global[ stage->transforms.slot_of_node[ node->idx ] ];
+}
+
+// ----------------------------------------------------------------------
+
+static inline glm::mat4 const& node_get_inverse_global_transform( le_stage_o const* stage, le_node_o const* node ) {
+	return stage->transforms.inverse_global[ stage->transforms.slot_of_node[ node->idx ] ];
+}
+
+// ----------------------------------------------------------------------
+/// \brief Add a slot for a node which has just been appended to stage->nodes.
+/// \note  Slots must be re-sorted via `transform_hierarchy_sort` once all new nodes have been added.
+static void transform_hierarchy_append( le_transform_hierarchy_o* self, uint32_t node_idx, glm::vec3 const& translation, glm::quat const& rotation, glm::vec3 const& scale, glm::mat4 const& local ) {
+
+	assert( node_idx == self->slot_of_node.size() && "nodes must be appended in order" );
+
+	uint32_t slot = uint32_t( self->parent.size() );
+
+	self->parent.push_back( le_transform_hierarchy_o::NO_PARENT );
+	self->translation.push_back( translation );
+	self->rotation.push_back( rotation );
+	self->scale.push_back( scale );
+	self->local.push_back( local );
+	self->global.push_back( local );
+	self->inverse_global.push_back( glm::mat4( 1.f ) );
+	self->local_dirty.push_back( 1 );
+	self->global_dirty.push_back( 0 );
+	self->node_of_slot.push_back( node_idx );
+	self->slot_of_node.push_back( slot );
+
+	self->has_local_changes = true;
+}
+
+// ----------------------------------------------------------------------
+
+template <typename T>
+static void permute( std::vector<T>& values, std::vector<uint32_t> const& old_slot_of_new_slot ) {
+	std::vector<T> result;
+	result.reserve( values.size() );
+	for ( uint32_t old_slot : old_slot_of_new_slot ) {
+		result.push_back( values[ old_slot ] );
+	}
+	values.swap( result );
+}
+
+// ----------------------------------------------------------------------
+/// \brief Sort slots breadth-first, so that parents come before their children,
+/// and slots are grouped by level of depth. Call this whenever nodes were added.
+static void transform_hierarchy_sort( le_transform_hierarchy_o* self, std::vector<le_node_o*> const& nodes ) {
+
+	uint32_t const num_nodes = uint32_t( nodes.size() );
+
+	assert( self->slot_of_node.size() == num_nodes );
+
+	constexpr uint32_t NO_PARENT = le_transform_hierarchy_o::NO_PARENT;
+
+	// -- Find parent for each node
+
+	std::vector<uint32_t> parent_of_node( num_nodes, NO_PARENT );
+
+	for ( le_node_o const* n : nodes ) {
+		for ( le_node_o const* c : n->children ) {
+			assert( parent_of_node[ c->idx ] == NO_PARENT && "node must not have more than one parent" );
+			parent_of_node[ c->idx ] = n->idx;
+		}
+	}
+
+	// -- Breadth-first traversal, starting with root nodes, gives us nodes
+	// sorted by level - we store the old slot for each new slot.
+
+	std::vector<uint32_t> old_slot_of_new_slot;
+	std::vector<uint32_t> new_slot_of_node( num_nodes, NO_PARENT );
+
+	old_slot_of_new_slot.reserve( num_nodes );
+	self->level_offsets.clear();
+
+	for ( uint32_t i = 0; i != num_nodes; i++ ) {
+		if ( parent_of_node[ i ] == NO_PARENT ) {
+			new_slot_of_node[ i ] = uint32_t( old_slot_of_new_slot.size() );
+			old_slot_of_new_slot.push_back( self->slot_of_node[ i ] );
+		}
+	}
+
+	for ( uint32_t level_begin = 0; level_begin != old_slot_of_new_slot.size(); ) {
+
+		uint32_t const level_end = uint32_t( old_slot_of_new_slot.size() );
+
+		self->level_offsets.push_back( level_begin );
+
+		for ( uint32_t slot = level_begin; slot != level_end; slot++ ) {
+			le_node_o const* n = nodes[ self->node_of_slot[ old_slot_of_new_slot[ slot ] ] ];
+			for ( le_node_o const* c : n->children ) {
+				new_slot_of_node[ c->idx ] = uint32_t( old_slot_of_new_slot.size() );
+				old_slot_of_new_slot.push_back( self->slot_of_node[ c->idx ] );
+			}
+		}
+
+		level_begin = level_end;
+	}
+
+	self->level_offsets.push_back( uint32_t( old_slot_of_new_slot.size() ) );
+
+	assert( old_slot_of_new_slot.size() == num_nodes && "node hierarchy must not contain cycles" );
+
+	// -- Move per-slot data into new slots
+
+	permute( self->translation, old_slot_of_new_slot );
+	permute( self->rotation, old_slot_of_new_slot );
+	permute( self->scale, old_slot_of_new_slot );
+	permute( self->local, old_slot_of_new_slot );
+	permute( self->global, old_slot_of_new_slot );
+	permute( self->inverse_global, old_slot_of_new_slot );
+	permute( self->local_dirty, old_slot_of_new_slot );
+	permute( self->global_dirty, old_slot_of_new_slot );
+	permute( self->node_of_slot, old_slot_of_new_slot );
+
+	for ( uint32_t slot = 0; slot != num_nodes; slot++ ) {
+		uint32_t parent_node = parent_of_node[ self->node_of_slot[ slot ] ];
+		self->parent[ slot ] = parent_node == NO_PARENT ? NO_PARENT : new_slot_of_node[ parent_node ];
+	}
+
+	self->slot_of_node.swap( new_slot_of_node );
+}
+
+// ----------------------------------------------------------------------
+
 /// \brief create nodes graph from list of nodes.
 /// nodes may refer to each other by index via their children property - indices may only refer
 /// to nodes passed within info. you cannot refer to nodes which are already inside the scene graph.
@@ -1039,11 +1486,13 @@ static uint32_t le_stage_create_nodes( le_stage_o* self, le_node_info const* inf
 	for ( auto n = n_begin; n != n_end; n++ ) {
 		le_node_o* node = new le_node_o{};
 
-		node->local_scale       = n->local_scale->data;
-		node->local_rotation    = glm::quat{ n->local_rotation->data };
-		node->local_translation = n->local_translation->data;
+		node->idx = uint32_t( self->nodes.size() );
 
-		node->local_transform = n->local_transform->data;
+		transform_hierarchy_append( &self->transforms, node->idx,
+		                            n->local_translation->data,
+		                            glm::quat{ n->local_rotation->data },
+		                            n->local_scale->data,
+		                            n->local_transform->data );
 
 		if ( n->has_mesh ) {
 			node->has_mesh = true;
@@ -1086,6 +1535,15 @@ static uint32_t le_stage_create_nodes( le_stage_o* self, le_node_info const* inf
 		}
 	}
 
+	transform_hierarchy_sort( &self->transforms, self->nodes );
+
+	// Sorting may have moved transform slots for any node.
+	for ( auto& s : self->scenes ) {
+		s.bvh.needs_build = true;
+	}
+
+	self->gpu_draws.needs_build = true;
+
 	return idx;
 }
 
@@ -1156,13 +1614,15 @@ static void le_node_o_set_scene_bit( le_node_o* node, uint8_t bit ) {
 }
 
 // ----------------------------------------------------------------------
-// An animation sampler is a vector of keyframes. A keyframe contains a time-mapped
-// target value, together with two optional interpolation value parameters, and
-// an enum signaling the type of interpolation to apply.
-static std::vector<le_keyframe_o> le_stage_create_animation_sampler( le_stage_o* self, le_animation_sampler_info* info, LeAnimationTargetType const& target_type ) {
+// An animation sampler is a sequence of keyframes. A keyframe contains a time-mapped
+// target value, together with two optional interpolation value parameters (tangents),
+// and the interpolation to apply is the same for all keyframes of a sampler.
+//
+// We load keyframe times and values into the channel, so that buffers may be discarded
+// once they have been uploaded.
+static void le_stage_load_animation_sampler( le_stage_o* self, le_animation_channel_o* channel, le_animation_sampler_info const* info, LeAnimationTargetType const& target_type ) {
 
-	// We must sample data from accessors and store it into keyframe so that we can
-	// apply it faster.
+	static auto logger = LeLog( LOGGER_LABEL );
 
 	// Output accessor decides about how many values are loaded and interpolated.
 	// This depends on the type of what the accessor points to.
@@ -1170,19 +1630,6 @@ static std::vector<le_keyframe_o> le_stage_create_animation_sampler( le_stage_o*
 	// Animation data will always only cover one of: T,R,S; or a scalar
 	// value (telling us how to interpolate between morph targets).
 
-	// Build keyframes by iterating over accessors and resolving their data.
-	//
-	// We want to store keyframe data locally, so that the buffer can be discarded, once it
-	// has been uploaded.
-
-	// Note that the interpolation type is the same for all
-	// elements within a channel.
-
-	std::vector<le_keyframe_o> keyframes;
-
-	// A le_sampler_o is a vector of keyframes
-	// we build the sampler by loading keyframe data by resolving accessors
-
 	auto& input_accessor  = self->accessors[ info->input_accesstor_idx ];
 	auto& output_accessor = self->accessors[ info->output_accessor_idx ];
 
@@ -1219,6 +1666,20 @@ static std::vector<le_keyframe_o> le_stage_create_animation_sampler( le_stage_o*
 		compound_type = le_compound_num_type::eQuat4;
 	}
 
+	channel->interpolation  = info->interpolation_type;
+	channel->values_per_key = info->interpolation_type == le_animation_sampler_info::InterpolationType::eCubicSpline ? 3 : 1;
+
+	// Number of values per keyframe - which is more than one for morph target weights: one weight per morph target.
+	uint32_t const array_size = std::max( 1u, num_output_per_input / channel->values_per_key );
+
+	channel->num_components = get_num_components( compound_type ) * array_size;
+
+	if ( channel->num_components > sizeof( channel->value ) / sizeof( float ) ) {
+		logger.warn( "Animation channel targets %u values, but at most %zu are supported. Ignoring channel.",
+		             channel->num_components, sizeof( channel->value ) / sizeof( float ) );
+		return;
+	}
+
 	le_buffer_view_o const& input_buffer_view  = self->buffer_views[ input_accessor.buffer_view_idx ];
 	le_buffer_view_o const& output_buffer_view = self->buffer_views[ output_accessor.buffer_view_idx ];
 
@@ -1237,62 +1698,36 @@ static std::vector<le_keyframe_o> le_stage_create_animation_sampler( le_stage_o*
 	        ? output_buffer_view.byte_stride
 	        : size_of( num_type ) * get_num_components( compound_type );
 
-	char* input  = static_cast<char*>( input_buffer->mem );
-	char* output = static_cast<char*>( output_buffer->mem );
+	char const* input  = static_cast<char const*>( input_buffer->mem ) + input_buffer_view.byte_offset + input_accessor.byte_offset;
+	char const* output = static_cast<char const*>( output_buffer->mem ) + output_buffer_view.byte_offset + output_accessor.byte_offset;
+
+	uint32_t const floats_per_output = get_num_components( compound_type );
+	uint32_t const floats_per_key    = num_output_per_input * floats_per_output;
+
+	channel->key_ticks.resize( input_accessor.count );
+	channel->key_values.resize( size_t( input_accessor.count ) * floats_per_key );
 
-	input += input_buffer_view.byte_offset;
-	output += output_buffer_view.byte_offset;
+	float* key_value = channel->key_values.data();
 
 	// TODO: check for overflow
 	for ( uint32_t ia = 0; ia != input_accessor.count; ia++ ) {
-		auto input_data  = input + input_accessor.byte_offset;
-		auto output_data = output + output_accessor.byte_offset;
 
-		le_keyframe_o keyframe{};
-		keyframe.compound_num_type = compound_type;
-		keyframe.num_type          = num_type;
-		keyframe.array_size        = uint16_t( num_output_per_input );
+		float input_time_seconds;
+		memcpy( &input_time_seconds, input, sizeof( float ) );
 
-		float input_time_seconds = *reinterpret_cast<float*>( input_data );
-		keyframe.delta_ticks     = uint64_t( lroundf( LE_TIME_TICKS_PER_SECOND * input_time_seconds ) );
+		channel->key_ticks[ ia ] = uint64_t( lroundf( LE_TIME_TICKS_PER_SECOND * input_time_seconds ) );
 
-		// For each element in output accessor: load data.
-		//
-		// This generalises to the case when there is just one accessor,
-		// as we assume that the 0 element of an array of type `T` within a union is at
-		// the same offset as the scalar version of type `T` within the union.
+		// For each element in output accessor: load data. Outputs for a keyframe are
+		// consecutive, which means that for cubic splines, we load in-tangent(s), value(s),
+		// out-tangent(s), in that order.
 		for ( uint32_t i = 0; i != num_output_per_input; i++ ) {
-
-			switch ( compound_type ) {
-			case le_compound_num_type::eScalar:
-				keyframe.data.as_scalar[ i ] = *reinterpret_cast<float*>( output_data );
-				break;
-			case le_compound_num_type::eVec2:
-				keyframe.data.as_vec2[ i ] = *reinterpret_cast<glm::vec2*>( output_data );
-				break;
-			case le_compound_num_type::eVec3:
-				keyframe.data.as_vec3[ i ] = *reinterpret_cast<glm::vec3*>( output_data );
-				break;
-			case le_compound_num_type::eVec4:
-				keyframe.data.as_vec4[ i ] = *reinterpret_cast<glm::vec4*>( output_data );
-				break;
-			case le_compound_num_type::eQuat4:
-				keyframe.data.as_quat[ i ] = *reinterpret_cast<glm::quat*>( output_data );
-				break;
-			default:
-				assert( false ); // unreacahble
-			}
-
-			output_data += output_stride;
+			memcpy( key_value, output, sizeof( float ) * floats_per_output );
+			key_value += floats_per_output;
+			output += output_stride;
 		}
 
-		keyframes.emplace_back( keyframe );
-
 		input += input_stride;
-		output += output_stride * num_output_per_input;
 	}
-
-	return keyframes;
 }
 
 // ----------------------------------------------------------------------
@@ -1311,37 +1746,33 @@ static uint32_t le_stage_create_animation( le_stage_o* self, le_animation_info c
 
 		assert( c->animation_sampler_idx < info->samplers_count );
 
-		channel.sampler     = le_stage_create_animation_sampler( self, info->samplers + c->animation_sampler_idx, c->animation_target_type );
+		le_stage_load_animation_sampler( self, &channel, info->samplers + c->animation_sampler_idx, c->animation_target_type );
 		channel.target_node = self->nodes[ c->node_idx ];
 
+		channel.target_type = c->animation_target_type;
+
 		switch ( c->animation_target_type ) {
 		case LeAnimationTargetType::eTranslation:
-			channel.target_node_element  = &channel.target_node->local_translation[ 0 ];
 			channel.target_compound_type = le_compound_num_type::eVec3;
 			break;
 		case LeAnimationTargetType::eScale:
-			channel.target_node_element  = &channel.target_node->local_scale[ 0 ];
 			channel.target_compound_type = le_compound_num_type::eVec3;
 			break;
 		case LeAnimationTargetType::eRotation:
-			channel.target_node_element  = &channel.target_node->local_rotation[ 0 ];
 			channel.target_compound_type = le_compound_num_type::eQuat4;
 			break;
 		case LeAnimationTargetType::eWeights:
 			channel.target_compound_type = le_compound_num_type::eScalar;
-			channel.target_node_element  = channel.target_node->morph_target_weights;
 			break;
 		default:
 			assert( false ); // unreachable
 			break;
 		}
 
-		if ( !channel.sampler.empty() ) {
+		if ( !channel.key_ticks.empty() ) {
 
-			assert( channel.target_compound_type == channel.sampler.front().compound_num_type );
-
-			channel.ticks_offset   = channel.sampler.front().delta_ticks;
-			channel.ticks_duration = channel.sampler.back().delta_ticks;
+			channel.ticks_offset   = channel.key_ticks.front();
+			channel.ticks_duration = channel.key_ticks.back();
 
 			// For each animation we must find out when it begins, and how long it lasts.
 			// we use this to skip over animations if they don't fall within our current
@@ -1388,7 +1819,7 @@ static uint32_t le_stage_create_skin( le_stage_o* self, le_skin_info const* info
 		size_t mat_byte_count = sizeof( glm::mat4 ) * info->node_indices_count;
 
 		assert( buffView.byte_length = uint32_t( mat_byte_count ) && "Buffer must hold enough bytes of memory for joints matrices" );
-		assert( buf->owns_mem && "Buffer must own its own memory" );
+		assert( buf->mem && "Buffer memory must still be available" );
 
 		glm::mat4* matrices = reinterpret_cast<glm::mat4*>( static_cast<char*>( buf->mem ) + buffView.byte_offset + acc.byte_offset );
 		memcpy( skin->inverse_bind_matrices.data(), matrices, mat_byte_count );
@@ -1412,6 +1843,13 @@ static uint32_t le_stage_create_skin( le_stage_o* self, le_skin_info const* info
 
 static void le_stage_node_set_skin( le_stage_o* self, uint32_t node_idx, uint32_t skin_idx ) {
 	self->nodes.at( node_idx )->skin = self->skins.at( skin_idx );
+	self->joint_palette.needs_layout = true;
+
+	for ( auto& s : self->scenes ) {
+		s.bvh.needs_build = true; // skinned nodes can't be culled
+	}
+
+	self->gpu_draws.needs_build = true; // skinned nodes can't be instanced
 }
 
 // ----------------------------------------------------------------------
@@ -1434,6 +1872,8 @@ static uint32_t le_stage_create_scene( le_stage_o* self, uint32_t* node_idx, uin
 
 	self->scenes.emplace_back( scene );
 
+	self->gpu_draws.needs_build = true;
+
 	return idx;
 }
 
@@ -1475,15 +1915,18 @@ static void pass_xfer_resources( le_command_buffer_encoder_o* encoder_, void* us
 			// upload buffer
 			encoder.writeToBuffer( b->handle, 0, b->mem, b->size );
 
-			// we could possibly free mem once that's done.
-			free( b->mem );
-			b->mem             = nullptr;
-			b->owns_mem        = false;
+			// Encoder has copied our data for upload - we don't need to hold on to it anymore.
+			stage_buffer_release_mem( b );
 			b->was_transferred = true;
 		}
 	}
 
 	for ( auto& img : stage->images ) {
+
+		if ( !img->was_transferred ) {
+			stage_image_resolve_pixels( img );
+		}
+
 		if ( !img->was_transferred && img->pixels ) {
 			using namespace le_pixels;
 			void* pix_data = le_pixels_i.get_data( img->pixels );
@@ -1547,6 +1990,68 @@ static void le_stage_update_render_module( le_stage_o* stage, le_rendergraph_o*
 	rendergraph_i
 	    .add_renderpass( module, rp );
 
+	// declare joint palette, and upload it whenever joint matrices have changed
+
+	if ( !stage->joint_palette.entries.empty() ) {
+
+		rendergraph_i.declare_resource( module, stage->joint_palette.handle, stage->joint_palette.resource_info );
+
+		auto joint_palette_pass =
+		    le::RenderPass( "Stage_Joint_Palette", le::QueueFlagBits::eTransfer )
+		        .setSetupCallback( stage, []( le_renderpass_o* pRp, void* user_data ) -> bool {
+			        le::RenderPass rp{ pRp };
+			        auto           stage = static_cast<le_stage_o*>( user_data );
+			        rp.useBufferResource( stage->joint_palette.handle, { le::BufferUsageFlags( le::BufferUsageFlagBits::eTransferDst ) } );
+			        return stage->joint_palette.needs_upload; // false means not to execute the execute callback.
+		        } )
+		        .setExecuteCallback( stage, []( le_command_buffer_encoder_o* encoder_, void* user_data ) {
+			        auto  stage   = static_cast<le_stage_o*>( user_data );
+			        auto  encoder = le::Encoder{ encoder_ };
+			        auto& palette = stage->joint_palette;
+			        encoder.writeToBuffer( palette.handle, 0, palette.matrices.data(), sizeof( glm::mat4 ) * palette.matrices.size() );
+			        palette.needs_upload = false;
+		        } )
+		        .setIsRoot( true );
+
+		rendergraph_i.add_renderpass( module, joint_palette_pass );
+	}
+
+	// declare buffers for gpu-driven drawing, upload instances, and transforms whenever these have changed,
+	// and draw command templates every frame - templates reset instance counts, which the cull pass accumulates.
+
+	if ( stage->gpu_draws.enabled && !stage->gpu_draws.needs_build && !stage->gpu_draws.groups.empty() ) {
+
+		auto& gpu_draws = stage->gpu_draws;
+
+		rendergraph_i.declare_resource( module, gpu_draws.instances_handle, gpu_draws.instances_info );
+		rendergraph_i.declare_resource( module, gpu_draws.transforms_handle, gpu_draws.transforms_info );
+		rendergraph_i.declare_resource( module, gpu_draws.visible_transforms_handle, gpu_draws.transforms_info );
+		rendergraph_i.declare_resource( module, gpu_draws.commands_handle, gpu_draws.commands_info );
+
+		auto gpu_draws_pass =
+		    le::RenderPass( "Stage Gpu Draws", le::QueueFlagBits::eTransfer )
+		        .useBufferResource( gpu_draws.instances_handle, le::AccessFlagBits2::eTransferWrite )
+		        .useBufferResource( gpu_draws.transforms_handle, le::AccessFlagBits2::eTransferWrite )
+		        .useBufferResource( gpu_draws.commands_handle, le::AccessFlagBits2::eTransferWrite )
+		        .setExecuteCallback( stage, []( le_command_buffer_encoder_o* encoder_, void* user_data ) {
+			        auto  stage     = static_cast<le_stage_o*>( user_data );
+			        auto  encoder   = le::TransferEncoder{ encoder_ };
+			        auto& gpu_draws = stage->gpu_draws;
+			        if ( gpu_draws.needs_upload ) {
+				        encoder.writeToBuffer( gpu_draws.instances_handle, 0, gpu_draws.instances.data(), sizeof( le_gpu_draws_o::instance_t ) * gpu_draws.instances.size() );
+				        gpu_draws.needs_upload = false;
+			        }
+			        if ( gpu_draws.transforms_need_upload ) {
+				        encoder.writeToBuffer( gpu_draws.transforms_handle, 0, gpu_draws.transforms.data(), sizeof( le_instance_transform_t ) * gpu_draws.transforms.size() );
+				        gpu_draws.transforms_need_upload = false;
+			        }
+			        encoder.writeToBuffer( gpu_draws.commands_handle, 0, gpu_draws.commands.data(), sizeof( uint32_t ) * gpu_draws.commands.size() );
+		        } )
+		        .setIsRoot( true );
+
+		rendergraph_i.add_renderpass( module, gpu_draws_pass );
+	}
+
 #ifdef LE_FEATURE_RTX
 
 	auto cp =
@@ -1647,10 +2152,10 @@ static void le_stage_update_render_module( le_stage_o* stage, le_rendergraph_o*
 						        le_rtx_geometry_instance_t instance{};
 						        instance.mask                                   = 0xff;
 						        instance.flags                                  = 0;
-						        instance.instanceShaderBindingTableRecordOffset = 0;                                     // TODO: set this to material-specific offset, based on array of hit shader groups in pipeline.
-						        instance.instanceCustomIndex                    = 0;                                     // TODO: set this to material?
-						        glm::mat4 transform                             = glm::transpose( n->global_transform ); // must transpose so that
-						        memcpy( &instance.transform, &transform, sizeof( instance.transform ) );                 // only copy 12 floats
+						        instance.instanceShaderBindingTableRecordOffset = 0;                                                       // TODO: set this to material-specific offset, based on array of hit shader groups in pipeline.
+						        instance.instanceCustomIndex                    = 0;                                                       // TODO: set this to material?
+						        glm::mat4 transform                             = glm::transpose( node_get_global_transform( stage, n ) ); // must transpose so that
+						        memcpy( &instance.transform, &transform, sizeof( instance.transform ) );                                   // only copy 12 floats
 						        for ( auto const& p : stage->meshes[ n->mesh_idx ].primitives ) {
 							        // TODO: set instanceCustomIndex based on material...
 							        blas_handles.push_back( p.rtx_blas_handle );
@@ -1732,13 +2237,13 @@ static bool stage_get_camera( le_stage_o const* stage, uint32_t scene_idx, uint3
 	le_camera_settings_o const& camera = stage->camera_settings[ found_camera_node->camera_idx ];
 
 	if ( camera_world_matrix ) {
-		*camera_world_matrix = found_camera_node->global_transform;
+		*camera_world_matrix = node_get_global_transform( stage, found_camera_node );
 	}
 
 	// Calculate: View Matrix is inverse global transform of the camera's node matrix.
 
 	if ( camera_view_matrix ) {
-		*camera_view_matrix = found_camera_node->inverse_global_transform;
+		*camera_view_matrix = node_get_inverse_global_transform( stage, found_camera_node );
 	}
 
 	// Calculate: Projection Matrix depends on type of camera.
@@ -1763,388 +2268,1105 @@ static bool stage_get_camera( le_stage_o const* stage, uint32_t scene_idx, uint3
 }
 
 // ----------------------------------------------------------------------
+/// \brief Transform axis-aligned bounds by matrix `m`, giving axis-aligned bounds
+/// which enclose the transformed box.
+static inline void aabb_transform( glm::mat4 const& m, glm::vec3 const& lo, glm::vec3 const& hi, glm::vec3* out_lo, glm::vec3* out_hi ) {
+	glm::vec3 const c  = ( lo + hi ) * 0.5f;
+	glm::vec3 const e  = ( hi - lo ) * 0.5f;
+	glm::vec3 const wc = glm::vec3( m * glm::vec4( c, 1.f ) );
+	glm::vec3 const we = glm::abs( glm::vec3( m[ 0 ] ) ) * e.x +
+	                     glm::abs( glm::vec3( m[ 1 ] ) ) * e.y +
+	                     glm::abs( glm::vec3( m[ 2 ] ) ) * e.z;
+	*out_lo = wc - we;
+	*out_hi = wc + we;
+}
 
-static void pass_draw( le_command_buffer_encoder_o* encoder_, void* user_data ) {
-	auto draw_params = static_cast<le_stage_api::draw_params_t*>( user_data );
-	auto camera      = draw_params->camera;
-	auto stage       = draw_params->stage;
-	auto encoder     = le::Encoder{ encoder_ };
+// ----------------------------------------------------------------------
 
-	static auto logger  = LeLog( LOGGER_LABEL );
-	auto        extents = encoder.getRenderpassExtent();
+static void scene_bvh_item_update_bounds( le_scene_bvh_o::item_t* item, le_stage_o const* stage ) {
+	le_mesh_o const& mesh = stage->meshes[ stage->nodes[ item->node_idx ]->mesh_idx ];
+	aabb_transform( stage->transforms.global[ item->slot ], mesh.bounds_min, mesh.bounds_max, &item->min, &item->max );
+}
 
-	le::Viewport viewports[ 2 ] = {
-	    { 0.f, float( extents.height ), float( extents.width ), -float( extents.height ), -0.f, 1.f }, // negative viewport means to flip y axis in screen space
-	    { 0.f, 0.f, float( extents.width ), float( extents.height ), 0.f, 1.f },
-	};
+// ----------------------------------------------------------------------
+/// \brief Fill bvh node `node_idx` so that it covers items [begin, end[ - splitting items at the
+/// median along the longest axis of their centres until at most MAX_ITEMS_PER_LEAF remain.
+static void scene_bvh_build_subtree( le_scene_bvh_o* self, uint32_t node_idx, uint32_t begin, uint32_t end ) {
+
+	glm::vec3 lo( std::numeric_limits<float>::max() );
+	glm::vec3 hi( -std::numeric_limits<float>::max() );
+	glm::vec3 centre_lo = lo;
+	glm::vec3 centre_hi = hi;
+
+	for ( uint32_t i = begin; i != end; i++ ) {
+		auto const&     item   = self->items[ i ];
+		glm::vec3 const centre = ( item.min + item.max ) * 0.5f;
+		lo                     = glm::min( lo, item.min );
+		hi                     = glm::max( hi, item.max );
+		centre_lo              = glm::min( centre_lo, centre );
+		centre_hi              = glm::max( centre_hi, centre );
+	}
 
-	// we set projection matrix and view matrix to somehow sensible defaults.
-	glm::mat4 camera_projection_matrix = glm::ortho( -0.5f, 0.5f, -0.5f, 0.5f, -1000.f, 1000.f );
-	glm::mat4 camera_view_matrix       = glm::identity<glm::mat4>();
-	glm::mat4 camera_world_matrix      = glm::identity<glm::mat4>(); // global transform for camera node (==inverse view matrix)
-
-	// update camera from interactive camera
-	// if no stage camera is given, and an interactive camera is available
-	if ( camera ) {
+	self->nodes[ node_idx ].min = lo;
+	self->nodes[ node_idx ].max = hi;
 
-		using namespace le_camera;
-		le_camera_i.set_viewport( camera, viewports[ 0 ] );
-		le_camera_i.get_view_matrix( camera, ( float* )( &camera_view_matrix ) );
-		le_camera_i.get_projection_matrix( camera, ( float* )( &camera_projection_matrix ) );
-		camera_world_matrix = glm::inverse( camera_view_matrix );
-	} else {
-		// Attempt to apply first camera from scene if no interactive camera was set.
-		//
-		// FIXME: We should cache position of camera node, otherwise we have to iterate
-		// the full scenegraph to find the camera.
-		stage_get_camera( stage, 0, 0, float( extents.width ) / float( extents.height ),
-		                  &camera_world_matrix,
-		                  &camera_view_matrix,
-		                  &camera_projection_matrix );
+	if ( end - begin <= le_scene_bvh_o::MAX_ITEMS_PER_LEAF ) {
+		self->nodes[ node_idx ].first = begin;
+		self->nodes[ node_idx ].count = end - begin;
+		return;
 	}
 
-	glm::vec4 camera_in_world_space = camera_world_matrix * glm::vec4{ 0, 0, 0, 1 };
-	camera_in_world_space /= camera_in_world_space.w;
+	glm::vec3 const extent = centre_hi - centre_lo;
+	int const       axis   = extent.x > extent.y ? ( extent.x > extent.z ? 0 : 2 ) : ( extent.y > extent.z ? 1 : 2 );
+	uint32_t const  mid    = begin + ( end - begin ) / 2;
 
-	struct UboMatrices {
-		glm::mat4 viewProjectionMatrix; // (projection * view) matrix
-		glm::mat4 normalMatrix;         // given in world-space, which means normalmatrix does not depend on camera, but is transpose(inverse(globalMatrix))
-		glm::mat4 modelMatrix;
-		glm::vec3 camera_position; // camera position in world space
-	};
+	std::nth_element( self->items.begin() + begin, self->items.begin() + mid, self->items.begin() + end,
+	                  [ axis ]( le_scene_bvh_o::item_t const& lhs, le_scene_bvh_o::item_t const& rhs ) {
+		                  return lhs.min[ axis ] + lhs.max[ axis ] < rhs.min[ axis ] + rhs.max[ axis ];
+	                  } );
 
-	UboMatrices mvp_ubo;
-	mvp_ubo.viewProjectionMatrix = camera_projection_matrix * camera_view_matrix;
-	mvp_ubo.camera_position      = camera_in_world_space;
+	// Children are allocated as a pair, so that the right child always follows the left child.
+	uint32_t const left = uint32_t( self->nodes.size() );
+	self->nodes.resize( self->nodes.size() + 2 );
 
-	struct UboMaterialParams {
-		glm::vec4 base_color_factor{ 1, 1, 1, 1 }; // 4*4 = 16 byte alignment, which is largest alignment, and as such forms the struct's base alignment
-		float     metallic_factor{ 1 };            // 4 byte alignment, must be at mulitple of 4
-		float     roughness_factor{ 1 };           // 4 byte alignment, must be at multiple of 4
-	};
+	self->nodes[ node_idx ].first = left;
+	self->nodes[ node_idx ].count = 0;
 
-	// static_assert(offsetof(UboMaterialParams,metallic_factor)%sizeof(UboMaterialParams::metallic_factor)==0, "must be at offset which is multiple of its size.");
+	scene_bvh_build_subtree( self, left, begin, mid );
+	scene_bvh_build_subtree( self, left + 1, mid, end );
+}
 
-	UboMaterialParams material_params_ubo{};
+// ----------------------------------------------------------------------
+/// \brief Collect all mesh nodes for scene, and build hierarchy over those which have bounds.
+static void scene_bvh_build( le_scene_bvh_o* self, le_stage_o const* stage, uint8_t scene_id ) {
 
-	struct UboPostProcessing {
-		float exposure{ 1.f };
-	};
+	self->nodes.clear();
+	self->items.clear();
+	self->unbounded.clear();
 
-	UboPostProcessing post_processing_params{};
+	for ( le_node_o const* n : stage->nodes ) {
 
-	// We reserve pretty large amount of memory for joints data - so that we
-	// don't have to make allocations inside of the draw loop.
-	std::vector<glm::mat4> joints_data( 256 );
-	std::vector<glm::mat4> joints_normal_data( 256 );
+		if ( !n->has_mesh || 0 == ( n->scene_bit_flags & ( 1 << scene_id ) ) ) {
+			continue;
+		}
 
-	// if ( false )
-	for ( le_scene_o const& s : stage->scenes ) {
-		for ( le_node_o* n : stage->nodes ) {
+		// Skinned meshes are placed by their joints, which means that we can't know their bounds
+		// from their node's transform alone.
+		if ( n->skin || !stage->meshes[ n->mesh_idx ].has_bounds ) {
+			self->unbounded.push_back( n->idx );
+			continue;
+		}
 
-			if ( ( n->scene_bit_flags & ( 1 << s.scene_id ) ) && n->has_mesh ) {
+		le_scene_bvh_o::item_t item{};
+		item.node_idx = n->idx;
+		item.slot     = stage->transforms.slot_of_node[ n->idx ];
+		scene_bvh_item_update_bounds( &item, stage );
+		self->items.push_back( item );
+	}
 
-				uint32_t joints_count = n->skin ? uint32_t( n->skin->joints.size() ) : 0;
+	if ( !self->items.empty() ) {
+		self->nodes.reserve( 2 * self->items.size() / le_scene_bvh_o::MAX_ITEMS_PER_LEAF + 1 );
+		self->nodes.resize( 1 );
+		scene_bvh_build_subtree( self, 0, 0, uint32_t( self->items.size() ) );
+	}
 
-				if ( joints_count ) {
-					// Calculate joints matrices for all given joints.
-					//
-					// TODO: if skin has a skeleton, it should be possible to cache skin data -
-					// because it won't change based on what node it is associated to.
-					// A skin ideally only needs to be calculated once, and should be re-used.
-					//
-					// Q: What does GLTF specify must happen if a skin does not specify its skeleton property
-					// A: This is not really well defined.
-					//
-					glm::mat4 const& rootInv =
-					    n->skin->skeleton
-					        ? n->skin->skeleton->inverse_global_transform
-					        : n->inverse_global_transform;
-
-					for ( size_t i = 0; i != n->skin->joints.size(); i++ ) {
-						joints_data[ i ] =
-						    rootInv *
-						    n->skin->joints[ i ]->global_transform *
-						    n->skin->inverse_bind_matrices[ i ];
-					}
+	self->needs_build = false;
+}
 
-					// Calculate joints normals data - this is basically calculating the
-					// normal matrix for each of the world transform matrices in each joint.
-					for ( size_t i = 0; i != n->skin->joints.size(); i++ ) {
-						joints_normal_data[ i ] = transpose( inverse( joints_data[ i ] ) );
-					}
-				}
+// ----------------------------------------------------------------------
+/// \brief Update bounds for items which moved, then update bounds for all bvh nodes, bottom-up.
+/// Hierarchy stays the same - which is fine as long as nodes don't move too far from where
+/// they were when the hierarchy was built.
+static void scene_bvh_refit( le_scene_bvh_o* self, le_stage_o const* stage ) {
 
-				auto const& mesh = stage->meshes[ n->mesh_idx ];
-				for ( auto const& primitive : mesh.primitives ) {
+	le_transform_hierarchy_o const& transforms = stage->transforms;
 
-					if ( !primitive.pipeline_state_handle ) {
-						logger.error( "missing pipeline state object for primitive - did you call setup_pipelines on the stage after adding the mesh/primitive?" );
-						continue;
-					}
+	bool any_changed = false;
 
-					mvp_ubo.modelMatrix  = n->global_transform;
-					mvp_ubo.normalMatrix = glm::transpose( n->inverse_global_transform );
+	for ( auto& node : self->nodes ) {
 
-					encoder
-					    .bindGraphicsPipeline( primitive.pipeline_state_handle )
-					    .setArgumentData( LE_ARGUMENT_NAME( "LightSSBO" ), s.lights.data(), sizeof( le_light_o ) * s.lights.size() )
-					    .setArgumentData( LE_ARGUMENT_NAME( "UboMatrices" ), &mvp_ubo, sizeof( UboMatrices ) )
-					    .setViewports( 0, 1, &viewports[ 0 ] );
+		if ( node.count == 0 ) {
+			continue;
+		}
 
-					if ( primitive.num_joints_sets && joints_count ) {
-						// we must apply joints matrices.
-						encoder.setArgumentData( LE_ARGUMENT_NAME( "UboJointMatrices" ), joints_data.data(), sizeof( glm::mat4 ) * joints_count );
-						encoder.setArgumentData( LE_ARGUMENT_NAME( "UboJointNormalMatrices" ), joints_normal_data.data(), sizeof( glm::mat4 ) * joints_count );
-					}
+		bool changed = false;
 
-					if ( primitive.morph_target_count > 0 ) {
+		for ( uint32_t i = node.first; i != node.first + node.count; i++ ) {
+			auto& item = self->items[ i ];
+			if ( transforms.global_dirty[ item.slot ] ) {
+				scene_bvh_item_update_bounds( &item, stage );
+				changed = true;
+			}
+		}
 
-						// This primitive has morph targets - we must upload the current weigths for the morph targets.
-						//
-						// NOTE: We upload the morph target weights tightly packed -
-						// this means the shader will receive them as vec4s, which
-						// every 4 floats (if available) grouped together into one vec4.
-						encoder.setArgumentData( LE_ARGUMENT_NAME( "UboMorphTargetWeights" ), n->morph_target_weights,
-						                         sizeof( glm::vec4 ) * ( ( primitive.morph_target_count + 3 ) / 4 ) );
-
-						if ( false ) {
-							std::ostringstream os;
-							os << "weights: " << std::dec;
-							for ( auto i = 0; i != primitive.morph_target_count; i++ ) {
-								os << std::setw( 8 ) << n->morph_target_weights[ i ] << ", ";
-							}
-							logger.info( os.str().c_str() );
-						}
-					}
+		if ( changed ) {
+			node.min = self->items[ node.first ].min;
+			node.max = self->items[ node.first ].max;
+			for ( uint32_t i = node.first + 1; i != node.first + node.count; i++ ) {
+				node.min = glm::min( node.min, self->items[ i ].min );
+				node.max = glm::max( node.max, self->items[ i ].max );
+			}
+			any_changed = true;
+		}
+	}
 
-					if ( primitive.has_material ) {
+	if ( !any_changed ) {
+		return;
+	}
 
-						auto const& material = stage->materials[ primitive.material_idx ];
+	// Children always come after their parent: iterating backwards, children are up to date by the time we reach their parent.
+	for ( size_t i = self->nodes.size(); i-- != 0; ) {
+		auto& node = self->nodes[ i ];
+		if ( node.count == 0 ) {
+			node.min = glm::min( self->nodes[ node.first ].min, self->nodes[ node.first + 1 ].min );
+			node.max = glm::max( self->nodes[ node.first ].max, self->nodes[ node.first + 1 ].max );
+		}
+	}
+}
 
-						{
-							// bind all textures
-							uint32_t tex_id = 0;
-							for ( auto const& tex : material.texture_handles ) {
-								encoder.setArgumentTexture( LE_ARGUMENT_NAME( "src_tex_unit" ), tex, tex_id++ );
-							}
-						}
+// ----------------------------------------------------------------------
 
-						if ( !material.cached_texture_params.empty() ) {
-							// has cached texture parameters
-							encoder.setArgumentData( LE_ARGUMENT_NAME( "UboTextureParams" ),
-							                         material.cached_texture_params.data(),
-							                         sizeof( le_material_o::UboTextureParamsSlice ) * material.cached_texture_params.size() );
-						}
+static void scene_bvh_update( le_scene_bvh_o* self, le_stage_o const* stage, uint8_t scene_id ) {
+	if ( self->needs_build ) {
+		scene_bvh_build( self, stage, scene_id );
+	} else if ( stage->transforms.has_global_changes ) {
+		scene_bvh_refit( self, stage );
+	}
+}
 
-						if ( material.metallic_roughness ) {
-							auto&       mr         = material.metallic_roughness;
-							auto const& base_color = mr->base_color_factor;
+// ----------------------------------------------------------------------
 
-							material_params_ubo.base_color_factor =
-							    glm::vec4( base_color[ 0 ],
-							               base_color[ 1 ],
-							               base_color[ 2 ],
-							               base_color[ 3 ] );
+// Frustum planes, in SoA layout, so that we can test an axis-aligned box against
+// four planes at a time. There are six planes - planes 6, and 7 always pass.
+struct le_frustum_t {
+	alignas( 16 ) float nx[ 8 ]; // plane normal
+	alignas( 16 ) float ny[ 8 ]; //
+	alignas( 16 ) float nz[ 8 ]; //
+	alignas( 16 ) float d[ 8 ];  // plane distance
+	alignas( 16 ) float ax[ 8 ]; // absolute value of plane normal
+	alignas( 16 ) float ay[ 8 ]; //
+	alignas( 16 ) float az[ 8 ]; //
+};
 
-							material_params_ubo.metallic_factor  = mr->metallic_factor;
-							material_params_ubo.roughness_factor = mr->roughness_factor;
+/// \brief Extract frustum planes from a (projection * view) matrix. Planes point inwards,
+/// and follow Vulkan clip space conventions: depth goes from 0 to 1.
+static void frustum_from_view_projection( le_frustum_t* self, glm::mat4 const& m ) {
+
+	glm::vec4 const row_0 = { m[ 0 ][ 0 ], m[ 1 ][ 0 ], m[ 2 ][ 0 ], m[ 3 ][ 0 ] };
+	glm::vec4 const row_1 = { m[ 0 ][ 1 ], m[ 1 ][ 1 ], m[ 2 ][ 1 ], m[ 3 ][ 1 ] };
+	glm::vec4 const row_2 = { m[ 0 ][ 2 ], m[ 1 ][ 2 ], m[ 2 ][ 2 ], m[ 3 ][ 2 ] };
+	glm::vec4 const row_3 = { m[ 0 ][ 3 ], m[ 1 ][ 3 ], m[ 2 ][ 3 ], m[ 3 ][ 3 ] };
+
+	glm::vec4 const planes[ 8 ] = {
+	    row_3 + row_0,  // left
+	    row_3 - row_0,  // right
+	    row_3 + row_1,  // bottom
+	    row_3 - row_1,  // top
+	    row_2,          // near
+	    row_3 - row_2,  // far
+	    { 0, 0, 0, 1 }, // padding: always passes
+	    { 0, 0, 0, 1 }, // padding: always passes
+	};
 
-							encoder.setArgumentData( LE_ARGUMENT_NAME( "UboMaterialParams" ),
-							                         &material_params_ubo, sizeof( UboMaterialParams ) );
-						}
-					}
+	for ( int i = 0; i != 8; i++ ) {
+		self->nx[ i ] = planes[ i ].x;
+		self->ny[ i ] = planes[ i ].y;
+		self->nz[ i ] = planes[ i ].z;
+		self->d[ i ]  = planes[ i ].w;
+		self->ax[ i ] = fabsf( planes[ i ].x );
+		self->ay[ i ] = fabsf( planes[ i ].y );
+		self->az[ i ] = fabsf( planes[ i ].z );
+	}
+}
 
-					encoder.setArgumentData( LE_ARGUMENT_NAME( "UboPostProcessing" ),
-					                         &post_processing_params, sizeof( UboPostProcessing ) );
+enum class FrustumTestResult : int {
+	eOutside = 0,
+	eIntersecting,
+	eInside,
+};
 
-					// ---- invariant: primitive has pipeline, bindings.
+/// \brief Test axis-aligned box against all frustum planes.
+static inline FrustumTestResult frustum_test_aabb( le_frustum_t const& f, glm::vec3 const& lo, glm::vec3 const& hi ) {
 
-					encoder.bindVertexBuffers( 0, uint32_t( primitive.bindings_buffer_handles.size() ),
-					                           primitive.bindings_buffer_handles.data(),
-					                           primitive.bindings_buffer_offsets.data() );
+	// For each plane, signed distance of box centre, and projected radius of box onto plane normal.
+	// Box is outside if it lies fully behind any plane; inside if it lies fully in front of all planes.
 
-					if ( primitive.has_indices ) {
+	glm::vec3 const c = ( lo + hi ) * 0.5f;
+	glm::vec3 const e = ( hi - lo ) * 0.5f;
 
-						auto& indices_accessor = stage->accessors[ primitive.indices_accessor_idx ];
-						auto& buffer_view      = stage->buffer_views[ indices_accessor.buffer_view_idx ];
-						auto& buffer           = stage->buffers[ buffer_view.buffer_idx ];
+#if defined( __SSE2__ ) || defined( _M_X64 )
+	__m128 const cx = _mm_set1_ps( c.x ), cy = _mm_set1_ps( c.y ), cz = _mm_set1_ps( c.z );
+	__m128 const ex = _mm_set1_ps( e.x ), ey = _mm_set1_ps( e.y ), ez = _mm_set1_ps( e.z );
+	__m128 const zero = _mm_setzero_ps();
 
-						encoder.bindIndexBuffer( buffer->handle,
-						                         buffer_view.byte_offset,
-						                         index_type_from_num_type( indices_accessor.component_type ) );
+	int outside      = 0;
+	int intersecting = 0;
 
-						encoder.drawIndexed( primitive.index_count );
-					} else {
+	for ( int i = 0; i != 8; i += 4 ) {
+		__m128 dist = _mm_add_ps( _mm_add_ps( _mm_mul_ps( _mm_load_ps( f.nx + i ), cx ), _mm_mul_ps( _mm_load_ps( f.ny + i ), cy ) ),
+		                          _mm_add_ps( _mm_mul_ps( _mm_load_ps( f.nz + i ), cz ), _mm_load_ps( f.d + i ) ) );
+		__m128 radius = _mm_add_ps( _mm_add_ps( _mm_mul_ps( _mm_load_ps( f.ax + i ), ex ), _mm_mul_ps( _mm_load_ps( f.ay + i ), ey ) ),
+		                            _mm_mul_ps( _mm_load_ps( f.az + i ), ez ) );
 
-						encoder.draw( primitive.vertex_count );
-					}
+		outside |= _mm_movemask_ps( _mm_cmplt_ps( _mm_add_ps( dist, radius ), zero ) );
+		intersecting |= _mm_movemask_ps( _mm_cmplt_ps( _mm_sub_ps( dist, radius ), zero ) );
+	}
 
-				} // end for all mesh.primitives
-			}
+	return outside ? FrustumTestResult::eOutside : intersecting ? FrustumTestResult::eIntersecting
+	                                                             : FrustumTestResult::eInside;
+#else
+	FrustumTestResult result = FrustumTestResult::eInside;
+
+	for ( int i = 0; i != 6; i++ ) {
+		float const dist   = f.nx[ i ] * c.x + f.ny[ i ] * c.y + f.nz[ i ] * c.z + f.d[ i ];
+		float const radius = f.ax[ i ] * e.x + f.ay[ i ] * e.y + f.az[ i ] * e.z;
+		if ( dist + radius < 0 ) {
+			return FrustumTestResult::eOutside;
+		}
+		if ( dist - radius < 0 ) {
+			result = FrustumTestResult::eIntersecting;
 		}
 	}
+
+	return result;
+#endif
 }
 
 // ----------------------------------------------------------------------
+/// \brief Append indices of all nodes in bvh which are at least partially inside frustum to `visible`.
+/// Subtrees which are fully inside the frustum are accepted without further tests.
+static void scene_bvh_cull( le_scene_bvh_o const* self, le_frustum_t const& frustum, std::vector<uint32_t>& visible ) {
 
-/// \brief add setup and execute callbacks to rendermodule so that rendermodule
-/// knows which resources are needed to render the stage.
-/// There are two resource types which potentially need uploading: buffers,
-/// and images.
-static void le_stage_draw_into_render_module( le_stage_api::draw_params_t* draw_params, le_rendergraph_o* module, le_img_resource_handle color_attachment_image, le_img_resource_handle depth_stencil_attachment_image ) {
-
-	using namespace le_renderer;
+	if ( self->nodes.empty() ) {
+		return;
+	}
 
-#ifdef LE_FEATURE_RTX
+	struct stack_entry_t {
+		uint32_t node;
+		bool     is_inside; // whether parent was fully inside frustum
+	};
 
-	{
+	stack_entry_t stack[ 64 ];
+	uint32_t      stack_size = 0;
 
-		auto rtx_pass =
-		    le::RenderPass( "Stage Rtx", le::QueueFlagBits::eCompute )
-		        .setExecuteCallback( draw_params, []( le_command_buffer_encoder_o* encoder_, void* user_data ) {
-			        auto draw_params = static_cast<le_stage_api::draw_params_t*>( user_data );
-			        auto camera      = draw_params->camera;
-			        auto stage       = draw_params->stage;
-			        auto encoder     = le::Encoder{ encoder_ };
+	stack[ stack_size++ ] = { 0, false };
 
-			        auto extents = encoder.getRenderpassExtent();
+	while ( stack_size ) {
 
-			        le::Viewport viewports[ 2 ] = {
-			            { 0.f, float( extents.height ), float( extents.width ), -float( extents.height ), -0.f, 1.f }, // negative viewport means to flip y axis in screen space
-			            { 0.f, 0.f, float( extents.width ), float( extents.height ), 0.f, 1.f },
-			        };
+		stack_entry_t const entry = stack[ --stack_size ];
 
-			        // we set projection matrix and view matrix to somehow sensible defaults.
-			        glm::mat4 camera_projection_matrix = glm::ortho( -0.5f, 0.5f, -0.5f, 0.5f, -1000.f, 1000.f );
-			        glm::mat4 camera_view_matrix       = glm::identity<glm::mat4>();
-			        glm::mat4 camera_world_matrix      = glm::identity<glm::mat4>(); // global transform for camera node (==inverse view matrix)
+		auto const& node = self->nodes[ entry.node ];
 
-			        // update camera from interactive camera
-			        // if no stage camera is given, and an interactive camera is available
-			        if ( camera ) {
+		FrustumTestResult result = entry.is_inside ? FrustumTestResult::eInside : frustum_test_aabb( frustum, node.min, node.max );
 
-				        using namespace le_camera;
-				        le_camera_i.set_viewport( camera, viewports[ 0 ] );
-				        le_camera_i.get_view_matrix( camera, &camera_view_matrix[ 0 ][ 0 ] );
-				        le_camera_i.get_projection_matrix( camera, &camera_projection_matrix[ 0 ][ 0 ] );
-				        camera_world_matrix = glm::inverse( camera_view_matrix );
-			        }
+		if ( result == FrustumTestResult::eOutside ) {
+			continue;
+		}
 
-			        auto pipeline_manager = encoder.getPipelineManager();
+		if ( node.count ) {
+			for ( uint32_t i = node.first; i != node.first + node.count; i++ ) {
+				auto const& item = self->items[ i ];
+				if ( result == FrustumTestResult::eInside ||
+				     frustum_test_aabb( frustum, item.min, item.max ) != FrustumTestResult::eOutside ) {
+					visible.push_back( item.node_idx );
+				}
+			}
+			continue;
+		}
 
-			        // -- Create rtx pso
-			        static le_rtxpso_handle rtx_pipeline = []( le_stage_o* stage, le_pipeline_manager_o* pipeline_manager ) {
-				        auto shader_raygen      = LeShaderModuleBuilder( pipeline_manager ).setSourceFilePath( "./resources/shaders/le_stage/rtx/raygen.rgen" ).setShaderStage( le::ShaderStage::eRaygenBitKhr ).build();
-				        auto shader_closest_hit = LeShaderModuleBuilder( pipeline_manager ).setSourceFilePath( "./resources/shaders/le_stage/rtx/closesthit.rchit" ).setShaderStage( le::ShaderStage::eClosestHitBitKhr ).build();
-				        auto shader_miss        = LeShaderModuleBuilder( pipeline_manager ).setSourceFilePath( "./resources/shaders/le_stage/rtx/miss.rmiss" ).setShaderStage( le::ShaderStage::eMissBitKhr ).build();
-				        auto shader_shadow_miss = LeShaderModuleBuilder( pipeline_manager ).setSourceFilePath( "./resources/shaders/le_stage/rtx/shadow.rmiss" ).setShaderStage( le::ShaderStage::eMissBitKhr ).build();
+		bool const is_inside = ( result == FrustumTestResult::eInside );
 
-				        // Create rtx pipeline
+		// Median splits keep the tree balanced, so its depth stays well below the stack size.
+		assert( stack_size + 2 <= sizeof( stack ) / sizeof( stack[ 0 ] ) );
 
-				        LeRtxPipelineBuilder builder( pipeline_manager );
+		stack[ stack_size++ ] = { node.first + 1, is_inside };
+		stack[ stack_size++ ] = { node.first, is_inside };
+	}
+}
 
-				        // add shader groups.
-				        builder
-				            .setShaderGroupRayGen( shader_raygen )                    // shader group handle: ray_gen 0
-				            .addShaderGroupTriangleHit( shader_closest_hit, nullptr ) // shader group handle: hit 0
-				            .addShaderGroupMiss( shader_miss )                        // shader group handle: miss 0
-				            .addShaderGroupMiss( shader_shadow_miss )                 // shader group handle: miss 1
-				            ;
+// ----------------------------------------------------------------------
 
-				        return builder.build();
-			        }( stage, pipeline_manager );
+// Whether a primitive may be drawn as one of many instances: this is only possible
+// if it needs no per-node data other than its transform.
+static inline bool primitive_is_instanceable( le_primitive_o const& primitive, le_node_o const* n ) {
+	return !( primitive.num_joints_sets && n->skin ) && primitive.morph_target_count == 0;
+}
 
-			        // At this point we should be able to build the shader binding table for the pipeline.
-			        // The SBT is basically a sequence of:
-			        // 1 RayGen Group
-			        // 1+ Hit Groups
-			        // 1+ Miss Groups
-			        // Each group may have parameters
+static inline bool stage_draw_items_can_share_draw( stage_draw_item_t const& lhs, stage_draw_item_t const& rhs ) {
+	return rhs.is_instanceable &&
+	       lhs.pipeline == rhs.pipeline &&
+	       lhs.material_idx == rhs.material_idx &&
+	       lhs.mesh_idx == rhs.mesh_idx &&
+	       lhs.primitive_idx == rhs.primitive_idx;
+}
 
-			        // Shader binding table is built on encoder - this way we can use the encoder's scratch GPU memory
-			        // as SBT memory. SBT is rebuilt every frame.
+// ----------------------------------------------------------------------
+/// \brief Collect primitives for all visible nodes, sorted by pipeline, then material, then mesh,
+/// so that we change state as rarely as possible, and so that draws of the same primitive
+/// with the same material end up next to each other, where they can be merged into one
+/// instanced draw. If `skip_instanceable` is set, only primitives which can't be instanced are collected.
+static void stage_build_draw_list( le_stage_o const* stage, std::vector<uint32_t> const& visible_nodes, bool skip_instanceable, std::vector<stage_draw_item_t>& items ) {
 
-			        le_shader_binding_table_o* sbt =
-			            le::Encoder::ShaderBindingTableBuilder( encoder, rtx_pipeline )
-			                .setRayGenIdx( 0 )
-			                .addHitIdx( 1 )
-			                .addMissIdx( 2 )
-			                .addMissIdx( 3 )
-			                .build();
+	static auto logger = LeLog( LOGGER_LABEL );
 
-			        // shader_binding_table_o* already contains a reference to pipeline,
-			        // which means pipeline does not need to be referenced again.
-			        encoder.bindRtxPipeline( sbt );
+	items.clear();
 
-			        // -- set ray tracing arguments
+	for ( uint32_t node_idx : visible_nodes ) {
 
-			        struct CameraPropertiesUBO {
-				        glm::mat4 viewInverse;
-				        glm::mat4 projectionInverse;
-				        glm::vec4 lightPos; // world coords
-			        };
+		le_node_o const* n    = stage->nodes[ node_idx ];
+		le_mesh_o const& mesh = stage->meshes[ n->mesh_idx ];
 
-			        CameraPropertiesUBO camera_properties;
-			        camera_properties.viewInverse       = camera_world_matrix;
-			        camera_properties.projectionInverse = glm::inverse( camera_projection_matrix );
+		for ( uint32_t p = 0; p != mesh.primitives.size(); p++ ) {
 
-			        if ( stage->scenes.empty() ) {
-				        return;
-			        }
+			le_primitive_o const& primitive = mesh.primitives[ p ];
 
-			        if ( !stage->scenes.front().lights.empty() ) {
-				        camera_properties.lightPos = glm::vec4( stage->scenes.front().lights.front().position, 1 );
-			        } else {
-				        camera_properties.lightPos = glm::vec4{ 3, 10, 4, 1 }; // arbitrary fallback defaults.
-			        }
+			if ( !primitive.pipeline_state_handle ) {
+				logger.error( "missing pipeline state object for primitive - did you call setup_pipelines on the stage after adding the mesh/primitive?" );
+				continue;
+			}
 
-			        // -- call trace rays
+			bool const is_instanceable = primitive_is_instanceable( primitive, n );
 
-			        encoder.setArgumentData( LE_ARGUMENT_NAME( "CameraProperties" ), &camera_properties, sizeof( CameraPropertiesUBO ) );
-			        encoder.setArgumentTlas( LE_ARGUMENT_NAME( "topLevelAS" ), stage->scenes.front().rtx_tlas_handle );
-			        encoder.setArgumentImage( LE_ARGUMENT_NAME( "image" ), RTX_IMAGE_TARGET_HANDLE );
+			if ( skip_instanceable && is_instanceable ) {
+				continue;
+			}
 
-			        encoder.traceRays( extents.width, extents.height );
-		        } ) //
-		    ;
+			stage_draw_item_t item;
+			item.pipeline        = primitive.pipeline_state_handle;
+			item.material_idx    = primitive.has_material ? primitive.material_idx : ~0u;
+			item.mesh_idx        = n->mesh_idx;
+			item.primitive_idx   = p;
+			item.node_idx        = node_idx;
+			item.is_instanceable = is_instanceable;
 
-		{
+			items.push_back( item );
+		}
+	}
 
-			// -- Signal that we want to use an image to write to.
+	std::sort( items.begin(), items.end(), []( stage_draw_item_t const& lhs, stage_draw_item_t const& rhs ) {
+		return lhs.pipeline != rhs.pipeline           ? std::less<le_gpso_handle>()( lhs.pipeline, rhs.pipeline )
+		       : lhs.material_idx != rhs.material_idx ? lhs.material_idx < rhs.material_idx
+		       : lhs.mesh_idx != rhs.mesh_idx         ? lhs.mesh_idx < rhs.mesh_idx
+		       : lhs.primitive_idx != rhs.primitive_idx
+		           ? lhs.primitive_idx < rhs.primitive_idx
+		           : lhs.node_idx < rhs.node_idx;
+	} );
+}
 
-			rtx_pass
-			    .useImageResource( RTX_IMAGE_TARGET_HANDLE, le::ImageUsageFlags( le::ImageUsageFlagBits::eStorage ) ); // write
+// ----------------------------------------------------------------------
+/// \brief Calculate view projection matrix, and camera position in world space for drawing into
+/// `viewport`: using the interactive camera if one was given, otherwise the first camera in the stage.
+static void stage_get_view_projection( le_stage_o const* stage, le_camera_o* camera, le::Viewport const& viewport, glm::mat4* view_projection, glm::vec3* camera_position ) {
 
-			le_resource_info_t rtx_target_info =
-			    le::ImageInfoBuilder()
-			        .setFormat( le::Format::eR8Unorm ) // 1 byte per cell, 1024x1024 cells
-			        .addUsageFlags( le::ImageUsageFlagBits::eStorage | le::ImageUsageFlagBits::eSampled )
-			        .build();
+	// we set projection matrix and view matrix to somehow sensible defaults.
+	glm::mat4 camera_projection_matrix = glm::ortho( -0.5f, 0.5f, -0.5f, 0.5f, -1000.f, 1000.f );
+	glm::mat4 camera_view_matrix       = glm::identity<glm::mat4>();
+	glm::mat4 camera_world_matrix      = glm::identity<glm::mat4>(); // global transform for camera node (==inverse view matrix)
 
-			rendergraph_i.declare_resource( module, RTX_IMAGE_TARGET_HANDLE, rtx_target_info );
+	// update camera from interactive camera
+	// if no stage camera is given, and an interactive camera is available
+	if ( camera ) {
 
-			// -- Signal that we want to read from bottom-level acceleration structures.
+		using namespace le_camera;
+		le_camera_i.set_viewport( camera, viewport );
+		le_camera_i.get_view_matrix( camera, ( float* )( &camera_view_matrix ) );
+		le_camera_i.get_projection_matrix( camera, ( float* )( &camera_projection_matrix ) );
+		camera_world_matrix = glm::inverse( camera_view_matrix );
+	} else {
+		// Attempt to apply first camera from scene if no interactive camera was set.
+		//
+		// FIXME: We should cache position of camera node, otherwise we have to iterate
+		// the full scenegraph to find the camera.
+		stage_get_camera( stage, 0, 0, fabsf( viewport.width / viewport.height ),
+		                  &camera_world_matrix,
+		                  &camera_view_matrix,
+		                  &camera_projection_matrix );
+	}
 
-			for ( auto const& m : draw_params->stage->meshes ) {
-				for ( auto const& p : m.primitives ) {
-					rtx_pass.useRtxBlasResource( p.rtx_blas_handle );
-				}
-			}
+	glm::vec4 camera_in_world_space = camera_world_matrix * glm::vec4{ 0, 0, 0, 1 };
+	camera_in_world_space /= camera_in_world_space.w;
 
-			// -- Signal that we want to read from top-level acceleration structures.
+	*view_projection = camera_projection_matrix * camera_view_matrix;
+	*camera_position = camera_in_world_space;
+}
 
-			for ( auto const& s : draw_params->stage->scenes ) {
-				rtx_pass.useRtxTlasResource( s.rtx_tlas_handle );
-			}
-		}
+// ----------------------------------------------------------------------
+/// \brief Extent which we expect the draw pass to have: the extent of the most recent draw pass,
+/// or, before we have drawn, the extent of the renderer's first swapchain. Returns false if unknown.
+static bool stage_get_draw_extent( le_stage_o const* stage, le::Extent2D* extent ) {
 
-		rendergraph_i.add_renderpass( module, rtx_pass );
+	if ( stage->draw_extent.width && stage->draw_extent.height ) {
+		*extent = stage->draw_extent;
+		return true;
 	}
 
-#endif
+	using namespace le_renderer;
 
-	auto stage_draw_pass =
+	uint32_t width  = 0;
+	uint32_t height = 0;
+
+	if ( stage->renderer && renderer_i.get_swapchain_extent( stage->renderer, nullptr, &width, &height ) && width && height ) {
+		*extent = { width, height };
+		return true;
+	}
+
+	return false;
+}
+
+// ----------------------------------------------------------------------
+/// \brief Cull gpu-drawn instances against the camera frustum, and write draw commands for visible instances.
+static void pass_gpu_cull( le_command_buffer_encoder_o* encoder_, void* user_data ) {
+	auto  draw_params = static_cast<le_stage_api::draw_params_t*>( user_data );
+	auto  stage       = draw_params->stage;
+	auto  encoder     = le::ComputeEncoder{ encoder_ };
+	auto& gpu_draws   = stage->gpu_draws;
+
+	// Layout must match `CullParams` in cull_instances.comp
+	struct CullParams {
+		glm::vec4 frustum_planes[ 6 ]; // world-space, pointing inwards
+		uint32_t  instance_count;
+		uint32_t  counts_offset;  // index of first draw count in draw commands
+		uint32_t  command_stride; // number of uint per draw command
+	};
+
+	CullParams params{};
+
+	params.instance_count = uint32_t( gpu_draws.instances.size() );
+	params.counts_offset  = le_gpu_draws_o::COMMAND_STRIDE * uint32_t( gpu_draws.groups.size() );
+	params.command_stride = le_gpu_draws_o::COMMAND_STRIDE;
+
+	le::Extent2D extent;
+
+	if ( stage_get_draw_extent( stage, &extent ) ) {
+
+		// We use the same viewport as the draw pass, so that the frustum matches the draw pass's frustum.
+		le::Viewport const viewport = { 0.f, float( extent.height ), float( extent.width ), -float( extent.height ), -0.f, 1.f };
+
+		glm::mat4 view_projection;
+		glm::vec3 camera_position;
+		stage_get_view_projection( stage, draw_params->camera, viewport, &view_projection, &camera_position );
+
+		le_frustum_t frustum;
+		frustum_from_view_projection( &frustum, view_projection );
+
+		for ( int i = 0; i != 6; i++ ) {
+			params.frustum_planes[ i ] = { frustum.nx[ i ], frustum.ny[ i ], frustum.nz[ i ], frustum.d[ i ] };
+		}
+	} else {
+		// We don't know the extent of the draw pass, and therefore the frustum: planes which always pass mean not to cull.
+		for ( auto& plane : params.frustum_planes ) {
+			plane = { 0, 0, 0, 1 };
+		}
+	}
+
+	encoder
+	    .bufferMemoryBarrier( le::PipelineStageFlagBits2::eTransfer,
+	                          le::PipelineStageFlagBits2::eComputeShader,
+	                          le::AccessFlagBits2::eShaderStorageRead | le::AccessFlagBits2::eShaderStorageWrite,
+	                          gpu_draws.commands_handle )
+	    .bufferMemoryBarrier( le::PipelineStageFlagBits2::eTransfer,
+	                          le::PipelineStageFlagBits2::eComputeShader,
+	                          le::AccessFlagBits2::eShaderStorageRead,
+	                          gpu_draws.transforms_handle )
+	    .bufferMemoryBarrier( le::PipelineStageFlagBits2::eTransfer,
+	                          le::PipelineStageFlagBits2::eComputeShader,
+	                          le::AccessFlagBits2::eShaderStorageRead,
+	                          gpu_draws.instances_handle )
+	    .bindComputePipeline( gpu_draws.cull_pipeline )
+	    .setArgumentData( LE_ARGUMENT_NAME( "CullParams" ), &params, sizeof( CullParams ) )
+	    .bindArgumentBuffer( LE_ARGUMENT_NAME( "Instances" ), gpu_draws.instances_handle )
+	    .bindArgumentBuffer( LE_ARGUMENT_NAME( "InstanceTransforms" ), gpu_draws.transforms_handle )
+	    .bindArgumentBuffer( LE_ARGUMENT_NAME( "VisibleTransforms" ), gpu_draws.visible_transforms_handle )
+	    .bindArgumentBuffer( LE_ARGUMENT_NAME( "DrawCommands" ), gpu_draws.commands_handle )
+	    .dispatch( ( params.instance_count + 63 ) / 64 )
+	    .bufferMemoryBarrier( le::PipelineStageFlagBits2::eComputeShader,
+	                          le::PipelineStageFlagBits2::eDrawIndirect,
+	                          le::AccessFlagBits2::eIndirectCommandRead,
+	                          gpu_draws.commands_handle )
+	    .bufferMemoryBarrier( le::PipelineStageFlagBits2::eComputeShader,
+	                          le::PipelineStageFlagBits2::eVertexShader,
+	                          le::AccessFlagBits2::eShaderStorageRead,
+	                          gpu_draws.visible_transforms_handle );
+}
+
+// ----------------------------------------------------------------------
+/// \brief Cull mesh nodes of each scene against the camera frustum, then build draw lists, and instance
+/// transforms for visible primitives which we draw from the CPU. If `skip_instanceable` is set,
+/// instanceable primitives are left to gpu-driven drawing. Grows the transforms storage buffer if needed.
+static void cpu_draws_build( le_cpu_draws_o* self, le_stage_o* stage, le_camera_o* camera, bool skip_instanceable ) {
+
+	le::Extent2D extent;
+	bool const   can_cull = stage_get_draw_extent( stage, &extent );
+
+	le_frustum_t frustum;
+
+	if ( can_cull ) {
+		// We use the same viewport as the draw pass, so that the frustum matches the draw pass's frustum.
+		le::Viewport const viewport = { 0.f, float( extent.height ), float( extent.width ), -float( extent.height ), -0.f, 1.f };
+
+		glm::mat4 view_projection;
+		glm::vec3 camera_position;
+		stage_get_view_projection( stage, camera, viewport, &view_projection, &camera_position );
+		frustum_from_view_projection( &frustum, view_projection );
+	}
+
+	self->scene_draws.resize( stage->scenes.size() );
+	self->transforms.clear();
+
+	for ( uint32_t scene_idx = 0; scene_idx != stage->scenes.size(); scene_idx++ ) {
+
+		le_scene_o const& s = stage->scenes[ scene_idx ];
+
+		// -- Find mesh nodes in this scene which are at least partially inside the camera frustum.
+
+		auto& visible_nodes = self->visible_nodes;
+		visible_nodes.clear();
+
+		if ( s.bvh.needs_build || !can_cull ) {
+			// Stage was not updated since scene changed, or we don't know the frustum yet:
+			// we can't cull, and must draw all mesh nodes.
+			for ( le_node_o const* n : stage->nodes ) {
+				if ( ( n->scene_bit_flags & ( 1 << s.scene_id ) ) && n->has_mesh ) {
+					visible_nodes.push_back( n->idx );
+				}
+			}
+		} else {
+			visible_nodes.insert( visible_nodes.end(), s.bvh.unbounded.begin(), s.bvh.unbounded.end() );
+			scene_bvh_cull( &s.bvh, frustum, visible_nodes );
+
+			stage->draw_stats.num_nodes_culled += uint32_t( s.bvh.items.size() + s.bvh.unbounded.size() - visible_nodes.size() );
+		}
+
+		stage->draw_stats.num_nodes_visible += uint32_t( visible_nodes.size() );
+
+		// -- Build draw list: one item per visible primitive, sorted so that primitives
+		// which share pipeline, material, and mesh are next to each other.
+
+		auto& scene_draws = self->scene_draws[ scene_idx ];
+
+		stage_build_draw_list( stage, visible_nodes, skip_instanceable, scene_draws.items );
+
+		stage->draw_stats.num_primitives += uint32_t( scene_draws.items.size() );
+
+		// -- Instance transforms, in draw list order.
+
+		scene_draws.first_transform = uint32_t( self->transforms.size() );
+
+		for ( stage_draw_item_t const& item : scene_draws.items ) {
+			le_node_o const* n = stage->nodes[ item.node_idx ];
+			self->transforms.push_back( { node_get_global_transform( stage, n ),
+			                              glm::transpose( node_get_inverse_global_transform( stage, n ) ) } );
+		}
+	}
+
+	if ( self->transforms.size() > self->capacity ) {
+
+		// Grow by powers of two, so that the renderer must rarely re-allocate the buffer.
+		uint32_t capacity = std::max<uint32_t>( self->capacity, 64 );
+		while ( capacity < self->transforms.size() ) {
+			capacity *= 2;
+		}
+
+		self->capacity      = capacity;
+		self->handle        = LE_BUF_RESOURCE( "le_stage_instance_transforms" );
+		self->resource_info = le::BufferInfoBuilder()
+		                          .setSize( uint32_t( sizeof( le_instance_transform_t ) * capacity ) )
+		                          .addUsageFlags( le::BufferUsageFlagBits::eTransferDst | le::BufferUsageFlagBits::eStorageBuffer )
+		                          .build();
+	}
+}
+
+// ----------------------------------------------------------------------
+
+static void pass_draw( le_command_buffer_encoder_o* encoder_, void* user_data ) {
+	auto draw_params = static_cast<le_stage_api::draw_params_t*>( user_data );
+	auto camera      = draw_params->camera;
+	auto stage       = draw_params->stage;
+	auto encoder     = le::Encoder{ encoder_ };
+
+	static auto logger  = LeLog( LOGGER_LABEL );
+	auto        extents = encoder.getRenderpassExtent();
+
+	le::Viewport viewports[ 2 ] = {
+	    { 0.f, float( extents.height ), float( extents.width ), -float( extents.height ), -0.f, 1.f }, // negative viewport means to flip y axis in screen space
+	    { 0.f, 0.f, float( extents.width ), float( extents.height ), 0.f, 1.f },
+	};
+
+	struct UboMatrices {
+		glm::mat4 viewProjectionMatrix; // (projection * view) matrix
+		glm::vec3 camera_position;      // camera position in world space
+	};
+
+	UboMatrices mvp_ubo;
+	stage_get_view_projection( stage, camera, viewports[ 0 ], &mvp_ubo.viewProjectionMatrix, &mvp_ubo.camera_position );
+
+	// Compute passes, and render module setup don't know our extent - we remember it so that
+	// culling may calculate a frustum.
+	stage->draw_extent = extents;
+
+	struct UboMaterialParams {
+		glm::vec4 base_color_factor{ 1, 1, 1, 1 }; // 4*4 = 16 byte alignment, which is largest alignment, and as such forms the struct's base alignment
+		float     metallic_factor{ 1 };            // 4 byte alignment, must be at mulitple of 4
+		float     roughness_factor{ 1 };           // 4 byte alignment, must be at multiple of 4
+	};
+
+	// static_assert(offsetof(UboMaterialParams,metallic_factor)%sizeof(UboMaterialParams::metallic_factor)==0, "must be at offset which is multiple of its size.");
+
+	UboMaterialParams material_params_ubo{};
+
+	struct UboPostProcessing {
+		float exposure{ 1.f };
+	};
+
+	UboPostProcessing post_processing_params{};
+
+	le_joint_palette_o const& joint_palette = stage->joint_palette;
+	le_gpu_draws_o const&     gpu_draws     = stage->gpu_draws;
+
+	// Whether instanceable primitives were culled on the GPU - in which case we draw them via
+	// indirect draws, and only draw primitives which are not instanceable from the CPU.
+	bool const use_gpu_draws = gpu_draws.enabled && !gpu_draws.needs_build && !gpu_draws.groups.empty();
+
+	le_cpu_draws_o const& cpu_draws = stage->cpu_draws;
+
+	auto bind_material = [ & ]( uint32_t material_idx ) {
+		auto const& material = stage->materials[ material_idx ];
+
+		{
+			// bind all textures
+			uint32_t tex_id = 0;
+			for ( auto const& tex : material.texture_handles ) {
+				encoder.setArgumentTexture( LE_ARGUMENT_NAME( "src_tex_unit" ), tex, tex_id++ );
+			}
+		}
+
+		if ( !material.cached_texture_params.empty() ) {
+			// has cached texture parameters
+			encoder.setArgumentData( LE_ARGUMENT_NAME( "UboTextureParams" ),
+			                         material.cached_texture_params.data(),
+			                         sizeof( le_material_o::UboTextureParamsSlice ) * material.cached_texture_params.size() );
+		}
+
+		if ( material.metallic_roughness ) {
+			auto&       mr         = material.metallic_roughness;
+			auto const& base_color = mr->base_color_factor;
+
+			material_params_ubo.base_color_factor =
+			    glm::vec4( base_color[ 0 ],
+			               base_color[ 1 ],
+			               base_color[ 2 ],
+			               base_color[ 3 ] );
+
+			material_params_ubo.metallic_factor  = mr->metallic_factor;
+			material_params_ubo.roughness_factor = mr->roughness_factor;
+
+			encoder.setArgumentData( LE_ARGUMENT_NAME( "UboMaterialParams" ),
+			                         &material_params_ubo, sizeof( UboMaterialParams ) );
+		}
+	};
+
+	auto bind_primitive_buffers = [ & ]( le_primitive_o const& primitive ) {
+		encoder.bindVertexBuffers( 0, uint32_t( primitive.bindings_buffer_handles.size() ),
+		                           primitive.bindings_buffer_handles.data(),
+		                           primitive.bindings_buffer_offsets.data() );
+
+		if ( primitive.has_indices ) {
+
+			auto& indices_accessor = stage->accessors[ primitive.indices_accessor_idx ];
+			auto& buffer_view      = stage->buffer_views[ indices_accessor.buffer_view_idx ];
+			auto& buffer           = stage->buffers[ buffer_view.buffer_idx ];
+
+			encoder.bindIndexBuffer( buffer->handle,
+			                         buffer_view.byte_offset,
+			                         index_type_from_num_type( indices_accessor.component_type ) );
+		}
+	};
+
+	// if ( false )
+	for ( uint32_t scene_idx = 0; scene_idx != stage->scenes.size(); scene_idx++ ) {
+
+		le_scene_o const& s = stage->scenes[ scene_idx ];
+
+		if ( use_gpu_draws ) {
+
+			// -- Draw instanceable primitives of this scene via indirect draws, one draw-indirect-count
+			// per batch of groups. The cull pass has written instance counts, and draw counts: a batch's
+			// draw count covers its groups up to the last group with visible instances - groups without
+			// visible instances have an instance count of zero, and the GPU skips their draws.
+
+			uint32_t const num_groups     = uint32_t( gpu_draws.groups.size() );
+			uint32_t const command_stride = sizeof( uint32_t ) * le_gpu_draws_o::COMMAND_STRIDE;
+
+			le_gpso_handle bound_pipeline     = nullptr;
+			bool           has_bound_material = false;
+			uint32_t       bound_material_idx = 0;
+
+			for ( uint32_t b = 0; b != uint32_t( gpu_draws.batches.size() ); b++ ) {
+
+				le_gpu_draws_o::batch_t const& batch = gpu_draws.batches[ b ];
+				le_gpu_draws_o::group_t const& group = gpu_draws.groups[ batch.first_group ];
+
+				if ( group.scene_idx != scene_idx ) {
+					continue;
+				}
+
+				// Groups in a batch differ only in offsets into the first group's buffers.
+				le_primitive_o const& primitive = stage->meshes[ group.mesh_idx ].primitives[ group.primitive_idx ];
+
+				if ( group.pipeline != bound_pipeline ) {
+
+					bound_pipeline     = group.pipeline;
+					has_bound_material = false;
+
+					encoder
+					    .bindGraphicsPipeline( group.pipeline )
+					    .setArgumentData( LE_ARGUMENT_NAME( "LightSSBO" ), s.lights.data(), sizeof( le_light_o ) * s.lights.size() )
+					    .setArgumentData( LE_ARGUMENT_NAME( "UboMatrices" ), &mvp_ubo, sizeof( UboMatrices ) )
+					    .setArgumentData( LE_ARGUMENT_NAME( "UboPostProcessing" ), &post_processing_params, sizeof( UboPostProcessing ) )
+					    .bindArgumentBuffer( LE_ARGUMENT_NAME( "InstanceTransforms" ), gpu_draws.visible_transforms_handle )
+					    .setViewports( 0, 1, &viewports[ 0 ] );
+
+					stage->draw_stats.num_pipeline_binds++;
+				}
+
+				if ( primitive.has_material && !( has_bound_material && bound_material_idx == primitive.material_idx ) ) {
+					has_bound_material = true;
+					bound_material_idx = primitive.material_idx;
+					bind_material( primitive.material_idx );
+				}
+
+				bind_primitive_buffers( primitive );
+
+				uint64_t const command_offset = uint64_t( command_stride ) * batch.first_group;
+				uint64_t const count_offset   = sizeof( uint32_t ) * ( uint64_t( le_gpu_draws_o::COMMAND_STRIDE ) * num_groups + b );
+
+				if ( primitive.has_indices ) {
+					encoder.drawIndexedIndirectCount( gpu_draws.commands_handle, command_offset, gpu_draws.commands_handle, count_offset, batch.group_count, command_stride );
+				} else {
+					encoder.drawIndirectCount( gpu_draws.commands_handle, command_offset, gpu_draws.commands_handle, count_offset, batch.group_count, command_stride );
+				}
+
+				for ( uint32_t g = batch.first_group; g != batch.first_group + batch.group_count; g++ ) {
+					stage->draw_stats.num_primitives += gpu_draws.groups[ g ].instance_count;
+				}
+
+				stage->draw_stats.num_draw_calls++;
+			}
+		}
+
+		// -- Draw primitives which were culled, and sorted when the stage was drawn into the render module.
+
+		if ( scene_idx >= cpu_draws.scene_draws.size() ) {
+			continue;
+		}
+
+		std::vector<stage_draw_item_t> const& draw_items      = cpu_draws.scene_draws[ scene_idx ].items;
+		uint32_t const                        first_transform = cpu_draws.scene_draws[ scene_idx ].first_transform;
+
+		le_gpso_handle bound_pipeline      = nullptr;
+		bool           has_bound_material  = false; //
+		uint32_t       bound_material_idx  = 0;     // only valid if has_bound_material
+		uint32_t       bound_mesh_idx      = ~0u;   // vertex buffers, and index buffer bound for this mesh, and primitive
+		uint32_t       bound_primitive_idx = ~0u;   //
+
+		for ( size_t i = 0; i != draw_items.size(); ) {
+
+			stage_draw_item_t const& item = draw_items[ i ];
+
+			le_node_o const*      n         = stage->nodes[ item.node_idx ];
+			le_primitive_o const& primitive = stage->meshes[ item.mesh_idx ].primitives[ item.primitive_idx ];
+
+			// -- Following items which draw the same primitive, with the same material
+			// can be merged into a single, instanced draw.
+
+			uint32_t instance_count = 1;
+
+			while ( item.is_instanceable &&
+			        i + instance_count != draw_items.size() &&
+			        stage_draw_items_can_share_draw( item, draw_items[ i + instance_count ] ) ) {
+				instance_count++;
+			}
+
+			if ( item.pipeline != bound_pipeline ) {
+
+				// Binding a pipeline resets all arguments - which is why we set arguments which
+				// are the same for all draws only once per pipeline, now that draws are sorted.
+
+				bound_pipeline     = item.pipeline;
+				has_bound_material = false;
+
+				encoder
+				    .bindGraphicsPipeline( item.pipeline )
+				    .setArgumentData( LE_ARGUMENT_NAME( "LightSSBO" ), s.lights.data(), sizeof( le_light_o ) * s.lights.size() )
+				    .setArgumentData( LE_ARGUMENT_NAME( "UboMatrices" ), &mvp_ubo, sizeof( UboMatrices ) )
+				    .setArgumentData( LE_ARGUMENT_NAME( "UboPostProcessing" ), &post_processing_params, sizeof( UboPostProcessing ) )
+				    .bindArgumentBuffer( LE_ARGUMENT_NAME( "InstanceTransforms" ), cpu_draws.handle )
+				    .setViewports( 0, 1, &viewports[ 0 ] );
+
+				stage->draw_stats.num_pipeline_binds++;
+			}
+
+			if ( primitive.num_joints_sets && n->skin && n->joint_palette_idx < joint_palette.entries.size() ) {
+				// we must apply joints matrices - these were calculated in le_stage_update,
+				// here, we only need to tell the primitive where to find them.
+				auto const&    joints_entry = joint_palette.entries[ n->joint_palette_idx ];
+				uint32_t const joints_count = uint32_t( n->skin->joints.size() );
+				encoder.bindArgumentBuffer( LE_ARGUMENT_NAME( "UboJointMatrices" ), joint_palette.handle,
+				                            sizeof( glm::mat4 ) * joints_entry.offset, sizeof( glm::mat4 ) * joints_count );
+				encoder.bindArgumentBuffer( LE_ARGUMENT_NAME( "UboJointNormalMatrices" ), joint_palette.handle,
+				                            sizeof( glm::mat4 ) * joints_entry.normals_offset, sizeof( glm::mat4 ) * joints_count );
+			}
+
+			if ( primitive.morph_target_count > 0 ) {
+
+				// This primitive has morph targets - we must upload the current weigths for the morph targets.
+				//
+				// NOTE: We upload the morph target weights tightly packed -
+				// this means the shader will receive them as vec4s, which
+				// every 4 floats (if available) grouped together into one vec4.
+				encoder.setArgumentData( LE_ARGUMENT_NAME( "UboMorphTargetWeights" ), n->morph_target_weights,
+				                         sizeof( glm::vec4 ) * ( ( primitive.morph_target_count + 3 ) / 4 ) );
+
+				if ( false ) {
+					std::ostringstream os;
+					os << "weights: " << std::dec;
+					for ( auto i = 0; i != primitive.morph_target_count; i++ ) {
+						os << std::setw( 8 ) << n->morph_target_weights[ i ] << ", ";
+					}
+					logger.info( os.str().c_str() );
+				}
+			}
+
+			if ( primitive.has_material && !( has_bound_material && bound_material_idx == primitive.material_idx ) ) {
+				has_bound_material = true;
+				bound_material_idx = primitive.material_idx;
+				bind_material( primitive.material_idx );
+			}
+
+			// ---- invariant: primitive has pipeline, bindings.
+
+			if ( item.mesh_idx != bound_mesh_idx || item.primitive_idx != bound_primitive_idx ) {
+				bound_mesh_idx      = item.mesh_idx;
+				bound_primitive_idx = item.primitive_idx;
+				bind_primitive_buffers( primitive );
+			}
+
+			// Instance transforms for all scenes were uploaded into one buffer, in draw list
+			// order - first instance tells the shader where to find transforms for this draw.
+			uint32_t const first_instance = first_transform + uint32_t( i );
+
+			if ( primitive.has_indices ) {
+				encoder.drawIndexed( primitive.index_count, instance_count, 0, 0, first_instance );
+			} else {
+				encoder.draw( primitive.vertex_count, instance_count, 0, first_instance );
+			}
+
+			stage->draw_stats.num_draw_calls++;
+
+			i += instance_count;
+		}
+	}
+}
+
+// ----------------------------------------------------------------------
+
+/// \brief add setup and execute callbacks to rendermodule so that rendermodule
+/// knows which resources are needed to render the stage.
+/// There are two resource types which potentially need uploading: buffers,
+/// and images.
+static void le_stage_draw_into_render_module( le_stage_api::draw_params_t* draw_params, le_rendergraph_o* module, le_img_resource_handle color_attachment_image, le_img_resource_handle depth_stencil_attachment_image ) {
+
+	using namespace le_renderer;
+
+#ifdef LE_FEATURE_RTX
+
+	{
+
+		auto rtx_pass =
+		    le::RenderPass( "Stage Rtx", le::QueueFlagBits::eCompute )
+		        .setExecuteCallback( draw_params, []( le_command_buffer_encoder_o* encoder_, void* user_data ) {
+			        auto draw_params = static_cast<le_stage_api::draw_params_t*>( user_data );
+			        auto camera      = draw_params->camera;
+			        auto stage       = draw_params->stage;
+			        auto encoder     = le::Encoder{ encoder_ };
+
+			        auto extents = encoder.getRenderpassExtent();
+
+			        le::Viewport viewports[ 2 ] = {
+			            { 0.f, float( extents.height ), float( extents.width ), -float( extents.height ), -0.f, 1.f }, // negative viewport means to flip y axis in screen space
+			            { 0.f, 0.f, float( extents.width ), float( extents.height ), 0.f, 1.f },
+			        };
+
+			        // we set projection matrix and view matrix to somehow sensible defaults.
+			        glm::mat4 camera_projection_matrix = glm::ortho( -0.5f, 0.5f, -0.5f, 0.5f, -1000.f, 1000.f );
+			        glm::mat4 camera_view_matrix       = glm::identity<glm::mat4>();
+			        glm::mat4 camera_world_matrix      = glm::identity<glm::mat4>(); // global transform for camera node (==inverse view matrix)
+
+			        // update camera from interactive camera
+			        // if no stage camera is given, and an interactive camera is available
+			        if ( camera ) {
+
+				        using namespace le_camera;
+				        le_camera_i.set_viewport( camera, viewports[ 0 ] );
+				        le_camera_i.get_view_matrix( camera, &camera_view_matrix[ 0 ][ 0 ] );
+				        le_camera_i.get_projection_matrix( camera, &camera_projection_matrix[ 0 ][ 0 ] );
+				        camera_world_matrix = glm::inverse( camera_view_matrix );
+			        }
+
+			        auto pipeline_manager = encoder.getPipelineManager();
+
+			        // -- Create rtx pso
+			        static le_rtxpso_handle rtx_pipeline = []( le_stage_o* stage, le_pipeline_manager_o* pipeline_manager ) {
+				        auto shader_raygen      = LeShaderModuleBuilder( pipeline_manager ).setSourceFilePath( "./resources/shaders/le_stage/rtx/raygen.rgen" ).setShaderStage( le::ShaderStage::eRaygenBitKhr ).build();
+				        auto shader_closest_hit = LeShaderModuleBuilder( pipeline_manager ).setSourceFilePath( "./resources/shaders/le_stage/rtx/closesthit.rchit" ).setShaderStage( le::ShaderStage::eClosestHitBitKhr ).build();
+				        auto shader_miss        = LeShaderModuleBuilder( pipeline_manager ).setSourceFilePath( "./resources/shaders/le_stage/rtx/miss.rmiss" ).setShaderStage( le::ShaderStage::eMissBitKhr ).build();
+				        auto shader_shadow_miss = LeShaderModuleBuilder( pipeline_manager ).setSourceFilePath( "./resources/shaders/le_stage/rtx/shadow.rmiss" ).setShaderStage( le::ShaderStage::eMissBitKhr ).build();
+
+				        // Create rtx pipeline
+
+				        LeRtxPipelineBuilder builder( pipeline_manager );
+
+				        // add shader groups.
+				        builder
+				            .setShaderGroupRayGen( shader_raygen )                    // shader group handle: ray_gen 0
+				            .addShaderGroupTriangleHit( shader_closest_hit, nullptr ) // shader group handle: hit 0
+				            .addShaderGroupMiss( shader_miss )                        // shader group handle: miss 0
+				            .addShaderGroupMiss( shader_shadow_miss )                 // shader group handle: miss 1
+				            ;
+
+				        return builder.build();
+			        }( stage, pipeline_manager );
+
+			        // At this point we should be able to build the shader binding table for the pipeline.
+			        // The SBT is basically a sequence of:
+			        // 1 RayGen Group
+			        // 1+ Hit Groups
+			        // 1+ Miss Groups
+			        // Each group may have parameters
+
+			        // Shader binding table is built on encoder - this way we can use the encoder's scratch GPU memory
+			        // as SBT memory. SBT is rebuilt every frame.
+
+			        le_shader_binding_table_o* sbt =
+			            le::Encoder::ShaderBindingTableBuilder( encoder, rtx_pipeline )
+			                .setRayGenIdx( 0 )
+			                .addHitIdx( 1 )
+			                .addMissIdx( 2 )
+			                .addMissIdx( 3 )
+			                .build();
+
+			        // shader_binding_table_o* already contains a reference to pipeline,
+			        // which means pipeline does not need to be referenced again.
+			        encoder.bindRtxPipeline( sbt );
+
+			        // -- set ray tracing arguments
+
+			        struct CameraPropertiesUBO {
+				        glm::mat4 viewInverse;
+				        glm::mat4 projectionInverse;
+				        glm::vec4 lightPos; // world coords
+			        };
+
+			        CameraPropertiesUBO camera_properties;
+			        camera_properties.viewInverse       = camera_world_matrix;
+			        camera_properties.projectionInverse = glm::inverse( camera_projection_matrix );
+
+			        if ( stage->scenes.empty() ) {
+				        return;
+			        }
+
+			        if ( !stage->scenes.front().lights.empty() ) {
+				        camera_properties.lightPos = glm::vec4( stage->scenes.front().lights.front().position, 1 );
+			        } else {
+				        camera_properties.lightPos = glm::vec4{ 3, 10, 4, 1 }; // arbitrary fallback defaults.
+			        }
+
+			        // -- call trace rays
+
+			        encoder.setArgumentData( LE_ARGUMENT_NAME( "CameraProperties" ), &camera_properties, sizeof( CameraPropertiesUBO ) );
+			        encoder.setArgumentTlas( LE_ARGUMENT_NAME( "topLevelAS" ), stage->scenes.front().rtx_tlas_handle );
+			        encoder.setArgumentImage( LE_ARGUMENT_NAME( "image" ), RTX_IMAGE_TARGET_HANDLE );
+
+			        encoder.traceRays( extents.width, extents.height );
+		        } ) //
+		    ;
+
+		{
+
+			// -- Signal that we want to use an image to write to.
+
+			rtx_pass
+			    .useImageResource( RTX_IMAGE_TARGET_HANDLE, le::ImageUsageFlags( le::ImageUsageFlagBits::eStorage ) ); // write
+
+			le_resource_info_t rtx_target_info =
+			    le::ImageInfoBuilder()
+			        .setFormat( le::Format::eR8Unorm ) // 1 byte per cell, 1024x1024 cells
+			        .addUsageFlags( le::ImageUsageFlagBits::eStorage | le::ImageUsageFlagBits::eSampled )
+			        .build();
+
+			rendergraph_i.declare_resource( module, RTX_IMAGE_TARGET_HANDLE, rtx_target_info );
+
+			// -- Signal that we want to read from bottom-level acceleration structures.
+
+			for ( auto const& m : draw_params->stage->meshes ) {
+				for ( auto const& p : m.primitives ) {
+					rtx_pass.useRtxBlasResource( p.rtx_blas_handle );
+				}
+			}
+
+			// -- Signal that we want to read from top-level acceleration structures.
+
+			for ( auto const& s : draw_params->stage->scenes ) {
+				rtx_pass.useRtxTlasResource( s.rtx_tlas_handle );
+			}
+		}
+
+		rendergraph_i.add_renderpass( module, rtx_pass );
+	}
+
+#endif
+
+	le_gpu_draws_o const& gpu_draws     = draw_params->stage->gpu_draws;
+	bool const            use_gpu_draws = gpu_draws.enabled && !gpu_draws.needs_build && !gpu_draws.groups.empty();
+
+	// Cull, and sort primitives which we draw from the CPU now, so that we know how many
+	// instance transforms to upload - the draw pass only records draws.
+
+	le_cpu_draws_o& cpu_draws = draw_params->stage->cpu_draws;
+
+	draw_params->stage->draw_stats = {};
+	cpu_draws_build( &cpu_draws, draw_params->stage, draw_params->camera, use_gpu_draws );
+
+	if ( !cpu_draws.transforms.empty() ) {
+
+		rendergraph_i.declare_resource( module, cpu_draws.handle, cpu_draws.resource_info );
+
+		auto transforms_pass =
+		    le::RenderPass( "Stage Instance Transforms", le::QueueFlagBits::eTransfer )
+		        .useBufferResource( cpu_draws.handle, le::AccessFlagBits2::eTransferWrite )
+		        .setExecuteCallback( draw_params->stage, []( le_command_buffer_encoder_o* encoder_, void* user_data ) {
+			        auto  stage     = static_cast<le_stage_o*>( user_data );
+			        auto  encoder   = le::TransferEncoder{ encoder_ };
+			        auto& cpu_draws = stage->cpu_draws;
+			        encoder.writeToBuffer( cpu_draws.handle, 0, cpu_draws.transforms.data(), sizeof( le_instance_transform_t ) * cpu_draws.transforms.size() );
+		        } );
+
+		rendergraph_i.add_renderpass( module, transforms_pass );
+	}
+
+	if ( use_gpu_draws ) {
+		auto cull_pass =
+		    le::RenderPass( "Stage Gpu Cull", le::QueueFlagBits::eCompute )
+		        .useBufferResource( gpu_draws.instances_handle, le::AccessFlagBits2::eShaderStorageRead )
+		        .useBufferResource( gpu_draws.transforms_handle, le::AccessFlagBits2::eShaderStorageRead )
+		        .useBufferResource( gpu_draws.visible_transforms_handle, le::AccessFlagBits2::eShaderStorageRead, le::AccessFlagBits2::eShaderStorageWrite )
+		        .useBufferResource( gpu_draws.commands_handle, le::AccessFlagBits2::eShaderStorageRead, le::AccessFlagBits2::eShaderStorageWrite )
+		        .setExecuteCallback( draw_params, pass_gpu_cull );
+
+		rendergraph_i.add_renderpass( module, cull_pass );
+	}
+
+	auto stage_draw_pass =
 	    le::RenderPass( "Stage Draw", le::QueueFlagBits::eGraphics )
 	        .setExecuteCallback( draw_params, pass_draw )
 	        .addColorAttachment(
@@ -2154,580 +3376,1250 @@ static void le_stage_draw_into_render_module( le_stage_api::draw_params_t* draw_
 	                .build() )
 	        .setSampleCount( le::SampleCountFlagBits::e4 );
 
-	if ( depth_stencil_attachment_image ) {
-		stage_draw_pass.addDepthStencilAttachment( depth_stencil_attachment_image );
+	if ( depth_stencil_attachment_image ) {
+		stage_draw_pass.addDepthStencilAttachment( depth_stencil_attachment_image );
+	}
+
+	for ( auto& b : draw_params->stage->buffers ) {
+		stage_draw_pass.useBufferResource( b->handle, le::BufferUsageFlagBits::eIndexBuffer | le::BufferUsageFlagBits::eVertexBuffer );
+	}
+
+	if ( !draw_params->stage->joint_palette.entries.empty() ) {
+		stage_draw_pass.useBufferResource( draw_params->stage->joint_palette.handle, le::BufferUsageFlagBits::eStorageBuffer );
+	}
+
+	if ( !cpu_draws.transforms.empty() ) {
+		stage_draw_pass.useBufferResource( cpu_draws.handle, le::AccessFlagBits2::eShaderStorageRead );
+	}
+
+	if ( use_gpu_draws ) {
+		stage_draw_pass
+		    .useBufferResource( gpu_draws.commands_handle, le::AccessFlagBits2::eIndirectCommandRead )
+		    .useBufferResource( gpu_draws.visible_transforms_handle, le::AccessFlagBits2::eShaderStorageRead );
+	}
+
+	for ( auto& t : draw_params->stage->textures ) {
+		// We must create texture handles for this renderpass.
+		stage_draw_pass.sampleTexture(
+		    t.texture_handle, {
+		                          draw_params->stage->samplers[ t.sampler_idx ],             // samplerInfo
+		                          { draw_params->stage->images[ t.image_idx ]->handle, {} }, // imageViewInfo
+		                      } );
+	}
+
+	rendergraph_i.add_renderpass( module, stage_draw_pass );
+}
+
+/// \brief initialises pipeline state objects associated with each primitive
+/// \details pipeline contains materials, vertex and index binding information on each primitive.
+/// this will also cache handles for vertex and index data with each primitive.
+static void le_stage_setup_pipelines( le_stage_o* stage ) {
+
+	using namespace le_renderer;
+
+	static auto            logger           = LeLog( LOGGER_LABEL );
+	le_pipeline_manager_o* pipeline_manager = renderer_i.get_pipeline_manager( stage->renderer );
+
+	// First, collect all possible shader define permutations based on shader #defines.
+	// since this will control how many instances of our shader we must send to the shader compiler.
+
+	std::unordered_map<uint64_t, std::string, IdentityHash> materials_defines_hash_to_defines_str; // map from materials defines hash to define string
+	std::vector<uint64_t>                                   defines_hash_at_material_idx;          // table from material inded to materials define hash
+
+	std::unordered_map<uint64_t, std::string, IdentityHash> vertex_input_defines_hash_to_defines_str; // map from vertex input defines hash to define string
+
+	struct shader_defines_signature {
+		uint64_t hash_vertex_input_defines;
+		uint64_t hash_materials_defines;
+	};
+
+	struct shader_programs {
+		shader_defines_signature signature;
+		le_shader_module_handle  vert;
+		le_shader_module_handle  frag;
+	};
+
+	std::unordered_map<uint64_t, shader_programs, IdentityHash> shader_map;
+
+	// -- First build up a map of all defines for materials
+
+	defines_hash_at_material_idx.reserve( stage->materials.size() );
+
+	for ( auto& material : stage->materials ) {
+
+		/** -- Update material properties - cache material texture transform matrices.
+		 *
+		 * For each texture, we add a define, and we cache the texture handle and the associated
+		 * texture info data with the material.
+		 *
+		 * For the material ubos we combine these so that all material data can be uploded in a
+		 * single ubo.
+		 *
+		 * We do this so that the material has a local cache of all the information
+		 * it needs when it gets bound on a primitive.
+		 *
+		 */
+
+		std::stringstream defines;
+
+		uint32_t num_textures = 0;
+
+		auto add_texture = [ & ]( char const* texture_name, const le_texture_view_o* tex_info ) {
+			defines << "HAS_" << texture_name << "_MAP,";
+
+			material.texture_handles.push_back( stage->textures[ tex_info->texture_id ].texture_handle );
+
+			if ( tex_info->has_transform ) {
+				defines << "HAS_" << texture_name << "_UV_TRANSFORM,";
+				// must push back 3 vec3 for the transform matrix
+				le_material_o::UboTextureParamsSlice vec_0{};
+				le_material_o::UboTextureParamsSlice vec_1{};
+				le_material_o::UboTextureParamsSlice vec_2{};
+				vec_0.slice.vec = glm::vec4( tex_info->transform[ 0 ], 0 );
+				vec_1.slice.vec = glm::vec4( tex_info->transform[ 1 ], 0 );
+				vec_2.slice.vec = glm::vec4( tex_info->transform[ 2 ], 0 );
+				material.cached_texture_params.emplace_back( vec_0 );
+				material.cached_texture_params.emplace_back( vec_1 );
+				material.cached_texture_params.emplace_back( vec_2 );
+			}
+
+			le_material_o::UboTextureParamsSlice params{};
+			params.slice.data.scale   = tex_info->scale;
+			params.slice.data.uv_set  = tex_info->uv_set;
+			params.slice.data.tex_idx = num_textures;
+			material.cached_texture_params.emplace_back( params );
+
+			num_textures++;
+		};
+
+		// clang-format off
+					if ( material.normal_texture )    add_texture( "NORMAL"     , material.normal_texture    );
+					if ( material.occlusion_texture ) add_texture( "OCCLUSION"  , material.occlusion_texture );
+		// clang-format on
+
+		if ( material.emissive_texture ) {
+			add_texture( "EMISSIVE", material.emissive_texture );
+			le_material_o::UboTextureParamsSlice emissive_factor{};
+			emissive_factor.slice.vec = glm::vec4( material.emissive_factor, 1 );
+			material.cached_texture_params.emplace_back( emissive_factor );
+		}
+
+		if ( material.metallic_roughness ) {
+			defines << "MATERIAL_METALLICROUGHNESS,";
+			if ( material.metallic_roughness->base_color ) {
+				add_texture( "BASE_COLOR", material.metallic_roughness->base_color );
+			}
+			if ( material.metallic_roughness->metallic_roughness ) {
+				add_texture( "METALLIC_ROUGHNESS", material.metallic_roughness->metallic_roughness );
+			}
+		}
+
+		if ( num_textures ) {
+			defines << "HAS_TEXTURES=" << num_textures << ",";
+		}
+
+		std::string defines_str  = defines.str();
+		uint64_t    defines_hash = SpookyHash::Hash64( defines_str.data(), defines_str.size(), 0 );
+
+		defines_hash_at_material_idx.push_back( defines_hash );
+		materials_defines_hash_to_defines_str.insert( { defines_hash, std::move( defines_str ) } );
+	}
+
+	// -- Then build a map of all vertex input defines per primitive
+
+	for ( auto& mesh : stage->meshes ) {
+
+		for ( auto& primitive : mesh.primitives ) {
+
+			std::stringstream defines;
+
+			auto const attr_begin = primitive.attributes.data();
+			auto const attr_end   = attr_begin + primitive.attributes.size();
+
+			{
+				// Find out if the primitive has morph targets - as this will
+				// inform the number of locations which each attribute occupies.
+				//
+				uint32_t morph_target_count = uint32_t( primitive.morph_target_count );
+				uint32_t location           = 0; // current location for attribute.
+
+				if ( morph_target_count ) {
+					defines << "MORPH_TARGET_COUNT=" << morph_target_count << ",";
+				}
+
+				// TODO: check number of requested locations against device limits.
+				//
+				// uint32_t max_location = primitive.attributes.size() ;
+				// assert(max_location < 17 && "cannot not bind more than 16 locations.");
+
+				for ( auto attr = attr_begin; attr != attr_end; ) {
+
+					// Find out how how many attibutes of the same type each exist
+					// (this gives us the array size per attribute)
+
+					uint32_t num_array_elements = 0;
+					for ( auto a = attr; a != attr_end && a->type == attr->type; a++, num_array_elements++ ) {
+					}
+
+					switch ( attr->type ) {
+					case ( le_primitive_attribute_info::Type::ePosition ):
+						defines << "LOC_POSITIONS=" << location << ",";
+						defines << "NUM_POSITIONS=" << num_array_elements << ",";
+						if ( num_array_elements > 1 ) {
+							assert( num_array_elements == ( morph_target_count + 1 ) && "number of array elements must match 1 + morph_target_count" );
+						}
+						break;
+					case ( le_primitive_attribute_info::Type::eNormal ):
+						defines << "LOC_NORMALS=" << location << ",";
+						defines << "NUM_NORMALS=" << num_array_elements << ",";
+						if ( num_array_elements > 1 ) {
+							assert( num_array_elements == ( morph_target_count + 1 ) && "number of array elements must match 1 + morph_target_count" );
+						}
+						break;
+					case ( le_primitive_attribute_info::Type::eTangent ):
+						defines << "LOC_TANGENTS=" << location << ",";
+						defines << "NUM_TANGENTS=" << num_array_elements << ",";
+						if ( num_array_elements > 1 ) {
+							assert( num_array_elements == ( morph_target_count + 1 ) && "number of array elements must match 1 + morph_target_count" );
+						}
+						break;
+					case ( le_primitive_attribute_info::Type::eTexcoord ):
+						defines << "LOC_TEXCOORDS=" << location << ",";
+						defines << "NUM_TEXCOORDS=" << num_array_elements << ",";
+						break;
+					case ( le_primitive_attribute_info::Type::eColor ):
+						defines << "LOC_COLORS=" << location << ",";
+						defines << "NUM_COLORS=" << num_array_elements << ",";
+						break;
+					case ( le_primitive_attribute_info::Type::eJoints ):
+						defines << "LOC_JOINT_SETS=" << location << ",";
+						defines << "NUM_JOINT_SETS=" << num_array_elements << ",";
+						break;
+					case ( le_primitive_attribute_info::Type::eJointWeights ):
+						defines << "LOC_JOINT_WEIGHTS_SET=" << location << ",";
+						defines << "NUM_JOINT_WEIGHTS_SET=" << num_array_elements << ",";
+						break;
+					default:
+						break;
+					}
+
+					location += num_array_elements;
+					attr += num_array_elements;
+				}
+			}
+
+			std::string vertex_input_defines = defines.str();
+
+			uint64_t vertex_input_defines_hash = SpookyHash::Hash64( vertex_input_defines.data(),
+			                                                         vertex_input_defines.size(), 0 );
+
+			// Store shader defines string if not yet present
+			vertex_input_defines_hash_to_defines_str.insert( { vertex_input_defines_hash, std::move( vertex_input_defines ) } );
+
+			// Build a shader defines signature from vertex input defines and materials defines for this primitive.
+			// We will use this later to look up the correct shader for the primitive.
+
+			shader_defines_signature signature{};
+			if ( primitive.has_material ) {
+				signature.hash_materials_defines = defines_hash_at_material_idx[ primitive.material_idx ];
+			}
+			signature.hash_vertex_input_defines = vertex_input_defines_hash;
+
+			primitive.all_defines_hash = SpookyHash::Hash64( &signature, sizeof( signature ), 0 );
+
+			// Inserting an element with null shader module pointers prepares for the next step, where
+			// we will iterate through the map of unique shader signatures, and instantiate shaders
+			// based on signatures.
+			shader_map.insert( { primitive.all_defines_hash, { signature, nullptr, nullptr } } );
+		}
+	}
+
+	// Get set of unique combinations of vertex inputs
+	// and material defines, and associate a shader with each.
+
+	// Create shaders from unique defines
+
+	for ( auto& shader : shader_map ) {
+
+		std::string defines = vertex_input_defines_hash_to_defines_str[ shader.second.signature.hash_vertex_input_defines ];
+		defines             = defines + materials_defines_hash_to_defines_str[ shader.second.signature.hash_materials_defines ];
+
+		logger.info( "Creating shader instance using defines: \n\t'-D%s'", defines.c_str() );
+
+		shader.second.vert = LeShaderModuleBuilder( pipeline_manager ).setSourceFilePath( "./resources/shaders/le_stage/gltf.vert" ).setShaderStage( le::ShaderStage::eVertex ).setSourceDefinesString( defines.c_str() ).build();
+		shader.second.frag = LeShaderModuleBuilder( pipeline_manager ).setSourceFilePath( "./resources/shaders/le_stage/metallic-roughness.frag" ).setShaderStage( le::ShaderStage::eFragment ).setSourceDefinesString( defines.c_str() ).build();
+	}
+
+	std::unordered_map<le_gpso_handle, uint64_t> pipelineCount; // Only used for debug purposes, count number of unique pipelines
+
+	// associate each primitive with shader matching defines id
+
+	for ( auto& mesh : stage->meshes ) {
+
+		for ( auto& primitive : mesh.primitives ) {
+
+			if ( !primitive.pipeline_state_handle ) {
+
+				// We must create a graphics pipeline state object (GPSO) for this primitive.
+				// The PSO captures everything needed for a material.
+
+				// We use an uber-shader to render materials; therefore our shader needs to simulate/handle
+				// missing attributes.
+				// We deactivate missing attributes via the shader preprocessor.
+
+				// -- Precondition: primitive.attributes are pre-sorted by type, then name,
+				// so that name "TEX_COORD_0" appears before "TEX_COORD_1",
+				// and normal attributes appear before tangent attributes etc.
+
+				LeGraphicsPipelineBuilder builder( pipeline_manager );
+
+				le_shader_module_handle shader_frag{};
+				le_shader_module_handle shader_vert{};
+
+				auto shaders = shader_map.find( primitive.all_defines_hash );
+
+				assert( shaders != shader_map.end() && "shader must be existing, and valid" );
+
+				shader_frag = shaders->second.frag;
+				shader_vert = shaders->second.vert;
+
+				if ( shader_frag ) {
+					builder.addShaderStage( shader_frag );
+				}
+
+				if ( shader_vert ) {
+					builder.addShaderStage( shader_vert );
+				}
+
+				assert( shader_frag && "shader_frag must be valid" );
+				assert( shader_vert && "shader_vert must be valid" );
+
+				// builder
+				//				    .withRasterizationState()
+				//				    .setCullMode( le::CullModeFlagBits::eBack )
+				//				    .setFrontFace( le::FrontFace::eClockwise )
+				// 			    .end();
+
+				primitive.bindings_buffer_handles.clear();
+				primitive.bindings_buffer_offsets.clear();
+				primitive.bindings_buffer_strides.clear();
+
+				// Calculate Attribute Bindings for this PSO.
+
+				auto& abs =
+				    builder.withAttributeBindingState();
+
+				// We must group our attributes by bufferviews.
+				//
+				// Only if there is interleaving we have more than one attribute per buffer binding,
+				// otherwise each binding takes its own buffer.
+				//
+				// + We must detect interleaving:
+				// - 1. gltf requirement: if bufferview.byteStride != 0, then there is interleaving.
+				// - 2. if more than one accessor refer to the same bufferview, we have interleaving.
+				//
+				// We must group by bufferViews: Each bufferview will mean one binding -
+				// as each bufferview refers to a buffer, and an offset into that buffer
+				//
+				// Q: if there is interleaving, does this mean that two or more accessors refer to the same
+				// bufferview?
+				//
+				// A: yes, in that case multiple accessors may refer to the same bufferView, in which case each accessor
+				//    defines a byteOffset to specify where it starts within the bufferView.
+
+				// Note: iterator is increased in inner do-while loop
+				for ( auto it = primitive.attributes.begin(); it != primitive.attributes.end(); ) {
+
+					le_accessor_o const* accessor        = &stage->accessors[ it->accessor_idx ];
+					auto const&          buffer_view     = stage->buffer_views[ accessor->buffer_view_idx ];
+					uint32_t             buffer_view_idx = accessor->buffer_view_idx;
+
+					auto& binding = abs.addBinding( uint16_t( buffer_view.byte_stride ) );
+
+					// If no explicit buffer_view.byte_stride was given, we accumulate each accessor's
+					// storage size so that we can set the stride of the binding based on the sum total
+					// of a bindning's accessors at the end.
+					//
+					uint16_t accessors_total_byte_count = 0;
+
+					do {
+
+						if ( 0 == buffer_view.byte_stride ) {
+							accessors_total_byte_count += size_of( accessor->component_type ) *
+							                              get_num_components( accessor->type );
+						}
+
+						// Add attributes until buffer_view_idx changes.
+						// in which case we want to open the next binding.
+						//
+						// if the buffer_view_idx doesn't change, this means that we are still within the same
+						// binding, because then we have interleaving.
+						//
+						// every accessor mapping the same buffer will go into the same binding number
+						// because that's what the encoder will bind in the end.
+						binding.addAttribute( uint16_t( accessor->byte_offset ),
+						                      accessor->component_type,
+						                      get_num_components( accessor->type ), // calculate number of components
+						                      accessor->is_normalized );
+
+						it++;
+
+						// prepare accessor for next iteration.
+						if ( it != primitive.attributes.end() ) {
+							accessor = &stage->accessors[ it->accessor_idx ];
+						}
+
+					} while ( it != primitive.attributes.end() &&
+					          buffer_view_idx == accessor->buffer_view_idx );
+
+					// Cache binding for primitive so that we can bind faster.
+
+					primitive.bindings_buffer_handles.push_back( stage->buffers[ buffer_view.buffer_idx ]->handle );
+					primitive.bindings_buffer_offsets.push_back( buffer_view.byte_offset );
+					primitive.bindings_buffer_strides.push_back( buffer_view.byte_stride );
+
+					if ( 0 == buffer_view.byte_stride ) {
+						// If stride was not explicitly specified - this will be non-zero,
+						// telling us that we must set stride here.
+						binding.setStride( accessors_total_byte_count );
+						primitive.bindings_buffer_strides.back() = accessors_total_byte_count;
+					}
+
+					binding.end();
+				}
+
+				// Fill in number of vertices for primitive
+				if ( !primitive.attributes.empty() ) {
+					primitive.vertex_count = stage->accessors[ primitive.attributes.front().accessor_idx ].count;
+				}
+
+				if ( primitive.has_indices ) {
+					primitive.index_count = stage->accessors[ primitive.indices_accessor_idx ].count;
+				}
+
+				primitive.pipeline_state_handle = builder.build();
+				pipelineCount[ primitive.pipeline_state_handle ]++;
+			}
+
+		} // end for all mesh.primitives
+	}     // end for all meshes
+
+	logger.info( "Pipelines in use:" );
+	for ( auto& p : pipelineCount ) {
+		logger.info( "%x : %d", p.first, p.second );
+	}
+
+#ifdef LE_FEATURE_RTX
+	{
+		// -- Create top level acceleration structure for each scene.
+
+		// For each TLAS we must know the number of nodes which contribute,
+		// as each node maps to one instance.
+
+		std::vector<uint32_t> node_count_per_scene;
+
+		uint32_t const scenes_count = uint32_t( stage->scenes.size() );
+		node_count_per_scene.resize( scenes_count, 0 );
+
+		// -- Count mesh nodes per scene:
+		for ( auto const& n : stage->nodes ) {
+			if ( n->has_mesh ) {
+				for ( uint32_t i = 0; i != scenes_count; i++ ) {
+					if ( 1 << i & n->scene_bit_flags ) {
+						node_count_per_scene[ i ]++;
+					}
+				}
+			}
+		}
+
+		// Associate a TLAS with each scene.
+		for ( uint32_t i = 0; i != scenes_count; i++ ) {
+			char rtx_tlas_resource_name[ 17 ]{};
+			snprintf( rtx_tlas_resource_name, sizeof( rtx_tlas_resource_name ), "tlas_%08u", i );
+
+			// -- Create top-level accelerator for this scene
+			stage->scenes[ i ].rtx_tlas_handle = le_renderer::renderer_i.produce_tlas_resource_handle( rtx_tlas_resource_name );
+
+			le::BuildAccelerationStructureFlagsKHR tlas_flags =
+			    le::BuildAccelerationStructureFlagBitsKHR::eAllowUpdateBitKhr |
+			    le::BuildAccelerationStructureFlagBitsKHR::ePreferFastBuildBitKhr;
+
+			le_resource_info_t resource_info{};
+
+			resource_info.type      = LeResourceType::eRtxTlas;
+			resource_info.tlas.info = renderer_i.create_rtx_tlas_info( stage->renderer, node_count_per_scene[ i ], tlas_flags );
+
+			stage->scenes[ i ].rtx_tlas_info = std::move( resource_info );
+		}
+	}
+
+#endif
+
+	// -- Since primitives have new pipelines, make sure that gpu draw groups get re-built.
+
+	stage->gpu_draws.needs_build = true;
+}
+
+// ----------------------------------------------------------------------
+/// \brief Find index of keyframe k such that key_ticks[k] <= ticks < key_ticks[k+1].
+/// Playback mostly moves forward by a few keyframes per frame, so we first look for
+/// the keyframe from where the previous lookup left off, and only fall back to a
+/// binary search if playback has jumped (seek, or loop).
+/// Ticks must lie in [key_ticks.front() .. key_ticks.back()[.
+static uint32_t animation_channel_find_keyframe( le_animation_channel_o* channel, uint64_t ticks ) {
+
+	static constexpr uint32_t MAX_LINEAR_STEPS = 4;
+
+	uint64_t const* key_ticks = channel->key_ticks.data();
+	uint32_t const  num_keys  = uint32_t( channel->key_ticks.size() );
+
+	uint32_t k = channel->cursor;
+
+	if ( k + 1 < num_keys && key_ticks[ k ] <= ticks ) {
+		for ( uint32_t i = 0; i != MAX_LINEAR_STEPS && k + 1 < num_keys; i++, k++ ) {
+			if ( ticks < key_ticks[ k + 1 ] ) {
+				channel->cursor = k;
+				return k;
+			}
+		}
+	}
+
+	// -- Cursor was too far off: binary search for first keyframe later than ticks.
+
+	k = uint32_t( std::upper_bound( key_ticks, key_ticks + num_keys, ticks ) - key_ticks ) - 1;
+
+	channel->cursor = k;
+	return k;
+}
+
+// ----------------------------------------------------------------------
+/// \brief Evaluate channel at given ticks, and store result in channel->value.
+static void animation_channel_evaluate( le_animation_channel_o* channel, uint64_t ticks ) {
+
+	using Interpolation = le_animation_channel_o::Interpolation;
+
+	uint32_t const num_components = channel->num_components;
+	uint32_t const floats_per_key = num_components * channel->values_per_key;
+
+	// Cubic spline keyframes store in-tangent, value, out-tangent - we want the value.
+	uint32_t const value_offset = channel->values_per_key == 3 ? num_components : 0;
+
+	float const* key_values = channel->key_values.data();
+
+	if ( ticks <= channel->key_ticks.front() || channel->key_ticks.size() < 2 ) {
+		memcpy( channel->value, key_values + value_offset, sizeof( float ) * num_components );
+		return;
+	}
+
+	if ( ticks >= channel->key_ticks.back() ) {
+		// Hold last keyframe, in case this channel is shorter than its animation.
+		memcpy( channel->value, key_values + floats_per_key * ( channel->key_ticks.size() - 1 ) + value_offset, sizeof( float ) * num_components );
+		return;
+	}
+
+	// -------- invariant: ticks lie between two keyframes.
+
+	uint32_t const k = animation_channel_find_keyframe( channel, ticks );
+
+	float const* v0 = key_values + floats_per_key * k;
+	float const* v1 = v0 + floats_per_key;
+
+	if ( channel->interpolation == Interpolation::eStep ) {
+		memcpy( channel->value, v0, sizeof( float ) * num_components );
+		return;
+	}
+
+	uint64_t const delta_ticks = channel->key_ticks[ k + 1 ] - channel->key_ticks[ k ];
+	float const    t           = float( ticks - channel->key_ticks[ k ] ) / float( delta_ticks );
+
+	bool const is_quat = channel->target_compound_type == le_compound_num_type::eQuat4;
+
+	if ( channel->interpolation == Interpolation::eCubicSpline ) {
+
+		// Hermite spline, as defined in the glTF 2.0 spec, Appendix C.
+		// Tangents are given per second, and must be scaled by keyframe duration.
+
+		float const dt  = float( delta_ticks ) / float( LE_TIME_TICKS_PER_SECOND );
+		float const t2  = t * t;
+		float const t3  = t2 * t;
+		float const h00 = 2 * t3 - 3 * t2 + 1;
+		float const h10 = ( t3 - 2 * t2 + t ) * dt;
+		float const h01 = -2 * t3 + 3 * t2;
+		float const h11 = ( t3 - t2 ) * dt;
+
+		float const* p0 = v0 + num_components;     // value at k
+		float const* b0 = v0 + 2 * num_components; // out-tangent at k
+		float const* a1 = v1;                      // in-tangent at k + 1
+		float const* p1 = v1 + num_components;     // value at k + 1
+
+		for ( uint32_t i = 0; i != num_components; i++ ) {
+			channel->value[ i ] = h00 * p0[ i ] + h10 * b0[ i ] + h01 * p1[ i ] + h11 * a1[ i ];
+		}
+
+		if ( is_quat ) {
+			glm::quat q;
+			memcpy( &q, channel->value, sizeof( glm::quat ) );
+			q = glm::normalize( q );
+			memcpy( channel->value, &q, sizeof( glm::quat ) );
+		}
+
+		return;
+	}
+
+	// -------- invariant: interpolation is linear
+
+	if ( is_quat ) {
+		// Quaternions need to be slerped instead of mixed. They also must be normalised before application.
+		glm::quat q0;
+		glm::quat q1;
+		memcpy( &q0, v0, sizeof( glm::quat ) );
+		memcpy( &q1, v1, sizeof( glm::quat ) );
+		glm::quat q = glm::normalize( glm::slerp( q0, q1, t ) );
+		memcpy( channel->value, &q, sizeof( glm::quat ) );
+		return;
 	}
 
-	for ( auto& b : draw_params->stage->buffers ) {
-		stage_draw_pass.useBufferResource( b->handle, le::BufferUsageFlagBits::eIndexBuffer | le::BufferUsageFlagBits::eVertexBuffer );
+	for ( uint32_t i = 0; i != num_components; i++ ) {
+		channel->value[ i ] = v0[ i ] + ( v1[ i ] - v0[ i ] ) * t;
 	}
+}
 
-	for ( auto& t : draw_params->stage->textures ) {
-		// We must create texture handles for this renderpass.
-		stage_draw_pass.sampleTexture(
-		    t.texture_handle, {
-		                          draw_params->stage->samplers[ t.sampler_idx ],             // samplerInfo
-		                          { draw_params->stage->images[ t.image_idx ]->handle, {} }, // imageViewInfo
-		                      } );
+// ----------------------------------------------------------------------
+/// \brief Write most recently evaluated channel value to node targeted by channel.
+static void animation_channel_apply( le_transform_hierarchy_o* transforms, le_animation_channel_o const& channel ) {
+
+	uint32_t const slot = transforms->slot_of_node[ channel.target_node->idx ];
+
+	switch ( channel.target_type ) {
+	case LeAnimationTargetType::eTranslation:
+		memcpy( &transforms->translation[ slot ], channel.value, sizeof( glm::vec3 ) );
+		break;
+	case LeAnimationTargetType::eRotation:
+		memcpy( &transforms->rotation[ slot ], channel.value, sizeof( glm::quat ) );
+		break;
+	case LeAnimationTargetType::eScale:
+		memcpy( &transforms->scale[ slot ], channel.value, sizeof( glm::vec3 ) );
+		break;
+	case LeAnimationTargetType::eWeights:
+		memcpy( channel.target_node->morph_target_weights, channel.value, sizeof( float ) * channel.num_components );
+		return;
+	default:
+		return;
 	}
 
-	rendergraph_i.add_renderpass( module, stage_draw_pass );
+	transforms->local_dirty[ slot ] = 1;
+	transforms->has_local_changes   = true;
 }
 
-/// \brief initialises pipeline state objects associated with each primitive
-/// \details pipeline contains materials, vertex and index binding information on each primitive.
-/// this will also cache handles for vertex and index data with each primitive.
-static void le_stage_setup_pipelines( le_stage_o* stage ) {
+// ----------------------------------------------------------------------
 
-	using namespace le_renderer;
+// If there are fewer channels than this, channels are evaluated on the calling thread.
+static constexpr uint32_t ANIMATION_MIN_CHANNELS_PER_JOB = 128;
 
-	static auto            logger           = LeLog( LOGGER_LABEL );
-	le_pipeline_manager_o* pipeline_manager = renderer_i.get_pipeline_manager( stage->renderer );
+struct animation_channel_eval_t {
+	le_animation_channel_o* channel;
+	uint64_t                ticks; // animation time at which to evaluate channel
+};
 
-	// First, collect all possible shader define permutations based on shader #defines.
-	// since this will control how many instances of our shader we must send to the shader compiler.
+struct animation_channel_job_t {
+	animation_channel_eval_t const* begin;
+	animation_channel_eval_t const* end;
+};
 
-	std::unordered_map<uint64_t, std::string, IdentityHash> materials_defines_hash_to_defines_str; // map from materials defines hash to define string
-	std::vector<uint64_t>                                   defines_hash_at_material_idx;          // table from material inded to materials define hash
+static void animation_channel_job_run( void* param ) {
+	auto job = static_cast<animation_channel_job_t const*>( param );
+	for ( auto e = job->begin; e != job->end; e++ ) {
+		animation_channel_evaluate( e->channel, e->ticks );
+	}
+}
 
-	std::unordered_map<uint64_t, std::string, IdentityHash> vertex_input_defines_hash_to_defines_str; // map from vertex input defines hash to define string
+// ----------------------------------------------------------------------
+/// \brief Evaluate all given channels - channels are independent of each other,
+/// which means that we may evaluate them on le_jobs worker threads, if available.
+static void animation_channels_evaluate( animation_channel_eval_t const* evals, uint32_t num_evals ) {
 
-	struct shader_defines_signature {
-		uint64_t hash_vertex_input_defines;
-		uint64_t hash_materials_defines;
-	};
+	uint32_t const num_workers = le_jobs::get_worker_thread_count();
 
-	struct shader_programs {
-		shader_defines_signature signature;
-		le_shader_module_handle  vert;
-		le_shader_module_handle  frag;
-	};
+	uint32_t const num_jobs =
+	    num_workers && num_evals >= 2 * ANIMATION_MIN_CHANNELS_PER_JOB
+	        ? std::min( num_workers * 4, num_evals / ANIMATION_MIN_CHANNELS_PER_JOB )
+	        : 1;
 
-	std::unordered_map<uint64_t, shader_programs, IdentityHash> shader_map;
+	if ( num_jobs == 1 ) {
+		animation_channel_job_t job{ evals, evals + num_evals };
+		animation_channel_job_run( &job );
+		return;
+	}
 
-	// -- First build up a map of all defines for materials
+	std::vector<animation_channel_job_t> channel_jobs( num_jobs );
+	std::vector<le_jobs::job_t>          jobs( num_jobs );
 
-	defines_hash_at_material_idx.reserve( stage->materials.size() );
+	for ( uint32_t i = 0; i != num_jobs; i++ ) {
+		channel_jobs[ i ] = { evals + uint64_t( num_evals ) * i / num_jobs,
+		                      evals + uint64_t( num_evals ) * ( i + 1 ) / num_jobs };
+		jobs[ i ]         = { animation_channel_job_run, &channel_jobs[ i ] };
+	}
 
-	for ( auto& material : stage->materials ) {
+	le_jobs::counter_t* counter;
+	le_jobs::run_jobs( jobs.data(), num_jobs, &counter );
+	le_jobs::wait_for_counter_and_free( counter, 0 );
+}
 
-		/** -- Update material properties - cache material texture transform matrices.
-		 *
-		 * For each texture, we add a define, and we cache the texture handle and the associated
-		 * texture info data with the material.
-		 *
-		 * For the material ubos we combine these so that all material data can be uploded in a
-		 * single ubo.
-		 *
-		 * We do this so that the material has a local cache of all the information
-		 * it needs when it gets bound on a primitive.
-		 *
-		 */
+// ----------------------------------------------------------------------
+/// \brief Inverse of a matrix which we know to be affine, i.e. its last row is (0,0,0,1)
+/// - which is the case for any transform built from translation, rotation, and scale.
+/// This is much cheaper than a general 4x4 inverse.
+static inline glm::mat4 affine_inverse( glm::mat4 const& m ) {
+	glm::mat3 const inv = glm::inverse( glm::mat3( m ) );
+	glm::vec3 const t   = -( inv * glm::vec3( m[ 3 ] ) );
+	return glm::mat4( glm::vec4( inv[ 0 ], 0.f ),
+	                  glm::vec4( inv[ 1 ], 0.f ),
+	                  glm::vec4( inv[ 2 ], 0.f ),
+	                  glm::vec4( t, 1.f ) );
+}
 
-		std::stringstream defines;
+// ----------------------------------------------------------------------
+/// \brief Update transforms for slots [begin, end[, all of which must be on the same level.
+/// Global transforms are only re-calculated if the local transform, or the parent's
+/// global transform changed - so that static subtrees cost next to nothing.
+static void transform_hierarchy_update_slots( le_transform_hierarchy_o* self, uint32_t begin, uint32_t end ) {
 
-		uint32_t num_textures = 0;
+	constexpr uint32_t NO_PARENT = le_transform_hierarchy_o::NO_PARENT;
 
-		auto add_texture = [ & ]( char const* texture_name, const le_texture_view_o* tex_info ) {
-			defines << "HAS_" << texture_name << "_MAP,";
+	for ( uint32_t slot = begin; slot != end; slot++ ) {
 
-			material.texture_handles.push_back( stage->textures[ tex_info->texture_id ].texture_handle );
+		bool const local_changed = self->local_dirty[ slot ];
 
-			if ( tex_info->has_transform ) {
-				defines << "HAS_" << texture_name << "_UV_TRANSFORM,";
-				// must push back 3 vec3 for the transform matrix
-				le_material_o::UboTextureParamsSlice vec_0{};
-				le_material_o::UboTextureParamsSlice vec_1{};
-				le_material_o::UboTextureParamsSlice vec_2{};
-				vec_0.slice.vec = glm::vec4( tex_info->transform[ 0 ], 0 );
-				vec_1.slice.vec = glm::vec4( tex_info->transform[ 1 ], 0 );
-				vec_2.slice.vec = glm::vec4( tex_info->transform[ 2 ], 0 );
-				material.cached_texture_params.emplace_back( vec_0 );
-				material.cached_texture_params.emplace_back( vec_1 );
-				material.cached_texture_params.emplace_back( vec_2 );
-			}
+		if ( local_changed ) {
+			// Equivalent to translate( T ) * mat4_cast( R ) * scale( S ), but without the matrix multiplications.
+			glm::mat3 const r = glm::mat3_cast( self->rotation[ slot ] );
+			glm::vec3 const s = self->scale[ slot ];
 
-			le_material_o::UboTextureParamsSlice params{};
-			params.slice.data.scale   = tex_info->scale;
-			params.slice.data.uv_set  = tex_info->uv_set;
-			params.slice.data.tex_idx = num_textures;
-			material.cached_texture_params.emplace_back( params );
+			self->local[ slot ] = glm::mat4( glm::vec4( r[ 0 ] * s.x, 0.f ),
+			                                 glm::vec4( r[ 1 ] * s.y, 0.f ),
+			                                 glm::vec4( r[ 2 ] * s.z, 0.f ),
+			                                 glm::vec4( self->translation[ slot ], 1.f ) );
 
-			num_textures++;
-		};
+			self->local_dirty[ slot ] = 0;
+		}
 
-		// clang-format off
-					if ( material.normal_texture )    add_texture( "NORMAL"     , material.normal_texture    );
-					if ( material.occlusion_texture ) add_texture( "OCCLUSION"  , material.occlusion_texture );
-		// clang-format on
+		uint32_t const parent = self->parent[ slot ];
 
-		if ( material.emissive_texture ) {
-			add_texture( "EMISSIVE", material.emissive_texture );
-			le_material_o::UboTextureParamsSlice emissive_factor{};
-			emissive_factor.slice.vec = glm::vec4( material.emissive_factor, 1 );
-			material.cached_texture_params.emplace_back( emissive_factor );
+		bool const global_changed = local_changed || ( parent != NO_PARENT && self->global_dirty[ parent ] );
+
+		self->global_dirty[ slot ] = global_changed;
+
+		if ( global_changed ) {
+			self->global[ slot ] =
+			    parent != NO_PARENT
+			        ? self->global[ parent ] * self->local[ slot ]
+			        : self->local[ slot ];
+
+			self->inverse_global[ slot ] = affine_inverse( self->global[ slot ] );
 		}
+	}
+}
 
-		if ( material.metallic_roughness ) {
-			defines << "MATERIAL_METALLICROUGHNESS,";
-			if ( material.metallic_roughness->base_color ) {
-				add_texture( "BASE_COLOR", material.metallic_roughness->base_color );
-			}
-			if ( material.metallic_roughness->metallic_roughness ) {
-				add_texture( "METALLIC_ROUGHNESS", material.metallic_roughness->metallic_roughness );
-			}
+// ----------------------------------------------------------------------
+
+// Levels with fewer slots than this are updated on the calling thread.
+static constexpr uint32_t TRANSFORM_MIN_SLOTS_PER_JOB = 4096;
+
+struct transform_hierarchy_job_t {
+	le_transform_hierarchy_o* hierarchy;
+	uint32_t                  begin;
+	uint32_t                  end;
+};
+
+static void transform_hierarchy_job_run( void* param ) {
+	auto job = static_cast<transform_hierarchy_job_t const*>( param );
+	transform_hierarchy_update_slots( job->hierarchy, job->begin, job->end );
+}
+
+// ----------------------------------------------------------------------
+/// \brief Update local, global, and inverse global transforms for all slots which
+/// (or whose ancestors) had their local translation, rotation, or scale changed.
+/// Large levels are split across le_jobs worker threads, if available.
+static void transform_hierarchy_update( le_transform_hierarchy_o* self ) {
+
+	if ( !self->has_local_changes ) {
+		// Nothing changed - but we must make sure that no slot is flagged as having changed.
+		if ( self->has_global_changes ) {
+			std::fill( self->global_dirty.begin(), self->global_dirty.end(), uint8_t( 0 ) );
+			self->has_global_changes = false;
 		}
+		return;
+	}
 
-		if ( num_textures ) {
-			defines << "HAS_TEXTURES=" << num_textures << ",";
+	uint32_t const num_workers = le_jobs::get_worker_thread_count();
+
+	std::vector<transform_hierarchy_job_t> hierarchy_jobs;
+	std::vector<le_jobs::job_t>            jobs;
+
+	for ( size_t l = 0; l + 1 < self->level_offsets.size(); l++ ) {
+
+		uint32_t const level_begin = self->level_offsets[ l ];
+		uint32_t const level_end   = self->level_offsets[ l + 1 ];
+		uint32_t const num_slots   = level_end - level_begin;
+
+		// Levels depend on their parent levels, so we must wait for each level to complete.
+
+		uint32_t const num_jobs =
+		    num_workers && num_slots >= 2 * TRANSFORM_MIN_SLOTS_PER_JOB
+		        ? std::min( num_workers * 4, num_slots / TRANSFORM_MIN_SLOTS_PER_JOB )
+		        : 1;
+
+		if ( num_jobs == 1 ) {
+			transform_hierarchy_update_slots( self, level_begin, level_end );
+			continue;
 		}
 
-		std::string defines_str  = defines.str();
-		uint64_t    defines_hash = SpookyHash::Hash64( defines_str.data(), defines_str.size(), 0 );
+		hierarchy_jobs.resize( num_jobs );
+		jobs.resize( num_jobs );
 
-		defines_hash_at_material_idx.push_back( defines_hash );
-		materials_defines_hash_to_defines_str.insert( { defines_hash, std::move( defines_str ) } );
+		for ( uint32_t i = 0; i != num_jobs; i++ ) {
+			hierarchy_jobs[ i ] = { self,
+			                        level_begin + uint32_t( uint64_t( num_slots ) * i / num_jobs ),
+			                        level_begin + uint32_t( uint64_t( num_slots ) * ( i + 1 ) / num_jobs ) };
+			jobs[ i ]           = { transform_hierarchy_job_run, &hierarchy_jobs[ i ] };
+		}
+
+		le_jobs::counter_t* counter;
+		le_jobs::run_jobs( jobs.data(), num_jobs, &counter );
+		le_jobs::wait_for_counter_and_free( counter, 0 );
 	}
 
-	// -- Then build a map of all vertex input defines per primitive
+	self->has_local_changes  = false;
+	self->has_global_changes = true;
+}
 
-	for ( auto& mesh : stage->meshes ) {
+// ----------------------------------------------------------------------
+/// \brief Assign a joint palette entry to each skinned node with a mesh, and lay out
+/// matrices for all entries.
+static void joint_palette_build_layout( le_joint_palette_o* self, std::vector<le_node_o*> const& nodes ) {
 
-		for ( auto& primitive : mesh.primitives ) {
+	self->entries.clear();
 
-			std::stringstream defines;
+	uint32_t num_matrices = 0;
 
-			auto const attr_begin = primitive.attributes.data();
-			auto const attr_end   = attr_begin + primitive.attributes.size();
+	for ( le_node_o* n : nodes ) {
 
-			{
-				// Find out if the primitive has morph targets - as this will
-				// inform the number of locations which each attribute occupies.
-				//
-				uint32_t morph_target_count = uint32_t( primitive.morph_target_count );
-				uint32_t location           = 0; // current location for attribute.
+		if ( !n->skin || !n->has_mesh ) {
+			continue;
+		}
 
-				if ( morph_target_count ) {
-					defines << "MORPH_TARGET_COUNT=" << morph_target_count << ",";
-				}
+		le_node_o const* root = n->skin->skeleton ? n->skin->skeleton : n;
 
-				// TODO: check number of requested locations against device limits.
-				//
-				// uint32_t max_location = primitive.attributes.size() ;
-				// assert(max_location < 17 && "cannot not bind more than 16 locations.");
+		auto it = std::find_if( self->entries.begin(), self->entries.end(), [ & ]( le_joint_palette_o::entry_t const& e ) {
+			return e.skin == n->skin && e.root == root;
+		} );
 
-				for ( auto attr = attr_begin; attr != attr_end; ) {
+		if ( it != self->entries.end() ) {
+			n->joint_palette_idx = uint32_t( it - self->entries.begin() );
+			continue;
+		}
 
-					// Find out how how many attibutes of the same type each exist
-					// (this gives us the array size per attribute)
+		uint32_t const num_joints_aligned =
+		    ( uint32_t( n->skin->joints.size() ) + le_joint_palette_o::ALIGNMENT - 1 ) & ~( le_joint_palette_o::ALIGNMENT - 1 );
 
-					uint32_t num_array_elements = 0;
-					for ( auto a = attr; a != attr_end && a->type == attr->type; a++, num_array_elements++ ) {
-					}
+		n->joint_palette_idx = uint32_t( self->entries.size() );
+		self->entries.push_back( { n->skin, root, num_matrices, num_matrices + num_joints_aligned } );
 
-					switch ( attr->type ) {
-					case ( le_primitive_attribute_info::Type::ePosition ):
-						defines << "LOC_POSITIONS=" << location << ",";
-						defines << "NUM_POSITIONS=" << num_array_elements << ",";
-						if ( num_array_elements > 1 ) {
-							assert( num_array_elements == ( morph_target_count + 1 ) && "number of array elements must match 1 + morph_target_count" );
-						}
-						break;
-					case ( le_primitive_attribute_info::Type::eNormal ):
-						defines << "LOC_NORMALS=" << location << ",";
-						defines << "NUM_NORMALS=" << num_array_elements << ",";
-						if ( num_array_elements > 1 ) {
-							assert( num_array_elements == ( morph_target_count + 1 ) && "number of array elements must match 1 + morph_target_count" );
-						}
-						break;
-					case ( le_primitive_attribute_info::Type::eTangent ):
-						defines << "LOC_TANGENTS=" << location << ",";
-						defines << "NUM_TANGENTS=" << num_array_elements << ",";
-						if ( num_array_elements > 1 ) {
-							assert( num_array_elements == ( morph_target_count + 1 ) && "number of array elements must match 1 + morph_target_count" );
-						}
-						break;
-					case ( le_primitive_attribute_info::Type::eTexcoord ):
-						defines << "LOC_TEXCOORDS=" << location << ",";
-						defines << "NUM_TEXCOORDS=" << num_array_elements << ",";
-						break;
-					case ( le_primitive_attribute_info::Type::eColor ):
-						defines << "LOC_COLORS=" << location << ",";
-						defines << "NUM_COLORS=" << num_array_elements << ",";
-						break;
-					case ( le_primitive_attribute_info::Type::eJoints ):
-						defines << "LOC_JOINT_SETS=" << location << ",";
-						defines << "NUM_JOINT_SETS=" << num_array_elements << ",";
-						break;
-					case ( le_primitive_attribute_info::Type::eJointWeights ):
-						defines << "LOC_JOINT_WEIGHTS_SET=" << location << ",";
-						defines << "NUM_JOINT_WEIGHTS_SET=" << num_array_elements << ",";
-						break;
-					default:
-						break;
-					}
+		num_matrices += 2 * num_joints_aligned;
+	}
 
-					location += num_array_elements;
-					attr += num_array_elements;
-				}
-			}
+	self->matrices.clear();
+	self->matrices.resize( num_matrices, glm::identity<glm::mat4>() );
 
-			std::string vertex_input_defines = defines.str();
+	if ( num_matrices ) {
+		self->handle        = LE_BUF_RESOURCE( "le_stage_joint_palette" );
+		self->resource_info = le::BufferInfoBuilder()
+		                          .setSize( uint32_t( sizeof( glm::mat4 ) * num_matrices ) )
+		                          .addUsageFlags( le::BufferUsageFlagBits::eTransferDst | le::BufferUsageFlagBits::eStorageBuffer )
+		                          .build();
+	}
 
-			uint64_t vertex_input_defines_hash = SpookyHash::Hash64( vertex_input_defines.data(),
-			                                                         vertex_input_defines.size(), 0 );
+	self->needs_layout = false;
+}
 
-			// Store shader defines string if not yet present
-			vertex_input_defines_hash_to_defines_str.insert( { vertex_input_defines_hash, std::move( vertex_input_defines ) } );
+// ----------------------------------------------------------------------
+/// \brief Calculate joint matrices, and joint normal matrices for palette entries [begin, end[,
+/// skipping entries for which neither joints nor root moved during the most recent update.
+/// Returns number of entries which were re-calculated.
+static uint32_t joint_palette_update_entries( le_joint_palette_o* self, le_transform_hierarchy_o const* transforms, bool force, uint32_t begin, uint32_t end ) {
 
-			// Build a shader defines signature from vertex input defines and materials defines for this primitive.
-			// We will use this later to look up the correct shader for the primitive.
+	uint32_t num_updated = 0;
 
-			shader_defines_signature signature{};
-			if ( primitive.has_material ) {
-				signature.hash_materials_defines = defines_hash_at_material_idx[ primitive.material_idx ];
-			}
-			signature.hash_vertex_input_defines = vertex_input_defines_hash;
+	for ( uint32_t i = begin; i != end; i++ ) {
 
-			primitive.all_defines_hash = SpookyHash::Hash64( &signature, sizeof( signature ), 0 );
+		le_joint_palette_o::entry_t const& e = self->entries[ i ];
 
-			// Inserting an element with null shader module pointers prepares for the next step, where
-			// we will iterate through the map of unique shader signatures, and instantiate shaders
-			// based on signatures.
-			shader_map.insert( { primitive.all_defines_hash, { signature, nullptr, nullptr } } );
+		std::vector<le_node_o*> const& joints = e.skin->joints;
+
+		uint32_t const root_slot = transforms->slot_of_node[ e.root->idx ];
+
+		bool changed = force || transforms->global_dirty[ root_slot ];
+
+		for ( size_t j = 0; !changed && j != joints.size(); j++ ) {
+			changed = transforms->global_dirty[ transforms->slot_of_node[ joints[ j ]->idx ] ];
 		}
-	}
 
-	// Get set of unique combinations of vertex inputs
-	// and material defines, and associate a shader with each.
+		if ( !changed ) {
+			continue;
+		}
 
-	// Create shaders from unique defines
+		// Joint matrices are given relative to the root: glTF does not really define
+		// what should happen if a skin does not specify its skeleton property - we
+		// then use the skinned node as the root.
+
+		glm::mat4 const& root_inv = transforms->inverse_global[ root_slot ];
+
+		glm::mat4* joint_matrices        = self->matrices.data() + e.offset;
+		glm::mat4* joint_normal_matrices = self->matrices.data() + e.normals_offset;
+
+		for ( size_t j = 0; j != joints.size(); j++ ) {
+			joint_matrices[ j ] =
+			    root_inv *
+			    transforms->global[ transforms->slot_of_node[ joints[ j ]->idx ] ] *
+			    e.skin->inverse_bind_matrices[ j ];
+
+			// Normal matrix for each joint matrix. Joint matrices are affine,
+			// which means we can use the much cheaper affine inverse.
+			joint_normal_matrices[ j ] = glm::transpose( affine_inverse( joint_matrices[ j ] ) );
+		}
+
+		num_updated++;
+	}
+
+	return num_updated;
+}
 
-	for ( auto& shader : shader_map ) {
+// ----------------------------------------------------------------------
 
-		std::string defines = vertex_input_defines_hash_to_defines_str[ shader.second.signature.hash_vertex_input_defines ];
-		defines             = defines + materials_defines_hash_to_defines_str[ shader.second.signature.hash_materials_defines ];
+// If there are fewer palette entries than this, entries are updated on the calling thread.
+static constexpr uint32_t JOINT_PALETTE_MIN_ENTRIES_PER_JOB = 16;
 
-		logger.info( "Creating shader instance using defines: \n\t'-D%s'", defines.c_str() );
+struct joint_palette_job_t {
+	le_joint_palette_o*             palette;
+	le_transform_hierarchy_o const* transforms;
+	bool                            force;
+	uint32_t                        begin;
+	uint32_t                        end;
+	uint32_t                        num_updated; // written by job
+};
 
-		shader.second.vert = LeShaderModuleBuilder( pipeline_manager ).setSourceFilePath( "./resources/shaders/le_stage/gltf.vert" ).setShaderStage( le::ShaderStage::eVertex ).setSourceDefinesString( defines.c_str() ).build();
-		shader.second.frag = LeShaderModuleBuilder( pipeline_manager ).setSourceFilePath( "./resources/shaders/le_stage/metallic-roughness.frag" ).setShaderStage( le::ShaderStage::eFragment ).setSourceDefinesString( defines.c_str() ).build();
-	}
+static void joint_palette_job_run( void* param ) {
+	auto job         = static_cast<joint_palette_job_t*>( param );
+	job->num_updated = joint_palette_update_entries( job->palette, job->transforms, job->force, job->begin, job->end );
+}
 
-	std::unordered_map<le_gpso_handle, uint64_t> pipelineCount; // Only used for debug purposes, count number of unique pipelines
+// ----------------------------------------------------------------------
+/// \brief Calculate joint matrices for each skin exactly once per frame - and only
+/// if any of its joints moved. Must be called after transforms have been updated.
+static void joint_palette_update( le_joint_palette_o* self, le_transform_hierarchy_o const* transforms, std::vector<le_node_o*> const& nodes ) {
 
-	// associate each primitive with shader matching defines id
+	bool force = false;
 
-	for ( auto& mesh : stage->meshes ) {
+	if ( self->needs_layout ) {
+		joint_palette_build_layout( self, nodes );
+		force = true; // all matrices are new
+	}
 
-		for ( auto& primitive : mesh.primitives ) {
+	uint32_t const num_entries = uint32_t( self->entries.size() );
 
-			if ( !primitive.pipeline_state_handle ) {
+	if ( num_entries == 0 || ( !force && !transforms->has_global_changes ) ) {
+		return;
+	}
 
-				// We must create a graphics pipeline state object (GPSO) for this primitive.
-				// The PSO captures everything needed for a material.
+	uint32_t const num_workers = le_jobs::get_worker_thread_count();
 
-				// We use an uber-shader to render materials; therefore our shader needs to simulate/handle
-				// missing attributes.
-				// We deactivate missing attributes via the shader preprocessor.
+	uint32_t const num_jobs =
+	    num_workers && num_entries >= 2 * JOINT_PALETTE_MIN_ENTRIES_PER_JOB
+	        ? std::min( num_workers * 4, num_entries / JOINT_PALETTE_MIN_ENTRIES_PER_JOB )
+	        : 1;
 
-				// -- Precondition: primitive.attributes are pre-sorted by type, then name,
-				// so that name "TEX_COORD_0" appears before "TEX_COORD_1",
-				// and normal attributes appear before tangent attributes etc.
+	uint32_t num_updated = 0;
 
-				LeGraphicsPipelineBuilder builder( pipeline_manager );
+	if ( num_jobs == 1 ) {
+		num_updated = joint_palette_update_entries( self, transforms, force, 0, num_entries );
+	} else {
 
-				le_shader_module_handle shader_frag{};
-				le_shader_module_handle shader_vert{};
+		std::vector<joint_palette_job_t> palette_jobs( num_jobs );
+		std::vector<le_jobs::job_t>      jobs( num_jobs );
 
-				auto shaders = shader_map.find( primitive.all_defines_hash );
+		for ( uint32_t i = 0; i != num_jobs; i++ ) {
+			palette_jobs[ i ] = { self, transforms, force,
+			                      uint32_t( uint64_t( num_entries ) * i / num_jobs ),
+			                      uint32_t( uint64_t( num_entries ) * ( i + 1 ) / num_jobs ),
+			                      0 };
+			jobs[ i ]         = { joint_palette_job_run, &palette_jobs[ i ] };
+		}
 
-				assert( shaders != shader_map.end() && "shader must be existing, and valid" );
+		le_jobs::counter_t* counter;
+		le_jobs::run_jobs( jobs.data(), num_jobs, &counter );
+		le_jobs::wait_for_counter_and_free( counter, 0 );
 
-				shader_frag = shaders->second.frag;
-				shader_vert = shaders->second.vert;
+		for ( auto const& j : palette_jobs ) {
+			num_updated += j.num_updated;
+		}
+	}
 
-				if ( shader_frag ) {
-					builder.addShaderStage( shader_frag );
-				}
+	self->needs_upload |= ( num_updated != 0 );
+}
 
-				if ( shader_vert ) {
-					builder.addShaderStage( shader_vert );
-				}
+// ----------------------------------------------------------------------
+/// \brief Whether `group` may be drawn via the same draw-indirect-count as `base`, with `base`'s buffers
+/// bound: both must share scene, pipeline, material, and buffers, at offsets from which we can reach
+/// `group`'s vertices, and indices via vertex offset, and first index. If so, sets these on `group`.
+static bool gpu_draws_group_join_batch( le_stage_o const* stage, le_gpu_draws_o::group_t const& base, le_gpu_draws_o::group_t& group ) {
 
-				assert( shader_frag && "shader_frag must be valid" );
-				assert( shader_vert && "shader_vert must be valid" );
+	if ( group.scene_idx != base.scene_idx || group.pipeline != base.pipeline || group.material_idx != base.material_idx ) {
+		return false;
+	}
 
-				// builder
-				//				    .withRasterizationState()
-				//				    .setCullMode( le::CullModeFlagBits::eBack )
-				//				    .setFrontFace( le::FrontFace::eClockwise )
-				// 			    .end();
+	le_primitive_o const& a = stage->meshes[ base.mesh_idx ].primitives[ base.primitive_idx ];
+	le_primitive_o const& b = stage->meshes[ group.mesh_idx ].primitives[ group.primitive_idx ];
 
-				primitive.bindings_buffer_handles.clear();
-				primitive.bindings_buffer_offsets.clear();
+	if ( a.has_indices != b.has_indices || a.bindings_buffer_handles != b.bindings_buffer_handles ) {
+		return false;
+	}
 
-				// Calculate Attribute Bindings for this PSO.
+	// All bindings must be offset by the same number of vertices - primitives which share a
+	// pipeline share their vertex input state, and therefore their binding strides.
 
-				auto& abs =
-				    builder.withAttributeBindingState();
+	uint64_t vertex_offset = 0;
 
-				// We must group our attributes by bufferviews.
-				//
-				// Only if there is interleaving we have more than one attribute per buffer binding,
-				// otherwise each binding takes its own buffer.
-				//
-				// + We must detect interleaving:
-				// - 1. gltf requirement: if bufferview.byteStride != 0, then there is interleaving.
-				// - 2. if more than one accessor refer to the same bufferview, we have interleaving.
-				//
-				// We must group by bufferViews: Each bufferview will mean one binding -
-				// as each bufferview refers to a buffer, and an offset into that buffer
-				//
-				// Q: if there is interleaving, does this mean that two or more accessors refer to the same
-				// bufferview?
-				//
-				// A: yes, in that case multiple accessors may refer to the same bufferView, in which case each accessor
-				//    defines a byteOffset to specify where it starts within the bufferView.
+	for ( size_t i = 0; i != b.bindings_buffer_offsets.size(); i++ ) {
 
-				// Note: iterator is increased in inner do-while loop
-				for ( auto it = primitive.attributes.begin(); it != primitive.attributes.end(); ) {
+		uint64_t const stride = b.bindings_buffer_strides[ i ];
 
-					le_accessor_o const* accessor        = &stage->accessors[ it->accessor_idx ];
-					auto const&          buffer_view     = stage->buffer_views[ accessor->buffer_view_idx ];
-					uint32_t             buffer_view_idx = accessor->buffer_view_idx;
+		if ( stride == 0 || b.bindings_buffer_offsets[ i ] < a.bindings_buffer_offsets[ i ] ) {
+			return false;
+		}
 
-					auto& binding = abs.addBinding( uint16_t( buffer_view.byte_stride ) );
+		uint64_t const delta = b.bindings_buffer_offsets[ i ] - a.bindings_buffer_offsets[ i ];
 
-					// If no explicit buffer_view.byte_stride was given, we accumulate each accessor's
-					// storage size so that we can set the stride of the binding based on the sum total
-					// of a bindning's accessors at the end.
-					//
-					uint16_t accessors_total_byte_count = 0;
+		if ( delta % stride != 0 || ( i != 0 && delta / stride != vertex_offset ) ) {
+			return false;
+		}
 
-					do {
+		vertex_offset = delta / stride;
+	}
 
-						if ( 0 == buffer_view.byte_stride ) {
-							accessors_total_byte_count += size_of( accessor->component_type ) *
-							                              get_num_components( accessor->type );
-						}
+	if ( vertex_offset > uint64_t( INT32_MAX ) ) {
+		return false;
+	}
 
-						// Add attributes until buffer_view_idx changes.
-						// in which case we want to open the next binding.
-						//
-						// if the buffer_view_idx doesn't change, this means that we are still within the same
-						// binding, because then we have interleaving.
-						//
-						// every accessor mapping the same buffer will go into the same binding number
-						// because that's what the encoder will bind in the end.
-						binding.addAttribute( uint16_t( accessor->byte_offset ),
-						                      accessor->component_type,
-						                      get_num_components( accessor->type ), // calculate number of components
-						                      accessor->is_normalized );
+	uint64_t first_index = 0;
 
-						it++;
+	if ( b.has_indices ) {
 
-						// prepare accessor for next iteration.
-						if ( it != primitive.attributes.end() ) {
-							accessor = &stage->accessors[ it->accessor_idx ];
-						}
+		le_accessor_o const&    a_indices = stage->accessors[ a.indices_accessor_idx ];
+		le_accessor_o const&    b_indices = stage->accessors[ b.indices_accessor_idx ];
+		le_buffer_view_o const& a_view    = stage->buffer_views[ a_indices.buffer_view_idx ];
+		le_buffer_view_o const& b_view    = stage->buffer_views[ b_indices.buffer_view_idx ];
 
-					} while ( it != primitive.attributes.end() &&
-					          buffer_view_idx == accessor->buffer_view_idx );
+		if ( a_indices.component_type != b_indices.component_type ||
+		     a_view.buffer_idx != b_view.buffer_idx ||
+		     b_view.byte_offset < a_view.byte_offset ) {
+			return false;
+		}
 
-					// Cache binding for primitive so that we can bind faster.
+		uint64_t const delta      = b_view.byte_offset - a_view.byte_offset;
+		uint64_t const index_size = size_of( b_indices.component_type );
 
-					primitive.bindings_buffer_handles.push_back( stage->buffers[ buffer_view.buffer_idx ]->handle );
-					primitive.bindings_buffer_offsets.push_back( buffer_view.byte_offset );
+		if ( delta % index_size != 0 || delta / index_size > UINT32_MAX ) {
+			return false;
+		}
 
-					if ( 0 == buffer_view.byte_stride ) {
-						// If stride was not explicitly specified - this will be non-zero,
-						// telling us that we must set stride here.
-						binding.setStride( accessors_total_byte_count );
-					}
+		first_index = delta / index_size;
+	}
 
-					binding.end();
-				}
+	group.vertex_offset = int32_t( vertex_offset );
+	group.first_index   = uint32_t( first_index );
 
-				// Fill in number of vertices for primitive
-				if ( !primitive.attributes.empty() ) {
-					primitive.vertex_count = stage->accessors[ primitive.attributes.front().accessor_idx ].count;
-				}
+	return true;
+}
 
-				if ( primitive.has_indices ) {
-					primitive.index_count = stage->accessors[ primitive.indices_accessor_idx ].count;
-				}
+// ----------------------------------------------------------------------
+/// \brief Group instanceable primitives of all mesh nodes, so that each group may be drawn via a single
+/// indirect draw, and lay out instances, and draw commands. Must be called after pipelines were set up.
+static void gpu_draws_build( le_gpu_draws_o* self, le_stage_o const* stage ) {
+
+	struct item_t {
+		le_gpso_handle pipeline;
+		uint32_t       scene_idx;
+		uint32_t       material_idx;
+		uint32_t       mesh_idx;
+		uint32_t       primitive_idx;
+		uint32_t       node_idx;
+	};
 
-				primitive.pipeline_state_handle = builder.build();
-				pipelineCount[ primitive.pipeline_state_handle ]++;
-			}
+	std::vector<item_t> items;
 
-		} // end for all mesh.primitives
-	}     // end for all meshes
+	for ( uint32_t scene_idx = 0; scene_idx != stage->scenes.size(); scene_idx++ ) {
 
-	logger.info( "Pipelines in use:" );
-	for ( auto& p : pipelineCount ) {
-		logger.info( "%x : %d", p.first, p.second );
-	}
+		uint32_t const scene_bit = 1 << stage->scenes[ scene_idx ].scene_id;
 
-#ifdef LE_FEATURE_RTX
-	{
-		// -- Create top level acceleration structure for each scene.
+		for ( le_node_o const* n : stage->nodes ) {
 
-		// For each TLAS we must know the number of nodes which contribute,
-		// as each node maps to one instance.
+			if ( !n->has_mesh || !( n->scene_bit_flags & scene_bit ) ) {
+				continue;
+			}
 
-		std::vector<uint32_t> node_count_per_scene;
+			auto const& primitives = stage->meshes[ n->mesh_idx ].primitives;
 
-		uint32_t const scenes_count = uint32_t( stage->scenes.size() );
-		node_count_per_scene.resize( scenes_count, 0 );
+			for ( uint32_t p = 0; p != primitives.size(); p++ ) {
+				le_primitive_o const& primitive = primitives[ p ];
 
-		// -- Count mesh nodes per scene:
-		for ( auto const& n : stage->nodes ) {
-			if ( n->has_mesh ) {
-				for ( uint32_t i = 0; i != scenes_count; i++ ) {
-					if ( 1 << i & n->scene_bit_flags ) {
-						node_count_per_scene[ i ]++;
-					}
+				if ( !primitive.pipeline_state_handle || !primitive_is_instanceable( primitive, n ) ) {
+					continue;
 				}
+
+				items.push_back( { primitive.pipeline_state_handle, scene_idx,
+				                   primitive.has_material ? primitive.material_idx : ~0u,
+				                   n->mesh_idx, p, n->idx } );
 			}
 		}
+	}
 
-		// Associate a TLAS with each scene.
-		for ( uint32_t i = 0; i != scenes_count; i++ ) {
-			char rtx_tlas_resource_name[ 17 ]{};
-			snprintf( rtx_tlas_resource_name, sizeof( rtx_tlas_resource_name ), "tlas_%08u", i );
+	std::sort( items.begin(), items.end(), []( item_t const& lhs, item_t const& rhs ) {
+		return std::tie( lhs.scene_idx, lhs.pipeline, lhs.material_idx, lhs.mesh_idx, lhs.primitive_idx, lhs.node_idx ) <
+		       std::tie( rhs.scene_idx, rhs.pipeline, rhs.material_idx, rhs.mesh_idx, rhs.primitive_idx, rhs.node_idx );
+	} );
 
-			// -- Create top-level accelerator for this scene
-			stage->scenes[ i ].rtx_tlas_handle = le_renderer::renderer_i.produce_tlas_resource_handle( rtx_tlas_resource_name );
+	self->groups.clear();
+	self->instances.clear();
+	self->instance_nodes.clear();
 
-			le::BuildAccelerationStructureFlagsKHR tlas_flags =
-			    le::BuildAccelerationStructureFlagBitsKHR::eAllowUpdateBitKhr |
-			    le::BuildAccelerationStructureFlagBitsKHR::ePreferFastBuildBitKhr;
+	for ( item_t const& item : items ) {
 
-			le_resource_info_t resource_info{};
+		if ( self->groups.empty() ||
+		     std::tie( item.scene_idx, item.pipeline, item.material_idx, item.mesh_idx, item.primitive_idx ) !=
+		         std::tie( self->groups.back().scene_idx, self->groups.back().pipeline, self->groups.back().material_idx,
+		                   self->groups.back().mesh_idx, self->groups.back().primitive_idx ) ) {
+			self->groups.push_back( { item.pipeline, item.scene_idx, item.material_idx, item.mesh_idx, item.primitive_idx,
+			                          uint32_t( self->instances.size() ), 0 } );
+		}
 
-			resource_info.type      = LeResourceType::eRtxTlas;
-			resource_info.tlas.info = renderer_i.create_rtx_tlas_info( stage->renderer, node_count_per_scene[ i ], tlas_flags );
+		le_gpu_draws_o::group_t& group = self->groups.back();
+		le_mesh_o const&         mesh  = stage->meshes[ item.mesh_idx ];
 
-			stage->scenes[ i ].rtx_tlas_info = std::move( resource_info );
+		le_gpu_draws_o::instance_t instance{};
+		instance.group_idx      = uint32_t( self->groups.size() - 1 );
+		instance.first_instance = group.first_instance;
+
+		if ( mesh.has_bounds ) {
+			instance.bounds_min = mesh.bounds_min;
+			instance.bounds_max = mesh.bounds_max;
+		} else {
+			// Inverted bounds tell the cull shader that this instance must always be drawn.
+			instance.bounds_min = glm::vec3( 1 );
+			instance.bounds_max = glm::vec3( -1 );
 		}
+
+		self->instances.push_back( instance );
+		self->instance_nodes.push_back( item.node_idx );
+
+		group.instance_count++;
 	}
 
-#endif
-}
+	// Batch consecutive groups which may share bindings - each batch becomes one draw-indirect-count.
 
-// ----------------------------------------------------------------------
+	uint32_t const num_groups = uint32_t( self->groups.size() );
 
-template <typename T>
-void lerp_animation_target( T* target, T const& val_previous, T const& val_next, float norm_t ) {
-	T blend = glm::mix( val_previous, val_next, norm_t );
-	if ( target ) {
-		*target = blend;
-	}
-}
+	self->batches.clear();
 
-// Quaternions need to be slerped instead of mixed. They also must be normalised before application.
-template <>
-void lerp_animation_target<glm::quat>( glm::quat* target, glm::quat const& val_previous, glm::quat const& val_next, float norm_t ) {
-	glm::quat blend = glm::slerp( val_previous, val_next, norm_t );
-	blend           = glm::normalize( blend );
-	if ( target ) {
-		*target = blend;
-	}
-}
+	for ( uint32_t g = 0; g != num_groups; g++ ) {
+		le_gpu_draws_o::group_t& group = self->groups[ g ];
 
-// ----------------------------------------------------------------------
+		if ( self->batches.empty() || !gpu_draws_group_join_batch( stage, self->groups[ self->batches.back().first_group ], group ) ) {
+			self->batches.push_back( { g, 0 } );
+		}
 
-static void apply_animation_channel( le_animation_channel_o const& channel, uint64_t ticks ) {
+		group.batch_idx  = uint32_t( self->batches.size() - 1 );
+		group.batch_slot = self->batches.back().group_count++;
+	}
 
-	if ( channel.sampler.size() < 2 ) {
-		return;
+	for ( le_gpu_draws_o::instance_t& instance : self->instances ) {
+		instance.batch_idx  = self->groups[ instance.group_idx ].batch_idx;
+		instance.batch_slot = self->groups[ instance.group_idx ].batch_slot;
 	}
 
-	// -------- invariant: sampler has at least two elements.
+	// Draw command templates: the cull pass fills in instance counts, and draw counts,
+	// which is why these must be reset to zero every frame, by uploading the templates.
 
-	le_keyframe_o const* sampler_begin = channel.sampler.data();
-	le_keyframe_o const* sampler_end   = sampler_begin + channel.sampler.size();
+	self->commands.assign( size_t( le_gpu_draws_o::COMMAND_STRIDE ) * num_groups + self->batches.size(), 0 );
 
-	le_keyframe_o const* previous_key = sampler_begin;
-	le_keyframe_o const* next_key     = sampler_begin + 1;
+	for ( uint32_t g = 0; g != num_groups; g++ ) {
+		le_gpu_draws_o::group_t const& group     = self->groups[ g ];
+		le_primitive_o const&          primitive = stage->meshes[ group.mesh_idx ].primitives[ group.primitive_idx ];
+		uint32_t*                      command   = self->commands.data() + size_t( le_gpu_draws_o::COMMAND_STRIDE ) * g;
 
-	while ( ( next_key->delta_ticks < ticks ) && ( next_key + 1 != sampler_end ) ) {
-		std::swap( previous_key, next_key );
-		next_key++;
+		if ( primitive.has_indices ) {
+			command[ 0 ] = primitive.index_count; // indexCount, instanceCount, firstIndex, vertexOffset, firstInstance
+			command[ 2 ] = group.first_index;
+			command[ 3 ] = uint32_t( group.vertex_offset );
+			command[ 4 ] = group.first_instance;
+		} else {
+			command[ 0 ] = primitive.vertex_count; // vertexCount, instanceCount, firstVertex, firstInstance
+			command[ 2 ] = uint32_t( group.vertex_offset );
+			command[ 3 ] = group.first_instance;
+		}
 	}
 
-	if ( ticks > next_key->delta_ticks ) {
-		// we're done here.
+	self->transforms.resize( self->instances.size() );
 
-		// TODO:
-		// we should probably make sure that the target value is
-		// set to the value of the last keyframe, just in case
-		// this channel gets oversampled.
+	if ( !self->instances.empty() ) {
 
-		return;
-	}
+		self->instances_handle          = LE_BUF_RESOURCE( "le_stage_gpu_instances" );
+		self->transforms_handle         = LE_BUF_RESOURCE( "le_stage_gpu_instance_transforms" );
+		self->visible_transforms_handle = LE_BUF_RESOURCE( "le_stage_gpu_visible_transforms" );
+		self->commands_handle           = LE_BUF_RESOURCE( "le_stage_gpu_draw_commands" );
 
-	float norm_t = 0.f; // normalised time in domain [previous_key..[next_key
+		self->instances_info = le::BufferInfoBuilder()
+		                           .setSize( uint32_t( sizeof( le_gpu_draws_o::instance_t ) * self->instances.size() ) )
+		                           .addUsageFlags( le::BufferUsageFlagBits::eTransferDst | le::BufferUsageFlagBits::eStorageBuffer )
+		                           .build();
 
-	// -- calculate normalised time.
+		// Visible transforms use the same resource info as transforms.
+		self->transforms_info = le::BufferInfoBuilder()
+		                            .setSize( uint32_t( sizeof( le_instance_transform_t ) * self->transforms.size() ) )
+		                            .addUsageFlags( le::BufferUsageFlagBits::eTransferDst | le::BufferUsageFlagBits::eStorageBuffer )
+		                            .build();
 
-	norm_t = ( ticks - previous_key->delta_ticks ) /
-	         float( next_key->delta_ticks - previous_key->delta_ticks );
+		self->commands_info = le::BufferInfoBuilder()
+		                          .setSize( uint32_t( sizeof( uint32_t ) * self->commands.size() ) )
+		                          .addUsageFlags( le::BufferUsageFlagBits::eTransferDst | le::BufferUsageFlagBits::eStorageBuffer | le::BufferUsageFlagBits::eIndirectBuffer )
+		                          .build();
+	}
 
-	norm_t = glm::clamp( norm_t, 0.f, 1.f );
+	self->needs_build  = false;
+	self->needs_upload = true;
+}
 
-	// apply data to node pointed in channel, based on type.
+// ----------------------------------------------------------------------
+/// \brief Copy global transforms for gpu-drawn instances whose nodes moved during the most recent transform
+/// update, or for all instances if `force` is set - must be called after transforms have been updated.
+static void gpu_draws_update_transforms( le_gpu_draws_o* self, le_stage_o const* stage, bool force ) {
 
-	assert( previous_key->array_size == next_key->array_size && "keys must have same array size" );
+	le_transform_hierarchy_o const& hierarchy = stage->transforms;
 
-	switch ( channel.target_compound_type ) {
-	case ( le_compound_num_type::eScalar ): {
-		for ( size_t i = 0; i != previous_key->array_size; i++ ) {
-			// If more than one scalar element, this most likely means that
-			// we're updating weights.
-			lerp_animation_target<float>( static_cast<float*>( channel.target_node_element ) + i,
-			                              previous_key->data.as_scalar[ i ], next_key->data.as_scalar[ i ], norm_t );
-		}
-		break;
-	}
-	case ( le_compound_num_type::eVec2 ): {
-		lerp_animation_target<glm::vec2>( static_cast<glm::vec2*>( channel.target_node_element ),
-		                                  previous_key->data.as_vec2[ 0 ], next_key->data.as_vec2[ 0 ], norm_t );
-		break;
-	}
-	case ( le_compound_num_type::eVec3 ): {
-		lerp_animation_target<glm::vec3>( static_cast<glm::vec3*>( channel.target_node_element ),
-		                                  previous_key->data.as_vec3[ 0 ], next_key->data.as_vec3[ 0 ], norm_t );
-		break;
-	}
-	case ( le_compound_num_type::eVec4 ): {
-		lerp_animation_target<glm::vec4>( static_cast<glm::vec4*>( channel.target_node_element ),
-		                                  previous_key->data.as_vec4[ 0 ], next_key->data.as_vec4[ 0 ], norm_t );
-		break;
-	}
-	case ( le_compound_num_type::eQuat4 ): {
-		// note that we distinguish between quat and vec, because interpolation type is different
-		lerp_animation_target<glm::quat>( static_cast<glm::quat*>( channel.target_node_element ),
-		                                  previous_key->data.as_quat[ 0 ], next_key->data.as_quat[ 0 ], norm_t );
-		break;
-	}
-	default:
-		break;
+	if ( !force && !hierarchy.has_global_changes ) {
+		return;
 	}
 
-	channel.target_node->local_transform_cached = false;
-}
+	for ( size_t i = 0; i != self->instance_nodes.size(); i++ ) {
+		uint32_t const node_idx = self->instance_nodes[ i ];
 
-// ----------------------------------------------------------------------
+		if ( !force && !hierarchy.global_dirty[ hierarchy.slot_of_node[ node_idx ] ] ) {
+			continue;
+		}
 
-static void traverse_node( le_node_o* parent ) {
-	for ( le_node_o* c : parent->children ) {
-		c->global_transform         = parent->global_transform * c->local_transform;
-		c->inverse_global_transform = glm::inverse( c->global_transform );
-		traverse_node( c );
-		c->global_transform_chached = true;
+		le_node_o const* n                 = stage->nodes[ node_idx ];
+		self->transforms[ i ].modelMatrix  = node_get_global_transform( stage, n );
+		self->transforms[ i ].normalMatrix = glm::transpose( node_get_inverse_global_transform( stage, n ) );
+		self->transforms_need_upload       = true;
 	}
 }
 
@@ -2745,9 +4637,15 @@ static void le_stage_update( le_stage_o* self ) {
 		uint64_t current_ticks = le_timebase_i.get_current_ticks( self->timebase );
 
 		if ( !self->animations.empty() ) {
-			// for each animation: find current keyframe
+			// for each animation: find animation time for its channels
+
+			std::vector<animation_channel_eval_t> evals;
+
+			for ( auto& a : self->animations ) {
 
-			for ( auto const& a : self->animations ) {
+				if ( a.ticks_duration == 0 ) {
+					continue;
+				}
 
 				uint64_t animation_time = current_ticks - a.ticks_offset;
 
@@ -2766,42 +4664,71 @@ static void le_stage_update( le_stage_o* self ) {
 					break;
 				}
 
-				for ( auto const& c : a.channels ) {
-					apply_animation_channel( c, animation_time );
+				for ( auto& c : a.channels ) {
+					if ( !c.key_ticks.empty() ) {
+						evals.push_back( { &c, animation_time } );
+					}
 				}
 			}
 
-			// apply keyframe value to node.
+			// -- Evaluate all channels - this is where interpolation happens.
+
+			animation_channels_evaluate( evals.data(), uint32_t( evals.size() ) );
+
+			// -- Apply channel values to nodes, in order, so that if more than one
+			// animation targets the same node, the last animation wins.
+
+			for ( auto const& e : evals ) {
+				animation_channel_apply( &self->transforms, *e.channel );
+			}
 		}
 	}
 
-	// -- Update node's local transform matrices from node's T,R,S properties.
+	// -- Update local transform matrices from T,R,S properties, then global transform
+	// -- matrices, and their inverses - but only for nodes which have changed, or whose
+	// -- ancestors have changed.
 
-	for ( le_node_o* n : self->nodes ) {
-		if ( false == n->local_transform_cached ) {
+	transform_hierarchy_update( &self->transforms );
 
-			glm::mat4 m =
-			    glm::translate( glm::mat4( 1.f ), n->local_translation ) * // translate
-			    glm::mat4_cast( n->local_rotation ) *                      // rotate
-			    glm::scale( glm::mat4( 1.f ), n->local_scale )             // scale
-			    ;
+	// -- Update joint matrices for skins whose joints have moved.
 
-			n->local_transform = m;
+	joint_palette_update( &self->joint_palette, &self->transforms, self->nodes );
 
-			n->local_transform_cached = true;
-		}
+	// -- Update transforms for instances which are culled, and drawn by the GPU - unless the
+	// device turned out not to support indirect draws, in which case we draw on the CPU.
+	// The pipeline for culling instances gets created the first time it is needed.
+
+	if ( self->gpu_draws.enabled && !le_backend_vk::settings_i.get_indirect_draws_enabled() ) {
+		static auto logger = LeLog( LOGGER_LABEL );
+		logger.warn( "Device does not support indirect draws - drawing on the CPU instead." );
+		self->gpu_draws.enabled = false;
 	}
 
-	// -- Update global transform matrices.
-	// -- while we are at it, we also calculate inverse global transforms.
-	// -- recurse over nodes, starting with root nodes of scene.
+	if ( self->gpu_draws.enabled && self->gpu_draws.cull_pipeline == nullptr ) {
+		le_pipeline_manager_o* pipeline_manager = le_renderer::renderer_i.get_pipeline_manager( self->renderer );
 
-	for ( le_scene_o const& s : self->scenes ) {
-		for ( le_node_o* n : s.root_nodes ) {
-			n->global_transform         = n->local_transform;
-			n->inverse_global_transform = glm::inverse( n->global_transform );
-			traverse_node( n );
+		self->gpu_draws.cull_pipeline =
+		    LeComputePipelineBuilder( pipeline_manager )
+		        .setShaderStage(
+		            LeShaderModuleBuilder( pipeline_manager )
+		                .setSourceFilePath( "./resources/shaders/le_stage/cull_instances.comp" )
+		                .setShaderStage( le::ShaderStage::eCompute )
+		                .build() )
+		        .build();
+	}
+
+	if ( self->gpu_draws.enabled ) {
+		bool const was_built = self->gpu_draws.needs_build;
+		if ( was_built ) {
+			gpu_draws_build( &self->gpu_draws, self );
 		}
+		gpu_draws_update_transforms( &self->gpu_draws, self, was_built );
+	}
+
+	// -- Update world-space bounds for mesh nodes which have moved, so that we may cull them.
+
+	for ( auto& s : self->scenes ) {
+		scene_bvh_update( &s.bvh, self, s.scene_id );
 	}
 
 	// -- Update all lights.
@@ -2826,8 +4753,8 @@ static void le_stage_update( le_stage_o* self ) {
 			glm::vec4 direction{ 0, 0, -1, 0 };
 			glm::vec4 position{ 0, 0, 0, 1 };
 
-			direction = n->global_transform * direction;
-			position  = n->global_transform * position;
+			direction = node_get_global_transform( self, n ) * direction;
+			position  = node_get_global_transform( self, n ) * position;
 
 			// clang-format off
 			switch(info.type) {
@@ -2871,6 +4798,33 @@ static void le_stage_update( le_stage_o* self ) {
 
 // ----------------------------------------------------------------------
 
+static void le_stage_get_draw_stats( le_stage_o const* self, le_stage_draw_stats_t* stats ) {
+	*stats = self->draw_stats;
+}
+
+// ----------------------------------------------------------------------
+
+// GPU-driven drawing needs indirect draw features, which we can only request from the backend
+// before it is initialised - if we're called too late, we warn, and keep drawing on the CPU.
+// We create the pipeline for culling instances on the first update once GPU-driven drawing
+// is enabled, since the pipeline manager only exists after renderer setup.
+static void le_stage_set_gpu_driven( le_stage_o* self, bool enabled ) {
+
+	static auto logger = LeLog( LOGGER_LABEL );
+
+	if ( enabled &&
+	     !le_backend_vk::settings_i.get_indirect_draws_enabled() &&
+	     !le_backend_vk::settings_i.set_indirect_draws_enabled( true ) ) {
+		logger.warn( "GPU-driven drawing needs indirect draws, which must be enabled before the renderer is set up - drawing on the CPU instead." );
+		enabled = false;
+	}
+
+	self->gpu_draws.enabled     = enabled;
+	self->gpu_draws.needs_build = true;
+}
+
+// ----------------------------------------------------------------------
+
 static le_stage_o* le_stage_create( le_renderer_o* renderer, le_timebase_o* timebase ) {
 	auto self      = new le_stage_o{};
 	self->renderer = renderer;
@@ -2883,6 +4837,7 @@ static le_stage_o* le_stage_create( le_renderer_o* renderer, le_timebase_o* time
 static void le_stage_destroy( le_stage_o* self ) {
 
 	for ( auto& img : self->images ) {
+		stage_image_resolve_pixels( img ); // we must not free an image while it is still being decoded
 		if ( img->pixels ) {
 			le_pixels::le_pixels_i.destroy( img->pixels );
 			img->pixels = nullptr;
@@ -2891,9 +4846,7 @@ static void le_stage_destroy( le_stage_o* self ) {
 	}
 
 	for ( auto& b : self->buffers ) {
-		if ( b->owns_mem && b->mem && b->size ) {
-			free( b->mem );
-		}
+		stage_buffer_release_mem( b );
 		delete b;
 	}
 
@@ -2940,18 +4893,22 @@ LE_MODULE_REGISTER_IMPL( le_stage, api ) {
 	le_stage_i.create_image_from_memory    = le_stage_create_image_from_memory;
 	le_stage_i.create_image_from_file_path = le_stage_create_image_from_file_path;
 
-	le_stage_i.create_texture         = le_stage_create_texture;
-	le_stage_i.create_sampler         = le_stage_create_sampler;
-	le_stage_i.create_buffer          = le_stage_create_buffer;
-	le_stage_i.create_buffer_view     = le_stage_create_buffer_view;
-	le_stage_i.create_accessor        = le_stage_create_accessor;
-	le_stage_i.create_material        = le_stage_create_material;
-	le_stage_i.create_mesh            = le_stage_create_mesh;
-	le_stage_i.create_light           = le_stage_create_light;
-	le_stage_i.create_camera_settings = le_stage_create_camera_settings;
-	le_stage_i.create_nodes           = le_stage_create_nodes;
-	le_stage_i.create_animation       = le_stage_create_animation;
-	le_stage_i.create_skin            = le_stage_create_skin;
-	le_stage_i.node_set_skin          = le_stage_node_set_skin;
-	le_stage_i.create_scene           = le_stage_create_scene;
+	le_stage_i.create_texture           = le_stage_create_texture;
+	le_stage_i.create_sampler           = le_stage_create_sampler;
+	le_stage_i.create_buffer            = le_stage_create_buffer;
+	le_stage_i.create_buffer_non_owning = le_stage_create_buffer_non_owning;
+	le_stage_i.create_buffer_view       = le_stage_create_buffer_view;
+	le_stage_i.create_accessor          = le_stage_create_accessor;
+	le_stage_i.create_material          = le_stage_create_material;
+	le_stage_i.create_mesh              = le_stage_create_mesh;
+	le_stage_i.create_light             = le_stage_create_light;
+	le_stage_i.create_camera_settings   = le_stage_create_camera_settings;
+	le_stage_i.create_nodes             = le_stage_create_nodes;
+	le_stage_i.create_animation         = le_stage_create_animation;
+	le_stage_i.create_skin              = le_stage_create_skin;
+	le_stage_i.node_set_skin            = le_stage_node_set_skin;
+	le_stage_i.create_scene             = le_stage_create_scene;
+
+	le_stage_i.get_draw_stats = le_stage_get_draw_stats;
+	le_stage_i.set_gpu_driven = le_stage_set_gpu_driven;
 }
@@ -47,6 +47,15 @@ struct le_sampler_info_t; // from le_renderer
  *
  */
 
+// Statistics for the most recent call to draw a stage.
+struct le_stage_draw_stats_t {
+	uint32_t num_nodes_visible;  // mesh nodes which were drawn
+	uint32_t num_nodes_culled;   // mesh nodes which were skipped, because they were outside the camera frustum
+	uint32_t num_primitives;     // primitives drawn - drawing each primitive separately would take as many draw calls, and pipeline binds
+	uint32_t num_draw_calls;     // draw calls issued, once primitives which share mesh, and material were merged into instanced draws
+	uint32_t num_pipeline_binds; // pipeline binds issued, once draws were sorted by pipeline
+};
+
 // clang-format off
 struct le_stage_api {
 
@@ -73,6 +82,11 @@ struct le_stage_api {
 		uint32_t (* create_texture)(le_stage_o* stage, le_texture_info const * info);
 
 		uint32_t (* create_buffer      )( le_stage_o* self, void *mem, uint32_t sz, char const *debug_name );
+
+		// Like create_buffer, but does not copy `mem` - use this for memory-mapped files. Stage calls `release_fn(release_user_data)`
+		// once it does not need `mem` anymore, which is after upload, or on destroy. `mem` must stay valid, and unchanged, until then.
+		uint32_t (* create_buffer_non_owning )( le_stage_o* self, void *mem, uint32_t sz, char const *debug_name, void (*release_fn)(void* release_user_data), void* release_user_data );
+
 		uint32_t (* create_buffer_view )( le_stage_o* self, le_buffer_view_info const *info );
 		uint32_t (* create_accessor    )( le_stage_o* self, le_accessor_info const *info );
 		uint32_t (* create_material    )( le_stage_o* self, le_material_info const * info);
@@ -87,6 +101,21 @@ struct le_stage_api {
 		void     (* node_set_skin)(le_stage_o*, uint32_t node_idx, uint32_t skin_idx);
 
 		uint32_t (* create_scene)( le_stage_o *self, uint32_t *node_idx, uint32_t node_idx_count );
+
+		// Mesh nodes are culled against the camera frustum before drawing, and their primitives are drawn sorted
+		// by state, merged into instanced draws where possible. Returns statistics for the most recent draw,
+		// summed over all scenes in the stage.
+		void     (* get_draw_stats)( le_stage_o const* self, le_stage_draw_stats_t* stats );
+
+		// If enabled, primitives which may be instanced are culled on the GPU, by a compute pass, and drawn via
+		// indirect draws: one draw-indirect-count per batch of primitives which share pipeline, material, and
+		// buffers. Draw stats then count each batch as one draw call, and all of its instances as drawn, since
+		// culling happens on the GPU. Requires indirect draws, which the backend can only request before the
+		// renderer is set up: the first call to enable GPU-driven drawing must therefore happen before renderer
+		// setup - after that, it may be toggled freely. Enabling it for the first time after renderer setup
+		// has no effect other than a warning, as does enabling it on a device without indirect draws: the
+		// stage keeps drawing on the CPU.
+		void     (* set_gpu_driven)( le_stage_o* self, bool enabled );
 	};
 
 	le_stage_interface_t       le_stage_i;
@@ -1,10 +1,15 @@
 #include "le_tessellator.h"
 #include "le_core.h"
+#include "le_jobs.h"
 
 #include "./3rdparty/earcut.hpp/include/mapbox/earcut.hpp"
 #include "tesselator.h"
 
 #include <string.h> // memcpy
+#include <assert.h>
+#include <algorithm>
+#include <limits>
+#include <vector>
 #include <glm/vec2.hpp>
 
 using Point     = glm::vec2;
@@ -36,6 +41,111 @@ struct le_tessellator_o {
 	uint64_t                        options;
 };
 
+struct tessellator_shape_t {
+	uint64_t                          options = 0;
+	std::vector<std::vector<Point>>   contours;
+	std::vector<Point>                vertices; // result of tessellation, before it gets copied to batch
+	std::vector<IndexType>            indices;  // result of tessellation, relative to first vertex of this shape
+	le_tessellator_api::shape_range_t range   = {};
+	bool                              success = false;
+};
+
+struct le_tessellator_batch_o {
+	std::vector<tessellator_shape_t> shapes;
+	std::vector<IndexType>           indices;  // indices for all shapes, absolute
+	std::vector<Point>               vertices; // vertices for all shapes
+};
+
+// Tessellator state which may be re-used across shapes - each thread (or job)
+// must use its own context, as neither libtess nor earcut are thread-safe.
+struct tessellation_context_t {
+	TESStesselator*                   tess = nullptr; // created on first use
+	mapbox::detail::Earcut<IndexType> earcut;
+};
+
+// ----------------------------------------------------------------------
+
+static void tessellation_context_destroy( tessellation_context_t* ctx ) {
+	if ( ctx->tess ) {
+		tessDeleteTess( ctx->tess );
+		ctx->tess = nullptr;
+	}
+}
+
+// ----------------------------------------------------------------------
+// Tessellates `contours` into `vertices` and `indices` - indices are relative to
+// the first element in `vertices`. Returns false if tessellation failed.
+static bool tessellate_contours( tessellation_context_t* ctx, std::vector<std::vector<Point>> const& contours, uint64_t options,
+                                 std::vector<Point>& vertices, std::vector<IndexType>& indices ) {
+
+	indices.clear();
+	vertices.clear();
+
+	if ( options & le_tessellator::Options::bitUseEarcutTessellator ) {
+		// Use earcut tessellator - earcut does not add any vertices, its indices
+		// refer to contour vertices in the order in which they were added.
+		ctx->earcut( contours );
+		indices.swap( ctx->earcut.indices );
+
+		for ( auto const& contour : contours ) {
+			vertices.insert( vertices.end(), contour.begin(), contour.end() );
+		}
+
+		return true;
+	}
+
+	// Use libtess
+
+	if ( nullptr == ctx->tess ) {
+		ctx->tess = tessNewTess( nullptr );
+	}
+
+	auto& tess = ctx->tess;
+
+	tessSetOption( tess, TessOption::TESS_CONSTRAINED_DELAUNAY_TRIANGULATION,
+	               options & le_tessellator::Options::bitConstrainedDelaunayTriangulation );
+
+	tessSetOption( tess, TessOption::TESS_REVERSE_CONTOURS,
+	               options & le_tessellator::Options::bitReverseContours );
+
+	for ( auto const& contour : contours ) {
+		tessAddContour( tess, Point::type::length(), contour.data(), sizeof( Point ), int( contour.size() ) );
+	}
+
+	int result = tessTesselate( tess,
+	                            int( options >> le_tessellator_api::le_tessellator_interface_t::OptionsWindingsOffset ),
+	                            TessElementType::TESS_POLYGONS,
+	                            3, // max number of vertices per polygon - we want triangles.
+	                            Point::length(),
+	                            nullptr );
+
+	if ( result == 0 ) {
+		// libtess may bail out half-way through, leaving its internal mesh in an
+		// undefined state - we must not re-use this tessellator.
+		tessellation_context_destroy( ctx );
+		return contours.empty();
+	}
+
+	size_t numVertices = size_t( tessGetVertexCount( tess ) );
+	auto   pVertices   = tessGetVertices( tess );
+	vertices.resize( numVertices );
+	memcpy( vertices.data(), pVertices, sizeof( Point ) * numVertices );
+
+	size_t numIndices = size_t( tessGetElementCount( tess ) ) * 3; // each element has 3 vertices, as we requested triangles when tessellating
+	indices.reserve( numIndices );
+
+	TESSindex const*       pIndex     = tessGetElements( tess );
+	TESSindex const* const pIndex_end = pIndex + numIndices;
+
+	// we must copy manually since indices are int, but we want IndexType
+
+	for ( auto idx = pIndex; idx != pIndex_end; idx++ ) {
+		indices.emplace_back( IndexType( *idx ) );
+	}
+
+	return true;
+}
+
 // ----------------------------------------------------------------------
 
 static le_tessellator_o* le_tessellator_create() {
@@ -63,84 +173,221 @@ static void le_tessellator_add_polyline( le_tessellator_o* self, Point const* co
 
 static bool le_tessellator_tessellate( le_tessellator_o* self ) {
 
-	// Run tessellation
-	if ( self->options & le_tessellator::Options::bitUseEarcutTessellator ) {
-		// Use earcut tessellator
-		self->indices = mapbox::earcut<IndexType>( self->contours );
+	tessellation_context_t ctx{};
+
+	bool result = tessellate_contours( &ctx, self->contours, self->options, self->vertices, self->indices );
+
+	tessellation_context_destroy( &ctx );
+
+	return result;
+}
+
+// ----------------------------------------------------------------------
+
+static void le_tessellator_get_indices( le_tessellator_o* self, IndexType const** pIndices, size_t* indexCount ) {
+	*pIndices   = self->indices.data();
+	*indexCount = self->indices.size();
+}
+
+// ----------------------------------------------------------------------
+
+static void le_tessellator_get_vertices( le_tessellator_o* self, Point const** pVertices, size_t* vertexCount ) {
+	*pVertices   = self->vertices.data();
+	*vertexCount = self->vertices.size();
+}
+
+// ----------------------------------------------------------------------
+
+static void le_tessellator_reset( le_tessellator_o* self ) {
+	self->contours.clear();
+	self->indices.clear();
+	self->vertices.clear();
+}
+
+// ----------------------------------------------------------------------
+
+static void le_tessellator_set_options( le_tessellator_o* self, uint64_t options ) {
+	self->options = options;
+}
+
+// ----------------------------------------------------------------------
+
+static le_tessellator_batch_o* le_tessellator_batch_create() {
+	auto self = new le_tessellator_batch_o();
+	return self;
+}
+
+// ----------------------------------------------------------------------
+
+static void le_tessellator_batch_destroy( le_tessellator_batch_o* self ) {
+	delete self;
+}
+
+// ----------------------------------------------------------------------
+
+static uint32_t le_tessellator_batch_add_shape( le_tessellator_batch_o* self, uint64_t options ) {
+	self->shapes.emplace_back();
+	self->shapes.back().options = options;
+	return uint32_t( self->shapes.size() - 1 );
+}
+
+// ----------------------------------------------------------------------
+
+static void le_tessellator_batch_add_polyline( le_tessellator_batch_o* self, Point const* const pPoints, size_t const& pointCount ) {
+	assert( !self->shapes.empty() && "must add shape before adding polylines" );
+	auto& contours = self->shapes.back().contours;
+	contours.insert( contours.end(), { pPoints, pPoints + pointCount } );
+}
+
+// ----------------------------------------------------------------------
+
+struct tessellate_shapes_job_params_t {
+	tessellator_shape_t* shapes_begin;
+	tessellator_shape_t* shapes_end;
+};
+
+// Tessellates a contiguous range of shapes, re-using one tessellation context for all shapes
+// in the range, so that we don't pay for setting up a tessellator for every single shape.
+static void tessellate_shapes( void* params_ ) {
+	auto params = static_cast<tessellate_shapes_job_params_t*>( params_ );
+
+	tessellation_context_t ctx{};
+
+	for ( auto s = params->shapes_begin; s != params->shapes_end; s++ ) {
+		s->success = tessellate_contours( &ctx, s->contours, s->options, s->vertices, s->indices );
+	}
+
+	tessellation_context_destroy( &ctx );
+}
+
+// ----------------------------------------------------------------------
+
+static bool le_tessellator_batch_tessellate( le_tessellator_batch_o* self ) {
+
+	if ( self->shapes.empty() ) {
+		return true;
+	}
+
+	uint32_t const num_shapes  = uint32_t( self->shapes.size() );
+	uint32_t const num_workers = le_jobs::get_worker_thread_count();
+
+	if ( num_workers == 0 || num_shapes == 1 ) {
+		// Job system not available: tessellate on the calling thread.
+		tessellate_shapes_job_params_t params{ self->shapes.data(), self->shapes.data() + num_shapes };
+		tessellate_shapes( &params );
 	} else {
-		// Use libtess
-		TESStesselator* tess;
-		tess = tessNewTess( nullptr );
+		// We split shapes into more chunks than we have workers, so that a few
+		// expensive shapes don't keep all other workers waiting.
+		uint32_t const num_jobs        = std::min( num_shapes, num_workers * 4 );
+		uint32_t const shapes_per_job  = ( num_shapes + num_jobs - 1 ) / num_jobs;
+		auto* const    shapes_data_end = self->shapes.data() + num_shapes;
+
+		std::vector<tessellate_shapes_job_params_t> params;
+		std::vector<le_jobs::job_t>                 jobs;
+		params.reserve( num_jobs );
+		jobs.reserve( num_jobs );
+
+		for ( uint32_t i = 0; i < num_shapes; i += shapes_per_job ) {
+			auto* begin = self->shapes.data() + i;
+			params.push_back( { begin, std::min( begin + shapes_per_job, shapes_data_end ) } );
+		}
+
+		for ( auto& p : params ) {
+			jobs.push_back( { tessellate_shapes, &p } );
+		}
+
+		le_jobs::counter_t* counter;
+		le_jobs::run_jobs( jobs.data(), uint32_t( jobs.size() ), &counter );
+		le_jobs::wait_for_counter_and_free( counter, 0 );
+	}
+
+	// --------| invariant: all shapes have been tessellated
 
-		tessSetOption( tess, TessOption::TESS_CONSTRAINED_DELAUNAY_TRIANGULATION,
-		               self->options & le_tessellator::Options::bitConstrainedDelaunayTriangulation );
+	// Calculate per-shape offsets into the shared vertex and index buffer.
 
-		tessSetOption( tess, TessOption::TESS_REVERSE_CONTOURS,
-		               self->options & le_tessellator::Options::bitReverseContours );
+	size_t num_vertices = 0;
+	size_t num_indices  = 0;
+	bool   success      = true;
 
-		for ( auto const& contour : self->contours ) {
-			tessAddContour( tess, Point::type::length(), contour.data(), sizeof( Point ), int( contour.size() ) );
+	for ( auto& s : self->shapes ) {
+		if ( !s.success ) {
+			s.vertices.clear();
+			s.indices.clear();
+			success = false;
 		}
+		s.range.vertex_offset = uint32_t( num_vertices );
+		s.range.vertex_count  = uint32_t( s.vertices.size() );
+		s.range.index_offset  = uint32_t( num_indices );
+		s.range.index_count   = uint32_t( s.indices.size() );
+		num_vertices += s.vertices.size();
+		num_indices += s.indices.size();
+	}
 
-		tessTesselate( tess,
-		               int( self->options >> le_tessellator_api::le_tessellator_interface_t::OptionsWindingsOffset ),
-		               TessElementType::TESS_POLYGONS,
-		               3, // max number of vertices per polygon - we want triangles.
-		               Point::length(),
-		               nullptr );
+	assert( num_vertices <= std::numeric_limits<IndexType>::max() && "too many vertices for index type" );
 
-		self->indices.clear();
-		self->vertices.clear();
+	self->vertices.resize( num_vertices );
+	self->indices.resize( num_indices );
 
-		size_t numVertices = size_t( tessGetVertexCount( tess ) );
-		auto   pVertices   = tessGetVertices( tess );
-		self->vertices.resize( numVertices );
-		memcpy( self->vertices.data(), pVertices, sizeof( Point ) * numVertices );
+	for ( auto& s : self->shapes ) {
 
-		size_t numIndices = size_t( tessGetElementCount( tess ) ) * 3; // each element has 3 vertices, as we requested triangles when tessellating
-		self->indices.reserve( numIndices );
+		if ( s.vertices.empty() ) {
+			continue;
+		}
 
-		TESSindex const*       pIndex     = tessGetElements( tess );
-		TESSindex const* const pIndex_end = pIndex + numIndices;
+		memcpy( self->vertices.data() + s.range.vertex_offset, s.vertices.data(), sizeof( Point ) * s.vertices.size() );
 
-		// we must copy manually since indices are int, but we want uint16_t
+		IndexType*       idx     = self->indices.data() + s.range.index_offset;
+		IndexType const* src     = s.indices.data();
+		IndexType const* src_end = src + s.indices.size();
 
-		for ( auto idx = pIndex; idx != pIndex_end; idx++ ) {
-			self->indices.emplace_back( *idx );
+		for ( ; src != src_end; src++, idx++ ) {
+			*idx = *src + s.range.vertex_offset;
 		}
 
-		tessDeleteTess( tess );
+		// Free intermediary storage - we keep contours, so that the batch may be tessellated again.
+		s.vertices = {};
+		s.indices  = {};
 	}
 
-	return true;
+	return success;
 }
 
 // ----------------------------------------------------------------------
 
-static void le_tessellator_get_indices( le_tessellator_o* self, IndexType const** pIndices, size_t* indexCount ) {
+static void le_tessellator_batch_get_indices( le_tessellator_batch_o* self, IndexType const** pIndices, size_t* indexCount ) {
 	*pIndices   = self->indices.data();
 	*indexCount = self->indices.size();
 }
 
 // ----------------------------------------------------------------------
 
-static void le_tessellator_get_vertices( le_tessellator_o* self, Point const** pVertices, size_t* vertexCount ) {
+static void le_tessellator_batch_get_vertices( le_tessellator_batch_o* self, Point const** pVertices, size_t* vertexCount ) {
 	*pVertices   = self->vertices.data();
 	*vertexCount = self->vertices.size();
 }
 
 // ----------------------------------------------------------------------
 
-static void le_tessellator_reset( le_tessellator_o* self ) {
-	self->contours.clear();
-	self->indices.clear();
-	self->vertices.clear();
+static size_t le_tessellator_batch_get_shape_count( le_tessellator_batch_o* self ) {
+	return self->shapes.size();
 }
 
 // ----------------------------------------------------------------------
 
-static void le_tessellator_set_options( le_tessellator_o* self, uint64_t options ) {
-	self->options = options;
+static bool le_tessellator_batch_get_shape_range( le_tessellator_batch_o* self, uint32_t shape_index, le_tessellator_api::shape_range_t* range ) {
+	if ( shape_index >= self->shapes.size() ) {
+		return false;
+	}
+	*range = self->shapes[ shape_index ].range;
+	return self->shapes[ shape_index ].success;
+}
+
+// ----------------------------------------------------------------------
+
+static void le_tessellator_batch_reset( le_tessellator_batch_o* self ) {
+	self->shapes.clear();
+	self->indices.clear();
+	self->vertices.clear();
 }
 
 // ----------------------------------------------------------------------
@@ -156,4 +403,17 @@ LE_MODULE_REGISTER_IMPL( le_tessellator, api ) {
 	le_tessellator_i.get_vertices = le_tessellator_get_vertices;
 	le_tessellator_i.reset        = le_tessellator_reset;
 	le_tessellator_i.set_options  = le_tessellator_set_options;
+
+	auto& batch_i = static_cast<le_tessellator_api*>( api )->le_tessellator_batch_i;
+
+	batch_i.create          = le_tessellator_batch_create;
+	batch_i.destroy         = le_tessellator_batch_destroy;
+	batch_i.add_shape       = le_tessellator_batch_add_shape;
+	batch_i.add_polyline    = le_tessellator_batch_add_polyline;
+	batch_i.tessellate      = le_tessellator_batch_tessellate;
+	batch_i.get_indices     = le_tessellator_batch_get_indices;
+	batch_i.get_vertices    = le_tessellator_batch_get_vertices;
+	batch_i.get_shape_count = le_tessellator_batch_get_shape_count;
+	batch_i.get_shape_range = le_tessellator_batch_get_shape_range;
+	batch_i.reset           = le_tessellator_batch_reset;
 }
@@ -8,11 +8,12 @@
 #endif
 
 struct le_tessellator_o;
+struct le_tessellator_batch_o; // tessellates many independent shapes in one go, in parallel if le_jobs is running
 
 // clang-format off
 struct le_tessellator_api {
 
-	typedef uint16_t IndexType;
+	typedef uint32_t IndexType; // 32 bit, so that tessellations may hold more than 65535 vertices
 
 	struct le_tessellator_interface_t {
 
@@ -47,7 +48,44 @@ struct le_tessellator_api {
 
 	};
 
+	// Per-shape ranges into the shared output buffers of a batch.
+	//
+	// Indices are absolute - they already include `vertex_offset`, which means
+	// that all shapes of a batch may be drawn using a single indexed draw call.
+	struct shape_range_t {
+		uint32_t vertex_offset;
+		uint32_t vertex_count;
+		uint32_t index_offset;
+		uint32_t index_count;
+	};
+
+	struct le_tessellator_batch_interface_t {
+
+		le_tessellator_batch_o * ( * create           ) ( );
+		void                     ( * destroy          ) ( le_tessellator_batch_o* self );
+
+		// Starts a new shape, and returns its shape index. Any subsequent calls to
+		// `add_polyline` add contours to this shape. `options` are the same as
+		// le_tessellator_interface_t::Options, and apply to this shape only.
+		uint32_t                 ( * add_shape        ) ( le_tessellator_batch_o* self, uint64_t options );
+		void                     ( * add_polyline     ) ( le_tessellator_batch_o* self, glm::vec2 const * const pPoints, size_t const& pointCount );
+
+		// Tessellates all shapes - shapes are distributed over le_jobs worker threads if the job
+		// system has been initialised, otherwise shapes are tessellated on the calling thread.
+		//
+		// Returns false if any shape failed to tessellate, shapes which failed have empty ranges.
+		bool                     ( * tessellate       ) ( le_tessellator_batch_o* self );
+
+		void                     ( * get_indices      ) ( le_tessellator_batch_o* self, IndexType const ** pIndices, size_t * indexCount );
+		void                     ( * get_vertices     ) ( le_tessellator_batch_o* self, glm::vec2 const ** pVertices, size_t * vertexCount );
+		size_t                   ( * get_shape_count  ) ( le_tessellator_batch_o* self );
+		bool                     ( * get_shape_range  ) ( le_tessellator_batch_o* self, uint32_t shape_index, shape_range_t* range );
+
+		void                     ( * reset            ) ( le_tessellator_batch_o* self );
+	};
+
 	le_tessellator_interface_t       le_tessellator_i;
+	le_tessellator_batch_interface_t le_tessellator_batch_i;
 };
 // clang-format on
 
@@ -59,6 +97,7 @@ LE_MODULE_LOAD_DEFAULT( le_tessellator );
 namespace le_tessellator {
 static const auto& api              = le_tessellator_api_i;
 static const auto& le_tessellator_i = api -> le_tessellator_i;
+static const auto& batch_i          = api -> le_tessellator_batch_i;
 using Options                       = le_tessellator_api::le_tessellator_interface_t::Options;
 } // namespace le_tessellator
 
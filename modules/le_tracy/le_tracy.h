@@ -67,6 +67,12 @@
 
 #include "3rdparty/tracy/public/tracy/Tracy.hpp"
 
+#if defined( TRACY_ENABLE )
+// we use the C api to forward gpu timestamps which
+// we read back ourselves as gpu zones.
+#	include "3rdparty/tracy/public/tracy/TracyC.h"
+#endif
+
 //----------------------------------------------------------------------
 
 // we allow ourselves a tracy context object so that we can store
@@ -0,0 +1,22 @@
+#ifndef LE_BINDLESS_GLSL
+#define LE_BINDLESS_GLSL
+
+// Bindless resources - only available if the backend was set up with
+// `settings_i.set_bindless_enabled(true)`. Set and bindings must match
+// `LE_BINDLESS_DESCRIPTOR_SET` in le_backend_vk.h.
+//
+// Indices come from the encoder: `getBindlessTextureIndex()`, and
+// `getBindlessBufferIndex()`. Use `nonuniformEXT()` whenever an index
+// may differ between invocations.
+
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout ( set = 3, binding = 0 ) uniform sampler2D le_bindless_textures[];
+
+// Declare your own storage buffer types at binding 1, e.g.:
+//
+//  layout ( std430, set = 3, binding = 1 ) readonly buffer MyData { vec4 data[]; } my_buffers[];
+
+#define le_bindless_texture( idx ) le_bindless_textures[ nonuniformEXT( idx ) ]
+
+#endif
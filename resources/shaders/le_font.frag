@@ -6,6 +6,9 @@
 // inputs 
 layout (location = 0) in VertexData {
 	vec2 texCoord;
+#ifdef PER_VERTEX_COLOR
+	vec4 color;
+#endif
 } inData;
 
 // outputs
@@ -13,9 +16,11 @@ layout (location = 0) out vec4 outFragColor;
 
 layout (set = 0, binding = 1) uniform sampler2D tex_unit_0;
 
+#ifndef PER_VERTEX_COLOR
 layout (set = 1, binding = 0) uniform VertexColor {
 	vec4 vertexColor;
 };
+#endif
 
 
 void main(){
@@ -23,5 +28,8 @@ void main(){
 	// outFragColor = vec4(inData.texCoord, 0, 1);
 	float sampleColor = texture(tex_unit_0, inData.texCoord,0).r;
 
+#ifdef PER_VERTEX_COLOR
+	vec4 vertexColor = inData.color;
+#endif
 	outFragColor = vertexColor * vec4(vec3(1),sampleColor);
 }
\ No newline at end of file
@@ -5,10 +5,16 @@
 
 // inputs 
 layout (location = 0) in vec4 vertex;
+#ifdef PER_VERTEX_COLOR
+layout (location = 1) in vec4 color;
+#endif
 
 // outputs 
 layout (location = 0) out VertexData {
 	vec2 texCoord;
+#ifdef PER_VERTEX_COLOR
+	vec4 color;
+#endif
 } outData;
 
 #ifdef NO_MVP
@@ -43,6 +49,9 @@ out gl_PerVertex
 void main() 
 {
 	outData.texCoord = vertex.zw;
+#ifdef PER_VERTEX_COLOR
+	outData.color = color;
+#endif
 	
 	vec4 position;
 #ifdef NO_MVP
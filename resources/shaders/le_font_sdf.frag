@@ -0,0 +1,41 @@
+#version 450 core
+
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+// Fragment shader for fonts which use a signed distance field atlas.
+
+// inputs 
+layout (location = 0) in VertexData {
+	vec2 texCoord;
+#ifdef PER_VERTEX_COLOR
+	vec4 color;
+#endif
+} inData;
+
+// outputs
+layout (location = 0) out vec4 outFragColor;
+
+layout (set = 0, binding = 1) uniform sampler2D tex_unit_0;
+
+#ifndef PER_VERTEX_COLOR
+layout (set = 1, binding = 0) uniform VertexColor {
+	vec4 vertexColor;
+};
+#endif
+
+
+void main(){
+	
+	// Distance fields store 0.5 on the outline, and increase towards the inside of glyphs.
+	float dist = texture(tex_unit_0, inData.texCoord).r;
+
+	// Anti-alias over about one screen pixel, whatever the scale at which glyphs are drawn.
+	float width = max(fwidth(dist), 1e-4);
+	float alpha = smoothstep(0.5 - width * 0.5, 0.5 + width * 0.5, dist);
+
+#ifdef PER_VERTEX_COLOR
+	vec4 vertexColor = inData.color;
+#endif
+	outFragColor = vertexColor * vec4(vec3(1), alpha);
+}
@@ -29,11 +29,20 @@ layout (location = LOC_POSITIONS ) in vec3 a_pos[NUM_POSITIONS];
 // Uniform Arguments
 layout (std140, set = 0, binding = 0) uniform UboMatrices {
 	mat4 viewProjectionMatrix; // (projection * view) matrix
-	mat4 normalMatrix;
-	mat4 modelMatrix;
 	vec3 camera_position; // camera position in world space
 };
 
+// Draws are instanced: each instance reads its transforms via gl_InstanceIndex
+// (which includes firstInstance).
+struct InstanceTransform {
+	mat4 modelMatrix;
+	mat4 normalMatrix;
+};
+
+layout (std140, set = 0, binding = 5) readonly buffer InstanceTransforms {
+	InstanceTransform instances[];
+};
+
 layout (std140, set = 0, binding = 1) uniform UboPostProcessing {
 	float exposure;
 } postProcessing;
@@ -146,6 +155,9 @@ vec4 getTangent(){
 
 void main() {
 
+	mat4 modelMatrix  = instances[gl_InstanceIndex].modelMatrix;
+	mat4 normalMatrix = instances[gl_InstanceIndex].normalMatrix;
+
     vec4 pos = modelMatrix * getPosition(); 	// world position
     v_position = vec3(pos.xyz) / pos.w; 		// un-project 
 	